@@ -139,7 +139,10 @@ qsc_thread qsc_async_thread_create(void (*func)(void*), void* state)
 		id = 0;
 		res = CreateThread(NULL, 0, (LPTHREAD_START_ROUTINE)func, state, 0, &id);
 #elif defined(QSC_SYSTEM_OS_POSIX)
-		pthread_create(&res, NULL, (void *(*) (void *))func, state);
+		if (pthread_create(&res, NULL, (void *(*) (void *))func, state) != 0)
+		{
+			res = 0;
+		}
 #endif
 	}
 
@@ -166,7 +169,10 @@ qsc_thread qsc_async_thread_create_ex(void (*func)(void**), void** args)
 		id = 0;
 		res = CreateThread(NULL, 0, (LPTHREAD_START_ROUTINE)func, args, 0, &id);
 #elif defined(QSC_SYSTEM_OS_POSIX)
-		pthread_create(&res, NULL, (void *(*) (void *))func, args);
+		if (pthread_create(&res, NULL, (void *(*) (void *))func, args) != 0)
+		{
+			res = 0;
+		}
 #endif
 	}
 
@@ -1,4 +1,5 @@
 #include "chacha.h"
+#include "async.h"
 #include "intutils.h"
 #include "memutils.h"
 
@@ -20,6 +21,20 @@
 #	define CHACHA_AVX512BLOCK_SIZE (16 * QSC_CHACHA_BLOCK_SIZE)
 #endif
 
+/* the 32-bit block counter limits a message to 2^32-1 blocks */
+#define CHACHAPOLY_MESSAGE_MAX 0x0000003FFFFFFFC0ULL
+
+/* the parallel transform divides the input into cache-sized work units */
+#define CHACHA_PARALLEL_CHUNK (64 * 1024)
+
+typedef struct
+{
+	qsc_chacha_state ctx;
+	uint8_t* output;
+	const uint8_t* input;
+	size_t length;
+} chacha_parallel_task;
+
 static void chacha_increment(qsc_chacha_state* ctx)
 {
 	++ctx->state[12];
@@ -681,6 +696,129 @@ static void chacha_permute_p4x512h(chacha_avx_state* ctxw)
 
 #endif
 
+static void chacha_quarter_round(uint32_t* x, size_t a, size_t b, size_t c, size_t d)
+{
+	x[a] += x[b];
+	x[d] = qsc_intutils_rotl32(x[d] ^ x[a], 16);
+	x[c] += x[d];
+	x[b] = qsc_intutils_rotl32(x[b] ^ x[c], 12);
+	x[a] += x[b];
+	x[d] = qsc_intutils_rotl32(x[d] ^ x[a], 8);
+	x[c] += x[d];
+	x[b] = qsc_intutils_rotl32(x[b] ^ x[c], 7);
+}
+
+static void chacha_hchacha(uint8_t* output, const uint8_t* key, const uint8_t* nonce)
+{
+	uint32_t x[CHACHA_STATE_SIZE];
+	size_t i;
+
+	x[0] = 0x61707865UL;
+	x[1] = 0x3320646EUL;
+	x[2] = 0x79622D32UL;
+	x[3] = 0x6B206574UL;
+
+	for (i = 0; i < 8; ++i)
+	{
+		x[4 + i] = qsc_intutils_le8to32(key + (i * sizeof(uint32_t)));
+	}
+
+	for (i = 0; i < 4; ++i)
+	{
+		x[12 + i] = qsc_intutils_le8to32(nonce + (i * sizeof(uint32_t)));
+	}
+
+	for (i = 0; i < QSC_CHACHA_ROUND_COUNT; i += 2)
+	{
+		chacha_quarter_round(x, 0, 4, 8, 12);
+		chacha_quarter_round(x, 1, 5, 9, 13);
+		chacha_quarter_round(x, 2, 6, 10, 14);
+		chacha_quarter_round(x, 3, 7, 11, 15);
+		chacha_quarter_round(x, 0, 5, 10, 15);
+		chacha_quarter_round(x, 1, 6, 11, 12);
+		chacha_quarter_round(x, 2, 7, 8, 13);
+		chacha_quarter_round(x, 3, 4, 9, 14);
+	}
+
+	/* the sub-key is the first and last rows, without the feed-forward addition */
+	for (i = 0; i < 4; ++i)
+	{
+		qsc_intutils_le32to8(output + (i * sizeof(uint32_t)), x[i]);
+		qsc_intutils_le32to8(output + 16 + (i * sizeof(uint32_t)), x[12 + i]);
+	}
+
+	qsc_memutils_clear((uint8_t*)x, sizeof(x));
+}
+
+static uint64_t chacha_position(const qsc_chacha_state* ctx)
+{
+	return ((uint64_t)ctx->state[13] << 32) | ctx->state[12];
+}
+
+static void chacha_parallel_worker(void* state)
+{
+	chacha_parallel_task* task = (chacha_parallel_task*)state;
+
+	qsc_chacha_transform(&task->ctx, task->output, task->input, task->length);
+	qsc_chacha_dispose(&task->ctx);
+}
+
+static void chachapoly_pad(qsc_chachapoly_state* ctx, size_t length)
+{
+	const uint8_t ZEROES[QSC_POLY1305_BLOCK_SIZE] = { 0 };
+	size_t plen;
+
+	plen = length % QSC_POLY1305_BLOCK_SIZE;
+
+	if (plen != 0)
+	{
+		qsc_poly1305_update(&ctx->mstate, ZEROES, QSC_POLY1305_BLOCK_SIZE - plen);
+	}
+}
+
+static void chachapoly_finalize(qsc_chachapoly_state* ctx, uint8_t* output, size_t length)
+{
+	uint8_t blen[2 * sizeof(uint64_t)] = { 0 };
+
+	/* pad the cipher-text, then add the associated data and cipher-text lengths */
+	chachapoly_pad(ctx, length);
+	qsc_intutils_le64to8(blen, ctx->aadlen);
+	qsc_intutils_le64to8(blen + sizeof(uint64_t), (uint64_t)length);
+	qsc_poly1305_update(&ctx->mstate, blen, sizeof(blen));
+	qsc_poly1305_finalize(&ctx->mstate, output);
+}
+
+static void chachapoly_load(qsc_chachapoly_state* ctx, const uint8_t* key, const uint8_t* nonce, bool encrypt)
+{
+	const uint8_t ZEROES[QSC_CHACHA_BLOCK_SIZE] = { 0 };
+	uint8_t mkey[QSC_CHACHA_BLOCK_SIZE] = { 0 };
+	size_t i;
+
+	ctx->cstate.state[0] = 0x61707865UL;
+	ctx->cstate.state[1] = 0x3320646EUL;
+	ctx->cstate.state[2] = 0x79622D32UL;
+	ctx->cstate.state[3] = 0x6B206574UL;
+
+	for (i = 0; i < 8; ++i)
+	{
+		ctx->cstate.state[4 + i] = qsc_intutils_le8to32(key + (i * sizeof(uint32_t)));
+	}
+
+	/* a 32-bit block counter followed by the 96-bit nonce */
+	ctx->cstate.state[12] = 0;
+	ctx->cstate.state[13] = qsc_intutils_le8to32(nonce);
+	ctx->cstate.state[14] = qsc_intutils_le8to32(nonce + 4);
+	ctx->cstate.state[15] = qsc_intutils_le8to32(nonce + 8);
+
+	/* the mac key is the first key-stream block, the cipher starts at block one */
+	qsc_chacha_transform(&ctx->cstate, mkey, ZEROES, sizeof(mkey));
+	qsc_poly1305_initialize(&ctx->mstate, mkey);
+	qsc_memutils_clear(mkey, sizeof(mkey));
+
+	ctx->aadlen = 0;
+	ctx->encrypt = encrypt;
+}
+
 void qsc_chacha_dispose(qsc_chacha_state* ctx)
 {
 	qsc_memutils_clear((uint8_t*)ctx->state, sizeof(ctx->state));
@@ -914,3 +1052,176 @@ void qsc_chacha_transform(qsc_chacha_state* ctx, uint8_t* output, const uint8_t*
 		}
 	}
 }
+
+void qsc_chacha_seek(qsc_chacha_state* ctx, uint64_t position)
+{
+	assert(ctx != NULL);
+
+	ctx->state[12] = (uint32_t)position;
+	ctx->state[13] = (uint32_t)(position >> 32);
+}
+
+void qsc_chacha_parallel_transform(qsc_chacha_state* ctx, uint8_t* output, const uint8_t* input, size_t length)
+{
+	assert(ctx != NULL);
+	assert(output != NULL);
+	assert(input != NULL);
+
+	qsc_thread thds[QSC_ASYNC_PARALLEL_MAX] = { 0 };
+	chacha_parallel_task* tasks;
+	uint64_t pos;
+	size_t cnks;
+	size_t i;
+	size_t oft;
+	size_t scnt;
+	size_t tcnt;
+	size_t tlen;
+
+	tasks = NULL;
+	cnks = (length + CHACHA_PARALLEL_CHUNK - 1) / CHACHA_PARALLEL_CHUNK;
+	tcnt = qsc_intutils_min(qsc_async_processor_count(), (size_t)QSC_ASYNC_PARALLEL_MAX);
+	tcnt = qsc_intutils_min(tcnt, cnks);
+
+	if (tcnt > 1)
+	{
+		tasks = (chacha_parallel_task*)qsc_memutils_malloc(tcnt * sizeof(chacha_parallel_task));
+	}
+
+	if (tasks != NULL)
+	{
+		pos = chacha_position(ctx);
+		oft = 0;
+
+		/* each thread receives a contiguous run of chunks, and seeks to the key-stream block at its offset */
+		for (i = 0; i < tcnt; ++i)
+		{
+			tlen = ((cnks / tcnt) + ((i < cnks % tcnt) ? 1 : 0)) * CHACHA_PARALLEL_CHUNK;
+			tlen = qsc_intutils_min(tlen, length - oft);
+
+			qsc_memutils_copy((uint8_t*)tasks[i].ctx.state, (const uint8_t*)ctx->state, sizeof(ctx->state));
+			qsc_chacha_seek(&tasks[i].ctx, pos + (oft / QSC_CHACHA_BLOCK_SIZE));
+			tasks[i].output = output + oft;
+			tasks[i].input = input + oft;
+			tasks[i].length = tlen;
+			oft += tlen;
+		}
+
+		/* if a worker cannot be started, its chunk and those after it are transformed on the calling thread */
+		for (i = 0; i < tcnt; ++i)
+		{
+			thds[i] = qsc_async_thread_create(chacha_parallel_worker, &tasks[i]);
+
+			if (thds[i] == 0)
+			{
+				break;
+			}
+		}
+
+		scnt = i;
+
+		for (; i < tcnt; ++i)
+		{
+			chacha_parallel_worker(&tasks[i]);
+		}
+
+		qsc_async_thread_wait_all(thds, scnt);
+		qsc_memutils_alloc_free(tasks);
+
+		/* advance the counter past the last, possibly partial, block */
+		qsc_chacha_seek(ctx, pos + ((length + QSC_CHACHA_BLOCK_SIZE - 1) / QSC_CHACHA_BLOCK_SIZE));
+	}
+	else
+	{
+		qsc_chacha_transform(ctx, output, input, length);
+	}
+}
+
+void qsc_chachapoly_dispose(qsc_chachapoly_state* ctx)
+{
+	assert(ctx != NULL);
+
+	if (ctx != NULL)
+	{
+		qsc_chacha_dispose(&ctx->cstate);
+		qsc_poly1305_reset(&ctx->mstate);
+		ctx->aadlen = 0;
+		ctx->encrypt = false;
+	}
+}
+
+void qsc_chachapoly_initialize(qsc_chachapoly_state* ctx, const uint8_t* key, const uint8_t* nonce, bool encrypt)
+{
+	assert(ctx != NULL);
+	assert(key != NULL);
+	assert(nonce != NULL);
+
+	chachapoly_load(ctx, key, nonce, encrypt);
+}
+
+void qsc_xchachapoly_initialize(qsc_chachapoly_state* ctx, const uint8_t* key, const uint8_t* nonce, bool encrypt)
+{
+	assert(ctx != NULL);
+	assert(key != NULL);
+	assert(nonce != NULL);
+
+	uint8_t skey[QSC_CHACHA_KEY256_SIZE] = { 0 };
+	uint8_t snonce[QSC_CHACHAPOLY_NONCE_SIZE] = { 0 };
+
+	/* derive the sub-key from the first 16 bytes of the nonce, the last 8 bytes form the ietf nonce */
+	chacha_hchacha(skey, key, nonce);
+	qsc_memutils_copy(snonce + 4, nonce + 16, 8);
+	chachapoly_load(ctx, skey, snonce, encrypt);
+	qsc_memutils_clear(skey, sizeof(skey));
+}
+
+void qsc_chachapoly_set_associated(qsc_chachapoly_state* ctx, const uint8_t* data, size_t length)
+{
+	assert(ctx != NULL);
+	assert(data != NULL);
+
+	if (length != 0)
+	{
+		qsc_poly1305_update(&ctx->mstate, data, length);
+		chachapoly_pad(ctx, length);
+		ctx->aadlen = (uint64_t)length;
+	}
+}
+
+bool qsc_chachapoly_transform(qsc_chachapoly_state* ctx, uint8_t* output, const uint8_t* input, size_t length)
+{
+	assert(ctx != NULL);
+	assert(output != NULL);
+	assert(input != NULL);
+
+	uint8_t code[QSC_CHACHAPOLY_MAC_SIZE] = { 0 };
+	bool res;
+
+	res = false;
+
+	if ((uint64_t)length <= CHACHAPOLY_MESSAGE_MAX)
+	{
+		if (ctx->encrypt == true)
+		{
+			/* encrypt the message, then mac the cipher-text and append the tag */
+			qsc_chacha_transform(&ctx->cstate, output, input, length);
+			qsc_poly1305_update(&ctx->mstate, output, length);
+			chachapoly_finalize(ctx, output + length, length);
+			res = true;
+		}
+		else
+		{
+			/* mac the cipher-text to a temp array for comparison */
+			qsc_poly1305_update(&ctx->mstate, input, length);
+			chachapoly_finalize(ctx, code, length);
+
+			/* test the tag for equality, bypassing the transform if the check fails */
+			if (qsc_intutils_verify(code, input + length, QSC_CHACHAPOLY_MAC_SIZE) == 0)
+			{
+				qsc_chacha_transform(&ctx->cstate, output, input, length);
+				res = true;
+			}
+		}
+	}
+
+	return res;
+}
@@ -26,6 +26,7 @@
 #define QSC_CHACHA20_H
 
 #include "common.h"
+#include "poly1305.h"
 
 /**
 * \file chacha.h
@@ -52,6 +53,26 @@
 * \endcode
 * An implementation of the ChaChaPoly20 stream cipher by Daniel J. Bernstein.
 * Implementation contains AVX, AVX2, and AVX512 intrinsics support.
+*
+* ChaCha20-Poly1305 AEAD example \n
+* \code
+*
+* uint8_t key[QSC_CHACHA_KEY256_SIZE] = {...};
+* uint8_t nonce[QSC_CHACHAPOLY_NONCE_SIZE] = {...};
+* uint8_t aad[20] = {...};
+* uint8_t msg[MSG_LEN] = {...};
+* uint8_t cpt[MSG_LEN + QSC_CHACHAPOLY_MAC_SIZE] = { 0 };
+*
+* qsc_chachapoly_state ctx;
+* qsc_chachapoly_initialize(&ctx, key, nonce, true);
+* qsc_chachapoly_set_associated(&ctx, aad, sizeof(aad));
+* qsc_chachapoly_transform(&ctx, cpt, msg, MSG_LEN);
+* qsc_chachapoly_dispose(&ctx);
+*
+* \endcode
+* The AEAD modes implement the IETF ChaCha20-Poly1305 construction (RFC 8439), with a 96-bit nonce
+* and a 32-bit block counter, and the XChaCha20-Poly1305 extended 192-bit nonce variant.
+* In decryption mode the tag is verified before the cipher-text is decrypted; if authentication fails, the output is not written.
 * \remarks For usage examples, see chacha_test.h
 */
 
@@ -85,6 +106,24 @@
 */
 #define QSC_CHACHA_ROUND_COUNT 20
 
+/*!
+* \def QSC_CHACHAPOLY_MAC_SIZE
+* \brief The size of the ChaCha20-Poly1305 authentication tag in bytes
+*/
+#define QSC_CHACHAPOLY_MAC_SIZE 16
+
+/*!
+* \def QSC_CHACHAPOLY_NONCE_SIZE
+* \brief The size of the IETF ChaCha20-Poly1305 nonce array in bytes
+*/
+#define QSC_CHACHAPOLY_NONCE_SIZE 12
+
+/*!
+* \def QSC_XCHACHAPOLY_NONCE_SIZE
+* \brief The size of the XChaCha20-Poly1305 extended nonce array in bytes
+*/
+#define QSC_XCHACHAPOLY_NONCE_SIZE 24
+
 /*!
 * \struct qsc_chacha_state
 * \brief Internal: contains the qsc_chacha_state state
@@ -140,4 +179,105 @@ QSC_EXPORT_API void qsc_chacha_initialize(qsc_chacha_state* ctx, const qsc_chach
 */
 QSC_EXPORT_API void qsc_chacha_transform(qsc_chacha_state* ctx, uint8_t* output, const uint8_t* input, size_t length);
 
+/**
+* \brief Set the position of the key-stream.
+* Sets the 64-bit block counter, so that the next transform starts at byte offset (position * QSC_CHACHA_BLOCK_SIZE) of the key-stream.
+*
+* \param ctx: [struct] The cipher state structure
+* \param position: The key-stream block index
+*/
+QSC_EXPORT_API void qsc_chacha_seek(qsc_chacha_state* ctx, uint64_t position);
+
+/**
+* \brief Transform a length of input text using multiple threads.
+* Large inputs are split across the available processor cores in cache-sized chunks,
+* each thread seeking to its own position in the key-stream.
+* The output and the state of the block counter are identical to the sequential transform.
+*
+* \param ctx: [struct] The cipher state structure
+* \param output: A pointer to the output byte array
+* \param input: [const] A pointer to the input byte array
+* \param length: The number of bytes to process
+*/
+QSC_EXPORT_API void qsc_chacha_parallel_transform(qsc_chacha_state* ctx, uint8_t* output, const uint8_t* input, size_t length);
+
+/*!
+* \struct qsc_chachapoly_state
+* \brief Internal: contains the ChaCha20-Poly1305 AEAD state
+*/
+QSC_EXPORT_API typedef struct
+{
+	qsc_chacha_state cstate;		/*!< The ChaCha cipher state */
+	qsc_poly1305_state mstate;		/*!< The Poly1305 MAC state */
+	uint64_t aadlen;				/*!< The length of the associated data */
+	bool encrypt;					/*!< The transformation mode; true for encryption */
+} qsc_chachapoly_state;
+
+/**
+* \brief Dispose of the ChaCha20-Poly1305 state.
+*
+* \warning The dispose function must be called when disposing of the cipher.
+* This function destroys internal arrays and data
+*
+* \param ctx: [struct] The AEAD state structure
+*/
+QSC_EXPORT_API void qsc_chachapoly_dispose(qsc_chachapoly_state* ctx);
+
+/**
+* \brief Initialize the IETF ChaCha20-Poly1305 (RFC 8439) state with the secret key and nonce.
+* The Poly1305 key is derived from the first key-stream block, and the block counter starts at one.
+*
+* \warning The key array must be 32 bytes in length
+* \warning The nonce array must be 12 bytes in length, and must never be reused with the same key
+*
+* \param ctx: [struct] The AEAD state structure
+* \param key: [const] The 32 byte secret key array
+* \param nonce: [const] The 12 byte nonce array
+* \param encrypt: The transformation mode; true for encryption, false for decryption
+*/
+QSC_EXPORT_API void qsc_chachapoly_initialize(qsc_chachapoly_state* ctx, const uint8_t* key, const uint8_t* nonce, bool encrypt);
+
+/**
+* \brief Initialize the XChaCha20-Poly1305 state with the secret key and extended nonce.
+* A sub-key is derived from the key and the first 16 bytes of the nonce with HChaCha20,
+* the remaining 8 bytes of the nonce are used with the IETF construction.
+*
+* \warning The key array must be 32 bytes in length
+* \warning The nonce array must be 24 bytes in length
+*
+* \param ctx: [struct] The AEAD state structure
+* \param key: [const] The 32 byte secret key array
+* \param nonce: [const] The 24 byte extended nonce array
+* \param encrypt: The transformation mode; true for encryption, false for decryption
+*/
+QSC_EXPORT_API void qsc_xchachapoly_initialize(qsc_chachapoly_state* ctx, const uint8_t* key, const uint8_t* nonce, bool encrypt);
+
+/**
+* \brief Set the associated data string used in authenticating the message.
+* The associated data is optional; if used, it must be set once, after initialization and before the transform is called.
+*
+* \param ctx: [struct] The AEAD state structure
+* \param data: [const] The associated data array
+* \param length: The associated data array length
+*/
+QSC_EXPORT_API void qsc_chachapoly_set_associated(qsc_chachapoly_state* ctx, const uint8_t* data, size_t length);
+
+/**
+* \brief Transform and authenticate a message.
+* In encryption mode, the cipher-text is written to the output, followed by the 16 byte authentication tag.
+* In decryption mode, the tag is expected at the end of the input array and is verified before the cipher-text is decrypted;
+* the output is not written if authentication fails.
+* The state is keyed for one message; re-initialize with a new nonce before processing the next message.
+*
+* \warning The input and output arrays must not overlap.
+* In encryption mode, the output array must be at least length + QSC_CHACHAPOLY_MAC_SIZE in size.
+*
+* \param ctx: [struct] The AEAD state structure
+* \param output: The output byte array
+* \param input: [const] The input byte array
+* \param length: The number of message bytes to process, not including the tag
+* \return Returns true for success, false if authentication fails or the message is too long
+*/
+QSC_EXPORT_API bool qsc_chachapoly_transform(qsc_chachapoly_state* ctx, uint8_t* output, const uint8_t* input, size_t length);
+
 #endif
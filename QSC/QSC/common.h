@@ -853,6 +853,14 @@
 */
 #define QSC_FALCON_S5SHAKE256F1024
 
+/*!
+\def QSC_FALCON_FPR_NATIVE
+* Use the native IEEE-754 double precision unit (SSE2) for floating-point arithmetic in the portable Falcon implementation on x86-64.
+* Division and square root remain emulated with integer arithmetic, because their native opcodes have an operand-dependent latency.
+* Remove this definition to use the integer floating-point emulation on all platforms.
+*/
+#define QSC_FALCON_FPR_NATIVE
+
 /*** SphincsPlus ***/
 
 /*!
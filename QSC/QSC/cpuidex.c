@@ -12,6 +12,7 @@ QSC_SYSTEM_CONDITION_IGNORE(5105)
 #	if defined(QSC_SYSTEM_ARCH_IX86)
 #		include <intrin.h>
 #		pragma intrinsic(__cpuid)
+#		pragma intrinsic(__cpuidex)
 #	elif defined(QSC_SYSTEM_ARCH_ARM)
 #		include <processthreadsapi.h>
 #	endif
@@ -398,6 +399,7 @@ static void cpuidex_arm_features(qsc_cpuidex_cpu_features* features)
 
 #	define CPUID_EBX_AVX2 0x00000020UL
 #	define CPUID_EBX_AVX512F 0x00010000UL
+#	define CPUID_EBX_AVX512IFMA 0x00200000UL
 #	define CPUID_EBX_ADX 0x00080000UL
 #	define CPUID_ECX_PCLMUL 0x00000002UL
 #	define CPUID_ECX_AESNI 0x02000000UL
@@ -407,6 +409,7 @@ static void cpuidex_arm_features(qsc_cpuidex_cpu_features* features)
 #	define CPUID_ECX_RDRAND 0x40000000UL
 #	define CPUID_EDX_RDTCSP 0x0000001BUL
 #	define CPUID_EBX_SHA2 0x20000000UL
+#	define CPUID_EAX_SHA512 0x00000001UL
 #	define XCR0_SSE 0x00000002UL
 #	define XCR0_AVX 0x00000004UL
 #	define XCR0_OPMASK 0x00000020UL
@@ -422,6 +425,17 @@ static void cpuidex_cpu_info(uint32_t info[4], const uint32_t infotype)
 #endif
 }
 
+#if defined(QSC_SYSTEM_HAS_AVX2)
+static void cpuidex_cpu_info_ex(uint32_t info[4], const uint32_t infotype, const uint32_t subtype)
+{
+#	if defined(QSC_SYSTEM_COMPILER_MSC)
+	__cpuidex((int*)info, infotype, subtype);
+#	elif defined(QSC_SYSTEM_COMPILER_GCC)
+	__cpuid_count(infotype, subtype, info[0], info[1], info[2], info[3]);
+#	endif
+}
+#endif
+
 static uint32_t cpuidex_read_bits(uint32_t value, int index, int length)
 {
 	int mask = ((1L << length) - 1) << index;
@@ -528,7 +542,7 @@ static void cpuidex_cpu_topology(qsc_cpuidex_cpu_features* features)
 		bool havx2;
 
 		qsc_memutils_clear(info, sizeof(info));
-		cpuidex_cpu_info(info, 0x00000007UL);
+		cpuidex_cpu_info_ex(info, 0x00000007UL, 0x00000000UL);
 
 #	if defined(QSC_SYSTEM_COMPILER_GCC)
 		__builtin_cpu_init();
@@ -540,6 +554,24 @@ static void cpuidex_cpu_topology(qsc_cpuidex_cpu_features* features)
 		features->adx = ((info[1] & CPUID_EBX_ADX) != 0x00000000UL);
 		features->avx2 = havx2 && ((uint32_t)_xgetbv(0) & 0x000000E6UL) != 0x00000000UL;
 		features->sha256 = ((info[1] & CPUID_EBX_SHA2) != 0x00000000UL);
+
+		/* the IFMA extension can be selected at runtime by builds that do not target AVX-512 */
+		if ((info[1] & (CPUID_EBX_AVX512F | CPUID_EBX_AVX512IFMA)) == (CPUID_EBX_AVX512F | CPUID_EBX_AVX512IFMA))
+		{
+			uint32_t xcr0 = (uint32_t)_xgetbv(0);
+
+			features->avx512ifma = ((xcr0 & (XCR0_OPMASK | XCR0_ZMM_HI256 | XCR0_HI16_ZMM)) ==
+				(XCR0_OPMASK | XCR0_ZMM_HI256 | XCR0_HI16_ZMM));
+		}
+
+		/* the SHA512 extension is reported in sub-leaf 1 */
+		if (info[0] >= 0x00000001UL)
+		{
+			uint32_t sinf[4] = { 0 };
+
+			cpuidex_cpu_info_ex(sinf, 0x00000007UL, 0x00000001UL);
+			features->sha512 = ((sinf[0] & CPUID_EAX_SHA512) != 0x00000000UL);
+		}
 #endif
 
 #if defined(QSC_SYSTEM_HAS_AVX512)
@@ -731,6 +763,14 @@ static void cpuidex_bsd_topology(qsc_cpuidex_cpu_features* features)
 		features->avx512f = (pval == 1);
 	}
 
+	pval = 0;
+	plen = sizeof(pval);
+
+	if (sysctlbyname("hw.optional.avx512ifma", &pval, &plen, NULL, 0) == 0)
+	{
+		features->avx512ifma = (pval == 1);
+	}
+
 	features->pcmul = features->avx;
 
 	pval = 0;
@@ -887,6 +927,7 @@ bool qsc_cpuidex_features_set(qsc_cpuidex_cpu_features* features)
     features->avx = false;
     features->avx2 = false;
     features->avx512f = false;
+    features->avx512ifma = false;
     features->hyperthread = false;
     features->rdrand = false;
     features->rdtcsp = false;
@@ -974,6 +1015,9 @@ void qsc_cpuidex_print_stats()
 		qsc_consoleutils_print_safe("AVX512: ");
 		qsc_consoleutils_print_line(cfeat.avx512f == true ? st : sf);
 
+		qsc_consoleutils_print_safe("AVX512IFMA: ");
+		qsc_consoleutils_print_line(cfeat.avx512ifma == true ? st : sf);
+
 		qsc_consoleutils_print_safe("Hyperthread: ");
 		qsc_consoleutils_print_line(cfeat.hyperthread == true ? st : sf);
 
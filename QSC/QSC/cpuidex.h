@@ -80,6 +80,7 @@ QSC_EXPORT_API typedef struct qsc_cpuidex_cpu_features
     bool avx;                               	/*!< The AVX flag */
     bool avx2;                              	/*!< The AVX2 flag */
     bool avx512f;                           	/*!< The AVX512F flag */
+    bool avx512ifma;                        	/*!< The AVX512 IFMA flag */
     bool hyperthread;                       	/*!< The hyper-thread flag */
     bool rdrand;                            	/*!< The RDRAND flag */
     bool rdtcsp;                            	/*!< The RDTCSP flag */
@@ -1,4 +1,5 @@
 #include "csx.h"
+#include "async.h"
 #include "intutils.h"
 #include "memutils.h"
 
@@ -22,6 +23,12 @@
 #define CSX_AVX512_BLOCK (8 * QSC_CSX_BLOCK_SIZE)
 #define CSX_AVX2_BLOCK (4 * QSC_CSX_BLOCK_SIZE)
 
+/*!
+\def CSX_PARALLEL_CHUNK
+* \brief The cache-sized work unit of the parallel transform
+*/
+#define CSX_PARALLEL_CHUNK (64 * 1024)
+
 static const uint8_t csx_info[QSC_CSX_INFO_SIZE] =
 {
 	0x43, 0x53, 0x58, 0x35, 0x31, 0x32, 0x20, 0x4B, 0x4D, 0x41, 0x43, 0x20, 0x61, 0x75, 0x74, 0x68,
@@ -54,6 +61,16 @@ static void csx_increment(qsc_csx_state* ctx)
 	}
 }
 
+static void csx_counter_add(uint64_t* counter, uint64_t blocks)
+{
+	counter[0] += blocks;
+
+	if (counter[0] < blocks)
+	{
+		++counter[1];
+	}
+}
+
 static void csx_permute_p1024c(const qsc_csx_state* ctx, uint8_t* output)
 {
 	uint64_t X0 = ctx->state[0];
@@ -680,6 +697,97 @@ static void csx_load_key(qsc_csx_state* ctx, const uint8_t* key, const uint8_t*
 	ctx->state[15] = qsc_intutils_le8to64((code + 40));
 
 #endif
+
+	ctx->origin[0] = ctx->state[12];
+	ctx->origin[1] = ctx->state[13];
+}
+
+typedef struct
+{
+	uint64_t state[QSC_CSX_STATE_SIZE];
+	uint8_t* output;
+	const uint8_t* input;
+	size_t length;
+} csx_parallel_task;
+
+static void csx_parallel_worker(void* state)
+{
+	csx_parallel_task* task = (csx_parallel_task*)state;
+	qsc_csx_state ctx;
+
+	qsc_memutils_copy((uint8_t*)ctx.state, (const uint8_t*)task->state, sizeof(ctx.state));
+	csx_transform(&ctx, task->output, task->input, task->length);
+	qsc_memutils_clear((uint8_t*)ctx.state, sizeof(ctx.state));
+	qsc_memutils_clear((uint8_t*)task->state, sizeof(task->state));
+}
+
+static void csx_parallel_transform(qsc_csx_state* ctx, uint8_t* output, const uint8_t* input, size_t length)
+{
+	qsc_thread thds[QSC_ASYNC_PARALLEL_MAX] = { 0 };
+	csx_parallel_task* tasks;
+	size_t cnks;
+	size_t i;
+	size_t oft;
+	size_t scnt;
+	size_t tcnt;
+	size_t tlen;
+
+	tasks = NULL;
+	cnks = (length + CSX_PARALLEL_CHUNK - 1) / CSX_PARALLEL_CHUNK;
+	tcnt = qsc_intutils_min(qsc_async_processor_count(), (size_t)QSC_ASYNC_PARALLEL_MAX);
+	tcnt = qsc_intutils_min(tcnt, cnks);
+
+	if (tcnt > 1)
+	{
+		tasks = (csx_parallel_task*)qsc_memutils_malloc(tcnt * sizeof(csx_parallel_task));
+	}
+
+	if (tasks != NULL)
+	{
+		oft = 0;
+
+		/* each thread receives a contiguous run of chunks, and a copy of the state advanced to its offset */
+		for (i = 0; i < tcnt; ++i)
+		{
+			tlen = ((cnks / tcnt) + ((i < cnks % tcnt) ? 1 : 0)) * CSX_PARALLEL_CHUNK;
+			tlen = qsc_intutils_min(tlen, length - oft);
+
+			qsc_memutils_copy((uint8_t*)tasks[i].state, (const uint8_t*)ctx->state, sizeof(ctx->state));
+			csx_counter_add(tasks[i].state + 12, oft / QSC_CSX_BLOCK_SIZE);
+			tasks[i].output = output + oft;
+			tasks[i].input = input + oft;
+			tasks[i].length = tlen;
+			oft += tlen;
+		}
+
+		/* if a worker cannot be started, its chunk and those after it are transformed on the calling thread */
+		for (i = 0; i < tcnt; ++i)
+		{
+			thds[i] = qsc_async_thread_create(csx_parallel_worker, &tasks[i]);
+
+			if (thds[i] == 0)
+			{
+				break;
+			}
+		}
+
+		scnt = i;
+
+		for (; i < tcnt; ++i)
+		{
+			csx_parallel_worker(&tasks[i]);
+		}
+
+		qsc_async_thread_wait_all(thds, scnt);
+		qsc_memutils_alloc_free(tasks);
+
+		/* advance the counter past the last, possibly partial, block */
+		csx_counter_add(ctx->state + 12, (length + QSC_CSX_BLOCK_SIZE - 1) / QSC_CSX_BLOCK_SIZE);
+	}
+	else
+	{
+		csx_transform(ctx, output, input, length);
+	}
 }
 
 #if	defined(QSC_CSX_AUTHENTICATED)
@@ -702,8 +810,317 @@ static void csx_finalize(qsc_csx_state* ctx, uint8_t* output)
 }
 #endif
 
+/* multi-stream scheduler */
+
+#if defined(QSC_SYSTEM_HAS_AVX512) || defined(QSC_SYSTEM_HAS_AVX2)
+
+typedef struct
+{
+	uint64_t state[QSC_CSX_STATE_SIZE][QSC_CSX_PARALLEL_LANES];
+	uint64_t outw[QSC_CSX_STATE_SIZE][QSC_CSX_PARALLEL_LANES];
+	qsc_csx_stream* stream[QSC_CSX_PARALLEL_LANES];
+	size_t offset[QSC_CSX_PARALLEL_LANES];
+} csx_lane_state;
+
+static int csx_stream_compare(const void* a, const void* b)
+{
+	const qsc_csx_stream* sa = *(qsc_csx_stream* const*)a;
+	const qsc_csx_stream* sb = *(qsc_csx_stream* const*)b;
+
+	/* longest first, so streams in the same lanes complete together */
+	return (sa->length < sb->length) ? 1 : ((sa->length > sb->length) ? -1 : 0);
+}
+
+static void csx_lanes_permute(csx_lane_state* lanes)
+{
+	size_t i;
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+	csx_avx512_state ctxw;
+
+	for (i = 0; i < QSC_CSX_STATE_SIZE; ++i)
+	{
+		ctxw.state[i] = _mm512_loadu_si512((const __m512i*)lanes->state[i]);
+	}
+
+	csx_permute_p8x1024h(&ctxw);
+
+	for (i = 0; i < QSC_CSX_STATE_SIZE; ++i)
+	{
+		_mm512_storeu_si512((__m512i*)lanes->outw[i], ctxw.outw[i]);
+	}
+#else
+	csx_avx256_state ctxw;
+
+	for (i = 0; i < QSC_CSX_STATE_SIZE; ++i)
+	{
+		ctxw.state[i] = _mm256_loadu_si256((const __m256i*)lanes->state[i]);
+	}
+
+	csx_permute_p4x1024h(&ctxw);
+
+	for (i = 0; i < QSC_CSX_STATE_SIZE; ++i)
+	{
+		_mm256_storeu_si256((__m256i*)lanes->outw[i], ctxw.outw[i]);
+	}
+#endif
+}
+
+static void csx_lane_load(csx_lane_state* lanes, size_t lane, qsc_csx_stream* stream)
+{
+	lanes->stream[lane] = stream;
+	lanes->offset[lane] = 0;
+
+	for (size_t i = 0; i < QSC_CSX_STATE_SIZE; ++i)
+	{
+		lanes->state[i][lane] = stream->ctx->state[i];
+	}
+}
+
+static void csx_lane_store(csx_lane_state* lanes, size_t lane)
+{
+	/* only the counter words change during a transform */
+	lanes->stream[lane]->ctx->state[12] = lanes->state[12][lane];
+	lanes->stream[lane]->ctx->state[13] = lanes->state[13][lane];
+	lanes->stream[lane] = NULL;
+}
+
+static void csx_lane_transform(csx_lane_state* lanes, size_t lane)
+{
+	uint8_t tmp[QSC_CSX_BLOCK_SIZE];
+	qsc_csx_stream* stream;
+	size_t blen;
+	size_t i;
+
+	stream = lanes->stream[lane];
+	blen = qsc_intutils_min(stream->length - lanes->offset[lane], QSC_CSX_BLOCK_SIZE);
+
+	for (i = 0; i < QSC_CSX_STATE_SIZE; ++i)
+	{
+		qsc_intutils_le64to8(tmp + (i * sizeof(uint64_t)), lanes->outw[i][lane]);
+	}
+
+	qsc_memutils_copy(stream->output + lanes->offset[lane], tmp, blen);
+	qsc_memutils_xor(stream->output + lanes->offset[lane], stream->input + lanes->offset[lane], blen);
+	lanes->offset[lane] += blen;
+
+	/* increment the lane nonce */
+	++lanes->state[12][lane];
+
+	if (lanes->state[12][lane] == 0)
+	{
+		++lanes->state[13][lane];
+	}
+}
+
+static void csx_streams_transform(qsc_csx_stream** queue, size_t count)
+{
+	csx_lane_state lanes;
+	size_t active;
+	size_t lane;
+	size_t next;
+
+	qsc_memutils_clear(&lanes, sizeof(lanes));
+	active = 0;
+	next = 0;
+
+	/* fill the lanes with the longest streams */
+	for (lane = 0; lane < QSC_CSX_PARALLEL_LANES && next < count; ++lane)
+	{
+		csx_lane_load(&lanes, lane, queue[next]);
+		++active;
+		++next;
+	}
+
+	while (active != 0)
+	{
+		if (active == 1 && next == count)
+		{
+			/* a single stream remains; finish it with the sequential transform */
+			for (lane = 0; lane < QSC_CSX_PARALLEL_LANES; ++lane)
+			{
+				if (lanes.stream[lane] != NULL)
+				{
+					qsc_csx_stream* stream = lanes.stream[lane];
+					const size_t OFT = lanes.offset[lane];
+
+					csx_lane_store(&lanes, lane);
+					csx_transform(stream->ctx, stream->output + OFT, stream->input + OFT, stream->length - OFT);
+				}
+			}
+
+			break;
+		}
+
+		csx_lanes_permute(&lanes);
+
+		for (lane = 0; lane < QSC_CSX_PARALLEL_LANES; ++lane)
+		{
+			if (lanes.stream[lane] != NULL)
+			{
+				csx_lane_transform(&lanes, lane);
+
+				if (lanes.offset[lane] == lanes.stream[lane]->length)
+				{
+					/* retire the completed stream and refill the lane from the queue */
+					csx_lane_store(&lanes, lane);
+					--active;
+
+					if (next < count)
+					{
+						csx_lane_load(&lanes, lane, queue[next]);
+						++active;
+						++next;
+					}
+				}
+			}
+		}
+	}
+
+	qsc_memutils_clear(&lanes, sizeof(lanes));
+}
+
+static bool csx_stream_prepare(qsc_csx_stream* stream)
+{
+	bool res;
+
+#if defined(QSC_CSX_AUTHENTICATED)
+
+	uint8_t ncopy[QSC_CSX_NONCE_SIZE] = { 0 };
+	qsc_csx_state* ctx = stream->ctx;
+
+	res = true;
+
+	/* store the nonce */
+	qsc_intutils_le64to8(ncopy, ctx->state[12]);
+	qsc_intutils_le64to8(ncopy + sizeof(uint64_t), ctx->state[13]);
+
+	/* update the processed bytes counter */
+	ctx->counter += stream->length;
+
+	/* update the mac with the nonce */
+	csx_mac_update(ctx, ncopy, sizeof(ncopy));
+
+	if (ctx->encrypt == false)
+	{
+		uint8_t code[QSC_CSX_MAC_SIZE] = { 0 };
+
+		/* authenticate the cipher-text before it is queued for decryption */
+		csx_mac_update(ctx, stream->input, stream->length);
+		csx_finalize(ctx, code);
+		res = (qsc_intutils_verify(code, stream->input + stream->length, QSC_CSX_MAC_SIZE) == 0);
+	}
+
+#else
+
+	(void)stream;
+	res = true;
+
+#endif
+
+	return res;
+}
+
+static void csx_stream_complete(qsc_csx_stream* stream)
+{
+#if defined(QSC_CSX_AUTHENTICATED)
+	if (stream->ctx->encrypt == true)
+	{
+		/* mac the cipher-text appending the code to the end of the array */
+		csx_mac_update(stream->ctx, stream->output, stream->length);
+		csx_finalize(stream->ctx, stream->output + stream->length);
+	}
+#else
+	(void)stream;
+#endif
+}
+
+#endif
+
 /* csx common */
 
+static bool csx_message_transform(qsc_csx_state* ctx, uint8_t* output, const uint8_t* input, size_t length, bool parallel)
+{
+	bool res;
+
+#if defined(QSC_CSX_AUTHENTICATED)
+
+	uint8_t ncopy[QSC_CSX_NONCE_SIZE] = { 0 };
+	res = false;
+
+	/* store the nonce */
+	qsc_intutils_le64to8(ncopy, ctx->state[12]);
+	qsc_intutils_le64to8(ncopy + sizeof(uint64_t), ctx->state[13]);
+
+	/* update the processed bytes counter */
+	ctx->counter += length;
+
+	/* update the mac with the nonce */
+	csx_mac_update(ctx, ncopy, sizeof(ncopy));
+
+	if (ctx->encrypt)
+	{
+		/* use the transform to generate the key-stream and encrypt the data  */
+		if (parallel == true)
+		{
+			csx_parallel_transform(ctx, output, input, length);
+		}
+		else
+		{
+			csx_transform(ctx, output, input, length);
+		}
+
+		/* update the mac with the cipher-text */
+		csx_mac_update(ctx, output, length);
+
+		/* mac the cipher-text appending the code to the end of the array */
+		csx_finalize(ctx, output + length);
+		res = true;
+	}
+	else
+	{
+		uint8_t code[QSC_CSX_MAC_SIZE] = { 0 };
+
+		/* update the mac with the cipher-text */
+		csx_mac_update(ctx, input, length);
+
+		/* generate the internal mac code */
+		csx_finalize(ctx, code);
+
+		/* compare the mac code with the one embedded in the cipher-text, bypassing the transform if the mac check fails */
+		if (qsc_intutils_verify(code, input + length, QSC_CSX_MAC_SIZE) == 0)
+		{
+			/* generate the key-stream and decrypt the array */
+			if (parallel == true)
+			{
+				csx_parallel_transform(ctx, output, input, length);
+			}
+			else
+			{
+				csx_transform(ctx, output, input, length);
+			}
+			res = true;
+		}
+	}
+
+#else
+
+	if (parallel == true)
+	{
+		csx_parallel_transform(ctx, output, input, length);
+	}
+	else
+	{
+		csx_transform(ctx, output, input, length);
+	}
+
+	res = true;
+
+#endif
+
+	return res;
+}
+
 void qsc_csx_dispose(qsc_csx_state* ctx)
 {
 	assert(ctx != NULL);
@@ -816,62 +1233,7 @@ bool qsc_csx_transform(qsc_csx_state* ctx, uint8_t* output, const uint8_t* input
 	assert(output != NULL);
 	assert(input != NULL);
 
-	bool res;
-
-#if defined(QSC_CSX_AUTHENTICATED)
-
-	uint8_t ncopy[QSC_CSX_NONCE_SIZE] = { 0 };
-	res = false;
-
-	/* store the nonce */
-	qsc_intutils_le64to8(ncopy, ctx->state[12]);
-	qsc_intutils_le64to8(ncopy + sizeof(uint64_t), ctx->state[13]);
-
-	/* update the processed bytes counter */
-	ctx->counter += length;
-
-	/* update the mac with the nonce */
-	csx_mac_update(ctx, ncopy, sizeof(ncopy));
-
-	if (ctx->encrypt)
-	{
-		/* use the transform to generate the key-stream and encrypt the data  */
-		csx_transform(ctx, output, input, length);
-
-		/* update the mac with the cipher-text */
-		csx_mac_update(ctx, output, length);
-
-		/* mac the cipher-text appending the code to the end of the array */
-		csx_finalize(ctx, output + length);
-		res = true;
-	}
-	else
-	{
-		uint8_t code[QSC_CSX_MAC_SIZE] = { 0 };
-
-		/* update the mac with the cipher-text */
-		csx_mac_update(ctx, input, length);
-
-		/* generate the internal mac code */
-		csx_finalize(ctx, code);
-
-		/* compare the mac code with the one embedded in the cipher-text, bypassing the transform if the mac check fails */
-		if (qsc_intutils_verify(code, input + length, QSC_CSX_MAC_SIZE) == 0)
-		{
-			/* generate the key-stream and decrypt the array */
-			csx_transform(ctx, output, input, length);
-			res = true;
-		}
-	}
-
-#else
-
-	csx_transform(ctx, output, input, length);
-	res = true;
-
-#endif
-
-	return res;
+	return csx_message_transform(ctx, output, input, length, false);
 }
 
 bool qsc_csx_extended_transform(qsc_csx_state* ctx, uint8_t* output, const uint8_t* input, size_t length, bool finalize)
@@ -950,3 +1312,86 @@ bool qsc_csx_extended_transform(qsc_csx_state* ctx, uint8_t* output, const uint8
 
 	return res;
 }
+
+bool qsc_csx_transform_streams(qsc_csx_stream* streams, size_t count)
+{
+	assert(streams != NULL);
+
+	size_t i;
+	bool res;
+
+	res = true;
+
+	if (streams != NULL)
+	{
+#if defined(QSC_SYSTEM_HAS_AVX512) || defined(QSC_SYSTEM_HAS_AVX2)
+		qsc_csx_stream** queue;
+		size_t qlen;
+
+		queue = (qsc_csx_stream**)qsc_memutils_malloc(count * sizeof(qsc_csx_stream*));
+
+		if (queue != NULL)
+		{
+			qlen = 0;
+
+			/* authenticate and queue the streams */
+			for (i = 0; i < count; ++i)
+			{
+				streams[i].result = csx_stream_prepare(&streams[i]);
+
+				if (streams[i].result == true && streams[i].length != 0)
+				{
+					queue[qlen] = &streams[i];
+					++qlen;
+				}
+
+				res &= streams[i].result;
+			}
+
+			/* group the pending streams by length */
+			qsort(queue, qlen, sizeof(qsc_csx_stream*), csx_stream_compare);
+
+			/* generate the key-streams in parallel lanes */
+			csx_streams_transform(queue, qlen);
+
+			for (i = 0; i < count; ++i)
+			{
+				if (streams[i].result == true)
+				{
+					csx_stream_complete(&streams[i]);
+				}
+			}
+
+			qsc_memutils_alloc_free(queue);
+		}
+		else
+#endif
+		{
+			for (i = 0; i < count; ++i)
+			{
+				streams[i].result = qsc_csx_transform(streams[i].ctx, streams[i].output, streams[i].input, streams[i].length);
+				res &= streams[i].result;
+			}
+		}
+	}
+
+	return res;
+}
+
+void qsc_csx_seek(qsc_csx_state* ctx, uint64_t position)
+{
+	assert(ctx != NULL);
+
+	ctx->state[12] = ctx->origin[0];
+	ctx->state[13] = ctx->origin[1];
+	csx_counter_add(ctx->state + 12, position);
+}
+
+bool qsc_csx_parallel_transform(qsc_csx_state* ctx, uint8_t* output, const uint8_t* input, size_t length)
+{
+	assert(ctx != NULL);
+	assert(output != NULL);
+	assert(input != NULL);
+
+	return csx_message_transform(ctx, output, input, length, true);
+}
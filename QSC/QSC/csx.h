@@ -185,6 +185,18 @@
 */
 #define QSC_CSX_STATE_SIZE 16
 
+/*!
+\def QSC_CSX_PARALLEL_LANES
+* \brief The number of independent cipher streams processed in parallel by the multi-stream transform
+*/
+#if defined(QSC_SYSTEM_HAS_AVX512)
+#	define QSC_CSX_PARALLEL_LANES 8
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+#	define QSC_CSX_PARALLEL_LANES 4
+#else
+#	define QSC_CSX_PARALLEL_LANES 1
+#endif
+
 /*! 
 * \struct qsc_csx_keyparams
 * \brief The key parameters structure containing key, nonce, and info arrays and lengths.
@@ -214,10 +226,25 @@ QSC_EXPORT_API typedef struct
 #else
 	qsc_keccak_state kstate;				/*!< the KMAC state structure */
 #endif
+	uint64_t origin[2];						/*!< the initial block counter, loaded from the nonce */
 	uint64_t counter;						/*!< the processed bytes counter */
 	bool encrypt;							/*!< the transformation mode; true for encryption */
 } qsc_csx_state;
 
+/*! 
+* \struct qsc_csx_stream
+* \brief A multi-stream transform record; an initialized cipher state, and the input and output arrays of one message.
+* Every record in a set must reference a different cipher state.
+*/
+QSC_EXPORT_API typedef struct
+{
+	qsc_csx_state* ctx;						/*!< the initialized cipher state of this stream */
+	uint8_t* output;						/*!< the output array; in authenticated encryption mode length + QSC_CSX_MAC_SIZE bytes */
+	const uint8_t* input;					/*!< the input array; in authenticated decryption mode length + QSC_CSX_MAC_SIZE bytes */
+	size_t length;							/*!< the number of message bytes to transform */
+	bool result;							/*!< set by the transform; false if the stream failed authentication */
+} qsc_csx_stream;
+
 /* public functions */
 
 /**
@@ -292,4 +319,48 @@ QSC_EXPORT_API bool qsc_csx_transform(qsc_csx_state* ctx, uint8_t* output, const
 */
 QSC_EXPORT_API bool qsc_csx_extended_transform(qsc_csx_state* ctx, uint8_t* output, const uint8_t* input, size_t length, bool finalize);
 
+/**
+* \brief Transform a set of independent messages, each under its own cipher state.
+* Up to QSC_CSX_PARALLEL_LANES key-streams are generated in parallel SIMD lanes (8 with AVX-512, 4 with AVX2).
+* The records are scheduled longest first, and a lane that completes its message is refilled from the pending set,
+* so messages of similar length share the lanes and short records do not stall on long ones. \n
+* Each record is transformed exactly as a qsc_csx_transform call on its state would transform it;
+* the states may be in either encryption or decryption mode, and the result member of each record is set to the outcome of its transform.
+*
+* \warning Each state must be initialized, and no two records may reference the same state
+*
+* \param streams: [struct] The array of stream records
+* \param count: The number of records in the array
+*
+* \return: Returns true if every record was transformed successfully, false if any record failed authentication
+*/
+QSC_EXPORT_API bool qsc_csx_transform_streams(qsc_csx_stream* streams, size_t count);
+
+/**
+* \brief Set the position of the key-stream.
+* Sets the 128-bit block counter to the initial nonce plus the position,
+* so that the next transform starts at byte offset (position * QSC_CSX_BLOCK_SIZE) of the key-stream.
+* In authenticated mode, the counter is also the nonce added to the MAC by the next transform.
+*
+* \param ctx: [struct] The cipher state structure
+* \param position: The key-stream block index
+*/
+QSC_EXPORT_API void qsc_csx_seek(qsc_csx_state* ctx, uint64_t position);
+
+/**
+* \brief Transform and authenticate a length of input text, using multiple threads to generate the key-stream.
+* Large inputs are split across the available processor cores in cache-sized chunks,
+* each thread seeking to its own position in the key-stream; the MAC is computed on the calling thread.
+* The output, MAC code, and the state of the block counter are identical to the sequential qsc_csx_transform function.
+*
+* \warning In authenticated encryption mode, the output array must be at least length + QSC_CSX_MAC_SIZE in size.
+*
+* \param ctx: [struct] The cipher state structure
+* \param output: A pointer to the output byte array
+* \param input: [const] A pointer to the input byte array
+* \param length: The number of bytes to process
+* \return Returns false if authentication fails
+*/
+QSC_EXPORT_API bool qsc_csx_parallel_transform(qsc_csx_state* ctx, uint8_t* output, const uint8_t* input, size_t length);
+
 #endif
@@ -5,6 +5,41 @@
 #else
 #	include "dilithiumbase.h"
 #endif
+#include "memutils.h"
+
+void qsc_dilithium_expand_privatekey(qsc_dilithium_expanded_privatekey* expanded, const uint8_t* privatekey)
+{
+	assert(expanded != NULL);
+	assert(privatekey != NULL);
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+	qsc_dilithium_avx2_expand_privatekey(expanded, privatekey);
+#else
+	qsc_dilithium_ref_expand_privatekey(expanded, privatekey);
+#endif
+}
+
+void qsc_dilithium_expand_publickey(qsc_dilithium_expanded_publickey* expanded, const uint8_t* publickey)
+{
+	assert(expanded != NULL);
+	assert(publickey != NULL);
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+	qsc_dilithium_avx2_expand_publickey(expanded, publickey);
+#else
+	qsc_dilithium_ref_expand_publickey(expanded, publickey);
+#endif
+}
+
+void qsc_dilithium_expanded_privatekey_dispose(qsc_dilithium_expanded_privatekey* expanded)
+{
+	assert(expanded != NULL);
+
+	if (expanded != NULL)
+	{
+		qsc_memutils_clear((uint8_t*)expanded, sizeof(qsc_dilithium_expanded_privatekey));
+	}
+}
 
 void qsc_dilithium_generate_keypair(uint8_t* publickey, uint8_t* privatekey, bool (*rng_generate)(uint8_t*, size_t))
 {
@@ -34,6 +69,21 @@ void qsc_dilithium_sign(uint8_t* signedmsg, size_t* smsglen, const uint8_t* mess
 #endif
 }
 
+void qsc_dilithium_sign_expanded(uint8_t* signedmsg, size_t* smsglen, const uint8_t* message, size_t msglen, const qsc_dilithium_expanded_privatekey* privatekey, bool (*rng_generate)(uint8_t*, size_t))
+{
+	assert(signedmsg != NULL);
+	assert(smsglen != NULL);
+	assert(message != NULL);
+	assert(privatekey != NULL);
+	assert(rng_generate != NULL);
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+	qsc_dilithium_avx2_sign_expanded(signedmsg, smsglen, message, msglen, privatekey, rng_generate);
+#else
+	qsc_dilithium_ref_sign_expanded(signedmsg, smsglen, message, msglen, privatekey, rng_generate);
+#endif
+}
+
 bool qsc_dilithium_verify(uint8_t* message, size_t* msglen, const uint8_t* signedmsg, size_t smsglen, const uint8_t* publickey)
 {
 	assert(message != NULL);
@@ -51,3 +101,173 @@ bool qsc_dilithium_verify(uint8_t* message, size_t* msglen, const uint8_t* signe
 
 	return res;
 }
+
+bool qsc_dilithium_verify_expanded(uint8_t* message, size_t* msglen, const uint8_t* signedmsg, size_t smsglen, const qsc_dilithium_expanded_publickey* publickey)
+{
+	assert(message != NULL);
+	assert(msglen != NULL);
+	assert(signedmsg != NULL);
+	assert(publickey != NULL);
+
+	bool res;
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+	res = qsc_dilithium_avx2_open_expanded(message, msglen, signedmsg, smsglen, publickey);
+#else
+	res = qsc_dilithium_ref_open_expanded(message, msglen, signedmsg, smsglen, publickey);
+#endif
+
+	return res;
+}
+
+void qsc_dilithium_sign_detached(uint8_t* signature, size_t* siglen, const uint8_t* message, size_t msglen, const uint8_t* privatekey, bool (*rng_generate)(uint8_t*, size_t))
+{
+	assert(signature != NULL);
+	assert(siglen != NULL);
+	assert(message != NULL);
+	assert(privatekey != NULL);
+	assert(rng_generate != NULL);
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+	qsc_dilithium_avx2_sign_signature(signature, siglen, message, msglen, privatekey, rng_generate);
+#else
+	qsc_dilithium_ref_sign_signature(signature, siglen, message, msglen, privatekey, rng_generate);
+#endif
+}
+
+bool qsc_dilithium_verify_detached(const uint8_t* signature, size_t siglen, const uint8_t* message, size_t msglen, const uint8_t* publickey)
+{
+	assert(signature != NULL);
+	assert(message != NULL);
+	assert(publickey != NULL);
+
+	bool res;
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+	res = qsc_dilithium_avx2_verify(signature, siglen, message, msglen, publickey);
+#else
+	res = qsc_dilithium_ref_verify(signature, siglen, message, msglen, publickey);
+#endif
+
+	return res;
+}
+
+void qsc_dilithium_sign_detached_parallel(uint8_t* signature, size_t* siglen, const uint8_t* message, size_t msglen, const uint8_t* privatekey, bool (*rng_generate)(uint8_t*, size_t))
+{
+	assert(signature != NULL);
+	assert(siglen != NULL);
+	assert(message != NULL);
+	assert(privatekey != NULL);
+	assert(rng_generate != NULL);
+
+	qsc_dilithium_expanded_privatekey esk;
+	qsc_keccak_state kstate;
+	uint8_t mu[QSC_DILITHIUM_CRH_SIZE];
+
+	/* the public key hash tr follows the rho and key seeds in the private key */
+	qsc_keccak_initialize_state(&kstate);
+	qsc_keccak_incremental_absorb(&kstate, QSC_KECCAK_256_RATE, privatekey + (2 * QSC_DILITHIUM_SEED_SIZE), QSC_DILITHIUM_CRH_SIZE);
+	qsc_keccak_incremental_absorb(&kstate, QSC_KECCAK_256_RATE, message, msglen);
+	qsc_keccak_incremental_finalize(&kstate, QSC_KECCAK_256_RATE, QSC_KECCAK_SHAKE_DOMAIN_ID);
+	qsc_keccak_incremental_squeeze(&kstate, QSC_KECCAK_256_RATE, mu, sizeof(mu));
+	qsc_keccak_dispose(&kstate);
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+	qsc_dilithium_avx2_expand_privatekey(&esk, privatekey);
+	qsc_dilithium_avx2_sign_signature_mu_parallel(signature, siglen, mu, &esk, rng_generate);
+#else
+	qsc_dilithium_ref_expand_privatekey(&esk, privatekey);
+	qsc_dilithium_ref_sign_signature_mu_parallel(signature, siglen, mu, &esk, rng_generate);
+#endif
+
+	qsc_dilithium_expanded_privatekey_dispose(&esk);
+}
+
+void qsc_dilithium_sign_initialize(qsc_dilithium_stream_state* state, const uint8_t* privatekey)
+{
+	assert(state != NULL);
+	assert(privatekey != NULL);
+
+	/* the public key hash tr follows the rho and key seeds in the private key */
+	qsc_keccak_initialize_state(&state->kstate);
+	qsc_keccak_incremental_absorb(&state->kstate, QSC_KECCAK_256_RATE, privatekey + (2 * QSC_DILITHIUM_SEED_SIZE), QSC_DILITHIUM_CRH_SIZE);
+}
+
+void qsc_dilithium_sign_update(qsc_dilithium_stream_state* state, const uint8_t* message, size_t msglen)
+{
+	assert(state != NULL);
+	assert(message != NULL);
+
+	qsc_keccak_incremental_absorb(&state->kstate, QSC_KECCAK_256_RATE, message, msglen);
+}
+
+void qsc_dilithium_sign_finalize(qsc_dilithium_stream_state* state, uint8_t* signature, size_t* siglen, const uint8_t* privatekey, bool (*rng_generate)(uint8_t*, size_t))
+{
+	assert(state != NULL);
+	assert(signature != NULL);
+	assert(siglen != NULL);
+	assert(privatekey != NULL);
+	assert(rng_generate != NULL);
+
+	qsc_dilithium_expanded_privatekey esk;
+	uint8_t mu[QSC_DILITHIUM_CRH_SIZE];
+
+	qsc_keccak_incremental_finalize(&state->kstate, QSC_KECCAK_256_RATE, QSC_KECCAK_SHAKE_DOMAIN_ID);
+	qsc_keccak_incremental_squeeze(&state->kstate, QSC_KECCAK_256_RATE, mu, sizeof(mu));
+	qsc_keccak_dispose(&state->kstate);
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+	qsc_dilithium_avx2_expand_privatekey(&esk, privatekey);
+	qsc_dilithium_avx2_sign_signature_mu(signature, siglen, mu, &esk, rng_generate);
+#else
+	qsc_dilithium_ref_expand_privatekey(&esk, privatekey);
+	qsc_dilithium_ref_sign_signature_mu(signature, siglen, mu, &esk, rng_generate);
+#endif
+
+	qsc_dilithium_expanded_privatekey_dispose(&esk);
+}
+
+void qsc_dilithium_verify_initialize(qsc_dilithium_stream_state* state, const uint8_t* publickey)
+{
+	assert(state != NULL);
+	assert(publickey != NULL);
+
+	uint8_t tr[QSC_DILITHIUM_CRH_SIZE];
+
+	qsc_shake256_compute(tr, sizeof(tr), publickey, QSC_DILITHIUM_PUBLICKEY_SIZE);
+	qsc_keccak_initialize_state(&state->kstate);
+	qsc_keccak_incremental_absorb(&state->kstate, QSC_KECCAK_256_RATE, tr, sizeof(tr));
+}
+
+void qsc_dilithium_verify_update(qsc_dilithium_stream_state* state, const uint8_t* message, size_t msglen)
+{
+	assert(state != NULL);
+	assert(message != NULL);
+
+	qsc_keccak_incremental_absorb(&state->kstate, QSC_KECCAK_256_RATE, message, msglen);
+}
+
+bool qsc_dilithium_verify_finalize(qsc_dilithium_stream_state* state, const uint8_t* signature, size_t siglen, const uint8_t* publickey)
+{
+	assert(state != NULL);
+	assert(signature != NULL);
+	assert(publickey != NULL);
+
+	qsc_dilithium_expanded_publickey epk;
+	uint8_t mu[QSC_DILITHIUM_CRH_SIZE];
+	bool res;
+
+	qsc_keccak_incremental_finalize(&state->kstate, QSC_KECCAK_256_RATE, QSC_KECCAK_SHAKE_DOMAIN_ID);
+	qsc_keccak_incremental_squeeze(&state->kstate, QSC_KECCAK_256_RATE, mu, sizeof(mu));
+	qsc_keccak_dispose(&state->kstate);
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+	qsc_dilithium_avx2_expand_publickey(&epk, publickey);
+	res = qsc_dilithium_avx2_verify_mu(signature, siglen, mu, &epk);
+#else
+	qsc_dilithium_ref_expand_publickey(&epk, publickey);
+	res = qsc_dilithium_ref_verify_mu(signature, siglen, mu, &epk);
+#endif
+
+	return res;
+}
@@ -26,6 +26,7 @@
 #define QSC_DILITHIUM_H
 
 #include "common.h"
+#include "sha3.h"
 
 /**
 * \file dilithium.h
@@ -83,6 +84,18 @@
 */
 #	define QSC_DILITHIUM_SIGNATURE_SIZE 2420
 
+/*!
+* \def QSC_DILITHIUM_K
+* \brief The number of rows in the public matrix
+*/
+#	define QSC_DILITHIUM_K 4
+
+/*!
+* \def QSC_DILITHIUM_L
+* \brief The number of columns in the public matrix
+*/
+#	define QSC_DILITHIUM_L 4
+
 #elif defined(QSC_DILITHIUM_S3P4016)
 
 /*!
@@ -103,6 +116,18 @@
 */
 #	define QSC_DILITHIUM_SIGNATURE_SIZE 3293
 
+/*!
+* \def QSC_DILITHIUM_K
+* \brief The number of rows in the public matrix
+*/
+#	define QSC_DILITHIUM_K 6
+
+/*!
+* \def QSC_DILITHIUM_L
+* \brief The number of columns in the public matrix
+*/
+#	define QSC_DILITHIUM_L 5
+
 #elif defined(QSC_DILITHIUM_S5P4880)
 
 /*!
@@ -123,6 +148,18 @@
 */
 #	define QSC_DILITHIUM_SIGNATURE_SIZE 4595
 
+/*!
+* \def QSC_DILITHIUM_K
+* \brief The number of rows in the public matrix
+*/
+#	define QSC_DILITHIUM_K 8
+
+/*!
+* \def QSC_DILITHIUM_L
+* \brief The number of columns in the public matrix
+*/
+#	define QSC_DILITHIUM_L 7
+
 #else
 #	error "The Dilithium parameter set is invalid!"
 #endif
@@ -139,6 +176,130 @@
 */
 /* #define QSC_DILITHIUM_RANDOMIZED_SIGNING */
 
+/*!
+* \def QSC_DILITHIUM_N
+* \brief The number of polynomial coefficients
+*/
+#define QSC_DILITHIUM_N 256
+
+/*!
+* \def QSC_DILITHIUM_CRH_SIZE
+* \brief The byte size of the public key hash
+*/
+#define QSC_DILITHIUM_CRH_SIZE 48
+
+/*!
+* \def QSC_DILITHIUM_SEED_SIZE
+* \brief The byte size of the signing key seed
+*/
+#define QSC_DILITHIUM_SEED_SIZE 32
+
+/**
+* \struct qsc_dilithium_poly
+* \brief Contains an N sized array of 32bit coefficients
+*
+* \var qsc_dilithium_poly::coeffs
+* The array of 32bit coefficients
+*/
+typedef struct
+{
+	int32_t coeffs[QSC_DILITHIUM_N];
+} qsc_dilithium_poly;
+
+/**
+* \struct qsc_dilithium_polyvecl
+* \brief Contains an L sized vector of qsc_dilithium_poly structures
+*
+* \var qsc_dilithium_polyvecl::vec
+* The polynomial vector array
+*/
+typedef struct
+{
+	qsc_dilithium_poly vec[QSC_DILITHIUM_L];
+} qsc_dilithium_polyvecl;
+
+/**
+* \struct qsc_dilithium_polyveck
+* \brief Contains a K sized vector of qsc_dilithium_poly structures
+*
+* \var qsc_dilithium_polyveck::vec
+* The polynomial vector array
+*/
+typedef struct
+{
+	qsc_dilithium_poly vec[QSC_DILITHIUM_K];
+} qsc_dilithium_polyveck;
+
+/**
+* \struct qsc_dilithium_expanded_publickey
+* \brief The expanded form of a Dilithium public key. \n
+* Holds the public matrix and the scaled public vector t1*2^d in the NTT domain,
+* and the hash of the packed public key, so verification skips the SHAKE matrix generation.
+* The polynomial layout is specific to the implementation that expanded the key.
+* A heap allocated structure must be 64-byte aligned, i.e. created with qsc_memutils_aligned_alloc.
+*/
+typedef struct
+{
+	QSC_ALIGN(64) qsc_dilithium_polyvecl mat[QSC_DILITHIUM_K];	/*!< The public matrix in the NTT domain */
+	QSC_ALIGN(64) qsc_dilithium_polyveck t1;					/*!< The public vector t1*2^d in the NTT domain */
+	uint8_t tr[QSC_DILITHIUM_CRH_SIZE];							/*!< The hash of the packed public key */
+} qsc_dilithium_expanded_publickey;
+
+/**
+* \struct qsc_dilithium_expanded_privatekey
+* \brief The expanded form of a Dilithium private key. \n
+* Holds the public matrix and the secret vectors s1, s2 and t0 in the NTT domain,
+* the public key hash and the signing key seed.
+* A heap allocated structure must be 64-byte aligned, i.e. created with qsc_memutils_aligned_alloc.
+*/
+typedef struct
+{
+	QSC_ALIGN(64) qsc_dilithium_polyvecl mat[QSC_DILITHIUM_K];	/*!< The public matrix in the NTT domain */
+	QSC_ALIGN(64) qsc_dilithium_polyvecl s1;					/*!< The secret vector s1 in the NTT domain */
+	QSC_ALIGN(64) qsc_dilithium_polyveck s2;					/*!< The secret vector s2 in the NTT domain */
+	QSC_ALIGN(64) qsc_dilithium_polyveck t0;					/*!< The low bits vector t0 in the NTT domain */
+	uint8_t tr[QSC_DILITHIUM_CRH_SIZE];							/*!< The hash of the packed public key */
+	uint8_t key[QSC_DILITHIUM_SEED_SIZE];						/*!< The signing key seed */
+} qsc_dilithium_expanded_privatekey;
+
+/**
+* \struct qsc_dilithium_stream_state
+* \brief The Dilithium streaming sign and verify state. \n
+* Holds the SHAKE state that absorbs the key hash and the message in chunks;
+* the finalize functions squeeze the message representative from it.
+*/
+typedef struct
+{
+	qsc_keccak_state kstate;	/*!< The message hash state */
+} qsc_dilithium_stream_state;
+
+/**
+* \brief Expands a private-key for repeated signing.
+* The public matrix and the secret vectors are stored in the NTT domain.
+*
+* \warning The expanded key holds secret material; erase it with qsc_dilithium_expanded_privatekey_dispose.
+*
+* \param expanded: Pointer to the output expanded private-key structure
+* \param privatekey: [const] Pointer to the private signature-key array
+*/
+QSC_EXPORT_API void qsc_dilithium_expand_privatekey(qsc_dilithium_expanded_privatekey* expanded, const uint8_t* privatekey);
+
+/**
+* \brief Expands a public-key for repeated verification.
+* The public matrix and the scaled public vector are stored in the NTT domain.
+*
+* \param expanded: Pointer to the output expanded public-key structure
+* \param publickey: [const] Pointer to the public verification-key array
+*/
+QSC_EXPORT_API void qsc_dilithium_expand_publickey(qsc_dilithium_expanded_publickey* expanded, const uint8_t* publickey);
+
+/**
+* \brief Erase an expanded private-key
+*
+* \param expanded: Pointer to the expanded private-key structure
+*/
+QSC_EXPORT_API void qsc_dilithium_expanded_privatekey_dispose(qsc_dilithium_expanded_privatekey* expanded);
+
 /**
 * \brief Generates a Dilithium public/private key-pair.
 *
@@ -164,6 +325,21 @@ QSC_EXPORT_API void qsc_dilithium_generate_keypair(uint8_t* publickey, uint8_t*
 */
 QSC_EXPORT_API void qsc_dilithium_sign(uint8_t* signedmsg, size_t* smsglen, const uint8_t* message, size_t msglen, const uint8_t* privatekey, bool (*rng_generate)(uint8_t*, size_t));
 
+/**
+* \brief Signs a message using an expanded private-key.
+* Produces the same signed message as qsc_dilithium_sign, without unpacking the key or generating the public matrix.
+*
+* \warning Signature array must be sized to the size of the message plus QSC_DILITHIUM_SIGNATURE_SIZE.
+*
+* \param signedmsg: Pointer to the signed-message array
+* \param smsglen: The signed message length
+* \param message: [const] Pointer to the message array
+* \param msglen: The message array length
+* \param privatekey: [const] Pointer to the expanded private-key, initialized with qsc_dilithium_expand_privatekey
+* \param rng_generate: Pointer to the random generator
+*/
+QSC_EXPORT_API void qsc_dilithium_sign_expanded(uint8_t* signedmsg, size_t* smsglen, const uint8_t* message, size_t msglen, const qsc_dilithium_expanded_privatekey* privatekey, bool (*rng_generate)(uint8_t*, size_t));
+
 /**
 * \brief Verifies a signature-message pair with the public key.
 *
@@ -176,4 +352,125 @@ QSC_EXPORT_API void qsc_dilithium_sign(uint8_t* signedmsg, size_t* smsglen, cons
 */
 QSC_EXPORT_API bool qsc_dilithium_verify(uint8_t* message, size_t* msglen, const uint8_t* signedmsg, size_t smsglen, const uint8_t* publickey);
 
+/**
+* \brief Verifies a signature-message pair with an expanded public key.
+* Skips the public matrix generation and the public-key hash.
+*
+* \param message: Pointer to the message output array
+* \param msglen: Length of the message array
+* \param signedmsg: [const] Pointer to the signed message array
+* \param smsglen: The signed message length
+* \param publickey: [const] Pointer to the expanded public-key, initialized with qsc_dilithium_expand_publickey
+* \return Returns true for success
+*/
+QSC_EXPORT_API bool qsc_dilithium_verify_expanded(uint8_t* message, size_t* msglen, const uint8_t* signedmsg, size_t smsglen, const qsc_dilithium_expanded_publickey* publickey);
+
+/**
+* \brief Signs a message and returns a detached signature.
+* The message is read in place; no copy of the message is made.
+*
+* \warning Signature array must be sized to QSC_DILITHIUM_SIGNATURE_SIZE.
+*
+* \param signature: Pointer to the signature array
+* \param siglen: The signature length
+* \param message: [const] Pointer to the message array
+* \param msglen: The message array length
+* \param privatekey: [const] Pointer to the private signature-key
+* \param rng_generate: Pointer to the random generator
+*/
+QSC_EXPORT_API void qsc_dilithium_sign_detached(uint8_t* signature, size_t* siglen, const uint8_t* message, size_t msglen, const uint8_t* privatekey, bool (*rng_generate)(uint8_t*, size_t));
+
+/**
+* \brief Verifies a detached signature against a message with the public key.
+*
+* \param signature: [const] Pointer to the signature array
+* \param siglen: The signature length
+* \param message: [const] Pointer to the message array
+* \param msglen: The message array length
+* \param publickey: [const] Pointer to the public verification-key array
+* \return Returns true for success
+*/
+QSC_EXPORT_API bool qsc_dilithium_verify_detached(const uint8_t* signature, size_t siglen, const uint8_t* message, size_t msglen, const uint8_t* publickey);
+
+/**
+* \brief Signs a message and returns a detached signature, evaluating the signing rejection loop on several threads.
+* Consecutive rejection-loop iterations run concurrently and the first accepted iteration is kept,
+* so the signature is identical to the one returned by qsc_dilithium_sign_detached,
+* while the worst-case signing latency is reduced on multi-core processors.
+*
+* \warning Signature array must be sized to QSC_DILITHIUM_SIGNATURE_SIZE.
+*
+* \param signature: Pointer to the signature array
+* \param siglen: The signature length
+* \param message: [const] Pointer to the message array
+* \param msglen: The message array length
+* \param privatekey: [const] Pointer to the private signature-key
+* \param rng_generate: Pointer to the random generator
+*/
+QSC_EXPORT_API void qsc_dilithium_sign_detached_parallel(uint8_t* signature, size_t* siglen, const uint8_t* message, size_t msglen, const uint8_t* privatekey, bool (*rng_generate)(uint8_t*, size_t));
+
+/**
+* \brief Initialize a streaming signature.
+* Long form api: must be used in conjunction with the update and finalize functions.
+* Produces the same signature as qsc_dilithium_sign_detached over the concatenated message.
+*
+* \param state: [struct] The stream state
+* \param privatekey: [const] Pointer to the private signature-key
+*/
+QSC_EXPORT_API void qsc_dilithium_sign_initialize(qsc_dilithium_stream_state* state, const uint8_t* privatekey);
+
+/**
+* \brief Add a block of message bytes to a streaming signature.
+* Can be called any number of times; memory use does not depend on the message length.
+*
+* \param state: [struct] The stream state
+* \param message: [const] Pointer to the message block
+* \param msglen: The message block length
+*/
+QSC_EXPORT_API void qsc_dilithium_sign_update(qsc_dilithium_stream_state* state, const uint8_t* message, size_t msglen);
+
+/**
+* \brief Finalize a streaming signature and return the detached signature.
+* The stream state is erased.
+*
+* \warning Signature array must be sized to QSC_DILITHIUM_SIGNATURE_SIZE.
+*
+* \param state: [struct] The stream state
+* \param signature: Pointer to the signature array
+* \param siglen: The signature length
+* \param privatekey: [const] Pointer to the private signature-key
+* \param rng_generate: Pointer to the random generator
+*/
+QSC_EXPORT_API void qsc_dilithium_sign_finalize(qsc_dilithium_stream_state* state, uint8_t* signature, size_t* siglen, const uint8_t* privatekey, bool (*rng_generate)(uint8_t*, size_t));
+
+/**
+* \brief Initialize a streaming verification.
+* Long form api: must be used in conjunction with the update and finalize functions.
+*
+* \param state: [struct] The stream state
+* \param publickey: [const] Pointer to the public verification-key array
+*/
+QSC_EXPORT_API void qsc_dilithium_verify_initialize(qsc_dilithium_stream_state* state, const uint8_t* publickey);
+
+/**
+* \brief Add a block of message bytes to a streaming verification.
+*
+* \param state: [struct] The stream state
+* \param message: [const] Pointer to the message block
+* \param msglen: The message block length
+*/
+QSC_EXPORT_API void qsc_dilithium_verify_update(qsc_dilithium_stream_state* state, const uint8_t* message, size_t msglen);
+
+/**
+* \brief Finalize a streaming verification and verify the detached signature.
+* The stream state is erased.
+*
+* \param state: [struct] The stream state
+* \param signature: [const] Pointer to the signature array
+* \param siglen: The signature length
+* \param publickey: [const] Pointer to the public verification-key array
+* \return Returns true for success
+*/
+QSC_EXPORT_API bool qsc_dilithium_verify_finalize(qsc_dilithium_stream_state* state, const uint8_t* signature, size_t siglen, const uint8_t* publickey);
+
 #endif
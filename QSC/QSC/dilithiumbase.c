@@ -1,4 +1,5 @@
 #include "dilithiumbase.h"
+#include "async.h"
 #include "intutils.h"
 #include "memutils.h"
 #include "sha3.h"
@@ -97,32 +98,29 @@
 #   define DILITHIUM_POLY_UNIFORM_GAMMA1_NBLOCKS ((640 + QSC_KECCAK_256_RATE - 1) / QSC_KECCAK_256_RATE)
 #endif
 
-/*!
-* \struct dilithium_poly
-* \brief Array of coefficients of length N
-*/
-typedef struct
-{
-    int32_t coeffs[DILITHIUM_N];            /*!< The coefficients  */
-} dilithium_poly;
+/* the parallel signer runs one worker per processor, each evaluating every n-th rejection-loop
+   iteration; on average fewer than six iterations are needed, so more workers rarely help */
+#define DILITHIUM_PARALLEL_MAX 8
 
-/*!
-* \struct dilithium_polyvecl
-* \brief Vectors of polynomials of length L
-*/
-typedef struct
-{
-    dilithium_poly vec[DILITHIUM_L];    /*!< The poly vector of L  */
-} dilithium_polyvecl;
+/* the accepted iteration of a worker that has not accepted a candidate */
+#define DILITHIUM_PARALLEL_NONE 0xFFFFFFFFUL
 
 /*!
-* \struct dilithium_polyveck
-* \brief Vectors of polynomials of length K
+* \struct dilithium_parallel_task
+* \brief A parallel signing worker, evaluating every count-th rejection-loop iteration from first
 */
-typedef struct
-{
-    dilithium_poly vec[DILITHIUM_K];    /*!< The poly vector of K  */
-} dilithium_polyveck;
+typedef struct dilithium_parallel_task
+{
+    uint8_t sig[DILITHIUM_SIGNATURE_SIZE];                  /*!< The accepted candidate signature  */
+    const qsc_dilithium_expanded_privatekey* esk;           /*!< The expanded private key  */
+    const uint8_t* mu;                                      /*!< The message representative  */
+    const uint8_t* rhoprime;                                /*!< The masking seed  */
+    const struct dilithium_parallel_task* workers;          /*!< The worker set, polled to stop early  */
+    const volatile bool* halt;                              /*!< Set when the worker set could not be started  */
+    size_t count;                                           /*!< The number of workers  */
+    uint32_t first;                                         /*!< The first iteration evaluated by the worker  */
+    volatile uint32_t accepted;                             /*!< The accepted iteration, or DILITHIUM_PARALLEL_NONE  */
+} dilithium_parallel_task;
 
 static const int32_t dilithium_zetas[DILITHIUM_N] =
 {
@@ -359,7 +357,7 @@ static void dilithium_invntt_to_mont(int32_t a[DILITHIUM_N])
     }
 }
 
-static void dilithium_poly_reduce(dilithium_poly* a)
+static void dilithium_poly_reduce(qsc_dilithium_poly* a)
 {
     for (size_t i = 0; i < DILITHIUM_N; ++i)
     {
@@ -367,7 +365,7 @@ static void dilithium_poly_reduce(dilithium_poly* a)
     }
 }
 
-static void dilithium_poly_caddq(dilithium_poly* a)
+static void dilithium_poly_caddq(qsc_dilithium_poly* a)
 {
     for (size_t i = 0; i < DILITHIUM_N; ++i)
     {
@@ -375,7 +373,7 @@ static void dilithium_poly_caddq(dilithium_poly* a)
     }
 }
 
-static void dilithium_poly_add(dilithium_poly* c, const dilithium_poly* a, const dilithium_poly* b)
+static void dilithium_poly_add(qsc_dilithium_poly* c, const qsc_dilithium_poly* a, const qsc_dilithium_poly* b)
 {
     for (size_t i = 0; i < DILITHIUM_N; ++i)
     {
@@ -383,7 +381,7 @@ static void dilithium_poly_add(dilithium_poly* c, const dilithium_poly* a, const
     }
 }
 
-static void dilithium_poly_sub(dilithium_poly* c, const dilithium_poly* a, const dilithium_poly* b)
+static void dilithium_poly_sub(qsc_dilithium_poly* c, const qsc_dilithium_poly* a, const qsc_dilithium_poly* b)
 {
     for (size_t i = 0; i < DILITHIUM_N; ++i)
     {
@@ -391,7 +389,7 @@ static void dilithium_poly_sub(dilithium_poly* c, const dilithium_poly* a, const
     }
 }
 
-static void dilithium_poly_shiftl(dilithium_poly* a)
+static void dilithium_poly_shiftl(qsc_dilithium_poly* a)
 {
     for (size_t i = 0; i < DILITHIUM_N; ++i)
     {
@@ -399,17 +397,17 @@ static void dilithium_poly_shiftl(dilithium_poly* a)
     }
 }
 
-static void dilithium_poly_ntt(dilithium_poly* a)
+static void dilithium_poly_ntt(qsc_dilithium_poly* a)
 {
     dilithium_ntt(a->coeffs);
 }
 
-static void dilithium_poly_invntt_to_mont(dilithium_poly* a)
+static void dilithium_poly_invntt_to_mont(qsc_dilithium_poly* a)
 {
     dilithium_invntt_to_mont(a->coeffs);
 }
 
-static void dilithium_poly_pointwise_montgomery(dilithium_poly* c, const dilithium_poly* a, const dilithium_poly* b)
+static void dilithium_poly_pointwise_montgomery(qsc_dilithium_poly* c, const qsc_dilithium_poly* a, const qsc_dilithium_poly* b)
 {
     for (size_t i = 0; i < DILITHIUM_N; ++i)
     {
@@ -417,7 +415,7 @@ static void dilithium_poly_pointwise_montgomery(dilithium_poly* c, const dilithi
     }
 }
 
-static void dilithium_poly_power2_round(dilithium_poly* a1, dilithium_poly* a0, const dilithium_poly* a)
+static void dilithium_poly_power2_round(qsc_dilithium_poly* a1, qsc_dilithium_poly* a0, const qsc_dilithium_poly* a)
 {
     for (size_t i = 0; i < DILITHIUM_N; ++i)
     {
@@ -425,7 +423,7 @@ static void dilithium_poly_power2_round(dilithium_poly* a1, dilithium_poly* a0,
     }
 }
 
-static void dilithium_poly_decompose(dilithium_poly* a1, dilithium_poly* a0, const dilithium_poly* a)
+static void dilithium_poly_decompose(qsc_dilithium_poly* a1, qsc_dilithium_poly* a0, const qsc_dilithium_poly* a)
 {
     for (size_t i = 0; i < DILITHIUM_N; ++i)
     {
@@ -433,7 +431,7 @@ static void dilithium_poly_decompose(dilithium_poly* a1, dilithium_poly* a0, con
     }
 }
 
-static uint32_t dilithium_poly_make_hint(dilithium_poly* h, const dilithium_poly* a0, const dilithium_poly* a1)
+static uint32_t dilithium_poly_make_hint(qsc_dilithium_poly* h, const qsc_dilithium_poly* a0, const qsc_dilithium_poly* a1)
 {
     uint32_t s;
 
@@ -448,7 +446,7 @@ static uint32_t dilithium_poly_make_hint(dilithium_poly* h, const dilithium_poly
     return s;
 }
 
-static void dilithium_poly_use_hint(dilithium_poly* b, const dilithium_poly* a, const dilithium_poly* h)
+static void dilithium_poly_use_hint(qsc_dilithium_poly* b, const qsc_dilithium_poly* a, const qsc_dilithium_poly* h)
 {
     for (size_t i = 0; i < DILITHIUM_N; ++i)
     {
@@ -456,7 +454,7 @@ static void dilithium_poly_use_hint(dilithium_poly* b, const dilithium_poly* a,
     }
 }
 
-static int32_t dilithium_poly_chknorm(const dilithium_poly* a, int32_t B)
+static int32_t dilithium_poly_chknorm(const qsc_dilithium_poly* a, int32_t B)
 {
     int32_t t;
     int32_t res;
@@ -517,7 +515,7 @@ static size_t dilithium_rej_uniform(int32_t* a, size_t len, const uint8_t* buf,
     return ctr;
 }
 
-static void dilithium_poly_uniform(dilithium_poly* a, const uint8_t seed[DILITHIUM_SEEDBYTES], uint16_t nonce)
+static void dilithium_poly_uniform(qsc_dilithium_poly* a, const uint8_t seed[DILITHIUM_SEEDBYTES], uint16_t nonce)
 {
     uint8_t buf[DILITHIUM_POLY_UNIFORM_NBLOCKS * QSC_KECCAK_128_RATE + 2];
     qsc_keccak_state kctx;
@@ -592,7 +590,7 @@ static size_t dilithium_rej_eta(int32_t* a, size_t len, const uint8_t* buf, size
     return ctr;
 }
 
-static void dilithium_poly_challenge(dilithium_poly* c, const uint8_t seed[DILITHIUM_SEEDBYTES])
+static void dilithium_poly_challenge(qsc_dilithium_poly* c, const uint8_t seed[DILITHIUM_SEEDBYTES])
 {
     uint8_t buf[QSC_KECCAK_256_RATE];
     qsc_keccak_state kctx;
@@ -638,7 +636,7 @@ static void dilithium_poly_challenge(dilithium_poly* c, const uint8_t seed[DILIT
     }
 }
 
-static void dilithium_polyeta_pack(uint8_t* r, const dilithium_poly* a)
+static void dilithium_polyeta_pack(uint8_t* r, const qsc_dilithium_poly* a)
 {
     uint8_t t[8];
 
@@ -668,7 +666,7 @@ static void dilithium_polyeta_pack(uint8_t* r, const dilithium_poly* a)
 #endif
 }
 
-static void dilithium_polyeta_unpack(dilithium_poly* r, const uint8_t* a)
+static void dilithium_polyeta_unpack(qsc_dilithium_poly* r, const uint8_t* a)
 {
 #if (DILITHIUM_ETA == 2)
     for (size_t i = 0; i < DILITHIUM_N / 8; ++i)
@@ -702,7 +700,7 @@ static void dilithium_polyeta_unpack(dilithium_poly* r, const uint8_t* a)
 #endif
 }
 
-static void dilithium_polyt1_pack(uint8_t* r, const dilithium_poly* a)
+static void dilithium_polyt1_pack(uint8_t* r, const qsc_dilithium_poly* a)
 {
     for (size_t i = 0; i < DILITHIUM_N / 4; ++i)
     {
@@ -714,7 +712,7 @@ static void dilithium_polyt1_pack(uint8_t* r, const dilithium_poly* a)
     }
 }
 
-static void dilithium_polyt1_unpack(dilithium_poly* r, const uint8_t* a)
+static void dilithium_polyt1_unpack(qsc_dilithium_poly* r, const uint8_t* a)
 {
     for (size_t i = 0; i < DILITHIUM_N / 4; ++i)
     {
@@ -725,7 +723,7 @@ static void dilithium_polyt1_unpack(dilithium_poly* r, const uint8_t* a)
     }
 }
 
-static void dilithium_polyt0_pack(uint8_t* r, const dilithium_poly* a)
+static void dilithium_polyt0_pack(uint8_t* r, const qsc_dilithium_poly* a)
 {
     uint32_t t[8];
 
@@ -763,7 +761,7 @@ static void dilithium_polyt0_pack(uint8_t* r, const dilithium_poly* a)
     }
 }
 
-static void dilithium_polyt0_unpack(dilithium_poly* r, const uint8_t* a)
+static void dilithium_polyt0_unpack(qsc_dilithium_poly* r, const uint8_t* a)
 {
     for (size_t i = 0; i < DILITHIUM_N / 8; ++i)
     {
@@ -814,7 +812,7 @@ static void dilithium_polyt0_unpack(dilithium_poly* r, const uint8_t* a)
     }
 }
 
-static void dilithium_polyz_pack(uint8_t* r, const dilithium_poly* a)
+static void dilithium_polyz_pack(uint8_t* r, const qsc_dilithium_poly* a)
 {
     uint32_t t[4];
 
@@ -855,7 +853,7 @@ static void dilithium_polyz_pack(uint8_t* r, const dilithium_poly* a)
 #endif
 }
 
-static void dilithium_polyz_unpack(dilithium_poly* r, const uint8_t* a)
+static void dilithium_polyz_unpack(qsc_dilithium_poly* r, const uint8_t* a)
 {
 #if (DILITHIUM_GAMMA1 == (1 << 17))
     for (size_t i = 0; i < DILITHIUM_N / 4; ++i)
@@ -904,7 +902,7 @@ static void dilithium_polyz_unpack(dilithium_poly* r, const uint8_t* a)
 #endif
 }
 
-static void dilithium_polyw1_pack(uint8_t* r, const dilithium_poly* a)
+static void dilithium_polyw1_pack(uint8_t* r, const qsc_dilithium_poly* a)
 {
 #if (DILITHIUM_GAMMA2 == (DILITHIUM_Q - 1) / 88)
     for (size_t i = 0; i < DILITHIUM_N / 4; ++i)
@@ -924,7 +922,7 @@ static void dilithium_polyw1_pack(uint8_t* r, const dilithium_poly* a)
 #endif
 }
 
-static void dilithium_poly_uniform_eta(dilithium_poly* a, const uint8_t seed[DILITHIUM_SEEDBYTES], uint16_t nonce)
+static void dilithium_poly_uniform_eta(qsc_dilithium_poly* a, const uint8_t seed[DILITHIUM_SEEDBYTES], uint16_t nonce)
 {
     uint8_t buf[DILITHIUM_POLY_UNIFORM_ETA_NBLOCKS * QSC_KECCAK_128_RATE];
     qsc_keccak_state kctx;
@@ -944,7 +942,7 @@ static void dilithium_poly_uniform_eta(dilithium_poly* a, const uint8_t seed[DIL
     }
 }
 
-static void dilithium_poly_uniform_gamma1(dilithium_poly* a, const uint8_t seed[DILITHIUM_CRHBYTES], uint16_t nonce)
+static void dilithium_poly_uniform_gamma1(qsc_dilithium_poly* a, const uint8_t seed[DILITHIUM_CRHBYTES], uint16_t nonce)
 {
     uint8_t buf[DILITHIUM_POLY_UNIFORM_GAMMA1_NBLOCKS * QSC_KECCAK_256_RATE];
     qsc_keccak_state kctx;
@@ -956,7 +954,7 @@ static void dilithium_poly_uniform_gamma1(dilithium_poly* a, const uint8_t seed[
 
 /* polyvec.c */
 
-static void dilithium_polyvec_matrix_expand(dilithium_polyvecl mat[DILITHIUM_K], const uint8_t rho[DILITHIUM_SEEDBYTES])
+static void dilithium_polyvec_matrix_expand(qsc_dilithium_polyvecl mat[DILITHIUM_K], const uint8_t rho[DILITHIUM_SEEDBYTES])
 {
     for (size_t i = 0; i < DILITHIUM_K; ++i)
     {
@@ -967,9 +965,9 @@ static void dilithium_polyvec_matrix_expand(dilithium_polyvecl mat[DILITHIUM_K],
     }
 }
 
-static void dilithium_polyvecl_pointwise_acc_montgomery(dilithium_poly* w, const dilithium_polyvecl* u, const dilithium_polyvecl* v)
+static void dilithium_polyvecl_pointwise_acc_montgomery(qsc_dilithium_poly* w, const qsc_dilithium_polyvecl* u, const qsc_dilithium_polyvecl* v)
 {
-    dilithium_poly t;
+    qsc_dilithium_poly t;
 
     dilithium_poly_pointwise_montgomery(w, &u->vec[0], &v->vec[0]);
 
@@ -980,7 +978,7 @@ static void dilithium_polyvecl_pointwise_acc_montgomery(dilithium_poly* w, const
     }
 }
 
-static void dilithium_polyvec_matrix_pointwise_montgomery(dilithium_polyveck* t, const dilithium_polyvecl mat[DILITHIUM_K], const dilithium_polyvecl* v)
+static void dilithium_polyvec_matrix_pointwise_montgomery(qsc_dilithium_polyveck* t, const qsc_dilithium_polyvecl mat[DILITHIUM_K], const qsc_dilithium_polyvecl* v)
 {
     for (size_t i = 0; i < DILITHIUM_K; ++i)
     {
@@ -988,7 +986,7 @@ static void dilithium_polyvec_matrix_pointwise_montgomery(dilithium_polyveck* t,
     }
 }
 
-static void dilithium_polyvecl_uniform_eta(dilithium_polyvecl* v, const uint8_t seed[DILITHIUM_SEEDBYTES], uint16_t nonce)
+static void dilithium_polyvecl_uniform_eta(qsc_dilithium_polyvecl* v, const uint8_t seed[DILITHIUM_SEEDBYTES], uint16_t nonce)
 {
     for (size_t i = 0; i < DILITHIUM_L; ++i)
     {
@@ -997,7 +995,7 @@ static void dilithium_polyvecl_uniform_eta(dilithium_polyvecl* v, const uint8_t
     }
 }
 
-static void dilithium_polyvecl_uniform_gamma1(dilithium_polyvecl* v, const uint8_t seed[DILITHIUM_SEEDBYTES], uint16_t nonce)
+static void dilithium_polyvecl_uniform_gamma1(qsc_dilithium_polyvecl* v, const uint8_t seed[DILITHIUM_SEEDBYTES], uint16_t nonce)
 {
     for (size_t i = 0; i < DILITHIUM_L; ++i)
     {
@@ -1005,7 +1003,7 @@ static void dilithium_polyvecl_uniform_gamma1(dilithium_polyvecl* v, const uint8
     }
 }
 
-static void dilithium_polyvecl_reduce(dilithium_polyvecl* v)
+static void dilithium_polyvecl_reduce(qsc_dilithium_polyvecl* v)
 {
     for (size_t i = 0; i < DILITHIUM_L; ++i)
     {
@@ -1013,7 +1011,7 @@ static void dilithium_polyvecl_reduce(dilithium_polyvecl* v)
     }
 }
 
-static void dilithium_polyvecl_add(dilithium_polyvecl* w, const dilithium_polyvecl* u, const dilithium_polyvecl* v)
+static void dilithium_polyvecl_add(qsc_dilithium_polyvecl* w, const qsc_dilithium_polyvecl* u, const qsc_dilithium_polyvecl* v)
 {
     for (size_t i = 0; i < DILITHIUM_L; ++i)
     {
@@ -1021,7 +1019,7 @@ static void dilithium_polyvecl_add(dilithium_polyvecl* w, const dilithium_polyve
     }
 }
 
-static void dilithium_polyvecl_ntt(dilithium_polyvecl* v)
+static void dilithium_polyvecl_ntt(qsc_dilithium_polyvecl* v)
 {
     for (size_t i = 0; i < DILITHIUM_L; ++i)
     {
@@ -1029,7 +1027,7 @@ static void dilithium_polyvecl_ntt(dilithium_polyvecl* v)
     }
 }
 
-static void dilithium_polyvecl_invntt_to_mont(dilithium_polyvecl* v)
+static void dilithium_polyvecl_invntt_to_mont(qsc_dilithium_polyvecl* v)
 {
     for (size_t i = 0; i < DILITHIUM_L; ++i)
     {
@@ -1037,7 +1035,7 @@ static void dilithium_polyvecl_invntt_to_mont(dilithium_polyvecl* v)
     }
 }
 
-static void dilithium_polyvecl_pointwise_poly_montgomery(dilithium_polyvecl* r, const dilithium_poly* a, const dilithium_polyvecl* v)
+static void dilithium_polyvecl_pointwise_poly_montgomery(qsc_dilithium_polyvecl* r, const qsc_dilithium_poly* a, const qsc_dilithium_polyvecl* v)
 {
     for (size_t i = 0; i < DILITHIUM_L; ++i)
     {
@@ -1045,7 +1043,7 @@ static void dilithium_polyvecl_pointwise_poly_montgomery(dilithium_polyvecl* r,
     }
 }
 
-static int32_t dilithium_polyvecl_chknorm(const dilithium_polyvecl* v, int32_t bound)
+static int32_t dilithium_polyvecl_chknorm(const qsc_dilithium_polyvecl* v, int32_t bound)
 {
     int32_t res;
 
@@ -1063,7 +1061,7 @@ static int32_t dilithium_polyvecl_chknorm(const dilithium_polyvecl* v, int32_t b
     return res;
 }
 
-static void dilithium_polyveck_uniform_eta(dilithium_polyveck* v, const uint8_t seed[DILITHIUM_SEEDBYTES], uint16_t nonce)
+static void dilithium_polyveck_uniform_eta(qsc_dilithium_polyveck* v, const uint8_t seed[DILITHIUM_SEEDBYTES], uint16_t nonce)
 {
     for (size_t i = 0; i < DILITHIUM_K; ++i)
     {
@@ -1072,7 +1070,7 @@ static void dilithium_polyveck_uniform_eta(dilithium_polyveck* v, const uint8_t
     }
 }
 
-static void dilithium_polyveck_reduce(dilithium_polyveck* v)
+static void dilithium_polyveck_reduce(qsc_dilithium_polyveck* v)
 {
     for (size_t i = 0; i < DILITHIUM_K; ++i)
     {
@@ -1080,7 +1078,7 @@ static void dilithium_polyveck_reduce(dilithium_polyveck* v)
     }
 }
 
-static void dilithium_polyveck_caddq(dilithium_polyveck* v)
+static void dilithium_polyveck_caddq(qsc_dilithium_polyveck* v)
 {
     for (size_t i = 0; i < DILITHIUM_K; ++i)
     {
@@ -1088,7 +1086,7 @@ static void dilithium_polyveck_caddq(dilithium_polyveck* v)
     }
 }
 
-static void dilithium_polyveck_add(dilithium_polyveck* w, const dilithium_polyveck* u, const dilithium_polyveck* v)
+static void dilithium_polyveck_add(qsc_dilithium_polyveck* w, const qsc_dilithium_polyveck* u, const qsc_dilithium_polyveck* v)
 {
     for (size_t i = 0; i < DILITHIUM_K; ++i)
     {
@@ -1096,7 +1094,7 @@ static void dilithium_polyveck_add(dilithium_polyveck* w, const dilithium_polyve
     }
 }
 
-static void dilithium_polyveck_sub(dilithium_polyveck* w, const dilithium_polyveck* u, const dilithium_polyveck* v)
+static void dilithium_polyveck_sub(qsc_dilithium_polyveck* w, const qsc_dilithium_polyveck* u, const qsc_dilithium_polyveck* v)
 {
     for (size_t i = 0; i < DILITHIUM_K; ++i)
     {
@@ -1104,7 +1102,7 @@ static void dilithium_polyveck_sub(dilithium_polyveck* w, const dilithium_polyve
     }
 }
 
-static void dilithium_polyveck_shiftl(dilithium_polyveck* v)
+static void dilithium_polyveck_shiftl(qsc_dilithium_polyveck* v)
 {
     for (size_t i = 0; i < DILITHIUM_K; ++i)
     {
@@ -1112,7 +1110,7 @@ static void dilithium_polyveck_shiftl(dilithium_polyveck* v)
     }
 }
 
-static void dilithium_polyveck_ntt(dilithium_polyveck* v)
+static void dilithium_polyveck_ntt(qsc_dilithium_polyveck* v)
 {
     for (size_t i = 0; i < DILITHIUM_K; ++i)
     {
@@ -1120,7 +1118,7 @@ static void dilithium_polyveck_ntt(dilithium_polyveck* v)
     }
 }
 
-static void dilithium_polyveck_invntt_to_mont(dilithium_polyveck* v)
+static void dilithium_polyveck_invntt_to_mont(qsc_dilithium_polyveck* v)
 {
     for (size_t i = 0; i < DILITHIUM_K; ++i)
     {
@@ -1128,7 +1126,7 @@ static void dilithium_polyveck_invntt_to_mont(dilithium_polyveck* v)
     }
 }
 
-static void dilithium_polyveck_pointwise_poly_montgomery(dilithium_polyveck* r, const dilithium_poly* a, const dilithium_polyveck* v)
+static void dilithium_polyveck_pointwise_poly_montgomery(qsc_dilithium_polyveck* r, const qsc_dilithium_poly* a, const qsc_dilithium_polyveck* v)
 {
     for (size_t i = 0; i < DILITHIUM_K; ++i)
     {
@@ -1136,7 +1134,7 @@ static void dilithium_polyveck_pointwise_poly_montgomery(dilithium_polyveck* r,
     }
 }
 
-static int32_t dilithium_polyveck_chknorm(const dilithium_polyveck* v, int32_t bound)
+static int32_t dilithium_polyveck_chknorm(const qsc_dilithium_polyveck* v, int32_t bound)
 {
     int32_t res;
 
@@ -1154,7 +1152,7 @@ static int32_t dilithium_polyveck_chknorm(const dilithium_polyveck* v, int32_t b
     return res;
 }
 
-static void dilithium_polyveck_power2_round(dilithium_polyveck* v1, dilithium_polyveck* v0, const dilithium_polyveck* v)
+static void dilithium_polyveck_power2_round(qsc_dilithium_polyveck* v1, qsc_dilithium_polyveck* v0, const qsc_dilithium_polyveck* v)
 {
     for (size_t i = 0; i < DILITHIUM_K; ++i)
     {
@@ -1162,7 +1160,7 @@ static void dilithium_polyveck_power2_round(dilithium_polyveck* v1, dilithium_po
     }
 }
 
-static void dilithium_polyveck_decompose(dilithium_polyveck* v1, dilithium_polyveck* v0, const dilithium_polyveck* v)
+static void dilithium_polyveck_decompose(qsc_dilithium_polyveck* v1, qsc_dilithium_polyveck* v0, const qsc_dilithium_polyveck* v)
 {
     for (size_t i = 0; i < DILITHIUM_K; ++i)
     {
@@ -1170,7 +1168,7 @@ static void dilithium_polyveck_decompose(dilithium_polyveck* v1, dilithium_polyv
     }
 }
 
-static uint32_t dilithium_polyveck_make_hint(dilithium_polyveck* h, const dilithium_polyveck* v0, const dilithium_polyveck* v1)
+static uint32_t dilithium_polyveck_make_hint(qsc_dilithium_polyveck* h, const qsc_dilithium_polyveck* v0, const qsc_dilithium_polyveck* v1)
 {
     uint32_t s;
 
@@ -1184,7 +1182,7 @@ static uint32_t dilithium_polyveck_make_hint(dilithium_polyveck* h, const dilith
     return s;
 }
 
-static void dilithium_polyveck_use_hint(dilithium_polyveck* w, const dilithium_polyveck* u, const dilithium_polyveck* h)
+static void dilithium_polyveck_use_hint(qsc_dilithium_polyveck* w, const qsc_dilithium_polyveck* u, const qsc_dilithium_polyveck* h)
 {
     for (size_t i = 0; i < DILITHIUM_K; ++i)
     {
@@ -1192,7 +1190,7 @@ static void dilithium_polyveck_use_hint(dilithium_polyveck* w, const dilithium_p
     }
 }
 
-static void dilithium_polyveck_pack_w1(uint8_t r[DILITHIUM_K * DILITHIUM_POLYW1_PACKEDBYTES], const dilithium_polyveck* w1)
+static void dilithium_polyveck_pack_w1(uint8_t r[DILITHIUM_K * DILITHIUM_POLYW1_PACKEDBYTES], const qsc_dilithium_polyveck* w1)
 {
     for (size_t i = 0; i < DILITHIUM_K; ++i)
     {
@@ -1202,7 +1200,7 @@ static void dilithium_polyveck_pack_w1(uint8_t r[DILITHIUM_K * DILITHIUM_POLYW1_
 
 /* packing.c */
 
-static void dilithium_pack_pk(uint8_t pk[DILITHIUM_PUBLICKEY_SIZE], const uint8_t rho[DILITHIUM_SEEDBYTES], const dilithium_polyveck* t1)
+static void dilithium_pack_pk(uint8_t pk[DILITHIUM_PUBLICKEY_SIZE], const uint8_t rho[DILITHIUM_SEEDBYTES], const qsc_dilithium_polyveck* t1)
 {
     size_t i;
 
@@ -1219,7 +1217,7 @@ static void dilithium_pack_pk(uint8_t pk[DILITHIUM_PUBLICKEY_SIZE], const uint8_
     }
 }
 
-static void dilithium_unpack_pk(uint8_t rho[DILITHIUM_SEEDBYTES], dilithium_polyveck* t1, const uint8_t pk[DILITHIUM_PUBLICKEY_SIZE])
+static void dilithium_unpack_pk(uint8_t rho[DILITHIUM_SEEDBYTES], qsc_dilithium_polyveck* t1, const uint8_t pk[DILITHIUM_PUBLICKEY_SIZE])
 {
     size_t i;
 
@@ -1237,7 +1235,7 @@ static void dilithium_unpack_pk(uint8_t rho[DILITHIUM_SEEDBYTES], dilithium_poly
 }
 
 static void dilithium_pack_sk(uint8_t sk[DILITHIUM_PRIVATEKEY_SIZE], const uint8_t rho[DILITHIUM_SEEDBYTES], const uint8_t tr[DILITHIUM_CRHBYTES],
-    const uint8_t key[DILITHIUM_SEEDBYTES], const dilithium_polyveck* t0, const dilithium_polyvecl* s1, const dilithium_polyveck* s2)
+    const uint8_t key[DILITHIUM_SEEDBYTES], const qsc_dilithium_polyveck* t0, const qsc_dilithium_polyvecl* s1, const qsc_dilithium_polyveck* s2)
 {
     size_t  i;
 
@@ -1271,7 +1269,7 @@ static void dilithium_pack_sk(uint8_t sk[DILITHIUM_PRIVATEKEY_SIZE], const uint8
 }
 
 static void dilithium_unpack_sk(uint8_t rho[DILITHIUM_SEEDBYTES], uint8_t tr[DILITHIUM_CRHBYTES], uint8_t key[DILITHIUM_SEEDBYTES],
-    dilithium_polyveck* t0, dilithium_polyvecl* s1, dilithium_polyveck* s2, const uint8_t sk[DILITHIUM_PRIVATEKEY_SIZE])
+    qsc_dilithium_polyveck* t0, qsc_dilithium_polyvecl* s1, qsc_dilithium_polyveck* s2, const uint8_t sk[DILITHIUM_PRIVATEKEY_SIZE])
 {
     size_t  i;
 
@@ -1304,7 +1302,7 @@ static void dilithium_unpack_sk(uint8_t rho[DILITHIUM_SEEDBYTES], uint8_t tr[DIL
     }
 }
 
-static void dilithium_pack_sig(uint8_t sig[DILITHIUM_SIGNATURE_SIZE], const uint8_t c[DILITHIUM_SEEDBYTES], const dilithium_polyvecl* z, const dilithium_polyveck* h)
+static void dilithium_pack_sig(uint8_t sig[DILITHIUM_SIGNATURE_SIZE], const uint8_t c[DILITHIUM_SEEDBYTES], const qsc_dilithium_polyvecl* z, const qsc_dilithium_polyveck* h)
 {
     size_t i;
     size_t j;
@@ -1343,7 +1341,7 @@ static void dilithium_pack_sig(uint8_t sig[DILITHIUM_SIGNATURE_SIZE], const uint
     }
 }
 
-static int32_t dilithium_unpack_sig(uint8_t c[DILITHIUM_SEEDBYTES], dilithium_polyvecl* z, dilithium_polyveck* h, const uint8_t sig[DILITHIUM_SIGNATURE_SIZE])
+static int32_t dilithium_unpack_sig(uint8_t c[DILITHIUM_SEEDBYTES], qsc_dilithium_polyvecl* z, qsc_dilithium_polyveck* h, const uint8_t sig[DILITHIUM_SIGNATURE_SIZE])
 {
     size_t i;
     size_t j;
@@ -1419,12 +1417,12 @@ static int32_t dilithium_unpack_sig(uint8_t c[DILITHIUM_SEEDBYTES], dilithium_po
 
 void qsc_dilithium_ref_generate_keypair(uint8_t* pk, uint8_t* sk, bool (*rng_generate)(uint8_t*, size_t))
 {
-    dilithium_polyvecl mat[DILITHIUM_K];
-    dilithium_polyvecl s1;
-    dilithium_polyvecl s1hat;
-    dilithium_polyveck s2;
-    dilithium_polyveck t1;
-    dilithium_polyveck t0;
+    qsc_dilithium_polyvecl mat[DILITHIUM_K];
+    qsc_dilithium_polyvecl s1;
+    qsc_dilithium_polyvecl s1hat;
+    qsc_dilithium_polyveck s2;
+    qsc_dilithium_polyveck t1;
+    qsc_dilithium_polyveck t0;
     uint8_t seedbuf[3 * DILITHIUM_SEEDBYTES];
     uint8_t tr[DILITHIUM_CRHBYTES];
     const uint8_t* rho;
@@ -1465,131 +1463,312 @@ void qsc_dilithium_ref_generate_keypair(uint8_t* pk, uint8_t* sk, bool (*rng_gen
     dilithium_pack_sk(sk, rho, tr, key, &t0, &s1, &s2);
 }
 
-void qsc_dilithium_ref_sign_signature(uint8_t* sig, size_t* siglen, const uint8_t* m, size_t mlen, const uint8_t* sk, bool (*rng_generate)(uint8_t*, size_t))
+void qsc_dilithium_ref_expand_privatekey(qsc_dilithium_expanded_privatekey* esk, const uint8_t* sk)
 {
-    uint8_t seedbuf[2 * DILITHIUM_SEEDBYTES + 3 * DILITHIUM_CRHBYTES];
-    dilithium_polyvecl mat[DILITHIUM_K];
-    dilithium_polyvecl s1;
-    dilithium_polyvecl y;
-    dilithium_polyvecl z;
-    dilithium_polyveck h;
-    dilithium_polyveck s2;
-    dilithium_polyveck t0;
-    dilithium_polyveck w1;
-    dilithium_polyveck w0;
-    dilithium_poly cp;
-    qsc_keccak_state kctx;
-    uint8_t* rho;
-    uint8_t* tr;
-    uint8_t* key;
-    uint8_t* mu;
-    uint8_t* rhoprime;
-    uint32_t n;
-    uint16_t nonce;
+    uint8_t rho[DILITHIUM_SEEDBYTES];
+    qsc_dilithium_polyvecl* mat;
+    qsc_dilithium_polyvecl* s1;
+    qsc_dilithium_polyveck* s2;
+    qsc_dilithium_polyveck* t0;
 
-    nonce = 0;
-    rho = seedbuf;
-    tr = rho + DILITHIUM_SEEDBYTES;
-    key = tr + DILITHIUM_CRHBYTES;
-    mu = key + DILITHIUM_SEEDBYTES;
-    rhoprime = mu + DILITHIUM_CRHBYTES;
+    mat = esk->mat;
+    s1 = &esk->s1;
+    s2 = &esk->s2;
+    t0 = &esk->t0;
 
-    dilithium_unpack_sk(rho, tr, key, &t0, &s1, &s2, sk);
+    dilithium_unpack_sk(rho, esk->tr, esk->key, t0, s1, s2, sk);
 
-    /* Compute CRH(tr, msg) */
-    qsc_keccak_initialize_state(&kctx);
-    qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, tr, DILITHIUM_CRHBYTES);
-    qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, m, mlen);
-    qsc_keccak_incremental_finalize(&kctx, QSC_KECCAK_256_RATE, QSC_KECCAK_SHAKE_DOMAIN_ID);
-    qsc_keccak_incremental_squeeze(&kctx, QSC_KECCAK_256_RATE, mu, DILITHIUM_CRHBYTES);
+    /* Expand matrix and transform vectors */
+    dilithium_polyvec_matrix_expand(mat, rho);
+    dilithium_polyvecl_ntt(s1);
+    dilithium_polyveck_ntt(s2);
+    dilithium_polyveck_ntt(t0);
+}
+
+void qsc_dilithium_ref_expand_publickey(qsc_dilithium_expanded_publickey* epk, const uint8_t* pk)
+{
+    uint8_t rho[DILITHIUM_SEEDBYTES];
+    qsc_dilithium_polyveck* t1;
 
+    t1 = &epk->t1;
+
+    dilithium_unpack_pk(rho, t1, pk);
+    dilithium_polyvec_matrix_expand(epk->mat, rho);
+
+    /* Store t1*2^d in the NTT domain */
+    dilithium_polyveck_shiftl(t1);
+    dilithium_polyveck_ntt(t1);
+
+    /* Compute CRH(rho, t1) */
+    qsc_shake256_compute(epk->tr, DILITHIUM_CRHBYTES, pk, DILITHIUM_PUBLICKEY_SIZE);
+}
+
+static void dilithium_sign_rhoprime(uint8_t* rhoprime, const uint8_t* mu, const qsc_dilithium_expanded_privatekey* esk, bool (*rng_generate)(uint8_t*, size_t))
+{
 #if defined(QSC_DILITHIUM_RANDOMIZED_SIGNING)
+    (void)mu;
+    (void)esk;
     rng_generate(rhoprime, DILITHIUM_CRHBYTES);
 #else
-    qsc_shake256_compute(rhoprime, DILITHIUM_CRHBYTES, key, DILITHIUM_SEEDBYTES + DILITHIUM_CRHBYTES);
+    uint8_t seedbuf[DILITHIUM_SEEDBYTES + DILITHIUM_CRHBYTES];
+
+    (void)rng_generate;
+    /* The message representative mu = CRH(tr, msg) follows the key */
+    qsc_memutils_copy(seedbuf, esk->key, DILITHIUM_SEEDBYTES);
+    qsc_memutils_copy(seedbuf + DILITHIUM_SEEDBYTES, mu, DILITHIUM_CRHBYTES);
+    qsc_shake256_compute(rhoprime, DILITHIUM_CRHBYTES, seedbuf, sizeof(seedbuf));
+    qsc_memutils_clear(seedbuf, sizeof(seedbuf));
 #endif
+}
 
-    /* Expand matrix and transform vectors */
-    dilithium_polyvec_matrix_expand(mat, rho);
-    dilithium_polyvecl_ntt(&s1);
-    dilithium_polyveck_ntt(&s2);
-    dilithium_polyveck_ntt(&t0);
+static bool dilithium_sign_attempt(uint8_t* sig, const uint8_t* mu, const uint8_t* rhoprime, uint16_t nonce, const qsc_dilithium_expanded_privatekey* esk)
+{
+    /* One iteration of the rejection loop; each nonce is independent of the others */
+    const qsc_dilithium_polyvecl* mat;
+    const qsc_dilithium_polyvecl* s1;
+    const qsc_dilithium_polyveck* s2;
+    const qsc_dilithium_polyveck* t0;
+    qsc_dilithium_polyvecl y;
+    qsc_dilithium_polyvecl z;
+    qsc_dilithium_polyveck h;
+    qsc_dilithium_polyveck w1;
+    qsc_dilithium_polyveck w0;
+    qsc_dilithium_poly cp;
+    qsc_keccak_state kctx;
+    uint32_t n;
 
-    while (true)
+    mat = esk->mat;
+    s1 = &esk->s1;
+    s2 = &esk->s2;
+    t0 = &esk->t0;
+
+    /* Sample intermediate vector y */
+    dilithium_polyvecl_uniform_gamma1(&y, rhoprime, nonce);
+    z = y;
+    dilithium_polyvecl_ntt(&z);
+
+    /* Matrix-vector multiplication */
+    dilithium_polyvec_matrix_pointwise_montgomery(&w1, mat, &z);
+    dilithium_polyveck_reduce(&w1);
+    dilithium_polyveck_invntt_to_mont(&w1);
+
+    /* Decompose w and call the random oracle */
+    dilithium_polyveck_caddq(&w1);
+    dilithium_polyveck_decompose(&w1, &w0, &w1);
+    dilithium_polyveck_pack_w1(sig, &w1);
+
+    qsc_keccak_initialize_state(&kctx);
+    qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, mu, DILITHIUM_CRHBYTES);
+    qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, sig, DILITHIUM_K * DILITHIUM_POLYW1_PACKEDBYTES);
+    qsc_keccak_incremental_finalize(&kctx, QSC_KECCAK_256_RATE, QSC_KECCAK_SHAKE_DOMAIN_ID);
+    qsc_keccak_incremental_squeeze(&kctx, QSC_KECCAK_256_RATE, sig, DILITHIUM_SEEDBYTES);
+
+    dilithium_poly_challenge(&cp, sig);
+    dilithium_poly_ntt(&cp);
+
+    /* Compute z, reject if it reveals secret */
+    dilithium_polyvecl_pointwise_poly_montgomery(&z, &cp, s1);
+    dilithium_polyvecl_invntt_to_mont(&z);
+    dilithium_polyvecl_add(&z, &z, &y);
+    dilithium_polyvecl_reduce(&z);
+
+    if (dilithium_polyvecl_chknorm(&z, DILITHIUM_GAMMA1 - DILITHIUM_BETA) != 0)
     {
-        /* Sample intermediate vector y */
-        dilithium_polyvecl_uniform_gamma1(&y, rhoprime, nonce);
-        ++nonce;
-        z = y;
-        dilithium_polyvecl_ntt(&z);
-
-        /* Matrix-vector multiplication */
-        dilithium_polyvec_matrix_pointwise_montgomery(&w1, mat, &z);
-        dilithium_polyveck_reduce(&w1);
-        dilithium_polyveck_invntt_to_mont(&w1);
-
-        /* Decompose w and call the random oracle */
-        dilithium_polyveck_caddq(&w1);
-        dilithium_polyveck_decompose(&w1, &w0, &w1);
-        dilithium_polyveck_pack_w1(sig, &w1);
-
-        qsc_keccak_initialize_state(&kctx);
-        qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, mu, DILITHIUM_CRHBYTES);
-        qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, sig, DILITHIUM_K * DILITHIUM_POLYW1_PACKEDBYTES);
-        qsc_keccak_incremental_finalize(&kctx, QSC_KECCAK_256_RATE, QSC_KECCAK_SHAKE_DOMAIN_ID);
-        qsc_keccak_incremental_squeeze(&kctx, QSC_KECCAK_256_RATE, sig, DILITHIUM_SEEDBYTES);
-
-        dilithium_poly_challenge(&cp, sig);
-        dilithium_poly_ntt(&cp);
-
-        /* Compute z, reject if it reveals secret */
-        dilithium_polyvecl_pointwise_poly_montgomery(&z, &cp, &s1);
-        dilithium_polyvecl_invntt_to_mont(&z);
-        dilithium_polyvecl_add(&z, &z, &y);
-        dilithium_polyvecl_reduce(&z);
-
-        if (dilithium_polyvecl_chknorm(&z, DILITHIUM_GAMMA1 - DILITHIUM_BETA) != 0)
+        return false;
+    }
+
+    /* Check that subtracting cs2 does not change high bits of w and low bits
+       do not reveal secret information */
+    dilithium_polyveck_pointwise_poly_montgomery(&h, &cp, s2);
+    dilithium_polyveck_invntt_to_mont(&h);
+    dilithium_polyveck_sub(&w0, &w0, &h);
+    dilithium_polyveck_reduce(&w0);
+
+    if (dilithium_polyveck_chknorm(&w0, DILITHIUM_GAMMA2 - DILITHIUM_BETA) != 0)
+    {
+        return false;
+    }
+
+    /* Compute hints for w1 */
+    dilithium_polyveck_pointwise_poly_montgomery(&h, &cp, t0);
+    dilithium_polyveck_invntt_to_mont(&h);
+    dilithium_polyveck_reduce(&h);
+
+    if (dilithium_polyveck_chknorm(&h, DILITHIUM_GAMMA2) != 0)
+    {
+        return false;
+    }
+
+    dilithium_polyveck_add(&w0, &w0, &h);
+    dilithium_polyveck_caddq(&w0);
+    n = dilithium_polyveck_make_hint(&h, &w0, &w1);
+
+    if (n > DILITHIUM_OMEGA)
+    {
+        return false;
+    }
+
+    /* Write signature */
+    dilithium_pack_sig(sig, sig, &z, &h);
+
+    return true;
+}
+
+static bool dilithium_sign_parallel_superseded(const dilithium_parallel_task* task, uint32_t iter)
+{
+    bool res;
+
+    res = *task->halt;
+
+    /* a worker publishes its accepted iteration once, so a stale read only delays the stop */
+    for (size_t i = 0; i < task->count && res == false; ++i)
+    {
+        res = (task->workers[i].accepted < iter);
+    }
+
+    return res;
+}
+
+static void dilithium_sign_parallel_worker(void* state)
+{
+    dilithium_parallel_task* task = (dilithium_parallel_task*)state;
+    uint32_t iter;
+
+    iter = task->first;
+
+    /* the worker persists across rejection rounds, and stops once it accepts a candidate
+       or another worker has accepted a lower iteration */
+    while (dilithium_sign_parallel_superseded(task, iter) == false)
+    {
+        if (dilithium_sign_attempt(task->sig, task->mu, task->rhoprime, (uint16_t)iter, task->esk) == true)
         {
-            continue;
+            task->accepted = iter;
+            break;
         }
 
-        /* Check that subtracting cs2 does not change high bits of w and low bits
-           do not reveal secret information */
-        dilithium_polyveck_pointwise_poly_montgomery(&h, &cp, &s2);
-        dilithium_polyveck_invntt_to_mont(&h);
-        dilithium_polyveck_sub(&w0, &w0, &h);
-        dilithium_polyveck_reduce(&w0);
+        iter += (uint32_t)task->count;
+    }
+}
+
+void qsc_dilithium_ref_sign_signature_mu(uint8_t* sig, size_t* siglen, const uint8_t* mu, const qsc_dilithium_expanded_privatekey* esk, bool (*rng_generate)(uint8_t*, size_t))
+{
+    uint8_t rhoprime[DILITHIUM_CRHBYTES];
+    uint16_t nonce;
+
+    nonce = 0;
+    dilithium_sign_rhoprime(rhoprime, mu, esk, rng_generate);
+
+    while (dilithium_sign_attempt(sig, mu, rhoprime, nonce, esk) == false)
+    {
+        ++nonce;
+    }
+
+    qsc_memutils_clear(rhoprime, sizeof(rhoprime));
+    *siglen = DILITHIUM_SIGNATURE_SIZE;
+}
 
-        if (dilithium_polyveck_chknorm(&w0, DILITHIUM_GAMMA2 - DILITHIUM_BETA) != 0)
+void qsc_dilithium_ref_sign_signature_mu_parallel(uint8_t* sig, size_t* siglen, const uint8_t* mu, const qsc_dilithium_expanded_privatekey* esk, bool (*rng_generate)(uint8_t*, size_t))
+{
+    qsc_thread thds[DILITHIUM_PARALLEL_MAX] = { 0 };
+    uint8_t rhoprime[DILITHIUM_CRHBYTES];
+    dilithium_parallel_task* tasks;
+    size_t i;
+    size_t sel;
+    size_t tcnt;
+    volatile bool halt;
+
+    tasks = NULL;
+    halt = true;
+    tcnt = qsc_intutils_min(qsc_async_processor_count(), (size_t)DILITHIUM_PARALLEL_MAX);
+
+    if (tcnt > 1)
+    {
+        tasks = (dilithium_parallel_task*)qsc_memutils_malloc(tcnt * sizeof(dilithium_parallel_task));
+    }
+
+    if (tasks != NULL)
+    {
+        halt = false;
+        dilithium_sign_rhoprime(rhoprime, mu, esk, rng_generate);
+
+        for (i = 0; i < tcnt; ++i)
         {
-            continue;
+            tasks[i].esk = esk;
+            tasks[i].mu = mu;
+            tasks[i].rhoprime = rhoprime;
+            tasks[i].workers = tasks;
+            tasks[i].halt = &halt;
+            tasks[i].count = tcnt;
+            tasks[i].first = (uint32_t)i;
+            tasks[i].accepted = DILITHIUM_PARALLEL_NONE;
         }
 
-        /* Compute hints for w1 */
-        dilithium_polyveck_pointwise_poly_montgomery(&h, &cp, &t0);
-        dilithium_polyveck_invntt_to_mont(&h);
-        dilithium_polyveck_reduce(&h);
-
-        if (dilithium_polyveck_chknorm(&h, DILITHIUM_GAMMA2) != 0)
+        /* the workers are created once per signature; if one cannot be started,
+           the running workers are stopped and the sequential signer is used */
+        for (i = 0; i < tcnt; ++i)
         {
-            continue;
+            thds[i] = qsc_async_thread_create(dilithium_sign_parallel_worker, &tasks[i]);
+
+            if (thds[i] == 0)
+            {
+                halt = true;
+                break;
+            }
         }
 
-        dilithium_polyveck_add(&w0, &w0, &h);
-        dilithium_polyveck_caddq(&w0);
-        n = dilithium_polyveck_make_hint(&h, &w0, &w1);
+        qsc_async_thread_wait_all(thds, i);
 
-        if (n > DILITHIUM_OMEGA)
+        if (halt == false)
         {
-            continue;
+            /* keep the lowest accepted iteration, so the signature is the one the sequential loop would have produced */
+            sel = 0;
+
+            for (i = 1; i < tcnt; ++i)
+            {
+                if (tasks[i].accepted < tasks[sel].accepted)
+                {
+                    sel = i;
+                }
+            }
+
+            qsc_memutils_copy(sig, tasks[sel].sig, DILITHIUM_SIGNATURE_SIZE);
+            *siglen = DILITHIUM_SIGNATURE_SIZE;
         }
 
-        break;
+        /* rejected candidates leak information about the secret key */
+        qsc_memutils_clear((uint8_t*)tasks, tcnt * sizeof(dilithium_parallel_task));
+        qsc_memutils_alloc_free(tasks);
+        qsc_memutils_clear(rhoprime, sizeof(rhoprime));
     }
 
-    /* Write signature */
-    dilithium_pack_sig(sig, sig, &z, &h);
-    *siglen = DILITHIUM_SIGNATURE_SIZE;
+    if (halt == true)
+    {
+        qsc_dilithium_ref_sign_signature_mu(sig, siglen, mu, esk, rng_generate);
+    }
+}
+
+void qsc_dilithium_ref_sign_signature_expanded(uint8_t* sig, size_t* siglen, const uint8_t* m, size_t mlen, const qsc_dilithium_expanded_privatekey* esk, bool (*rng_generate)(uint8_t*, size_t))
+{
+    uint8_t mu[DILITHIUM_CRHBYTES];
+    qsc_keccak_state kctx;
+
+    /* Compute CRH(tr, msg) */
+    qsc_keccak_initialize_state(&kctx);
+    qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, esk->tr, DILITHIUM_CRHBYTES);
+    qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, m, mlen);
+    qsc_keccak_incremental_finalize(&kctx, QSC_KECCAK_256_RATE, QSC_KECCAK_SHAKE_DOMAIN_ID);
+    qsc_keccak_incremental_squeeze(&kctx, QSC_KECCAK_256_RATE, mu, DILITHIUM_CRHBYTES);
+
+    qsc_dilithium_ref_sign_signature_mu(sig, siglen, mu, esk, rng_generate);
+}
+
+void qsc_dilithium_ref_sign_signature(uint8_t* sig, size_t* siglen, const uint8_t* m, size_t mlen, const uint8_t* sk, bool (*rng_generate)(uint8_t*, size_t))
+{
+    qsc_dilithium_expanded_privatekey esk;
+
+    qsc_dilithium_ref_expand_privatekey(&esk, sk);
+    qsc_dilithium_ref_sign_signature_expanded(sig, siglen, m, mlen, &esk, rng_generate);
+    qsc_memutils_clear(&esk, sizeof(esk));
 }
 
 void qsc_dilithium_ref_sign(uint8_t* sm, size_t* smlen, const uint8_t* m, size_t mlen, const uint8_t* sk, bool (*rng_generate)(uint8_t*, size_t))
@@ -1603,19 +1782,27 @@ void qsc_dilithium_ref_sign(uint8_t* sm, size_t* smlen, const uint8_t* m, size_t
     *smlen += mlen;
 }
 
-bool qsc_dilithium_ref_verify(const uint8_t* sig, size_t siglen, const uint8_t* m, size_t mlen, const uint8_t* pk)
+void qsc_dilithium_ref_sign_expanded(uint8_t* sm, size_t* smlen, const uint8_t* m, size_t mlen, const qsc_dilithium_expanded_privatekey* esk, bool (*rng_generate)(uint8_t*, size_t))
+{
+    for (size_t i = 0; i < mlen; ++i)
+    {
+        sm[DILITHIUM_SIGNATURE_SIZE + mlen - 1 - i] = m[mlen - 1 - i];
+    }
+
+    qsc_dilithium_ref_sign_signature_expanded(sm, smlen, sm + DILITHIUM_SIGNATURE_SIZE, mlen, esk, rng_generate);
+    *smlen += mlen;
+}
+
+bool qsc_dilithium_ref_verify_mu(const uint8_t* sig, size_t siglen, const uint8_t* mu, const qsc_dilithium_expanded_publickey* epk)
 {
     uint8_t buf[DILITHIUM_K * DILITHIUM_POLYW1_PACKEDBYTES];
-    uint8_t rho[DILITHIUM_SEEDBYTES];
-    uint8_t mu[DILITHIUM_CRHBYTES];
     uint8_t c[DILITHIUM_SEEDBYTES];
     uint8_t c2[DILITHIUM_SEEDBYTES];
-    dilithium_polyvecl mat[DILITHIUM_K];
-    dilithium_polyvecl z;
-    dilithium_polyveck h;
-    dilithium_polyveck t1;
-    dilithium_polyveck w1;
-    dilithium_poly cp;
+    qsc_dilithium_polyvecl z;
+    qsc_dilithium_polyveck h;
+    qsc_dilithium_polyveck t1;
+    qsc_dilithium_polyveck w1;
+    qsc_dilithium_poly cp;
     qsc_keccak_state kctx = { 0 };
     bool res;
 
@@ -1623,31 +1810,17 @@ bool qsc_dilithium_ref_verify(const uint8_t* sig, size_t siglen, const uint8_t*
 
     if (siglen >= DILITHIUM_SIGNATURE_SIZE)
     {
-        dilithium_unpack_pk(rho, &t1, pk);
-
         if (dilithium_unpack_sig(c, &z, &h, sig) == 0)
         {
             if (dilithium_polyvecl_chknorm(&z, DILITHIUM_GAMMA1 - DILITHIUM_BETA) == 0)
             {
-                /* Compute CRH(CRH(rho, t1), msg) */
-                qsc_shake256_compute(mu, DILITHIUM_CRHBYTES, pk, DILITHIUM_PUBLICKEY_SIZE);
-
-                qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, mu, DILITHIUM_CRHBYTES);
-                qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, m, mlen);
-                qsc_keccak_incremental_finalize(&kctx, QSC_KECCAK_256_RATE, QSC_KECCAK_SHAKE_DOMAIN_ID);
-                qsc_keccak_incremental_squeeze(&kctx, QSC_KECCAK_256_RATE, mu, DILITHIUM_CRHBYTES);
-
                 /* Matrix-vector multiplication; compute Az - c2^dt1 */
                 dilithium_poly_challenge(&cp, c);
-                dilithium_polyvec_matrix_expand(mat, rho);
-
                 dilithium_polyvecl_ntt(&z);
-                dilithium_polyvec_matrix_pointwise_montgomery(&w1, mat, &z);
+                dilithium_polyvec_matrix_pointwise_montgomery(&w1, epk->mat, &z);
 
                 dilithium_poly_ntt(&cp);
-                dilithium_polyveck_shiftl(&t1);
-                dilithium_polyveck_ntt(&t1);
-                dilithium_polyveck_pointwise_poly_montgomery(&t1, &cp, &t1);
+                dilithium_polyveck_pointwise_poly_montgomery(&t1, &cp, &epk->t1);
 
                 dilithium_polyveck_sub(&w1, &w1, &t1);
                 dilithium_polyveck_reduce(&w1);
@@ -1673,6 +1846,30 @@ bool qsc_dilithium_ref_verify(const uint8_t* sig, size_t siglen, const uint8_t*
     return res;
 }
 
+bool qsc_dilithium_ref_verify_expanded(const uint8_t* sig, size_t siglen, const uint8_t* m, size_t mlen, const qsc_dilithium_expanded_publickey* epk)
+{
+    uint8_t mu[DILITHIUM_CRHBYTES];
+    qsc_keccak_state kctx;
+
+    /* Compute CRH(CRH(rho, t1), msg) */
+    qsc_keccak_initialize_state(&kctx);
+    qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, epk->tr, DILITHIUM_CRHBYTES);
+    qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, m, mlen);
+    qsc_keccak_incremental_finalize(&kctx, QSC_KECCAK_256_RATE, QSC_KECCAK_SHAKE_DOMAIN_ID);
+    qsc_keccak_incremental_squeeze(&kctx, QSC_KECCAK_256_RATE, mu, DILITHIUM_CRHBYTES);
+
+    return qsc_dilithium_ref_verify_mu(sig, siglen, mu, epk);
+}
+
+bool qsc_dilithium_ref_verify(const uint8_t* sig, size_t siglen, const uint8_t* m, size_t mlen, const uint8_t* pk)
+{
+    qsc_dilithium_expanded_publickey epk;
+
+    qsc_dilithium_ref_expand_publickey(&epk, pk);
+
+    return qsc_dilithium_ref_verify_expanded(sig, siglen, m, mlen, &epk);
+}
+
 bool qsc_dilithium_ref_open(uint8_t* m, size_t* mlen, const uint8_t* sm, size_t smlen, const uint8_t* pk)
 {
     bool res;
@@ -1692,7 +1889,34 @@ bool qsc_dilithium_ref_open(uint8_t* m, size_t* mlen, const uint8_t* sm, size_t
         }
     }
 
-    if (res == false)
+    if (res == false && smlen >= DILITHIUM_SIGNATURE_SIZE)
+    {
+        qsc_memutils_clear(m, smlen - DILITHIUM_SIGNATURE_SIZE);
+    }
+
+    return res;
+}
+
+bool qsc_dilithium_ref_open_expanded(uint8_t* m, size_t* mlen, const uint8_t* sm, size_t smlen, const qsc_dilithium_expanded_publickey* epk)
+{
+    bool res;
+
+    *mlen = -1;
+    res = false;
+
+    if (smlen >= DILITHIUM_SIGNATURE_SIZE)
+    {
+        *mlen = smlen - DILITHIUM_SIGNATURE_SIZE;
+        res = qsc_dilithium_ref_verify_expanded(sm, DILITHIUM_SIGNATURE_SIZE, sm + DILITHIUM_SIGNATURE_SIZE, *mlen, epk);
+
+        if (res == true)
+        {
+            /* All good, copy msg, return 0 */
+            qsc_memutils_copy(m, sm + DILITHIUM_SIGNATURE_SIZE, *mlen);
+        }
+    }
+
+    if (res == false && smlen >= DILITHIUM_SIGNATURE_SIZE)
     {
         qsc_memutils_clear(m, smlen - DILITHIUM_SIGNATURE_SIZE);
     }
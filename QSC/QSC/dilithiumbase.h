@@ -32,6 +32,7 @@
 /* \cond DOXYGEN_IGNORE */
 
 #include "common.h"
+#include "dilithium.h"
 
 /**
 * \brief Generates a Dilithium public/private key-pair.
@@ -43,6 +44,22 @@
 */
 void qsc_dilithium_ref_generate_keypair(uint8_t* pk, uint8_t* sk, bool (*rng_generate)(uint8_t*, size_t));
 
+/**
+* \brief Expands a private key into the public matrix and the NTT domain secret vectors
+*
+* \param esk: The expanded private signature key
+* \param sk: [const] The private signature key
+*/
+void qsc_dilithium_ref_expand_privatekey(qsc_dilithium_expanded_privatekey* esk, const uint8_t* sk);
+
+/**
+* \brief Expands a public key into the public matrix and the NTT domain public vector
+*
+* \param epk: The expanded public verification key
+* \param pk: [const] The public verification key
+*/
+void qsc_dilithium_ref_expand_publickey(qsc_dilithium_expanded_publickey* epk, const uint8_t* pk);
+
 /**
 * \brief Takes the message as input and returns an array containing the signature
 *
@@ -55,6 +72,42 @@ void qsc_dilithium_ref_generate_keypair(uint8_t* pk, uint8_t* sk, bool (*rng_gen
 */
 void qsc_dilithium_ref_sign_signature(uint8_t* sig, size_t* siglen, const uint8_t* m, size_t mlen, const uint8_t* sk, bool (*rng_generate)(uint8_t*, size_t));
 
+/**
+* \brief Takes the message as input and returns an array containing the signature, using an expanded private key
+*
+* \param sig: The signed message
+* \param siglen: The signed message length
+* \param m: [const] The message to be signed
+* \param mlen: The message length
+* \param esk: [const] The expanded private signature key
+* \param rng_generate: The random generator
+*/
+void qsc_dilithium_ref_sign_signature_expanded(uint8_t* sig, size_t* siglen, const uint8_t* m, size_t mlen, const qsc_dilithium_expanded_privatekey* esk, bool (*rng_generate)(uint8_t*, size_t));
+
+/**
+* \brief Signs a precomputed message representative mu = CRH(tr, msg) and returns the signature, using an expanded private key
+*
+* \param sig: The signature
+* \param siglen: The signature length
+* \param mu: [const] The message representative
+* \param esk: [const] The expanded private signature key
+* \param rng_generate: The random generator
+*/
+void qsc_dilithium_ref_sign_signature_mu(uint8_t* sig, size_t* siglen, const uint8_t* mu, const qsc_dilithium_expanded_privatekey* esk, bool (*rng_generate)(uint8_t*, size_t));
+
+/**
+* \brief Signs a precomputed message representative using several threads.
+* Consecutive rejection-loop nonces are evaluated concurrently, and the lowest accepted nonce is kept,
+* so the signature is identical to the one returned by the sequential signing function.
+*
+* \param sig: The signature
+* \param siglen: The signature length
+* \param mu: [const] The message representative
+* \param esk: [const] The expanded private signature key
+* \param rng_generate: The random generator
+*/
+void qsc_dilithium_ref_sign_signature_mu_parallel(uint8_t* sig, size_t* siglen, const uint8_t* mu, const qsc_dilithium_expanded_privatekey* esk, bool (*rng_generate)(uint8_t*, size_t));
+
 /**
 * \brief Takes the message as input and returns an array containing the signature followed by the message
 *
@@ -67,6 +120,18 @@ void qsc_dilithium_ref_sign_signature(uint8_t* sig, size_t* siglen, const uint8_
 */
 void qsc_dilithium_ref_sign(uint8_t* sm, size_t* smlen, const uint8_t* m, size_t mlen, const uint8_t* sk, bool (*rng_generate)(uint8_t*, size_t));
 
+/**
+* \brief Takes the message as input and returns an array containing the signature followed by the message, using an expanded private key
+*
+* \param sm: The signed message
+* \param smlen: The signed message length
+* \param m: [const] The message to be signed
+* \param mlen: The message length
+* \param esk: [const] The expanded private signature key
+* \param rng_generate: The random generator
+*/
+void qsc_dilithium_ref_sign_expanded(uint8_t* sm, size_t* smlen, const uint8_t* m, size_t mlen, const qsc_dilithium_expanded_privatekey* esk, bool (*rng_generate)(uint8_t*, size_t));
+
 /**
 * \brief Verifies a signature-message pair with the public key.
 *
@@ -79,6 +144,29 @@ void qsc_dilithium_ref_sign(uint8_t* sm, size_t* smlen, const uint8_t* m, size_t
 */
 bool qsc_dilithium_ref_verify(const uint8_t* sig, size_t siglen, const uint8_t* m, size_t mlen, const uint8_t* pk);
 
+/**
+* \brief Verifies a signature-message pair with an expanded public key.
+*
+* \param sig: [const] The signature
+* \param siglen: The signature length
+* \param m: [const] The message
+* \param mlen: The message length
+* \param epk: [const] The expanded public verification key
+* \return Returns true for success
+*/
+bool qsc_dilithium_ref_verify_expanded(const uint8_t* sig, size_t siglen, const uint8_t* m, size_t mlen, const qsc_dilithium_expanded_publickey* epk);
+
+/**
+* \brief Verifies a signature against a precomputed message representative mu = CRH(CRH(rho, t1), msg) with an expanded public key.
+*
+* \param sig: [const] The signature
+* \param siglen: The signature length
+* \param mu: [const] The message representative
+* \param epk: [const] The expanded public verification key
+* \return Returns true for success
+*/
+bool qsc_dilithium_ref_verify_mu(const uint8_t* sig, size_t siglen, const uint8_t* mu, const qsc_dilithium_expanded_publickey* epk);
+
 /**
 * \brief Verifies a signature-message pair with the public key.
 *
@@ -91,6 +179,18 @@ bool qsc_dilithium_ref_verify(const uint8_t* sig, size_t siglen, const uint8_t*
 */
 bool qsc_dilithium_ref_open(uint8_t* m, size_t* mlen, const uint8_t* sm, size_t smlen, const uint8_t* pk);
 
+/**
+* \brief Verifies a signature-message pair with an expanded public key.
+*
+* \param m: The message output
+* \param mlen: The message length
+* \param sm: [const] The signed message
+* \param smlen: The signed message length
+* \param epk: [const] The expanded public verification key
+* \return Returns true for success
+*/
+bool qsc_dilithium_ref_open_expanded(uint8_t* m, size_t* mlen, const uint8_t* sm, size_t smlen, const qsc_dilithium_expanded_publickey* epk);
+
 /* \endcond DOXYGEN_IGNORE */
 
 #endif
@@ -1,4 +1,5 @@
 #include "dilithiumbase_avx2.h"
+#include "async.h"
 #include "intutils.h"
 #include "memutils.h"
 #include "sha3.h"
@@ -110,32 +111,29 @@
 
 #define DILITHIUM_REJ_UNIFORM_BUFLEN ((768 + QSC_KECCAK_128_RATE - 1) / QSC_KECCAK_128_RATE * QSC_KECCAK_128_RATE)
 
-/*!
-* \struct dilithium_poly
-* \brief Array of coefficients of length N
-*/
-typedef struct
-{
-    int32_t coeffs[DILITHIUM_N];            /*!< The coefficients  */
-} dilithium_poly;
+/* the parallel signer runs one worker per processor, each evaluating every n-th rejection-loop
+   iteration; on average fewer than six iterations are needed, so more workers rarely help */
+#define DILITHIUM_PARALLEL_MAX 8
 
-/*!
-* \struct dilithium_polyvecl
-* \brief Vectors of polynomials of length L
-*/
-typedef struct
-{
-    dilithium_poly vec[DILITHIUM_L];    /*!< The poly vector of L  */
-} dilithium_polyvecl;
+/* the accepted iteration of a worker that has not accepted a candidate */
+#define DILITHIUM_PARALLEL_NONE 0xFFFFFFFFUL
 
 /*!
-* \struct dilithium_polyveck
-* \brief Vectors of polynomials of length K
+* \struct dilithium_parallel_task
+* \brief A parallel signing worker, evaluating every count-th rejection-loop iteration from first
 */
-typedef struct
+typedef struct dilithium_parallel_task
 {
-    dilithium_poly vec[DILITHIUM_K];    /*!< The poly vector of K  */
-} dilithium_polyveck;
+    uint8_t sig[DILITHIUM_SIGNATURE_SIZE];                  /*!< The accepted candidate signature  */
+    const qsc_dilithium_expanded_privatekey* esk;           /*!< The expanded private key  */
+    const uint8_t* mu;                                      /*!< The message representative  */
+    const uint8_t* rhoprime;                                /*!< The masking seed  */
+    const struct dilithium_parallel_task* workers;          /*!< The worker set, polled to stop early  */
+    const volatile bool* halt;                              /*!< Set when the worker set could not be started  */
+    size_t count;                                           /*!< The number of workers  */
+    uint32_t first;                                         /*!< The first iteration evaluated by the worker  */
+    volatile uint32_t accepted;                             /*!< The accepted iteration, or DILITHIUM_PARALLEL_NONE  */
+} dilithium_parallel_task;
 
 QSC_ALIGN(64) static const uint8_t dilithium_rej_avx2[256][8] = {
   { 0,  0,  0,  0,  0,  0,  0,  0}, { 0,  0,  0,  0,  0,  0,  0,  0}, { 1,  0,  0,  0,  0,  0,  0,  0}, { 0,  1,  0,  0,  0,  0,  0,  0},
@@ -240,6 +238,253 @@ static const int32_t dilithium_zetas[DILITHIUM_N] =
     0xFFF78A50L, 0x003BCF2CL, 0xFFFF434EL, 0xFFEB36DFL, 0x003C15CAL, 0x00155E68L, 0xFFF316B6L, 0x001E29CEL
 };
 
+#if defined(QSC_SYSTEM_HAS_AVX512)
+/* the AVX-512 transform zetas; for each 32 coefficient block, the length 8, 4, 2 and 1 layer zetas,
+   ordered to match the lanes of the shuffled vector pair */
+static const int32_t dilithium_ntt_zetas_avx512[512] =
+{
+    0x00299658L, 0x00299658L, 0x00299658L, 0x00299658L, 0x00299658L, 0x00299658L, 0x00299658L, 0x00299658L,
+    0x000FA070L, 0x000FA070L, 0x000FA070L, 0x000FA070L, 0x000FA070L, 0x000FA070L, 0x000FA070L, 0x000FA070L,
+    0x00294A67L, 0x00294A67L, 0x00294A67L, 0x00294A67L, 0x00017620L, 0x00017620L, 0x00017620L, 0x00017620L,
+    0x002EF4CDL, 0x002EF4CDL, 0x002EF4CDL, 0x002EF4CDL, 0x0035DEC5L, 0x0035DEC5L, 0x0035DEC5L, 0x0035DEC5L,
+    0xFFC406E5L, 0xFFC406E5L, 0xFFE8AC81L, 0xFFE8AC81L, 0xFFC7E1CFL, 0xFFC7E1CFL, 0xFFD19819L, 0xFFD19819L,
+    0xFFE9D65DL, 0xFFE9D65DL, 0x003509EEL, 0x003509EEL, 0x002135C7L, 0x002135C7L, 0xFFE7CFBBL, 0xFFE7CFBBL,
+    0x001FEA93L, 0x0033FF5AL, 0x002358D4L, 0x003A41F8L, 0xFFCCFF72L, 0x00223DFBL, 0xFFDAAB9FL, 0xFFC9A422L,
+    0x000412F5L, 0x00252587L, 0xFFED24F0L, 0x00359B5DL, 0xFFCA48A0L, 0xFFC6A2FCL, 0xFFEDBB56L, 0xFFCF45DEL,
+    0xFFEF85A4L, 0xFFEF85A4L, 0xFFEF85A4L, 0xFFEF85A4L, 0xFFEF85A4L, 0xFFEF85A4L, 0xFFEF85A4L, 0xFFEF85A4L,
+    0x0036B788L, 0x0036B788L, 0x0036B788L, 0x0036B788L, 0x0036B788L, 0x0036B788L, 0x0036B788L, 0x0036B788L,
+    0xFFE6A503L, 0xFFE6A503L, 0xFFE6A503L, 0xFFE6A503L, 0xFFC9302CL, 0xFFC9302CL, 0xFFC9302CL, 0xFFC9302CL,
+    0xFFD947D4L, 0xFFD947D4L, 0xFFD947D4L, 0xFFD947D4L, 0x003BBEAFL, 0x003BBEAFL, 0x003BBEAFL, 0x003BBEAFL,
+    0xFFECCF75L, 0xFFECCF75L, 0x001D9772L, 0x001D9772L, 0xFFC1B072L, 0xFFC1B072L, 0xFFF0BCF6L, 0xFFF0BCF6L,
+    0xFFCF5280L, 0xFFCF5280L, 0xFFCFD2AEL, 0xFFCFD2AEL, 0xFFC890E0L, 0xFFC890E0L, 0x0001EFCAL, 0x0001EFCAL,
+    0x000DBE5EL, 0x001C5E1AL, 0x000DE0E6L, 0x000C7F5AL, 0x00078F83L, 0xFFE7628AL, 0xFFFF5704L, 0xFFF806FCL,
+    0xFFF60021L, 0xFFD05AF6L, 0x001F0084L, 0x0030EF86L, 0xFFC9B97DL, 0xFFF7FCD6L, 0xFFF44592L, 0xFFC921C2L,
+    0xFFF79D90L, 0xFFF79D90L, 0xFFF79D90L, 0xFFF79D90L, 0xFFF79D90L, 0xFFF79D90L, 0xFFF79D90L, 0xFFF79D90L,
+    0xFFEEEAA0L, 0xFFEEEAA0L, 0xFFEEEAA0L, 0xFFEEEAA0L, 0xFFEEEAA0L, 0xFFEEEAA0L, 0xFFEEEAA0L, 0xFFEEEAA0L,
+    0xFFC51585L, 0xFFC51585L, 0xFFC51585L, 0xFFC51585L, 0xFFD18E7CL, 0xFFD18E7CL, 0xFFD18E7CL, 0xFFD18E7CL,
+    0x00368A96L, 0x00368A96L, 0x00368A96L, 0x00368A96L, 0xFFD43E41L, 0xFFD43E41L, 0xFFD43E41L, 0xFFD43E41L,
+    0x003410F2L, 0x003410F2L, 0xFFF0FE85L, 0xFFF0FE85L, 0x0020C638L, 0x0020C638L, 0x00296E9FL, 0x00296E9FL,
+    0xFFD2B7A3L, 0xFFD2B7A3L, 0xFFC7A44BL, 0xFFC7A44BL, 0xFFF9BA6DL, 0xFFF9BA6DL, 0xFFDA3409L, 0xFFDA3409L,
+    0x00053919L, 0x0004610CL, 0xFFDACD41L, 0x003EB01BL, 0x003472E7L, 0xFFCD003BL, 0x001A7CC7L, 0x00031924L,
+    0x002B5EE5L, 0x00291199L, 0xFFD87A3AL, 0x00134D71L, 0x003DE11CL, 0x00130984L, 0x0025F051L, 0x00185A46L,
+    0x0027F968L, 0x0027F968L, 0x0027F968L, 0x0027F968L, 0x0027F968L, 0x0027F968L, 0x0027F968L, 0x0027F968L,
+    0xFFDFD37BL, 0xFFDFD37BL, 0xFFDFD37BL, 0xFFDFD37BL, 0xFFDFD37BL, 0xFFDFD37BL, 0xFFDFD37BL, 0xFFDFD37BL,
+    0x00360400L, 0x00360400L, 0x00360400L, 0x00360400L, 0xFFFB6A4DL, 0xFFFB6A4DL, 0xFFFB6A4DL, 0xFFFB6A4DL,
+    0x0023D69CL, 0x0023D69CL, 0x0023D69CL, 0x0023D69CL, 0xFFF7C55DL, 0xFFF7C55DL, 0xFFF7C55DL, 0xFFF7C55DL,
+    0xFFF5C282L, 0xFFF5C282L, 0xFFED4113L, 0xFFED4113L, 0xFFFFA63BL, 0xFFFFA63BL, 0xFFEC09F7L, 0xFFEC09F7L,
+    0xFFFA2BDDL, 0xFFFA2BDDL, 0x001495D4L, 0x001495D4L, 0x001C4563L, 0x001C4563L, 0xFFEA2C62L, 0xFFEA2C62L,
+    0xFFC68518L, 0x001314BEL, 0x00283891L, 0xFFC9DB90L, 0xFFD25089L, 0x001C853FL, 0x001D0B4BL, 0xFFEFF6A6L,
+    0xFFEBA8BEL, 0x0012E11BL, 0xFFCD5E3EL, 0xFFEA2D2FL, 0xFFF91DE4L, 0x001406C7L, 0x00327283L, 0xFFE20D6EL,
+    0xFFDFADD6L, 0xFFDFADD6L, 0xFFDFADD6L, 0xFFDFADD6L, 0xFFDFADD6L, 0xFFDFADD6L, 0xFFDFADD6L, 0xFFDFADD6L,
+    0xFFC51AE7L, 0xFFC51AE7L, 0xFFC51AE7L, 0xFFC51AE7L, 0xFFC51AE7L, 0xFFC51AE7L, 0xFFC51AE7L, 0xFFC51AE7L,
+    0xFFE6123DL, 0xFFE6123DL, 0xFFE6123DL, 0xFFE6123DL, 0xFFE6EAD6L, 0xFFE6EAD6L, 0xFFE6EAD6L, 0xFFE6EAD6L,
+    0x00357E1EL, 0x00357E1EL, 0x00357E1EL, 0x00357E1EL, 0xFFC5AF59L, 0xFFC5AF59L, 0xFFC5AF59L, 0xFFC5AF59L,
+    0xFFCCFBE9L, 0xFFCCFBE9L, 0x00040AF0L, 0x00040AF0L, 0x0007C417L, 0x0007C417L, 0x002F4588L, 0x002F4588L,
+    0x0000AD00L, 0x0000AD00L, 0xFFEF36BEL, 0xFFEF36BEL, 0x000DCD44L, 0x000DCD44L, 0x003C675AL, 0x003C675AL,
+    0xFFEC7953L, 0x001D4099L, 0xFFD92578L, 0xFFEB05ADL, 0x0016E405L, 0x000BDBE7L, 0x00221DE8L, 0x0033F8CFL,
+    0xFFF7B934L, 0xFFD4CA0CL, 0xFFE67FF8L, 0xFFE3D157L, 0xFFD8911BL, 0xFFC72C12L, 0x000910D8L, 0xFFC65E1FL,
+    0xFFEAA4F7L, 0xFFEAA4F7L, 0xFFEAA4F7L, 0xFFEAA4F7L, 0xFFEAA4F7L, 0xFFEAA4F7L, 0xFFEAA4F7L, 0xFFEAA4F7L,
+    0xFFCDFC98L, 0xFFCDFC98L, 0xFFCDFC98L, 0xFFCDFC98L, 0xFFCDFC98L, 0xFFCDFC98L, 0xFFCDFC98L, 0xFFCDFC98L,
+    0x0035843FL, 0x0035843FL, 0x0035843FL, 0x0035843FL, 0xFFDF5617L, 0xFFDF5617L, 0xFFDF5617L, 0xFFDF5617L,
+    0xFFE7945CL, 0xFFE7945CL, 0xFFE7945CL, 0xFFE7945CL, 0x0038738CL, 0x0038738CL, 0x0038738CL, 0x0038738CL,
+    0xFFC72BCAL, 0xFFC72BCAL, 0xFFFFDE7EL, 0xFFFFDE7EL, 0x00193948L, 0x00193948L, 0xFFCE69C0L, 0xFFCE69C0L,
+    0x0024756CL, 0x0024756CL, 0xFFFCC7DFL, 0xFFFCC7DFL, 0x000B98A1L, 0x000B98A1L, 0xFFEBE808L, 0xFFEBE808L,
+    0xFFE14658L, 0x00251D8BL, 0x002573B7L, 0xFFFD7C8FL, 0x001DDD98L, 0x00336898L, 0x0002D4BBL, 0xFFED93A7L,
+    0xFFCF6CBEL, 0x00027C1CL, 0x0018AA08L, 0x002DFD71L, 0x000C5CA5L, 0x0019379AL, 0xFFC7A167L, 0xFFE48C3DL,
+    0x001AD035L, 0x001AD035L, 0x001AD035L, 0x001AD035L, 0x001AD035L, 0x001AD035L, 0x001AD035L, 0x001AD035L,
+    0xFFFFB422L, 0xFFFFB422L, 0xFFFFB422L, 0xFFFFB422L, 0xFFFFB422L, 0xFFFFB422L, 0xFFFFB422L, 0xFFFFB422L,
+    0x000C63A8L, 0x000C63A8L, 0x000C63A8L, 0x000C63A8L, 0x00081B9AL, 0x00081B9AL, 0x00081B9AL, 0x00081B9AL,
+    0x000E8F76L, 0x000E8F76L, 0x000E8F76L, 0x000E8F76L, 0x003B3853L, 0x003B3853L, 0x003B3853L, 0x003B3853L,
+    0x0002E46CL, 0x0002E46CL, 0xFFC9C808L, 0xFFC9C808L, 0x003036C2L, 0x003036C2L, 0xFFE3BFF6L, 0xFFE3BFF6L,
+    0xFFDB3C93L, 0xFFDB3C93L, 0xFFFD4AE0L, 0xFFFD4AE0L, 0x00141305L, 0x00141305L, 0x00147792L, 0x00147792L,
+    0xFFD1A13CL, 0x0035C539L, 0x003B0115L, 0x00041DC0L, 0x0021C4F7L, 0xFFF11BF4L, 0x001A35E7L, 0x0007340EL,
+    0xFFF97D45L, 0x001A4CD0L, 0xFFE47CAEL, 0x001D2668L, 0xFFE68E98L, 0xFFEF2633L, 0xFFFC05DAL, 0xFFC57FDBL,
+    0x003D3201L, 0x003D3201L, 0x003D3201L, 0x003D3201L, 0x003D3201L, 0x003D3201L, 0x003D3201L, 0x003D3201L,
+    0x000445C5L, 0x000445C5L, 0x000445C5L, 0x000445C5L, 0x000445C5L, 0x000445C5L, 0x000445C5L, 0x000445C5L,
+    0x003B8534L, 0x003B8534L, 0x003B8534L, 0x003B8534L, 0xFFD8FC30L, 0xFFD8FC30L, 0xFFD8FC30L, 0xFFD8FC30L,
+    0x001F9D54L, 0x001F9D54L, 0x001F9D54L, 0x001F9D54L, 0xFFD54F2DL, 0xFFD54F2DL, 0xFFD54F2DL, 0xFFD54F2DL,
+    0x00139E25L, 0x00139E25L, 0xFFE7D0E0L, 0xFFE7D0E0L, 0xFFF39944L, 0xFFF39944L, 0xFFEA0802L, 0xFFEA0802L,
+    0xFFD1EEA2L, 0xFFD1EEA2L, 0xFFC4C79CL, 0xFFC4C79CL, 0xFFC8A057L, 0xFFC8A057L, 0x003A97D9L, 0x003A97D9L,
+    0xFFD32764L, 0xFFDDE1AFL, 0xFFF993DDL, 0xFFDD1D09L, 0x0002CC93L, 0xFFF11805L, 0x00189C2AL, 0xFFC9E5A9L,
+    0xFFF78A50L, 0x003BCF2CL, 0xFFFF434EL, 0xFFEB36DFL, 0x003C15CAL, 0x00155E68L, 0xFFF316B6L, 0x001E29CEL
+};
+
+/* the negated AVX-512 inverse transform zetas; for each block, the length 1, 2, 4 and 8 layer zetas */
+static const int32_t dilithium_invntt_zetas_avx512[512] =
+{
+    0xFFE1D632L, 0x000CE94AL, 0xFFEAA198L, 0xFFC3EA36L, 0x0014C921L, 0x0000BCB2L, 0xFFC430D4L, 0x000875B0L,
+    0x00361A57L, 0xFFE763D6L, 0x000EE7FBL, 0xFFFD336DL, 0x0022E2F7L, 0x00066C23L, 0x00221E51L, 0x002CD89CL,
+    0xFFC56827L, 0xFFC56827L, 0x00375FA9L, 0x00375FA9L, 0x003B3864L, 0x003B3864L, 0x002E115EL, 0x002E115EL,
+    0x0015F7FEL, 0x0015F7FEL, 0x000C66BCL, 0x000C66BCL, 0x00182F20L, 0x00182F20L, 0xFFEC61DBL, 0xFFEC61DBL,
+    0x002AB0D3L, 0x002AB0D3L, 0x002AB0D3L, 0x002AB0D3L, 0xFFE062ACL, 0xFFE062ACL, 0xFFE062ACL, 0xFFE062ACL,
+    0x002703D0L, 0x002703D0L, 0x002703D0L, 0x002703D0L, 0xFFC47ACCL, 0xFFC47ACCL, 0xFFC47ACCL, 0xFFC47ACCL,
+    0xFFFBBA3BL, 0xFFFBBA3BL, 0xFFFBBA3BL, 0xFFFBBA3BL, 0xFFFBBA3BL, 0xFFFBBA3BL, 0xFFFBBA3BL, 0xFFFBBA3BL,
+    0xFFC2CDFFL, 0xFFC2CDFFL, 0xFFC2CDFFL, 0xFFC2CDFFL, 0xFFC2CDFFL, 0xFFC2CDFFL, 0xFFC2CDFFL, 0xFFC2CDFFL,
+    0x003A8025L, 0x0003FA26L, 0x0010D9CDL, 0x00197168L, 0xFFE2D998L, 0x001B8352L, 0xFFE5B330L, 0x000682BBL,
+    0xFFF8CBF2L, 0xFFE5CA19L, 0x000EE40CL, 0xFFDE3B09L, 0xFFFBE240L, 0xFFC4FEEBL, 0xFFCA3AC7L, 0x002E5EC4L,
+    0xFFEB886EL, 0xFFEB886EL, 0xFFEBECFBL, 0xFFEBECFBL, 0x0002B520L, 0x0002B520L, 0x0024C36DL, 0x0024C36DL,
+    0x001C400AL, 0x001C400AL, 0xFFCFC93EL, 0xFFCFC93EL, 0x003637F8L, 0x003637F8L, 0xFFFD1B94L, 0xFFFD1B94L,
+    0xFFC4C7ADL, 0xFFC4C7ADL, 0xFFC4C7ADL, 0xFFC4C7ADL, 0xFFF1708AL, 0xFFF1708AL, 0xFFF1708AL, 0xFFF1708AL,
+    0xFFF7E466L, 0xFFF7E466L, 0xFFF7E466L, 0xFFF7E466L, 0xFFF39C58L, 0xFFF39C58L, 0xFFF39C58L, 0xFFF39C58L,
+    0x00004BDEL, 0x00004BDEL, 0x00004BDEL, 0x00004BDEL, 0x00004BDEL, 0x00004BDEL, 0x00004BDEL, 0x00004BDEL,
+    0xFFE52FCBL, 0xFFE52FCBL, 0xFFE52FCBL, 0xFFE52FCBL, 0xFFE52FCBL, 0xFFE52FCBL, 0xFFE52FCBL, 0xFFE52FCBL,
+    0x001B73C3L, 0x00385E99L, 0xFFE6C866L, 0xFFF3A35BL, 0xFFD2028FL, 0xFFE755F8L, 0xFFFD83E4L, 0x00309342L,
+    0x00126C59L, 0xFFFD2B45L, 0xFFCC9768L, 0xFFE22268L, 0x00028371L, 0xFFDA8C49L, 0xFFDAE275L, 0x001EB9A8L,
+    0x001417F8L, 0x001417F8L, 0xFFF4675FL, 0xFFF4675FL, 0x00033821L, 0x00033821L, 0xFFDB8A94L, 0xFFDB8A94L,
+    0x00319640L, 0x00319640L, 0xFFE6C6B8L, 0xFFE6C6B8L, 0x00002182L, 0x00002182L, 0x0038D436L, 0x0038D436L,
+    0xFFC78C74L, 0xFFC78C74L, 0xFFC78C74L, 0xFFC78C74L, 0x00186BA4L, 0x00186BA4L, 0x00186BA4L, 0x00186BA4L,
+    0x0020A9E9L, 0x0020A9E9L, 0x0020A9E9L, 0x0020A9E9L, 0xFFCA7BC1L, 0xFFCA7BC1L, 0xFFCA7BC1L, 0xFFCA7BC1L,
+    0x00320368L, 0x00320368L, 0x00320368L, 0x00320368L, 0x00320368L, 0x00320368L, 0x00320368L, 0x00320368L,
+    0x00155B09L, 0x00155B09L, 0x00155B09L, 0x00155B09L, 0x00155B09L, 0x00155B09L, 0x00155B09L, 0x00155B09L,
+    0x0039A1E1L, 0xFFF6EF28L, 0x0038D3EEL, 0x00276EE5L, 0x001C2EA9L, 0x00198008L, 0x002B35F4L, 0x000846CCL,
+    0xFFCC0731L, 0xFFDDE218L, 0xFFF42419L, 0xFFE91BFBL, 0x0014FA53L, 0x0026DA88L, 0xFFE2BF67L, 0x001386ADL,
+    0xFFC398A6L, 0xFFC398A6L, 0xFFF232BCL, 0xFFF232BCL, 0x0010C942L, 0x0010C942L, 0xFFFF5300L, 0xFFFF5300L,
+    0xFFD0BA78L, 0xFFD0BA78L, 0xFFF83BE9L, 0xFFF83BE9L, 0xFFFBF510L, 0xFFFBF510L, 0x00330417L, 0x00330417L,
+    0x003A50A7L, 0x003A50A7L, 0x003A50A7L, 0x003A50A7L, 0xFFCA81E2L, 0xFFCA81E2L, 0xFFCA81E2L, 0xFFCA81E2L,
+    0x0019152AL, 0x0019152AL, 0x0019152AL, 0x0019152AL, 0x0019EDC3L, 0x0019EDC3L, 0x0019EDC3L, 0x0019EDC3L,
+    0x003AE519L, 0x003AE519L, 0x003AE519L, 0x003AE519L, 0x003AE519L, 0x003AE519L, 0x003AE519L, 0x003AE519L,
+    0x0020522AL, 0x0020522AL, 0x0020522AL, 0x0020522AL, 0x0020522AL, 0x0020522AL, 0x0020522AL, 0x0020522AL,
+    0x001DF292L, 0xFFCD8D7DL, 0xFFEBF939L, 0x0006E21CL, 0x0015D2D1L, 0x0032A1C2L, 0xFFED1EE5L, 0x00145742L,
+    0x0010095AL, 0xFFE2F4B5L, 0xFFE37AC1L, 0x002DAF77L, 0x00362470L, 0xFFD7C76FL, 0xFFECEB42L, 0x00397AE8L,
+    0x0015D39EL, 0x0015D39EL, 0xFFE3BA9DL, 0xFFE3BA9DL, 0xFFEB6A2CL, 0xFFEB6A2CL, 0x0005D423L, 0x0005D423L,
+    0x0013F609L, 0x0013F609L, 0x000059C5L, 0x000059C5L, 0x0012BEEDL, 0x0012BEEDL, 0x000A3D7EL, 0x000A3D7EL,
+    0x00083AA3L, 0x00083AA3L, 0x00083AA3L, 0x00083AA3L, 0xFFDC2964L, 0xFFDC2964L, 0xFFDC2964L, 0xFFDC2964L,
+    0x000495B3L, 0x000495B3L, 0x000495B3L, 0x000495B3L, 0xFFC9FC00L, 0xFFC9FC00L, 0xFFC9FC00L, 0xFFC9FC00L,
+    0x00202C85L, 0x00202C85L, 0x00202C85L, 0x00202C85L, 0x00202C85L, 0x00202C85L, 0x00202C85L, 0x00202C85L,
+    0xFFD80698L, 0xFFD80698L, 0xFFD80698L, 0xFFD80698L, 0xFFD80698L, 0xFFD80698L, 0xFFD80698L, 0xFFD80698L,
+    0xFFE7A5BAL, 0xFFDA0FAFL, 0xFFECF67CL, 0xFFC21EE4L, 0xFFECB28FL, 0x002785C6L, 0xFFD6EE67L, 0xFFD4A11BL,
+    0xFFFCE6DCL, 0xFFE58339L, 0x0032FFC5L, 0xFFCB8D19L, 0xFFC14FE5L, 0x002532BFL, 0xFFFB9EF4L, 0xFFFAC6E7L,
+    0x0025CBF7L, 0x0025CBF7L, 0x00064593L, 0x00064593L, 0x00385BB5L, 0x00385BB5L, 0x002D485DL, 0x002D485DL,
+    0xFFD69161L, 0xFFD69161L, 0xFFDF39C8L, 0xFFDF39C8L, 0x000F017BL, 0x000F017BL, 0xFFCBEF0EL, 0xFFCBEF0EL,
+    0x002BC1BFL, 0x002BC1BFL, 0x002BC1BFL, 0x002BC1BFL, 0xFFC9756AL, 0xFFC9756AL, 0xFFC9756AL, 0xFFC9756AL,
+    0x002E7184L, 0x002E7184L, 0x002E7184L, 0x002E7184L, 0x003AEA7BL, 0x003AEA7BL, 0x003AEA7BL, 0x003AEA7BL,
+    0x00111560L, 0x00111560L, 0x00111560L, 0x00111560L, 0x00111560L, 0x00111560L, 0x00111560L, 0x00111560L,
+    0x00086270L, 0x00086270L, 0x00086270L, 0x00086270L, 0x00086270L, 0x00086270L, 0x00086270L, 0x00086270L,
+    0x0036DE3EL, 0x000BBA6EL, 0x0008032AL, 0x00364683L, 0xFFCF107AL, 0xFFE0FF7CL, 0x002FA50AL, 0x0009FFDFL,
+    0x0007F904L, 0x0000A8FCL, 0x00189D76L, 0xFFF8707DL, 0xFFF380A6L, 0xFFF21F1AL, 0xFFE3A1E6L, 0xFFF241A2L,
+    0xFFFE1036L, 0xFFFE1036L, 0x00376F20L, 0x00376F20L, 0x00302D52L, 0x00302D52L, 0x0030AD80L, 0x0030AD80L,
+    0x000F430AL, 0x000F430AL, 0x003E4F8EL, 0x003E4F8EL, 0xFFE2688EL, 0xFFE2688EL, 0x0013308BL, 0x0013308BL,
+    0xFFC44151L, 0xFFC44151L, 0xFFC44151L, 0xFFC44151L, 0x0026B82CL, 0x0026B82CL, 0x0026B82CL, 0x0026B82CL,
+    0x0036CFD4L, 0x0036CFD4L, 0x0036CFD4L, 0x0036CFD4L, 0x00195AFDL, 0x00195AFDL, 0x00195AFDL, 0x00195AFDL,
+    0xFFC94878L, 0xFFC94878L, 0xFFC94878L, 0xFFC94878L, 0xFFC94878L, 0xFFC94878L, 0xFFC94878L, 0xFFC94878L,
+    0x00107A5CL, 0x00107A5CL, 0x00107A5CL, 0x00107A5CL, 0x00107A5CL, 0x00107A5CL, 0x00107A5CL, 0x00107A5CL,
+    0x0030BA22L, 0x001244AAL, 0x00395D04L, 0x0035B760L, 0xFFCA64A3L, 0x0012DB10L, 0xFFDADA79L, 0xFFFBED0BL,
+    0x00365BDEL, 0x00255461L, 0xFFDDC205L, 0x0033008EL, 0xFFC5BE08L, 0xFFDCA72CL, 0xFFCC00A6L, 0xFFE0156DL,
+    0x00183045L, 0x00183045L, 0xFFDECA39L, 0xFFDECA39L, 0xFFCAF612L, 0xFFCAF612L, 0x001629A3L, 0x001629A3L,
+    0x002E67E7L, 0x002E67E7L, 0x00381E31L, 0x00381E31L, 0x0017537FL, 0x0017537FL, 0x003BF91BL, 0x003BF91BL,
+    0xFFCA213BL, 0xFFCA213BL, 0xFFCA213BL, 0xFFCA213BL, 0xFFD10B33L, 0xFFD10B33L, 0xFFD10B33L, 0xFFD10B33L,
+    0xFFFE89E0L, 0xFFFE89E0L, 0xFFFE89E0L, 0xFFFE89E0L, 0xFFD6B599L, 0xFFD6B599L, 0xFFD6B599L, 0xFFD6B599L,
+    0xFFF05F90L, 0xFFF05F90L, 0xFFF05F90L, 0xFFF05F90L, 0xFFF05F90L, 0xFFF05F90L, 0xFFF05F90L, 0xFFF05F90L,
+    0xFFD669A8L, 0xFFD669A8L, 0xFFD669A8L, 0xFFD669A8L, 0xFFD669A8L, 0xFFD669A8L, 0xFFD669A8L, 0xFFD669A8L
+};
+#else
+/* the AVX2 transform zetas; for each 16 coefficient block, the length 4, 2 and 1 layer zetas */
+static const int32_t dilithium_ntt_zetas_avx2[384] =
+{
+    0x00294A67L, 0x00294A67L, 0x00294A67L, 0x00294A67L, 0x00017620L, 0x00017620L, 0x00017620L, 0x00017620L,
+    0xFFC406E5L, 0xFFC406E5L, 0xFFE8AC81L, 0xFFE8AC81L, 0xFFC7E1CFL, 0xFFC7E1CFL, 0xFFD19819L, 0xFFD19819L,
+    0x001FEA93L, 0x0033FF5AL, 0x002358D4L, 0x003A41F8L, 0xFFCCFF72L, 0x00223DFBL, 0xFFDAAB9FL, 0xFFC9A422L,
+    0x002EF4CDL, 0x002EF4CDL, 0x002EF4CDL, 0x002EF4CDL, 0x0035DEC5L, 0x0035DEC5L, 0x0035DEC5L, 0x0035DEC5L,
+    0xFFE9D65DL, 0xFFE9D65DL, 0x003509EEL, 0x003509EEL, 0x002135C7L, 0x002135C7L, 0xFFE7CFBBL, 0xFFE7CFBBL,
+    0x000412F5L, 0x00252587L, 0xFFED24F0L, 0x00359B5DL, 0xFFCA48A0L, 0xFFC6A2FCL, 0xFFEDBB56L, 0xFFCF45DEL,
+    0xFFE6A503L, 0xFFE6A503L, 0xFFE6A503L, 0xFFE6A503L, 0xFFC9302CL, 0xFFC9302CL, 0xFFC9302CL, 0xFFC9302CL,
+    0xFFECCF75L, 0xFFECCF75L, 0x001D9772L, 0x001D9772L, 0xFFC1B072L, 0xFFC1B072L, 0xFFF0BCF6L, 0xFFF0BCF6L,
+    0x000DBE5EL, 0x001C5E1AL, 0x000DE0E6L, 0x000C7F5AL, 0x00078F83L, 0xFFE7628AL, 0xFFFF5704L, 0xFFF806FCL,
+    0xFFD947D4L, 0xFFD947D4L, 0xFFD947D4L, 0xFFD947D4L, 0x003BBEAFL, 0x003BBEAFL, 0x003BBEAFL, 0x003BBEAFL,
+    0xFFCF5280L, 0xFFCF5280L, 0xFFCFD2AEL, 0xFFCFD2AEL, 0xFFC890E0L, 0xFFC890E0L, 0x0001EFCAL, 0x0001EFCAL,
+    0xFFF60021L, 0xFFD05AF6L, 0x001F0084L, 0x0030EF86L, 0xFFC9B97DL, 0xFFF7FCD6L, 0xFFF44592L, 0xFFC921C2L,
+    0xFFC51585L, 0xFFC51585L, 0xFFC51585L, 0xFFC51585L, 0xFFD18E7CL, 0xFFD18E7CL, 0xFFD18E7CL, 0xFFD18E7CL,
+    0x003410F2L, 0x003410F2L, 0xFFF0FE85L, 0xFFF0FE85L, 0x0020C638L, 0x0020C638L, 0x00296E9FL, 0x00296E9FL,
+    0x00053919L, 0x0004610CL, 0xFFDACD41L, 0x003EB01BL, 0x003472E7L, 0xFFCD003BL, 0x001A7CC7L, 0x00031924L,
+    0x00368A96L, 0x00368A96L, 0x00368A96L, 0x00368A96L, 0xFFD43E41L, 0xFFD43E41L, 0xFFD43E41L, 0xFFD43E41L,
+    0xFFD2B7A3L, 0xFFD2B7A3L, 0xFFC7A44BL, 0xFFC7A44BL, 0xFFF9BA6DL, 0xFFF9BA6DL, 0xFFDA3409L, 0xFFDA3409L,
+    0x002B5EE5L, 0x00291199L, 0xFFD87A3AL, 0x00134D71L, 0x003DE11CL, 0x00130984L, 0x0025F051L, 0x00185A46L,
+    0x00360400L, 0x00360400L, 0x00360400L, 0x00360400L, 0xFFFB6A4DL, 0xFFFB6A4DL, 0xFFFB6A4DL, 0xFFFB6A4DL,
+    0xFFF5C282L, 0xFFF5C282L, 0xFFED4113L, 0xFFED4113L, 0xFFFFA63BL, 0xFFFFA63BL, 0xFFEC09F7L, 0xFFEC09F7L,
+    0xFFC68518L, 0x001314BEL, 0x00283891L, 0xFFC9DB90L, 0xFFD25089L, 0x001C853FL, 0x001D0B4BL, 0xFFEFF6A6L,
+    0x0023D69CL, 0x0023D69CL, 0x0023D69CL, 0x0023D69CL, 0xFFF7C55DL, 0xFFF7C55DL, 0xFFF7C55DL, 0xFFF7C55DL,
+    0xFFFA2BDDL, 0xFFFA2BDDL, 0x001495D4L, 0x001495D4L, 0x001C4563L, 0x001C4563L, 0xFFEA2C62L, 0xFFEA2C62L,
+    0xFFEBA8BEL, 0x0012E11BL, 0xFFCD5E3EL, 0xFFEA2D2FL, 0xFFF91DE4L, 0x001406C7L, 0x00327283L, 0xFFE20D6EL,
+    0xFFE6123DL, 0xFFE6123DL, 0xFFE6123DL, 0xFFE6123DL, 0xFFE6EAD6L, 0xFFE6EAD6L, 0xFFE6EAD6L, 0xFFE6EAD6L,
+    0xFFCCFBE9L, 0xFFCCFBE9L, 0x00040AF0L, 0x00040AF0L, 0x0007C417L, 0x0007C417L, 0x002F4588L, 0x002F4588L,
+    0xFFEC7953L, 0x001D4099L, 0xFFD92578L, 0xFFEB05ADL, 0x0016E405L, 0x000BDBE7L, 0x00221DE8L, 0x0033F8CFL,
+    0x00357E1EL, 0x00357E1EL, 0x00357E1EL, 0x00357E1EL, 0xFFC5AF59L, 0xFFC5AF59L, 0xFFC5AF59L, 0xFFC5AF59L,
+    0x0000AD00L, 0x0000AD00L, 0xFFEF36BEL, 0xFFEF36BEL, 0x000DCD44L, 0x000DCD44L, 0x003C675AL, 0x003C675AL,
+    0xFFF7B934L, 0xFFD4CA0CL, 0xFFE67FF8L, 0xFFE3D157L, 0xFFD8911BL, 0xFFC72C12L, 0x000910D8L, 0xFFC65E1FL,
+    0x0035843FL, 0x0035843FL, 0x0035843FL, 0x0035843FL, 0xFFDF5617L, 0xFFDF5617L, 0xFFDF5617L, 0xFFDF5617L,
+    0xFFC72BCAL, 0xFFC72BCAL, 0xFFFFDE7EL, 0xFFFFDE7EL, 0x00193948L, 0x00193948L, 0xFFCE69C0L, 0xFFCE69C0L,
+    0xFFE14658L, 0x00251D8BL, 0x002573B7L, 0xFFFD7C8FL, 0x001DDD98L, 0x00336898L, 0x0002D4BBL, 0xFFED93A7L,
+    0xFFE7945CL, 0xFFE7945CL, 0xFFE7945CL, 0xFFE7945CL, 0x0038738CL, 0x0038738CL, 0x0038738CL, 0x0038738CL,
+    0x0024756CL, 0x0024756CL, 0xFFFCC7DFL, 0xFFFCC7DFL, 0x000B98A1L, 0x000B98A1L, 0xFFEBE808L, 0xFFEBE808L,
+    0xFFCF6CBEL, 0x00027C1CL, 0x0018AA08L, 0x002DFD71L, 0x000C5CA5L, 0x0019379AL, 0xFFC7A167L, 0xFFE48C3DL,
+    0x000C63A8L, 0x000C63A8L, 0x000C63A8L, 0x000C63A8L, 0x00081B9AL, 0x00081B9AL, 0x00081B9AL, 0x00081B9AL,
+    0x0002E46CL, 0x0002E46CL, 0xFFC9C808L, 0xFFC9C808L, 0x003036C2L, 0x003036C2L, 0xFFE3BFF6L, 0xFFE3BFF6L,
+    0xFFD1A13CL, 0x0035C539L, 0x003B0115L, 0x00041DC0L, 0x0021C4F7L, 0xFFF11BF4L, 0x001A35E7L, 0x0007340EL,
+    0x000E8F76L, 0x000E8F76L, 0x000E8F76L, 0x000E8F76L, 0x003B3853L, 0x003B3853L, 0x003B3853L, 0x003B3853L,
+    0xFFDB3C93L, 0xFFDB3C93L, 0xFFFD4AE0L, 0xFFFD4AE0L, 0x00141305L, 0x00141305L, 0x00147792L, 0x00147792L,
+    0xFFF97D45L, 0x001A4CD0L, 0xFFE47CAEL, 0x001D2668L, 0xFFE68E98L, 0xFFEF2633L, 0xFFFC05DAL, 0xFFC57FDBL,
+    0x003B8534L, 0x003B8534L, 0x003B8534L, 0x003B8534L, 0xFFD8FC30L, 0xFFD8FC30L, 0xFFD8FC30L, 0xFFD8FC30L,
+    0x00139E25L, 0x00139E25L, 0xFFE7D0E0L, 0xFFE7D0E0L, 0xFFF39944L, 0xFFF39944L, 0xFFEA0802L, 0xFFEA0802L,
+    0xFFD32764L, 0xFFDDE1AFL, 0xFFF993DDL, 0xFFDD1D09L, 0x0002CC93L, 0xFFF11805L, 0x00189C2AL, 0xFFC9E5A9L,
+    0x001F9D54L, 0x001F9D54L, 0x001F9D54L, 0x001F9D54L, 0xFFD54F2DL, 0xFFD54F2DL, 0xFFD54F2DL, 0xFFD54F2DL,
+    0xFFD1EEA2L, 0xFFD1EEA2L, 0xFFC4C79CL, 0xFFC4C79CL, 0xFFC8A057L, 0xFFC8A057L, 0x003A97D9L, 0x003A97D9L,
+    0xFFF78A50L, 0x003BCF2CL, 0xFFFF434EL, 0xFFEB36DFL, 0x003C15CAL, 0x00155E68L, 0xFFF316B6L, 0x001E29CEL
+};
+
+/* the negated AVX2 inverse transform zetas; for each block, the length 1, 2 and 4 layer zetas */
+static const int32_t dilithium_invntt_zetas_avx2[384] =
+{
+    0xFFE1D632L, 0x000CE94AL, 0xFFEAA198L, 0xFFC3EA36L, 0x0014C921L, 0x0000BCB2L, 0xFFC430D4L, 0x000875B0L,
+    0xFFC56827L, 0xFFC56827L, 0x00375FA9L, 0x00375FA9L, 0x003B3864L, 0x003B3864L, 0x002E115EL, 0x002E115EL,
+    0x002AB0D3L, 0x002AB0D3L, 0x002AB0D3L, 0x002AB0D3L, 0xFFE062ACL, 0xFFE062ACL, 0xFFE062ACL, 0xFFE062ACL,
+    0x00361A57L, 0xFFE763D6L, 0x000EE7FBL, 0xFFFD336DL, 0x0022E2F7L, 0x00066C23L, 0x00221E51L, 0x002CD89CL,
+    0x0015F7FEL, 0x0015F7FEL, 0x000C66BCL, 0x000C66BCL, 0x00182F20L, 0x00182F20L, 0xFFEC61DBL, 0xFFEC61DBL,
+    0x002703D0L, 0x002703D0L, 0x002703D0L, 0x002703D0L, 0xFFC47ACCL, 0xFFC47ACCL, 0xFFC47ACCL, 0xFFC47ACCL,
+    0x003A8025L, 0x0003FA26L, 0x0010D9CDL, 0x00197168L, 0xFFE2D998L, 0x001B8352L, 0xFFE5B330L, 0x000682BBL,
+    0xFFEB886EL, 0xFFEB886EL, 0xFFEBECFBL, 0xFFEBECFBL, 0x0002B520L, 0x0002B520L, 0x0024C36DL, 0x0024C36DL,
+    0xFFC4C7ADL, 0xFFC4C7ADL, 0xFFC4C7ADL, 0xFFC4C7ADL, 0xFFF1708AL, 0xFFF1708AL, 0xFFF1708AL, 0xFFF1708AL,
+    0xFFF8CBF2L, 0xFFE5CA19L, 0x000EE40CL, 0xFFDE3B09L, 0xFFFBE240L, 0xFFC4FEEBL, 0xFFCA3AC7L, 0x002E5EC4L,
+    0x001C400AL, 0x001C400AL, 0xFFCFC93EL, 0xFFCFC93EL, 0x003637F8L, 0x003637F8L, 0xFFFD1B94L, 0xFFFD1B94L,
+    0xFFF7E466L, 0xFFF7E466L, 0xFFF7E466L, 0xFFF7E466L, 0xFFF39C58L, 0xFFF39C58L, 0xFFF39C58L, 0xFFF39C58L,
+    0x001B73C3L, 0x00385E99L, 0xFFE6C866L, 0xFFF3A35BL, 0xFFD2028FL, 0xFFE755F8L, 0xFFFD83E4L, 0x00309342L,
+    0x001417F8L, 0x001417F8L, 0xFFF4675FL, 0xFFF4675FL, 0x00033821L, 0x00033821L, 0xFFDB8A94L, 0xFFDB8A94L,
+    0xFFC78C74L, 0xFFC78C74L, 0xFFC78C74L, 0xFFC78C74L, 0x00186BA4L, 0x00186BA4L, 0x00186BA4L, 0x00186BA4L,
+    0x00126C59L, 0xFFFD2B45L, 0xFFCC9768L, 0xFFE22268L, 0x00028371L, 0xFFDA8C49L, 0xFFDAE275L, 0x001EB9A8L,
+    0x00319640L, 0x00319640L, 0xFFE6C6B8L, 0xFFE6C6B8L, 0x00002182L, 0x00002182L, 0x0038D436L, 0x0038D436L,
+    0x0020A9E9L, 0x0020A9E9L, 0x0020A9E9L, 0x0020A9E9L, 0xFFCA7BC1L, 0xFFCA7BC1L, 0xFFCA7BC1L, 0xFFCA7BC1L,
+    0x0039A1E1L, 0xFFF6EF28L, 0x0038D3EEL, 0x00276EE5L, 0x001C2EA9L, 0x00198008L, 0x002B35F4L, 0x000846CCL,
+    0xFFC398A6L, 0xFFC398A6L, 0xFFF232BCL, 0xFFF232BCL, 0x0010C942L, 0x0010C942L, 0xFFFF5300L, 0xFFFF5300L,
+    0x003A50A7L, 0x003A50A7L, 0x003A50A7L, 0x003A50A7L, 0xFFCA81E2L, 0xFFCA81E2L, 0xFFCA81E2L, 0xFFCA81E2L,
+    0xFFCC0731L, 0xFFDDE218L, 0xFFF42419L, 0xFFE91BFBL, 0x0014FA53L, 0x0026DA88L, 0xFFE2BF67L, 0x001386ADL,
+    0xFFD0BA78L, 0xFFD0BA78L, 0xFFF83BE9L, 0xFFF83BE9L, 0xFFFBF510L, 0xFFFBF510L, 0x00330417L, 0x00330417L,
+    0x0019152AL, 0x0019152AL, 0x0019152AL, 0x0019152AL, 0x0019EDC3L, 0x0019EDC3L, 0x0019EDC3L, 0x0019EDC3L,
+    0x001DF292L, 0xFFCD8D7DL, 0xFFEBF939L, 0x0006E21CL, 0x0015D2D1L, 0x0032A1C2L, 0xFFED1EE5L, 0x00145742L,
+    0x0015D39EL, 0x0015D39EL, 0xFFE3BA9DL, 0xFFE3BA9DL, 0xFFEB6A2CL, 0xFFEB6A2CL, 0x0005D423L, 0x0005D423L,
+    0x00083AA3L, 0x00083AA3L, 0x00083AA3L, 0x00083AA3L, 0xFFDC2964L, 0xFFDC2964L, 0xFFDC2964L, 0xFFDC2964L,
+    0x0010095AL, 0xFFE2F4B5L, 0xFFE37AC1L, 0x002DAF77L, 0x00362470L, 0xFFD7C76FL, 0xFFECEB42L, 0x00397AE8L,
+    0x0013F609L, 0x0013F609L, 0x000059C5L, 0x000059C5L, 0x0012BEEDL, 0x0012BEEDL, 0x000A3D7EL, 0x000A3D7EL,
+    0x000495B3L, 0x000495B3L, 0x000495B3L, 0x000495B3L, 0xFFC9FC00L, 0xFFC9FC00L, 0xFFC9FC00L, 0xFFC9FC00L,
+    0xFFE7A5BAL, 0xFFDA0FAFL, 0xFFECF67CL, 0xFFC21EE4L, 0xFFECB28FL, 0x002785C6L, 0xFFD6EE67L, 0xFFD4A11BL,
+    0x0025CBF7L, 0x0025CBF7L, 0x00064593L, 0x00064593L, 0x00385BB5L, 0x00385BB5L, 0x002D485DL, 0x002D485DL,
+    0x002BC1BFL, 0x002BC1BFL, 0x002BC1BFL, 0x002BC1BFL, 0xFFC9756AL, 0xFFC9756AL, 0xFFC9756AL, 0xFFC9756AL,
+    0xFFFCE6DCL, 0xFFE58339L, 0x0032FFC5L, 0xFFCB8D19L, 0xFFC14FE5L, 0x002532BFL, 0xFFFB9EF4L, 0xFFFAC6E7L,
+    0xFFD69161L, 0xFFD69161L, 0xFFDF39C8L, 0xFFDF39C8L, 0x000F017BL, 0x000F017BL, 0xFFCBEF0EL, 0xFFCBEF0EL,
+    0x002E7184L, 0x002E7184L, 0x002E7184L, 0x002E7184L, 0x003AEA7BL, 0x003AEA7BL, 0x003AEA7BL, 0x003AEA7BL,
+    0x0036DE3EL, 0x000BBA6EL, 0x0008032AL, 0x00364683L, 0xFFCF107AL, 0xFFE0FF7CL, 0x002FA50AL, 0x0009FFDFL,
+    0xFFFE1036L, 0xFFFE1036L, 0x00376F20L, 0x00376F20L, 0x00302D52L, 0x00302D52L, 0x0030AD80L, 0x0030AD80L,
+    0xFFC44151L, 0xFFC44151L, 0xFFC44151L, 0xFFC44151L, 0x0026B82CL, 0x0026B82CL, 0x0026B82CL, 0x0026B82CL,
+    0x0007F904L, 0x0000A8FCL, 0x00189D76L, 0xFFF8707DL, 0xFFF380A6L, 0xFFF21F1AL, 0xFFE3A1E6L, 0xFFF241A2L,
+    0x000F430AL, 0x000F430AL, 0x003E4F8EL, 0x003E4F8EL, 0xFFE2688EL, 0xFFE2688EL, 0x0013308BL, 0x0013308BL,
+    0x0036CFD4L, 0x0036CFD4L, 0x0036CFD4L, 0x0036CFD4L, 0x00195AFDL, 0x00195AFDL, 0x00195AFDL, 0x00195AFDL,
+    0x0030BA22L, 0x001244AAL, 0x00395D04L, 0x0035B760L, 0xFFCA64A3L, 0x0012DB10L, 0xFFDADA79L, 0xFFFBED0BL,
+    0x00183045L, 0x00183045L, 0xFFDECA39L, 0xFFDECA39L, 0xFFCAF612L, 0xFFCAF612L, 0x001629A3L, 0x001629A3L,
+    0xFFCA213BL, 0xFFCA213BL, 0xFFCA213BL, 0xFFCA213BL, 0xFFD10B33L, 0xFFD10B33L, 0xFFD10B33L, 0xFFD10B33L,
+    0x00365BDEL, 0x00255461L, 0xFFDDC205L, 0x0033008EL, 0xFFC5BE08L, 0xFFDCA72CL, 0xFFCC00A6L, 0xFFE0156DL,
+    0x002E67E7L, 0x002E67E7L, 0x00381E31L, 0x00381E31L, 0x0017537FL, 0x0017537FL, 0x003BF91BL, 0x003BF91BL,
+    0xFFFE89E0L, 0xFFFE89E0L, 0xFFFE89E0L, 0xFFFE89E0L, 0xFFD6B599L, 0xFFD6B599L, 0xFFD6B599L, 0xFFD6B599L
+};
+#endif
+
 static dilithium_q_avx2[8] = { DILITHIUM_Q, DILITHIUM_Q, DILITHIUM_Q, DILITHIUM_Q,
     DILITHIUM_Q, DILITHIUM_Q, DILITHIUM_Q, DILITHIUM_Q };
 static dilithium_qinv_avx2[8] = { DILITHIUM_QINV, DILITHIUM_QINV, DILITHIUM_QINV, DILITHIUM_QINV,
@@ -252,7 +497,8 @@ static dilithium_qinv_avx2[8] = { DILITHIUM_QINV, DILITHIUM_QINV, DILITHIUM_QINV
 
 /* rounding.c */
 
-static void dilithium_avx2_power2round(int32_t* restrict a1, int32_t* restrict a0, const int32_t* restrict a)
+/* the polynomial wrappers are called in place, a1 may alias a, so only a0 is restrict qualified */
+static void dilithium_avx2_power2round(int32_t* a1, int32_t* restrict a0, const int32_t* a)
 {
     __m256i f;
     __m256i f0;
@@ -273,7 +519,8 @@ static void dilithium_avx2_power2round(int32_t* restrict a1, int32_t* restrict a
 }
 
 #if DILITHIUM_GAMMA2 == (DILITHIUM_Q - 1) / 32
-static void dilithium_avx2_decompose_avx2(int32_t* restrict a1, int32_t* restrict a0, const int32_t* restrict a)
+/* a1 may alias a, see dilithium_avx2_power2round */
+static void dilithium_avx2_decompose_avx2(int32_t* a1, int32_t* restrict a0, const int32_t* a)
 {
     const __m256i q = _mm256_load_si256((__m256i*)&dilithium_q_avx2[0]);
     const __m256i hq = _mm256_srli_epi32(q, 1);
@@ -304,7 +551,8 @@ static void dilithium_avx2_decompose_avx2(int32_t* restrict a1, int32_t* restric
     }
 }
 #elif DILITHIUM_GAMMA2 == (DILITHIUM_Q - 1) / 88
-static void dilithium_avx2_decompose_avx2(int32_t* restrict a1, int32_t* restrict a0, const int32_t* restrict a)
+/* a1 may alias a, see dilithium_avx2_power2round */
+static void dilithium_avx2_decompose_avx2(int32_t* a1, int32_t* restrict a0, const int32_t* a)
 {
     const __m256i q = _mm256_load_si256((__m256i*)&dilithium_q_avx2[0]);
     const __m256i hq = _mm256_srli_epi32(q, 1);
@@ -374,7 +622,8 @@ static uint32_t dilithium_avx2_make_hint(int32_t* restrict h, const int32_t* res
     return DILITHIUM_N - r;
 }
 
-static void dilithium_avx2_use_hint(int32_t* restrict b, const int32_t* restrict a, const int32_t* restrict hint)
+/* b may alias a, the verifier recovers w1 in place */
+static void dilithium_avx2_use_hint(int32_t* b, const int32_t* a, const int32_t* restrict hint)
 {
     QSC_ALIGN(32) int32_t a0[DILITHIUM_N];
     __m256i f;
@@ -546,9 +795,62 @@ static uint32_t dilithium_avx2_rej_uniform(int32_t* restrict r, const uint8_t* r
     return ctr;
 }
 
-/* dilithium_poly.c */
+#if defined(QSC_SYSTEM_HAS_AVX512)
+static uint32_t dilithium_avx512_rej_uniform(int32_t* restrict r, const uint8_t* restrict buf)
+{
+    /* every 48 bytes expand to sixteen 23-bit candidates; the accepted lanes are compressed
+       to the front of the vector and stored, the counter advances by the number accepted */
+    const __m512i bound = _mm512_set1_epi32(DILITHIUM_Q);
+    const __m512i mask = _mm512_set1_epi32(0x7FFFFF);
+    const __m512i idx32 = _mm512_set_epi32(11, 11, 10, 9, 8, 8, 7, 6, 5, 5, 4, 3, 2, 2, 1, 0);
+    const __m512i idx8 = _mm512_broadcast_i32x4(_mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1));
+    __m512i d;
+    __mmask16 good;
+    size_t pos;
+    uint32_t ctr;
+    uint32_t t;
+
+    ctr = 0;
+    pos = 0;
+
+    while (ctr <= DILITHIUM_N - 16 && pos <= DILITHIUM_REJ_UNIFORM_BUFLEN - 48)
+    {
+        d = _mm512_loadu_si512((const __m512i*)&buf[pos]);
+        d = _mm512_permutexvar_epi32(idx32, d);
+        d = _mm512_shuffle_epi8(d, idx8);
+        d = _mm512_and_si512(d, mask);
+        pos += 48;
+
+        good = _mm512_cmplt_epi32_mask(d, bound);
+        d = _mm512_maskz_compress_epi32(good, d);
+        _mm512_storeu_si512((__m512i*)&r[ctr], d);
+        ctr += (uint32_t)_mm_popcnt_u32(good);
+    }
+
+    while (ctr < DILITHIUM_N && pos <= DILITHIUM_REJ_UNIFORM_BUFLEN - 3)
+    {
+        t = buf[pos];
+        ++pos;
+        t |= (uint32_t)buf[pos] << 8;
+        ++pos;
+        t |= (uint32_t)buf[pos] << 16;
+        ++pos;
+        t &= 0x7FFFFF;
+
+        if (t < DILITHIUM_Q)
+        {
+            r[ctr] = t;
+            ++ctr;
+        }
+    }
+
+    return ctr;
+}
+#endif
+
+/* qsc_dilithium_poly.c */
 
-static void dilithium_avx2_poly_reduce(dilithium_poly* a)
+static void dilithium_avx2_poly_reduce(qsc_dilithium_poly* a)
 {
     const __m256i q = _mm256_load_si256((__m256i*)&dilithium_q_avx2[0]);
     const __m256i off = _mm256_set1_epi32(1 << 22);
@@ -566,7 +868,7 @@ static void dilithium_avx2_poly_reduce(dilithium_poly* a)
     }
 }
 
-static void dilithium_avx2_poly_caddq(dilithium_poly* a)
+static void dilithium_avx2_poly_caddq(qsc_dilithium_poly* a)
 {
     const __m256i q = _mm256_load_si256((__m256i*)&dilithium_q_avx2[0]);
     const __m256i zero = _mm256_setzero_si256();
@@ -582,7 +884,7 @@ static void dilithium_avx2_poly_caddq(dilithium_poly* a)
     }
 }
 
-static void dilithium_avx2_poly_add(dilithium_poly* c, const dilithium_poly* a, const dilithium_poly* b)
+static void dilithium_avx2_poly_add(qsc_dilithium_poly* c, const qsc_dilithium_poly* a, const qsc_dilithium_poly* b)
 {
     __m256i vec0;
     __m256i vec1;
@@ -596,7 +898,7 @@ static void dilithium_avx2_poly_add(dilithium_poly* c, const dilithium_poly* a,
     }
 }
 
-static void dilithium_avx2_poly_sub(dilithium_poly* c, const dilithium_poly* a, const dilithium_poly* b)
+static void dilithium_avx2_poly_sub(qsc_dilithium_poly* c, const qsc_dilithium_poly* a, const qsc_dilithium_poly* b)
 {
     __m256i vec0;
     __m256i vec1;
@@ -610,7 +912,7 @@ static void dilithium_avx2_poly_sub(dilithium_poly* c, const dilithium_poly* a,
     }
 }
 
-static void dilithium_avx2_poly_shiftl(dilithium_poly* a)
+static void dilithium_avx2_poly_shiftl(qsc_dilithium_poly* a)
 {
     __m256i vec;
 
@@ -622,17 +924,17 @@ static void dilithium_avx2_poly_shiftl(dilithium_poly* a)
     }
 }
 
-static void dilithium_avx2_poly_power2round(dilithium_poly* a1, dilithium_poly* a0, const dilithium_poly* a)
+static void dilithium_avx2_poly_power2round(qsc_dilithium_poly* a1, qsc_dilithium_poly* a0, const qsc_dilithium_poly* a)
 {
     dilithium_avx2_power2round(a1->coeffs, a0->coeffs, a->coeffs);
 }
 
-static void dilithium_avx2_poly_decompose(dilithium_poly* a1, dilithium_poly* a0, const dilithium_poly* a)
+static void dilithium_avx2_poly_decompose(qsc_dilithium_poly* a1, qsc_dilithium_poly* a0, const qsc_dilithium_poly* a)
 {
     dilithium_avx2_decompose_avx2(a1->coeffs, a0->coeffs, a->coeffs);
 }
 
-static uint32_t dilithium_avx2_poly_make_hint(dilithium_poly* h, const dilithium_poly* a0, const dilithium_poly* a1)
+static uint32_t dilithium_avx2_poly_make_hint(qsc_dilithium_poly* h, const qsc_dilithium_poly* a0, const qsc_dilithium_poly* a1)
 {
     uint32_t r;
 
@@ -641,12 +943,12 @@ static uint32_t dilithium_avx2_poly_make_hint(dilithium_poly* h, const dilithium
     return r;
 }
 
-static void dilithium_avx2_poly_use_hint(dilithium_poly* b, const dilithium_poly* a, const dilithium_poly* h)
+static void dilithium_avx2_poly_use_hint(qsc_dilithium_poly* b, const qsc_dilithium_poly* a, const qsc_dilithium_poly* h)
 {
     dilithium_avx2_use_hint(b->coeffs, a->coeffs, h->coeffs);
 }
 
-static int32_t dilithium_avx2_poly_chknorm(const dilithium_poly* a, int32_t B)
+static int32_t dilithium_avx2_poly_chknorm(const qsc_dilithium_poly* a, int32_t B)
 {
     const __m256i bound = _mm256_set1_epi32(B - 1);
     __m256i f;
@@ -675,7 +977,7 @@ static int32_t dilithium_avx2_poly_chknorm(const dilithium_poly* a, int32_t B)
     return r;
 }
 
-static void dilithium_avx2_poly_uniform_4x(dilithium_poly* a0, dilithium_poly* a1, dilithium_poly* a2, dilithium_poly* a3,
+static void dilithium_avx2_poly_uniform_4x(qsc_dilithium_poly* a0, qsc_dilithium_poly* a1, qsc_dilithium_poly* a2, qsc_dilithium_poly* a3,
     const uint8_t seed[32], uint16_t nonce0, uint16_t nonce1, uint16_t nonce2, uint16_t nonce3)
 {
     __m256i ksi[QSC_KECCAK_STATE_SIZE] = { 0 };
@@ -720,7 +1022,50 @@ static void dilithium_avx2_poly_uniform_4x(dilithium_poly* a0, dilithium_poly* a
     }
 }
 
-static void dilithium_avx2_poly_uniform_eta_4x(dilithium_poly* a0, dilithium_poly* a1, dilithium_poly* a2, dilithium_poly* a3,
+#if defined(QSC_SYSTEM_HAS_AVX512)
+static void dilithium_avx512_poly_uniform_8x(qsc_dilithium_poly* a[8], const uint8_t seed[32], const uint16_t nonce[8])
+{
+    __m512i ksa[QSC_KECCAK_STATE_SIZE] = { 0 };
+    QSC_ALIGN(64) uint8_t buf[8][896];
+    uint32_t ctr[8];
+    size_t i;
+    bool done;
+
+    for (i = 0; i < 8; ++i)
+    {
+        qsc_memutils_copy(buf[i], seed, DILITHIUM_SEEDBYTES);
+        buf[i][DILITHIUM_SEEDBYTES] = (uint8_t)nonce[i];
+        buf[i][DILITHIUM_SEEDBYTES + 1] = (uint8_t)(nonce[i] >> 8);
+    }
+
+    qsc_keccakx8_absorb(ksa, qsc_keccak_rate_128, buf[0], buf[1], buf[2], buf[3], buf[4], buf[5], buf[6], buf[7],
+        DILITHIUM_SEEDBYTES + 2, QSC_KECCAK_SHAKE_DOMAIN_ID);
+    qsc_keccakx8_squeezeblocks(ksa, qsc_keccak_rate_128, buf[0], buf[1], buf[2], buf[3], buf[4], buf[5], buf[6], buf[7],
+        DILITHIUM_REJ_UNIFORM_BUFLEN / QSC_KECCAK_128_RATE);
+
+    done = true;
+
+    for (i = 0; i < 8; ++i)
+    {
+        ctr[i] = dilithium_avx512_rej_uniform(a[i]->coeffs, buf[i]);
+        done &= (ctr[i] == DILITHIUM_N);
+    }
+
+    while (done == false)
+    {
+        qsc_keccakx8_squeezeblocks(ksa, qsc_keccak_rate_128, buf[0], buf[1], buf[2], buf[3], buf[4], buf[5], buf[6], buf[7], 1);
+        done = true;
+
+        for (i = 0; i < 8; ++i)
+        {
+            ctr[i] += dilithium_rej_uniform(a[i]->coeffs + ctr[i], DILITHIUM_N - ctr[i], buf[i], QSC_KECCAK_128_RATE);
+            done &= (ctr[i] == DILITHIUM_N);
+        }
+    }
+}
+#endif
+
+static void dilithium_avx2_poly_uniform_eta_4x(qsc_dilithium_poly* a0, qsc_dilithium_poly* a1, qsc_dilithium_poly* a2, qsc_dilithium_poly* a3,
     const uint8_t seed[32], uint16_t nonce0, uint16_t nonce1, uint16_t nonce2, uint16_t nonce3)
 {
 #if DILITHIUM_ETA == 2
@@ -769,7 +1114,7 @@ static void dilithium_avx2_poly_uniform_eta_4x(dilithium_poly* a0, dilithium_pol
     }
 }
 
-static void dilithium_polyz_unpack(dilithium_poly* r, const uint8_t* a)
+static void dilithium_polyz_unpack(qsc_dilithium_poly* r, const uint8_t* a)
 {
 #if (DILITHIUM_GAMMA1 == (1 << 17))
     for (size_t i = 0; i < DILITHIUM_N / 4; ++i)
@@ -818,7 +1163,7 @@ static void dilithium_polyz_unpack(dilithium_poly* r, const uint8_t* a)
 #endif
 }
 
-static void dilithium_avx2_poly_uniform_gamma1_4x(dilithium_poly* a0, dilithium_poly* a1, dilithium_poly* a2, dilithium_poly* a3,
+static void dilithium_avx2_poly_uniform_gamma1_4x(qsc_dilithium_poly* a0, qsc_dilithium_poly* a1, qsc_dilithium_poly* a2, qsc_dilithium_poly* a3,
     const uint8_t seed[48], uint16_t nonce0, uint16_t nonce1, uint16_t nonce2, uint16_t nonce3)
 {
     QSC_ALIGN(32) uint8_t buf[4][704];
@@ -856,7 +1201,7 @@ static void dilithium_avx2_poly_uniform_gamma1_4x(dilithium_poly* a0, dilithium_
 }
 
 #if DILITHIUM_GAMMA2 == (DILITHIUM_Q - 1) / 88
-static void dilithium_avx2_polyw1_pack(uint8_t* r, const dilithium_poly* a)
+static void dilithium_avx2_polyw1_pack(uint8_t* r, const qsc_dilithium_poly* a)
 {
 #if DILITHIUM_GAMMA2 == (DILITHIUM_Q - 1) / 88
     for (size_t i = 0; i < DILITHIUM_N / 4; ++i)
@@ -877,7 +1222,7 @@ static void dilithium_avx2_polyw1_pack(uint8_t* r, const dilithium_poly* a)
 }
 
 #elif DILITHIUM_GAMMA2 == (DILITHIUM_Q - 1) / 32
-static void dilithium_avx2_polyw1_pack(uint8_t* restrict r, const dilithium_poly* restrict a)
+static void dilithium_avx2_polyw1_pack(uint8_t* restrict r, const qsc_dilithium_poly* restrict a)
 {
     const __m256i mask = _mm256_set1_epi64x(0xFF00FF00FF00FF00);
     const __m256i idx = _mm256_set_epi8(15, 13, 14, 12, 11, 9, 10, 8,
@@ -942,14 +1287,22 @@ static void dilithium_avx2_polyw1_pack(uint8_t* restrict r, const dilithium_poly
 
 /* reduce.c */
 
-static int32_t dilithium_montgomery_reduce(int64_t a)
+static __m256i dilithium_fqmul_avx2(__m256i a, __m256i b, __m256i bqinv)
 {
-    int32_t t;
-
-    t = (int32_t)a * DILITHIUM_QINV;
-    t = (a - (int64_t)t * DILITHIUM_Q) >> 32;
-
-    return t;
+    /* the signed montgomery product of 8 lanes; the even and odd lanes are reduced
+       in 64-bit halves and the high words merged back into one vector */
+    const __m256i q = _mm256_set1_epi32(DILITHIUM_Q);
+    __m256i ao;
+    __m256i bo;
+    __m256i re;
+    __m256i ro;
+
+    ao = _mm256_srli_epi64(a, 32);
+    bo = _mm256_srli_epi64(b, 32);
+    re = _mm256_sub_epi64(_mm256_mul_epi32(a, b), _mm256_mul_epi32(_mm256_mul_epi32(a, bqinv), q));
+    ro = _mm256_sub_epi64(_mm256_mul_epi32(ao, bo), _mm256_mul_epi32(_mm256_mul_epi32(ao, _mm256_srli_epi64(bqinv, 32)), q));
+
+    return _mm256_blend_epi32(_mm256_srli_epi64(re, 32), ro, 0xAA);
 }
 
 /* rounding.c */
@@ -975,160 +1328,488 @@ static int32_t dilithium_decompose(int32_t* a0, int32_t a)
 
 /* ntt.c */
 
-static void dilithium_ntt(int32_t a[DILITHIUM_N])
+#if defined(QSC_SYSTEM_HAS_AVX512)
+static __m512i dilithium_fqmul_avx512(__m512i a, __m512i b, __m512i bqinv)
+{
+    /* the 16 lane form of dilithium_fqmul_avx2 */
+    const __m512i q = _mm512_set1_epi32(DILITHIUM_Q);
+    __m512i ao;
+    __m512i bo;
+    __m512i re;
+    __m512i ro;
+
+    ao = _mm512_srli_epi64(a, 32);
+    bo = _mm512_srli_epi64(b, 32);
+    re = _mm512_sub_epi64(_mm512_mul_epi32(a, b), _mm512_mul_epi32(_mm512_mul_epi32(a, bqinv), q));
+    ro = _mm512_sub_epi64(_mm512_mul_epi32(ao, bo), _mm512_mul_epi32(_mm512_mul_epi32(ao, _mm512_srli_epi64(bqinv, 32)), q));
+
+    return _mm512_mask_blend_epi32(0xAAAA, _mm512_srli_epi64(re, 32), ro);
+}
+
+static void dilithium_butterfly_avx512(__m512i* a, __m512i* b, __m512i zeta, __m512i zqinv)
+{
+    __m512i t;
+
+    t = dilithium_fqmul_avx512(*b, zeta, zqinv);
+    *b = _mm512_sub_epi32(*a, t);
+    *a = _mm512_add_epi32(*a, t);
+}
+
+static void dilithium_invbutterfly_avx512(__m512i* a, __m512i* b, __m512i zeta, __m512i zqinv)
+{
+    __m512i t;
+
+    t = *a;
+    *a = _mm512_add_epi32(t, *b);
+    *b = dilithium_fqmul_avx512(_mm512_sub_epi32(t, *b), zeta, zqinv);
+}
+
+/* the 512-bit shuffles pair the coefficients of the length 8, 4, 2 and 1 layers
+   of two 16 coefficient blocks at once; each is its own inverse */
+
+static void dilithium_shuffle8_avx512(__m512i* a, __m512i* b)
+{
+    __m512i t;
+
+    t = _mm512_shuffle_i64x2(*a, *b, 0x44);
+    *b = _mm512_shuffle_i64x2(*a, *b, 0xEE);
+    *a = t;
+}
+
+static void dilithium_shuffle4_avx512(__m512i* a, __m512i* b)
+{
+    const __m512i IDXL = _mm512_set_epi64(13, 12, 5, 4, 9, 8, 1, 0);
+    const __m512i IDXH = _mm512_set_epi64(15, 14, 7, 6, 11, 10, 3, 2);
+    __m512i t;
+
+    t = _mm512_permutex2var_epi64(*a, IDXL, *b);
+    *b = _mm512_permutex2var_epi64(*a, IDXH, *b);
+    *a = t;
+}
+
+static void dilithium_shuffle2_avx512(__m512i* a, __m512i* b)
+{
+    __m512i t;
+
+    t = _mm512_unpacklo_epi64(*a, *b);
+    *b = _mm512_unpackhi_epi64(*a, *b);
+    *a = t;
+}
+
+static void dilithium_shuffle1_avx512(__m512i* a, __m512i* b)
+{
+    __m512i t;
+
+    t = _mm512_mask_blend_epi32(0xAAAA, *a, _mm512_slli_epi64(*b, 32));
+    *b = _mm512_mask_blend_epi32(0xAAAA, _mm512_srli_epi64(*a, 32), *b);
+    *a = t;
+}
+
+static void dilithium_ntt_avx512(int32_t a[DILITHIUM_N])
 {
+    const __m512i QINV = _mm512_set1_epi32(DILITHIUM_QINV);
+    __m512i v[16];
+    __m512i z;
+    size_t i;
     size_t j;
-    size_t k;
-    int32_t zeta;
-    int32_t t;
 
-    k = 0;
+    for (j = 0; j < 16; ++j)
+    {
+        v[j] = _mm512_loadu_si512((const __m512i*)&a[16 * j]);
+    }
 
-    for (size_t len = 128; len > 0; len >>= 1)
+    /* layers 128, 64, 32 and 16 between the vectors */
+    z = _mm512_set1_epi32(dilithium_zetas[1]);
+
+    for (j = 0; j < 8; ++j)
     {
-        for (size_t start = 0; start < DILITHIUM_N; start = j + len)
-        {
-            ++k;
-            zeta = dilithium_zetas[k];
+        dilithium_butterfly_avx512(&v[j], &v[j + 8], z, _mm512_mullo_epi32(z, QINV));
+    }
 
-            for (j = start; j < start + len; ++j)
-            {
-                t = dilithium_montgomery_reduce((int64_t)zeta * a[j + len]);
-                a[j + len] = a[j] - t;
-                a[j] = a[j] + t;
-            }
+    for (i = 0; i < 16; i += 8)
+    {
+        z = _mm512_set1_epi32(dilithium_zetas[2 + (i / 8)]);
+
+        for (j = i; j < i + 4; ++j)
+        {
+            dilithium_butterfly_avx512(&v[j], &v[j + 4], z, _mm512_mullo_epi32(z, QINV));
         }
     }
+
+    for (i = 0; i < 16; i += 4)
+    {
+        z = _mm512_set1_epi32(dilithium_zetas[4 + (i / 4)]);
+        dilithium_butterfly_avx512(&v[i], &v[i + 2], z, _mm512_mullo_epi32(z, QINV));
+        dilithium_butterfly_avx512(&v[i + 1], &v[i + 3], z, _mm512_mullo_epi32(z, QINV));
+    }
+
+    for (i = 0; i < 16; i += 2)
+    {
+        z = _mm512_set1_epi32(dilithium_zetas[8 + (i / 2)]);
+        dilithium_butterfly_avx512(&v[i], &v[i + 1], z, _mm512_mullo_epi32(z, QINV));
+    }
+
+    /* layers 8, 4, 2 and 1 on each pair of vectors */
+    for (i = 0; i < 8; ++i)
+    {
+        dilithium_shuffle8_avx512(&v[2 * i], &v[(2 * i) + 1]);
+        z = _mm512_loadu_si512((const __m512i*)&dilithium_ntt_zetas_avx512[64 * i]);
+        dilithium_butterfly_avx512(&v[2 * i], &v[(2 * i) + 1], z, _mm512_mullo_epi32(z, QINV));
+
+        dilithium_shuffle4_avx512(&v[2 * i], &v[(2 * i) + 1]);
+        z = _mm512_loadu_si512((const __m512i*)&dilithium_ntt_zetas_avx512[(64 * i) + 16]);
+        dilithium_butterfly_avx512(&v[2 * i], &v[(2 * i) + 1], z, _mm512_mullo_epi32(z, QINV));
+
+        dilithium_shuffle2_avx512(&v[2 * i], &v[(2 * i) + 1]);
+        z = _mm512_loadu_si512((const __m512i*)&dilithium_ntt_zetas_avx512[(64 * i) + 32]);
+        dilithium_butterfly_avx512(&v[2 * i], &v[(2 * i) + 1], z, _mm512_mullo_epi32(z, QINV));
+
+        dilithium_shuffle1_avx512(&v[2 * i], &v[(2 * i) + 1]);
+        z = _mm512_loadu_si512((const __m512i*)&dilithium_ntt_zetas_avx512[(64 * i) + 48]);
+        dilithium_butterfly_avx512(&v[2 * i], &v[(2 * i) + 1], z, _mm512_mullo_epi32(z, QINV));
+
+        dilithium_shuffle1_avx512(&v[2 * i], &v[(2 * i) + 1]);
+        dilithium_shuffle2_avx512(&v[2 * i], &v[(2 * i) + 1]);
+        dilithium_shuffle4_avx512(&v[2 * i], &v[(2 * i) + 1]);
+        dilithium_shuffle8_avx512(&v[2 * i], &v[(2 * i) + 1]);
+    }
+
+    for (j = 0; j < 16; ++j)
+    {
+        _mm512_storeu_si512((__m512i*)&a[16 * j], v[j]);
+    }
 }
 
-static void dilithium_invntt_to_mont(int32_t a[DILITHIUM_N])
+static void dilithium_invntt_avx512(int32_t a[DILITHIUM_N])
 {
+    const __m512i QINV = _mm512_set1_epi32(DILITHIUM_QINV);
+    const __m512i F = _mm512_set1_epi32(41978); /* mont ^ 2 / 256 */
+    __m512i v[16];
+    __m512i z;
+    size_t i;
     size_t j;
-    size_t k;
-    int32_t t;
-    int32_t zeta;
-    const int32_t F = 41978; /* mont ^ 2 / 256 */
 
-    k = 256;
+    for (j = 0; j < 16; ++j)
+    {
+        v[j] = _mm512_loadu_si512((const __m512i*)&a[16 * j]);
+    }
 
-    for (size_t len = 1; len < DILITHIUM_N; len <<= 1)
+    /* layers 1, 2, 4 and 8 on each pair of vectors */
+    for (i = 0; i < 8; ++i)
     {
-        for (size_t start = 0; start < DILITHIUM_N; start = j + len)
-        {
-            --k;
-            zeta = -dilithium_zetas[k];
+        dilithium_shuffle8_avx512(&v[2 * i], &v[(2 * i) + 1]);
+        dilithium_shuffle4_avx512(&v[2 * i], &v[(2 * i) + 1]);
+        dilithium_shuffle2_avx512(&v[2 * i], &v[(2 * i) + 1]);
+        dilithium_shuffle1_avx512(&v[2 * i], &v[(2 * i) + 1]);
 
-            for (j = start; j < start + len; ++j)
-            {
-                t = a[j];
-                a[j] = t + a[j + len];
-                a[j + len] = t - a[j + len];
-                a[j + len] = dilithium_montgomery_reduce((int64_t)zeta * a[j + len]);
-            }
-        }
+        z = _mm512_loadu_si512((const __m512i*)&dilithium_invntt_zetas_avx512[64 * i]);
+        dilithium_invbutterfly_avx512(&v[2 * i], &v[(2 * i) + 1], z, _mm512_mullo_epi32(z, QINV));
+        dilithium_shuffle1_avx512(&v[2 * i], &v[(2 * i) + 1]);
+
+        z = _mm512_loadu_si512((const __m512i*)&dilithium_invntt_zetas_avx512[(64 * i) + 16]);
+        dilithium_invbutterfly_avx512(&v[2 * i], &v[(2 * i) + 1], z, _mm512_mullo_epi32(z, QINV));
+        dilithium_shuffle2_avx512(&v[2 * i], &v[(2 * i) + 1]);
+
+        z = _mm512_loadu_si512((const __m512i*)&dilithium_invntt_zetas_avx512[(64 * i) + 32]);
+        dilithium_invbutterfly_avx512(&v[2 * i], &v[(2 * i) + 1], z, _mm512_mullo_epi32(z, QINV));
+        dilithium_shuffle4_avx512(&v[2 * i], &v[(2 * i) + 1]);
+
+        z = _mm512_loadu_si512((const __m512i*)&dilithium_invntt_zetas_avx512[(64 * i) + 48]);
+        dilithium_invbutterfly_avx512(&v[2 * i], &v[(2 * i) + 1], z, _mm512_mullo_epi32(z, QINV));
+        dilithium_shuffle8_avx512(&v[2 * i], &v[(2 * i) + 1]);
     }
 
-    for (j = 0; j < DILITHIUM_N; ++j)
+    /* layers 16, 32, 64 and 128 between the vectors */
+    for (i = 0; i < 16; i += 2)
     {
-        a[j] = dilithium_montgomery_reduce((int64_t)F * a[j]);
+        z = _mm512_set1_epi32(-dilithium_zetas[15 - (i / 2)]);
+        dilithium_invbutterfly_avx512(&v[i], &v[i + 1], z, _mm512_mullo_epi32(z, QINV));
     }
-}
 
-/* poly.c */
+    for (i = 0; i < 16; i += 4)
+    {
+        z = _mm512_set1_epi32(-dilithium_zetas[7 - (i / 4)]);
+        dilithium_invbutterfly_avx512(&v[i], &v[i + 2], z, _mm512_mullo_epi32(z, QINV));
+        dilithium_invbutterfly_avx512(&v[i + 1], &v[i + 3], z, _mm512_mullo_epi32(z, QINV));
+    }
 
-static void dilithium_poly_add(dilithium_poly* c, const dilithium_poly* a, const dilithium_poly* b)
-{
-    for (size_t i = 0; i < DILITHIUM_N; ++i)
+    for (i = 0; i < 16; i += 8)
     {
-        c->coeffs[i] = a->coeffs[i] + b->coeffs[i];
+        z = _mm512_set1_epi32(-dilithium_zetas[3 - (i / 8)]);
+
+        for (j = i; j < i + 4; ++j)
+        {
+            dilithium_invbutterfly_avx512(&v[j], &v[j + 4], z, _mm512_mullo_epi32(z, QINV));
+        }
     }
-}
 
-static void dilithium_poly_sub(dilithium_poly* c, const dilithium_poly* a, const dilithium_poly* b)
-{
-    for (size_t i = 0; i < DILITHIUM_N; ++i)
+    z = _mm512_set1_epi32(-dilithium_zetas[1]);
+
+    for (j = 0; j < 8; ++j)
     {
-        c->coeffs[i] = a->coeffs[i] - b->coeffs[i];
+        dilithium_invbutterfly_avx512(&v[j], &v[j + 8], z, _mm512_mullo_epi32(z, QINV));
     }
-}
 
-static void dilithium_poly_shiftl(dilithium_poly* a)
-{
-    for (size_t i = 0; i < DILITHIUM_N; ++i)
+    for (j = 0; j < 16; ++j)
     {
-        a->coeffs[i] <<= DILITHIUM_D;
+        v[j] = dilithium_fqmul_avx512(v[j], F, _mm512_mullo_epi32(F, QINV));
+        _mm512_storeu_si512((__m512i*)&a[16 * j], v[j]);
     }
 }
+#else
+static void dilithium_butterfly_avx2(__m256i* a, __m256i* b, __m256i zeta, __m256i zqinv)
+{
+    __m256i t;
+
+    t = dilithium_fqmul_avx2(*b, zeta, zqinv);
+    *b = _mm256_sub_epi32(*a, t);
+    *a = _mm256_add_epi32(*a, t);
+}
 
-static void dilithium_poly_ntt(dilithium_poly* a)
+static void dilithium_invbutterfly_avx2(__m256i* a, __m256i* b, __m256i zeta, __m256i zqinv)
 {
-    dilithium_ntt(a->coeffs);
+    __m256i t;
+
+    t = *a;
+    *a = _mm256_add_epi32(t, *b);
+    *b = dilithium_fqmul_avx2(_mm256_sub_epi32(t, *b), zeta, zqinv);
 }
 
-static void dilithium_poly_invntt_to_mont(dilithium_poly* a)
+/* the 256-bit shuffles pair the coefficients of the length 4, 2 and 1 layers
+   of two 8 coefficient blocks; each is its own inverse */
+
+static void dilithium_shuffle4_avx2(__m256i* a, __m256i* b)
 {
-    dilithium_invntt_to_mont(a->coeffs);
+    __m256i t;
+
+    t = _mm256_permute2x128_si256(*a, *b, 0x20);
+    *b = _mm256_permute2x128_si256(*a, *b, 0x31);
+    *a = t;
 }
 
-static void dilithium_poly_pointwise_montgomery(dilithium_poly* c, const dilithium_poly* a, const dilithium_poly* b)
+static void dilithium_shuffle2_avx2(__m256i* a, __m256i* b)
 {
-    for (size_t i = 0; i < DILITHIUM_N; ++i)
-    {
-        c->coeffs[i] = dilithium_montgomery_reduce((int64_t)a->coeffs[i] * b->coeffs[i]);
-    }
+    __m256i t;
+
+    t = _mm256_unpacklo_epi64(*a, *b);
+    *b = _mm256_unpackhi_epi64(*a, *b);
+    *a = t;
 }
 
-static void dilithium_poly_challenge(dilithium_poly* c, const uint8_t seed[DILITHIUM_SEEDBYTES])
+static void dilithium_shuffle1_avx2(__m256i* a, __m256i* b)
 {
-    uint8_t buf[QSC_KECCAK_256_RATE];
-    qsc_keccak_state kctx;
-    uint64_t signs;
-    size_t i;
-    size_t b;
-    size_t pos;
+    __m256i t;
 
-    qsc_keccak_initialize_state(&kctx);
-    qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, seed, DILITHIUM_SEEDBYTES);
-    qsc_keccak_incremental_finalize(&kctx, QSC_KECCAK_256_RATE, QSC_KECCAK_SHAKE_DOMAIN_ID);
-    qsc_keccak_squeezeblocks(&kctx, buf, 1, QSC_KECCAK_256_RATE, QSC_KECCAK_PERMUTATION_ROUNDS);
-    signs = 0;
-    pos = 8;
+    t = _mm256_blend_epi32(*a, _mm256_slli_epi64(*b, 32), 0xAA);
+    *b = _mm256_blend_epi32(_mm256_srli_epi64(*a, 32), *b, 0xAA);
+    *a = t;
+}
 
-    for (i = 0; i < 8; ++i)
-    {
-        signs |= (uint64_t)buf[i] << (8 * i);
-    }
+static void dilithium_ntt_avx2(int32_t a[DILITHIUM_N])
+{
+    const __m256i QINV = _mm256_set1_epi32(DILITHIUM_QINV);
+    __m256i v[32];
+    __m256i z;
+    size_t i;
+    size_t j;
+    size_t k;
+    size_t len;
 
-    for (i = 0; i < DILITHIUM_N; ++i)
+    for (j = 0; j < 32; ++j)
     {
-        c->coeffs[i] = 0;
+        v[j] = _mm256_loadu_si256((const __m256i*)&a[8 * j]);
     }
 
-    for (i = DILITHIUM_N - DILITHIUM_TAU; i < DILITHIUM_N; ++i)
+    /* layers 128, 64, 32, 16 and 8 between the vectors */
+    k = 0;
+
+    for (len = 16; len > 0; len >>= 1)
     {
-        do
+        for (i = 0; i < 32; i += 2 * len)
         {
-            if (pos >= QSC_KECCAK_256_RATE)
+            ++k;
+            z = _mm256_set1_epi32(dilithium_zetas[k]);
+
+            for (j = i; j < i + len; ++j)
             {
-                qsc_keccak_squeezeblocks(&kctx, buf, 1, QSC_KECCAK_256_RATE, QSC_KECCAK_PERMUTATION_ROUNDS);
-                pos = 0;
+                dilithium_butterfly_avx2(&v[j], &v[j + len], z, _mm256_mullo_epi32(z, QINV));
             }
+        }
+    }
 
-            b = buf[pos];
-            ++pos;
-        } 
-        while (b > i);
+    /* layers 4, 2 and 1 on each pair of vectors */
+    for (i = 0; i < 16; ++i)
+    {
+        dilithium_shuffle4_avx2(&v[2 * i], &v[(2 * i) + 1]);
+        z = _mm256_loadu_si256((const __m256i*)&dilithium_ntt_zetas_avx2[24 * i]);
+        dilithium_butterfly_avx2(&v[2 * i], &v[(2 * i) + 1], z, _mm256_mullo_epi32(z, QINV));
 
-        c->coeffs[i] = c->coeffs[b];
-        c->coeffs[b] = 1 - (2 * (signs & 1));
-        signs >>= 1;
+        dilithium_shuffle2_avx2(&v[2 * i], &v[(2 * i) + 1]);
+        z = _mm256_loadu_si256((const __m256i*)&dilithium_ntt_zetas_avx2[(24 * i) + 8]);
+        dilithium_butterfly_avx2(&v[2 * i], &v[(2 * i) + 1], z, _mm256_mullo_epi32(z, QINV));
+
+        dilithium_shuffle1_avx2(&v[2 * i], &v[(2 * i) + 1]);
+        z = _mm256_loadu_si256((const __m256i*)&dilithium_ntt_zetas_avx2[(24 * i) + 16]);
+        dilithium_butterfly_avx2(&v[2 * i], &v[(2 * i) + 1], z, _mm256_mullo_epi32(z, QINV));
+
+        dilithium_shuffle1_avx2(&v[2 * i], &v[(2 * i) + 1]);
+        dilithium_shuffle2_avx2(&v[2 * i], &v[(2 * i) + 1]);
+        dilithium_shuffle4_avx2(&v[2 * i], &v[(2 * i) + 1]);
+    }
+
+    for (j = 0; j < 32; ++j)
+    {
+        _mm256_storeu_si256((__m256i*)&a[8 * j], v[j]);
     }
 }
 
-static void dilithium_polyeta_pack(uint8_t* r, const dilithium_poly* a)
+static void dilithium_invntt_avx2(int32_t a[DILITHIUM_N])
 {
-    uint8_t t[8];
-
+    const __m256i QINV = _mm256_set1_epi32(DILITHIUM_QINV);
+    const __m256i F = _mm256_set1_epi32(41978); /* mont ^ 2 / 256 */
+    __m256i v[32];
+    __m256i z;
+    size_t i;
+    size_t j;
+    size_t k;
+    size_t len;
+
+    for (j = 0; j < 32; ++j)
+    {
+        v[j] = _mm256_loadu_si256((const __m256i*)&a[8 * j]);
+    }
+
+    /* layers 1, 2 and 4 on each pair of vectors */
+    for (i = 0; i < 16; ++i)
+    {
+        dilithium_shuffle4_avx2(&v[2 * i], &v[(2 * i) + 1]);
+        dilithium_shuffle2_avx2(&v[2 * i], &v[(2 * i) + 1]);
+        dilithium_shuffle1_avx2(&v[2 * i], &v[(2 * i) + 1]);
+
+        z = _mm256_loadu_si256((const __m256i*)&dilithium_invntt_zetas_avx2[24 * i]);
+        dilithium_invbutterfly_avx2(&v[2 * i], &v[(2 * i) + 1], z, _mm256_mullo_epi32(z, QINV));
+        dilithium_shuffle1_avx2(&v[2 * i], &v[(2 * i) + 1]);
+
+        z = _mm256_loadu_si256((const __m256i*)&dilithium_invntt_zetas_avx2[(24 * i) + 8]);
+        dilithium_invbutterfly_avx2(&v[2 * i], &v[(2 * i) + 1], z, _mm256_mullo_epi32(z, QINV));
+        dilithium_shuffle2_avx2(&v[2 * i], &v[(2 * i) + 1]);
+
+        z = _mm256_loadu_si256((const __m256i*)&dilithium_invntt_zetas_avx2[(24 * i) + 16]);
+        dilithium_invbutterfly_avx2(&v[2 * i], &v[(2 * i) + 1], z, _mm256_mullo_epi32(z, QINV));
+        dilithium_shuffle4_avx2(&v[2 * i], &v[(2 * i) + 1]);
+    }
+
+    /* layers 8, 16, 32, 64 and 128 between the vectors */
+    k = 32;
+
+    for (len = 1; len < 32; len <<= 1)
+    {
+        for (i = 0; i < 32; i += 2 * len)
+        {
+            --k;
+            z = _mm256_set1_epi32(-dilithium_zetas[k]);
+
+            for (j = i; j < i + len; ++j)
+            {
+                dilithium_invbutterfly_avx2(&v[j], &v[j + len], z, _mm256_mullo_epi32(z, QINV));
+            }
+        }
+    }
+
+    for (j = 0; j < 32; ++j)
+    {
+        v[j] = dilithium_fqmul_avx2(v[j], F, _mm256_mullo_epi32(F, QINV));
+        _mm256_storeu_si256((__m256i*)&a[8 * j], v[j]);
+    }
+}
+#endif
+
+/* poly.c */
+
+static void dilithium_poly_ntt(qsc_dilithium_poly* a)
+{
+#if defined(QSC_SYSTEM_HAS_AVX512)
+    dilithium_ntt_avx512(a->coeffs);
+#else
+    dilithium_ntt_avx2(a->coeffs);
+#endif
+}
+
+static void dilithium_poly_invntt_to_mont(qsc_dilithium_poly* a)
+{
+#if defined(QSC_SYSTEM_HAS_AVX512)
+    dilithium_invntt_avx512(a->coeffs);
+#else
+    dilithium_invntt_avx2(a->coeffs);
+#endif
+}
+
+static void dilithium_avx2_poly_pointwise_montgomery(qsc_dilithium_poly* c, const qsc_dilithium_poly* a, const qsc_dilithium_poly* b)
+{
+    const __m256i QINV = _mm256_set1_epi32(DILITHIUM_QINV);
+    __m256i f;
+    __m256i g;
+
+    for (size_t i = 0; i < DILITHIUM_N; i += 8)
+    {
+        f = _mm256_loadu_si256((const __m256i*)&a->coeffs[i]);
+        g = _mm256_loadu_si256((const __m256i*)&b->coeffs[i]);
+        f = dilithium_fqmul_avx2(f, g, _mm256_mullo_epi32(g, QINV));
+        _mm256_storeu_si256((__m256i*)&c->coeffs[i], f);
+    }
+}
+
+static void dilithium_poly_challenge(qsc_dilithium_poly* c, const uint8_t seed[DILITHIUM_SEEDBYTES])
+{
+    uint8_t buf[QSC_KECCAK_256_RATE];
+    qsc_keccak_state kctx;
+    uint64_t signs;
+    size_t i;
+    size_t b;
+    size_t pos;
+
+    qsc_keccak_initialize_state(&kctx);
+    qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, seed, DILITHIUM_SEEDBYTES);
+    qsc_keccak_incremental_finalize(&kctx, QSC_KECCAK_256_RATE, QSC_KECCAK_SHAKE_DOMAIN_ID);
+    qsc_keccak_squeezeblocks(&kctx, buf, 1, QSC_KECCAK_256_RATE, QSC_KECCAK_PERMUTATION_ROUNDS);
+    signs = 0;
+    pos = 8;
+
+    for (i = 0; i < 8; ++i)
+    {
+        signs |= (uint64_t)buf[i] << (8 * i);
+    }
+
+    for (i = 0; i < DILITHIUM_N; ++i)
+    {
+        c->coeffs[i] = 0;
+    }
+
+    for (i = DILITHIUM_N - DILITHIUM_TAU; i < DILITHIUM_N; ++i)
+    {
+        do
+        {
+            if (pos >= QSC_KECCAK_256_RATE)
+            {
+                qsc_keccak_squeezeblocks(&kctx, buf, 1, QSC_KECCAK_256_RATE, QSC_KECCAK_PERMUTATION_ROUNDS);
+                pos = 0;
+            }
+
+            b = buf[pos];
+            ++pos;
+        } 
+        while (b > i);
+
+        c->coeffs[i] = c->coeffs[b];
+        c->coeffs[b] = 1 - (2 * (signs & 1));
+        signs >>= 1;
+    }
+}
+
+static void dilithium_polyeta_pack(uint8_t* r, const qsc_dilithium_poly* a)
+{
+    uint8_t t[8];
+
 #if DILITHIUM_ETA == 2
     for (size_t i = 0; i < DILITHIUM_N / 8; ++i)
     {
@@ -1155,7 +1836,7 @@ static void dilithium_polyeta_pack(uint8_t* r, const dilithium_poly* a)
 #endif
 }
 
-static void dilithium_polyeta_unpack(dilithium_poly* r, const uint8_t* a)
+static void dilithium_polyeta_unpack(qsc_dilithium_poly* r, const uint8_t* a)
 {
 #if (DILITHIUM_ETA == 2)
     for (size_t i = 0; i < DILITHIUM_N / 8; ++i)
@@ -1189,7 +1870,7 @@ static void dilithium_polyeta_unpack(dilithium_poly* r, const uint8_t* a)
 #endif
 }
 
-static void dilithium_polyt1_pack(uint8_t* r, const dilithium_poly* a)
+static void dilithium_polyt1_pack(uint8_t* r, const qsc_dilithium_poly* a)
 {
     for (size_t i = 0; i < DILITHIUM_N / 4; ++i)
     {
@@ -1201,7 +1882,7 @@ static void dilithium_polyt1_pack(uint8_t* r, const dilithium_poly* a)
     }
 }
 
-static void dilithium_polyt1_unpack(dilithium_poly* r, const uint8_t* a)
+static void dilithium_polyt1_unpack(qsc_dilithium_poly* r, const uint8_t* a)
 {
     for (size_t i = 0; i < DILITHIUM_N / 4; ++i)
     {
@@ -1212,7 +1893,7 @@ static void dilithium_polyt1_unpack(dilithium_poly* r, const uint8_t* a)
     }
 }
 
-static void dilithium_polyt0_pack(uint8_t* r, const dilithium_poly* a)
+static void dilithium_polyt0_pack(uint8_t* r, const qsc_dilithium_poly* a)
 {
     uint32_t t[8];
 
@@ -1250,7 +1931,7 @@ static void dilithium_polyt0_pack(uint8_t* r, const dilithium_poly* a)
     }
 }
 
-static void dilithium_polyt0_unpack(dilithium_poly* r, const uint8_t* a)
+static void dilithium_polyt0_unpack(qsc_dilithium_poly* r, const uint8_t* a)
 {
     for (size_t i = 0; i < DILITHIUM_N / 8; ++i)
     {
@@ -1301,7 +1982,7 @@ static void dilithium_polyt0_unpack(dilithium_poly* r, const uint8_t* a)
     }
 }
 
-static void dilithium_polyz_pack(uint8_t* r, const dilithium_poly* a)
+static void dilithium_polyz_pack(uint8_t* r, const qsc_dilithium_poly* a)
 {
     uint32_t t[4];
 
@@ -1342,7 +2023,7 @@ static void dilithium_polyz_pack(uint8_t* r, const dilithium_poly* a)
 #endif
 }
 
-static void dilithium_poly_uniform_gamma1(dilithium_poly* a, const uint8_t seed[DILITHIUM_CRHBYTES], uint16_t nonce)
+static void dilithium_poly_uniform_gamma1(qsc_dilithium_poly* a, const uint8_t seed[DILITHIUM_CRHBYTES], uint16_t nonce)
 {
     uint8_t buf[DILITHIUM_POLY_UNIFORM_GAMMA1_NBLOCKS * QSC_KECCAK_256_RATE];
     qsc_keccak_state kctx;
@@ -1361,16 +2042,60 @@ static void dilithium_poly_uniform_gamma1(dilithium_poly* a, const uint8_t seed[
 
 /* polyvec.c */
 
-static void dilithium_avx2_polyvec_matrix_expand(dilithium_polyvecl mat[DILITHIUM_K], const uint8_t rho[DILITHIUM_SEEDBYTES])
+#if defined(QSC_SYSTEM_HAS_AVX512)
+static void dilithium_avx512_polyvec_matrix_expand_span(qsc_dilithium_polyvecl mat[DILITHIUM_K], const uint8_t rho[DILITHIUM_SEEDBYTES], size_t first, size_t count)
 {
-#if DILITHIUM_K == 4 && DILITHIUM_L == 4
+    /* expands the matrix entries [first, first + count) in row-major order, eight at a time;
+       unused lanes write to scratch polynomials, a short tail falls back to the 4-way sampler */
+    qsc_dilithium_poly tmp[8];
+    qsc_dilithium_poly* pa[8];
+    uint16_t nonce[8];
+    size_t i;
+    size_t k;
+    size_t r;
+
+    for (i = first; i < first + count; i += 8)
+    {
+        r = first + count - i;
+
+        for (k = 0; k < 8; ++k)
+        {
+            if (k < r)
+            {
+                pa[k] = &mat[(i + k) / DILITHIUM_L].vec[(i + k) % DILITHIUM_L];
+                nonce[k] = (uint16_t)((((i + k) / DILITHIUM_L) << 8) + ((i + k) % DILITHIUM_L));
+            }
+            else
+            {
+                pa[k] = &tmp[k];
+                nonce[k] = 0;
+            }
+        }
+
+        if (r > 4)
+        {
+            dilithium_avx512_poly_uniform_8x(pa, rho, nonce);
+        }
+        else
+        {
+            dilithium_avx2_poly_uniform_4x(pa[0], pa[1], pa[2], pa[3], rho, nonce[0], nonce[1], nonce[2], nonce[3]);
+        }
+    }
+}
+#endif
+
+static void dilithium_avx2_polyvec_matrix_expand(qsc_dilithium_polyvecl mat[DILITHIUM_K], const uint8_t rho[DILITHIUM_SEEDBYTES])
+{
+#if defined(QSC_SYSTEM_HAS_AVX512)
+    dilithium_avx512_polyvec_matrix_expand_span(mat, rho, 0, DILITHIUM_K * DILITHIUM_L);
+#elif DILITHIUM_K == 4 && DILITHIUM_L == 4
     dilithium_avx2_poly_uniform_4x(&mat[0].vec[0], &mat[0].vec[1], &mat[0].vec[2], &mat[0].vec[3], rho, 0, 1, 2, 3);
     dilithium_avx2_poly_uniform_4x(&mat[1].vec[0], &mat[1].vec[1], &mat[1].vec[2], &mat[1].vec[3], rho, 256, 257, 258, 259);
     dilithium_avx2_poly_uniform_4x(&mat[2].vec[0], &mat[2].vec[1], &mat[2].vec[2], &mat[2].vec[3], rho, 512, 513, 514, 515);
     dilithium_avx2_poly_uniform_4x(&mat[3].vec[0], &mat[3].vec[1], &mat[3].vec[2], &mat[3].vec[3], rho, 768, 769, 770, 771);
 #elif DILITHIUM_K == 6 && DILITHIUM_L == 5
-    dilithium_poly t0;
-    dilithium_poly t1;
+    qsc_dilithium_poly t0;
+    qsc_dilithium_poly t1;
     dilithium_avx2_poly_uniform_4x(&mat[0].vec[0], &mat[0].vec[1], &mat[0].vec[2], &mat[0].vec[3], rho, 0, 1, 2, 3);
     dilithium_avx2_poly_uniform_4x(&mat[0].vec[4], &mat[1].vec[0], &mat[1].vec[1], &mat[1].vec[2], rho, 4, 256, 257, 258);
     dilithium_avx2_poly_uniform_4x(&mat[1].vec[3], &mat[1].vec[4], &mat[2].vec[0], &mat[2].vec[1], rho, 259, 260, 512, 513);
@@ -1397,9 +2122,11 @@ static void dilithium_avx2_polyvec_matrix_expand(dilithium_polyvecl mat[DILITHIU
 #endif
 }
 
-static void dilithium_avx2_polyvec_matrix_expand_row(dilithium_polyvecl mat[DILITHIUM_K], const uint8_t rho[DILITHIUM_SEEDBYTES], size_t idx)
+static void dilithium_avx2_polyvec_matrix_expand_row(qsc_dilithium_polyvecl mat[DILITHIUM_K], const uint8_t rho[DILITHIUM_SEEDBYTES], size_t idx)
 {
-#if DILITHIUM_K == 4 && DILITHIUM_L == 4
+#if defined(QSC_SYSTEM_HAS_AVX512)
+    dilithium_avx512_polyvec_matrix_expand_span(mat, rho, idx * DILITHIUM_L, DILITHIUM_L);
+#elif DILITHIUM_K == 4 && DILITHIUM_L == 4
     if (idx == 0)
     {
         dilithium_avx2_poly_uniform_4x(&mat[0].vec[0], &mat[0].vec[1], &mat[0].vec[2], &mat[0].vec[3], rho, 0, 1, 2, 3);
@@ -1441,8 +2168,8 @@ static void dilithium_avx2_polyvec_matrix_expand_row(dilithium_polyvecl mat[DILI
     }
     if (idx == 5)
     {
-        dilithium_poly t0;
-        dilithium_poly t1;
+        qsc_dilithium_poly t0;
+        qsc_dilithium_poly t1;
 
         dilithium_avx2_poly_uniform_4x(&mat[5].vec[3], &mat[5].vec[4], &t0, &t1, rho, 1283, 1284, 0, 0);
     }
@@ -1489,20 +2216,33 @@ static void dilithium_avx2_polyvec_matrix_expand_row(dilithium_polyvecl mat[DILI
 #endif
 }
 
-static void dilithium_polyvecl_pointwise_acc_montgomery(dilithium_poly* w, const dilithium_polyvecl* u, const dilithium_polyvecl* v)
+static void dilithium_avx2_polyvecl_pointwise_acc_montgomery(qsc_dilithium_poly* w, const qsc_dilithium_polyvecl* u, const qsc_dilithium_polyvecl* v)
 {
-    dilithium_poly t;
-
-    dilithium_poly_pointwise_montgomery(w, &u->vec[0], &v->vec[0]);
+    /* the products of each column are reduced and summed in registers,
+       the accumulator is stored once per 8 coefficients */
+    const __m256i QINV = _mm256_set1_epi32(DILITHIUM_QINV);
+    __m256i acc;
+    __m256i f;
+    __m256i g;
 
-    for (size_t i = 1; i < DILITHIUM_L; ++i)
+    for (size_t i = 0; i < DILITHIUM_N; i += 8)
     {
-        dilithium_poly_pointwise_montgomery(&t, &u->vec[i], &v->vec[i]);
-        dilithium_poly_add(w, w, &t);
+        f = _mm256_loadu_si256((const __m256i*)&u->vec[0].coeffs[i]);
+        g = _mm256_loadu_si256((const __m256i*)&v->vec[0].coeffs[i]);
+        acc = dilithium_fqmul_avx2(f, g, _mm256_mullo_epi32(g, QINV));
+
+        for (size_t j = 1; j < DILITHIUM_L; ++j)
+        {
+            f = _mm256_loadu_si256((const __m256i*)&u->vec[j].coeffs[i]);
+            g = _mm256_loadu_si256((const __m256i*)&v->vec[j].coeffs[i]);
+            acc = _mm256_add_epi32(acc, dilithium_fqmul_avx2(f, g, _mm256_mullo_epi32(g, QINV)));
+        }
+
+        _mm256_storeu_si256((__m256i*)&w->coeffs[i], acc);
     }
 }
 
-static void dilithium_polyvecl_ntt(dilithium_polyvecl* v)
+static void dilithium_polyvecl_ntt(qsc_dilithium_polyvecl* v)
 {
     for (size_t i = 0; i < DILITHIUM_L; ++i)
     {
@@ -1510,7 +2250,7 @@ static void dilithium_polyvecl_ntt(dilithium_polyvecl* v)
     }
 }
 
-static void dilithium_polyveck_ntt(dilithium_polyveck* v)
+static void dilithium_polyveck_ntt(qsc_dilithium_polyveck* v)
 {
     for (size_t i = 0; i < DILITHIUM_K; ++i)
     {
@@ -1521,7 +2261,7 @@ static void dilithium_polyveck_ntt(dilithium_polyveck* v)
 /* packing.c */
 
 static void dilithium_unpack_sk(uint8_t rho[DILITHIUM_SEEDBYTES], uint8_t tr[DILITHIUM_CRHBYTES], uint8_t key[DILITHIUM_SEEDBYTES],
-    dilithium_polyveck* t0, dilithium_polyvecl* s1, dilithium_polyveck* s2, const uint8_t sk[DILITHIUM_PRIVATEKEY_SIZE])
+    qsc_dilithium_polyveck* t0, qsc_dilithium_polyvecl* s1, qsc_dilithium_polyveck* s2, const uint8_t sk[DILITHIUM_PRIVATEKEY_SIZE])
 {
     size_t  i;
 
@@ -1556,11 +2296,11 @@ static void dilithium_unpack_sk(uint8_t rho[DILITHIUM_SEEDBYTES], uint8_t tr[DIL
 
 void qsc_dilithium_avx2_generate_keypair(uint8_t* pk, uint8_t* sk, bool (*rng_generate)(uint8_t*, size_t))
 {
-    dilithium_polyvecl mat[DILITHIUM_K];
-    dilithium_polyvecl s1;
-    dilithium_polyveck s2;
-    dilithium_poly t0;
-    dilithium_poly t1;
+    qsc_dilithium_polyvecl mat[DILITHIUM_K];
+    qsc_dilithium_polyvecl s1;
+    qsc_dilithium_polyveck s2;
+    qsc_dilithium_poly t0;
+    qsc_dilithium_poly t1;
     QSC_ALIGN(32) uint8_t seedbuf[3 * DILITHIUM_SEEDBYTES];
     QSC_ALIGN(32)uint8_t tr[DILITHIUM_CRHBYTES];
     const uint8_t* key;
@@ -1616,7 +2356,9 @@ void qsc_dilithium_avx2_generate_keypair(uint8_t* pk, uint8_t* sk, bool (*rng_ge
         /* Expand matrix row */
         dilithium_avx2_polyvec_matrix_expand_row(mat, rho, i);
         /* Compute inner-product */
-        dilithium_polyvecl_pointwise_acc_montgomery(&t1, &mat[i], &s1);
+        dilithium_avx2_polyvecl_pointwise_acc_montgomery(&t1, &mat[i], &s1);
+        /* bound the accumulated products for the inverse NTT, as the reference signer does */
+        dilithium_avx2_poly_reduce(&t1);
         dilithium_poly_invntt_to_mont(&t1);
         /* Add error polynomial */
         dilithium_avx2_poly_add(&t1, &t1, &s2.vec[i]);
@@ -1632,193 +2374,376 @@ void qsc_dilithium_avx2_generate_keypair(uint8_t* pk, uint8_t* sk, bool (*rng_ge
     qsc_memutils_copy(sk + (2 * DILITHIUM_SEEDBYTES), tr, DILITHIUM_CRHBYTES);
 }
 
-void qsc_dilithium_avx2_sign_signature(uint8_t* sig, size_t* siglen, const uint8_t* m, size_t mlen, const uint8_t* sk, bool (*rng_generate)(uint8_t*, size_t))
+void qsc_dilithium_avx2_expand_privatekey(qsc_dilithium_expanded_privatekey* esk, const uint8_t* sk)
 {
-    dilithium_polyvecl mat[DILITHIUM_K];
-    dilithium_polyvecl s1;
-    dilithium_polyvecl y;
-    dilithium_polyvecl z;
-    dilithium_polyveck t0;
-    dilithium_polyveck s2;
-    dilithium_polyveck w1;
-    dilithium_polyveck w0;
-    dilithium_poly cp;
-    dilithium_poly h;
-    QSC_ALIGN(32) uint8_t seedbuf[2 * DILITHIUM_SEEDBYTES + 3 * DILITHIUM_CRHBYTES];
-    qsc_keccak_state kctx = { 0 };
-    uint8_t* rho;
-    uint8_t* tr;
-    uint8_t* key;
-    uint8_t* mu;
-    uint8_t* rhoprime;
-    uint8_t* hint = sig + DILITHIUM_SEEDBYTES + DILITHIUM_L * DILITHIUM_POLYZ_PACKEDBYTES;
-    uint16_t nonce;
+    QSC_ALIGN(32) uint8_t rho[DILITHIUM_SEEDBYTES];
+    qsc_dilithium_polyvecl* s1;
+    qsc_dilithium_polyveck* s2;
+    qsc_dilithium_polyveck* t0;
+
+    s1 = &esk->s1;
+    s2 = &esk->s2;
+    t0 = &esk->t0;
+
+    dilithium_unpack_sk(rho, esk->tr, esk->key, t0, s1, s2, sk);
+
+    /* Expand matrix and transform vectors */
+    dilithium_avx2_polyvec_matrix_expand(esk->mat, rho);
+    dilithium_polyvecl_ntt(s1);
+    dilithium_polyveck_ntt(s2);
+    dilithium_polyveck_ntt(t0);
+}
+
+void qsc_dilithium_avx2_expand_publickey(qsc_dilithium_expanded_publickey* epk, const uint8_t* pk)
+{
+    qsc_dilithium_polyveck* t1;
     size_t i;
-    size_t j;
-    size_t n;
-    size_t pos;
-    bool res;
 
-    nonce = 0;
-    rho = seedbuf;
-    tr = rho + DILITHIUM_SEEDBYTES;
-    key = tr + DILITHIUM_CRHBYTES;
-    mu = key + DILITHIUM_SEEDBYTES;
-    rhoprime = mu + DILITHIUM_CRHBYTES;
-    dilithium_unpack_sk(rho, tr, key, &t0, &s1, &s2, sk);
+    t1 = &epk->t1;
 
-    /* Compute CRH(tr, msg) */
-    qsc_keccak_initialize_state(&kctx);
-    qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, tr, DILITHIUM_CRHBYTES);
-    qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, m, mlen);
-    qsc_keccak_incremental_finalize(&kctx, QSC_KECCAK_256_RATE, QSC_KECCAK_SHAKE_DOMAIN_ID);
-    qsc_keccak_incremental_squeeze(&kctx, QSC_KECCAK_256_RATE, mu, DILITHIUM_CRHBYTES);
+    /* The packed public key begins with rho */
+    dilithium_avx2_polyvec_matrix_expand(epk->mat, pk);
 
+    /* Store t1*2^d in the NTT domain */
+    for (i = 0; i < DILITHIUM_K; ++i)
+    {
+        dilithium_polyt1_unpack(&t1->vec[i], pk + DILITHIUM_SEEDBYTES + i * DILITHIUM_POLYT1_PACKEDBYTES);
+        dilithium_avx2_poly_shiftl(&t1->vec[i]);
+        dilithium_poly_ntt(&t1->vec[i]);
+    }
+
+    /* Compute CRH(rho, t1) */
+    qsc_shake256_compute(epk->tr, DILITHIUM_CRHBYTES, pk, DILITHIUM_PUBLICKEY_SIZE);
+}
+
+static void dilithium_sign_rhoprime(uint8_t* rhoprime, const uint8_t* mu, const qsc_dilithium_expanded_privatekey* esk, bool (*rng_generate)(uint8_t*, size_t))
+{
 #ifdef QSC_DILITHIUM_RANDOMIZED_SIGNING
-    rng_generate(rhoprime, CRHBYTES);
+    (void)mu;
+    (void)esk;
+    rng_generate(rhoprime, DILITHIUM_CRHBYTES);
 #else
-    qsc_shake256_compute(rhoprime, DILITHIUM_CRHBYTES, key, DILITHIUM_SEEDBYTES + DILITHIUM_CRHBYTES);
+    QSC_ALIGN(32) uint8_t seedbuf[DILITHIUM_SEEDBYTES + DILITHIUM_CRHBYTES];
+
+    (void)rng_generate;
+    /* The message representative mu = CRH(tr, msg) follows the key */
+    qsc_memutils_copy(seedbuf, esk->key, DILITHIUM_SEEDBYTES);
+    qsc_memutils_copy(seedbuf + DILITHIUM_SEEDBYTES, mu, DILITHIUM_CRHBYTES);
+    qsc_shake256_compute(rhoprime, DILITHIUM_CRHBYTES, seedbuf, sizeof(seedbuf));
+    qsc_memutils_clear(seedbuf, sizeof(seedbuf));
 #endif
+}
 
-    /* Expand matrix and transform vectors */
-    dilithium_avx2_polyvec_matrix_expand(mat, rho);
-    dilithium_polyvecl_ntt(&s1);//12829849..-523516
-    dilithium_polyveck_ntt(&s2);
-    dilithium_polyveck_ntt(&t0);
+static bool dilithium_sign_attempt(uint8_t* sig, const uint8_t* mu, const uint8_t* rhoprime, uint16_t nonce, const qsc_dilithium_expanded_privatekey* esk)
+{
+    /* One iteration of the rejection loop; each nonce is independent of the others */
+    const qsc_dilithium_polyvecl* mat;
+    const qsc_dilithium_polyvecl* s1;
+    const qsc_dilithium_polyveck* s2;
+    const qsc_dilithium_polyveck* t0;
+    qsc_dilithium_polyvecl y;
+    qsc_dilithium_polyvecl z;
+    qsc_dilithium_polyveck w1;
+    qsc_dilithium_polyveck w0;
+    qsc_dilithium_poly cp;
+    qsc_dilithium_poly h;
+    qsc_keccak_state kctx = { 0 };
+    uint8_t* hint = sig + DILITHIUM_SEEDBYTES + DILITHIUM_L * DILITHIUM_POLYZ_PACKEDBYTES;
+    size_t i;
+    size_t j;
+    size_t n;
+    size_t pos;
+    bool res;
 
-    while (true)
-    {
-        res = true;
-        /* Sample intermediate vector y */
+    res = true;
+    mat = esk->mat;
+    s1 = &esk->s1;
+    s2 = &esk->s2;
+    t0 = &esk->t0;
+
+    /* Sample intermediate vector y */
 #if DILITHIUM_L == 4
-        dilithium_avx2_poly_uniform_gamma1_4x(&y.vec[0], &y.vec[1], &y.vec[2], &y.vec[3], rhoprime, nonce, nonce + 1, nonce + 2, nonce + 3);
-        nonce += 4;
+    dilithium_avx2_poly_uniform_gamma1_4x(&y.vec[0], &y.vec[1], &y.vec[2], &y.vec[3], rhoprime, nonce, nonce + 1, nonce + 2, nonce + 3);
 #elif DILITHIUM_L == 5
-        dilithium_avx2_poly_uniform_gamma1_4x(&y.vec[0], &y.vec[1], &y.vec[2], &y.vec[3], rhoprime, nonce, nonce + 1, nonce + 2, nonce + 3);
-        dilithium_poly_uniform_gamma1(&y.vec[4], rhoprime, nonce + 4);
-        nonce += 5;
+    dilithium_avx2_poly_uniform_gamma1_4x(&y.vec[0], &y.vec[1], &y.vec[2], &y.vec[3], rhoprime, nonce, nonce + 1, nonce + 2, nonce + 3);
+    dilithium_poly_uniform_gamma1(&y.vec[4], rhoprime, nonce + 4);
 #elif DILITHIUM_L == 7
-        dilithium_avx2_poly_uniform_gamma1_4x(&y.vec[0], &y.vec[1], &y.vec[2], &y.vec[3], rhoprime, nonce, nonce + 1, nonce + 2, nonce + 3);
-        dilithium_avx2_poly_uniform_gamma1_4x(&y.vec[4], &y.vec[5], &y.vec[6], &h, rhoprime, nonce + 4, nonce + 5, nonce + 6, 0);
-        nonce += 7;
+    dilithium_avx2_poly_uniform_gamma1_4x(&y.vec[0], &y.vec[1], &y.vec[2], &y.vec[3], rhoprime, nonce, nonce + 1, nonce + 2, nonce + 3);
+    dilithium_avx2_poly_uniform_gamma1_4x(&y.vec[4], &y.vec[5], &y.vec[6], &h, rhoprime, nonce + 4, nonce + 5, nonce + 6, 0);
 #else
 #   error
 #endif
 
-        /* Save y and transform it */
-        z = y;
-        dilithium_polyvecl_ntt(&y);
+    /* Save y and transform it */
+    z = y;
+    dilithium_polyvecl_ntt(&y);
 
-        for (i = 0; i < DILITHIUM_K; i++)
+    for (i = 0; i < DILITHIUM_K; i++)
+    {
+        /* Compute inner-product */
+        dilithium_avx2_polyvecl_pointwise_acc_montgomery(&w1.vec[i], &mat[i], &y);
+        /* bound the accumulated products for the inverse NTT, as the reference signer does */
+        dilithium_avx2_poly_reduce(&w1.vec[i]);
+        dilithium_poly_invntt_to_mont(&w1.vec[i]);
+        /* Decompose w and use sig as temporary buffer for packed w1 */
+        dilithium_avx2_poly_caddq(&w1.vec[i]);
+        dilithium_avx2_poly_decompose(&w1.vec[i], &w0.vec[i], &w1.vec[i]);
+        dilithium_avx2_polyw1_pack(sig + i * DILITHIUM_POLYW1_PACKEDBYTES, &w1.vec[i]);
+    }
+
+    /* Call the random oracle */
+    qsc_keccak_initialize_state(&kctx);
+    qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, mu, DILITHIUM_CRHBYTES);
+    qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, sig, DILITHIUM_K * DILITHIUM_POLYW1_PACKEDBYTES);
+    qsc_keccak_incremental_finalize(&kctx, QSC_KECCAK_256_RATE, QSC_KECCAK_SHAKE_DOMAIN_ID);
+    qsc_keccak_incremental_squeeze(&kctx, QSC_KECCAK_256_RATE, sig, DILITHIUM_SEEDBYTES);
+
+    dilithium_poly_challenge(&cp, sig);
+    dilithium_poly_ntt(&cp);
+
+    /* Compute z, reject if it reveals secret */
+    for (i = 0; i < DILITHIUM_L; i++)
+    {
+        dilithium_avx2_poly_pointwise_montgomery(&h, &cp, &s1->vec[i]);
+        dilithium_poly_invntt_to_mont(&h);
+        dilithium_avx2_poly_add(&z.vec[i], &z.vec[i], &h);
+        dilithium_avx2_poly_reduce(&z.vec[i]);
+
+        if (dilithium_avx2_poly_chknorm(&z.vec[i], DILITHIUM_GAMMA1 - DILITHIUM_BETA))
         {
-            /* Compute inner-product */
-            dilithium_polyvecl_pointwise_acc_montgomery(&w1.vec[i], &mat[i], &y);
-            dilithium_poly_invntt_to_mont(&w1.vec[i]);
-            /* Decompose w and use sig as temporary buffer for packed w1 */
-            dilithium_avx2_poly_caddq(&w1.vec[i]);
-            dilithium_avx2_poly_decompose(&w1.vec[i], &w0.vec[i], &w1.vec[i]);
-            dilithium_avx2_polyw1_pack(sig + i * DILITHIUM_POLYW1_PACKEDBYTES, &w1.vec[i]);
+            res = false;
+            break;
         }
+    }
 
-        /* Call the random oracle */
-        qsc_keccak_initialize_state(&kctx);
-        qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, mu, DILITHIUM_CRHBYTES);
-        qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, sig, DILITHIUM_K * DILITHIUM_POLYW1_PACKEDBYTES);
-        qsc_keccak_incremental_finalize(&kctx, QSC_KECCAK_256_RATE, QSC_KECCAK_SHAKE_DOMAIN_ID);
-        qsc_keccak_incremental_squeeze(&kctx, QSC_KECCAK_256_RATE, sig, DILITHIUM_SEEDBYTES);
-
-        dilithium_poly_challenge(&cp, sig);
-        dilithium_poly_ntt(&cp);
+    if (res == true)
+    {
+        /* Zero hint in signature */
+        n = 0;
+        pos = 0;
+        qsc_memutils_clear(hint, DILITHIUM_OMEGA + DILITHIUM_K);
 
-        /* Compute z, reject if it reveals secret */
-        for (i = 0; i < DILITHIUM_L; i++)
+        for (i = 0; i < DILITHIUM_K; i++)
         {
-            dilithium_poly_pointwise_montgomery(&h, &cp, &s1.vec[i]);
+            /* Check that subtracting cs2 does not change high bits of w and low bits
+             * do not reveal secret information */
+            dilithium_avx2_poly_pointwise_montgomery(&h, &cp, &s2->vec[i]);
             dilithium_poly_invntt_to_mont(&h);
-            dilithium_avx2_poly_add(&z.vec[i], &z.vec[i], &h);
-            dilithium_avx2_poly_reduce(&z.vec[i]);
+            dilithium_avx2_poly_sub(&w0.vec[i], &w0.vec[i], &h);
+            dilithium_avx2_poly_reduce(&w0.vec[i]);
 
-            if (dilithium_avx2_poly_chknorm(&z.vec[i], DILITHIUM_GAMMA1 - DILITHIUM_BETA))
+            if (dilithium_avx2_poly_chknorm(&w0.vec[i], DILITHIUM_GAMMA2 - DILITHIUM_BETA))
             {
                 res = false;
                 break;
             }
-        }
 
-        if (res == true)
-        {
-            /* Zero hint in signature */
-            n = 0;
-            pos = 0;
-            qsc_memutils_clear(hint, DILITHIUM_OMEGA + DILITHIUM_K);
+            /* Compute hints */
+            dilithium_avx2_poly_pointwise_montgomery(&h, &cp, &t0->vec[i]);
+            dilithium_poly_invntt_to_mont(&h);
+            dilithium_avx2_poly_reduce(&h);
 
-            for (i = 0; i < DILITHIUM_K; i++)
+            if (dilithium_avx2_poly_chknorm(&h, DILITHIUM_GAMMA2))
             {
-                /* Check that subtracting cs2 does not change high bits of w and low bits
-                 * do not reveal secret information */
-                dilithium_poly_pointwise_montgomery(&h, &cp, &s2.vec[i]);
-                dilithium_poly_invntt_to_mont(&h);
-                dilithium_avx2_poly_sub(&w0.vec[i], &w0.vec[i], &h);
-                dilithium_avx2_poly_reduce(&w0.vec[i]);
-
-                if (dilithium_avx2_poly_chknorm(&w0.vec[i], DILITHIUM_GAMMA2 - DILITHIUM_BETA))
-                {
-                    res = false;
-                    break;
-                }
-
-                /* Compute hints */
-                dilithium_poly_pointwise_montgomery(&h, &cp, &t0.vec[i]);
-                dilithium_poly_invntt_to_mont(&h);
-                dilithium_avx2_poly_reduce(&h);
-
-                if (dilithium_avx2_poly_chknorm(&h, DILITHIUM_GAMMA2))
-                {
-                    res = false;
-                    break;
-                }
+                res = false;
+                break;
+            }
 
-                dilithium_avx2_poly_add(&w0.vec[i], &w0.vec[i], &h);
-                dilithium_avx2_poly_caddq(&w0.vec[i]);
-                n += dilithium_avx2_poly_make_hint(&h, &w0.vec[i], &w1.vec[i]);
+            dilithium_avx2_poly_add(&w0.vec[i], &w0.vec[i], &h);
+            dilithium_avx2_poly_caddq(&w0.vec[i]);
+            n += dilithium_avx2_poly_make_hint(&h, &w0.vec[i], &w1.vec[i]);
 
-                if (n > DILITHIUM_OMEGA)
-                {
-                    res = false;
-                    break;
-                }
+            if (n > DILITHIUM_OMEGA)
+            {
+                res = false;
+                break;
+            }
 
-                /* Store hints in signature */
-                for (j = 0; j < DILITHIUM_N; ++j)
+            /* Store hints in signature */
+            for (j = 0; j < DILITHIUM_N; ++j)
+            {
+                if (h.coeffs[j] != 0)
                 {
-                    if (h.coeffs[j] != 0)
-                    {
-                        hint[pos] = (uint8_t)j;
-                        ++pos;
-                    }
+                    hint[pos] = (uint8_t)j;
+                    ++pos;
                 }
-
-                hint[DILITHIUM_OMEGA + i] = (uint8_t)pos;
             }
-        }
 
-        if (res == false)
-        {
-            continue;
+            hint[DILITHIUM_OMEGA + i] = (uint8_t)pos;
         }
+    }
 
+    if (res == true)
+    {
         /* Pack z into signature */
         for (i = 0; i < DILITHIUM_L; i++)
         {
             dilithium_polyz_pack(sig + DILITHIUM_SEEDBYTES + i * DILITHIUM_POLYZ_PACKEDBYTES, &z.vec[i]);
         }
+    }
+
+    return res;
+}
+
+static bool dilithium_sign_parallel_superseded(const dilithium_parallel_task* task, uint32_t iter)
+{
+    bool res;
+
+    res = *task->halt;
+
+    /* a worker publishes its accepted iteration once, so a stale read only delays the stop */
+    for (size_t i = 0; i < task->count && res == false; ++i)
+    {
+        res = (task->workers[i].accepted < iter);
+    }
+
+    return res;
+}
+
+static void dilithium_sign_parallel_worker(void* state)
+{
+    dilithium_parallel_task* task = (dilithium_parallel_task*)state;
+    uint32_t iter;
+
+    iter = task->first;
+
+    /* the worker persists across rejection rounds, and stops once it accepts a candidate
+       or another worker has accepted a lower iteration */
+    while (dilithium_sign_parallel_superseded(task, iter) == false)
+    {
+        if (dilithium_sign_attempt(task->sig, task->mu, task->rhoprime, (uint16_t)(iter * DILITHIUM_L), task->esk) == true)
+        {
+            task->accepted = iter;
+            break;
+        }
+
+        iter += (uint32_t)task->count;
+    }
+}
+
+void qsc_dilithium_avx2_sign_signature_mu(uint8_t* sig, size_t* siglen, const uint8_t* mu, const qsc_dilithium_expanded_privatekey* esk, bool (*rng_generate)(uint8_t*, size_t))
+{
+    QSC_ALIGN(32) uint8_t rhoprime[DILITHIUM_CRHBYTES];
+    uint16_t nonce;
+
+    nonce = 0;
+    dilithium_sign_rhoprime(rhoprime, mu, esk, rng_generate);
 
-        break;
+    /* Each iteration consumes L nonces, one per polynomial of y */
+    while (dilithium_sign_attempt(sig, mu, rhoprime, nonce, esk) == false)
+    {
+        nonce += DILITHIUM_L;
     }
 
+    qsc_memutils_clear(rhoprime, sizeof(rhoprime));
     *siglen = DILITHIUM_SIGNATURE_SIZE;
 }
 
+void qsc_dilithium_avx2_sign_signature_mu_parallel(uint8_t* sig, size_t* siglen, const uint8_t* mu, const qsc_dilithium_expanded_privatekey* esk, bool (*rng_generate)(uint8_t*, size_t))
+{
+    qsc_thread thds[DILITHIUM_PARALLEL_MAX] = { 0 };
+    QSC_ALIGN(32) uint8_t rhoprime[DILITHIUM_CRHBYTES];
+    dilithium_parallel_task* tasks;
+    size_t i;
+    size_t sel;
+    size_t tcnt;
+    volatile bool halt;
+
+    tasks = NULL;
+    halt = true;
+    tcnt = qsc_intutils_min(qsc_async_processor_count(), (size_t)DILITHIUM_PARALLEL_MAX);
+
+    if (tcnt > 1)
+    {
+        tasks = (dilithium_parallel_task*)qsc_memutils_malloc(tcnt * sizeof(dilithium_parallel_task));
+    }
+
+    if (tasks != NULL)
+    {
+        halt = false;
+        dilithium_sign_rhoprime(rhoprime, mu, esk, rng_generate);
+
+        for (i = 0; i < tcnt; ++i)
+        {
+            tasks[i].esk = esk;
+            tasks[i].mu = mu;
+            tasks[i].rhoprime = rhoprime;
+            tasks[i].workers = tasks;
+            tasks[i].halt = &halt;
+            tasks[i].count = tcnt;
+            tasks[i].first = (uint32_t)i;
+            tasks[i].accepted = DILITHIUM_PARALLEL_NONE;
+        }
+
+        /* the workers are created once per signature; if one cannot be started,
+           the running workers are stopped and the sequential signer is used */
+        for (i = 0; i < tcnt; ++i)
+        {
+            thds[i] = qsc_async_thread_create(dilithium_sign_parallel_worker, &tasks[i]);
+
+            if (thds[i] == 0)
+            {
+                halt = true;
+                break;
+            }
+        }
+
+        qsc_async_thread_wait_all(thds, i);
+
+        if (halt == false)
+        {
+            /* keep the lowest accepted iteration, so the signature is the one the sequential loop would have produced */
+            sel = 0;
+
+            for (i = 1; i < tcnt; ++i)
+            {
+                if (tasks[i].accepted < tasks[sel].accepted)
+                {
+                    sel = i;
+                }
+            }
+
+            qsc_memutils_copy(sig, tasks[sel].sig, DILITHIUM_SIGNATURE_SIZE);
+            *siglen = DILITHIUM_SIGNATURE_SIZE;
+        }
+
+        /* rejected candidates leak information about the secret key */
+        qsc_memutils_clear((uint8_t*)tasks, tcnt * sizeof(dilithium_parallel_task));
+        qsc_memutils_alloc_free(tasks);
+        qsc_memutils_clear(rhoprime, sizeof(rhoprime));
+    }
+
+    if (halt == true)
+    {
+        qsc_dilithium_avx2_sign_signature_mu(sig, siglen, mu, esk, rng_generate);
+    }
+}
+
+
+void qsc_dilithium_avx2_sign_signature_expanded(uint8_t* sig, size_t* siglen, const uint8_t* m, size_t mlen, const qsc_dilithium_expanded_privatekey* esk, bool (*rng_generate)(uint8_t*, size_t))
+{
+    uint8_t mu[DILITHIUM_CRHBYTES];
+    qsc_keccak_state kctx = { 0 };
+
+    /* Compute CRH(tr, msg) */
+    qsc_keccak_initialize_state(&kctx);
+    qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, esk->tr, DILITHIUM_CRHBYTES);
+    qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, m, mlen);
+    qsc_keccak_incremental_finalize(&kctx, QSC_KECCAK_256_RATE, QSC_KECCAK_SHAKE_DOMAIN_ID);
+    qsc_keccak_incremental_squeeze(&kctx, QSC_KECCAK_256_RATE, mu, DILITHIUM_CRHBYTES);
+
+    qsc_dilithium_avx2_sign_signature_mu(sig, siglen, mu, esk, rng_generate);
+}
+
+void qsc_dilithium_avx2_sign_signature(uint8_t* sig, size_t* siglen, const uint8_t* m, size_t mlen, const uint8_t* sk, bool (*rng_generate)(uint8_t*, size_t))
+{
+    qsc_dilithium_expanded_privatekey esk;
+
+    qsc_dilithium_avx2_expand_privatekey(&esk, sk);
+    qsc_dilithium_avx2_sign_signature_expanded(sig, siglen, m, mlen, &esk, rng_generate);
+    qsc_memutils_clear(&esk, sizeof(esk));
+}
+
 void qsc_dilithium_avx2_sign(uint8_t* sm, size_t* smlen, const uint8_t* m, size_t mlen, const uint8_t* sk, bool (*rng_generate)(uint8_t*, size_t))
 {
     for (size_t i = 0; i < mlen; ++i)
@@ -1830,17 +2755,28 @@ void qsc_dilithium_avx2_sign(uint8_t* sm, size_t* smlen, const uint8_t* m, size_
     *smlen += mlen;
 }
 
-bool qsc_dilithium_avx2_verify(const uint8_t* sig, size_t siglen, const uint8_t* m, size_t mlen, const uint8_t* pk)
+void qsc_dilithium_avx2_sign_expanded(uint8_t* sm, size_t* smlen, const uint8_t* m, size_t mlen, const qsc_dilithium_expanded_privatekey* esk, bool (*rng_generate)(uint8_t*, size_t))
 {
-    dilithium_polyvecl mat[DILITHIUM_K];
-    dilithium_polyvecl z;
-    dilithium_poly cp;
-    dilithium_poly w1;
-    dilithium_poly t1;
-    dilithium_poly h;
+    for (size_t i = 0; i < mlen; ++i)
+    {
+        sm[DILITHIUM_SIGNATURE_SIZE + mlen - 1 - i] = m[mlen - 1 - i];
+    }
+
+    qsc_dilithium_avx2_sign_signature_expanded(sm, smlen, sm + DILITHIUM_SIGNATURE_SIZE, mlen, esk, rng_generate);
+    *smlen += mlen;
+}
+
+bool qsc_dilithium_avx2_verify_mu(const uint8_t* sig, size_t siglen, const uint8_t* mu, const qsc_dilithium_expanded_publickey* epk)
+{
+    const qsc_dilithium_polyvecl* mat;
+    const qsc_dilithium_polyveck* t1;
+    qsc_dilithium_polyvecl z;
+    qsc_dilithium_poly cp;
+    qsc_dilithium_poly w1;
+    qsc_dilithium_poly ct1;
+    qsc_dilithium_poly h;
     qsc_keccak_state kctx = { 0 };
     QSC_ALIGN(32) uint8_t buf[DILITHIUM_K * DILITHIUM_POLYW1_PACKEDBYTES];
-    uint8_t mu[DILITHIUM_CRHBYTES];
     uint8_t c[DILITHIUM_SEEDBYTES];
     const uint8_t* hint = sig + DILITHIUM_SEEDBYTES + DILITHIUM_L * DILITHIUM_POLYZ_PACKEDBYTES;
     size_t i;
@@ -1848,16 +2784,13 @@ bool qsc_dilithium_avx2_verify(const uint8_t* sig, size_t siglen, const uint8_t*
     size_t pos;
     bool res;
 
-    res = true;
+    mat = epk->mat;
+    t1 = &epk->t1;
+    res = false;
 
     if (siglen == DILITHIUM_SIGNATURE_SIZE)
     {
-        /* Compute CRH(CRH(rho, t1), msg) */
-        qsc_shake256_compute(mu, DILITHIUM_CRHBYTES, pk, DILITHIUM_PUBLICKEY_SIZE);
-        qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, mu, DILITHIUM_CRHBYTES);
-        qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, m, mlen);
-        qsc_keccak_incremental_finalize(&kctx, QSC_KECCAK_256_RATE, QSC_KECCAK_SHAKE_DOMAIN_ID);
-        qsc_keccak_incremental_squeeze(&kctx, QSC_KECCAK_256_RATE, mu, DILITHIUM_CRHBYTES);
+        res = true;
 
         /* Expand challenge */
         dilithium_poly_challenge(&cp, sig);
@@ -1874,18 +2807,11 @@ bool qsc_dilithium_avx2_verify(const uint8_t* sig, size_t siglen, const uint8_t*
 
         for (i = 0; i < DILITHIUM_K; i++)
         {
-            /* Expand matrix row */
-            dilithium_avx2_polyvec_matrix_expand_row(mat, pk, i);
-
             /* Compute i-th row of Az - c2^Dt1 */
-            dilithium_polyvecl_pointwise_acc_montgomery(&w1, &mat[i], &z);
-
-            dilithium_polyt1_unpack(&t1, pk + DILITHIUM_SEEDBYTES + i * DILITHIUM_POLYT1_PACKEDBYTES);
-            dilithium_avx2_poly_shiftl(&t1);
-            dilithium_poly_ntt(&t1);
-            dilithium_poly_pointwise_montgomery(&t1, &cp, &t1);
+            dilithium_avx2_polyvecl_pointwise_acc_montgomery(&w1, &mat[i], &z);
 
-            dilithium_avx2_poly_sub(&w1, &w1, &t1);
+            dilithium_avx2_poly_pointwise_montgomery(&ct1, &cp, &t1->vec[i]);
+            dilithium_avx2_poly_sub(&w1, &w1, &ct1);
             dilithium_avx2_poly_reduce(&w1);
             dilithium_poly_invntt_to_mont(&w1);
 
@@ -1961,6 +2887,30 @@ bool qsc_dilithium_avx2_verify(const uint8_t* sig, size_t siglen, const uint8_t*
     return res;
 }
 
+bool qsc_dilithium_avx2_verify_expanded(const uint8_t* sig, size_t siglen, const uint8_t* m, size_t mlen, const qsc_dilithium_expanded_publickey* epk)
+{
+    uint8_t mu[DILITHIUM_CRHBYTES];
+    qsc_keccak_state kctx;
+
+    /* Compute CRH(CRH(rho, t1), msg) */
+    qsc_keccak_initialize_state(&kctx);
+    qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, epk->tr, DILITHIUM_CRHBYTES);
+    qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, m, mlen);
+    qsc_keccak_incremental_finalize(&kctx, QSC_KECCAK_256_RATE, QSC_KECCAK_SHAKE_DOMAIN_ID);
+    qsc_keccak_incremental_squeeze(&kctx, QSC_KECCAK_256_RATE, mu, DILITHIUM_CRHBYTES);
+
+    return qsc_dilithium_avx2_verify_mu(sig, siglen, mu, epk);
+}
+
+bool qsc_dilithium_avx2_verify(const uint8_t* sig, size_t siglen, const uint8_t* m, size_t mlen, const uint8_t* pk)
+{
+    qsc_dilithium_expanded_publickey epk;
+
+    qsc_dilithium_avx2_expand_publickey(&epk, pk);
+
+    return qsc_dilithium_avx2_verify_expanded(sig, siglen, m, mlen, &epk);
+}
+
 bool qsc_dilithium_avx2_open(uint8_t* m, size_t* mlen, const uint8_t* sm, size_t smlen, const uint8_t* pk)
 {
     bool res;
@@ -1980,7 +2930,34 @@ bool qsc_dilithium_avx2_open(uint8_t* m, size_t* mlen, const uint8_t* sm, size_t
         }
     }
 
-    if (res == false)
+    if (res == false && smlen >= DILITHIUM_SIGNATURE_SIZE)
+    {
+        qsc_memutils_clear(m, smlen - DILITHIUM_SIGNATURE_SIZE);
+    }
+
+    return res;
+}
+
+bool qsc_dilithium_avx2_open_expanded(uint8_t* m, size_t* mlen, const uint8_t* sm, size_t smlen, const qsc_dilithium_expanded_publickey* epk)
+{
+    bool res;
+
+    *mlen = -1;
+    res = false;
+
+    if (smlen >= DILITHIUM_SIGNATURE_SIZE)
+    {
+        *mlen = smlen - DILITHIUM_SIGNATURE_SIZE;
+        res = qsc_dilithium_avx2_verify_expanded(sm, DILITHIUM_SIGNATURE_SIZE, sm + DILITHIUM_SIGNATURE_SIZE, *mlen, epk);
+
+        if (res == true)
+        {
+            /* All good, copy msg, return 0 */
+            qsc_memutils_copy(m, sm + DILITHIUM_SIGNATURE_SIZE, *mlen);
+        }
+    }
+
+    if (res == false && smlen >= DILITHIUM_SIGNATURE_SIZE)
     {
         qsc_memutils_clear(m, smlen - DILITHIUM_SIGNATURE_SIZE);
     }
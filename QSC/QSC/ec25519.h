@@ -42,6 +42,7 @@
 #define EC25519_SIGNATURE_SIZE 64
 #define EC25519_PUBLICKEY_SIZE 32
 #define EC25519_PRIVATEKEY_SIZE 64
+#define EC25519_PREHASH_SIZE 64
 #define EC25519_CURVE_SIZE 32U
 
 /* fe */
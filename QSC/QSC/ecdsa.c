@@ -30,3 +30,56 @@ bool qsc_ecdsa_verify(uint8_t* message, size_t* msglen, const uint8_t* signedmsg
 
 	return (ret == 0);
 }
+
+void qsc_ecdsa_sign_detached(uint8_t* signature, size_t* siglen, const uint8_t* message, size_t msglen, const uint8_t* privatekey)
+{
+	qsc_ed25519_sign_signature(signature, siglen, message, msglen, privatekey);
+}
+
+bool qsc_ecdsa_verify_detached(const uint8_t* signature, size_t siglen, const uint8_t* message, size_t msglen, const uint8_t* publickey)
+{
+	int32_t ret;
+
+	ret = qsc_ed25519_verify_signature(signature, siglen, message, msglen, publickey);
+
+	return (ret == 0);
+}
+
+void qsc_ecdsa_sign_initialize(qsc_ecdsa_stream_state* state)
+{
+	qsc_sha512_initialize(&state->hstate);
+}
+
+void qsc_ecdsa_sign_update(qsc_ecdsa_stream_state* state, const uint8_t* message, size_t msglen)
+{
+	qsc_sha512_update(&state->hstate, message, msglen);
+}
+
+void qsc_ecdsa_sign_finalize(qsc_ecdsa_stream_state* state, uint8_t* signature, size_t* siglen, const uint8_t* privatekey)
+{
+	uint8_t phm[QSC_SHA2_512_HASH_SIZE] = { 0 };
+
+	qsc_sha512_finalize(&state->hstate, phm);
+	qsc_ed25519ph_sign_signature(signature, siglen, phm, privatekey);
+}
+
+void qsc_ecdsa_verify_initialize(qsc_ecdsa_stream_state* state)
+{
+	qsc_sha512_initialize(&state->hstate);
+}
+
+void qsc_ecdsa_verify_update(qsc_ecdsa_stream_state* state, const uint8_t* message, size_t msglen)
+{
+	qsc_sha512_update(&state->hstate, message, msglen);
+}
+
+bool qsc_ecdsa_verify_finalize(qsc_ecdsa_stream_state* state, const uint8_t* signature, size_t siglen, const uint8_t* publickey)
+{
+	uint8_t phm[QSC_SHA2_512_HASH_SIZE] = { 0 };
+	int32_t ret;
+
+	qsc_sha512_finalize(&state->hstate, phm);
+	ret = qsc_ed25519ph_verify_signature(signature, siglen, phm, publickey);
+
+	return (ret == 0);
+}
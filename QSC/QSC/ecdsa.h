@@ -26,6 +26,7 @@
 #define QSC_ECDSA_H
 
 #include "common.h"
+#include "sha2.h"
 
 /**
 * \file ecdsa.h
@@ -101,6 +102,18 @@
 */
 #define QSC_ECDSA_ALGNAME "ECDSA"
 
+/**
+* \struct qsc_ecdsa_stream_state
+* \brief The ECDSA streaming sign and verify state. \n
+* Holds the SHA2-512 state that absorbs the message in chunks.
+* Ed25519 hashes the message twice during signing, so streaming signatures
+* use the HashEdDSA variant Ed25519ph (RFC 8032) over the SHA2-512 hash of the message.
+*/
+typedef struct
+{
+	qsc_sha512_state hstate;	/*!< The message pre-hash state */
+} qsc_ecdsa_stream_state;
+
 /**
 * \brief Generates a ECDSA public/private key-pair.
 *
@@ -148,4 +161,91 @@ QSC_EXPORT_API void qsc_ecdsa_sign(uint8_t* signedmsg, size_t* smsglen, const ui
 */
 QSC_EXPORT_API bool qsc_ecdsa_verify(uint8_t* message, size_t* msglen, const uint8_t* signedmsg, size_t smsglen, const uint8_t* publickey);
 
+/**
+* \brief Signs a message and returns a detached signature.
+* The message is read in place; no copy of the message is made.
+*
+* \warning Signature array must be sized to QSC_ECDSA_SIGNATURE_SIZE.
+*
+* \param signature: Pointer to the signature array
+* \param siglen: Pointer to the signature length
+* \param message: [const] Pointer to the message array
+* \param msglen: The message length
+* \param privatekey: [const] Pointer to the private signature-key array
+*/
+QSC_EXPORT_API void qsc_ecdsa_sign_detached(uint8_t* signature, size_t* siglen, const uint8_t* message, size_t msglen, const uint8_t* privatekey);
+
+/**
+* \brief Verifies a detached signature against a message with the public key.
+*
+* \param signature: [const] Pointer to the signature array
+* \param siglen: The signature length
+* \param message: [const] Pointer to the message array
+* \param msglen: The message length
+* \param publickey: [const] Pointer to the public verification-key array
+* \return Returns true for success
+*/
+QSC_EXPORT_API bool qsc_ecdsa_verify_detached(const uint8_t* signature, size_t siglen, const uint8_t* message, size_t msglen, const uint8_t* publickey);
+
+/**
+* \brief Initialize a streaming Ed25519ph signature.
+* Long form api: must be used in conjunction with the update and finalize functions.
+* The signature verifies only with the streaming verification functions, or any RFC 8032 Ed25519ph implementation.
+*
+* \param state: [struct] The stream state
+*/
+QSC_EXPORT_API void qsc_ecdsa_sign_initialize(qsc_ecdsa_stream_state* state);
+
+/**
+* \brief Add a block of message bytes to a streaming signature.
+* Can be called any number of times; memory use does not depend on the message length.
+*
+* \param state: [struct] The stream state
+* \param message: [const] Pointer to the message block
+* \param msglen: The message block length
+*/
+QSC_EXPORT_API void qsc_ecdsa_sign_update(qsc_ecdsa_stream_state* state, const uint8_t* message, size_t msglen);
+
+/**
+* \brief Finalize a streaming signature and return the detached signature.
+* The stream state is erased.
+*
+* \warning Signature array must be sized to QSC_ECDSA_SIGNATURE_SIZE.
+*
+* \param state: [struct] The stream state
+* \param signature: Pointer to the signature array
+* \param siglen: Pointer to the signature length
+* \param privatekey: [const] Pointer to the private signature-key array
+*/
+QSC_EXPORT_API void qsc_ecdsa_sign_finalize(qsc_ecdsa_stream_state* state, uint8_t* signature, size_t* siglen, const uint8_t* privatekey);
+
+/**
+* \brief Initialize a streaming Ed25519ph verification.
+* Long form api: must be used in conjunction with the update and finalize functions.
+*
+* \param state: [struct] The stream state
+*/
+QSC_EXPORT_API void qsc_ecdsa_verify_initialize(qsc_ecdsa_stream_state* state);
+
+/**
+* \brief Add a block of message bytes to a streaming verification.
+*
+* \param state: [struct] The stream state
+* \param message: [const] Pointer to the message block
+* \param msglen: The message block length
+*/
+QSC_EXPORT_API void qsc_ecdsa_verify_update(qsc_ecdsa_stream_state* state, const uint8_t* message, size_t msglen);
+
+/**
+* \brief Finalize a streaming verification and verify the detached signature.
+* The stream state is erased.
+*
+* \param state: [struct] The stream state
+* \param signature: [const] Pointer to the signature array
+* \param siglen: The signature length
+* \param publickey: [const] Pointer to the public verification-key array
+* \return Returns true for success
+*/
+QSC_EXPORT_API bool qsc_ecdsa_verify_finalize(qsc_ecdsa_stream_state* state, const uint8_t* signature, size_t siglen, const uint8_t* publickey);
+
 #endif
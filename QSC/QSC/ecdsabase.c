@@ -5,7 +5,21 @@
 #include "memutils.h"
 #include "sha2.h"
 
-static int32_t ecdsa_ed25519_sign(uint8_t* sm, size_t* smlen, const uint8_t* m, size_t mlen, const uint8_t* sk)
+/*!
+\def ECDSA_ED25519PH_DOM_SIZE
+* \brief The byte size of the Ed25519ph dom2 prefix with an empty context
+*/
+#define ECDSA_ED25519PH_DOM_SIZE 34
+
+/* dom2(1, ""): the RFC 8032 prefix string, the pre-hash flag, and the context length */
+static const uint8_t ecdsa_ed25519ph_dom[ECDSA_ED25519PH_DOM_SIZE] =
+{
+	0x53, 0x69, 0x67, 0x45, 0x64, 0x32, 0x35, 0x35, 0x31, 0x39, 0x20, 0x6E, 0x6F, 0x20, 0x45, 0x64,
+	0x32, 0x35, 0x35, 0x31, 0x39, 0x20, 0x63, 0x6F, 0x6C, 0x6C, 0x69, 0x73, 0x69, 0x6F, 0x6E, 0x73,
+	0x01, 0x00
+};
+
+static int32_t ecdsa_ed25519_sign(uint8_t* sm, size_t* smlen, const uint8_t* m, size_t mlen, const uint8_t* sk, const uint8_t* dom, size_t domlen)
 {
 	uint8_t az[64] = { 0 };
 	uint8_t nonce[64] = { 0 };
@@ -17,6 +31,11 @@ static int32_t ecdsa_ed25519_sign(uint8_t* sm, size_t* smlen, const uint8_t* m,
 	qsc_sha512_compute(az, sk, 32);
 
 	qsc_sha512_initialize(&ctx);
+	/* update with the domain prefix */
+	if (domlen != 0)
+	{
+		qsc_sha512_update(&ctx, dom, domlen);
+	}
 	/* update with 2nd half of az */
 	qsc_sha512_update(&ctx, az + 32, 32);
 	/* update hash with m */
@@ -34,6 +53,11 @@ static int32_t ecdsa_ed25519_sign(uint8_t* sm, size_t* smlen, const uint8_t* m,
 	ge25519_p3_tobytes(sm, &R);
 
 	qsc_sha512_initialize(&ctx);
+	/* update with the domain prefix */
+	if (domlen != 0)
+	{
+		qsc_sha512_update(&ctx, dom, domlen);
+	}
 	/* update hash with sig */
 	qsc_sha512_update(&ctx, sm, 64);
 	/* update hash with message */
@@ -59,7 +83,7 @@ static int32_t ecdsa_ed25519_sign(uint8_t* sm, size_t* smlen, const uint8_t* m,
 	return 0;
 }
 
-static bool ecdsa_ed25519_verify(const uint8_t* sig, const uint8_t* m, size_t mlen, const uint8_t* pk)
+static bool ecdsa_ed25519_verify(const uint8_t* sig, const uint8_t* m, size_t mlen, const uint8_t* pk, const uint8_t* dom, size_t domlen)
 {
 	qsc_sha512_state ctx;
 	uint8_t h[64] = { 0 };
@@ -92,6 +116,12 @@ static bool ecdsa_ed25519_verify(const uint8_t* sig, const uint8_t* m, size_t ml
 	if (res == true)
 	{
 		qsc_sha512_initialize(&ctx);
+
+		if (domlen != 0)
+		{
+			qsc_sha512_update(&ctx, dom, domlen);
+		}
+
 		qsc_sha512_update(&ctx, sig, 32);
 		qsc_sha512_update(&ctx, pk, 32);
 		qsc_sha512_update(&ctx, m, mlen);
@@ -133,7 +163,7 @@ int32_t qsc_ed25519_sign(uint8_t* signedmsg, size_t* smsglen, const uint8_t* mes
 
 	qsc_memutils_copy(signedmsg + EC25519_SIGNATURE_SIZE, message, msglen);
 
-	if (ecdsa_ed25519_sign(signedmsg, &slen, signedmsg + EC25519_SIGNATURE_SIZE, msglen, privatekey) != 0 || slen != EC25519_SIGNATURE_SIZE)
+	if (ecdsa_ed25519_sign(signedmsg, &slen, signedmsg + EC25519_SIGNATURE_SIZE, msglen, privatekey, NULL, 0) != 0 || slen != EC25519_SIGNATURE_SIZE)
 	{
 		if (smsglen != NULL)
 		{
@@ -164,7 +194,7 @@ int32_t qsc_ed25519_verify(uint8_t* message, size_t* msglen, const uint8_t* sign
 	assert(smsglen > EC25519_SIGNATURE_SIZE);
 	assert(smsglen - EC25519_SIGNATURE_SIZE < QSC_SIZE_MAX);
 
-	if (ecdsa_ed25519_verify(signedmsg, signedmsg + EC25519_SIGNATURE_SIZE, MSGLEN, publickey) == false)
+	if (ecdsa_ed25519_verify(signedmsg, signedmsg + EC25519_SIGNATURE_SIZE, MSGLEN, publickey, NULL, 0) == false)
 	{
 		if (message != NULL)
 		{
@@ -195,3 +225,91 @@ int32_t qsc_ed25519_verify(uint8_t* message, size_t* msglen, const uint8_t* sign
 
 	return res;
 }
+
+int32_t qsc_ed25519_sign_signature(uint8_t* signature, size_t* siglen, const uint8_t* message, size_t msglen, const uint8_t* privatekey)
+{
+	size_t slen;
+	int32_t res;
+
+	if (ecdsa_ed25519_sign(signature, &slen, message, msglen, privatekey, NULL, 0) != 0 || slen != EC25519_SIGNATURE_SIZE)
+	{
+		if (siglen != NULL)
+		{
+			*siglen = 0;
+		}
+
+		qsc_memutils_clear(signature, EC25519_SIGNATURE_SIZE);
+		res = -1;
+	}
+	else
+	{
+		if (siglen != NULL)
+		{
+			*siglen = slen;
+		}
+
+		res = 0;
+	}
+
+	return res;
+}
+
+int32_t qsc_ed25519_verify_signature(const uint8_t* signature, size_t siglen, const uint8_t* message, size_t msglen, const uint8_t* publickey)
+{
+	int32_t res;
+
+	if (siglen != EC25519_SIGNATURE_SIZE || ecdsa_ed25519_verify(signature, message, msglen, publickey, NULL, 0) == false)
+	{
+		res = -1;
+	}
+	else
+	{
+		res = 0;
+	}
+
+	return res;
+}
+
+int32_t qsc_ed25519ph_sign_signature(uint8_t* signature, size_t* siglen, const uint8_t* phm, const uint8_t* privatekey)
+{
+	size_t slen;
+	int32_t res;
+
+	if (ecdsa_ed25519_sign(signature, &slen, phm, EC25519_PREHASH_SIZE, privatekey, ecdsa_ed25519ph_dom, sizeof(ecdsa_ed25519ph_dom)) != 0 || slen != EC25519_SIGNATURE_SIZE)
+	{
+		if (siglen != NULL)
+		{
+			*siglen = 0;
+		}
+
+		qsc_memutils_clear(signature, EC25519_SIGNATURE_SIZE);
+		res = -1;
+	}
+	else
+	{
+		if (siglen != NULL)
+		{
+			*siglen = slen;
+		}
+
+		res = 0;
+	}
+
+	return res;
+}
+
+int32_t qsc_ed25519ph_verify_signature(const uint8_t* signature, size_t siglen, const uint8_t* phm, const uint8_t* publickey)
+{
+	int32_t res;
+
+	if (siglen != EC25519_SIGNATURE_SIZE || ecdsa_ed25519_verify(signature, phm, EC25519_PREHASH_SIZE, publickey, ecdsa_ed25519ph_dom, sizeof(ecdsa_ed25519ph_dom)) == false)
+	{
+		res = -1;
+	}
+	else
+	{
+		res = 0;
+	}
+
+	return res;
+}
@@ -73,6 +73,52 @@ int32_t qsc_ed25519_sign(uint8_t* signedmsg, size_t* smsglen, const uint8_t* mes
 */
 int32_t qsc_ed25519_verify(uint8_t* message, size_t* msglen, const uint8_t* signedmsg, size_t smsglen, const uint8_t* publickey);
 
+/**
+* \brief Signs a message and returns the detached signature.
+*
+* \param signature: The signature array
+* \param siglen: The signature length
+* \param message: [const] The message to be signed
+* \param msglen: The message length
+* \param secretkey: [const] The private signature key
+* \return Returns 0 for success
+*/
+int32_t qsc_ed25519_sign_signature(uint8_t* signature, size_t* siglen, const uint8_t* message, size_t msglen, const uint8_t* privatekey);
+
+/**
+* \brief Verifies a detached signature against a message with the public key.
+*
+* \param signature: [const] The signature array
+* \param siglen: The signature length
+* \param message: [const] The message that was signed
+* \param msglen: The message length
+* \param publickey: [const] The public verification key
+* \return Returns 0 for success
+*/
+int32_t qsc_ed25519_verify_signature(const uint8_t* signature, size_t siglen, const uint8_t* message, size_t msglen, const uint8_t* publickey);
+
+/**
+* \brief Signs a SHA2-512 message pre-hash with Ed25519ph (RFC 8032, empty context) and returns the detached signature.
+*
+* \param signature: The signature array
+* \param siglen: The signature length
+* \param phm: [const] The 64 byte SHA2-512 hash of the message
+* \param secretkey: [const] The private signature key
+* \return Returns 0 for success
+*/
+int32_t qsc_ed25519ph_sign_signature(uint8_t* signature, size_t* siglen, const uint8_t* phm, const uint8_t* privatekey);
+
+/**
+* \brief Verifies an Ed25519ph (RFC 8032, empty context) signature against a SHA2-512 message pre-hash.
+*
+* \param signature: [const] The signature array
+* \param siglen: The signature length
+* \param phm: [const] The 64 byte SHA2-512 hash of the message
+* \param publickey: [const] The public verification key
+* \return Returns 0 for success
+*/
+int32_t qsc_ed25519ph_verify_signature(const uint8_t* signature, size_t siglen, const uint8_t* phm, const uint8_t* publickey);
+
 /* \endcond DOXYGEN_IGNORE */
 
 #endif
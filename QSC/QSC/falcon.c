@@ -9,6 +9,8 @@
 #else
 #	include "falconbase.h"
 #endif
+#include "intutils.h"
+#include "memutils.h"
 
 void qsc_falcon_generate_keypair(uint8_t* publickey, uint8_t* privatekey, bool (*rng_generate)(uint8_t*, size_t))
 {
@@ -38,6 +40,47 @@ void qsc_falcon_sign(uint8_t* signedmsg, size_t* smsglen, const uint8_t* message
 #endif
 }
 
+bool qsc_falcon_expand_privatekey(qsc_falcon_expanded_privatekey* expanded, const uint8_t* privatekey)
+{
+	assert(expanded != NULL);
+	assert(privatekey != NULL);
+
+	int32_t res;
+
+#if defined(QSC_FALCON_AVX2)
+	res = qsc_falcon_avx2_expand_privatekey(expanded, privatekey);
+#else
+	res = qsc_falcon_ref_expand_privatekey(expanded, privatekey);
+#endif
+
+	return (res == 0);
+}
+
+void qsc_falcon_expanded_privatekey_dispose(qsc_falcon_expanded_privatekey* expanded)
+{
+	assert(expanded != NULL);
+
+	if (expanded != NULL)
+	{
+		qsc_memutils_clear((uint8_t*)expanded, sizeof(qsc_falcon_expanded_privatekey));
+	}
+}
+
+void qsc_falcon_sign_expanded(uint8_t* signedmsg, size_t* smsglen, const uint8_t* message, size_t msglen, const qsc_falcon_expanded_privatekey* privatekey, bool (*rng_generate)(uint8_t*, size_t))
+{
+	assert(signedmsg != NULL);
+	assert(smsglen != NULL);
+	assert(message != NULL);
+	assert(privatekey != NULL);
+	assert(rng_generate != NULL);
+
+#if defined(QSC_FALCON_AVX2)
+	qsc_falcon_avx2_sign_expanded(signedmsg, smsglen, message, msglen, privatekey, rng_generate);
+#else
+	qsc_falcon_ref_sign_expanded(signedmsg, smsglen, message, msglen, privatekey, rng_generate);
+#endif
+}
+
 bool qsc_falcon_verify(uint8_t* message, size_t* msglen, const uint8_t* signedmsg, size_t smsglen, const uint8_t* publickey)
 {
 	assert(message != NULL);
@@ -55,3 +98,121 @@ bool qsc_falcon_verify(uint8_t* message, size_t* msglen, const uint8_t* signedms
 
 	return res;
 }
+
+void qsc_falcon_sign_detached(uint8_t* signature, size_t* siglen, const uint8_t* message, size_t msglen, const uint8_t* privatekey, bool (*rng_generate)(uint8_t*, size_t))
+{
+	assert(signature != NULL);
+	assert(siglen != NULL);
+	assert(message != NULL);
+	assert(privatekey != NULL);
+	assert(rng_generate != NULL);
+
+#if defined(QSC_FALCON_AVX2)
+	qsc_falcon_avx2_sign_signature(signature, siglen, message, msglen, privatekey, rng_generate);
+#else
+	qsc_falcon_ref_sign_signature(signature, siglen, message, msglen, privatekey, rng_generate);
+#endif
+}
+
+bool qsc_falcon_verify_detached(const uint8_t* signature, size_t siglen, const uint8_t* message, size_t msglen, const uint8_t* publickey)
+{
+	assert(signature != NULL);
+	assert(message != NULL);
+	assert(publickey != NULL);
+
+	bool res;
+
+#if defined(QSC_FALCON_AVX2)
+	res = qsc_falcon_avx2_verify(signature, siglen, message, msglen, publickey);
+#else
+	res = qsc_falcon_ref_verify(signature, siglen, message, msglen, publickey);
+#endif
+
+	return res;
+}
+
+void qsc_falcon_sign_initialize(qsc_falcon_stream_state* state, bool (*rng_generate)(uint8_t*, size_t))
+{
+	assert(state != NULL);
+	assert(rng_generate != NULL);
+
+	rng_generate(state->nonce, sizeof(state->nonce));
+	qsc_keccak_initialize_state(&state->kstate);
+	qsc_keccak_incremental_absorb(&state->kstate, QSC_KECCAK_256_RATE, state->nonce, sizeof(state->nonce));
+}
+
+void qsc_falcon_sign_update(qsc_falcon_stream_state* state, const uint8_t* message, size_t msglen)
+{
+	assert(state != NULL);
+	assert(message != NULL);
+
+	qsc_keccak_incremental_absorb(&state->kstate, QSC_KECCAK_256_RATE, message, msglen);
+}
+
+void qsc_falcon_sign_finalize(qsc_falcon_stream_state* state, uint8_t* signature, size_t* siglen, const uint8_t* privatekey, bool (*rng_generate)(uint8_t*, size_t))
+{
+	assert(state != NULL);
+	assert(signature != NULL);
+	assert(siglen != NULL);
+	assert(privatekey != NULL);
+	assert(rng_generate != NULL);
+
+#if defined(QSC_FALCON_AVX2)
+	qsc_falcon_avx2_sign_hashed(signature, siglen, &state->kstate, state->nonce, privatekey, rng_generate);
+#else
+	qsc_falcon_ref_sign_hashed(signature, siglen, &state->kstate, state->nonce, privatekey, rng_generate);
+#endif
+
+	qsc_keccak_dispose(&state->kstate);
+	qsc_memutils_clear(state->nonce, sizeof(state->nonce));
+}
+
+void qsc_falcon_verify_initialize(qsc_falcon_stream_state* state, const uint8_t* signature, size_t siglen)
+{
+	assert(state != NULL);
+	assert(signature != NULL);
+
+	qsc_memutils_clear(state->nonce, sizeof(state->nonce));
+
+	/* a short signature leaves a zero nonce and fails in finalize */
+	if (siglen >= 2 + QSC_FALCON_NONCE_SIZE)
+	{
+		qsc_memutils_copy(state->nonce, signature + 2, sizeof(state->nonce));
+	}
+
+	qsc_keccak_initialize_state(&state->kstate);
+	qsc_keccak_incremental_absorb(&state->kstate, QSC_KECCAK_256_RATE, state->nonce, sizeof(state->nonce));
+}
+
+void qsc_falcon_verify_update(qsc_falcon_stream_state* state, const uint8_t* message, size_t msglen)
+{
+	assert(state != NULL);
+	assert(message != NULL);
+
+	qsc_keccak_incremental_absorb(&state->kstate, QSC_KECCAK_256_RATE, message, msglen);
+}
+
+bool qsc_falcon_verify_finalize(qsc_falcon_stream_state* state, const uint8_t* signature, size_t siglen, const uint8_t* publickey)
+{
+	assert(state != NULL);
+	assert(signature != NULL);
+	assert(publickey != NULL);
+
+	bool res;
+
+	res = false;
+
+	/* the signature must carry the nonce the state was initialized with */
+	if (siglen >= 2 + QSC_FALCON_NONCE_SIZE && qsc_intutils_are_equal8(state->nonce, signature + 2, sizeof(state->nonce)) == true)
+	{
+#if defined(QSC_FALCON_AVX2)
+		res = qsc_falcon_avx2_verify_hashed(signature, siglen, &state->kstate, publickey);
+#else
+		res = qsc_falcon_ref_verify_hashed(signature, siglen, &state->kstate, publickey);
+#endif
+	}
+
+	qsc_keccak_dispose(&state->kstate);
+
+	return res;
+}
@@ -11,50 +11,11 @@
 
 /* fpr.c */
 
-static uint64_t falcon_fpr_ursh(uint64_t x, int32_t n)
-{
-	/*
-	* Right-shift a 64-bit uint32_t value by a possibly secret shift count.
-	* We assumed that the underlying architecture had a barrel shifter for
-	* 32-bit shifts, but for 64-bit shifts on a 32-bit system, this will
-	* typically invoke a software routine that is not necessarily
-	* constant-time; hence the function below.
-	*
-	* Shift count n MUST be in the 0..63 range.
-	*/
-
-	x ^= (x ^ (x >> 32)) & (uint64_t)-(int64_t)(n >> 5);
-
-	return x >> (n & 31);
-}
-
-static int64_t falcon_fpr_irsh(int64_t x, int32_t n)
-{
-	/*
-	 * Right-shift a 64-bit signed value by a possibly secret shift count
-	 * (see falcon_fpr_ursh() for the rationale).
-	 *
-	 * Shift count n MUST be in the 0..63 range.
-	 */
-
-	x ^= (x ^ (x >> 32)) & -(int64_t)(n >> 5);
-
-	return x >> (n & 31);
-}
-
-static uint64_t falcon_fpr_ulsh(uint64_t x, int32_t n)
-{
-	/*
-	* Left-shift a 64-bit uint32_t value by a possibly secret shift count
-	* (see falcon_fpr_ursh() for the rationale).
-	*
-	* Shift count n MUST be in the 0..63 range.
-	*/
-
-	x ^= (x ^ (x << 32)) & (uint64_t)-(int64_t)(n >> 5);
-
-	return x << (n & 31);
-}
+/*
+ * The packing, division and square root functions are emulated with integer
+ * arithmetic in both backends, so that their execution time does not depend
+ * on the operand values.
+ */
 
 static falcon_fpr falcon_FPR(int32_t s, int32_t e, uint64_t m)
 {
@@ -116,6 +77,338 @@ static falcon_fpr falcon_FPR(int32_t s, int32_t e, uint64_t m)
 	return x;
 }
 
+static falcon_fpr falcon_fpr_div(falcon_fpr x, falcon_fpr y)
+{
+	uint64_t xu;
+	uint64_t yu;
+	uint64_t q;
+	uint64_t q2;
+	uint64_t w;
+	int32_t i;
+	int32_t ex;
+	int32_t ey;
+	int32_t e;
+	int32_t d;
+	int32_t s;
+
+	/*
+	 * Extract mantissas of x and y (uint32_t).
+	 */
+	xu = (x & ((1ULL << 52) - 1)) | (1ULL << 52);
+	yu = (y & ((1ULL << 52) - 1)) | (1ULL << 52);
+
+	/*
+	 * Perform bit-by-bit division of xu by yu. We run it for 55 bits.
+	 */
+	q = 0;
+
+	for (i = 0; i < 55; ++i)
+	{
+		/*
+		 * If yu is less than or equal xu, then subtract it and
+		 * push a 1 in the quotient; otherwise, leave xu unchanged
+		 * and push a 0.
+		 */
+		uint64_t b;
+
+		b = ((xu - yu) >> 63) - 1;
+		xu -= b & yu;
+		q |= b & 1;
+		xu <<= 1;
+		q <<= 1;
+	}
+
+	/*
+	 * We got 55 bits in the quotient, followed by an extra zero. We
+	 * want that 56th bit to be "sticky": it should be a 1 if and
+	 * only if the remainder (xu) is non-zero.
+	 */
+	q |= (xu | (uint64_t)-(int64_t)xu) >> 63;
+
+	/*
+	 * Quotient is at most 2^56-1. Its top bit may be zero, but in
+	 * that case the next-to-top bit will be a one, since the
+	 * initial xu and yu were both in the 2^52..2^53-1 range.
+	 * We perform a conditional shift to normalize q to the
+	 * 2^54..2^55-1 range (with the bottom bit being sticky).
+	 */
+	q2 = (q >> 1) | (q & 1);
+	w = q >> 55;
+	q ^= (q ^ q2) & (uint64_t)-(int64_t)w;
+
+	/*
+	 * Extract exponents to compute the scaling factor:
+	 *
+	 *   - Each exponent is biased and we scaled them up by
+	 *     52 bits; but these biases will cancel out.
+	 *
+	 *   - The division loop produced a 55-bit shifted result,
+	 *     so we must scale it down by 55 bits.
+	 *
+	 *   - If w = 1, we right-shifted the integer by 1 bit,
+	 *     hence we must add 1 to the scaling.
+	 */
+	ex = (int32_t)((x >> 52) & 0x000007FFL);
+	ey = (int32_t)((y >> 52) & 0x000007FFL);
+	e = ex - ey - 55 + (int32_t)w;
+
+	/*
+	 * Sign is the XOR of the signs of the operands.
+	 */
+	s = (int32_t)((x ^ y) >> 63);
+
+	/*
+	 * Corrective actions for zeros: if x = 0, then the computation
+	 * is wrong, and we must clamp e and q to 0. We do not care
+	 * about the case y = 0 (as per assumptions in this module,
+	 * the caller does not perform divisions by zero).
+	 */
+	d = (ex + 0x000007FFL) >> 11;
+	s &= d;
+	e &= -d;
+	q &= (uint64_t)-(int64_t)d;
+
+	/*
+	 * falcon_FPR() packs the result and applies proper rounding.
+	 */
+	return falcon_FPR(s, e, q);
+}
+
+static falcon_fpr falcon_fpr_sqrt(falcon_fpr x)
+{
+	uint64_t xu;
+	uint64_t q;
+	uint64_t s;
+	uint64_t r;
+	int32_t ex;
+	int32_t e;
+
+	/*
+	 * Extract the mantissa and the exponent. We don't care about
+	 * the sign: by assumption, the operand is nonnegative.
+	 * We want the "true" exponent corresponding to a mantissa
+	 * in the 1..2 range.
+	 */
+	xu = (x & ((1ULL << 52) - 1)) | (1ULL << 52);
+	ex = (int32_t)((x >> 52) & 0x000007FFL);
+	e = ex - 1023;
+
+	/*
+	 * If the exponent is odd, double the mantissa and decrement
+	 * the exponent. The exponent is then halved to account for
+	 * the square root.
+	 */
+	xu += xu & (uint64_t)-(int64_t)(e & 1);
+	e >>= 1;
+
+	/*
+	 * Double the mantissa.
+	 */
+	xu <<= 1;
+
+	/*
+	 * We now have a mantissa in the 2^53..2^55-1 range. It
+	 * represents a value between 1 (inclusive) and 4 (exclusive)
+	 * in fixed point notation (with 53 fractional bits). We
+	 * compute the square root bit by bit.
+	 */
+	q = 0;
+	s = 0;
+	r = 1ULL << 53;
+
+	for (int32_t i = 0; i < 54; ++i)
+	{
+		uint64_t b;
+		uint64_t t;
+
+		t = s + r;
+		b = ((xu - t) >> 63) - 1;
+		s += (r << 1) & b;
+		xu -= t & b;
+		q += r & b;
+		xu <<= 1;
+		r >>= 1;
+	}
+
+	/*
+	 * Now, q is a rounded-low 54-bit value, with a leading 1,
+	 * 52 fractional digits, and an additional guard bit. We add
+	 * an extra sticky bit to account for what remains of the operand.
+	 */
+	q <<= 1;
+	q |= (xu | (uint64_t)-(int64_t)xu) >> 63;
+
+	/*
+	 * Result q is in the 2^54..2^55-1 range; we bias the exponent
+	 * by 54 bits (the value e at that point contains the "true"
+	 * exponent, but q is now considered an integer, i.e. scaled
+	 * up.
+	 */
+	e -= 54;
+
+	/*
+	 * Corrective action for an operand of value zero.
+	 */
+	q &= (uint64_t)-(int64_t)((ex + 0x000007FFL) >> 11);
+
+	/*
+	 * Apply rounding and back result.
+	 */
+	return falcon_FPR(0, e, q);
+}
+
+#if defined(FALCON_FPR_NATIVE)
+
+/*
+ * Native floating-point backend. A falcon_fpr holds the IEEE-754 binary64
+ * encoding of the value, so the constants and precomputed tables are shared
+ * with the integer emulation below; the values are moved into SSE2 registers
+ * and processed with the scalar double-precision instructions. With the
+ * default MXCSR settings (round-to-nearest-even, no flush-to-zero) these
+ * produce the correctly rounded results that the emulation reproduces in
+ * software. Only the add, multiply, convert and compare opcodes are used;
+ * divsd and sqrtsd have an operand-dependent latency on many x86-64 cores,
+ * so division and square root use the integer emulation above.
+ */
+
+inline static __m128d falcon_fpr_load(falcon_fpr x)
+{
+	return _mm_castsi128_pd(_mm_cvtsi64_si128((int64_t)x));
+}
+
+inline static falcon_fpr falcon_fpr_store(__m128d v)
+{
+	return (falcon_fpr)_mm_cvtsi128_si64(_mm_castpd_si128(v));
+}
+
+inline static falcon_fpr falcon_fpr_neg(falcon_fpr x)
+{
+	x ^= 1ULL << 63;
+
+	return x;
+}
+
+inline static falcon_fpr falcon_fpr_half(falcon_fpr x)
+{
+	return falcon_fpr_store(_mm_mul_sd(falcon_fpr_load(x), _mm_set_sd(0.5)));
+}
+
+inline static int64_t falcon_fpr_rint(falcon_fpr x)
+{
+	/*
+	 * The cvtsd2si opcode rounds with the current MXCSR mode, which is
+	 * round-to-nearest-even, and is constant-time, unlike llrint().
+	 */
+	return _mm_cvtsd_si64(falcon_fpr_load(x));
+}
+
+inline static int64_t falcon_fpr_floor(falcon_fpr x)
+{
+	__m128d v;
+	int64_t r;
+
+	/*
+	 * The truncating conversion rounds toward zero and is thus wrong by
+	 * one for negative non-integral values; the correction is taken from
+	 * a comparison mask rather than a branch.
+	 */
+	v = falcon_fpr_load(x);
+	r = _mm_cvttsd_si64(v);
+
+	return r + (int64_t)_mm_cvtsi128_si64(_mm_castpd_si128(_mm_cmplt_sd(v, _mm_cvtsi64_sd(v, r))));
+}
+
+inline static int64_t falcon_fpr_trunc(falcon_fpr x)
+{
+	return _mm_cvttsd_si64(falcon_fpr_load(x));
+}
+
+inline static int32_t falcon_fpr_lt(falcon_fpr x, falcon_fpr y)
+{
+	return _mm_comilt_sd(falcon_fpr_load(x), falcon_fpr_load(y));
+}
+
+inline static falcon_fpr falcon_fpr_of(int64_t i)
+{
+	return falcon_fpr_store(_mm_cvtsi64_sd(_mm_setzero_pd(), i));
+}
+
+inline static falcon_fpr falcon_fpr_add(falcon_fpr x, falcon_fpr y)
+{
+	return falcon_fpr_store(_mm_add_sd(falcon_fpr_load(x), falcon_fpr_load(y)));
+}
+
+inline static falcon_fpr falcon_fpr_sub(falcon_fpr x, falcon_fpr y)
+{
+	return falcon_fpr_store(_mm_sub_sd(falcon_fpr_load(x), falcon_fpr_load(y)));
+}
+
+inline static falcon_fpr falcon_fpr_mul(falcon_fpr x, falcon_fpr y)
+{
+	return falcon_fpr_store(_mm_mul_sd(falcon_fpr_load(x), falcon_fpr_load(y)));
+}
+
+inline static falcon_fpr falcon_fpr_sqr(falcon_fpr x)
+{
+	__m128d v;
+
+	v = falcon_fpr_load(x);
+
+	return falcon_fpr_store(_mm_mul_sd(v, v));
+}
+
+inline static falcon_fpr falcon_fpr_inv(falcon_fpr x)
+{
+	return falcon_fpr_div(falcon_fpr_one, x);
+}
+
+#else
+
+static uint64_t falcon_fpr_ursh(uint64_t x, int32_t n)
+{
+	/*
+	* Right-shift a 64-bit uint32_t value by a possibly secret shift count.
+	* We assumed that the underlying architecture had a barrel shifter for
+	* 32-bit shifts, but for 64-bit shifts on a 32-bit system, this will
+	* typically invoke a software routine that is not necessarily
+	* constant-time; hence the function below.
+	*
+	* Shift count n MUST be in the 0..63 range.
+	*/
+
+	x ^= (x ^ (x >> 32)) & (uint64_t)-(int64_t)(n >> 5);
+
+	return x >> (n & 31);
+}
+
+static int64_t falcon_fpr_irsh(int64_t x, int32_t n)
+{
+	/*
+	 * Right-shift a 64-bit signed value by a possibly secret shift count
+	 * (see falcon_fpr_ursh() for the rationale).
+	 *
+	 * Shift count n MUST be in the 0..63 range.
+	 */
+
+	x ^= (x ^ (x >> 32)) & -(int64_t)(n >> 5);
+
+	return x >> (n & 31);
+}
+
+static uint64_t falcon_fpr_ulsh(uint64_t x, int32_t n)
+{
+	/*
+	* Left-shift a 64-bit uint32_t value by a possibly secret shift count
+	* (see falcon_fpr_ursh() for the rationale).
+	*
+	* Shift count n MUST be in the 0..63 range.
+	*/
+
+	x ^= (x ^ (x << 32)) & (uint64_t)-(int64_t)(n >> 5);
+
+	return x << (n & 31);
+}
+
 static falcon_fpr falcon_fpr_neg(falcon_fpr x)
 {
 	x ^= 1ULL << 63;
@@ -555,247 +848,67 @@ static falcon_fpr falcon_fpr_add(falcon_fpr x, falcon_fpr y)
 	 * product is in the 2^104..2^106-1 range. We first reassemble
 	 * it and round it into the 2^54..2^56-1 range; the bottom bit
 	 * is made "sticky". Since the low limbs z0 and z1 are 25 bits
-	 * each, we just take the upper part (zu), and consider z0 and
-	 * z1 only for purposes of stickiness.
-	 * (This is the reason why we chose 25-bit limbs above.)
-	 */
-	zu |= ((z0 | z1) + 0x01FFFFFFUL) >> 25;
-
-	/*
-	 * We normalize zu to the 2^54..s^55-1 range: it could be one
-	 * bit too large at this point. This is done with a conditional
-	 * right-shift that takes into account the sticky bit.
-	 */
-	zv = (zu >> 1) | (zu & 1);
-	w = zu >> 55;
-	zu ^= (zu ^ zv) & (uint64_t)-(int64_t)w;
-
-	/*
-	 * Get the aggregate scaling factor:
-	 *
-	 *   - Each exponent is biased by 1023.
-	 *
-	 *   - Integral mantissas are scaled by 2^52, hence an
-	 *     extra 52 bias for each exponent.
-	 *
-	 *   - However, we right-shifted z by 50 bits, and then
-	 *     by 0 or 1 extra bit (depending on the value of w).
-	 *
-	 * In total, we must add the exponents, then subtract
-	 * 2 * (1023 + 52), then add 50 + w.
-	 */
-	ex = (int32_t)((x >> 52) & 0x000007FFUL);
-	ey = (int32_t)((y >> 52) & 0x000007FFUL);
-	e = ex + ey - 2100 + (int32_t)w;
-
-	/*
-	 * Sign bit is the XOR of the operand sign bits.
-	 */
-	s = (int32_t)((x ^ y) >> 63);
-
-	/*
-	 * Corrective actions for zeros: if either of the operands is
-	 * zero, then the computations above were wrong. Test for zero
-	 * is whether ex or ey is zero. We just have to set the mantissa
-	 * (zu) to zero, the falcon_FPR() function will normalize e.
-	 */
-	d = ((ex + 0x000007FFL) & (ey + 0x000007FFL)) >> 11;
-	zu &= (uint64_t)-(int64_t)d;
-
-	/*
-	 * falcon_FPR() packs the result and applies proper rounding.
-	 */
-	return falcon_FPR(s, e, zu);
-}
-
-static falcon_fpr falcon_fpr_div(falcon_fpr x, falcon_fpr y)
-{
-	uint64_t xu;
-	uint64_t yu;
-	uint64_t q;
-	uint64_t q2;
-	uint64_t w;
-	int32_t i;
-	int32_t ex;
-	int32_t ey;
-	int32_t e;
-	int32_t d;
-	int32_t s;
-
-	/*
-	 * Extract mantissas of x and y (uint32_t).
-	 */
-	xu = (x & ((1ULL << 52) - 1)) | (1ULL << 52);
-	yu = (y & ((1ULL << 52) - 1)) | (1ULL << 52);
-
-	/*
-	 * Perform bit-by-bit division of xu by yu. We run it for 55 bits.
-	 */
-	q = 0;
-
-	for (i = 0; i < 55; ++i)
-	{
-		/*
-		 * If yu is less than or equal xu, then subtract it and
-		 * push a 1 in the quotient; otherwise, leave xu unchanged
-		 * and push a 0.
-		 */
-		uint64_t b;
-
-		b = ((xu - yu) >> 63) - 1;
-		xu -= b & yu;
-		q |= b & 1;
-		xu <<= 1;
-		q <<= 1;
-	}
-
-	/*
-	 * We got 55 bits in the quotient, followed by an extra zero. We
-	 * want that 56th bit to be "sticky": it should be a 1 if and
-	 * only if the remainder (xu) is non-zero.
-	 */
-	q |= (xu | (uint64_t)-(int64_t)xu) >> 63;
-
-	/*
-	 * Quotient is at most 2^56-1. Its top bit may be zero, but in
-	 * that case the next-to-top bit will be a one, since the
-	 * initial xu and yu were both in the 2^52..2^53-1 range.
-	 * We perform a conditional shift to normalize q to the
-	 * 2^54..2^55-1 range (with the bottom bit being sticky).
-	 */
-	q2 = (q >> 1) | (q & 1);
-	w = q >> 55;
-	q ^= (q ^ q2) & (uint64_t)-(int64_t)w;
-
-	/*
-	 * Extract exponents to compute the scaling factor:
-	 *
-	 *   - Each exponent is biased and we scaled them up by
-	 *     52 bits; but these biases will cancel out.
-	 *
-	 *   - The division loop produced a 55-bit shifted result,
-	 *     so we must scale it down by 55 bits.
-	 *
-	 *   - If w = 1, we right-shifted the integer by 1 bit,
-	 *     hence we must add 1 to the scaling.
-	 */
-	ex = (int32_t)((x >> 52) & 0x000007FFL);
-	ey = (int32_t)((y >> 52) & 0x000007FFL);
-	e = ex - ey - 55 + (int32_t)w;
-
-	/*
-	 * Sign is the XOR of the signs of the operands.
-	 */
-	s = (int32_t)((x ^ y) >> 63);
-
-	/*
-	 * Corrective actions for zeros: if x = 0, then the computation
-	 * is wrong, and we must clamp e and q to 0. We do not care
-	 * about the case y = 0 (as per assumptions in this module,
-	 * the caller does not perform divisions by zero).
-	 */
-	d = (ex + 0x000007FFL) >> 11;
-	s &= d;
-	e &= -d;
-	q &= (uint64_t)-(int64_t)d;
-
-	/*
-	 * falcon_FPR() packs the result and applies proper rounding.
-	 */
-	return falcon_FPR(s, e, q);
-}
-
-static falcon_fpr falcon_fpr_inv(falcon_fpr x)
-{
-	return falcon_fpr_div(4607182418800017408ULL, x);
-}
-
-static falcon_fpr falcon_fpr_sqr(falcon_fpr x)
-{
-	return falcon_fpr_mul(x, x);
-}
-
-static falcon_fpr falcon_fpr_sqrt(falcon_fpr x)
-{
-	uint64_t xu;
-	uint64_t q;
-	uint64_t s;
-	uint64_t r;
-	int32_t ex;
-	int32_t e;
-
-	/*
-	 * Extract the mantissa and the exponent. We don't care about
-	 * the sign: by assumption, the operand is nonnegative.
-	 * We want the "true" exponent corresponding to a mantissa
-	 * in the 1..2 range.
-	 */
-	xu = (x & ((1ULL << 52) - 1)) | (1ULL << 52);
-	ex = (int32_t)((x >> 52) & 0x000007FFL);
-	e = ex - 1023;
-
-	/*
-	 * If the exponent is odd, double the mantissa and decrement
-	 * the exponent. The exponent is then halved to account for
-	 * the square root.
+	 * each, we just take the upper part (zu), and consider z0 and
+	 * z1 only for purposes of stickiness.
+	 * (This is the reason why we chose 25-bit limbs above.)
 	 */
-	xu += xu & (uint64_t)-(int64_t)(e & 1);
-	e >>= 1;
+	zu |= ((z0 | z1) + 0x01FFFFFFUL) >> 25;
 
 	/*
-	 * Double the mantissa.
+	 * We normalize zu to the 2^54..s^55-1 range: it could be one
+	 * bit too large at this point. This is done with a conditional
+	 * right-shift that takes into account the sticky bit.
 	 */
-	xu <<= 1;
+	zv = (zu >> 1) | (zu & 1);
+	w = zu >> 55;
+	zu ^= (zu ^ zv) & (uint64_t)-(int64_t)w;
 
 	/*
-	 * We now have a mantissa in the 2^53..2^55-1 range. It
-	 * represents a value between 1 (inclusive) and 4 (exclusive)
-	 * in fixed point notation (with 53 fractional bits). We
-	 * compute the square root bit by bit.
+	 * Get the aggregate scaling factor:
+	 *
+	 *   - Each exponent is biased by 1023.
+	 *
+	 *   - Integral mantissas are scaled by 2^52, hence an
+	 *     extra 52 bias for each exponent.
+	 *
+	 *   - However, we right-shifted z by 50 bits, and then
+	 *     by 0 or 1 extra bit (depending on the value of w).
+	 *
+	 * In total, we must add the exponents, then subtract
+	 * 2 * (1023 + 52), then add 50 + w.
 	 */
-	q = 0;
-	s = 0;
-	r = 1ULL << 53;
-
-	for (int32_t i = 0; i < 54; ++i)
-	{
-		uint64_t b;
-		uint64_t t;
-
-		t = s + r;
-		b = ((xu - t) >> 63) - 1;
-		s += (r << 1) & b;
-		xu -= t & b;
-		q += r & b;
-		xu <<= 1;
-		r >>= 1;
-	}
+	ex = (int32_t)((x >> 52) & 0x000007FFUL);
+	ey = (int32_t)((y >> 52) & 0x000007FFUL);
+	e = ex + ey - 2100 + (int32_t)w;
 
 	/*
-	 * Now, q is a rounded-low 54-bit value, with a leading 1,
-	 * 52 fractional digits, and an additional guard bit. We add
-	 * an extra sticky bit to account for what remains of the operand.
+	 * Sign bit is the XOR of the operand sign bits.
 	 */
-	q <<= 1;
-	q |= (xu | (uint64_t)-(int64_t)xu) >> 63;
+	s = (int32_t)((x ^ y) >> 63);
 
 	/*
-	 * Result q is in the 2^54..2^55-1 range; we bias the exponent
-	 * by 54 bits (the value e at that point contains the "true"
-	 * exponent, but q is now considered an integer, i.e. scaled
-	 * up.
+	 * Corrective actions for zeros: if either of the operands is
+	 * zero, then the computations above were wrong. Test for zero
+	 * is whether ex or ey is zero. We just have to set the mantissa
+	 * (zu) to zero, the falcon_FPR() function will normalize e.
 	 */
-	e -= 54;
+	d = ((ex + 0x000007FFL) & (ey + 0x000007FFL)) >> 11;
+	zu &= (uint64_t)-(int64_t)d;
 
 	/*
-	 * Corrective action for an operand of value zero.
+	 * falcon_FPR() packs the result and applies proper rounding.
 	 */
-	q &= (uint64_t)-(int64_t)((ex + 0x000007FFL) >> 11);
+	return falcon_FPR(s, e, zu);
+}
 
-	/*
-	 * Apply rounding and back result.
-	 */
-	return falcon_FPR(0, e, q);
+static falcon_fpr falcon_fpr_inv(falcon_fpr x)
+{
+	return falcon_fpr_div(4607182418800017408ULL, x);
+}
+
+static falcon_fpr falcon_fpr_sqr(falcon_fpr x)
+{
+	return falcon_fpr_mul(x, x);
 }
 
 static falcon_fpr falcon_fpr_sub(falcon_fpr x, falcon_fpr y)
@@ -805,6 +918,8 @@ static falcon_fpr falcon_fpr_sub(falcon_fpr x, falcon_fpr y)
 	return falcon_fpr_add(x, y);
 }
 
+#endif
+
 static uint64_t falcon_fpr_expm_p63(falcon_fpr x, falcon_fpr ccs)
 {
 	/*
@@ -7841,8 +7956,6 @@ static void falcon_keygen(qsc_keccak_state* kctx, int8_t* f, int8_t* g, int8_t*
 
 /* sign.c */
 
-#if defined(FALCON_HISTORICAL_ENABLE)
-
 static void falcon_poly_LDLmv_fft(falcon_fpr* restrict d11, falcon_fpr* restrict l10, const falcon_fpr* restrict g00, const falcon_fpr* restrict g01, const falcon_fpr* restrict g11, uint32_t logn)
 {
 	size_t hn;
@@ -7964,238 +8077,107 @@ static void falcon_ffLDL_fft_inner(falcon_fpr* restrict tree, falcon_fpr* restri
 	 * quasicyclic matrix for the next recursive step.
 	 */
 	falcon_ffLDL_fft_inner(tree + n, g1, g1 + hn, logn - 1, tmp);
-	falcon_ffLDL_fft_inner(tree + n + falcon_ffLDL_treesize(logn - 1), g0, g0 + hn, logn - 1, tmp);
-}
-
-static void falcon_ffLDL_fft(falcon_fpr* restrict tree, const falcon_fpr* restrict g00, const falcon_fpr* restrict g01, const falcon_fpr* restrict g11, uint32_t logn, falcon_fpr* restrict tmp)
-{
-	/*
-	 * Compute the ffLDL tree of an auto-adjoint matrix G. The matrix
-	 * is provided as three polynomials (FFT representation).
-	 *
-	 * The "tree" array is filled with the computed tree, of size
-	 * (logn+1)*(2^logn) elements (see falcon_ffLDL_treesize()).
-	 *
-	 * Input arrays MUST NOT overlap, except possibly the three unmodified
-	 * arrays g00, g01 and g11. tmp[] should have room for at least three
-	 * polynomials of 2^logn elements each.
-	 */
-
-	falcon_fpr* d00;
-	falcon_fpr* d11;
-	size_t hn;
-	size_t n;
-
-	n = falcon_mkn(logn);
-
-	if (n == 1)
-	{
-		tree[0] = g00[0];
-		return;
-	}
-
-	hn = n >> 1;
-	d00 = tmp;
-	d11 = tmp + n;
-	tmp += n << 1;
-
-	qsc_memutils_copy(d00, g00, n * sizeof(*g00));
-	falcon_poly_LDLmv_fft(d11, tree, g00, g01, g11, logn);
-
-	falcon_poly_split_fft(tmp, tmp + hn, d00, logn);
-	falcon_poly_split_fft(d00, d00 + hn, d11, logn);
-	qsc_memutils_copy(d11, tmp, n * sizeof(*tmp));
-	falcon_ffLDL_fft_inner(tree + n, d11, d11 + hn, logn - 1, tmp);
-	falcon_ffLDL_fft_inner(tree + n + falcon_ffLDL_treesize(logn - 1), d00, d00 + hn, logn - 1, tmp);
-}
-
-static void falcon_ffLDL_binary_normalize(falcon_fpr* tree, uint32_t orig_logn, uint32_t logn)
-{
-	/*
-	* Normalize an ffLDL tree: each leaf of value x is replaced with
-	* sigma / sqrt(x).
-	*/
-
-	size_t n;
-
-	n = falcon_mkn(logn);
-	if (n == 1)
-	{
-		/*
-		 * We actually store in the tree leaf the inverse of
-		 * the value mandated by the specification: this
-		 * saves a division both here and in the sampler.
-		 */
-		tree[0] = falcon_fpr_mul(falcon_fpr_sqrt(tree[0]), falcon_fpr_inv_sigma[orig_logn]);
-	}
-	else
-	{
-		falcon_ffLDL_binary_normalize(tree + n, orig_logn, logn - 1);
-		falcon_ffLDL_binary_normalize(tree + n + falcon_ffLDL_treesize(logn - 1), orig_logn, logn - 1);
-	}
-}
-
-static void falcon_prng_get_bytes(falcon_prng_state* pctx, void* dst, size_t len)
-{
-	uint8_t* buf;
-
-	buf = dst;
-
-	while (len > 0)
-	{
-		size_t clen;
-
-		clen = sizeof(pctx->buf) - pctx->ptr;
-
-		if (clen > len)
-		{
-			clen = len;
-		}
-
-		qsc_memutils_copy(buf, pctx->buf, clen);
-		buf += clen;
-		len -= clen;
-		pctx->ptr += clen;
-
-		if (pctx->ptr == sizeof(pctx->buf))
-		{
-			falcon_prng_refill(pctx);
-		}
-	}
-}
-
-static int32_t falcon_do_sign_tree(falcon_samplerZ samp, void* samp_ctx, int16_t* s2, const falcon_fpr* restrict expanded_key,
-	const uint16_t* hm, uint32_t logn, falcon_fpr* restrict tmp)
-{
-	/*
-	* Compute a signature: the signature contains two vectors, s1 and s2.
-	* The s1 vector is not returned. The squared norm of (s1,s2) is
-	* computed, and if it is short enough, then s2 is returned into the
-	* s2[] buffer, and 1 is returned; otherwise, s2[] is untouched and 0 is
-	* returned; the caller should then try again. This function uses an
-	* expanded key.
-	*
-	* tmp[] must have room for at least six polynomials.
-	*/
-
-	const falcon_fpr* b00;
-	const falcon_fpr* b01;
-	const falcon_fpr* b10;
-	const falcon_fpr* b11;
-	const falcon_fpr* tree;
-	falcon_fpr* t0;
-	falcon_fpr* t1;
-	falcon_fpr* tx;
-	falcon_fpr* ty;
-	falcon_fpr ni;
-	size_t n;
-	size_t u;
-	uint32_t sqn;
-	uint32_t ng;
-	int16_t* s1tmp;
-	int16_t* s2tmp;
-
-	n = falcon_mkn(logn);
-	t0 = tmp;
-	t1 = t0 + n;
-	b00 = expanded_key + falcon_skoff_b00(logn);
-	b01 = expanded_key + falcon_skoff_b01(logn);
-	b10 = expanded_key + falcon_skoff_b10(logn);
-	b11 = expanded_key + falcon_skoff_b11(logn);
-	tree = expanded_key + falcon_skoff_tree(logn);
-
-	/*
-	 * Set the target vector to [hm, 0] (hm is the hashed message).
-	 */
-	for (u = 0; u < n; ++u)
-	{
-		t0[u] = falcon_fpr_of(hm[u]);
-	}
-
-	/*
-	 * Apply the lattice basis to obtain the real target
-	 * vector (after normalization with regards to modulus).
-	 */
-	falcon_FFT(t0, logn);
-	ni = falcon_fpr_inverse_of_q;
-	qsc_memutils_copy(t1, t0, n * sizeof(*t0));
-	falcon_poly_mul_fft(t1, b01, logn);
-	falcon_poly_mulconst(t1, falcon_fpr_neg(ni), logn);
-	falcon_poly_mul_fft(t0, b11, logn);
-	falcon_poly_mulconst(t0, ni, logn);
-
-	tx = t1 + n;
-	ty = tx + n;
-
-	/*
-	 * Apply sampling. Output is written back in [tx, ty].
-	 */
-	falcon_ffSampling_fft(samp, samp_ctx, tx, ty, tree, t0, t1, logn, ty + n);
+	falcon_ffLDL_fft_inner(tree + n + falcon_ffLDL_treesize(logn - 1), g0, g0 + hn, logn - 1, tmp);
+}
 
+static void falcon_ffLDL_fft(falcon_fpr* restrict tree, const falcon_fpr* restrict g00, const falcon_fpr* restrict g01, const falcon_fpr* restrict g11, uint32_t logn, falcon_fpr* restrict tmp)
+{
 	/*
-	 * Get the lattice point corresponding to that tiny vector.
+	 * Compute the ffLDL tree of an auto-adjoint matrix G. The matrix
+	 * is provided as three polynomials (FFT representation).
+	 *
+	 * The "tree" array is filled with the computed tree, of size
+	 * (logn+1)*(2^logn) elements (see falcon_ffLDL_treesize()).
+	 *
+	 * Input arrays MUST NOT overlap, except possibly the three unmodified
+	 * arrays g00, g01 and g11. tmp[] should have room for at least three
+	 * polynomials of 2^logn elements each.
 	 */
-	qsc_memutils_copy(t0, tx, n * sizeof(*tx));
-	qsc_memutils_copy(t1, ty, n * sizeof(*ty));
-	falcon_poly_mul_fft(tx, b00, logn);
-	falcon_poly_mul_fft(ty, b10, logn);
-	falcon_poly_add(tx, ty, logn);
-	qsc_memutils_copy(ty, t0, n * sizeof(*t0));
-	falcon_poly_mul_fft(ty, b01, logn);
-
-	qsc_memutils_copy(t0, tx, n * sizeof(*tx));
-	falcon_poly_mul_fft(t1, b11, logn);
-	falcon_poly_add(t1, ty, logn);
 
-	falcon_iFFT(t0, logn);
-	falcon_iFFT(t1, logn);
+	falcon_fpr* d00;
+	falcon_fpr* d11;
+	size_t hn;
+	size_t n;
 
-	/*
-	 * Compute the signature.
-	 */
-	s1tmp = (int16_t*)tx;
-	sqn = 0;
-	ng = 0;
+	n = falcon_mkn(logn);
 
-	for (u = 0; u < n; ++u)
+	if (n == 1)
 	{
-		int32_t z;
-
-		z = (int32_t)hm[u] - (int32_t)falcon_fpr_rint(t0[u]);
-		sqn += (uint32_t)(z * z);
-		ng |= sqn;
-		s1tmp[u] = (int16_t)z;
+		tree[0] = g00[0];
+		return;
 	}
 
-	sqn |= (uint32_t)-(int32_t)(ng >> 31);
+	hn = n >> 1;
+	d00 = tmp;
+	d11 = tmp + n;
+	tmp += n << 1;
+
+	qsc_memutils_copy(d00, g00, n * sizeof(*g00));
+	falcon_poly_LDLmv_fft(d11, tree, g00, g01, g11, logn);
 
+	falcon_poly_split_fft(tmp, tmp + hn, d00, logn);
+	falcon_poly_split_fft(d00, d00 + hn, d11, logn);
+	qsc_memutils_copy(d11, tmp, n * sizeof(*tmp));
+	falcon_ffLDL_fft_inner(tree + n, d11, d11 + hn, logn - 1, tmp);
+	falcon_ffLDL_fft_inner(tree + n + falcon_ffLDL_treesize(logn - 1), d00, d00 + hn, logn - 1, tmp);
+}
+
+static void falcon_ffLDL_binary_normalize(falcon_fpr* tree, uint32_t orig_logn, uint32_t logn)
+{
 	/*
-	 * With "normal" degrees (e.g. 512 or 1024), it is very
-	 * improbable that the computed vector is not short enough
-	 * however, it may happen in practice for the very reduced
-	 * versions (e.g. degree 16 or below). In that case, the caller
-	 * will loop, and we must not write anything into s2[] because
-	 * s2[] may overlap with the hashed message hm[] and we need
-	 * hm[] for the next iteration.
-	 */
-	s2tmp = (int16_t *)tmp;
+	* Normalize an ffLDL tree: each leaf of value x is replaced with
+	* sigma / sqrt(x).
+	*/
 
-	for (u = 0; u < n; ++u)
+	size_t n;
+
+	n = falcon_mkn(logn);
+	if (n == 1)
 	{
-		s2tmp[u] = (int16_t)-falcon_fpr_rint(t1[u]);
+		/*
+		 * We actually store in the tree leaf the inverse of
+		 * the value mandated by the specification: this
+		 * saves a division both here and in the sampler.
+		 */
+		tree[0] = falcon_fpr_mul(falcon_fpr_sqrt(tree[0]), falcon_fpr_inv_sigma[orig_logn]);
+	}
+	else
+	{
+		falcon_ffLDL_binary_normalize(tree + n, orig_logn, logn - 1);
+		falcon_ffLDL_binary_normalize(tree + n + falcon_ffLDL_treesize(logn - 1), orig_logn, logn - 1);
 	}
+}
 
-	if (falcon_is_short_half(sqn, s2tmp, logn) != 0)
+#if defined(FALCON_HISTORICAL_ENABLE)
+static void falcon_prng_get_bytes(falcon_prng_state* pctx, void* dst, size_t len)
+{
+	uint8_t* buf;
+
+	buf = dst;
+
+	while (len > 0)
 	{
-		qsc_memutils_copy(s2, s2tmp, n * sizeof(*s2));
-		qsc_memutils_copy(tmp, s1tmp, n * sizeof(*s1tmp));
+		size_t clen;
 
-		return 1;
-	}
+		clen = sizeof(pctx->buf) - pctx->ptr;
 
-	return 0;
-}
+		if (clen > len)
+		{
+			clen = len;
+		}
+
+		qsc_memutils_copy(buf, pctx->buf, clen);
+		buf += clen;
+		len -= clen;
+		pctx->ptr += clen;
 
+		if (pctx->ptr == sizeof(pctx->buf))
+		{
+			falcon_prng_refill(pctx);
+		}
+	}
+}
+#endif
 
 static void falcon_ffSampling_fft(falcon_samplerZ samp, void* samp_ctx, falcon_fpr* restrict z0, falcon_fpr* restrict z1, const falcon_fpr* restrict tree,
 	const falcon_fpr* restrict t0, const falcon_fpr* restrict t1, uint32_t logn, falcon_fpr* restrict tmp)
@@ -8432,7 +8414,137 @@ static void falcon_ffSampling_fft(falcon_samplerZ samp, void* samp_ctx, falcon_f
 	falcon_poly_merge_fft(z0, tmp, tmp + hn, logn);
 }
 
-#endif
+static int32_t falcon_do_sign_tree(falcon_samplerZ samp, void* samp_ctx, int16_t* s2, const falcon_fpr* restrict expanded_key,
+	const uint16_t* hm, uint32_t logn, falcon_fpr* restrict tmp)
+{
+	/*
+	* Compute a signature: the signature contains two vectors, s1 and s2.
+	* The s1 vector is not returned. The squared norm of (s1,s2) is
+	* computed, and if it is short enough, then s2 is returned into the
+	* s2[] buffer, and 1 is returned; otherwise, s2[] is untouched and 0 is
+	* returned; the caller should then try again. This function uses an
+	* expanded key.
+	*
+	* tmp[] must have room for at least six polynomials.
+	*/
+
+	const falcon_fpr* b00;
+	const falcon_fpr* b01;
+	const falcon_fpr* b10;
+	const falcon_fpr* b11;
+	const falcon_fpr* tree;
+	falcon_fpr* t0;
+	falcon_fpr* t1;
+	falcon_fpr* tx;
+	falcon_fpr* ty;
+	falcon_fpr ni;
+	size_t n;
+	size_t u;
+	uint32_t sqn;
+	uint32_t ng;
+	int16_t* s1tmp;
+	int16_t* s2tmp;
+
+	n = falcon_mkn(logn);
+	t0 = tmp;
+	t1 = t0 + n;
+	b00 = expanded_key + falcon_skoff_b00(logn);
+	b01 = expanded_key + falcon_skoff_b01(logn);
+	b10 = expanded_key + falcon_skoff_b10(logn);
+	b11 = expanded_key + falcon_skoff_b11(logn);
+	tree = expanded_key + falcon_skoff_tree(logn);
+
+	/*
+	 * Set the target vector to [hm, 0] (hm is the hashed message).
+	 */
+	for (u = 0; u < n; ++u)
+	{
+		t0[u] = falcon_fpr_of(hm[u]);
+	}
+
+	/*
+	 * Apply the lattice basis to obtain the real target
+	 * vector (after normalization with regards to modulus).
+	 */
+	falcon_FFT(t0, logn);
+	ni = falcon_fpr_inverse_of_q;
+	qsc_memutils_copy(t1, t0, n * sizeof(*t0));
+	falcon_poly_mul_fft(t1, b01, logn);
+	falcon_poly_mulconst(t1, falcon_fpr_neg(ni), logn);
+	falcon_poly_mul_fft(t0, b11, logn);
+	falcon_poly_mulconst(t0, ni, logn);
+
+	tx = t1 + n;
+	ty = tx + n;
+
+	/*
+	 * Apply sampling. Output is written back in [tx, ty].
+	 */
+	falcon_ffSampling_fft(samp, samp_ctx, tx, ty, tree, t0, t1, logn, ty + n);
+
+	/*
+	 * Get the lattice point corresponding to that tiny vector.
+	 */
+	qsc_memutils_copy(t0, tx, n * sizeof(*tx));
+	qsc_memutils_copy(t1, ty, n * sizeof(*ty));
+	falcon_poly_mul_fft(tx, b00, logn);
+	falcon_poly_mul_fft(ty, b10, logn);
+	falcon_poly_add(tx, ty, logn);
+	qsc_memutils_copy(ty, t0, n * sizeof(*t0));
+	falcon_poly_mul_fft(ty, b01, logn);
+
+	qsc_memutils_copy(t0, tx, n * sizeof(*tx));
+	falcon_poly_mul_fft(t1, b11, logn);
+	falcon_poly_add(t1, ty, logn);
+
+	falcon_iFFT(t0, logn);
+	falcon_iFFT(t1, logn);
+
+	/*
+	 * Compute the signature.
+	 */
+	s1tmp = (int16_t*)tx;
+	sqn = 0;
+	ng = 0;
+
+	for (u = 0; u < n; ++u)
+	{
+		int32_t z;
+
+		z = (int32_t)hm[u] - (int32_t)falcon_fpr_rint(t0[u]);
+		sqn += (uint32_t)(z * z);
+		ng |= sqn;
+		s1tmp[u] = (int16_t)z;
+	}
+
+	sqn |= (uint32_t)-(int32_t)(ng >> 31);
+
+	/*
+	 * With "normal" degrees (e.g. 512 or 1024), it is very
+	 * improbable that the computed vector is not short enough
+	 * however, it may happen in practice for the very reduced
+	 * versions (e.g. degree 16 or below). In that case, the caller
+	 * will loop, and we must not write anything into s2[] because
+	 * s2[] may overlap with the hashed message hm[] and we need
+	 * hm[] for the next iteration.
+	 */
+	s2tmp = (int16_t *)tmp;
+
+	for (u = 0; u < n; ++u)
+	{
+		s2tmp[u] = (int16_t)-falcon_fpr_rint(t1[u]);
+	}
+
+	if (falcon_is_short_half(sqn, s2tmp, logn) != 0)
+	{
+		qsc_memutils_copy(s2, s2tmp, n * sizeof(*s2));
+		qsc_memutils_copy(tmp, s1tmp, n * sizeof(*s1tmp));
+
+		return 1;
+	}
+
+	return 0;
+}
 
 static void falcon_smallints_to_fpr(falcon_fpr* r, const int8_t* t, uint32_t logn)
 {
@@ -9030,6 +9142,169 @@ static void falcon_sign_dyn(int16_t* sig, qsc_keccak_state* kctx, const int8_t*
 	}
 }
 
+static int32_t falcon_decode_privatekey(int8_t* f, int8_t* g, int8_t* F, int8_t* G, const uint8_t* sk, uint32_t logn, uint8_t* tmp)
+{
+	/*
+	* Decode the private key (f, g, F) and recompute G.
+	* Returns 0 on success, or -1 if the key is malformed.
+	* tmp[] must have room for at least 72*2^logn bytes.
+	*/
+
+	size_t u;
+	size_t v;
+
+	if (sk[0] != 0x50 + logn)
+	{
+		return -1;
+	}
+
+	u = 1;
+	v = falcon_trim_i8_decode(f, logn, falcon_max_fg_bits[logn], sk + u, FALCON_CRYPTO_SECRETKEYBYTES - u);
+
+	if (v == 0)
+	{
+		return -1;
+	}
+
+	u += v;
+	v = falcon_trim_i8_decode(g, logn, falcon_max_fg_bits[logn], sk + u, FALCON_CRYPTO_SECRETKEYBYTES - u);
+
+	if (v == 0)
+	{
+		return -1;
+	}
+
+	u += v;
+	v = falcon_trim_i8_decode(F, logn, falcon_max_FG_bits[logn], sk + u, FALCON_CRYPTO_SECRETKEYBYTES - u);
+
+	if (v == 0)
+	{
+		return -1;
+	}
+
+	u += v;
+
+	if (u != FALCON_CRYPTO_SECRETKEYBYTES)
+	{
+		return -1;
+	}
+
+	if (!falcon_complete_private(G, f, g, F, logn, tmp))
+	{
+		return -1;
+	}
+
+	return 0;
+}
+
+static void falcon_expand_privkey(falcon_fpr* restrict expanded_key, const int8_t* f, const int8_t* g,
+	const int8_t* F, const int8_t* G, uint32_t logn, uint8_t* restrict tmp)
+{
+	/*
+	* Expand a private key into the lattice basis B0 = [[g, -f], [G, -F]]
+	* in FFT representation, followed by the normalized LDL tree of the
+	* Gram matrix. The expanded key has (8*logn+40)*2^logn bytes, and
+	* tmp[] must have room for at least 48*2^logn bytes.
+	*/
+
+	falcon_fpr* b00;
+	falcon_fpr* b01;
+	falcon_fpr* b10;
+	falcon_fpr* b11;
+	falcon_fpr* g00;
+	falcon_fpr* g01;
+	falcon_fpr* g11;
+	falcon_fpr* gxx;
+	falcon_fpr* tree;
+	size_t n;
+
+	n = falcon_mkn(logn);
+	b00 = expanded_key + falcon_skoff_b00(logn);
+	b01 = expanded_key + falcon_skoff_b01(logn);
+	b10 = expanded_key + falcon_skoff_b10(logn);
+	b11 = expanded_key + falcon_skoff_b11(logn);
+	tree = expanded_key + falcon_skoff_tree(logn);
+
+	/*
+	 * The private key elements are loaded directly into B0,
+	 * then converted to FFT, and f and F are negated.
+	 */
+	falcon_smallints_to_fpr(b01, f, logn);
+	falcon_smallints_to_fpr(b00, g, logn);
+	falcon_smallints_to_fpr(b11, F, logn);
+	falcon_smallints_to_fpr(b10, G, logn);
+	falcon_FFT(b01, logn);
+	falcon_FFT(b00, logn);
+	falcon_FFT(b11, logn);
+	falcon_FFT(b10, logn);
+	falcon_poly_neg(b01, logn);
+	falcon_poly_neg(b11, logn);
+
+	/*
+	 * Compute the Gram matrix G = B0*adj(B0), upper triangle only:
+	 *   g00 = b00*adj(b00) + b01*adj(b01)
+	 *   g01 = b00*adj(b10) + b01*adj(b11)
+	 *   g11 = b10*adj(b10) + b11*adj(b11)
+	 */
+	g00 = (falcon_fpr*)tmp;
+	g01 = g00 + n;
+	g11 = g01 + n;
+	gxx = g11 + n;
+
+	qsc_memutils_copy(g00, b00, n * sizeof(*b00));
+	falcon_poly_mulselfadj_fft(g00, logn);
+	qsc_memutils_copy(gxx, b01, n * sizeof(*b01));
+	falcon_poly_mulselfadj_fft(gxx, logn);
+	falcon_poly_add(g00, gxx, logn);
+
+	qsc_memutils_copy(g01, b00, n * sizeof(*b00));
+	falcon_poly_muladj_fft(g01, b10, logn);
+	qsc_memutils_copy(gxx, b01, n * sizeof(*b01));
+	falcon_poly_muladj_fft(gxx, b11, logn);
+	falcon_poly_add(g01, gxx, logn);
+
+	qsc_memutils_copy(g11, b10, n * sizeof(*b10));
+	falcon_poly_mulselfadj_fft(g11, logn);
+	qsc_memutils_copy(gxx, b11, n * sizeof(*b11));
+	falcon_poly_mulselfadj_fft(gxx, logn);
+	falcon_poly_add(g11, gxx, logn);
+
+	/*
+	 * Compute the LDL tree, and normalize its leaves with regards to sigma.
+	 */
+	falcon_ffLDL_fft(tree, g00, g01, g11, logn, gxx);
+	falcon_ffLDL_binary_normalize(tree, logn, logn);
+}
+
+static void falcon_sign_tree(int16_t* sig, qsc_keccak_state* kctx, const falcon_fpr* restrict expanded_key,
+	const uint16_t* hm, uint32_t logn, uint8_t* tmp)
+{
+	falcon_fpr* ftmp;
+
+	ftmp = (falcon_fpr*)tmp;
+
+	for (;;)
+	{
+		/*
+		 * Same loop as falcon_sign_dyn(), but the basis and the LDL tree
+		 * are read from the expanded key instead of being rebuilt.
+		 */
+		falcon_sampler_context spc = { 0 };
+		falcon_samplerZ samp;
+		void *samp_ctx;
+
+		spc.sigma_min = falcon_fpr_sigma_min[logn];
+		falcon_prng_init(&spc.p, kctx);
+		samp = falcon_sampler;
+		samp_ctx = &spc;
+
+		if (falcon_do_sign_tree(samp, samp_ctx, sig, expanded_key, hm, logn, ftmp) != 0)
+		{
+			break;
+		}
+	}
+}
+
 #if defined(QSC_FALCON_S3SHAKE256F512)
 
 int32_t qsc_falcon_ref_generate_keypair(uint8_t* pk, uint8_t* sk, bool (*rng_generate)(uint8_t*, size_t))
@@ -9102,21 +9377,20 @@ int32_t qsc_falcon_ref_generate_keypair(uint8_t* pk, uint8_t* sk, bool (*rng_gen
 	return 0;
 }
 
-int32_t qsc_falcon_ref_sign(uint8_t *sm, size_t *smlen, const uint8_t *m, size_t mlen, const uint8_t *sk, bool (*rng_generate)(uint8_t*, size_t))
+int32_t qsc_falcon_ref_sign_hashed(uint8_t *sig, size_t *siglen, qsc_keccak_state *hctx, const uint8_t *nonce, const uint8_t *sk, bool (*rng_generate)(uint8_t*, size_t))
 {
-	int16_t sig[512];
+	int16_t s2[512];
 	uint8_t b[72 * 512];
 	int8_t f[512];
 	int8_t g[512];
 	int8_t F[512];
 	int8_t G[512];
 	uint8_t seed[48];
-	uint8_t nonce[FALCON_NONCE_SIZE];
-	uint8_t esig[FALCON_CRYPTO_SIGNATURE_BYTES - 2 - sizeof(nonce)];
+	uint8_t esig[FALCON_CRYPTO_SIGNATURE_BYTES - 2 - FALCON_NONCE_SIZE];
 	qsc_keccak_state kctx;
 	size_t u;
 	size_t v;
-	size_t siglen;
+	size_t elen;
 
 	/*
 	 * Decode the private key.
@@ -9145,36 +9419,213 @@ int32_t qsc_falcon_ref_sign(uint8_t *sm, size_t *smlen, const uint8_t *m, size_t
 	u += v;
 	v = falcon_trim_i8_decode(F, 9, falcon_max_FG_bits[9], sk + u, FALCON_CRYPTO_SECRETKEYBYTES - u);
 
-	if (v == 0)
-	{
-		return -1;
-	}
+	if (v == 0)
+	{
+		return -1;
+	}
+
+	u += v;
+
+	if (u != FALCON_CRYPTO_SECRETKEYBYTES)
+	{
+		return -1;
+	}
+
+	if (!falcon_complete_private(G, f, g, F, 9, b))
+	{
+		return -1;
+	}
+
+	/*
+	 * The hash state has absorbed nonce + message; hash it into a vector.
+	 */
+	qsc_keccak_incremental_finalize(hctx, QSC_KECCAK_256_RATE, QSC_KECCAK_SHAKE_DOMAIN_ID);
+	falcon_hash_to_point_vartime(hctx, (uint16_t*)s2, 9);
+
+	/*
+	 * Initialize a RNG.
+	 */
+	rng_generate(seed, sizeof(seed));
+	qsc_keccak_initialize_state(&kctx);
+	qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, seed, sizeof(seed));
+	qsc_keccak_incremental_finalize(&kctx, QSC_KECCAK_256_RATE, QSC_KECCAK_SHAKE_DOMAIN_ID);
+
+
+	/*
+	 * Compute the signature.
+	 */
+	falcon_sign_dyn(s2, &kctx, f, g, F, G, (uint16_t*)s2, 9, b);
+
+
+	/*
+	 * Encode the detached signature. Format is:
+	 *   signature length     2 bytes, big-endian
+	 *   nonce                40 bytes
+	 *   signature            slen bytes
+	 */
+	esig[0] = 0x20 + 9;
+	elen = falcon_comp_encode(esig + 1, (sizeof(esig)) - 1, s2, 9);
+
+	if (elen == 0)
+	{
+		return -1;
+	}
+
+	elen++;
+	sig[0] = (uint8_t)(elen >> 8);
+	sig[1] = (uint8_t)elen;
+	qsc_memutils_copy(sig + 2, nonce, FALCON_NONCE_SIZE);
+	qsc_memutils_copy(sig + 2 + FALCON_NONCE_SIZE, esig, elen);
+	*siglen = 2 + FALCON_NONCE_SIZE + elen;
+
+	return 0;
+}
+
+int32_t qsc_falcon_ref_sign_signature(uint8_t *sig, size_t *siglen, const uint8_t *m, size_t mlen, const uint8_t *sk, bool (*rng_generate)(uint8_t*, size_t))
+{
+	uint8_t nonce[FALCON_NONCE_SIZE];
+	qsc_keccak_state kctx;
+
+	/*
+	 * Create a random nonce (40 bytes), and absorb nonce + message.
+	 */
+	rng_generate(nonce, sizeof(nonce));
+	qsc_keccak_initialize_state(&kctx);
+	qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, nonce, sizeof(nonce));
+	qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, m, mlen);
+
+	return qsc_falcon_ref_sign_hashed(sig, siglen, &kctx, nonce, sk, rng_generate);
+}
+
+bool qsc_falcon_ref_verify_hashed(const uint8_t *sig, size_t siglen, qsc_keccak_state *hctx, const uint8_t *pk)
+{
+	uint16_t h[512];
+	uint16_t hm[512];
+	int16_t s2[512];
+	uint8_t b[2 * 512];
+	const uint8_t* esig;
+	size_t elen;
+
+	/*
+	 * Decode public key.
+	 */
+	if (pk[0] != 0x00 + 9)
+	{
+		return false;
+	}
+
+	if (falcon_modq_decode(h, 9, pk + 1, FALCON_CRYPTO_PUBLICKEY_BYTES - 1) != FALCON_CRYPTO_PUBLICKEY_BYTES - 1)
+	{
+		return false;
+	}
+
+	falcon_to_ntt_monty(h, 9);
+
+	/*
+	 * Find nonce and signature length.
+	 */
+	if (siglen < 2 + FALCON_NONCE_SIZE)
+	{
+		return false;
+	}
+
+	elen = ((size_t)sig[0] << 8) | (size_t)sig[1];
+
+	if (elen != siglen - 2 - FALCON_NONCE_SIZE)
+	{
+		return false;
+	}
+
+	/*
+	 * Decode signature.
+	 */
+	esig = sig + 2 + FALCON_NONCE_SIZE;
+
+	if (elen < 1 || esig[0] != 0x20 + 9)
+	{
+		return false;
+	}
+
+	if (falcon_comp_decode(s2, 9, esig + 1, elen - 1) != elen - 1)
+	{
+		return false;
+	}
+
+	/*
+	 * The hash state has absorbed nonce + message; hash it into a vector.
+	 */
+	qsc_keccak_incremental_finalize(hctx, QSC_KECCAK_256_RATE, QSC_KECCAK_SHAKE_DOMAIN_ID);
+	falcon_hash_to_point_vartime(hctx, hm, 9);
+
+	/*
+	 * Verify signature.
+	 */
+	if (!falcon_verify_raw(hm, s2, h, 9, b))
+	{
+		return false;
+	}
+
+	return true;
+}
+
+bool qsc_falcon_ref_verify(const uint8_t *sig, size_t siglen, const uint8_t *m, size_t mlen, const uint8_t *pk)
+{
+	qsc_keccak_state kctx;
+
+	if (siglen < 2 + FALCON_NONCE_SIZE)
+	{
+		return false;
+	}
+
+	/*
+	 * Absorb nonce + message.
+	 */
+	qsc_keccak_initialize_state(&kctx);
+	qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, sig + 2, FALCON_NONCE_SIZE);
+	qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, m, mlen);
+
+	return qsc_falcon_ref_verify_hashed(sig, siglen, &kctx, pk);
+}
+
+int32_t qsc_falcon_ref_expand_privatekey(qsc_falcon_expanded_privatekey* esk, const uint8_t* sk)
+{
+	uint8_t b[72 * 512];
+	int8_t f[512];
+	int8_t g[512];
+	int8_t F[512];
+	int8_t G[512];
+	int32_t res;
 
-	u += v;
+	res = falcon_decode_privatekey(f, g, F, G, sk, 9, b);
 
-	if (u != FALCON_CRYPTO_SECRETKEYBYTES)
+	if (res == 0)
 	{
-		return -1;
+		falcon_expand_privkey((falcon_fpr*)esk->key, f, g, F, G, 9, b);
 	}
 
-	if (!falcon_complete_private(G, f, g, F, 9, b))
-	{
-		return -1;
-	}
+	qsc_memutils_clear(b, sizeof(b));
+	qsc_memutils_clear((uint8_t*)f, sizeof(f));
+	qsc_memutils_clear((uint8_t*)g, sizeof(g));
+	qsc_memutils_clear((uint8_t*)F, sizeof(F));
+	qsc_memutils_clear((uint8_t*)G, sizeof(G));
 
-	/*
-	 * Create a random nonce (40 bytes).
-	 */
-	rng_generate(nonce, sizeof(nonce));
+	return res;
+}
+
+int32_t qsc_falcon_ref_sign_hashed_expanded(uint8_t* sig, size_t* siglen, qsc_keccak_state* hctx, const uint8_t* nonce, const qsc_falcon_expanded_privatekey* esk, bool (*rng_generate)(uint8_t*, size_t))
+{
+	int16_t s2[512];
+	uint8_t b[48 * 512];
+	uint8_t seed[48];
+	uint8_t esig[FALCON_CRYPTO_SIGNATURE_BYTES - 2 - FALCON_NONCE_SIZE];
+	qsc_keccak_state kctx;
+	size_t elen;
 
 	/*
-	 * Hash message nonce + message into a vector.
+	 * The hash state has absorbed nonce + message; hash it into a vector.
 	 */
-	qsc_keccak_initialize_state(&kctx);
-	qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, nonce, sizeof(nonce));
-	qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, m, mlen);
-	qsc_keccak_incremental_finalize(&kctx, QSC_KECCAK_256_RATE, QSC_KECCAK_SHAKE_DOMAIN_ID);
-	falcon_hash_to_point_vartime(&kctx, (uint16_t*)sig, 9);
+	qsc_keccak_incremental_finalize(hctx, QSC_KECCAK_256_RATE, QSC_KECCAK_SHAKE_DOMAIN_ID);
+	falcon_hash_to_point_vartime(hctx, (uint16_t*)s2, 9);
 
 	/*
 	 * Initialize a RNG.
@@ -9184,64 +9635,98 @@ int32_t qsc_falcon_ref_sign(uint8_t *sm, size_t *smlen, const uint8_t *m, size_t
 	qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, seed, sizeof(seed));
 	qsc_keccak_incremental_finalize(&kctx, QSC_KECCAK_256_RATE, QSC_KECCAK_SHAKE_DOMAIN_ID);
 
-
 	/*
-	 * Compute the signature.
+	 * Compute the signature with the expanded key.
 	 */
-	falcon_sign_dyn(sig, &kctx, f, g, F, G, (uint16_t*)sig, 9, b);
-
+	falcon_sign_tree(s2, &kctx, (const falcon_fpr*)esk->key, (uint16_t*)s2, 9, b);
 
 	/*
-	 * Encode the signature and bundle it with the message. Format is:
+	 * Encode the detached signature. Format is:
 	 *   signature length     2 bytes, big-endian
 	 *   nonce                40 bytes
-	 *   message              mlen bytes
 	 *   signature            slen bytes
 	 */
 	esig[0] = 0x20 + 9;
-	siglen = falcon_comp_encode(esig + 1, (sizeof(esig)) - 1, sig, 9);
+	elen = falcon_comp_encode(esig + 1, (sizeof(esig)) - 1, s2, 9);
 
-	if (siglen == 0)
+	if (elen == 0)
 	{
 		return -1;
 	}
 
-	siglen++;
-	qsc_memutils_move(sm + 2 + sizeof(nonce), m, mlen);
-	sm[0] = (uint8_t)(siglen >> 8);
-	sm[1] = (uint8_t)siglen;
-	qsc_memutils_copy(sm + 2, nonce, sizeof(nonce));
-	qsc_memutils_copy(sm + 2 + sizeof(nonce) + mlen, esig, siglen);
-	*smlen = 2 + sizeof(nonce) + mlen + siglen;
+	elen++;
+	sig[0] = (uint8_t)(elen >> 8);
+	sig[1] = (uint8_t)elen;
+	qsc_memutils_copy(sig + 2, nonce, FALCON_NONCE_SIZE);
+	qsc_memutils_copy(sig + 2 + FALCON_NONCE_SIZE, esig, elen);
+	*siglen = 2 + FALCON_NONCE_SIZE + elen;
 
 	return 0;
 }
 
-bool qsc_falcon_ref_open(uint8_t *m, size_t *mlen, const uint8_t *sm, size_t smlen, const uint8_t *pk)
+int32_t qsc_falcon_ref_sign_signature_expanded(uint8_t* sig, size_t* siglen, const uint8_t* m, size_t mlen, const qsc_falcon_expanded_privatekey* esk, bool (*rng_generate)(uint8_t*, size_t))
 {
-	uint16_t h[512];
-	uint16_t hm[512];
-	int16_t sig[512];
-	uint8_t b[2 * 512];
-	const uint8_t* esig;
+	uint8_t nonce[FALCON_NONCE_SIZE];
 	qsc_keccak_state kctx;
-	size_t msglen;
+
+	rng_generate(nonce, sizeof(nonce));
+	qsc_keccak_initialize_state(&kctx);
+	qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, nonce, sizeof(nonce));
+	qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, m, mlen);
+
+	return qsc_falcon_ref_sign_hashed_expanded(sig, siglen, &kctx, nonce, esk, rng_generate);
+}
+
+int32_t qsc_falcon_ref_sign_expanded(uint8_t* sm, size_t* smlen, const uint8_t* m, size_t mlen, const qsc_falcon_expanded_privatekey* esk, bool (*rng_generate)(uint8_t*, size_t))
+{
+	uint8_t sig[FALCON_CRYPTO_SIGNATURE_BYTES];
 	size_t siglen;
+	int32_t res;
 
-	/*
-	 * Decode public key.
-	 */
-	if (pk[0] != 0x00 + 9)
+	res = qsc_falcon_ref_sign_signature_expanded(sig, &siglen, m, mlen, esk, rng_generate);
+
+	if (res == 0)
 	{
-		return false;
+		qsc_memutils_move(sm + 2 + FALCON_NONCE_SIZE, m, mlen);
+		qsc_memutils_copy(sm, sig, 2 + FALCON_NONCE_SIZE);
+		qsc_memutils_copy(sm + 2 + FALCON_NONCE_SIZE + mlen, sig + 2 + FALCON_NONCE_SIZE, siglen - 2 - FALCON_NONCE_SIZE);
+		*smlen = siglen + mlen;
 	}
 
-	if (falcon_modq_decode(h, 9, pk + 1, FALCON_CRYPTO_PUBLICKEY_BYTES - 1) != FALCON_CRYPTO_PUBLICKEY_BYTES - 1)
+	return res;
+}
+
+int32_t qsc_falcon_ref_sign(uint8_t *sm, size_t *smlen, const uint8_t *m, size_t mlen, const uint8_t *sk, bool (*rng_generate)(uint8_t*, size_t))
+{
+	uint8_t sig[FALCON_CRYPTO_SIGNATURE_BYTES];
+	size_t siglen;
+	int32_t res;
+
+	/*
+	 * Sign the message, then bundle the signature with the message. Format is:
+	 *   signature length     2 bytes, big-endian
+	 *   nonce                40 bytes
+	 *   message              mlen bytes
+	 *   signature            slen bytes
+	 */
+	res = qsc_falcon_ref_sign_signature(sig, &siglen, m, mlen, sk, rng_generate);
+
+	if (res == 0)
 	{
-		return false;
+		qsc_memutils_move(sm + 2 + FALCON_NONCE_SIZE, m, mlen);
+		qsc_memutils_copy(sm, sig, 2 + FALCON_NONCE_SIZE);
+		qsc_memutils_copy(sm + 2 + FALCON_NONCE_SIZE + mlen, sig + 2 + FALCON_NONCE_SIZE, siglen - 2 - FALCON_NONCE_SIZE);
+		*smlen = siglen + mlen;
 	}
 
-	falcon_to_ntt_monty(h, 9);
+	return res;
+}
+
+bool qsc_falcon_ref_open(uint8_t *m, size_t *mlen, const uint8_t *sm, size_t smlen, const uint8_t *pk)
+{
+	uint8_t sig[FALCON_CRYPTO_SIGNATURE_BYTES];
+	size_t msglen;
+	size_t siglen;
 
 	/*
 	 * Find nonce, signature, message length.
@@ -9253,7 +9738,7 @@ bool qsc_falcon_ref_open(uint8_t *m, size_t *mlen, const uint8_t *sm, size_t sml
 
 	siglen = ((size_t)sm[0] << 8) | (size_t)sm[1];
 
-	if (siglen > (smlen - 2 - FALCON_NONCE_SIZE))
+	if (siglen > (smlen - 2 - FALCON_NONCE_SIZE) || siglen > (sizeof(sig) - 2 - FALCON_NONCE_SIZE))
 	{
 		return false;
 	}
@@ -9261,32 +9746,12 @@ bool qsc_falcon_ref_open(uint8_t *m, size_t *mlen, const uint8_t *sm, size_t sml
 	msglen = smlen - 2 - FALCON_NONCE_SIZE - siglen;
 
 	/*
-	 * Decode signature.
-	 */
-	esig = sm + 2 + FALCON_NONCE_SIZE + msglen;
-
-	if (siglen < 1 || esig[0] != 0x20 + 9)
-	{
-		return false;
-	}
-
-	if (falcon_comp_decode(sig, 9, esig + 1, siglen - 1) != siglen - 1)
-	{
-		return false;
-	}
-
-	/*
-	 * Hash nonce + message into a vector.
+	 * Reassemble the detached signature and verify it against the message in place.
 	 */
-	qsc_keccak_initialize_state(&kctx);
-	qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, sm + 2, FALCON_NONCE_SIZE + msglen);
-	qsc_keccak_incremental_finalize(&kctx, QSC_KECCAK_256_RATE, QSC_KECCAK_SHAKE_DOMAIN_ID);
-	falcon_hash_to_point_vartime(&kctx, hm, 9);
+	qsc_memutils_copy(sig, sm, 2 + FALCON_NONCE_SIZE);
+	qsc_memutils_copy(sig + 2 + FALCON_NONCE_SIZE, sm + 2 + FALCON_NONCE_SIZE + msglen, siglen);
 
-	/*
-	 * Verify signature.
-	 */
-	if (!falcon_verify_raw(hm, sig, h, 9, b))
+	if (!qsc_falcon_ref_verify(sig, 2 + FALCON_NONCE_SIZE + siglen, sm + 2 + FALCON_NONCE_SIZE, msglen, pk))
 	{
 		return false;
 	}
@@ -9374,21 +9839,20 @@ int32_t qsc_falcon_ref_generate_keypair(uint8_t* pk, uint8_t* sk, bool (*rng_gen
 	return 0;
 }
 
-int32_t qsc_falcon_ref_sign(uint8_t* sm, size_t* smlen, const uint8_t* m, size_t mlen, const uint8_t* sk, bool (*rng_generate)(uint8_t*, size_t))
+int32_t qsc_falcon_ref_sign_hashed(uint8_t* sig, size_t* siglen, qsc_keccak_state* hctx, const uint8_t* nonce, const uint8_t* sk, bool (*rng_generate)(uint8_t*, size_t))
 {
-	int16_t sig[1024] = { 0 };
+	int16_t s2[1024] = { 0 };
 	uint8_t b[72 * 1024];
 	int8_t f[1024];
 	int8_t g[1024];
 	int8_t F[1024];
 	int8_t G[1024];
 	uint8_t seed[48];
-	uint8_t nonce[FALCON_NONCE_SIZE];
-	uint8_t esig[FALCON_CRYPTO_SIGNATURE_BYTES - 2 - sizeof(nonce)] = { 0 };
+	uint8_t esig[FALCON_CRYPTO_SIGNATURE_BYTES - 2 - FALCON_NONCE_SIZE] = { 0 };
 	qsc_keccak_state kctx;
 	size_t u;
 	size_t v;
-	size_t siglen;
+	size_t elen;
 
 	/*
 	 * Decode the private key.
@@ -9435,18 +9899,10 @@ int32_t qsc_falcon_ref_sign(uint8_t* sm, size_t* smlen, const uint8_t* m, size_t
 	}
 
 	/*
-	 * Create a random nonce (40 bytes).
-	 */
-	rng_generate(nonce, sizeof(nonce));
-
-	/*
-	 * Hash message nonce + message into a vector.
+	 * The hash state has absorbed nonce + message; hash it into a vector.
 	 */
-	qsc_keccak_initialize_state(&kctx);
-	qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, nonce, sizeof(nonce));
-	qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, m, mlen);
-	qsc_keccak_incremental_finalize(&kctx, QSC_KECCAK_256_RATE, QSC_KECCAK_SHAKE_DOMAIN_ID);
-	falcon_hash_to_point_vartime(&kctx, (uint16_t*)sig, 10);
+	qsc_keccak_incremental_finalize(hctx, QSC_KECCAK_256_RATE, QSC_KECCAK_SHAKE_DOMAIN_ID);
+	falcon_hash_to_point_vartime(hctx, (uint16_t*)s2, 10);
 
 	/*
 	 * Initialize a RNG.
@@ -9459,44 +9915,56 @@ int32_t qsc_falcon_ref_sign(uint8_t* sm, size_t* smlen, const uint8_t* m, size_t
 	/*
 	 * Compute the signature.
 	 */
-	falcon_sign_dyn(sig, &kctx, f, g, F, G, (uint16_t*)sig, 10, b);
+	falcon_sign_dyn(s2, &kctx, f, g, F, G, (uint16_t*)s2, 10, b);
 
 	/*
-	 * Encode the signature and bundle it with the message. Format is:
+	 * Encode the detached signature. Format is:
 	 *   signature length     2 bytes, big-endian
 	 *   nonce                40 bytes
-	 *   message              mlen bytes
 	 *   signature            slen bytes
 	 */
 	esig[0] = 0x20 + 10;
-	siglen = falcon_comp_encode(esig + 1, sizeof(esig) - 1, sig, 10);
+	elen = falcon_comp_encode(esig + 1, sizeof(esig) - 1, s2, 10);
 
-	if (siglen == 0)
+	if (elen == 0)
 	{
 		return -1;
 	}
 
-	siglen++;
-	qsc_memutils_move(sm + 2 + sizeof(nonce), m, mlen);
-	sm[0] = (uint8_t)(siglen >> 8);
-	sm[1] = (uint8_t)siglen;
-	qsc_memutils_copy(sm + 2, nonce, sizeof(nonce));
-	qsc_memutils_copy(sm + 2 + sizeof(nonce) + mlen, esig, siglen);
-	*smlen = 2 + sizeof(nonce) + mlen + siglen;
+	elen++;
+	sig[0] = (uint8_t)(elen >> 8);
+	sig[1] = (uint8_t)elen;
+	qsc_memutils_copy(sig + 2, nonce, FALCON_NONCE_SIZE);
+	qsc_memutils_copy(sig + 2 + FALCON_NONCE_SIZE, esig, elen);
+	*siglen = 2 + FALCON_NONCE_SIZE + elen;
 
 	return 0;
 }
 
-bool qsc_falcon_ref_open(uint8_t* m, size_t* mlen, const uint8_t* sm, size_t smlen, const uint8_t* pk)
+int32_t qsc_falcon_ref_sign_signature(uint8_t* sig, size_t* siglen, const uint8_t* m, size_t mlen, const uint8_t* sk, bool (*rng_generate)(uint8_t*, size_t))
+{
+	uint8_t nonce[FALCON_NONCE_SIZE];
+	qsc_keccak_state kctx;
+
+	/*
+	 * Create a random nonce (40 bytes), and absorb nonce + message.
+	 */
+	rng_generate(nonce, sizeof(nonce));
+	qsc_keccak_initialize_state(&kctx);
+	qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, nonce, sizeof(nonce));
+	qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, m, mlen);
+
+	return qsc_falcon_ref_sign_hashed(sig, siglen, &kctx, nonce, sk, rng_generate);
+}
+
+bool qsc_falcon_ref_verify_hashed(const uint8_t* sig, size_t siglen, qsc_keccak_state* hctx, const uint8_t* pk)
 {
 	uint16_t h[1024];
 	uint16_t hm[1024];
-	int16_t sig[1024];
+	int16_t s2[1024];
 	uint8_t b[2 * 1024];
 	const uint8_t* esig;
-	qsc_keccak_state kctx;
-	size_t siglen;
-	size_t msglen;
+	size_t elen;
 
 	/*
 	 * Decode public key.
@@ -9514,49 +9982,236 @@ bool qsc_falcon_ref_open(uint8_t* m, size_t* mlen, const uint8_t* sm, size_t sml
 	falcon_to_ntt_monty(h, 10);
 
 	/*
-	 * Find nonce, signature, message length.
+	 * Find nonce and signature length.
 	 */
-	if (smlen < 2 + FALCON_NONCE_SIZE)
+	if (siglen < 2 + FALCON_NONCE_SIZE)
 	{
 		return false;
 	}
 
-	siglen = ((size_t)sm[0] << 8) | (size_t)sm[1];
+	elen = ((size_t)sig[0] << 8) | (size_t)sig[1];
 
-	if (siglen > (smlen - 2 - FALCON_NONCE_SIZE))
+	if (elen != siglen - 2 - FALCON_NONCE_SIZE)
 	{
 		return false;
 	}
 
-	msglen = smlen - 2 - FALCON_NONCE_SIZE - siglen;
-
 	/*
 	 * Decode signature.
 	 */
-	esig = sm + 2 + FALCON_NONCE_SIZE + msglen;
+	esig = sig + 2 + FALCON_NONCE_SIZE;
 
-	if (siglen < 1 || esig[0] != 0x20 + 10)
+	if (elen < 1 || esig[0] != 0x20 + 10)
 	{
 		return false;
 	}
 
-	if (falcon_comp_decode(sig, 10, esig + 1, siglen - 1) != siglen - 1)
+	if (falcon_comp_decode(s2, 10, esig + 1, elen - 1) != elen - 1)
 	{
 		return false;
 	}
 
 	/*
-	 * Hash nonce + message into a vector.
+	 * The hash state has absorbed nonce + message; hash it into a vector.
 	 */
+	qsc_keccak_incremental_finalize(hctx, QSC_KECCAK_256_RATE, QSC_KECCAK_SHAKE_DOMAIN_ID);
+	falcon_hash_to_point_vartime(hctx, hm, 10);
+
+	/*
+	 * Verify signature.
+	 */
+	if (falcon_verify_raw(hm, s2, h, 10, b) == 0)
+	{
+		return false;
+	}
+
+	return true;
+}
+
+bool qsc_falcon_ref_verify(const uint8_t* sig, size_t siglen, const uint8_t* m, size_t mlen, const uint8_t* pk)
+{
+	qsc_keccak_state kctx;
+
+	if (siglen < 2 + FALCON_NONCE_SIZE)
+	{
+		return false;
+	}
+
+	/*
+	 * Absorb nonce + message.
+	 */
+	qsc_keccak_initialize_state(&kctx);
+	qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, sig + 2, FALCON_NONCE_SIZE);
+	qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, m, mlen);
+
+	return qsc_falcon_ref_verify_hashed(sig, siglen, &kctx, pk);
+}
+
+int32_t qsc_falcon_ref_expand_privatekey(qsc_falcon_expanded_privatekey* esk, const uint8_t* sk)
+{
+	uint8_t b[72 * 1024];
+	int8_t f[1024];
+	int8_t g[1024];
+	int8_t F[1024];
+	int8_t G[1024];
+	int32_t res;
+
+	res = falcon_decode_privatekey(f, g, F, G, sk, 10, b);
+
+	if (res == 0)
+	{
+		falcon_expand_privkey((falcon_fpr*)esk->key, f, g, F, G, 10, b);
+	}
+
+	qsc_memutils_clear(b, sizeof(b));
+	qsc_memutils_clear((uint8_t*)f, sizeof(f));
+	qsc_memutils_clear((uint8_t*)g, sizeof(g));
+	qsc_memutils_clear((uint8_t*)F, sizeof(F));
+	qsc_memutils_clear((uint8_t*)G, sizeof(G));
+
+	return res;
+}
+
+int32_t qsc_falcon_ref_sign_hashed_expanded(uint8_t* sig, size_t* siglen, qsc_keccak_state* hctx, const uint8_t* nonce, const qsc_falcon_expanded_privatekey* esk, bool (*rng_generate)(uint8_t*, size_t))
+{
+	int16_t s2[1024];
+	uint8_t b[48 * 1024];
+	uint8_t seed[48];
+	uint8_t esig[FALCON_CRYPTO_SIGNATURE_BYTES - 2 - FALCON_NONCE_SIZE];
+	qsc_keccak_state kctx;
+	size_t elen;
+
+	/*
+	 * The hash state has absorbed nonce + message; hash it into a vector.
+	 */
+	qsc_keccak_incremental_finalize(hctx, QSC_KECCAK_256_RATE, QSC_KECCAK_SHAKE_DOMAIN_ID);
+	falcon_hash_to_point_vartime(hctx, (uint16_t*)s2, 10);
+
+	/*
+	 * Initialize a RNG.
+	 */
+	rng_generate(seed, sizeof(seed));
 	qsc_keccak_initialize_state(&kctx);
-	qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, sm + 2, FALCON_NONCE_SIZE + msglen);
+	qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, seed, sizeof(seed));
 	qsc_keccak_incremental_finalize(&kctx, QSC_KECCAK_256_RATE, QSC_KECCAK_SHAKE_DOMAIN_ID);
-	falcon_hash_to_point_vartime(&kctx, hm, 10);
 
 	/*
-	 * Verify signature.
+	 * Compute the signature with the expanded key.
+	 */
+	falcon_sign_tree(s2, &kctx, (const falcon_fpr*)esk->key, (uint16_t*)s2, 10, b);
+
+	/*
+	 * Encode the detached signature. Format is:
+	 *   signature length     2 bytes, big-endian
+	 *   nonce                40 bytes
+	 *   signature            slen bytes
+	 */
+	esig[0] = 0x20 + 10;
+	elen = falcon_comp_encode(esig + 1, (sizeof(esig)) - 1, s2, 10);
+
+	if (elen == 0)
+	{
+		return -1;
+	}
+
+	elen++;
+	sig[0] = (uint8_t)(elen >> 8);
+	sig[1] = (uint8_t)elen;
+	qsc_memutils_copy(sig + 2, nonce, FALCON_NONCE_SIZE);
+	qsc_memutils_copy(sig + 2 + FALCON_NONCE_SIZE, esig, elen);
+	*siglen = 2 + FALCON_NONCE_SIZE + elen;
+
+	return 0;
+}
+
+int32_t qsc_falcon_ref_sign_signature_expanded(uint8_t* sig, size_t* siglen, const uint8_t* m, size_t mlen, const qsc_falcon_expanded_privatekey* esk, bool (*rng_generate)(uint8_t*, size_t))
+{
+	uint8_t nonce[FALCON_NONCE_SIZE];
+	qsc_keccak_state kctx;
+
+	rng_generate(nonce, sizeof(nonce));
+	qsc_keccak_initialize_state(&kctx);
+	qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, nonce, sizeof(nonce));
+	qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, m, mlen);
+
+	return qsc_falcon_ref_sign_hashed_expanded(sig, siglen, &kctx, nonce, esk, rng_generate);
+}
+
+int32_t qsc_falcon_ref_sign_expanded(uint8_t* sm, size_t* smlen, const uint8_t* m, size_t mlen, const qsc_falcon_expanded_privatekey* esk, bool (*rng_generate)(uint8_t*, size_t))
+{
+	uint8_t sig[FALCON_CRYPTO_SIGNATURE_BYTES];
+	size_t siglen;
+	int32_t res;
+
+	res = qsc_falcon_ref_sign_signature_expanded(sig, &siglen, m, mlen, esk, rng_generate);
+
+	if (res == 0)
+	{
+		qsc_memutils_move(sm + 2 + FALCON_NONCE_SIZE, m, mlen);
+		qsc_memutils_copy(sm, sig, 2 + FALCON_NONCE_SIZE);
+		qsc_memutils_copy(sm + 2 + FALCON_NONCE_SIZE + mlen, sig + 2 + FALCON_NONCE_SIZE, siglen - 2 - FALCON_NONCE_SIZE);
+		*smlen = siglen + mlen;
+	}
+
+	return res;
+}
+
+int32_t qsc_falcon_ref_sign(uint8_t* sm, size_t* smlen, const uint8_t* m, size_t mlen, const uint8_t* sk, bool (*rng_generate)(uint8_t*, size_t))
+{
+	uint8_t sig[FALCON_CRYPTO_SIGNATURE_BYTES];
+	size_t siglen;
+	int32_t res;
+
+	/*
+	 * Sign the message, then bundle the signature with the message. Format is:
+	 *   signature length     2 bytes, big-endian
+	 *   nonce                40 bytes
+	 *   message              mlen bytes
+	 *   signature            slen bytes
+	 */
+	res = qsc_falcon_ref_sign_signature(sig, &siglen, m, mlen, sk, rng_generate);
+
+	if (res == 0)
+	{
+		qsc_memutils_move(sm + 2 + FALCON_NONCE_SIZE, m, mlen);
+		qsc_memutils_copy(sm, sig, 2 + FALCON_NONCE_SIZE);
+		qsc_memutils_copy(sm + 2 + FALCON_NONCE_SIZE + mlen, sig + 2 + FALCON_NONCE_SIZE, siglen - 2 - FALCON_NONCE_SIZE);
+		*smlen = siglen + mlen;
+	}
+
+	return res;
+}
+
+bool qsc_falcon_ref_open(uint8_t* m, size_t* mlen, const uint8_t* sm, size_t smlen, const uint8_t* pk)
+{
+	uint8_t sig[FALCON_CRYPTO_SIGNATURE_BYTES];
+	size_t msglen;
+	size_t siglen;
+
+	/*
+	 * Find nonce, signature, message length.
 	 */
-	if (falcon_verify_raw(hm, sig, h, 10, b) == 0)
+	if (smlen < 2 + FALCON_NONCE_SIZE)
+	{
+		return false;
+	}
+
+	siglen = ((size_t)sm[0] << 8) | (size_t)sm[1];
+
+	if (siglen > (smlen - 2 - FALCON_NONCE_SIZE) || siglen > (sizeof(sig) - 2 - FALCON_NONCE_SIZE))
+	{
+		return false;
+	}
+
+	msglen = smlen - 2 - FALCON_NONCE_SIZE - siglen;
+
+	/*
+	 * Reassemble the detached signature and verify it against the message in place.
+	 */
+	qsc_memutils_copy(sig, sm, 2 + FALCON_NONCE_SIZE);
+	qsc_memutils_copy(sig + 2 + FALCON_NONCE_SIZE, sm + 2 + FALCON_NONCE_SIZE + msglen, siglen);
+
+	if (!qsc_falcon_ref_verify(sig, 2 + FALCON_NONCE_SIZE + siglen, sm + 2 + FALCON_NONCE_SIZE, msglen, pk))
 	{
 		return false;
 	}
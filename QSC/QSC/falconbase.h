@@ -25,9 +25,16 @@
 #define QSC_FALCONBASE_H
 
 #include "common.h"
+#include "falcon.h"
+#include "sha3.h"
 
 /* \cond DOXYGEN_IGNORE */
 
+#if defined(QSC_FALCON_FPR_NATIVE) && defined(QSC_SYSTEM_ARCH_IX86_64)
+#	include <emmintrin.h>
+#	define FALCON_FPR_NATIVE
+#endif
+
 /* api.h */
 
 #if defined(QSC_FALCON_S3SHAKE256F512)
@@ -279,6 +286,102 @@ int32_t qsc_falcon_ref_sign(uint8_t *sm, size_t *smlen, const uint8_t *m, size_t
 */
 bool qsc_falcon_ref_open(uint8_t *m, size_t *mlen, const uint8_t *sm, size_t smlen, const uint8_t *pk);
 
+/**
+* \brief Signs a message and returns the detached signature; the message is read in place and not copied.
+* The signature array must be sized to the maximum signature length.
+*
+* \param signature: The signature array
+* \param siglen: The signature length
+* \param message: The message to be signed
+* \param msglen: The message length
+* \param privatekey: The private signature key
+* \param rng_generate: The random generator
+*/
+int32_t qsc_falcon_ref_sign_signature(uint8_t *sig, size_t *siglen, const uint8_t *m, size_t mlen, const uint8_t *sk, bool (*rng_generate)(uint8_t*, size_t));
+
+/**
+* \brief Verifies a detached signature against a message with the public key.
+*
+* \param signature: The signature array
+* \param siglen: The signature length
+* \param message: The message that was signed
+* \param msglen: The message length
+* \param publickey: The public verification key
+* \return Returns true for success
+*/
+bool qsc_falcon_ref_verify(const uint8_t *sig, size_t siglen, const uint8_t *m, size_t mlen, const uint8_t *pk);
+
+/**
+* \brief Signs a message hash state and returns the detached signature.
+* The hash state must be initialized and have absorbed the nonce followed by the message.
+*
+* \param signature: The signature array
+* \param siglen: The signature length
+* \param hctx: The message hash state
+* \param nonce: The 40 byte nonce absorbed by the hash state
+* \param privatekey: The private signature key
+* \param rng_generate: The random generator
+*/
+int32_t qsc_falcon_ref_sign_hashed(uint8_t *sig, size_t *siglen, qsc_keccak_state *hctx, const uint8_t *nonce, const uint8_t *sk, bool (*rng_generate)(uint8_t*, size_t));
+
+/**
+* \brief Verifies a detached signature against a message hash state with the public key.
+* The hash state must be initialized and have absorbed the signature nonce followed by the message.
+*
+* \param signature: The signature array
+* \param siglen: The signature length
+* \param hctx: The message hash state
+* \param publickey: The public verification key
+* \return Returns true for success
+*/
+bool qsc_falcon_ref_verify_hashed(const uint8_t *sig, size_t siglen, qsc_keccak_state *hctx, const uint8_t *pk);
+
+/**
+* \brief Expands a private key into the FFT-domain lattice basis and the normalized LDL tree.
+*
+* \param esk: The expanded private key
+* \param sk: The private signature key
+* \return Returns 0 for success, or -1 if the private key is malformed
+*/
+int32_t qsc_falcon_ref_expand_privatekey(qsc_falcon_expanded_privatekey* esk, const uint8_t* sk);
+
+/**
+* \brief Signs a message hash state with an expanded private key and returns the detached signature.
+* The hash state must be initialized and have absorbed the nonce followed by the message.
+*
+* \param sig: The signature array
+* \param siglen: The signature length
+* \param hctx: The message hash state
+* \param nonce: The 40 byte nonce absorbed by the hash state
+* \param esk: The expanded private signature key
+* \param rng_generate: The random generator
+*/
+int32_t qsc_falcon_ref_sign_hashed_expanded(uint8_t* sig, size_t* siglen, qsc_keccak_state* hctx, const uint8_t* nonce, const qsc_falcon_expanded_privatekey* esk, bool (*rng_generate)(uint8_t*, size_t));
+
+/**
+* \brief Signs a message with an expanded private key and returns the detached signature.
+*
+* \param sig: The signature array
+* \param siglen: The signature length
+* \param m: The message to be signed
+* \param mlen: The message length
+* \param esk: The expanded private signature key
+* \param rng_generate: The random generator
+*/
+int32_t qsc_falcon_ref_sign_signature_expanded(uint8_t* sig, size_t* siglen, const uint8_t* m, size_t mlen, const qsc_falcon_expanded_privatekey* esk, bool (*rng_generate)(uint8_t*, size_t));
+
+/**
+* \brief Signs a message with an expanded private key and returns the signature followed by the message
+*
+* \param sm: The signed message
+* \param smlen: The signed message length
+* \param m: The message to be signed
+* \param mlen: The message length
+* \param esk: The expanded private signature key
+* \param rng_generate: The random generator
+*/
+int32_t qsc_falcon_ref_sign_expanded(uint8_t* sm, size_t* smlen, const uint8_t* m, size_t mlen, const qsc_falcon_expanded_privatekey* esk, bool (*rng_generate)(uint8_t*, size_t));
+
 /* \endcond DOXYGEN_IGNORE */
 
 #endif
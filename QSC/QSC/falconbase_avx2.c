@@ -4473,8 +4473,8 @@ static void falcon_zint_finish_mod(uint32_t* a, size_t len, const uint32_t* m, u
 	 * Word xm is a word of m (if neg = 0) or -m (if neg = 1)
 	 * but if neg = 0 and cc = 1, then ym = 0 and it forces mw to 0.
 	 */
-	xm = -(int32_t)neg >> 1;
-	ym = -(int32_t)(neg | (1 - cc));
+	xm = (uint32_t)-(int32_t)neg >> 1;
+	ym = (uint32_t)-(int32_t)(neg | (1 - cc));
 	cc = neg;
 
 	for (u = 0; u < len; ++u)
@@ -4909,7 +4909,7 @@ static void falcon_zint_add_scaled_mul_small(uint32_t* restrict x, size_t xlen,
 
 	if (ylen != 0)
 	{
-		ysign = -(int32_t)(y[ylen - 1] >> 30) >> 1;
+		ysign = (uint32_t)-(int32_t)(y[ylen - 1] >> 30) >> 1;
 		tw = 0;
 		cc = 0;
 
@@ -5710,7 +5710,7 @@ static int32_t falcon_solve_NTRU_deepest(uint32_t logn_top, const int8_t* f, con
 	const falcon_small_prime* primes;
 	int32_t res;
 
-	res = 1;
+	res = 0;
 	len = falcon_avx2_max_bl_small[logn_top];
 	primes = falcon_avx2_small_primes;
 
@@ -5748,9 +5748,9 @@ static int32_t falcon_solve_NTRU_deepest(uint32_t logn_top, const int8_t* f, con
 		 */
 		q = 12289;
 
-		if (falcon_zint_mul_small(Fp, len, q) != 0 || falcon_zint_mul_small(Gp, len, q) != 0)
+		if (falcon_zint_mul_small(Fp, len, q) == 0 && falcon_zint_mul_small(Gp, len, q) == 0)
 		{
-			res = 0;
+			res = 1;
 		}
 	}
 
@@ -7635,8 +7635,6 @@ static void falcon_ffSampling_fft_dyntree(falcon_samplerZ samp, void* samp_ctx,
 	falcon_poly_merge_fft(t0, z0, z0 + hn, logn);
 }
 
-#if defined(FALCON_HISTORICAL_ENABLE)
-
 static void falcon_poly_LDLmv_fft(falcon_fpr* restrict d11, falcon_fpr* restrict l10, const falcon_fpr* restrict g00, const falcon_fpr* restrict g01, const falcon_fpr* restrict g11, uint32_t logn)
 {
 	size_t n;
@@ -7993,6 +7991,7 @@ static void falcon_ffSampling_fft(falcon_samplerZ samp, void* samp_ctx, falcon_f
 	}
 }
 
+#if defined(FALCON_HISTORICAL_ENABLE)
 static void falcon_prng_get_bytes(falcon_prng_state* p, void* dst, size_t len)
 {
 	uint8_t *buf;
@@ -8077,6 +8076,7 @@ static void falcon_poly_div_fft(falcon_fpr* restrict a, const falcon_fpr* restri
 		}
 	}
 }
+#endif
 
 static void falcon_ffLDL_fft(falcon_fpr* restrict tree, const falcon_fpr* restrict g00, const falcon_fpr* restrict g01, const falcon_fpr* restrict g11, uint32_t logn, falcon_fpr* restrict tmp)
 {
@@ -8279,8 +8279,6 @@ static int32_t falcon_do_sign_tree(falcon_samplerZ samp, void* samp_ctx, int16_t
 	return 0;
 }
 
-#endif
-
 static int32_t falcon_do_sign_dyn(falcon_samplerZ samp, void* samp_ctx, int16_t* s2, const int8_t* restrict f, const int8_t* restrict g,
 	const int8_t* restrict F, const int8_t* restrict G, const uint16_t* hm, uint32_t logn, falcon_fpr* restrict tmp)
 {
@@ -8766,6 +8764,169 @@ static void falcon_sign_dyn(int16_t* sig, qsc_keccak_state* kctx, const int8_t*
 	}
 }
 
+static int32_t falcon_decode_privatekey(int8_t* f, int8_t* g, int8_t* F, int8_t* G, const uint8_t* sk, uint32_t logn, uint8_t* tmp)
+{
+	/*
+	* Decode the private key (f, g, F) and recompute G.
+	* Returns 0 on success, or -1 if the key is malformed.
+	* tmp[] must have room for at least 72*2^logn bytes.
+	*/
+
+	size_t u;
+	size_t v;
+
+	if (sk[0] != 0x50 + logn)
+	{
+		return -1;
+	}
+
+	u = 1;
+	v = falcon_trim_i8_decode(f, logn, falcon_avx2_max_fg_bits[logn], sk + u, CRYPTO_SECRETKEYBYTES - u);
+
+	if (v == 0)
+	{
+		return -1;
+	}
+
+	u += v;
+	v = falcon_trim_i8_decode(g, logn, falcon_avx2_max_fg_bits[logn], sk + u, CRYPTO_SECRETKEYBYTES - u);
+
+	if (v == 0)
+	{
+		return -1;
+	}
+
+	u += v;
+	v = falcon_trim_i8_decode(F, logn, falcon_falcon_max_FG_bits[logn], sk + u, CRYPTO_SECRETKEYBYTES - u);
+
+	if (v == 0)
+	{
+		return -1;
+	}
+
+	u += v;
+
+	if (u != CRYPTO_SECRETKEYBYTES)
+	{
+		return -1;
+	}
+
+	if (!falcon_complete_private(G, f, g, F, logn, tmp))
+	{
+		return -1;
+	}
+
+	return 0;
+}
+
+static void falcon_expand_privkey(falcon_fpr* restrict expanded_key, const int8_t* f, const int8_t* g,
+	const int8_t* F, const int8_t* G, uint32_t logn, uint8_t* restrict tmp)
+{
+	/*
+	* Expand a private key into the lattice basis B0 = [[g, -f], [G, -F]]
+	* in FFT representation, followed by the normalized LDL tree of the
+	* Gram matrix. The expanded key has (8*logn+40)*2^logn bytes, and
+	* tmp[] must have room for at least 48*2^logn bytes.
+	*/
+
+	falcon_fpr* b00;
+	falcon_fpr* b01;
+	falcon_fpr* b10;
+	falcon_fpr* b11;
+	falcon_fpr* g00;
+	falcon_fpr* g01;
+	falcon_fpr* g11;
+	falcon_fpr* gxx;
+	falcon_fpr* tree;
+	size_t n;
+
+	n = falcon_mkn(logn);
+	b00 = expanded_key + falcon_skoff_b00(logn);
+	b01 = expanded_key + falcon_skoff_b01(logn);
+	b10 = expanded_key + falcon_skoff_b10(logn);
+	b11 = expanded_key + falcon_skoff_b11(logn);
+	tree = expanded_key + falcon_skoff_tree(logn);
+
+	/*
+	 * The private key elements are loaded directly into B0,
+	 * then converted to FFT, and f and F are negated.
+	 */
+	falcon_smallints_to_fpr(b01, f, logn);
+	falcon_smallints_to_fpr(b00, g, logn);
+	falcon_smallints_to_fpr(b11, F, logn);
+	falcon_smallints_to_fpr(b10, G, logn);
+	falcon_FFT(b01, logn);
+	falcon_FFT(b00, logn);
+	falcon_FFT(b11, logn);
+	falcon_FFT(b10, logn);
+	falcon_poly_neg(b01, logn);
+	falcon_poly_neg(b11, logn);
+
+	/*
+	 * Compute the Gram matrix G = B0*adj(B0), upper triangle only:
+	 *   g00 = b00*adj(b00) + b01*adj(b01)
+	 *   g01 = b00*adj(b10) + b01*adj(b11)
+	 *   g11 = b10*adj(b10) + b11*adj(b11)
+	 */
+	g00 = (falcon_fpr*)tmp;
+	g01 = g00 + n;
+	g11 = g01 + n;
+	gxx = g11 + n;
+
+	qsc_memutils_copy(g00, b00, n * sizeof(*b00));
+	falcon_poly_mulselfadj_fft(g00, logn);
+	qsc_memutils_copy(gxx, b01, n * sizeof(*b01));
+	falcon_poly_mulselfadj_fft(gxx, logn);
+	falcon_poly_add(g00, gxx, logn);
+
+	qsc_memutils_copy(g01, b00, n * sizeof(*b00));
+	falcon_poly_muladj_fft(g01, b10, logn);
+	qsc_memutils_copy(gxx, b01, n * sizeof(*b01));
+	falcon_poly_muladj_fft(gxx, b11, logn);
+	falcon_poly_add(g01, gxx, logn);
+
+	qsc_memutils_copy(g11, b10, n * sizeof(*b10));
+	falcon_poly_mulselfadj_fft(g11, logn);
+	qsc_memutils_copy(gxx, b11, n * sizeof(*b11));
+	falcon_poly_mulselfadj_fft(gxx, logn);
+	falcon_poly_add(g11, gxx, logn);
+
+	/*
+	 * Compute the LDL tree, and normalize its leaves with regards to sigma.
+	 */
+	falcon_ffLDL_fft(tree, g00, g01, g11, logn, gxx);
+	falcon_ffLDL_binary_normalize(tree, logn, logn);
+}
+
+static void falcon_sign_tree(int16_t* sig, qsc_keccak_state* kctx, const falcon_fpr* restrict expanded_key,
+	const uint16_t* hm, uint32_t logn, uint8_t* tmp)
+{
+	falcon_fpr* ftmp;
+
+	ftmp = (falcon_fpr*)tmp;
+
+	for (;;)
+	{
+		/*
+		 * Same loop as falcon_sign_dyn(), but the basis and the LDL tree
+		 * are read from the expanded key instead of being rebuilt.
+		 */
+		falcon_sampler_context spc = { 0 };
+		falcon_samplerZ samp;
+		void *samp_ctx;
+
+		spc.sigma_min = falcon_avx2_fpr_sigma_min[logn];
+		falcon_prng_init(&spc.p, kctx);
+		samp = falcon_sampler;
+		samp_ctx = &spc;
+
+		if (falcon_do_sign_tree(samp, samp_ctx, sig, expanded_key, hm, logn, ftmp) != 0)
+		{
+			break;
+		}
+	}
+}
+
 #if defined(QSC_FALCON_S3SHAKE256F512)
 
 int32_t qsc_falcon_avx2_generate_keypair(uint8_t* pk, uint8_t* sk, bool (*rng_generate)(uint8_t*, size_t))
@@ -8838,21 +8999,20 @@ int32_t qsc_falcon_avx2_generate_keypair(uint8_t* pk, uint8_t* sk, bool (*rng_ge
 	return 0;
 }
 
-int32_t qsc_falcon_avx2_sign(uint8_t *sm, size_t *smlen, const uint8_t *m, size_t mlen, const uint8_t *sk, bool (*rng_generate)(uint8_t*, size_t))
+int32_t qsc_falcon_avx2_sign_hashed(uint8_t *sig, size_t *siglen, qsc_keccak_state *hctx, const uint8_t *nonce, const uint8_t *sk, bool (*rng_generate)(uint8_t*, size_t))
 {
-	int16_t sig[512];
+	int16_t s2[512];
 	uint8_t b[72 * 512];
 	int8_t f[512];
 	int8_t g[512];
 	int8_t F[512];
 	int8_t G[512];
 	uint8_t seed[48];
-	uint8_t nonce[FALCON_NONCE_SIZE];
-	uint8_t esig[CRYPTO_BYTES - 2 - sizeof(nonce)];
+	uint8_t esig[CRYPTO_BYTES - 2 - FALCON_NONCE_SIZE];
 	qsc_keccak_state kctx;
 	size_t u;
 	size_t v;
-	size_t siglen;
+	size_t elen;
 
 	/*
 	 * Decode the private key.
@@ -8899,18 +9059,10 @@ int32_t qsc_falcon_avx2_sign(uint8_t *sm, size_t *smlen, const uint8_t *m, size_
 	}
 
 	/*
-	 * Create a random nonce (40 bytes).
+	 * The hash state has absorbed nonce + message; hash it into a vector.
 	 */
-	rng_generate(nonce, sizeof(nonce));
-
-	/*
-	 * Hash message nonce + message into a vector.
-	 */
-	qsc_keccak_initialize_state(&kctx);
-	qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, nonce, sizeof(nonce));
-	qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, m, mlen);
-	qsc_keccak_incremental_finalize(&kctx, QSC_KECCAK_256_RATE, QSC_KECCAK_SHAKE_DOMAIN_ID);
-	falcon_hash_to_point_vartime(&kctx, (uint16_t*)sig, 9);
+	qsc_keccak_incremental_finalize(hctx, QSC_KECCAK_256_RATE, QSC_KECCAK_SHAKE_DOMAIN_ID);
+	falcon_hash_to_point_vartime(hctx, (uint16_t*)s2, 9);
 
 	/*
 	 * Initialize a RNG.
@@ -8924,45 +9076,57 @@ int32_t qsc_falcon_avx2_sign(uint8_t *sm, size_t *smlen, const uint8_t *m, size_
 	/*
 	 * Compute the signature.
 	 */
-	falcon_sign_dyn(sig, &kctx, f, g, F, G, (uint16_t*)sig, 9, b);
+	falcon_sign_dyn(s2, &kctx, f, g, F, G, (uint16_t*)s2, 9, b);
 
 
 	/*
-	 * Encode the signature and bundle it with the message. Format is:
+	 * Encode the detached signature. Format is:
 	 *   signature length     2 bytes, big-endian
 	 *   nonce                40 bytes
-	 *   message              mlen bytes
 	 *   signature            slen bytes
 	 */
 	esig[0] = 0x20 + 9;
-	siglen = falcon_comp_encode(esig + 1, (sizeof(esig)) - 1, sig, 9);
+	elen = falcon_comp_encode(esig + 1, (sizeof(esig)) - 1, s2, 9);
 
-	if (siglen == 0)
+	if (elen == 0)
 	{
 		return -1;
 	}
 
-	siglen++;
-	qsc_memutils_move(sm + 2 + sizeof(nonce), m, mlen);
-	sm[0] = (uint8_t)(siglen >> 8);
-	sm[1] = (uint8_t)siglen;
-	qsc_memutils_copy(sm + 2, nonce, sizeof(nonce));
-	qsc_memutils_copy(sm + 2 + sizeof(nonce) + mlen, esig, siglen);
-	*smlen = 2 + sizeof(nonce) + mlen + siglen;
+	elen++;
+	sig[0] = (uint8_t)(elen >> 8);
+	sig[1] = (uint8_t)elen;
+	qsc_memutils_copy(sig + 2, nonce, FALCON_NONCE_SIZE);
+	qsc_memutils_copy(sig + 2 + FALCON_NONCE_SIZE, esig, elen);
+	*siglen = 2 + FALCON_NONCE_SIZE + elen;
 
 	return 0;
 }
 
-bool qsc_falcon_avx2_open(uint8_t *m, size_t *mlen, const uint8_t *sm, size_t smlen, const uint8_t *pk)
+int32_t qsc_falcon_avx2_sign_signature(uint8_t *sig, size_t *siglen, const uint8_t *m, size_t mlen, const uint8_t *sk, bool (*rng_generate)(uint8_t*, size_t))
+{
+	uint8_t nonce[FALCON_NONCE_SIZE];
+	qsc_keccak_state kctx;
+
+	/*
+	 * Create a random nonce (40 bytes), and absorb nonce + message.
+	 */
+	rng_generate(nonce, sizeof(nonce));
+	qsc_keccak_initialize_state(&kctx);
+	qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, nonce, sizeof(nonce));
+	qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, m, mlen);
+
+	return qsc_falcon_avx2_sign_hashed(sig, siglen, &kctx, nonce, sk, rng_generate);
+}
+
+bool qsc_falcon_avx2_verify_hashed(const uint8_t *sig, size_t siglen, qsc_keccak_state *hctx, const uint8_t *pk)
 {
 	uint16_t h[512];
 	uint16_t hm[512];
-	int16_t sig[512];
+	int16_t s2[512];
 	uint8_t b[2 * 512];
 	const uint8_t* esig;
-	qsc_keccak_state kctx;
-	size_t msglen;
-	size_t siglen;
+	size_t elen;
 
 	/*
 	 * Decode public key.
@@ -8980,49 +9144,236 @@ bool qsc_falcon_avx2_open(uint8_t *m, size_t *mlen, const uint8_t *sm, size_t sm
 	falcon_to_ntt_monty(h, 9);
 
 	/*
-	 * Find nonce, signature, message length.
+	 * Find nonce and signature length.
 	 */
-	if (smlen < 2 + FALCON_NONCE_SIZE)
+	if (siglen < 2 + FALCON_NONCE_SIZE)
 	{
 		return false;
 	}
 
-	siglen = ((size_t)sm[0] << 8) | (size_t)sm[1];
+	elen = ((size_t)sig[0] << 8) | (size_t)sig[1];
 
-	if (siglen > (smlen - 2 - FALCON_NONCE_SIZE))
+	if (elen != siglen - 2 - FALCON_NONCE_SIZE)
 	{
 		return false;
 	}
 
-	msglen = smlen - 2 - FALCON_NONCE_SIZE - siglen;
-
 	/*
 	 * Decode signature.
 	 */
-	esig = sm + 2 + FALCON_NONCE_SIZE + msglen;
+	esig = sig + 2 + FALCON_NONCE_SIZE;
 
-	if (siglen < 1 || esig[0] != 0x20 + 9)
+	if (elen < 1 || esig[0] != 0x20 + 9)
 	{
 		return false;
 	}
 
-	if (falcon_comp_decode(sig, 9, esig + 1, siglen - 1) != siglen - 1)
+	if (falcon_comp_decode(s2, 9, esig + 1, elen - 1) != elen - 1)
 	{
 		return false;
 	}
 
 	/*
-	 * Hash nonce + message into a vector.
+	 * The hash state has absorbed nonce + message; hash it into a vector.
+	 */
+	qsc_keccak_incremental_finalize(hctx, QSC_KECCAK_256_RATE, QSC_KECCAK_SHAKE_DOMAIN_ID);
+	falcon_hash_to_point_vartime(hctx, hm, 9);
+
+	/*
+	 * Verify signature.
+	 */
+	if (!falcon_verify_raw(hm, s2, h, 9, b))
+	{
+		return false;
+	}
+
+	return true;
+}
+
+bool qsc_falcon_avx2_verify(const uint8_t *sig, size_t siglen, const uint8_t *m, size_t mlen, const uint8_t *pk)
+{
+	qsc_keccak_state kctx;
+
+	if (siglen < 2 + FALCON_NONCE_SIZE)
+	{
+		return false;
+	}
+
+	/*
+	 * Absorb nonce + message.
 	 */
 	qsc_keccak_initialize_state(&kctx);
-	qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, sm + 2, FALCON_NONCE_SIZE + msglen);
+	qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, sig + 2, FALCON_NONCE_SIZE);
+	qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, m, mlen);
+
+	return qsc_falcon_avx2_verify_hashed(sig, siglen, &kctx, pk);
+}
+
+int32_t qsc_falcon_avx2_expand_privatekey(qsc_falcon_expanded_privatekey* esk, const uint8_t* sk)
+{
+	uint8_t b[72 * 512];
+	int8_t f[512];
+	int8_t g[512];
+	int8_t F[512];
+	int8_t G[512];
+	int32_t res;
+
+	res = falcon_decode_privatekey(f, g, F, G, sk, 9, b);
+
+	if (res == 0)
+	{
+		falcon_expand_privkey((falcon_fpr*)esk->key, f, g, F, G, 9, b);
+	}
+
+	qsc_memutils_clear(b, sizeof(b));
+	qsc_memutils_clear((uint8_t*)f, sizeof(f));
+	qsc_memutils_clear((uint8_t*)g, sizeof(g));
+	qsc_memutils_clear((uint8_t*)F, sizeof(F));
+	qsc_memutils_clear((uint8_t*)G, sizeof(G));
+
+	return res;
+}
+
+int32_t qsc_falcon_avx2_sign_hashed_expanded(uint8_t* sig, size_t* siglen, qsc_keccak_state* hctx, const uint8_t* nonce, const qsc_falcon_expanded_privatekey* esk, bool (*rng_generate)(uint8_t*, size_t))
+{
+	int16_t s2[512];
+	uint8_t b[48 * 512];
+	uint8_t seed[48];
+	uint8_t esig[CRYPTO_BYTES - 2 - FALCON_NONCE_SIZE];
+	qsc_keccak_state kctx;
+	size_t elen;
+
+	/*
+	 * The hash state has absorbed nonce + message; hash it into a vector.
+	 */
+	qsc_keccak_incremental_finalize(hctx, QSC_KECCAK_256_RATE, QSC_KECCAK_SHAKE_DOMAIN_ID);
+	falcon_hash_to_point_vartime(hctx, (uint16_t*)s2, 9);
+
+	/*
+	 * Initialize a RNG.
+	 */
+	rng_generate(seed, sizeof(seed));
+	qsc_keccak_initialize_state(&kctx);
+	qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, seed, sizeof(seed));
 	qsc_keccak_incremental_finalize(&kctx, QSC_KECCAK_256_RATE, QSC_KECCAK_SHAKE_DOMAIN_ID);
-	falcon_hash_to_point_vartime(&kctx, hm, 9);
 
 	/*
-	 * Verify signature.
+	 * Compute the signature with the expanded key.
+	 */
+	falcon_sign_tree(s2, &kctx, (const falcon_fpr*)esk->key, (uint16_t*)s2, 9, b);
+
+	/*
+	 * Encode the detached signature. Format is:
+	 *   signature length     2 bytes, big-endian
+	 *   nonce                40 bytes
+	 *   signature            slen bytes
+	 */
+	esig[0] = 0x20 + 9;
+	elen = falcon_comp_encode(esig + 1, (sizeof(esig)) - 1, s2, 9);
+
+	if (elen == 0)
+	{
+		return -1;
+	}
+
+	elen++;
+	sig[0] = (uint8_t)(elen >> 8);
+	sig[1] = (uint8_t)elen;
+	qsc_memutils_copy(sig + 2, nonce, FALCON_NONCE_SIZE);
+	qsc_memutils_copy(sig + 2 + FALCON_NONCE_SIZE, esig, elen);
+	*siglen = 2 + FALCON_NONCE_SIZE + elen;
+
+	return 0;
+}
+
+int32_t qsc_falcon_avx2_sign_signature_expanded(uint8_t* sig, size_t* siglen, const uint8_t* m, size_t mlen, const qsc_falcon_expanded_privatekey* esk, bool (*rng_generate)(uint8_t*, size_t))
+{
+	uint8_t nonce[FALCON_NONCE_SIZE];
+	qsc_keccak_state kctx;
+
+	rng_generate(nonce, sizeof(nonce));
+	qsc_keccak_initialize_state(&kctx);
+	qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, nonce, sizeof(nonce));
+	qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, m, mlen);
+
+	return qsc_falcon_avx2_sign_hashed_expanded(sig, siglen, &kctx, nonce, esk, rng_generate);
+}
+
+int32_t qsc_falcon_avx2_sign_expanded(uint8_t* sm, size_t* smlen, const uint8_t* m, size_t mlen, const qsc_falcon_expanded_privatekey* esk, bool (*rng_generate)(uint8_t*, size_t))
+{
+	uint8_t sig[CRYPTO_BYTES];
+	size_t siglen;
+	int32_t res;
+
+	res = qsc_falcon_avx2_sign_signature_expanded(sig, &siglen, m, mlen, esk, rng_generate);
+
+	if (res == 0)
+	{
+		qsc_memutils_move(sm + 2 + FALCON_NONCE_SIZE, m, mlen);
+		qsc_memutils_copy(sm, sig, 2 + FALCON_NONCE_SIZE);
+		qsc_memutils_copy(sm + 2 + FALCON_NONCE_SIZE + mlen, sig + 2 + FALCON_NONCE_SIZE, siglen - 2 - FALCON_NONCE_SIZE);
+		*smlen = siglen + mlen;
+	}
+
+	return res;
+}
+
+int32_t qsc_falcon_avx2_sign(uint8_t *sm, size_t *smlen, const uint8_t *m, size_t mlen, const uint8_t *sk, bool (*rng_generate)(uint8_t*, size_t))
+{
+	uint8_t sig[CRYPTO_BYTES];
+	size_t siglen;
+	int32_t res;
+
+	/*
+	 * Sign the message, then bundle the signature with the message. Format is:
+	 *   signature length     2 bytes, big-endian
+	 *   nonce                40 bytes
+	 *   message              mlen bytes
+	 *   signature            slen bytes
 	 */
-	if (!falcon_verify_raw(hm, sig, h, 9, b))
+	res = qsc_falcon_avx2_sign_signature(sig, &siglen, m, mlen, sk, rng_generate);
+
+	if (res == 0)
+	{
+		qsc_memutils_move(sm + 2 + FALCON_NONCE_SIZE, m, mlen);
+		qsc_memutils_copy(sm, sig, 2 + FALCON_NONCE_SIZE);
+		qsc_memutils_copy(sm + 2 + FALCON_NONCE_SIZE + mlen, sig + 2 + FALCON_NONCE_SIZE, siglen - 2 - FALCON_NONCE_SIZE);
+		*smlen = siglen + mlen;
+	}
+
+	return res;
+}
+
+bool qsc_falcon_avx2_open(uint8_t *m, size_t *mlen, const uint8_t *sm, size_t smlen, const uint8_t *pk)
+{
+	uint8_t sig[CRYPTO_BYTES];
+	size_t msglen;
+	size_t siglen;
+
+	/*
+	 * Find nonce, signature, message length.
+	 */
+	if (smlen < 2 + FALCON_NONCE_SIZE)
+	{
+		return false;
+	}
+
+	siglen = ((size_t)sm[0] << 8) | (size_t)sm[1];
+
+	if (siglen > (smlen - 2 - FALCON_NONCE_SIZE) || siglen > (sizeof(sig) - 2 - FALCON_NONCE_SIZE))
+	{
+		return false;
+	}
+
+	msglen = smlen - 2 - FALCON_NONCE_SIZE - siglen;
+
+	/*
+	 * Reassemble the detached signature and verify it against the message in place.
+	 */
+	qsc_memutils_copy(sig, sm, 2 + FALCON_NONCE_SIZE);
+	qsc_memutils_copy(sig + 2 + FALCON_NONCE_SIZE, sm + 2 + FALCON_NONCE_SIZE + msglen, siglen);
+
+	if (!qsc_falcon_avx2_verify(sig, 2 + FALCON_NONCE_SIZE + siglen, sm + 2 + FALCON_NONCE_SIZE, msglen, pk))
 	{
 		return false;
 	}
@@ -9110,21 +9461,20 @@ int32_t qsc_falcon_avx2_generate_keypair(uint8_t* pk, uint8_t* sk, bool (*rng_ge
 	return 0;
 }
 
-int32_t qsc_falcon_avx2_sign(uint8_t* sm, size_t* smlen, const uint8_t* m, size_t mlen, const uint8_t* sk, bool (*rng_generate)(uint8_t*, size_t))
+int32_t qsc_falcon_avx2_sign_hashed(uint8_t* sig, size_t* siglen, qsc_keccak_state* hctx, const uint8_t* nonce, const uint8_t* sk, bool (*rng_generate)(uint8_t*, size_t))
 {
-	int16_t sig[1024] = { 0 };
+	int16_t s2[1024] = { 0 };
 	uint8_t b[72 * 1024];
 	int8_t f[1024];
 	int8_t g[1024];
 	int8_t F[1024];
 	int8_t G[1024];
 	uint8_t seed[48];
-	uint8_t nonce[FALCON_NONCE_SIZE];
-	uint8_t esig[CRYPTO_BYTES - 2 - sizeof(nonce)] = { 0 };
+	uint8_t esig[CRYPTO_BYTES - 2 - FALCON_NONCE_SIZE] = { 0 };
 	qsc_keccak_state kctx;
 	size_t u;
 	size_t v;
-	size_t siglen;
+	size_t elen;
 
 	/*
 	 * Decode the private key.
@@ -9171,18 +9521,10 @@ int32_t qsc_falcon_avx2_sign(uint8_t* sm, size_t* smlen, const uint8_t* m, size_
 	}
 
 	/*
-	 * Create a random nonce (40 bytes).
+	 * The hash state has absorbed nonce + message; hash it into a vector.
 	 */
-	rng_generate(nonce, sizeof(nonce));
-
-	/*
-	 * Hash message nonce + message into a vector.
-	 */
-	qsc_keccak_initialize_state(&kctx);
-	qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, nonce, sizeof(nonce));
-	qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, m, mlen);
-	qsc_keccak_incremental_finalize(&kctx, QSC_KECCAK_256_RATE, QSC_KECCAK_SHAKE_DOMAIN_ID);
-	falcon_hash_to_point_vartime(&kctx, (uint16_t*)sig, 10);
+	qsc_keccak_incremental_finalize(hctx, QSC_KECCAK_256_RATE, QSC_KECCAK_SHAKE_DOMAIN_ID);
+	falcon_hash_to_point_vartime(hctx, (uint16_t*)s2, 10);
 
 	/*
 	 * Initialize a RNG.
@@ -9195,44 +9537,56 @@ int32_t qsc_falcon_avx2_sign(uint8_t* sm, size_t* smlen, const uint8_t* m, size_
 	/*
 	 * Compute the signature.
 	 */
-	falcon_sign_dyn(sig, &kctx, f, g, F, G, (uint16_t*)sig, 10, b);
+	falcon_sign_dyn(s2, &kctx, f, g, F, G, (uint16_t*)s2, 10, b);
 
 	/*
-	 * Encode the signature and bundle it with the message. Format is:
+	 * Encode the detached signature. Format is:
 	 *   signature length     2 bytes, big-endian
 	 *   nonce                40 bytes
-	 *   message              mlen bytes
 	 *   signature            slen bytes
 	 */
 	esig[0] = 0x20 + 10;
-	siglen = falcon_comp_encode(esig + 1, sizeof(esig) - 1, sig, 10);
+	elen = falcon_comp_encode(esig + 1, sizeof(esig) - 1, s2, 10);
 
-	if (siglen == 0)
+	if (elen == 0)
 	{
 		return -1;
 	}
 
-	siglen++;
-	qsc_memutils_move(sm + 2 + sizeof(nonce), m, mlen);
-	sm[0] = (uint8_t)(siglen >> 8);
-	sm[1] = (uint8_t)siglen;
-	qsc_memutils_copy(sm + 2, nonce, sizeof(nonce));
-	qsc_memutils_copy(sm + 2 + sizeof(nonce) + mlen, esig, siglen);
-	*smlen = 2 + sizeof(nonce) + mlen + siglen;
+	elen++;
+	sig[0] = (uint8_t)(elen >> 8);
+	sig[1] = (uint8_t)elen;
+	qsc_memutils_copy(sig + 2, nonce, FALCON_NONCE_SIZE);
+	qsc_memutils_copy(sig + 2 + FALCON_NONCE_SIZE, esig, elen);
+	*siglen = 2 + FALCON_NONCE_SIZE + elen;
 
 	return 0;
 }
 
-bool qsc_falcon_avx2_open(uint8_t* m, size_t* mlen, const uint8_t* sm, size_t smlen, const uint8_t* pk)
+int32_t qsc_falcon_avx2_sign_signature(uint8_t* sig, size_t* siglen, const uint8_t* m, size_t mlen, const uint8_t* sk, bool (*rng_generate)(uint8_t*, size_t))
+{
+	uint8_t nonce[FALCON_NONCE_SIZE];
+	qsc_keccak_state kctx;
+
+	/*
+	 * Create a random nonce (40 bytes), and absorb nonce + message.
+	 */
+	rng_generate(nonce, sizeof(nonce));
+	qsc_keccak_initialize_state(&kctx);
+	qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, nonce, sizeof(nonce));
+	qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, m, mlen);
+
+	return qsc_falcon_avx2_sign_hashed(sig, siglen, &kctx, nonce, sk, rng_generate);
+}
+
+bool qsc_falcon_avx2_verify_hashed(const uint8_t* sig, size_t siglen, qsc_keccak_state* hctx, const uint8_t* pk)
 {
 	uint16_t h[1024];
 	uint16_t hm[1024];
-	int16_t sig[1024];
+	int16_t s2[1024];
 	uint8_t b[2 * 1024];
 	const uint8_t* esig;
-	qsc_keccak_state kctx;
-	size_t siglen;
-	size_t msglen;
+	size_t elen;
 
 	/*
 	 * Decode public key.
@@ -9250,49 +9604,236 @@ bool qsc_falcon_avx2_open(uint8_t* m, size_t* mlen, const uint8_t* sm, size_t sm
 	falcon_to_ntt_monty(h, 10);
 
 	/*
-	 * Find nonce, signature, message length.
+	 * Find nonce and signature length.
 	 */
-	if (smlen < 2 + FALCON_NONCE_SIZE)
+	if (siglen < 2 + FALCON_NONCE_SIZE)
 	{
 		return false;
 	}
 
-	siglen = ((size_t)sm[0] << 8) | (size_t)sm[1];
+	elen = ((size_t)sig[0] << 8) | (size_t)sig[1];
 
-	if (siglen > (smlen - 2 - FALCON_NONCE_SIZE))
+	if (elen != siglen - 2 - FALCON_NONCE_SIZE)
 	{
 		return false;
 	}
 
-	msglen = smlen - 2 - FALCON_NONCE_SIZE - siglen;
-
 	/*
 	 * Decode signature.
 	 */
-	esig = sm + 2 + FALCON_NONCE_SIZE + msglen;
+	esig = sig + 2 + FALCON_NONCE_SIZE;
+
+	if (elen < 1 || esig[0] != 0x20 + 10)
+	{
+		return false;
+	}
+
+	if (falcon_comp_decode(s2, 10, esig + 1, elen - 1) != elen - 1)
+	{
+		return false;
+	}
+
+	/*
+	 * The hash state has absorbed nonce + message; hash it into a vector.
+	 */
+	qsc_keccak_incremental_finalize(hctx, QSC_KECCAK_256_RATE, QSC_KECCAK_SHAKE_DOMAIN_ID);
+	falcon_hash_to_point_vartime(hctx, hm, 10);
 
-	if (siglen < 1 || esig[0] != 0x20 + 10)
+	/*
+	 * Verify signature.
+	 */
+	if (falcon_verify_raw(hm, s2, h, 10, b) == 0)
 	{
 		return false;
 	}
 
-	if (falcon_comp_decode(sig, 10, esig + 1, siglen - 1) != siglen - 1)
+	return true;
+}
+
+bool qsc_falcon_avx2_verify(const uint8_t* sig, size_t siglen, const uint8_t* m, size_t mlen, const uint8_t* pk)
+{
+	qsc_keccak_state kctx;
+
+	if (siglen < 2 + FALCON_NONCE_SIZE)
 	{
 		return false;
 	}
 
 	/*
-	 * Hash nonce + message into a vector.
+	 * Absorb nonce + message.
+	 */
+	qsc_keccak_initialize_state(&kctx);
+	qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, sig + 2, FALCON_NONCE_SIZE);
+	qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, m, mlen);
+
+	return qsc_falcon_avx2_verify_hashed(sig, siglen, &kctx, pk);
+}
+
+int32_t qsc_falcon_avx2_expand_privatekey(qsc_falcon_expanded_privatekey* esk, const uint8_t* sk)
+{
+	uint8_t b[72 * 1024];
+	int8_t f[1024];
+	int8_t g[1024];
+	int8_t F[1024];
+	int8_t G[1024];
+	int32_t res;
+
+	res = falcon_decode_privatekey(f, g, F, G, sk, 10, b);
+
+	if (res == 0)
+	{
+		falcon_expand_privkey((falcon_fpr*)esk->key, f, g, F, G, 10, b);
+	}
+
+	qsc_memutils_clear(b, sizeof(b));
+	qsc_memutils_clear((uint8_t*)f, sizeof(f));
+	qsc_memutils_clear((uint8_t*)g, sizeof(g));
+	qsc_memutils_clear((uint8_t*)F, sizeof(F));
+	qsc_memutils_clear((uint8_t*)G, sizeof(G));
+
+	return res;
+}
+
+int32_t qsc_falcon_avx2_sign_hashed_expanded(uint8_t* sig, size_t* siglen, qsc_keccak_state* hctx, const uint8_t* nonce, const qsc_falcon_expanded_privatekey* esk, bool (*rng_generate)(uint8_t*, size_t))
+{
+	int16_t s2[1024];
+	uint8_t b[48 * 1024];
+	uint8_t seed[48];
+	uint8_t esig[CRYPTO_BYTES - 2 - FALCON_NONCE_SIZE];
+	qsc_keccak_state kctx;
+	size_t elen;
+
+	/*
+	 * The hash state has absorbed nonce + message; hash it into a vector.
+	 */
+	qsc_keccak_incremental_finalize(hctx, QSC_KECCAK_256_RATE, QSC_KECCAK_SHAKE_DOMAIN_ID);
+	falcon_hash_to_point_vartime(hctx, (uint16_t*)s2, 10);
+
+	/*
+	 * Initialize a RNG.
 	 */
+	rng_generate(seed, sizeof(seed));
 	qsc_keccak_initialize_state(&kctx);
-	qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, sm + 2, FALCON_NONCE_SIZE + msglen);
+	qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, seed, sizeof(seed));
 	qsc_keccak_incremental_finalize(&kctx, QSC_KECCAK_256_RATE, QSC_KECCAK_SHAKE_DOMAIN_ID);
-	falcon_hash_to_point_vartime(&kctx, hm, 10);
 
 	/*
-	 * Verify signature.
+	 * Compute the signature with the expanded key.
 	 */
-	if (falcon_verify_raw(hm, sig, h, 10, b) == 0)
+	falcon_sign_tree(s2, &kctx, (const falcon_fpr*)esk->key, (uint16_t*)s2, 10, b);
+
+	/*
+	 * Encode the detached signature. Format is:
+	 *   signature length     2 bytes, big-endian
+	 *   nonce                40 bytes
+	 *   signature            slen bytes
+	 */
+	esig[0] = 0x20 + 10;
+	elen = falcon_comp_encode(esig + 1, (sizeof(esig)) - 1, s2, 10);
+
+	if (elen == 0)
+	{
+		return -1;
+	}
+
+	elen++;
+	sig[0] = (uint8_t)(elen >> 8);
+	sig[1] = (uint8_t)elen;
+	qsc_memutils_copy(sig + 2, nonce, FALCON_NONCE_SIZE);
+	qsc_memutils_copy(sig + 2 + FALCON_NONCE_SIZE, esig, elen);
+	*siglen = 2 + FALCON_NONCE_SIZE + elen;
+
+	return 0;
+}
+
+int32_t qsc_falcon_avx2_sign_signature_expanded(uint8_t* sig, size_t* siglen, const uint8_t* m, size_t mlen, const qsc_falcon_expanded_privatekey* esk, bool (*rng_generate)(uint8_t*, size_t))
+{
+	uint8_t nonce[FALCON_NONCE_SIZE];
+	qsc_keccak_state kctx;
+
+	rng_generate(nonce, sizeof(nonce));
+	qsc_keccak_initialize_state(&kctx);
+	qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, nonce, sizeof(nonce));
+	qsc_keccak_incremental_absorb(&kctx, QSC_KECCAK_256_RATE, m, mlen);
+
+	return qsc_falcon_avx2_sign_hashed_expanded(sig, siglen, &kctx, nonce, esk, rng_generate);
+}
+
+int32_t qsc_falcon_avx2_sign_expanded(uint8_t* sm, size_t* smlen, const uint8_t* m, size_t mlen, const qsc_falcon_expanded_privatekey* esk, bool (*rng_generate)(uint8_t*, size_t))
+{
+	uint8_t sig[CRYPTO_BYTES];
+	size_t siglen;
+	int32_t res;
+
+	res = qsc_falcon_avx2_sign_signature_expanded(sig, &siglen, m, mlen, esk, rng_generate);
+
+	if (res == 0)
+	{
+		qsc_memutils_move(sm + 2 + FALCON_NONCE_SIZE, m, mlen);
+		qsc_memutils_copy(sm, sig, 2 + FALCON_NONCE_SIZE);
+		qsc_memutils_copy(sm + 2 + FALCON_NONCE_SIZE + mlen, sig + 2 + FALCON_NONCE_SIZE, siglen - 2 - FALCON_NONCE_SIZE);
+		*smlen = siglen + mlen;
+	}
+
+	return res;
+}
+
+int32_t qsc_falcon_avx2_sign(uint8_t* sm, size_t* smlen, const uint8_t* m, size_t mlen, const uint8_t* sk, bool (*rng_generate)(uint8_t*, size_t))
+{
+	uint8_t sig[CRYPTO_BYTES];
+	size_t siglen;
+	int32_t res;
+
+	/*
+	 * Sign the message, then bundle the signature with the message. Format is:
+	 *   signature length     2 bytes, big-endian
+	 *   nonce                40 bytes
+	 *   message              mlen bytes
+	 *   signature            slen bytes
+	 */
+	res = qsc_falcon_avx2_sign_signature(sig, &siglen, m, mlen, sk, rng_generate);
+
+	if (res == 0)
+	{
+		qsc_memutils_move(sm + 2 + FALCON_NONCE_SIZE, m, mlen);
+		qsc_memutils_copy(sm, sig, 2 + FALCON_NONCE_SIZE);
+		qsc_memutils_copy(sm + 2 + FALCON_NONCE_SIZE + mlen, sig + 2 + FALCON_NONCE_SIZE, siglen - 2 - FALCON_NONCE_SIZE);
+		*smlen = siglen + mlen;
+	}
+
+	return res;
+}
+
+bool qsc_falcon_avx2_open(uint8_t* m, size_t* mlen, const uint8_t* sm, size_t smlen, const uint8_t* pk)
+{
+	uint8_t sig[CRYPTO_BYTES];
+	size_t msglen;
+	size_t siglen;
+
+	/*
+	 * Find nonce, signature, message length.
+	 */
+	if (smlen < 2 + FALCON_NONCE_SIZE)
+	{
+		return false;
+	}
+
+	siglen = ((size_t)sm[0] << 8) | (size_t)sm[1];
+
+	if (siglen > (smlen - 2 - FALCON_NONCE_SIZE) || siglen > (sizeof(sig) - 2 - FALCON_NONCE_SIZE))
+	{
+		return false;
+	}
+
+	msglen = smlen - 2 - FALCON_NONCE_SIZE - siglen;
+
+	/*
+	 * Reassemble the detached signature and verify it against the message in place.
+	 */
+	qsc_memutils_copy(sig, sm, 2 + FALCON_NONCE_SIZE);
+	qsc_memutils_copy(sig + 2 + FALCON_NONCE_SIZE, sm + 2 + FALCON_NONCE_SIZE + msglen, siglen);
+
+	if (!qsc_falcon_avx2_verify(sig, 2 + FALCON_NONCE_SIZE + siglen, sm + 2 + FALCON_NONCE_SIZE, msglen, pk))
 	{
 		return false;
 	}
@@ -1,4 +1,11 @@
 #include "kyber.h"
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+#	include "kyberbase_avx2.h"
+#else
+#	include "kyberbase.h"
+#endif
+#include "memutils.h"
 #include "secrand.h"
 
 bool qsc_kyber_decapsulate(uint8_t* secret, const uint8_t* ciphertext, const uint8_t* privatekey)
@@ -23,6 +30,28 @@ bool qsc_kyber_decapsulate(uint8_t* secret, const uint8_t* ciphertext, const uin
 	return res;
 }
 
+bool qsc_kyber_decapsulate_expanded(uint8_t* secret, const uint8_t* ciphertext, const qsc_kyber_expanded_privatekey* privatekey)
+{
+	assert(secret != NULL);
+	assert(ciphertext != NULL);
+	assert(privatekey != NULL);
+
+	bool res;
+
+	res = false;
+
+	if (secret != NULL && ciphertext != NULL && privatekey != NULL)
+	{
+#if defined(QSC_SYSTEM_HAS_AVX2)
+		res = qsc_kyber_avx2_decapsulate_expanded(secret, ciphertext, privatekey);
+#else
+		res = qsc_kyber_ref_decapsulate_expanded(secret, ciphertext, privatekey);
+#endif
+	}
+
+	return res;
+}
+
 bool qsc_kyber_decrypt(uint8_t* secret, const uint8_t* ciphertext, const uint8_t* privatekey)
 {
 	assert(secret != NULL);
@@ -58,6 +87,23 @@ void qsc_kyber_encapsulate(uint8_t* secret, uint8_t* ciphertext, const uint8_t*
 	}
 }
 
+void qsc_kyber_encapsulate_expanded(uint8_t* secret, uint8_t* ciphertext, const qsc_kyber_expanded_publickey* publickey, bool (*rng_generate)(uint8_t*, size_t))
+{
+	assert(secret != NULL);
+	assert(ciphertext != NULL);
+	assert(publickey != NULL);
+	assert(rng_generate != NULL);
+
+	if (secret != NULL && ciphertext != NULL && publickey != NULL && rng_generate != NULL)
+	{
+#if defined(QSC_SYSTEM_HAS_AVX2)
+		qsc_kyber_avx2_encapsulate_expanded(ciphertext, secret, publickey, rng_generate);
+#else
+		qsc_kyber_ref_encapsulate_expanded(ciphertext, secret, publickey, rng_generate);
+#endif
+	}
+}
+
 void qsc_kyber_encrypt(uint8_t* secret, uint8_t* ciphertext, const uint8_t* publickey, const uint8_t seed[QSC_KYBER_SEED_SIZE])
 {
 	assert(secret != NULL);
@@ -73,6 +119,46 @@ void qsc_kyber_encrypt(uint8_t* secret, uint8_t* ciphertext, const uint8_t* publ
 	}
 }
 
+void qsc_kyber_expand_privatekey(qsc_kyber_expanded_privatekey* expanded, const uint8_t* privatekey)
+{
+	assert(expanded != NULL);
+	assert(privatekey != NULL);
+
+	if (expanded != NULL && privatekey != NULL)
+	{
+#if defined(QSC_SYSTEM_HAS_AVX2)
+		qsc_kyber_avx2_expand_privatekey(expanded, privatekey);
+#else
+		qsc_kyber_ref_expand_privatekey(expanded, privatekey);
+#endif
+	}
+}
+
+void qsc_kyber_expand_publickey(qsc_kyber_expanded_publickey* expanded, const uint8_t* publickey)
+{
+	assert(expanded != NULL);
+	assert(publickey != NULL);
+
+	if (expanded != NULL && publickey != NULL)
+	{
+#if defined(QSC_SYSTEM_HAS_AVX2)
+		qsc_kyber_avx2_expand_publickey(expanded, publickey);
+#else
+		qsc_kyber_ref_expand_publickey(expanded, publickey);
+#endif
+	}
+}
+
+void qsc_kyber_expanded_privatekey_dispose(qsc_kyber_expanded_privatekey* expanded)
+{
+	assert(expanded != NULL);
+
+	if (expanded != NULL)
+	{
+		qsc_memutils_clear((uint8_t*)expanded, sizeof(qsc_kyber_expanded_privatekey));
+	}
+}
+
 void qsc_kyber_generate_keypair(uint8_t* publickey, uint8_t* privatekey, bool (*rng_generate)(uint8_t*, size_t))
 {
 	assert(publickey != NULL);
@@ -67,12 +67,182 @@
 */
 
 #include "common.h"
-#if defined(QSC_SYSTEM_HAS_AVX2)
-#	include "kyberbase_avx2.h"
+
+/* \cond DOXYGEN_IGNORE */
+
+/*!
+\def QSC_KYBER_K
+* Read Only: The k level
+*/
+#if defined(QSC_KYBER_S1P1632)
+#	define QSC_KYBER_K 2
+#elif defined(QSC_KYBER_S3P2400)
+#	define QSC_KYBER_K 3
+#elif defined(QSC_KYBER_S5P3168)
+#	define QSC_KYBER_K 4
+#elif defined(QSC_KYBER_S6P3936)
+#	define QSC_KYBER_K 5
 #else
-#	include "kyberbase.h"
+#	error "The Kyber parameter set is invalid!"
+#endif
+
+/*!
+\def QSC_KYBER_N
+* Read Only: The polynomial dimension N
+*/
+#define QSC_KYBER_N 256
+
+/*!
+\def QSC_KYBER_Q
+* Read Only: The modulus prime factor Q
+*/
+#define QSC_KYBER_Q 3329
+
+/*!
+\def QSC_KYBER_ETA2
+* Read Only: The binomial distribution factor
+*/
+#define QSC_KYBER_ETA2 2
+
+/*!
+\def QSC_KYBER_MSGBYTES
+* Read Only: The size in bytes of the shared secret
+*/
+#define QSC_KYBER_MSGBYTES 32
+
+/*!
+\def QSC_KYBER_SYMBYTES
+* Read Only: The size in bytes of hashes, and seeds
+*/
+#define QSC_KYBER_SYMBYTES 32
+
+/*!
+\def QSC_KYBER_POLYBYTES
+* Read Only: The secret key base multiplier
+*/
+#define QSC_KYBER_POLYBYTES 384
+
+#if (QSC_KYBER_K == 2)
+#	define QSC_KYBER_POLYCOMPRESSED_BYTES 128
+#	define QSC_KYBER_POLYVECBASE_BYTES 320
+#	define QSC_KYBER_ETA1 3
+#elif (QSC_KYBER_K == 3)
+#	define QSC_KYBER_POLYCOMPRESSED_BYTES 128
+#	define QSC_KYBER_POLYVECBASE_BYTES 320
+#	define QSC_KYBER_ETA1 2
+#elif (QSC_KYBER_K == 4)
+#	define QSC_KYBER_POLYCOMPRESSED_BYTES 160
+#	define QSC_KYBER_POLYVECBASE_BYTES 352
+#	define QSC_KYBER_ETA1 2
+#elif (QSC_KYBER_K == 5)
+#	define QSC_KYBER_POLYCOMPRESSED_BYTES 160
+#	define QSC_KYBER_POLYVECBASE_BYTES 352
+#	define QSC_KYBER_ETA1 2
 #endif
 
+/*!
+\def QSC_KYBER_POLYVEC_COMPRESSED_BYTES
+* Read Only: The base size of the public key
+*/
+#define QSC_KYBER_POLYVEC_COMPRESSED_BYTES (QSC_KYBER_K * QSC_KYBER_POLYVECBASE_BYTES)
+
+/*!
+\def QSC_KYBER_POLYVEC_BYTES
+* Read Only: The base size of the secret key
+*/
+#define QSC_KYBER_POLYVEC_BYTES (QSC_KYBER_K * QSC_KYBER_POLYBYTES)
+
+/*!
+\def QSC_KYBER_INDCPA_PUBLICKEY_BYTES
+* Read Only: The base INDCPA formatted public key size in bytes
+*/
+#define QSC_KYBER_INDCPA_PUBLICKEY_BYTES (QSC_KYBER_POLYVEC_BYTES + QSC_KYBER_SYMBYTES)
+
+/*!
+\def QSC_KYBER_INDCPA_SECRETKEY_BYTES
+* Read Only: The base INDCPA formatted private key size in bytes
+*/
+#define QSC_KYBER_INDCPA_SECRETKEY_BYTES (QSC_KYBER_POLYVEC_BYTES)
+
+/*!
+\def QSC_KYBER_INDCPA_BYTES
+* Read Only: The size of the INDCPA formatted output cipher-text
+*/
+#define QSC_KYBER_INDCPA_BYTES (QSC_KYBER_POLYVEC_COMPRESSED_BYTES + QSC_KYBER_POLYCOMPRESSED_BYTES)
+
+/*!
+\def QSC_KYBER_PUBLICKEY_BYTES
+* Read Only: The byte size of the public-key array
+*/
+#define QSC_KYBER_PUBLICKEY_BYTES  (QSC_KYBER_INDCPA_PUBLICKEY_BYTES)
+
+/*!
+\def QSC_KYBER_SECRETKEY_BYTES
+* Read Only: The byte size of the secret private-key array
+*/
+#define QSC_KYBER_SECRETKEY_BYTES  (QSC_KYBER_INDCPA_SECRETKEY_BYTES + QSC_KYBER_INDCPA_PUBLICKEY_BYTES + 2 * QSC_KYBER_SYMBYTES)
+
+/*!
+\def QSC_KYBER_CIPHERTEXT_BYTES
+* Read Only: The byte size of the cipher-text array
+*/
+#define QSC_KYBER_CIPHERTEXT_BYTES (QSC_KYBER_INDCPA_BYTES)
+
+/* \endcond DOXYGEN_IGNORE */
+
+/**
+* \struct qsc_kyber_poly
+* \brief Contains an N sized array of 16bit coefficients. /n
+* Elements of R_q = Z_q[X] / (X^n + 1). /n
+* Represents polynomial coeffs[0] + X * coeffs[1] + X^2 * xoeffs[2] + ... + X^{n-1} * coeffs[n-1]
+*
+* \var qsc_kyber_poly::coeffs
+* The array of 16bit coefficients
+*/
+typedef struct
+{
+	QSC_ALIGN(32) int16_t coeffs[QSC_KYBER_N];
+} qsc_kyber_poly;
+
+/**
+* \struct qsc_kyber_polyvec
+* \brief Contains a K sized vector of qsc_kyber_poly structures
+*
+* \var qsc_kyber_polyvec::vec
+* The polynomial vector array
+*/
+typedef struct
+{
+	qsc_kyber_poly vec[QSC_KYBER_K];
+} qsc_kyber_polyvec;
+
+/**
+* \struct qsc_kyber_expanded_publickey
+* \brief The expanded form of a Kyber public key. \n
+* Holds the transposed public matrix and the public vector in the NTT domain,
+* and the hash of the packed public key, so encapsulation skips the SHAKE matrix generation.
+* The polynomial layout is specific to the implementation that expanded the key.
+*/
+typedef struct
+{
+	qsc_kyber_polyvec at[QSC_KYBER_K];		/*!< The transposed public matrix in the NTT domain */
+	qsc_kyber_polyvec t;					/*!< The public vector in the NTT domain */
+	uint8_t hpk[QSC_KYBER_SYMBYTES];		/*!< The hash of the packed public key */
+} qsc_kyber_expanded_publickey;
+
+/**
+* \struct qsc_kyber_expanded_privatekey
+* \brief The expanded form of a Kyber private key. \n
+* Holds the secret vector in the NTT domain, the expanded public key used for the re-encryption check,
+* and the implicit rejection value.
+*/
+typedef struct
+{
+	qsc_kyber_polyvec s;					/*!< The secret vector in the NTT domain */
+	qsc_kyber_expanded_publickey epk;		/*!< The expanded public key */
+	uint8_t z[QSC_KYBER_SYMBYTES];			/*!< The implicit rejection value */
+} qsc_kyber_expanded_privatekey;
+
 /*!
 * \def QSC_KYBER_CIPHERTEXT_SIZE
 * \brief The byte size of the cipher-text array
@@ -120,6 +290,17 @@
 */
 QSC_EXPORT_API bool qsc_kyber_decapsulate(uint8_t* secret, const uint8_t* ciphertext, const uint8_t* privatekey);
 
+/**
+* \brief Decapsulates the shared secret for a given cipher-text using an expanded private-key.
+* Produces the same shared secret as qsc_kyber_decapsulate, without unpacking the key or generating the public matrix.
+*
+* \param secret: Pointer to the output shared secret key, an array of QSC_KYBER_SHAREDSECRET_SIZE constant size
+* \param ciphertext: [const] Pointer to the cipher-text array of QSC_KYBER_CIPHERTEXT_SIZE constant size
+* \param privatekey: [const] Pointer to the expanded private-key, initialized with qsc_kyber_expand_privatekey
+* \return Returns true for success
+*/
+QSC_EXPORT_API bool qsc_kyber_decapsulate_expanded(uint8_t* secret, const uint8_t* ciphertext, const qsc_kyber_expanded_privatekey* privatekey);
+
 /**
 * \brief Decrypts the shared secret for a given cipher-text using a private-key
 * Used in conjunction with the encrypt function.
@@ -144,6 +325,19 @@ QSC_EXPORT_API bool qsc_kyber_decrypt(uint8_t* secret, const uint8_t* ciphertext
 */
 QSC_EXPORT_API void qsc_kyber_encapsulate(uint8_t* secret, uint8_t* ciphertext, const uint8_t* publickey, bool (*rng_generate)(uint8_t*, size_t));
 
+/**
+* \brief Generates cipher-text and encapsulates a shared secret key using an expanded public-key.
+* Used for repeated encapsulations to the same public key; skips the public matrix generation and the public-key hash.
+*
+* \warning Ciphertext array must be sized to the QSC_KYBER_CIPHERTEXT_SIZE.
+*
+* \param secret: Pointer to the shared secret key, a uint8_t array of QSC_KYBER_SHAREDSECRET_SIZE constant size
+* \param ciphertext: Pointer to the cipher-text array of QSC_KYBER_CIPHERTEXT_SIZE constant size
+* \param publickey: [const] Pointer to the expanded public-key, initialized with qsc_kyber_expand_publickey
+* \param rng_generate: A pointer to the random generator function
+*/
+QSC_EXPORT_API void qsc_kyber_encapsulate_expanded(uint8_t* secret, uint8_t* ciphertext, const qsc_kyber_expanded_publickey* publickey, bool (*rng_generate)(uint8_t*, size_t));
+
 /**
 * \brief Generates cipher-text and encapsulates a shared secret key using a public-key
 * Used in conjunction with the encrypt function.
@@ -157,6 +351,33 @@ QSC_EXPORT_API void qsc_kyber_encapsulate(uint8_t* secret, uint8_t* ciphertext,
 */
 QSC_EXPORT_API void qsc_kyber_encrypt(uint8_t* secret, uint8_t* ciphertext, const uint8_t* publickey, const uint8_t seed[QSC_KYBER_SEED_SIZE]);
 
+/**
+* \brief Expands a private-key for repeated decapsulations.
+* The secret vector and the public matrix are stored in the NTT domain.
+*
+* \warning The expanded key holds secret material; erase it with qsc_kyber_expanded_privatekey_dispose.
+*
+* \param expanded: Pointer to the output expanded private-key structure
+* \param privatekey: [const] Pointer to the private-key array of QSC_KYBER_PRIVATEKEY_SIZE constant size
+*/
+QSC_EXPORT_API void qsc_kyber_expand_privatekey(qsc_kyber_expanded_privatekey* expanded, const uint8_t* privatekey);
+
+/**
+* \brief Expands a public-key for repeated encapsulations.
+* The transposed public matrix and the public vector are stored in the NTT domain.
+*
+* \param expanded: Pointer to the output expanded public-key structure
+* \param publickey: [const] Pointer to the public-key array of QSC_KYBER_PUBLICKEY_SIZE constant size
+*/
+QSC_EXPORT_API void qsc_kyber_expand_publickey(qsc_kyber_expanded_publickey* expanded, const uint8_t* publickey);
+
+/**
+* \brief Erase an expanded private-key
+*
+* \param expanded: Pointer to the expanded private-key structure
+*/
+QSC_EXPORT_API void qsc_kyber_expanded_privatekey_dispose(qsc_kyber_expanded_privatekey* expanded);
+
 /**
 * \brief Generates public and private key for the KYBER key encapsulation mechanism
 *
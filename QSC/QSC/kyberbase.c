@@ -54,34 +54,6 @@ static int16_t kyber_barrett_reduce(int16_t a)
     return (a - t);
 }
 
-/* poly.h */
-
-/**
-* \struct qsc_kyber_poly
-* \brief Contains an N sized array of 16bit coefficients. /n
-* Elements of R_q = Z_q[X] / (X^n + 1). /n
-* Represents polynomial coeffs[0] + X * coeffs[1] + X^2 * xoeffs[2] + ... + X^{n-1} * coeffs[n-1]
-*
-* \var qsc_kyber_poly::coeffs
-* The array of 16bit coefficients
-*/
-typedef struct
-{
-    int16_t coeffs[QSC_KYBER_N];
-} qsc_kyber_poly;
-
-/**
-* \struct qsc_kyber_polyvec
-* \brief Contains a K sized vector of qsc_kyber_poly structures
-*
-* \var qsc_kyber_polyvec::vec
-* The polynomial vector array
-*/
-typedef struct
-{
-    qsc_kyber_poly vec[QSC_KYBER_K];
-} qsc_kyber_polyvec;
-
 /* cbd.c */
 
 static void kyber_cbd2(qsc_kyber_poly* r, const uint8_t buf[QSC_KYBER_ETA2 * QSC_KYBER_N / 4])
@@ -783,25 +755,20 @@ static void kyber_indcpa_keypair(uint8_t pk[QSC_KYBER_INDCPA_PUBLICKEY_BYTES], u
     kyber_pack_pk(pk, &pkpv, publicseed);
 }
 
-static void kyber_indcpa_enc(uint8_t c[QSC_KYBER_INDCPA_BYTES], const uint8_t m[QSC_KYBER_MSGBYTES],
-    const uint8_t pk[QSC_KYBER_INDCPA_PUBLICKEY_BYTES], const uint8_t coins[QSC_KYBER_SYMBYTES])
+static void kyber_indcpa_enc_expanded(uint8_t c[QSC_KYBER_INDCPA_BYTES], const uint8_t m[QSC_KYBER_MSGBYTES],
+    const qsc_kyber_polyvec at[QSC_KYBER_K], const qsc_kyber_polyvec* pkpv, const uint8_t coins[QSC_KYBER_SYMBYTES])
 {
     qsc_kyber_polyvec sp;
-    qsc_kyber_polyvec pkpv;
     qsc_kyber_polyvec ep;
-    qsc_kyber_polyvec at[QSC_KYBER_K];
     qsc_kyber_polyvec b;
     qsc_kyber_poly v;
     qsc_kyber_poly k;
     qsc_kyber_poly epp;
-    uint8_t seed[QSC_KYBER_SYMBYTES];
     size_t i;
     uint8_t nonce;
 
     nonce = 0;
-    kyber_unpack_pk(&pkpv, seed, pk);
     kyber_poly_from_msg(&k, m);
-    kyber_gen_matrix(at, seed, 1);
 
     for (i = 0; i < QSC_KYBER_K; ++i)
     {
@@ -823,7 +790,7 @@ static void kyber_indcpa_enc(uint8_t c[QSC_KYBER_INDCPA_BYTES], const uint8_t m[
         kyber_polyvec_basemul_acc_montgomery(&b.vec[i], &at[i], &sp);
     }
 
-    kyber_polyvec_basemul_acc_montgomery(&v, &pkpv, &sp);
+    kyber_polyvec_basemul_acc_montgomery(&v, pkpv, &sp);
     kyber_polyvec_invntt_to_mont(&b);
     kyber_poly_invntt_to_mont(&v);
 
@@ -837,23 +804,49 @@ static void kyber_indcpa_enc(uint8_t c[QSC_KYBER_INDCPA_BYTES], const uint8_t m[
     kyber_pack_ciphertext(c, &b, &v);
 }
 
-static void kyber_indcpa_dec(uint8_t m[QSC_KYBER_MSGBYTES], const uint8_t c[QSC_KYBER_INDCPA_BYTES], const uint8_t sk[QSC_KYBER_INDCPA_SECRETKEY_BYTES])
+static void kyber_indcpa_enc(uint8_t c[QSC_KYBER_INDCPA_BYTES], const uint8_t m[QSC_KYBER_MSGBYTES],
+    const uint8_t pk[QSC_KYBER_INDCPA_PUBLICKEY_BYTES], const uint8_t coins[QSC_KYBER_SYMBYTES])
+{
+    qsc_kyber_polyvec pkpv;
+    qsc_kyber_polyvec at[QSC_KYBER_K];
+    uint8_t seed[QSC_KYBER_SYMBYTES];
+
+    kyber_unpack_pk(&pkpv, seed, pk);
+    kyber_gen_matrix(at, seed, 1);
+    kyber_indcpa_enc_expanded(c, m, at, &pkpv, coins);
+}
+
+static void kyber_indcpa_dec_expanded(uint8_t m[QSC_KYBER_MSGBYTES], const uint8_t c[QSC_KYBER_INDCPA_BYTES], const qsc_kyber_polyvec* skpv)
 {
     qsc_kyber_polyvec b;
-    qsc_kyber_polyvec skpv;
     qsc_kyber_poly v;
     qsc_kyber_poly mp;
 
     kyber_unpack_ciphertext(&b, &v, c);
-    kyber_unpack_sk(&skpv, sk);
     kyber_polyvec_ntt(&b);
-    kyber_polyvec_basemul_acc_montgomery(&mp, &skpv, &b);
+    kyber_polyvec_basemul_acc_montgomery(&mp, skpv, &b);
     kyber_poly_invntt_to_mont(&mp);
     kyber_poly_sub(&mp, &v, &mp);
     kyber_poly_reduce(&mp);
     kyber_poly_to_msg(m, &mp);
 }
 
+static void kyber_indcpa_dec(uint8_t m[QSC_KYBER_MSGBYTES], const uint8_t c[QSC_KYBER_INDCPA_BYTES], const uint8_t sk[QSC_KYBER_INDCPA_SECRETKEY_BYTES])
+{
+    qsc_kyber_polyvec skpv;
+
+    kyber_unpack_sk(&skpv, sk);
+    kyber_indcpa_dec_expanded(m, c, &skpv);
+}
+
+static void kyber_indcpa_expand_publickey(qsc_kyber_expanded_publickey* epk, const uint8_t pk[QSC_KYBER_INDCPA_PUBLICKEY_BYTES])
+{
+    uint8_t seed[QSC_KYBER_SYMBYTES];
+
+    kyber_unpack_pk(&epk->t, seed, pk);
+    kyber_gen_matrix(epk->at, seed, 1);
+}
+
 /* kem.c */
 
 void qsc_kyber_ref_generate_keypair(uint8_t pk[QSC_KYBER_PUBLICKEY_BYTES], uint8_t sk[QSC_KYBER_SECRETKEY_BYTES], bool (*rng_generate)(uint8_t*, size_t))
@@ -918,3 +911,69 @@ bool qsc_kyber_ref_decapsulate(uint8_t ss[QSC_KYBER_MSGBYTES], const uint8_t ct[
 
     return (fail == 0);
 }
+
+void qsc_kyber_ref_encapsulate_expanded(uint8_t ct[QSC_KYBER_CIPHERTEXT_BYTES], uint8_t ss[QSC_KYBER_MSGBYTES], const qsc_kyber_expanded_publickey* epk, bool (*rng_generate)(uint8_t*, size_t))
+{
+    uint8_t buf[2 * QSC_KYBER_SYMBYTES];
+    uint8_t kr[2 * QSC_KYBER_SYMBYTES];
+
+    rng_generate(buf, QSC_KYBER_SYMBYTES);
+    /* Don't release system RNG output */
+    qsc_sha3_compute256(buf, buf, QSC_KYBER_SYMBYTES);
+
+    /* Multitarget countermeasure for coins + contributory KEM; H(pk) is stored in the expanded key */
+    qsc_memutils_copy((buf + QSC_KYBER_SYMBYTES), epk->hpk, QSC_KYBER_SYMBYTES);
+    qsc_sha3_compute512(kr, buf, 2 * QSC_KYBER_SYMBYTES);
+
+    /* coins are in kr+QSC_KYBER_SYMBYTES */
+    kyber_indcpa_enc_expanded(ct, buf, epk->at, &epk->t, (kr + QSC_KYBER_SYMBYTES));
+
+    /* overwrite coins in kr with H(c) */
+    qsc_sha3_compute256((kr + QSC_KYBER_SYMBYTES), ct, QSC_KYBER_CIPHERTEXT_BYTES);
+    /* hash concatenation of pre-k and H(c) to k */
+    qsc_shake256_compute(ss, QSC_KYBER_MSGBYTES, kr, 2 * QSC_KYBER_SYMBYTES);
+}
+
+bool qsc_kyber_ref_decapsulate_expanded(uint8_t ss[QSC_KYBER_MSGBYTES], const uint8_t ct[QSC_KYBER_CIPHERTEXT_BYTES], const qsc_kyber_expanded_privatekey* esk)
+{
+    uint8_t buf[2 * QSC_KYBER_SYMBYTES];
+    uint8_t cmp[QSC_KYBER_CIPHERTEXT_BYTES];
+    uint8_t kr[2 * QSC_KYBER_SYMBYTES];
+    int32_t fail;
+
+    kyber_indcpa_dec_expanded(buf, ct, &esk->s);
+
+    /* Multitarget countermeasure for coins + contributory KEM */
+    qsc_memutils_copy((buf + QSC_KYBER_SYMBYTES), esk->epk.hpk, QSC_KYBER_SYMBYTES);
+    qsc_sha3_compute512(kr, buf, 2 * QSC_KYBER_SYMBYTES);
+
+    /* coins are in kr+QSC_KYBER_SYMBYTES */
+    kyber_indcpa_enc_expanded(cmp, buf, esk->epk.at, &esk->epk.t, (kr + QSC_KYBER_SYMBYTES));
+
+    fail = qsc_intutils_verify(ct, cmp, QSC_KYBER_CIPHERTEXT_BYTES);
+
+    /* overwrite coins in kr with H(c) */
+    qsc_sha3_compute256((kr + QSC_KYBER_SYMBYTES), ct, QSC_KYBER_CIPHERTEXT_BYTES);
+
+    /* Overwrite pre-k with z on re-encryption failure */
+    qsc_intutils_cmov(kr, esk->z, QSC_KYBER_SYMBYTES, (uint8_t)fail);
+
+    /* hash concatenation of pre-k and H(c) to k */
+    qsc_shake256_compute(ss, QSC_KYBER_MSGBYTES, kr, 2 * QSC_KYBER_SYMBYTES);
+
+    return (fail == 0);
+}
+
+void qsc_kyber_ref_expand_publickey(qsc_kyber_expanded_publickey* epk, const uint8_t pk[QSC_KYBER_PUBLICKEY_BYTES])
+{
+    kyber_indcpa_expand_publickey(epk, pk);
+    qsc_sha3_compute256(epk->hpk, pk, QSC_KYBER_PUBLICKEY_BYTES);
+}
+
+void qsc_kyber_ref_expand_privatekey(qsc_kyber_expanded_privatekey* esk, const uint8_t sk[QSC_KYBER_SECRETKEY_BYTES])
+{
+    kyber_unpack_sk(&esk->s, sk);
+    kyber_indcpa_expand_publickey(&esk->epk, (sk + QSC_KYBER_INDCPA_SECRETKEY_BYTES));
+    qsc_memutils_copy(esk->epk.hpk, (sk + QSC_KYBER_SECRETKEY_BYTES - (2 * QSC_KYBER_SYMBYTES)), QSC_KYBER_SYMBYTES);
+    qsc_memutils_copy(esk->z, (sk + QSC_KYBER_SECRETKEY_BYTES - QSC_KYBER_SYMBYTES), QSC_KYBER_SYMBYTES);
+}
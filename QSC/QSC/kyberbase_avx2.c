@@ -32,33 +32,291 @@ static const uint16_t kyber_zetas[KYBER_ZETA_SIZE] =
     0xFF94, 0xFECC, 0x03E4, 0x03DF, 0x03BE, 0xFA4C, 0x05F2, 0x065C
 };
 
-/* poly.h */
-
-/**
-* \struct qsc_kyber_poly
-* \brief Contains an N sized array of 16bit coefficients. /n
-* Elements of R_q = Z_q[X] / (X^n + 1). /n
-* Represents polynomial coeffs[0] + X * coeffs[1] + X^2 * xoeffs[2] + ... + X^{n-1} * coeffs[n-1]
-*
-* \var qsc_kyber_poly::coeffs
-* The array of 16bit coefficients
-*/
-typedef struct
-{
-	QSC_ALIGN(32) int16_t coeffs[QSC_KYBER_N];
-} qsc_kyber_poly;
-
-/**
-* \struct qsc_kyber_polyvec
-* \brief Contains a K sized vector of qsc_kyber_poly structures
-*
-* \var qsc_kyber_polyvec::vec
-* The polynomial vector array
-*/
-typedef struct
-{
-    qsc_kyber_poly vec[QSC_KYBER_K];
-} qsc_kyber_polyvec;
+#if defined(QSC_SYSTEM_HAS_AVX512)
+/* the AVX-512 transform zetas; for each 64 coefficient block, the length 16, 8, 4 and 2 layer zetas,
+   with the lower and upper 256-bit halves serving the two 32 coefficient blocks */
+static const uint16_t kyber_ntt_zetas_avx512[512] =
+{
+    0xFF55, 0xFF55, 0xFF55, 0xFF55, 0xFF55, 0xFF55, 0xFF55, 0xFF55,
+    0xFF55, 0xFF55, 0xFF55, 0xFF55, 0xFF55, 0xFF55, 0xFF55, 0xFF55,
+    0x026E, 0x026E, 0x026E, 0x026E, 0x026E, 0x026E, 0x026E, 0x026E,
+    0x026E, 0x026E, 0x026E, 0x026E, 0x026E, 0x026E, 0x026E, 0x026E,
+    0x023D, 0x023D, 0x023D, 0x023D, 0x023D, 0x023D, 0x023D, 0x023D,
+    0xFAD3, 0xFAD3, 0xFAD3, 0xFAD3, 0xFAD3, 0xFAD3, 0xFAD3, 0xFAD3,
+    0x0108, 0x0108, 0x0108, 0x0108, 0x0108, 0x0108, 0x0108, 0x0108,
+    0x017F, 0x017F, 0x017F, 0x017F, 0x017F, 0x017F, 0x017F, 0x017F,
+    0x04C7, 0x04C7, 0x04C7, 0x04C7, 0x028C, 0x028C, 0x028C, 0x028C,
+    0xFDD8, 0xFDD8, 0xFDD8, 0xFDD8, 0x03F7, 0x03F7, 0x03F7, 0x03F7,
+    0xFAF3, 0xFAF3, 0xFAF3, 0xFAF3, 0x05D3, 0x05D3, 0x05D3, 0x05D3,
+    0xFEE6, 0xFEE6, 0xFEE6, 0xFEE6, 0xF9F8, 0xF9F8, 0xF9F8, 0xF9F8,
+    0xFBB1, 0xFBB1, 0x01AE, 0x01AE, 0x022B, 0x022B, 0x034B, 0x034B,
+    0xFB1D, 0xFB1D, 0x0367, 0x0367, 0x060E, 0x060E, 0x0069, 0x0069,
+    0x01A6, 0x01A6, 0x024B, 0x024B, 0x00B1, 0x00B1, 0xFF15, 0xFF15,
+    0xFEDD, 0xFEDD, 0xFE34, 0xFE34, 0x0626, 0x0626, 0x0675, 0x0675,
+    0x0629, 0x0629, 0x0629, 0x0629, 0x0629, 0x0629, 0x0629, 0x0629,
+    0x0629, 0x0629, 0x0629, 0x0629, 0x0629, 0x0629, 0x0629, 0x0629,
+    0x00B6, 0x00B6, 0x00B6, 0x00B6, 0x00B6, 0x00B6, 0x00B6, 0x00B6,
+    0x00B6, 0x00B6, 0x00B6, 0x00B6, 0x00B6, 0x00B6, 0x00B6, 0x00B6,
+    0xFCC3, 0xFCC3, 0xFCC3, 0xFCC3, 0xFCC3, 0xFCC3, 0xFCC3, 0xFCC3,
+    0x05B2, 0x05B2, 0x05B2, 0x05B2, 0x05B2, 0x05B2, 0x05B2, 0x05B2,
+    0xF9BE, 0xF9BE, 0xF9BE, 0xF9BE, 0xF9BE, 0xF9BE, 0xF9BE, 0xF9BE,
+    0xFF7E, 0xFF7E, 0xFF7E, 0xFF7E, 0xFF7E, 0xFF7E, 0xFF7E, 0xFF7E,
+    0x0204, 0x0204, 0x0204, 0x0204, 0xFFF8, 0xFFF8, 0xFFF8, 0xFFF8,
+    0xFEC0, 0xFEC0, 0xFEC0, 0xFEC0, 0xFD66, 0xFD66, 0xFD66, 0xFD66,
+    0xF9AE, 0xF9AE, 0xF9AE, 0xF9AE, 0xFB76, 0xFB76, 0xFB76, 0xFB76,
+    0x007E, 0x007E, 0x007E, 0x007E, 0x05BD, 0x05BD, 0x05BD, 0x05BD,
+    0xFF0A, 0xFF0A, 0x030A, 0x030A, 0x0487, 0x0487, 0xFF6D, 0xFF6D,
+    0xFCF7, 0xFCF7, 0x05CB, 0x05CB, 0xFDA6, 0xFDA6, 0x045F, 0x045F,
+    0xF9CA, 0xF9CA, 0x0284, 0x0284, 0xFC98, 0xFC98, 0x015D, 0x015D,
+    0x01A2, 0x01A2, 0x0149, 0x0149, 0xFF64, 0xFF64, 0xFFB5, 0xFFB5,
+    0x03C2, 0x03C2, 0x03C2, 0x03C2, 0x03C2, 0x03C2, 0x03C2, 0x03C2,
+    0x03C2, 0x03C2, 0x03C2, 0x03C2, 0x03C2, 0x03C2, 0x03C2, 0x03C2,
+    0xFB4E, 0xFB4E, 0xFB4E, 0xFB4E, 0xFB4E, 0xFB4E, 0xFB4E, 0xFB4E,
+    0xFB4E, 0xFB4E, 0xFB4E, 0xFB4E, 0xFB4E, 0xFB4E, 0xFB4E, 0xFB4E,
+    0xFD57, 0xFD57, 0xFD57, 0xFD57, 0xFD57, 0xFD57, 0xFD57, 0xFD57,
+    0x03F9, 0x03F9, 0x03F9, 0x03F9, 0x03F9, 0x03F9, 0x03F9, 0x03F9,
+    0x02DC, 0x02DC, 0x02DC, 0x02DC, 0x02DC, 0x02DC, 0x02DC, 0x02DC,
+    0x0260, 0x0260, 0x0260, 0x0260, 0x0260, 0x0260, 0x0260, 0x0260,
+    0xFCAB, 0xFCAB, 0xFCAB, 0xFCAB, 0xFFA6, 0xFFA6, 0xFFA6, 0xFFA6,
+    0xFEF1, 0xFEF1, 0xFEF1, 0xFEF1, 0x033E, 0x033E, 0x033E, 0x033E,
+    0x006B, 0x006B, 0x006B, 0x006B, 0xFA73, 0xFA73, 0xFA73, 0xFA73,
+    0xFF09, 0xFF09, 0xFF09, 0xFF09, 0xFC49, 0xFC49, 0xFC49, 0xFC49,
+    0x0331, 0x0331, 0x0449, 0x0449, 0x025B, 0x025B, 0x0262, 0x0262,
+    0x052A, 0x052A, 0xFAFB, 0xFAFB, 0xFA47, 0xFA47, 0x0180, 0x0180,
+    0xFB41, 0xFB41, 0xFF78, 0xFF78, 0x04C2, 0x04C2, 0xFAC9, 0xFAC9,
+    0xFC96, 0xFC96, 0x00DC, 0x00DC, 0xFB5D, 0xFB5D, 0xF985, 0xF985,
+    0xFA3E, 0xFA3E, 0xFA3E, 0xFA3E, 0xFA3E, 0xFA3E, 0xFA3E, 0xFA3E,
+    0xFA3E, 0xFA3E, 0xFA3E, 0xFA3E, 0xFA3E, 0xFA3E, 0xFA3E, 0xFA3E,
+    0x05BC, 0x05BC, 0x05BC, 0x05BC, 0x05BC, 0x05BC, 0x05BC, 0x05BC,
+    0x05BC, 0x05BC, 0x05BC, 0x05BC, 0x05BC, 0x05BC, 0x05BC, 0x05BC,
+    0xF9FA, 0xF9FA, 0xF9FA, 0xF9FA, 0xF9FA, 0xF9FA, 0xF9FA, 0xF9FA,
+    0x019B, 0x019B, 0x019B, 0x019B, 0x019B, 0x019B, 0x019B, 0x019B,
+    0xFF33, 0xFF33, 0xFF33, 0xFF33, 0xFF33, 0xFF33, 0xFF33, 0xFF33,
+    0xF9DD, 0xF9DD, 0xF9DD, 0xF9DD, 0xF9DD, 0xF9DD, 0xF9DD, 0xF9DD,
+    0xFE72, 0xFE72, 0xFE72, 0xFE72, 0x03C1, 0x03C1, 0x03C1, 0x03C1,
+    0xFA1C, 0xFA1C, 0xFA1C, 0xFA1C, 0xFD2B, 0xFD2B, 0xFD2B, 0xFD2B,
+    0x01C0, 0x01C0, 0x01C0, 0x01C0, 0xFBD7, 0xFBD7, 0xFBD7, 0xFBD7,
+    0x02A5, 0x02A5, 0x02A5, 0x02A5, 0xFB05, 0xFB05, 0xFB05, 0xFB05,
+    0xFB5F, 0xFB5F, 0xFA06, 0xFA06, 0xFB02, 0xFB02, 0x031A, 0x031A,
+    0xFA1A, 0xFA1A, 0xFCAA, 0xFCAA, 0xFC9A, 0xFC9A, 0x01DE, 0x01DE,
+    0xFF94, 0xFF94, 0xFECC, 0xFECC, 0x03E4, 0x03E4, 0x03DF, 0x03DF,
+    0x03BE, 0x03BE, 0xFA4C, 0xFA4C, 0x05F2, 0x05F2, 0x065C, 0x065C
+};
+
+/* the AVX-512 inverse transform zetas; for each block, the length 2, 4, 8 and 16 layer zetas */
+static const uint16_t kyber_invntt_zetas_avx512[512] =
+{
+    0x065C, 0x065C, 0x05F2, 0x05F2, 0xFA4C, 0xFA4C, 0x03BE, 0x03BE,
+    0x03DF, 0x03DF, 0x03E4, 0x03E4, 0xFECC, 0xFECC, 0xFF94, 0xFF94,
+    0x01DE, 0x01DE, 0xFC9A, 0xFC9A, 0xFCAA, 0xFCAA, 0xFA1A, 0xFA1A,
+    0x031A, 0x031A, 0xFB02, 0xFB02, 0xFA06, 0xFA06, 0xFB5F, 0xFB5F,
+    0xFB05, 0xFB05, 0xFB05, 0xFB05, 0x02A5, 0x02A5, 0x02A5, 0x02A5,
+    0xFBD7, 0xFBD7, 0xFBD7, 0xFBD7, 0x01C0, 0x01C0, 0x01C0, 0x01C0,
+    0xFD2B, 0xFD2B, 0xFD2B, 0xFD2B, 0xFA1C, 0xFA1C, 0xFA1C, 0xFA1C,
+    0x03C1, 0x03C1, 0x03C1, 0x03C1, 0xFE72, 0xFE72, 0xFE72, 0xFE72,
+    0xF9DD, 0xF9DD, 0xF9DD, 0xF9DD, 0xF9DD, 0xF9DD, 0xF9DD, 0xF9DD,
+    0xFF33, 0xFF33, 0xFF33, 0xFF33, 0xFF33, 0xFF33, 0xFF33, 0xFF33,
+    0x019B, 0x019B, 0x019B, 0x019B, 0x019B, 0x019B, 0x019B, 0x019B,
+    0xF9FA, 0xF9FA, 0xF9FA, 0xF9FA, 0xF9FA, 0xF9FA, 0xF9FA, 0xF9FA,
+    0x05BC, 0x05BC, 0x05BC, 0x05BC, 0x05BC, 0x05BC, 0x05BC, 0x05BC,
+    0x05BC, 0x05BC, 0x05BC, 0x05BC, 0x05BC, 0x05BC, 0x05BC, 0x05BC,
+    0xFA3E, 0xFA3E, 0xFA3E, 0xFA3E, 0xFA3E, 0xFA3E, 0xFA3E, 0xFA3E,
+    0xFA3E, 0xFA3E, 0xFA3E, 0xFA3E, 0xFA3E, 0xFA3E, 0xFA3E, 0xFA3E,
+    0xF985, 0xF985, 0xFB5D, 0xFB5D, 0x00DC, 0x00DC, 0xFC96, 0xFC96,
+    0xFAC9, 0xFAC9, 0x04C2, 0x04C2, 0xFF78, 0xFF78, 0xFB41, 0xFB41,
+    0x0180, 0x0180, 0xFA47, 0xFA47, 0xFAFB, 0xFAFB, 0x052A, 0x052A,
+    0x0262, 0x0262, 0x025B, 0x025B, 0x0449, 0x0449, 0x0331, 0x0331,
+    0xFC49, 0xFC49, 0xFC49, 0xFC49, 0xFF09, 0xFF09, 0xFF09, 0xFF09,
+    0xFA73, 0xFA73, 0xFA73, 0xFA73, 0x006B, 0x006B, 0x006B, 0x006B,
+    0x033E, 0x033E, 0x033E, 0x033E, 0xFEF1, 0xFEF1, 0xFEF1, 0xFEF1,
+    0xFFA6, 0xFFA6, 0xFFA6, 0xFFA6, 0xFCAB, 0xFCAB, 0xFCAB, 0xFCAB,
+    0x0260, 0x0260, 0x0260, 0x0260, 0x0260, 0x0260, 0x0260, 0x0260,
+    0x02DC, 0x02DC, 0x02DC, 0x02DC, 0x02DC, 0x02DC, 0x02DC, 0x02DC,
+    0x03F9, 0x03F9, 0x03F9, 0x03F9, 0x03F9, 0x03F9, 0x03F9, 0x03F9,
+    0xFD57, 0xFD57, 0xFD57, 0xFD57, 0xFD57, 0xFD57, 0xFD57, 0xFD57,
+    0xFB4E, 0xFB4E, 0xFB4E, 0xFB4E, 0xFB4E, 0xFB4E, 0xFB4E, 0xFB4E,
+    0xFB4E, 0xFB4E, 0xFB4E, 0xFB4E, 0xFB4E, 0xFB4E, 0xFB4E, 0xFB4E,
+    0x03C2, 0x03C2, 0x03C2, 0x03C2, 0x03C2, 0x03C2, 0x03C2, 0x03C2,
+    0x03C2, 0x03C2, 0x03C2, 0x03C2, 0x03C2, 0x03C2, 0x03C2, 0x03C2,
+    0xFFB5, 0xFFB5, 0xFF64, 0xFF64, 0x0149, 0x0149, 0x01A2, 0x01A2,
+    0x015D, 0x015D, 0xFC98, 0xFC98, 0x0284, 0x0284, 0xF9CA, 0xF9CA,
+    0x045F, 0x045F, 0xFDA6, 0xFDA6, 0x05CB, 0x05CB, 0xFCF7, 0xFCF7,
+    0xFF6D, 0xFF6D, 0x0487, 0x0487, 0x030A, 0x030A, 0xFF0A, 0xFF0A,
+    0x05BD, 0x05BD, 0x05BD, 0x05BD, 0x007E, 0x007E, 0x007E, 0x007E,
+    0xFB76, 0xFB76, 0xFB76, 0xFB76, 0xF9AE, 0xF9AE, 0xF9AE, 0xF9AE,
+    0xFD66, 0xFD66, 0xFD66, 0xFD66, 0xFEC0, 0xFEC0, 0xFEC0, 0xFEC0,
+    0xFFF8, 0xFFF8, 0xFFF8, 0xFFF8, 0x0204, 0x0204, 0x0204, 0x0204,
+    0xFF7E, 0xFF7E, 0xFF7E, 0xFF7E, 0xFF7E, 0xFF7E, 0xFF7E, 0xFF7E,
+    0xF9BE, 0xF9BE, 0xF9BE, 0xF9BE, 0xF9BE, 0xF9BE, 0xF9BE, 0xF9BE,
+    0x05B2, 0x05B2, 0x05B2, 0x05B2, 0x05B2, 0x05B2, 0x05B2, 0x05B2,
+    0xFCC3, 0xFCC3, 0xFCC3, 0xFCC3, 0xFCC3, 0xFCC3, 0xFCC3, 0xFCC3,
+    0x00B6, 0x00B6, 0x00B6, 0x00B6, 0x00B6, 0x00B6, 0x00B6, 0x00B6,
+    0x00B6, 0x00B6, 0x00B6, 0x00B6, 0x00B6, 0x00B6, 0x00B6, 0x00B6,
+    0x0629, 0x0629, 0x0629, 0x0629, 0x0629, 0x0629, 0x0629, 0x0629,
+    0x0629, 0x0629, 0x0629, 0x0629, 0x0629, 0x0629, 0x0629, 0x0629,
+    0x0675, 0x0675, 0x0626, 0x0626, 0xFE34, 0xFE34, 0xFEDD, 0xFEDD,
+    0xFF15, 0xFF15, 0x00B1, 0x00B1, 0x024B, 0x024B, 0x01A6, 0x01A6,
+    0x0069, 0x0069, 0x060E, 0x060E, 0x0367, 0x0367, 0xFB1D, 0xFB1D,
+    0x034B, 0x034B, 0x022B, 0x022B, 0x01AE, 0x01AE, 0xFBB1, 0xFBB1,
+    0xF9F8, 0xF9F8, 0xF9F8, 0xF9F8, 0xFEE6, 0xFEE6, 0xFEE6, 0xFEE6,
+    0x05D3, 0x05D3, 0x05D3, 0x05D3, 0xFAF3, 0xFAF3, 0xFAF3, 0xFAF3,
+    0x03F7, 0x03F7, 0x03F7, 0x03F7, 0xFDD8, 0xFDD8, 0xFDD8, 0xFDD8,
+    0x028C, 0x028C, 0x028C, 0x028C, 0x04C7, 0x04C7, 0x04C7, 0x04C7,
+    0x017F, 0x017F, 0x017F, 0x017F, 0x017F, 0x017F, 0x017F, 0x017F,
+    0x0108, 0x0108, 0x0108, 0x0108, 0x0108, 0x0108, 0x0108, 0x0108,
+    0xFAD3, 0xFAD3, 0xFAD3, 0xFAD3, 0xFAD3, 0xFAD3, 0xFAD3, 0xFAD3,
+    0x023D, 0x023D, 0x023D, 0x023D, 0x023D, 0x023D, 0x023D, 0x023D,
+    0x026E, 0x026E, 0x026E, 0x026E, 0x026E, 0x026E, 0x026E, 0x026E,
+    0x026E, 0x026E, 0x026E, 0x026E, 0x026E, 0x026E, 0x026E, 0x026E,
+    0xFF55, 0xFF55, 0xFF55, 0xFF55, 0xFF55, 0xFF55, 0xFF55, 0xFF55,
+    0xFF55, 0xFF55, 0xFF55, 0xFF55, 0xFF55, 0xFF55, 0xFF55, 0xFF55
+};
+#else
+/* the zetas of the layers computed inside a vector; for each 32 coefficient block,
+   the length 8, 4 and 2 layer zetas, arranged to match the shuffled coefficients */
+static const uint16_t kyber_ntt_zetas_avx2[384] =
+{
+    0x023D, 0x023D, 0x023D, 0x023D, 0x023D, 0x023D, 0x023D, 0x023D,
+    0xFAD3, 0xFAD3, 0xFAD3, 0xFAD3, 0xFAD3, 0xFAD3, 0xFAD3, 0xFAD3,
+    0x04C7, 0x04C7, 0x04C7, 0x04C7, 0x028C, 0x028C, 0x028C, 0x028C,
+    0xFDD8, 0xFDD8, 0xFDD8, 0xFDD8, 0x03F7, 0x03F7, 0x03F7, 0x03F7,
+    0xFBB1, 0xFBB1, 0x01AE, 0x01AE, 0x022B, 0x022B, 0x034B, 0x034B,
+    0xFB1D, 0xFB1D, 0x0367, 0x0367, 0x060E, 0x060E, 0x0069, 0x0069,
+    0x0108, 0x0108, 0x0108, 0x0108, 0x0108, 0x0108, 0x0108, 0x0108,
+    0x017F, 0x017F, 0x017F, 0x017F, 0x017F, 0x017F, 0x017F, 0x017F,
+    0xFAF3, 0xFAF3, 0xFAF3, 0xFAF3, 0x05D3, 0x05D3, 0x05D3, 0x05D3,
+    0xFEE6, 0xFEE6, 0xFEE6, 0xFEE6, 0xF9F8, 0xF9F8, 0xF9F8, 0xF9F8,
+    0x01A6, 0x01A6, 0x024B, 0x024B, 0x00B1, 0x00B1, 0xFF15, 0xFF15,
+    0xFEDD, 0xFEDD, 0xFE34, 0xFE34, 0x0626, 0x0626, 0x0675, 0x0675,
+    0xFCC3, 0xFCC3, 0xFCC3, 0xFCC3, 0xFCC3, 0xFCC3, 0xFCC3, 0xFCC3,
+    0x05B2, 0x05B2, 0x05B2, 0x05B2, 0x05B2, 0x05B2, 0x05B2, 0x05B2,
+    0x0204, 0x0204, 0x0204, 0x0204, 0xFFF8, 0xFFF8, 0xFFF8, 0xFFF8,
+    0xFEC0, 0xFEC0, 0xFEC0, 0xFEC0, 0xFD66, 0xFD66, 0xFD66, 0xFD66,
+    0xFF0A, 0xFF0A, 0x030A, 0x030A, 0x0487, 0x0487, 0xFF6D, 0xFF6D,
+    0xFCF7, 0xFCF7, 0x05CB, 0x05CB, 0xFDA6, 0xFDA6, 0x045F, 0x045F,
+    0xF9BE, 0xF9BE, 0xF9BE, 0xF9BE, 0xF9BE, 0xF9BE, 0xF9BE, 0xF9BE,
+    0xFF7E, 0xFF7E, 0xFF7E, 0xFF7E, 0xFF7E, 0xFF7E, 0xFF7E, 0xFF7E,
+    0xF9AE, 0xF9AE, 0xF9AE, 0xF9AE, 0xFB76, 0xFB76, 0xFB76, 0xFB76,
+    0x007E, 0x007E, 0x007E, 0x007E, 0x05BD, 0x05BD, 0x05BD, 0x05BD,
+    0xF9CA, 0xF9CA, 0x0284, 0x0284, 0xFC98, 0xFC98, 0x015D, 0x015D,
+    0x01A2, 0x01A2, 0x0149, 0x0149, 0xFF64, 0xFF64, 0xFFB5, 0xFFB5,
+    0xFD57, 0xFD57, 0xFD57, 0xFD57, 0xFD57, 0xFD57, 0xFD57, 0xFD57,
+    0x03F9, 0x03F9, 0x03F9, 0x03F9, 0x03F9, 0x03F9, 0x03F9, 0x03F9,
+    0xFCAB, 0xFCAB, 0xFCAB, 0xFCAB, 0xFFA6, 0xFFA6, 0xFFA6, 0xFFA6,
+    0xFEF1, 0xFEF1, 0xFEF1, 0xFEF1, 0x033E, 0x033E, 0x033E, 0x033E,
+    0x0331, 0x0331, 0x0449, 0x0449, 0x025B, 0x025B, 0x0262, 0x0262,
+    0x052A, 0x052A, 0xFAFB, 0xFAFB, 0xFA47, 0xFA47, 0x0180, 0x0180,
+    0x02DC, 0x02DC, 0x02DC, 0x02DC, 0x02DC, 0x02DC, 0x02DC, 0x02DC,
+    0x0260, 0x0260, 0x0260, 0x0260, 0x0260, 0x0260, 0x0260, 0x0260,
+    0x006B, 0x006B, 0x006B, 0x006B, 0xFA73, 0xFA73, 0xFA73, 0xFA73,
+    0xFF09, 0xFF09, 0xFF09, 0xFF09, 0xFC49, 0xFC49, 0xFC49, 0xFC49,
+    0xFB41, 0xFB41, 0xFF78, 0xFF78, 0x04C2, 0x04C2, 0xFAC9, 0xFAC9,
+    0xFC96, 0xFC96, 0x00DC, 0x00DC, 0xFB5D, 0xFB5D, 0xF985, 0xF985,
+    0xF9FA, 0xF9FA, 0xF9FA, 0xF9FA, 0xF9FA, 0xF9FA, 0xF9FA, 0xF9FA,
+    0x019B, 0x019B, 0x019B, 0x019B, 0x019B, 0x019B, 0x019B, 0x019B,
+    0xFE72, 0xFE72, 0xFE72, 0xFE72, 0x03C1, 0x03C1, 0x03C1, 0x03C1,
+    0xFA1C, 0xFA1C, 0xFA1C, 0xFA1C, 0xFD2B, 0xFD2B, 0xFD2B, 0xFD2B,
+    0xFB5F, 0xFB5F, 0xFA06, 0xFA06, 0xFB02, 0xFB02, 0x031A, 0x031A,
+    0xFA1A, 0xFA1A, 0xFCAA, 0xFCAA, 0xFC9A, 0xFC9A, 0x01DE, 0x01DE,
+    0xFF33, 0xFF33, 0xFF33, 0xFF33, 0xFF33, 0xFF33, 0xFF33, 0xFF33,
+    0xF9DD, 0xF9DD, 0xF9DD, 0xF9DD, 0xF9DD, 0xF9DD, 0xF9DD, 0xF9DD,
+    0x01C0, 0x01C0, 0x01C0, 0x01C0, 0xFBD7, 0xFBD7, 0xFBD7, 0xFBD7,
+    0x02A5, 0x02A5, 0x02A5, 0x02A5, 0xFB05, 0xFB05, 0xFB05, 0xFB05,
+    0xFF94, 0xFF94, 0xFECC, 0xFECC, 0x03E4, 0x03E4, 0x03DF, 0x03DF,
+    0x03BE, 0x03BE, 0xFA4C, 0xFA4C, 0x05F2, 0x05F2, 0x065C, 0x065C
+};
+
+/* the inverse transform zetas; for each block, the length 2, 4 and 8 layer zetas */
+static const uint16_t kyber_invntt_zetas_avx2[384] =
+{
+    0x065C, 0x065C, 0x05F2, 0x05F2, 0xFA4C, 0xFA4C, 0x03BE, 0x03BE,
+    0x03DF, 0x03DF, 0x03E4, 0x03E4, 0xFECC, 0xFECC, 0xFF94, 0xFF94,
+    0xFB05, 0xFB05, 0xFB05, 0xFB05, 0x02A5, 0x02A5, 0x02A5, 0x02A5,
+    0xFBD7, 0xFBD7, 0xFBD7, 0xFBD7, 0x01C0, 0x01C0, 0x01C0, 0x01C0,
+    0xF9DD, 0xF9DD, 0xF9DD, 0xF9DD, 0xF9DD, 0xF9DD, 0xF9DD, 0xF9DD,
+    0xFF33, 0xFF33, 0xFF33, 0xFF33, 0xFF33, 0xFF33, 0xFF33, 0xFF33,
+    0x01DE, 0x01DE, 0xFC9A, 0xFC9A, 0xFCAA, 0xFCAA, 0xFA1A, 0xFA1A,
+    0x031A, 0x031A, 0xFB02, 0xFB02, 0xFA06, 0xFA06, 0xFB5F, 0xFB5F,
+    0xFD2B, 0xFD2B, 0xFD2B, 0xFD2B, 0xFA1C, 0xFA1C, 0xFA1C, 0xFA1C,
+    0x03C1, 0x03C1, 0x03C1, 0x03C1, 0xFE72, 0xFE72, 0xFE72, 0xFE72,
+    0x019B, 0x019B, 0x019B, 0x019B, 0x019B, 0x019B, 0x019B, 0x019B,
+    0xF9FA, 0xF9FA, 0xF9FA, 0xF9FA, 0xF9FA, 0xF9FA, 0xF9FA, 0xF9FA,
+    0xF985, 0xF985, 0xFB5D, 0xFB5D, 0x00DC, 0x00DC, 0xFC96, 0xFC96,
+    0xFAC9, 0xFAC9, 0x04C2, 0x04C2, 0xFF78, 0xFF78, 0xFB41, 0xFB41,
+    0xFC49, 0xFC49, 0xFC49, 0xFC49, 0xFF09, 0xFF09, 0xFF09, 0xFF09,
+    0xFA73, 0xFA73, 0xFA73, 0xFA73, 0x006B, 0x006B, 0x006B, 0x006B,
+    0x0260, 0x0260, 0x0260, 0x0260, 0x0260, 0x0260, 0x0260, 0x0260,
+    0x02DC, 0x02DC, 0x02DC, 0x02DC, 0x02DC, 0x02DC, 0x02DC, 0x02DC,
+    0x0180, 0x0180, 0xFA47, 0xFA47, 0xFAFB, 0xFAFB, 0x052A, 0x052A,
+    0x0262, 0x0262, 0x025B, 0x025B, 0x0449, 0x0449, 0x0331, 0x0331,
+    0x033E, 0x033E, 0x033E, 0x033E, 0xFEF1, 0xFEF1, 0xFEF1, 0xFEF1,
+    0xFFA6, 0xFFA6, 0xFFA6, 0xFFA6, 0xFCAB, 0xFCAB, 0xFCAB, 0xFCAB,
+    0x03F9, 0x03F9, 0x03F9, 0x03F9, 0x03F9, 0x03F9, 0x03F9, 0x03F9,
+    0xFD57, 0xFD57, 0xFD57, 0xFD57, 0xFD57, 0xFD57, 0xFD57, 0xFD57,
+    0xFFB5, 0xFFB5, 0xFF64, 0xFF64, 0x0149, 0x0149, 0x01A2, 0x01A2,
+    0x015D, 0x015D, 0xFC98, 0xFC98, 0x0284, 0x0284, 0xF9CA, 0xF9CA,
+    0x05BD, 0x05BD, 0x05BD, 0x05BD, 0x007E, 0x007E, 0x007E, 0x007E,
+    0xFB76, 0xFB76, 0xFB76, 0xFB76, 0xF9AE, 0xF9AE, 0xF9AE, 0xF9AE,
+    0xFF7E, 0xFF7E, 0xFF7E, 0xFF7E, 0xFF7E, 0xFF7E, 0xFF7E, 0xFF7E,
+    0xF9BE, 0xF9BE, 0xF9BE, 0xF9BE, 0xF9BE, 0xF9BE, 0xF9BE, 0xF9BE,
+    0x045F, 0x045F, 0xFDA6, 0xFDA6, 0x05CB, 0x05CB, 0xFCF7, 0xFCF7,
+    0xFF6D, 0xFF6D, 0x0487, 0x0487, 0x030A, 0x030A, 0xFF0A, 0xFF0A,
+    0xFD66, 0xFD66, 0xFD66, 0xFD66, 0xFEC0, 0xFEC0, 0xFEC0, 0xFEC0,
+    0xFFF8, 0xFFF8, 0xFFF8, 0xFFF8, 0x0204, 0x0204, 0x0204, 0x0204,
+    0x05B2, 0x05B2, 0x05B2, 0x05B2, 0x05B2, 0x05B2, 0x05B2, 0x05B2,
+    0xFCC3, 0xFCC3, 0xFCC3, 0xFCC3, 0xFCC3, 0xFCC3, 0xFCC3, 0xFCC3,
+    0x0675, 0x0675, 0x0626, 0x0626, 0xFE34, 0xFE34, 0xFEDD, 0xFEDD,
+    0xFF15, 0xFF15, 0x00B1, 0x00B1, 0x024B, 0x024B, 0x01A6, 0x01A6,
+    0xF9F8, 0xF9F8, 0xF9F8, 0xF9F8, 0xFEE6, 0xFEE6, 0xFEE6, 0xFEE6,
+    0x05D3, 0x05D3, 0x05D3, 0x05D3, 0xFAF3, 0xFAF3, 0xFAF3, 0xFAF3,
+    0x017F, 0x017F, 0x017F, 0x017F, 0x017F, 0x017F, 0x017F, 0x017F,
+    0x0108, 0x0108, 0x0108, 0x0108, 0x0108, 0x0108, 0x0108, 0x0108,
+    0x0069, 0x0069, 0x060E, 0x060E, 0x0367, 0x0367, 0xFB1D, 0xFB1D,
+    0x034B, 0x034B, 0x022B, 0x022B, 0x01AE, 0x01AE, 0xFBB1, 0xFBB1,
+    0x03F7, 0x03F7, 0x03F7, 0x03F7, 0xFDD8, 0xFDD8, 0xFDD8, 0xFDD8,
+    0x028C, 0x028C, 0x028C, 0x028C, 0x04C7, 0x04C7, 0x04C7, 0x04C7,
+    0xFAD3, 0xFAD3, 0xFAD3, 0xFAD3, 0xFAD3, 0xFAD3, 0xFAD3, 0xFAD3,
+    0x023D, 0x023D, 0x023D, 0x023D, 0x023D, 0x023D, 0x023D, 0x023D
+};
+#endif
+
+/* the base multiplication zetas; the signed zeta of each coefficient pair, in every lane of the pair */
+static const uint16_t kyber_basemul_zetas_avx2[256] =
+{
+    0xFBB1, 0xFBB1, 0x044F, 0x044F, 0x01AE, 0x01AE, 0xFE52, 0xFE52,
+    0x022B, 0x022B, 0xFDD5, 0xFDD5, 0x034B, 0x034B, 0xFCB5, 0xFCB5,
+    0xFB1D, 0xFB1D, 0x04E3, 0x04E3, 0x0367, 0x0367, 0xFC99, 0xFC99,
+    0x060E, 0x060E, 0xF9F2, 0xF9F2, 0x0069, 0x0069, 0xFF97, 0xFF97,
+    0x01A6, 0x01A6, 0xFE5A, 0xFE5A, 0x024B, 0x024B, 0xFDB5, 0xFDB5,
+    0x00B1, 0x00B1, 0xFF4F, 0xFF4F, 0xFF15, 0xFF15, 0x00EB, 0x00EB,
+    0xFEDD, 0xFEDD, 0x0123, 0x0123, 0xFE34, 0xFE34, 0x01CC, 0x01CC,
+    0x0626, 0x0626, 0xF9DA, 0xF9DA, 0x0675, 0x0675, 0xF98B, 0xF98B,
+    0xFF0A, 0xFF0A, 0x00F6, 0x00F6, 0x030A, 0x030A, 0xFCF6, 0xFCF6,
+    0x0487, 0x0487, 0xFB79, 0xFB79, 0xFF6D, 0xFF6D, 0x0093, 0x0093,
+    0xFCF7, 0xFCF7, 0x0309, 0x0309, 0x05CB, 0x05CB, 0xFA35, 0xFA35,
+    0xFDA6, 0xFDA6, 0x025A, 0x025A, 0x045F, 0x045F, 0xFBA1, 0xFBA1,
+    0xF9CA, 0xF9CA, 0x0636, 0x0636, 0x0284, 0x0284, 0xFD7C, 0xFD7C,
+    0xFC98, 0xFC98, 0x0368, 0x0368, 0x015D, 0x015D, 0xFEA3, 0xFEA3,
+    0x01A2, 0x01A2, 0xFE5E, 0xFE5E, 0x0149, 0x0149, 0xFEB7, 0xFEB7,
+    0xFF64, 0xFF64, 0x009C, 0x009C, 0xFFB5, 0xFFB5, 0x004B, 0x004B,
+    0x0331, 0x0331, 0xFCCF, 0xFCCF, 0x0449, 0x0449, 0xFBB7, 0xFBB7,
+    0x025B, 0x025B, 0xFDA5, 0xFDA5, 0x0262, 0x0262, 0xFD9E, 0xFD9E,
+    0x052A, 0x052A, 0xFAD6, 0xFAD6, 0xFAFB, 0xFAFB, 0x0505, 0x0505,
+    0xFA47, 0xFA47, 0x05B9, 0x05B9, 0x0180, 0x0180, 0xFE80, 0xFE80,
+    0xFB41, 0xFB41, 0x04BF, 0x04BF, 0xFF78, 0xFF78, 0x0088, 0x0088,
+    0x04C2, 0x04C2, 0xFB3E, 0xFB3E, 0xFAC9, 0xFAC9, 0x0537, 0x0537,
+    0xFC96, 0xFC96, 0x036A, 0x036A, 0x00DC, 0x00DC, 0xFF24, 0xFF24,
+    0xFB5D, 0xFB5D, 0x04A3, 0x04A3, 0xF985, 0xF985, 0x067B, 0x067B,
+    0xFB5F, 0xFB5F, 0x04A1, 0x04A1, 0xFA06, 0xFA06, 0x05FA, 0x05FA,
+    0xFB02, 0xFB02, 0x04FE, 0x04FE, 0x031A, 0x031A, 0xFCE6, 0xFCE6,
+    0xFA1A, 0xFA1A, 0x05E6, 0x05E6, 0xFCAA, 0xFCAA, 0x0356, 0x0356,
+    0xFC9A, 0xFC9A, 0x0366, 0x0366, 0x01DE, 0x01DE, 0xFE22, 0xFE22,
+    0xFF94, 0xFF94, 0x006C, 0x006C, 0xFECC, 0xFECC, 0x0134, 0x0134,
+    0x03E4, 0x03E4, 0xFC1C, 0xFC1C, 0x03DF, 0x03DF, 0xFC21, 0xFC21,
+    0x03BE, 0x03BE, 0xFC42, 0xFC42, 0xFA4C, 0xFA4C, 0x05B4, 0x05B4,
+    0x05F2, 0x05F2, 0xFA0E, 0xFA0E, 0x065C, 0x065C, 0xF9A4, 0xF9A4
+};
+
 
 /* reduce.c */
 
@@ -75,17 +333,6 @@ static int16_t kyber_montgomery_reduce(int32_t a)
     return (int16_t)t;
 }
 
-static int16_t kyber_barrett_reduce(int16_t a)
-{
-    int16_t t;
-    const int16_t V = ((1U << 26) + QSC_KYBER_Q / 2) / QSC_KYBER_Q;
-
-    t = (int16_t)(((int32_t)V * a + (1 << 25)) >> 26);
-    t *= QSC_KYBER_Q;
-
-    return (a - t);
-}
-
 /* cbd.c */
 
 static void kyber_cbd2_avx2(qsc_kyber_poly *r, const uint8_t buf[4 * QSC_KYBER_N / 8])
@@ -195,77 +442,473 @@ static void kyber_cbd3_avx2(qsc_kyber_poly* r, const uint8_t buf[6 * QSC_KYBER_N
 
 /* kyber_ntt.c */
 
-static int16_t kyber_fqmul(int16_t a, int16_t b)
+static __m256i kyber_fqmul_avx2(__m256i a, __m256i b, __m256i bqinv)
+{
+    /* the montgomery product of each lane; identical to montgomery_reduce(a * b) */
+    __m256i t;
+    __m256i u;
+
+    t = _mm256_mulhi_epi16(a, b);
+    u = _mm256_mullo_epi16(a, bqinv);
+    u = _mm256_mulhi_epi16(u, _mm256_set1_epi16(QSC_KYBER_Q));
+
+    return _mm256_sub_epi16(t, u);
+}
+
+static __m256i kyber_barrett_reduce_avx2(__m256i a)
+{
+    /* ((v * a + 2^25) >> 26) computed as (((v * a) >> 16) + 2^9) >> 10 */
+    const __m256i V = _mm256_set1_epi16((int16_t)(((1U << 26) + QSC_KYBER_Q / 2) / QSC_KYBER_Q));
+    __m256i t;
+
+    t = _mm256_mulhi_epi16(a, V);
+    t = _mm256_add_epi16(t, _mm256_set1_epi16(1 << 9));
+    t = _mm256_srai_epi16(t, 10);
+    t = _mm256_mullo_epi16(t, _mm256_set1_epi16(QSC_KYBER_Q));
+
+    return _mm256_sub_epi16(a, t);
+}
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+static __m512i kyber_fqmul_avx512(__m512i a, __m512i b, __m512i bqinv)
+{
+    __m512i t;
+    __m512i u;
+
+    t = _mm512_mulhi_epi16(a, b);
+    u = _mm512_mullo_epi16(a, bqinv);
+    u = _mm512_mulhi_epi16(u, _mm512_set1_epi16(QSC_KYBER_Q));
+
+    return _mm512_sub_epi16(t, u);
+}
+
+static __m512i kyber_barrett_reduce_avx512(__m512i a)
+{
+    const __m512i V = _mm512_set1_epi16((int16_t)(((1U << 26) + QSC_KYBER_Q / 2) / QSC_KYBER_Q));
+    __m512i t;
+
+    t = _mm512_mulhi_epi16(a, V);
+    t = _mm512_add_epi16(t, _mm512_set1_epi16(1 << 9));
+    t = _mm512_srai_epi16(t, 10);
+    t = _mm512_mullo_epi16(t, _mm512_set1_epi16(QSC_KYBER_Q));
+
+    return _mm512_sub_epi16(a, t);
+}
+
+static void kyber_butterfly_avx512(__m512i* a, __m512i* b, __m512i zeta, __m512i zqinv)
+{
+    __m512i t;
+
+    t = kyber_fqmul_avx512(*b, zeta, zqinv);
+    *b = _mm512_sub_epi16(*a, t);
+    *a = _mm512_add_epi16(*a, t);
+}
+
+static void kyber_invbutterfly_avx512(__m512i* a, __m512i* b, __m512i zeta, __m512i zqinv)
+{
+    __m512i t;
+
+    t = *a;
+    *a = kyber_barrett_reduce_avx512(_mm512_add_epi16(t, *b));
+    *b = kyber_fqmul_avx512(_mm512_sub_epi16(*b, t), zeta, zqinv);
+}
+
+/* the 512-bit shuffles pair the coefficients of the length 16, 8, 4 and 2 layers
+   of two 32 coefficient blocks at once; like the AVX2 shuffles, each is its own inverse */
+
+static void kyber_shuffle16_avx512(__m512i* a, __m512i* b)
 {
-    return kyber_montgomery_reduce((int32_t)a * b);
+    __m512i t;
+
+    t = _mm512_shuffle_i64x2(*a, *b, 0x44);
+    *b = _mm512_shuffle_i64x2(*a, *b, 0xEE);
+    *a = t;
 }
 
-static void kyber_ntt_avx(int16_t r[QSC_KYBER_N])
+static void kyber_shuffle8_avx512(__m512i* a, __m512i* b)
 {
+    const __m512i IDXL = _mm512_set_epi64(13, 12, 5, 4, 9, 8, 1, 0);
+    const __m512i IDXH = _mm512_set_epi64(15, 14, 7, 6, 11, 10, 3, 2);
+    __m512i t;
+
+    t = _mm512_permutex2var_epi64(*a, IDXL, *b);
+    *b = _mm512_permutex2var_epi64(*a, IDXH, *b);
+    *a = t;
+}
+
+static void kyber_shuffle4_avx512(__m512i* a, __m512i* b)
+{
+    __m512i t;
+
+    t = _mm512_unpacklo_epi64(*a, *b);
+    *b = _mm512_unpackhi_epi64(*a, *b);
+    *a = t;
+}
+
+static void kyber_shuffle2_avx512(__m512i* a, __m512i* b)
+{
+    __m512i t;
+
+    t = _mm512_mask_blend_epi32(0xAAAA, *a, _mm512_slli_epi64(*b, 32));
+    *b = _mm512_mask_blend_epi32(0xAAAA, _mm512_srli_epi64(*a, 32), *b);
+    *a = t;
+}
+
+static void kyber_ntt_avx512(int16_t r[QSC_KYBER_N])
+{
+    const __m512i QINV = _mm512_set1_epi16((int16_t)KYBER_QINV);
+    __m512i v[8];
+    __m512i z;
+    size_t i;
     size_t j;
-    size_t k;
-    int16_t t;
-    int16_t zeta;
 
-    k = 1;
+    for (j = 0; j < 8; ++j)
+    {
+        v[j] = _mm512_loadu_si512((const __m512i*)&r[32 * j]);
+    }
+
+    /* layers 128, 64 and 32 between the vectors */
+    z = _mm512_set1_epi16((int16_t)kyber_zetas[1]);
 
-    for (size_t len = 128; len >= 2; len >>= 1)
+    for (j = 0; j < 4; ++j)
     {
-        for (size_t start = 0; start < QSC_KYBER_N; start = (j + len))
-        {
-            zeta = (int16_t)kyber_zetas[k];
-            ++k;
+        kyber_butterfly_avx512(&v[j], &v[j + 4], z, _mm512_mullo_epi16(z, QINV));
+    }
 
-            for (j = start; j < start + len; ++j)
-            {
-                t = kyber_fqmul(zeta, r[j + len]);
-                r[j + len] = r[j] - t;
-                r[j] = r[j] + t;
-            }
-        }
+    for (j = 0; j < 8; j += 4)
+    {
+        z = _mm512_set1_epi16((int16_t)kyber_zetas[2 + (j / 4)]);
+        kyber_butterfly_avx512(&v[j], &v[j + 2], z, _mm512_mullo_epi16(z, QINV));
+        kyber_butterfly_avx512(&v[j + 1], &v[j + 3], z, _mm512_mullo_epi16(z, QINV));
+    }
+
+    for (j = 0; j < 8; j += 2)
+    {
+        z = _mm512_set1_epi16((int16_t)kyber_zetas[4 + (j / 2)]);
+        kyber_butterfly_avx512(&v[j], &v[j + 1], z, _mm512_mullo_epi16(z, QINV));
+    }
+
+    /* layers 16, 8, 4 and 2 on each pair of vectors */
+    for (i = 0; i < 4; ++i)
+    {
+        kyber_shuffle16_avx512(&v[2 * i], &v[(2 * i) + 1]);
+        z = _mm512_loadu_si512((const __m512i*)&kyber_ntt_zetas_avx512[128 * i]);
+        kyber_butterfly_avx512(&v[2 * i], &v[(2 * i) + 1], z, _mm512_mullo_epi16(z, QINV));
+
+        kyber_shuffle8_avx512(&v[2 * i], &v[(2 * i) + 1]);
+        z = _mm512_loadu_si512((const __m512i*)&kyber_ntt_zetas_avx512[(128 * i) + 32]);
+        kyber_butterfly_avx512(&v[2 * i], &v[(2 * i) + 1], z, _mm512_mullo_epi16(z, QINV));
+
+        kyber_shuffle4_avx512(&v[2 * i], &v[(2 * i) + 1]);
+        z = _mm512_loadu_si512((const __m512i*)&kyber_ntt_zetas_avx512[(128 * i) + 64]);
+        kyber_butterfly_avx512(&v[2 * i], &v[(2 * i) + 1], z, _mm512_mullo_epi16(z, QINV));
+
+        kyber_shuffle2_avx512(&v[2 * i], &v[(2 * i) + 1]);
+        z = _mm512_loadu_si512((const __m512i*)&kyber_ntt_zetas_avx512[(128 * i) + 96]);
+        kyber_butterfly_avx512(&v[2 * i], &v[(2 * i) + 1], z, _mm512_mullo_epi16(z, QINV));
+
+        kyber_shuffle2_avx512(&v[2 * i], &v[(2 * i) + 1]);
+        kyber_shuffle4_avx512(&v[2 * i], &v[(2 * i) + 1]);
+        kyber_shuffle8_avx512(&v[2 * i], &v[(2 * i) + 1]);
+        kyber_shuffle16_avx512(&v[2 * i], &v[(2 * i) + 1]);
+    }
+
+    for (j = 0; j < 8; ++j)
+    {
+        _mm512_storeu_si512((__m512i*)&r[32 * j], kyber_barrett_reduce_avx512(v[j]));
     }
 }
 
-static void kyber_invntt_avx(int16_t r[QSC_KYBER_N])
+static void kyber_invntt_avx512(int16_t r[QSC_KYBER_N])
 {
+    const __m512i QINV = _mm512_set1_epi16((int16_t)KYBER_QINV);
+    const __m512i F = _mm512_set1_epi16(1441);
+    __m512i v[8];
+    __m512i z;
+    size_t i;
     size_t j;
-    size_t k;
-    int16_t t;
-    int16_t zeta;
-    const int16_t F = 1441;
 
-    k = 127;
+    for (j = 0; j < 8; ++j)
+    {
+        v[j] = _mm512_loadu_si512((const __m512i*)&r[32 * j]);
+    }
+
+    /* layers 2, 4, 8 and 16 on each pair of vectors */
+    for (i = 0; i < 4; ++i)
+    {
+        kyber_shuffle16_avx512(&v[2 * i], &v[(2 * i) + 1]);
+        kyber_shuffle8_avx512(&v[2 * i], &v[(2 * i) + 1]);
+        kyber_shuffle4_avx512(&v[2 * i], &v[(2 * i) + 1]);
+        kyber_shuffle2_avx512(&v[2 * i], &v[(2 * i) + 1]);
+
+        z = _mm512_loadu_si512((const __m512i*)&kyber_invntt_zetas_avx512[128 * i]);
+        kyber_invbutterfly_avx512(&v[2 * i], &v[(2 * i) + 1], z, _mm512_mullo_epi16(z, QINV));
+        kyber_shuffle2_avx512(&v[2 * i], &v[(2 * i) + 1]);
+
+        z = _mm512_loadu_si512((const __m512i*)&kyber_invntt_zetas_avx512[(128 * i) + 32]);
+        kyber_invbutterfly_avx512(&v[2 * i], &v[(2 * i) + 1], z, _mm512_mullo_epi16(z, QINV));
+        kyber_shuffle4_avx512(&v[2 * i], &v[(2 * i) + 1]);
+
+        z = _mm512_loadu_si512((const __m512i*)&kyber_invntt_zetas_avx512[(128 * i) + 64]);
+        kyber_invbutterfly_avx512(&v[2 * i], &v[(2 * i) + 1], z, _mm512_mullo_epi16(z, QINV));
+        kyber_shuffle8_avx512(&v[2 * i], &v[(2 * i) + 1]);
+
+        z = _mm512_loadu_si512((const __m512i*)&kyber_invntt_zetas_avx512[(128 * i) + 96]);
+        kyber_invbutterfly_avx512(&v[2 * i], &v[(2 * i) + 1], z, _mm512_mullo_epi16(z, QINV));
+        kyber_shuffle16_avx512(&v[2 * i], &v[(2 * i) + 1]);
+    }
+
+    /* layers 32, 64 and 128 between the vectors, merged with the final scaling */
+    for (j = 0; j < 8; j += 2)
+    {
+        z = _mm512_set1_epi16((int16_t)kyber_zetas[7 - (j / 2)]);
+        kyber_invbutterfly_avx512(&v[j], &v[j + 1], z, _mm512_mullo_epi16(z, QINV));
+    }
+
+    for (j = 0; j < 8; j += 4)
+    {
+        z = _mm512_set1_epi16((int16_t)kyber_zetas[3 - (j / 4)]);
+        kyber_invbutterfly_avx512(&v[j], &v[j + 2], z, _mm512_mullo_epi16(z, QINV));
+        kyber_invbutterfly_avx512(&v[j + 1], &v[j + 3], z, _mm512_mullo_epi16(z, QINV));
+    }
+
+    z = _mm512_set1_epi16((int16_t)kyber_zetas[1]);
+
+    for (j = 0; j < 4; ++j)
+    {
+        kyber_invbutterfly_avx512(&v[j], &v[j + 4], z, _mm512_mullo_epi16(z, QINV));
+    }
 
-    for (size_t len = 2; len <= 128; len <<= 1)
+    for (j = 0; j < 8; ++j)
     {
-        for (size_t start = 0; start < 256; start = (j + len))
+        v[j] = kyber_fqmul_avx512(v[j], F, _mm512_mullo_epi16(F, QINV));
+        _mm512_storeu_si512((__m512i*)&r[32 * j], v[j]);
+    }
+}
+#else
+static void kyber_butterfly_avx2(__m256i* a, __m256i* b, __m256i zeta, __m256i zqinv)
+{
+    __m256i t;
+
+    t = kyber_fqmul_avx2(*b, zeta, zqinv);
+    *b = _mm256_sub_epi16(*a, t);
+    *a = _mm256_add_epi16(*a, t);
+}
+
+static void kyber_invbutterfly_avx2(__m256i* a, __m256i* b, __m256i zeta, __m256i zqinv)
+{
+    __m256i t;
+
+    t = *a;
+    *a = kyber_barrett_reduce_avx2(_mm256_add_epi16(t, *b));
+    *b = kyber_fqmul_avx2(_mm256_sub_epi16(*b, t), zeta, zqinv);
+}
+
+/* the shuffles pair the coefficients of the length 8, 4 and 2 layers across two vectors;
+   each is its own inverse, so applying them in reverse order restores the coefficient order */
+
+static void kyber_shuffle8_avx2(__m256i* a, __m256i* b)
+{
+    __m256i t;
+
+    t = _mm256_permute2x128_si256(*a, *b, 0x20);
+    *b = _mm256_permute2x128_si256(*a, *b, 0x31);
+    *a = t;
+}
+
+static void kyber_shuffle4_avx2(__m256i* a, __m256i* b)
+{
+    __m256i t;
+
+    t = _mm256_unpacklo_epi64(*a, *b);
+    *b = _mm256_unpackhi_epi64(*a, *b);
+    *a = t;
+}
+
+static void kyber_shuffle2_avx2(__m256i* a, __m256i* b)
+{
+    __m256i t;
+
+    t = _mm256_blend_epi32(*a, _mm256_slli_epi64(*b, 32), 0xAA);
+    *b = _mm256_blend_epi32(_mm256_srli_epi64(*a, 32), *b, 0xAA);
+    *a = t;
+}
+
+static void kyber_ntt_avx2(int16_t r[QSC_KYBER_N])
+{
+    const __m256i QINV = _mm256_set1_epi16((int16_t)KYBER_QINV);
+    __m256i v[8];
+    __m256i a;
+    __m256i b;
+    __m256i z;
+    size_t i;
+    size_t j;
+
+    /* layers 128, 64 and 32; each pass holds every second vector */
+    for (i = 0; i < 2; ++i)
+    {
+        for (j = 0; j < 8; ++j)
         {
-            zeta = (int16_t)kyber_zetas[k];
-            --k;
+            v[j] = _mm256_load_si256((const __m256i*)&r[(16 * i) + (32 * j)]);
+        }
 
-            for (j = start; j < start + len; ++j)
-            {
-                t = r[j];
-                r[j] = kyber_barrett_reduce(t + r[j + len]);
-                r[j + len] = r[j + len] - t;
-                r[j + len] = kyber_fqmul(zeta, r[j + len]);
-            }
+        z = _mm256_set1_epi16((int16_t)kyber_zetas[1]);
+
+        for (j = 0; j < 4; ++j)
+        {
+            kyber_butterfly_avx2(&v[j], &v[j + 4], z, _mm256_mullo_epi16(z, QINV));
+        }
+
+        for (j = 0; j < 8; j += 4)
+        {
+            z = _mm256_set1_epi16((int16_t)kyber_zetas[2 + (j / 4)]);
+            kyber_butterfly_avx2(&v[j], &v[j + 2], z, _mm256_mullo_epi16(z, QINV));
+            kyber_butterfly_avx2(&v[j + 1], &v[j + 3], z, _mm256_mullo_epi16(z, QINV));
+        }
+
+        for (j = 0; j < 8; j += 2)
+        {
+            z = _mm256_set1_epi16((int16_t)kyber_zetas[4 + (j / 2)]);
+            kyber_butterfly_avx2(&v[j], &v[j + 1], z, _mm256_mullo_epi16(z, QINV));
+        }
+
+        for (j = 0; j < 8; ++j)
+        {
+            _mm256_store_si256((__m256i*)&r[(16 * i) + (32 * j)], v[j]);
         }
     }
 
-    for (j = 0; j < 256; ++j)
+    /* layers 16, 8, 4 and 2 on each 32 coefficient block */
+    for (i = 0; i < QSC_KYBER_N / 32; ++i)
+    {
+        a = _mm256_load_si256((const __m256i*)&r[32 * i]);
+        b = _mm256_load_si256((const __m256i*)&r[(32 * i) + 16]);
+
+        z = _mm256_set1_epi16((int16_t)kyber_zetas[8 + i]);
+        kyber_butterfly_avx2(&a, &b, z, _mm256_mullo_epi16(z, QINV));
+
+        kyber_shuffle8_avx2(&a, &b);
+        z = _mm256_loadu_si256((const __m256i*)&kyber_ntt_zetas_avx2[48 * i]);
+        kyber_butterfly_avx2(&a, &b, z, _mm256_mullo_epi16(z, QINV));
+
+        kyber_shuffle4_avx2(&a, &b);
+        z = _mm256_loadu_si256((const __m256i*)&kyber_ntt_zetas_avx2[(48 * i) + 16]);
+        kyber_butterfly_avx2(&a, &b, z, _mm256_mullo_epi16(z, QINV));
+
+        kyber_shuffle2_avx2(&a, &b);
+        z = _mm256_loadu_si256((const __m256i*)&kyber_ntt_zetas_avx2[(48 * i) + 32]);
+        kyber_butterfly_avx2(&a, &b, z, _mm256_mullo_epi16(z, QINV));
+
+        kyber_shuffle2_avx2(&a, &b);
+        kyber_shuffle4_avx2(&a, &b);
+        kyber_shuffle8_avx2(&a, &b);
+
+        _mm256_store_si256((__m256i*)&r[32 * i], a);
+        _mm256_store_si256((__m256i*)&r[(32 * i) + 16], b);
+    }
+}
+
+static void kyber_invntt_avx2(int16_t r[QSC_KYBER_N])
+{
+    const __m256i QINV = _mm256_set1_epi16((int16_t)KYBER_QINV);
+    const __m256i F = _mm256_set1_epi16(1441);
+    __m256i v[8];
+    __m256i a;
+    __m256i b;
+    __m256i z;
+    size_t i;
+    size_t j;
+
+    /* layers 2, 4, 8 and 16 on each 32 coefficient block */
+    for (i = 0; i < QSC_KYBER_N / 32; ++i)
     {
-        r[j] = kyber_fqmul(r[j], F);
+        a = _mm256_load_si256((const __m256i*)&r[32 * i]);
+        b = _mm256_load_si256((const __m256i*)&r[(32 * i) + 16]);
+
+        kyber_shuffle8_avx2(&a, &b);
+        kyber_shuffle4_avx2(&a, &b);
+        kyber_shuffle2_avx2(&a, &b);
+
+        z = _mm256_loadu_si256((const __m256i*)&kyber_invntt_zetas_avx2[48 * i]);
+        kyber_invbutterfly_avx2(&a, &b, z, _mm256_mullo_epi16(z, QINV));
+        kyber_shuffle2_avx2(&a, &b);
+
+        z = _mm256_loadu_si256((const __m256i*)&kyber_invntt_zetas_avx2[(48 * i) + 16]);
+        kyber_invbutterfly_avx2(&a, &b, z, _mm256_mullo_epi16(z, QINV));
+        kyber_shuffle4_avx2(&a, &b);
+
+        z = _mm256_loadu_si256((const __m256i*)&kyber_invntt_zetas_avx2[(48 * i) + 32]);
+        kyber_invbutterfly_avx2(&a, &b, z, _mm256_mullo_epi16(z, QINV));
+        kyber_shuffle8_avx2(&a, &b);
+
+        z = _mm256_set1_epi16((int16_t)kyber_zetas[15 - i]);
+        kyber_invbutterfly_avx2(&a, &b, z, _mm256_mullo_epi16(z, QINV));
+
+        _mm256_store_si256((__m256i*)&r[32 * i], a);
+        _mm256_store_si256((__m256i*)&r[(32 * i) + 16], b);
+    }
+
+    /* layers 32, 64 and 128, merged with the final scaling */
+    for (i = 0; i < 2; ++i)
+    {
+        for (j = 0; j < 8; ++j)
+        {
+            v[j] = _mm256_load_si256((const __m256i*)&r[(16 * i) + (32 * j)]);
+        }
+
+        for (j = 0; j < 8; j += 2)
+        {
+            z = _mm256_set1_epi16((int16_t)kyber_zetas[7 - (j / 2)]);
+            kyber_invbutterfly_avx2(&v[j], &v[j + 1], z, _mm256_mullo_epi16(z, QINV));
+        }
+
+        for (j = 0; j < 8; j += 4)
+        {
+            z = _mm256_set1_epi16((int16_t)kyber_zetas[3 - (j / 4)]);
+            kyber_invbutterfly_avx2(&v[j], &v[j + 2], z, _mm256_mullo_epi16(z, QINV));
+            kyber_invbutterfly_avx2(&v[j + 1], &v[j + 3], z, _mm256_mullo_epi16(z, QINV));
+        }
+
+        z = _mm256_set1_epi16((int16_t)kyber_zetas[1]);
+
+        for (j = 0; j < 4; ++j)
+        {
+            kyber_invbutterfly_avx2(&v[j], &v[j + 4], z, _mm256_mullo_epi16(z, QINV));
+        }
+
+        for (j = 0; j < 8; ++j)
+        {
+            v[j] = kyber_fqmul_avx2(v[j], F, _mm256_mullo_epi16(F, QINV));
+            _mm256_store_si256((__m256i*)&r[(16 * i) + (32 * j)], v[j]);
+        }
     }
 }
+#endif
 
-static void kyber_basemul(int16_t r[2], const int16_t a[2], const int16_t b[2], int16_t zeta)
+static __m256i kyber_basemul_avx2(__m256i a, __m256i b, __m256i zeta)
 {
-    r[0] = kyber_fqmul(a[1], b[1]);
-    r[0] = kyber_fqmul(r[0], zeta);
-    r[0] += kyber_fqmul(a[0], b[0]);
-    r[1] = kyber_fqmul(a[0], b[1]);
-    r[1] += kyber_fqmul(a[1], b[0]);
+    /* each 32-bit lane holds one degree-one product (a0 + a1X)(b0 + b1X) mod (X^2 - zeta) */
+    const __m256i SWAP = _mm256_setr_epi8(2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13,
+        2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13);
+    const __m256i QINV = _mm256_set1_epi16((int16_t)KYBER_QINV);
+    __m256i bq;
+    __m256i p;
+    __m256i q;
+    __m256i s;
+    __m256i t;
+
+    bq = _mm256_mullo_epi16(b, QINV);
+    /* a0b0, a1b1 */
+    p = kyber_fqmul_avx2(a, b, bq);
+    /* a0b1, a1b0 */
+    q = kyber_fqmul_avx2(a, _mm256_shuffle_epi8(b, SWAP), _mm256_shuffle_epi8(bq, SWAP));
+    /* a1b1zeta in the odd lanes, added to a0b0 */
+    t = kyber_fqmul_avx2(p, zeta, _mm256_mullo_epi16(zeta, QINV));
+    t = _mm256_add_epi16(p, _mm256_shuffle_epi8(t, SWAP));
+    /* a0b1 + a1b0 in the odd lanes */
+    s = _mm256_add_epi16(q, _mm256_shuffle_epi8(q, SWAP));
+
+    return _mm256_blend_epi16(t, s, 0xAA);
 }
 
 /* poly.c */
@@ -608,30 +1251,33 @@ static void kyber_poly_get_noise_eta2(qsc_kyber_poly* r, const uint8_t seed[QSC_
 
 static void kyber_poly_reduce(qsc_kyber_poly* r)
 {
-    for (size_t i = 0; i < QSC_KYBER_N; ++i)
+    __m256i f;
+
+    for (size_t i = 0; i < QSC_KYBER_N; i += 16)
     {
-        r->coeffs[i] = kyber_barrett_reduce(r->coeffs[i]);
+        f = _mm256_load_si256((const __m256i*)&r->coeffs[i]);
+        f = kyber_barrett_reduce_avx2(f);
+        _mm256_store_si256((__m256i*)&r->coeffs[i], f);
     }
 }
 
 static void kyber_poly_ntt(qsc_kyber_poly* r)
 {
-    kyber_ntt_avx(r->coeffs);
+#if defined(QSC_SYSTEM_HAS_AVX512)
+    kyber_ntt_avx512(r->coeffs);
+#else
+    kyber_ntt_avx2(r->coeffs);
     kyber_poly_reduce(r);
+#endif
 }
 
 static void kyber_poly_invntt_to_mont(qsc_kyber_poly* r)
 {
-    kyber_invntt_avx(r->coeffs);
-}
-
-static void kyber_poly_basemul_montgomery(qsc_kyber_poly* r, const qsc_kyber_poly* a, const qsc_kyber_poly* b)
-{
-    for (size_t i = 0; i < QSC_KYBER_N / 4; ++i)
-    {
-        kyber_basemul(&r->coeffs[4 * i], &a->coeffs[4 * i], &b->coeffs[4 * i], (int16_t)kyber_zetas[64 + i]);
-        kyber_basemul(&r->coeffs[(4 * i) + 2], &a->coeffs[(4 * i) + 2], &b->coeffs[(4 * i) + 2], -(int16_t)kyber_zetas[64 + i]);
-    }
+#if defined(QSC_SYSTEM_HAS_AVX512)
+    kyber_invntt_avx512(r->coeffs);
+#else
+    kyber_invntt_avx2(r->coeffs);
+#endif
 }
 
 static void kyber_poly_to_mont(qsc_kyber_poly* r)
@@ -836,17 +1482,23 @@ static void kyber_polyvec_invntt_to_mont(qsc_kyber_polyvec* r)
 
 static void kyber_polyvec_basemul_acc_montgomery(qsc_kyber_poly* r, const qsc_kyber_polyvec* a, const qsc_kyber_polyvec* b)
 {
-    qsc_kyber_poly t;
-
-    kyber_poly_basemul_montgomery(r, &a->vec[0], &b->vec[0]);
+    __m256i f;
+    __m256i z;
 
-    for (size_t i = 1; i < QSC_KYBER_K; ++i)
+    /* the products of each vector of coefficients are accumulated in a register, and reduced once */
+    for (size_t i = 0; i < QSC_KYBER_N; i += 16)
     {
-        kyber_poly_basemul_montgomery(&t, &a->vec[i], &b->vec[i]);
-        kyber_poly_add_avx2(r, r, &t);
-    }
+        z = _mm256_loadu_si256((const __m256i*)&kyber_basemul_zetas_avx2[i]);
+        f = kyber_basemul_avx2(_mm256_load_si256((const __m256i*)&a->vec[0].coeffs[i]), _mm256_load_si256((const __m256i*)&b->vec[0].coeffs[i]), z);
 
-    kyber_poly_reduce(r);
+        for (size_t j = 1; j < QSC_KYBER_K; ++j)
+        {
+            f = _mm256_add_epi16(f, kyber_basemul_avx2(_mm256_load_si256((const __m256i*)&a->vec[j].coeffs[i]), _mm256_load_si256((const __m256i*)&b->vec[j].coeffs[i]), z));
+        }
+
+        f = kyber_barrett_reduce_avx2(f);
+        _mm256_store_si256((__m256i*)&r->coeffs[i], f);
+    }
 }
 
 static void kyber_polyvec_reduce(qsc_kyber_polyvec* r)
@@ -1033,6 +1685,67 @@ static const int8_t kyber_rej_idx[256][8] =
     { 2,  4,  6,  8, 10, 12, 14, -1 }, { 0,  2,  4,  6,  8, 10, 12, 14 }
 };
 
+#if defined(QSC_SYSTEM_HAS_AVX512)
+static uint32_t kyber_rej_uniform_avx512(int16_t* restrict r, const uint8_t* restrict buf)
+{
+    /* every 24 bytes expand to sixteen 12-bit candidates; the accepted lanes are compressed
+       to the front of the vector and stored, the counter advances by the number accepted */
+    const __m512i bound = _mm512_set1_epi32(QSC_KYBER_Q);
+    const __m256i mask = _mm256_set1_epi16(0xFFF);
+    const __m256i idx8 = _mm256_set_epi8(15, 14, 14, 13, 12, 11, 11, 10,
+        9, 8, 8, 7, 6, 5, 5, 4, 11, 10, 10, 9, 8, 7, 7, 6, 5, 4, 4, 3, 2, 1, 1, 0);
+    __m512i g;
+    __m256i f;
+    __m256i t;
+    __mmask16 good;
+    uint32_t ctr;
+    uint32_t pos;
+    uint16_t val0;
+    uint16_t val1;
+
+    ctr = 0;
+    pos = 0;
+
+    while (ctr <= QSC_KYBER_N - 16 && pos <= QSC_AVX_REJ_UNIFORM_BUFLEN - 24)
+    {
+        f = _mm256_loadu_si256((const __m256i*)&buf[pos]);
+        f = _mm256_permute4x64_epi64(f, 0x94);
+        f = _mm256_shuffle_epi8(f, idx8);
+        t = _mm256_srli_epi16(f, 4);
+        f = _mm256_blend_epi16(f, t, 0xAA);
+        f = _mm256_and_si256(f, mask);
+        pos += 24;
+
+        g = _mm512_cvtepu16_epi32(f);
+        good = _mm512_cmplt_epu32_mask(g, bound);
+        g = _mm512_maskz_compress_epi32(good, g);
+        _mm256_storeu_si256((__m256i*)&r[ctr], _mm512_cvtepi32_epi16(g));
+        ctr += (uint32_t)_mm_popcnt_u32(good);
+    }
+
+    while (ctr < QSC_KYBER_N && pos <= QSC_AVX_REJ_UNIFORM_BUFLEN - 3)
+    {
+        val0 = (uint16_t)(((uint16_t)buf[pos] | ((uint16_t)buf[pos + 1] << 8)) & 0x0FFF);
+        val1 = (uint16_t)(((uint16_t)buf[pos + 1] >> 4) | ((uint16_t)buf[pos + 2] << 4));
+        pos += 3;
+
+        if (val0 < QSC_KYBER_Q)
+        {
+            r[ctr] = val0;
+            ++ctr;
+        }
+
+        if (val1 < QSC_KYBER_Q && ctr < QSC_KYBER_N)
+        {
+            r[ctr] = val1;
+            ++ctr;
+        }
+    }
+
+    return ctr;
+}
+#endif
+
 uint32_t kyber_rej_uniform_avx2(int16_t* restrict r, const uint8_t* restrict buf)
 {
     const __m256i bound = _mm256_set1_epi16(QSC_KYBER_Q);
@@ -1173,6 +1886,109 @@ static uint32_t kyber_rej_uniform(int16_t* r, uint32_t len, const uint8_t* buf,
     return ctr;
 }
 
+#if defined(QSC_SYSTEM_HAS_AVX512)
+static void kyber_gen_matrix_avx512(qsc_kyber_polyvec* a, const uint8_t seed[QSC_KYBER_SYMBYTES], int32_t transposed)
+{
+    __m512i ksa8[QSC_KECCAK_STATE_SIZE] = { 0 };
+    __m256i ksa4[QSC_KECCAK_STATE_SIZE] = { 0 };
+    QSC_ALIGN(64) uint8_t buf[8][QSC_AVX_REJ_UNIFORM_BUFLEN + 8] = { 0 };
+    QSC_ALIGN(64) uint8_t extseed[8][QSC_KYBER_SYMBYTES + 2] = { 0 };
+    int16_t* pcf[8] = { 0 };
+    uint32_t ctr[8] = { 0 };
+    size_t i;
+    size_t j;
+    size_t k;
+    size_t n;
+    bool bchk;
+    bool wide;
+
+    for (k = 0; k < 8; ++k)
+    {
+        qsc_memutils_copy(extseed[k], seed, QSC_KYBER_SYMBYTES);
+    }
+
+    /* the matrix entries are flattened and expanded eight at a time,
+       the last four or fewer entries use the four-way permutation */
+    for (n = 0; n < QSC_KYBER_K * QSC_KYBER_K; n += 8)
+    {
+        for (k = 0; k < 8; ++k)
+        {
+            pcf[k] = NULL;
+            ctr[k] = QSC_KYBER_N;
+
+            if (n + k < QSC_KYBER_K * QSC_KYBER_K)
+            {
+                i = (n + k) / QSC_KYBER_K;
+                j = (n + k) % QSC_KYBER_K;
+                extseed[k][QSC_KYBER_SYMBYTES] = (uint8_t)((transposed != 0) ? i : j);
+                extseed[k][QSC_KYBER_SYMBYTES + 1] = (uint8_t)((transposed != 0) ? j : i);
+                pcf[k] = a[i].vec[j].coeffs;
+            }
+        }
+
+        wide = (QSC_KYBER_K * QSC_KYBER_K) - n > 4;
+
+        if (wide == true)
+        {
+            qsc_keccakx8_absorb(ksa8, qsc_keccak_rate_128, extseed[0], extseed[1], extseed[2], extseed[3],
+                extseed[4], extseed[5], extseed[6], extseed[7], sizeof(extseed[0]), QSC_KECCAK_SHAKE_DOMAIN_ID);
+            qsc_keccakx8_squeezeblocks(ksa8, qsc_keccak_rate_128, buf[0], buf[1], buf[2], buf[3],
+                buf[4], buf[5], buf[6], buf[7], KYBER_GEN_MATRIX_NBLOCKS);
+        }
+        else
+        {
+            qsc_keccakx4_absorb(ksa4, qsc_keccak_rate_128, extseed[0], extseed[1], extseed[2], extseed[3], sizeof(extseed[0]), QSC_KECCAK_SHAKE_DOMAIN_ID);
+            qsc_keccakx4_squeezeblocks(ksa4, qsc_keccak_rate_128, buf[0], buf[1], buf[2], buf[3], KYBER_GEN_MATRIX_NBLOCKS);
+        }
+
+        bchk = false;
+
+        for (k = 0; k < 8; ++k)
+        {
+            if (pcf[k] != NULL)
+            {
+                ctr[k] = kyber_rej_uniform_avx512(pcf[k], buf[k]);
+
+                if (ctr[k] < QSC_KYBER_N)
+                {
+                    bchk = true;
+                }
+            }
+        }
+
+        while (bchk == true)
+        {
+            if (wide == true)
+            {
+                qsc_keccakx8_squeezeblocks(ksa8, qsc_keccak_rate_128, buf[0], buf[1], buf[2], buf[3],
+                    buf[4], buf[5], buf[6], buf[7], 1);
+            }
+            else
+            {
+                qsc_keccakx4_squeezeblocks(ksa4, qsc_keccak_rate_128, buf[0], buf[1], buf[2], buf[3], 1);
+            }
+
+            bchk = false;
+
+            for (k = 0; k < 8; ++k)
+            {
+                if (ctr[k] < QSC_KYBER_N)
+                {
+                    ctr[k] += kyber_rej_uniform(pcf[k] + ctr[k], QSC_KYBER_N - ctr[k], buf[k], QSC_KECCAK_128_RATE);
+
+                    if (ctr[k] < QSC_KYBER_N)
+                    {
+                        bchk = true;
+                    }
+                }
+            }
+        }
+
+        qsc_memutils_clear(ksa8, sizeof(ksa8));
+        qsc_memutils_clear(ksa4, sizeof(ksa4));
+    }
+}
+#else
 static void kyber_gen_matrix_avx2(qsc_kyber_polyvec* a, const uint8_t seed[QSC_KYBER_SYMBYTES], int32_t transposed)
 {
     __m256i ksa[QSC_KECCAK_STATE_SIZE] = { 0 };
@@ -1255,6 +2071,7 @@ static void kyber_gen_matrix_avx2(qsc_kyber_polyvec* a, const uint8_t seed[QSC_K
         qsc_memutils_clear(ksa, sizeof(ksa));
     }
 }
+#endif
 
 static void kyber_indcpa_keypair(uint8_t pk[QSC_KYBER_INDCPA_PUBLICKEY_BYTES], uint8_t sk[QSC_KYBER_INDCPA_SECRETKEY_BYTES], bool (*rng_generate)(uint8_t*, size_t))
 {
@@ -1272,7 +2089,11 @@ static void kyber_indcpa_keypair(uint8_t pk[QSC_KYBER_INDCPA_PUBLICKEY_BYTES], u
     rng_generate(buf, QSC_KYBER_SYMBYTES);
     qsc_sha3_compute512(buf, buf, QSC_KYBER_SYMBYTES);
 
+#if defined(QSC_SYSTEM_HAS_AVX512)
+    kyber_gen_matrix_avx512(a, publicseed, 0);
+#else
     kyber_gen_matrix_avx2(a, publicseed, 0);
+#endif
 
     for (i = 0; i < QSC_KYBER_K; ++i)
     {
@@ -1302,25 +2123,20 @@ static void kyber_indcpa_keypair(uint8_t pk[QSC_KYBER_INDCPA_PUBLICKEY_BYTES], u
     kyber_pack_pk(pk, &pkpv, publicseed);
 }
 
-static void kyber_indcpa_enc(uint8_t c[QSC_KYBER_INDCPA_BYTES], const uint8_t m[QSC_KYBER_MSGBYTES],
-    const uint8_t pk[QSC_KYBER_INDCPA_PUBLICKEY_BYTES], const uint8_t coins[QSC_KYBER_SYMBYTES])
+static void kyber_indcpa_enc_expanded(uint8_t c[QSC_KYBER_INDCPA_BYTES], const uint8_t m[QSC_KYBER_MSGBYTES],
+    const qsc_kyber_polyvec at[QSC_KYBER_K], const qsc_kyber_polyvec* pkpv, const uint8_t coins[QSC_KYBER_SYMBYTES])
 {
     qsc_kyber_polyvec sp;
-    qsc_kyber_polyvec pkpv;
     qsc_kyber_polyvec ep;
-    qsc_kyber_polyvec at[QSC_KYBER_K];
     qsc_kyber_polyvec b;
     qsc_kyber_poly v;
     qsc_kyber_poly k;
     qsc_kyber_poly epp;
-    uint8_t seed[QSC_KYBER_SYMBYTES];
     size_t i;
     uint8_t nonce;
 
     nonce = 0;
-    kyber_unpack_pk(&pkpv, seed, pk);
     kyber_poly_from_msg_avx2(&k, m);
-    kyber_gen_matrix_avx2(at, seed, 1);
 
     for (i = 0; i < QSC_KYBER_K; ++i)
     {
@@ -1342,7 +2158,7 @@ static void kyber_indcpa_enc(uint8_t c[QSC_KYBER_INDCPA_BYTES], const uint8_t m[
         kyber_polyvec_basemul_acc_montgomery(&b.vec[i], &at[i], &sp);
     }
 
-    kyber_polyvec_basemul_acc_montgomery(&v, &pkpv, &sp);
+    kyber_polyvec_basemul_acc_montgomery(&v, pkpv, &sp);
     kyber_polyvec_invntt_to_mont(&b);
     kyber_poly_invntt_to_mont(&v);
 
@@ -1356,23 +2172,57 @@ static void kyber_indcpa_enc(uint8_t c[QSC_KYBER_INDCPA_BYTES], const uint8_t m[
     kyber_pack_ciphertext(c, &b, &v);
 }
 
-static void kyber_indcpa_dec(uint8_t m[QSC_KYBER_MSGBYTES], const uint8_t c[QSC_KYBER_INDCPA_BYTES], const uint8_t sk[QSC_KYBER_INDCPA_SECRETKEY_BYTES])
+static void kyber_indcpa_enc(uint8_t c[QSC_KYBER_INDCPA_BYTES], const uint8_t m[QSC_KYBER_MSGBYTES],
+    const uint8_t pk[QSC_KYBER_INDCPA_PUBLICKEY_BYTES], const uint8_t coins[QSC_KYBER_SYMBYTES])
+{
+    qsc_kyber_polyvec pkpv;
+    qsc_kyber_polyvec at[QSC_KYBER_K];
+    uint8_t seed[QSC_KYBER_SYMBYTES];
+
+    kyber_unpack_pk(&pkpv, seed, pk);
+#if defined(QSC_SYSTEM_HAS_AVX512)
+    kyber_gen_matrix_avx512(at, seed, 1);
+#else
+    kyber_gen_matrix_avx2(at, seed, 1);
+#endif
+    kyber_indcpa_enc_expanded(c, m, at, &pkpv, coins);
+}
+
+static void kyber_indcpa_dec_expanded(uint8_t m[QSC_KYBER_MSGBYTES], const uint8_t c[QSC_KYBER_INDCPA_BYTES], const qsc_kyber_polyvec* skpv)
 {
     qsc_kyber_polyvec b;
-    qsc_kyber_polyvec skpv;
     qsc_kyber_poly v;
     qsc_kyber_poly mp;
 
     kyber_unpack_ciphertext(&b, &v, c);
-    kyber_unpack_sk(&skpv, sk);
     kyber_polyvec_ntt(&b);
-    kyber_polyvec_basemul_acc_montgomery(&mp, &skpv, &b);
+    kyber_polyvec_basemul_acc_montgomery(&mp, skpv, &b);
     kyber_poly_invntt_to_mont(&mp);
     kyber_poly_sub_avx2(&mp, &v, &mp);
     kyber_poly_reduce(&mp);
     kyber_poly_to_msg(m, &mp);
 }
 
+static void kyber_indcpa_dec(uint8_t m[QSC_KYBER_MSGBYTES], const uint8_t c[QSC_KYBER_INDCPA_BYTES], const uint8_t sk[QSC_KYBER_INDCPA_SECRETKEY_BYTES])
+{
+    qsc_kyber_polyvec skpv;
+
+    kyber_unpack_sk(&skpv, sk);
+    kyber_indcpa_dec_expanded(m, c, &skpv);
+}
+
+static void kyber_indcpa_expand_publickey(qsc_kyber_expanded_publickey* epk, const uint8_t pk[QSC_KYBER_INDCPA_PUBLICKEY_BYTES])
+{
+    uint8_t seed[QSC_KYBER_SYMBYTES];
+
+    kyber_unpack_pk(&epk->t, seed, pk);
+#if defined(QSC_SYSTEM_HAS_AVX512)
+    kyber_gen_matrix_avx512(epk->at, seed, 1);
+#else
+    kyber_gen_matrix_avx2(epk->at, seed, 1);
+#endif
+}
+
 /* verify.c */
 
 void kyber_cmov_avx2(uint8_t* restrict r, const uint8_t* restrict x, size_t len, uint8_t b)
@@ -1500,4 +2350,70 @@ bool qsc_kyber_avx2_decapsulate(uint8_t ss[QSC_KYBER_MSGBYTES], const uint8_t ct
     return (fail == 0);
 }
 
+void qsc_kyber_avx2_encapsulate_expanded(uint8_t ct[QSC_KYBER_CIPHERTEXT_BYTES], uint8_t ss[QSC_KYBER_MSGBYTES], const qsc_kyber_expanded_publickey* epk, bool (*rng_generate)(uint8_t*, size_t))
+{
+    QSC_ALIGN(32)uint8_t buf[2 * QSC_KYBER_SYMBYTES];
+    QSC_ALIGN(32)uint8_t kr[2 * QSC_KYBER_SYMBYTES];
+
+    rng_generate(buf, QSC_KYBER_SYMBYTES);
+    /* Don't release system RNG output */
+    qsc_sha3_compute256(buf, buf, QSC_KYBER_SYMBYTES);
+
+    /* Multitarget countermeasure for coins + contributory KEM; H(pk) is stored in the expanded key */
+    qsc_memutils_copy((buf + QSC_KYBER_SYMBYTES), epk->hpk, QSC_KYBER_SYMBYTES);
+    qsc_sha3_compute512(kr, buf, 2 * QSC_KYBER_SYMBYTES);
+
+    /* coins are in kr+QSC_KYBER_SYMBYTES */
+    kyber_indcpa_enc_expanded(ct, buf, epk->at, &epk->t, (kr + QSC_KYBER_SYMBYTES));
+
+    /* overwrite coins in kr with H(c) */
+    qsc_sha3_compute256((kr + QSC_KYBER_SYMBYTES), ct, QSC_KYBER_CIPHERTEXT_BYTES);
+    /* hash concatenation of pre-k and H(c) to k */
+    qsc_shake256_compute(ss, QSC_KYBER_MSGBYTES, kr, 2 * QSC_KYBER_SYMBYTES);
+}
+
+bool qsc_kyber_avx2_decapsulate_expanded(uint8_t ss[QSC_KYBER_MSGBYTES], const uint8_t ct[QSC_KYBER_CIPHERTEXT_BYTES], const qsc_kyber_expanded_privatekey* esk)
+{
+    QSC_ALIGN(32)uint8_t buf[2 * QSC_KYBER_SYMBYTES];
+    QSC_ALIGN(32)uint8_t cmp[QSC_KYBER_CIPHERTEXT_BYTES];
+    QSC_ALIGN(32)uint8_t kr[2 * QSC_KYBER_SYMBYTES];
+    int32_t fail;
+
+    kyber_indcpa_dec_expanded(buf, ct, &esk->s);
+
+    /* Multitarget countermeasure for coins + contributory KEM */
+    qsc_memutils_copy((buf + QSC_KYBER_SYMBYTES), esk->epk.hpk, QSC_KYBER_SYMBYTES);
+    qsc_sha3_compute512(kr, buf, 2 * QSC_KYBER_SYMBYTES);
+
+    /* coins are in kr+QSC_KYBER_SYMBYTES */
+    kyber_indcpa_enc_expanded(cmp, buf, esk->epk.at, &esk->epk.t, (kr + QSC_KYBER_SYMBYTES));
+
+    fail = kyber_verify_avx2(ct, cmp, QSC_KYBER_CIPHERTEXT_BYTES);
+
+    /* overwrite coins in kr with H(c) */
+    qsc_sha3_compute256((kr + QSC_KYBER_SYMBYTES), ct, QSC_KYBER_CIPHERTEXT_BYTES);
+
+    /* Overwrite pre-k with z on re-encryption failure */
+    kyber_cmov_avx2(kr, esk->z, QSC_KYBER_SYMBYTES, (uint8_t)fail);
+
+    /* hash concatenation of pre-k and H(c) to k */
+    qsc_shake256_compute(ss, QSC_KYBER_MSGBYTES, kr, 2 * QSC_KYBER_SYMBYTES);
+
+    return (fail == 0);
+}
+
+void qsc_kyber_avx2_expand_publickey(qsc_kyber_expanded_publickey* epk, const uint8_t pk[QSC_KYBER_PUBLICKEY_BYTES])
+{
+    kyber_indcpa_expand_publickey(epk, pk);
+    qsc_sha3_compute256(epk->hpk, pk, QSC_KYBER_PUBLICKEY_BYTES);
+}
+
+void qsc_kyber_avx2_expand_privatekey(qsc_kyber_expanded_privatekey* esk, const uint8_t sk[QSC_KYBER_SECRETKEY_BYTES])
+{
+    kyber_unpack_sk(&esk->s, sk);
+    kyber_indcpa_expand_publickey(&esk->epk, (sk + QSC_KYBER_INDCPA_SECRETKEY_BYTES));
+    qsc_memutils_copy(esk->epk.hpk, (sk + QSC_KYBER_SECRETKEY_BYTES - (2 * QSC_KYBER_SYMBYTES)), QSC_KYBER_SYMBYTES);
+    qsc_memutils_copy(esk->z, (sk + QSC_KYBER_SECRETKEY_BYTES - QSC_KYBER_SYMBYTES), QSC_KYBER_SYMBYTES);
+}
+
 #endif
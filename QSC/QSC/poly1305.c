@@ -1,5 +1,571 @@
 #include "poly1305.h"
 #include "intutils.h"
+#include "memutils.h"
+
+#if defined(QSC_POLY1305_PARALLEL_BLOCKS)
+#	include "intrinsics.h"
+#	define POLY1305_PARALLEL_SIZE (QSC_POLY1305_PARALLEL_BLOCKS * QSC_POLY1305_BLOCK_SIZE)
+#endif
+
+/* the IFMA update is compiled with a function target and selected at runtime */
+#if defined(QSC_POLY1305_IFMA_BLOCKS) && (defined(QSC_SYSTEM_COMPILER_GCC) || defined(QSC_SYSTEM_COMPILER_MSC))
+#	define POLY1305_IFMA
+#	include "cpuidex.h"
+#	define POLY1305_IFMA_SIZE (QSC_POLY1305_IFMA_BLOCKS * QSC_POLY1305_BLOCK_SIZE)
+#	if defined(QSC_SYSTEM_COMPILER_GCC)
+#		define POLY1305_IFMA_TARGET __attribute__((target("avx512f,avx512ifma")))
+#	else
+#		define POLY1305_IFMA_TARGET
+#	endif
+#endif
+
+#if defined(QSC_POLY1305_PARALLEL_BLOCKS)
+
+static void poly1305_reduce(uint32_t* output, uint64_t* t)
+{
+	uint64_t b;
+
+	/* carry the 64-bit limb sums and fold the overflow back with 2^130 = 5 */
+	b = (t[0] >> 26);
+	t[1] += b;
+	b = (t[1] >> 26);
+	t[2] += b;
+	b = (t[2] >> 26);
+	t[3] += b;
+	b = (t[3] >> 26);
+	t[4] += b;
+	b = (t[4] >> 26);
+	t[0] = (t[0] & 0x3FFFFFFUL) + (b * 5);
+	t[1] = (t[1] & 0x3FFFFFFUL) + (t[0] >> 26);
+
+	output[0] = (uint32_t)(t[0] & 0x3FFFFFFUL);
+	output[1] = (uint32_t)t[1];
+	output[2] = (uint32_t)(t[2] & 0x3FFFFFFUL);
+	output[3] = (uint32_t)(t[3] & 0x3FFFFFFUL);
+	output[4] = (uint32_t)(t[4] & 0x3FFFFFFUL);
+}
+
+static void poly1305_multiply(uint32_t* output, const uint32_t* a, const uint32_t* r)
+{
+	uint64_t t[5];
+
+	t[0] = ((uint64_t)a[0] * r[0]) + ((uint64_t)a[1] * r[4] * 5) + ((uint64_t)a[2] * r[3] * 5) + ((uint64_t)a[3] * r[2] * 5) + ((uint64_t)a[4] * r[1] * 5);
+	t[1] = ((uint64_t)a[0] * r[1]) + ((uint64_t)a[1] * r[0]) + ((uint64_t)a[2] * r[4] * 5) + ((uint64_t)a[3] * r[3] * 5) + ((uint64_t)a[4] * r[2] * 5);
+	t[2] = ((uint64_t)a[0] * r[2]) + ((uint64_t)a[1] * r[1]) + ((uint64_t)a[2] * r[0]) + ((uint64_t)a[3] * r[4] * 5) + ((uint64_t)a[4] * r[3] * 5);
+	t[3] = ((uint64_t)a[0] * r[3]) + ((uint64_t)a[1] * r[2]) + ((uint64_t)a[2] * r[1]) + ((uint64_t)a[3] * r[0]) + ((uint64_t)a[4] * r[4] * 5);
+	t[4] = ((uint64_t)a[0] * r[4]) + ((uint64_t)a[1] * r[3]) + ((uint64_t)a[2] * r[2]) + ((uint64_t)a[3] * r[1]) + ((uint64_t)a[4] * r[0]);
+
+	poly1305_reduce(output, t);
+}
+
+static void poly1305_powers(qsc_poly1305_state* ctx)
+{
+	size_t i;
+
+	/* p[i] = r^(i+1), computed once per key */
+	if (qsc_intutils_are_equal8((const uint8_t*)ctx->p[0], (const uint8_t*)ctx->r, sizeof(ctx->p[0])) == false)
+	{
+		qsc_memutils_copy((uint8_t*)ctx->p[0], (const uint8_t*)ctx->r, sizeof(ctx->p[0]));
+
+		for (i = 1; i < QSC_POLY1305_PARALLEL_BLOCKS; ++i)
+		{
+			poly1305_multiply(ctx->p[i], ctx->p[i - 1], ctx->r);
+		}
+	}
+}
+
+#endif
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+
+static void poly1305_load_x8(__m512i* m, const uint8_t* message)
+{
+	const __m512i IDXL = _mm512_set_epi64(14, 12, 10, 8, 6, 4, 2, 0);
+	const __m512i IDXH = _mm512_set_epi64(15, 13, 11, 9, 7, 5, 3, 1);
+	const __m512i MASK = _mm512_set1_epi64(0x3FFFFFFLL);
+	const __m512i HIBIT = _mm512_set1_epi64(1LL << 24);
+	__m512i hi;
+	__m512i lo;
+	__m512i t0;
+	__m512i t1;
+
+	/* lane i holds the low and high 64-bit words of block i */
+	t0 = _mm512_loadu_si512((const __m512i*)message);
+	t1 = _mm512_loadu_si512((const __m512i*)(message + 64));
+	lo = _mm512_permutex2var_epi64(t0, IDXL, t1);
+	hi = _mm512_permutex2var_epi64(t0, IDXH, t1);
+
+	m[0] = _mm512_and_si512(lo, MASK);
+	m[1] = _mm512_and_si512(_mm512_srli_epi64(lo, 26), MASK);
+	m[2] = _mm512_and_si512(_mm512_or_si512(_mm512_srli_epi64(lo, 52), _mm512_slli_epi64(hi, 12)), MASK);
+	m[3] = _mm512_and_si512(_mm512_srli_epi64(hi, 14), MASK);
+	m[4] = _mm512_or_si512(_mm512_srli_epi64(hi, 40), HIBIT);
+}
+
+static void poly1305_multiply_x8(__m512i* d, const __m512i* a, const __m512i* r, const __m512i* s)
+{
+	d[0] = _mm512_add_epi64(_mm512_add_epi64(_mm512_add_epi64(_mm512_mul_epu32(a[0], r[0]), _mm512_mul_epu32(a[1], s[4])),
+		_mm512_add_epi64(_mm512_mul_epu32(a[2], s[3]), _mm512_mul_epu32(a[3], s[2]))), _mm512_mul_epu32(a[4], s[1]));
+	d[1] = _mm512_add_epi64(_mm512_add_epi64(_mm512_add_epi64(_mm512_mul_epu32(a[0], r[1]), _mm512_mul_epu32(a[1], r[0])),
+		_mm512_add_epi64(_mm512_mul_epu32(a[2], s[4]), _mm512_mul_epu32(a[3], s[3]))), _mm512_mul_epu32(a[4], s[2]));
+	d[2] = _mm512_add_epi64(_mm512_add_epi64(_mm512_add_epi64(_mm512_mul_epu32(a[0], r[2]), _mm512_mul_epu32(a[1], r[1])),
+		_mm512_add_epi64(_mm512_mul_epu32(a[2], r[0]), _mm512_mul_epu32(a[3], s[4]))), _mm512_mul_epu32(a[4], s[3]));
+	d[3] = _mm512_add_epi64(_mm512_add_epi64(_mm512_add_epi64(_mm512_mul_epu32(a[0], r[3]), _mm512_mul_epu32(a[1], r[2])),
+		_mm512_add_epi64(_mm512_mul_epu32(a[2], r[1]), _mm512_mul_epu32(a[3], r[0]))), _mm512_mul_epu32(a[4], s[4]));
+	d[4] = _mm512_add_epi64(_mm512_add_epi64(_mm512_add_epi64(_mm512_mul_epu32(a[0], r[4]), _mm512_mul_epu32(a[1], r[3])),
+		_mm512_add_epi64(_mm512_mul_epu32(a[2], r[2]), _mm512_mul_epu32(a[3], r[1]))), _mm512_mul_epu32(a[4], r[0]));
+}
+
+static void poly1305_carry_x8(__m512i* d)
+{
+	const __m512i MASK = _mm512_set1_epi64(0x3FFFFFFLL);
+	__m512i c;
+
+	c = _mm512_srli_epi64(d[0], 26);
+	d[0] = _mm512_and_si512(d[0], MASK);
+	d[1] = _mm512_add_epi64(d[1], c);
+	c = _mm512_srli_epi64(d[1], 26);
+	d[1] = _mm512_and_si512(d[1], MASK);
+	d[2] = _mm512_add_epi64(d[2], c);
+	c = _mm512_srli_epi64(d[2], 26);
+	d[2] = _mm512_and_si512(d[2], MASK);
+	d[3] = _mm512_add_epi64(d[3], c);
+	c = _mm512_srli_epi64(d[3], 26);
+	d[3] = _mm512_and_si512(d[3], MASK);
+	d[4] = _mm512_add_epi64(d[4], c);
+	c = _mm512_srli_epi64(d[4], 26);
+	d[4] = _mm512_and_si512(d[4], MASK);
+	d[0] = _mm512_add_epi64(d[0], _mm512_add_epi64(c, _mm512_slli_epi64(c, 2)));
+	c = _mm512_srli_epi64(d[0], 26);
+	d[0] = _mm512_and_si512(d[0], MASK);
+	d[1] = _mm512_add_epi64(d[1], c);
+}
+
+static void poly1305_blocks_x8(qsc_poly1305_state* ctx, const uint8_t* message, size_t nblocks)
+{
+	__m512i a[5];
+	__m512i d[5];
+	__m512i m[5];
+	__m512i r[5];
+	__m512i s[5];
+	uint64_t t[5];
+	size_t i;
+
+	/* the first lane absorbs the current accumulator */
+	poly1305_powers(ctx);
+	poly1305_load_x8(a, message);
+
+	for (i = 0; i < 5; ++i)
+	{
+		a[i] = _mm512_add_epi64(a[i], _mm512_set_epi64(0, 0, 0, 0, 0, 0, 0, (int64_t)ctx->h[i]));
+		r[i] = _mm512_set1_epi64((int64_t)ctx->p[7][i]);
+		s[i] = _mm512_add_epi64(r[i], _mm512_slli_epi64(r[i], 2));
+	}
+
+	message += POLY1305_PARALLEL_SIZE;
+	nblocks -= QSC_POLY1305_PARALLEL_BLOCKS;
+
+	/* each lane computes a = a * r^8 + m */
+	while (nblocks != 0)
+	{
+		poly1305_multiply_x8(d, a, r, s);
+		poly1305_carry_x8(d);
+		poly1305_load_x8(m, message);
+
+		for (i = 0; i < 5; ++i)
+		{
+			a[i] = _mm512_add_epi64(d[i], m[i]);
+		}
+
+		message += POLY1305_PARALLEL_SIZE;
+		nblocks -= QSC_POLY1305_PARALLEL_BLOCKS;
+	}
+
+	/* multiply lane i by r^(8-i) and sum the lanes */
+	for (i = 0; i < 5; ++i)
+	{
+		r[i] = _mm512_set_epi64((int64_t)ctx->p[0][i], (int64_t)ctx->p[1][i], (int64_t)ctx->p[2][i], (int64_t)ctx->p[3][i],
+			(int64_t)ctx->p[4][i], (int64_t)ctx->p[5][i], (int64_t)ctx->p[6][i], (int64_t)ctx->p[7][i]);
+		s[i] = _mm512_add_epi64(r[i], _mm512_slli_epi64(r[i], 2));
+	}
+
+	poly1305_multiply_x8(d, a, r, s);
+
+	for (i = 0; i < 5; ++i)
+	{
+		t[i] = (uint64_t)_mm512_reduce_add_epi64(d[i]);
+	}
+
+	poly1305_reduce(ctx->h, t);
+}
+
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+
+static void poly1305_load_x4(__m256i* m, const uint8_t* message)
+{
+	const __m256i MASK = _mm256_set1_epi64x(0x3FFFFFFLL);
+	const __m256i HIBIT = _mm256_set1_epi64x(1LL << 24);
+	__m256i hi;
+	__m256i lo;
+	__m256i t0;
+	__m256i t1;
+
+	/* lane i holds the low and high 64-bit words of block i */
+	t0 = _mm256_loadu_si256((const __m256i*)message);
+	t1 = _mm256_loadu_si256((const __m256i*)(message + 32));
+	lo = _mm256_permute4x64_epi64(_mm256_unpacklo_epi64(t0, t1), 0xD8);
+	hi = _mm256_permute4x64_epi64(_mm256_unpackhi_epi64(t0, t1), 0xD8);
+
+	m[0] = _mm256_and_si256(lo, MASK);
+	m[1] = _mm256_and_si256(_mm256_srli_epi64(lo, 26), MASK);
+	m[2] = _mm256_and_si256(_mm256_or_si256(_mm256_srli_epi64(lo, 52), _mm256_slli_epi64(hi, 12)), MASK);
+	m[3] = _mm256_and_si256(_mm256_srli_epi64(hi, 14), MASK);
+	m[4] = _mm256_or_si256(_mm256_srli_epi64(hi, 40), HIBIT);
+}
+
+static void poly1305_multiply_x4(__m256i* d, const __m256i* a, const __m256i* r, const __m256i* s)
+{
+	d[0] = _mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epu32(a[0], r[0]), _mm256_mul_epu32(a[1], s[4])),
+		_mm256_add_epi64(_mm256_mul_epu32(a[2], s[3]), _mm256_mul_epu32(a[3], s[2]))), _mm256_mul_epu32(a[4], s[1]));
+	d[1] = _mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epu32(a[0], r[1]), _mm256_mul_epu32(a[1], r[0])),
+		_mm256_add_epi64(_mm256_mul_epu32(a[2], s[4]), _mm256_mul_epu32(a[3], s[3]))), _mm256_mul_epu32(a[4], s[2]));
+	d[2] = _mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epu32(a[0], r[2]), _mm256_mul_epu32(a[1], r[1])),
+		_mm256_add_epi64(_mm256_mul_epu32(a[2], r[0]), _mm256_mul_epu32(a[3], s[4]))), _mm256_mul_epu32(a[4], s[3]));
+	d[3] = _mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epu32(a[0], r[3]), _mm256_mul_epu32(a[1], r[2])),
+		_mm256_add_epi64(_mm256_mul_epu32(a[2], r[1]), _mm256_mul_epu32(a[3], r[0]))), _mm256_mul_epu32(a[4], s[4]));
+	d[4] = _mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epu32(a[0], r[4]), _mm256_mul_epu32(a[1], r[3])),
+		_mm256_add_epi64(_mm256_mul_epu32(a[2], r[2]), _mm256_mul_epu32(a[3], r[1]))), _mm256_mul_epu32(a[4], r[0]));
+}
+
+static void poly1305_carry_x4(__m256i* d)
+{
+	const __m256i MASK = _mm256_set1_epi64x(0x3FFFFFFLL);
+	__m256i c;
+
+	c = _mm256_srli_epi64(d[0], 26);
+	d[0] = _mm256_and_si256(d[0], MASK);
+	d[1] = _mm256_add_epi64(d[1], c);
+	c = _mm256_srli_epi64(d[1], 26);
+	d[1] = _mm256_and_si256(d[1], MASK);
+	d[2] = _mm256_add_epi64(d[2], c);
+	c = _mm256_srli_epi64(d[2], 26);
+	d[2] = _mm256_and_si256(d[2], MASK);
+	d[3] = _mm256_add_epi64(d[3], c);
+	c = _mm256_srli_epi64(d[3], 26);
+	d[3] = _mm256_and_si256(d[3], MASK);
+	d[4] = _mm256_add_epi64(d[4], c);
+	c = _mm256_srli_epi64(d[4], 26);
+	d[4] = _mm256_and_si256(d[4], MASK);
+	d[0] = _mm256_add_epi64(d[0], _mm256_add_epi64(c, _mm256_slli_epi64(c, 2)));
+	c = _mm256_srli_epi64(d[0], 26);
+	d[0] = _mm256_and_si256(d[0], MASK);
+	d[1] = _mm256_add_epi64(d[1], c);
+}
+
+static void poly1305_blocks_x4(qsc_poly1305_state* ctx, const uint8_t* message, size_t nblocks)
+{
+	QSC_ALIGN(32) uint64_t tmp[4];
+	__m256i a[5];
+	__m256i d[5];
+	__m256i m[5];
+	__m256i r[5];
+	__m256i s[5];
+	uint64_t t[5];
+	size_t i;
+
+	/* the first lane absorbs the current accumulator */
+	poly1305_powers(ctx);
+	poly1305_load_x4(a, message);
+
+	for (i = 0; i < 5; ++i)
+	{
+		a[i] = _mm256_add_epi64(a[i], _mm256_set_epi64x(0, 0, 0, (int64_t)ctx->h[i]));
+		r[i] = _mm256_set1_epi64x((int64_t)ctx->p[3][i]);
+		s[i] = _mm256_add_epi64(r[i], _mm256_slli_epi64(r[i], 2));
+	}
+
+	message += POLY1305_PARALLEL_SIZE;
+	nblocks -= QSC_POLY1305_PARALLEL_BLOCKS;
+
+	/* each lane computes a = a * r^4 + m */
+	while (nblocks != 0)
+	{
+		poly1305_multiply_x4(d, a, r, s);
+		poly1305_carry_x4(d);
+		poly1305_load_x4(m, message);
+
+		for (i = 0; i < 5; ++i)
+		{
+			a[i] = _mm256_add_epi64(d[i], m[i]);
+		}
+
+		message += POLY1305_PARALLEL_SIZE;
+		nblocks -= QSC_POLY1305_PARALLEL_BLOCKS;
+	}
+
+	/* multiply lane i by r^(4-i) and sum the lanes */
+	for (i = 0; i < 5; ++i)
+	{
+		r[i] = _mm256_set_epi64x((int64_t)ctx->p[0][i], (int64_t)ctx->p[1][i], (int64_t)ctx->p[2][i], (int64_t)ctx->p[3][i]);
+		s[i] = _mm256_add_epi64(r[i], _mm256_slli_epi64(r[i], 2));
+	}
+
+	poly1305_multiply_x4(d, a, r, s);
+
+	for (i = 0; i < 5; ++i)
+	{
+		_mm256_store_si256((__m256i*)tmp, d[i]);
+		t[i] = tmp[0] + tmp[1] + tmp[2] + tmp[3];
+	}
+
+	poly1305_reduce(ctx->h, t);
+}
+
+#endif
+
+#if defined(POLY1305_IFMA)
+
+static bool poly1305_ifma_available(void)
+{
+	static volatile int32_t state = -1;
+	qsc_cpuidex_cpu_features feat = { 0 };
+
+	/* the feature query is made once; the result is idempotent, so concurrent first calls are harmless */
+	if (state < 0)
+	{
+		state = (qsc_cpuidex_features_set(&feat) == true && feat.avx512ifma == true) ? 1 : 0;
+	}
+
+	return (state == 1);
+}
+
+static void poly1305_radix44(uint64_t* output, const uint32_t* h)
+{
+	uint64_t x;
+
+	/* regroup the five 26-bit limbs as 44, 44 and 42-bit limbs */
+	x = (uint64_t)h[0] + ((uint64_t)h[1] << 26);
+	output[0] = x & 0xFFFFFFFFFFFULL;
+	x = (x >> 44) + ((uint64_t)h[2] << 8) + ((uint64_t)h[3] << 34);
+	output[1] = x & 0xFFFFFFFFFFFULL;
+	output[2] = (x >> 44) + ((uint64_t)h[4] << 16);
+}
+
+static void poly1305_radix26(uint32_t* output, uint64_t* t)
+{
+	uint64_t x;
+
+	/* carry the limb sums and fold the overflow back with 2^130 = 5 */
+	x = t[0] >> 44;
+	t[0] &= 0xFFFFFFFFFFFULL;
+	t[1] += x;
+	x = t[1] >> 44;
+	t[1] &= 0xFFFFFFFFFFFULL;
+	t[2] += x;
+	x = t[2] >> 42;
+	t[2] &= 0x3FFFFFFFFFFULL;
+	t[0] += x * 5;
+	x = t[0] >> 44;
+	t[0] &= 0xFFFFFFFFFFFULL;
+	t[1] += x;
+
+	x = t[0];
+	output[0] = (uint32_t)(x & 0x3FFFFFFUL);
+	x = (x >> 26) + (t[1] << 18);
+	output[1] = (uint32_t)(x & 0x3FFFFFFUL);
+	x >>= 26;
+	output[2] = (uint32_t)(x & 0x3FFFFFFUL);
+	x = (x >> 26) + (t[2] << 10);
+	output[3] = (uint32_t)(x & 0x3FFFFFFUL);
+	output[4] = (uint32_t)(x >> 26);
+}
+
+POLY1305_IFMA_TARGET
+static void poly1305_load_ifma(__m512i* m, const uint8_t* message)
+{
+	const __m512i IDXL = _mm512_set_epi64(14, 12, 10, 8, 6, 4, 2, 0);
+	const __m512i IDXH = _mm512_set_epi64(15, 13, 11, 9, 7, 5, 3, 1);
+	const __m512i MASK = _mm512_set1_epi64(0xFFFFFFFFFFFLL);
+	const __m512i HIBIT = _mm512_set1_epi64(1LL << 40);
+	__m512i hi;
+	__m512i lo;
+	__m512i t0;
+	__m512i t1;
+
+	/* lane i holds the low and high 64-bit words of block i */
+	t0 = _mm512_loadu_si512((const __m512i*)message);
+	t1 = _mm512_loadu_si512((const __m512i*)(message + 64));
+	lo = _mm512_permutex2var_epi64(t0, IDXL, t1);
+	hi = _mm512_permutex2var_epi64(t0, IDXH, t1);
+
+	m[0] = _mm512_and_si512(lo, MASK);
+	m[1] = _mm512_and_si512(_mm512_or_si512(_mm512_srli_epi64(lo, 44), _mm512_slli_epi64(hi, 20)), MASK);
+	m[2] = _mm512_or_si512(_mm512_srli_epi64(hi, 24), HIBIT);
+}
+
+POLY1305_IFMA_TARGET
+static void poly1305_multiply_ifma(__m512i* d, const __m512i* a, const __m512i* r, const __m512i* s)
+{
+	const __m512i MASK44 = _mm512_set1_epi64(0xFFFFFFFFFFFLL);
+	const __m512i MASK42 = _mm512_set1_epi64(0x3FFFFFFFFFFLL);
+	const __m512i ZERO = _mm512_setzero_si512();
+	__m512i c;
+	__m512i h0;
+	__m512i h1;
+	__m512i h2;
+
+	/* 52-bit multiply-accumulate of the low and high product halves; s = 20r folds the 2^132 terms */
+	d[0] = _mm512_madd52lo_epu64(ZERO, a[0], r[0]);
+	h0 = _mm512_madd52hi_epu64(ZERO, a[0], r[0]);
+	d[1] = _mm512_madd52lo_epu64(ZERO, a[0], r[1]);
+	h1 = _mm512_madd52hi_epu64(ZERO, a[0], r[1]);
+	d[2] = _mm512_madd52lo_epu64(ZERO, a[0], r[2]);
+	h2 = _mm512_madd52hi_epu64(ZERO, a[0], r[2]);
+	d[0] = _mm512_madd52lo_epu64(d[0], a[1], s[2]);
+	h0 = _mm512_madd52hi_epu64(h0, a[1], s[2]);
+	d[1] = _mm512_madd52lo_epu64(d[1], a[1], r[0]);
+	h1 = _mm512_madd52hi_epu64(h1, a[1], r[0]);
+	d[2] = _mm512_madd52lo_epu64(d[2], a[1], r[1]);
+	h2 = _mm512_madd52hi_epu64(h2, a[1], r[1]);
+	d[0] = _mm512_madd52lo_epu64(d[0], a[2], s[1]);
+	h0 = _mm512_madd52hi_epu64(h0, a[2], s[1]);
+	d[1] = _mm512_madd52lo_epu64(d[1], a[2], s[2]);
+	h1 = _mm512_madd52hi_epu64(h1, a[2], s[2]);
+	d[2] = _mm512_madd52lo_epu64(d[2], a[2], r[0]);
+	h2 = _mm512_madd52hi_epu64(h2, a[2], r[0]);
+
+	/* a high half sits 2^52 = 2^(44 + 8) above its limb; the top limb is 42 bits, so 2^140 folds as 5 * 2^10 */
+	d[1] = _mm512_add_epi64(d[1], _mm512_slli_epi64(h0, 8));
+	d[2] = _mm512_add_epi64(d[2], _mm512_slli_epi64(h1, 8));
+	c = _mm512_add_epi64(_mm512_srli_epi64(d[2], 42), _mm512_slli_epi64(h2, 10));
+	d[2] = _mm512_and_si512(d[2], MASK42);
+	d[0] = _mm512_add_epi64(d[0], _mm512_add_epi64(c, _mm512_slli_epi64(c, 2)));
+
+	c = _mm512_srli_epi64(d[0], 44);
+	d[0] = _mm512_and_si512(d[0], MASK44);
+	d[1] = _mm512_add_epi64(d[1], c);
+	c = _mm512_srli_epi64(d[1], 44);
+	d[1] = _mm512_and_si512(d[1], MASK44);
+	d[2] = _mm512_add_epi64(d[2], c);
+}
+
+POLY1305_IFMA_TARGET
+static void poly1305_ifma_powers(qsc_poly1305_state* ctx)
+{
+	QSC_ALIGN(64) uint64_t t[8];
+	const __m512i LANES = _mm512_set_epi64(7, 6, 5, 4, 3, 2, 1, 0);
+	const __mmask8 MASKS[3] = { 0xFE, 0xFC, 0xF0 };
+	__m512i a[3];
+	__m512i b[3];
+	__m512i d[3];
+	__m512i p[3];
+	__m512i s[3];
+	uint64_t r[3];
+	size_t i;
+	size_t j;
+
+	/* q[i] = r^(i+1), computed once per key */
+	poly1305_radix44(r, ctx->r);
+
+	if (qsc_intutils_are_equal8((const uint8_t*)ctx->q[0], (const uint8_t*)r, sizeof(r)) == false)
+	{
+		for (i = 0; i < 3; ++i)
+		{
+			p[i] = _mm512_set1_epi64((int64_t)r[i]);
+		}
+
+		/* lane k holds r^(k+1); each step sets lane k from lane k-n times r^n, for n = 1, 2 and 4 */
+		for (j = 0; j < 3; ++j)
+		{
+			for (i = 0; i < 3; ++i)
+			{
+				a[i] = _mm512_permutexvar_epi64(_mm512_sub_epi64(LANES, _mm512_set1_epi64((int64_t)(1ULL << j))), p[i]);
+				b[i] = _mm512_permutexvar_epi64(_mm512_set1_epi64((int64_t)((1ULL << j) - 1)), p[i]);
+				s[i] = _mm512_add_epi64(_mm512_slli_epi64(b[i], 4), _mm512_slli_epi64(b[i], 2));
+			}
+
+			poly1305_multiply_ifma(d, a, b, s);
+
+			for (i = 0; i < 3; ++i)
+			{
+				p[i] = _mm512_mask_mov_epi64(p[i], MASKS[j], d[i]);
+			}
+		}
+
+		for (i = 0; i < 3; ++i)
+		{
+			_mm512_store_si512((__m512i*)t, p[i]);
+
+			for (j = 0; j < QSC_POLY1305_IFMA_BLOCKS; ++j)
+			{
+				ctx->q[j][i] = t[j];
+			}
+		}
+
+		qsc_intutils_clear64(t, 8);
+	}
+}
+
+POLY1305_IFMA_TARGET
+static void poly1305_blocks_ifma(qsc_poly1305_state* ctx, const uint8_t* message, size_t nblocks)
+{
+	__m512i a[3];
+	__m512i d[3];
+	__m512i m[3];
+	__m512i r[3];
+	__m512i s[3];
+	uint64_t h[3];
+	size_t i;
+
+	/* the first lane absorbs the current accumulator */
+	poly1305_ifma_powers(ctx);
+	poly1305_radix44(h, ctx->h);
+	poly1305_load_ifma(a, message);
+
+	for (i = 0; i < 3; ++i)
+	{
+		a[i] = _mm512_add_epi64(a[i], _mm512_set_epi64(0, 0, 0, 0, 0, 0, 0, (int64_t)h[i]));
+		r[i] = _mm512_set1_epi64((int64_t)ctx->q[7][i]);
+		s[i] = _mm512_add_epi64(_mm512_slli_epi64(r[i], 4), _mm512_slli_epi64(r[i], 2));
+	}
+
+	message += POLY1305_IFMA_SIZE;
+	nblocks -= QSC_POLY1305_IFMA_BLOCKS;
+
+	/* each lane computes a = a * r^8 + m */
+	while (nblocks != 0)
+	{
+		poly1305_multiply_ifma(d, a, r, s);
+		poly1305_load_ifma(m, message);
+
+		for (i = 0; i < 3; ++i)
+		{
+			a[i] = _mm512_add_epi64(d[i], m[i]);
+		}
+
+		message += POLY1305_IFMA_SIZE;
+		nblocks -= QSC_POLY1305_IFMA_BLOCKS;
+	}
+
+	/* multiply lane i by r^(8-i) and sum the lanes */
+	for (i = 0; i < 3; ++i)
+	{
+		r[i] = _mm512_set_epi64((int64_t)ctx->q[0][i], (int64_t)ctx->q[1][i], (int64_t)ctx->q[2][i], (int64_t)ctx->q[3][i],
+			(int64_t)ctx->q[4][i], (int64_t)ctx->q[5][i], (int64_t)ctx->q[6][i], (int64_t)ctx->q[7][i]);
+		s[i] = _mm512_add_epi64(_mm512_slli_epi64(r[i], 4), _mm512_slli_epi64(r[i], 2));
+	}
+
+	poly1305_multiply_ifma(d, a, r, s);
+
+	for (i = 0; i < 3; ++i)
+	{
+		h[i] = (uint64_t)_mm512_reduce_add_epi64(d[i]);
+	}
+
+	poly1305_radix26(ctx->h, h);
+}
+
+#endif
 
 void qsc_poly1305_blockupdate(qsc_poly1305_state* ctx, const uint8_t* message)
 {
@@ -177,6 +743,14 @@ void qsc_poly1305_initialize(qsc_poly1305_state* ctx, const uint8_t* key)
 	ctx->k[3] = qsc_intutils_le8to32(&key[28]);
 	ctx->fnl = 0;
 	ctx->rmd = 0;
+
+#if defined(QSC_POLY1305_PARALLEL_BLOCKS)
+	/* the powers of r are computed on the first parallel update */
+	qsc_intutils_clear32((uint32_t*)ctx->p, sizeof(ctx->p) / sizeof(uint32_t));
+#endif
+#if defined(QSC_POLY1305_IFMA_BLOCKS)
+	qsc_intutils_clear64((uint64_t*)ctx->q, sizeof(ctx->q) / sizeof(uint64_t));
+#endif
 }
 
 void qsc_poly1305_reset(qsc_poly1305_state* ctx)
@@ -190,6 +764,13 @@ void qsc_poly1305_reset(qsc_poly1305_state* ctx)
 	qsc_intutils_clear8(ctx->buf, QSC_POLY1305_BLOCK_SIZE);
 	ctx->rmd = 0;
 	ctx->fnl = 0;
+
+#if defined(QSC_POLY1305_PARALLEL_BLOCKS)
+	qsc_intutils_clear32((uint32_t*)ctx->p, sizeof(ctx->p) / sizeof(uint32_t));
+#endif
+#if defined(QSC_POLY1305_IFMA_BLOCKS)
+	qsc_intutils_clear64((uint64_t*)ctx->q, sizeof(ctx->q) / sizeof(uint64_t));
+#endif
 }
 
 void qsc_poly1305_update(qsc_poly1305_state* ctx, const uint8_t* message, size_t msglen)
@@ -225,6 +806,34 @@ void qsc_poly1305_update(qsc_poly1305_state* ctx, const uint8_t* message, size_t
 		}
 	}
 
+#if defined(POLY1305_IFMA)
+	if (msglen >= 2 * POLY1305_IFMA_SIZE && poly1305_ifma_available() == true)
+	{
+		rmd = msglen - (msglen % POLY1305_IFMA_SIZE);
+		poly1305_blocks_ifma(ctx, message, rmd / QSC_POLY1305_BLOCK_SIZE);
+		message += rmd;
+		msglen -= rmd;
+	}
+#endif
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+	if (msglen >= 2 * POLY1305_PARALLEL_SIZE)
+	{
+		rmd = msglen - (msglen % POLY1305_PARALLEL_SIZE);
+		poly1305_blocks_x8(ctx, message, rmd / QSC_POLY1305_BLOCK_SIZE);
+		message += rmd;
+		msglen -= rmd;
+	}
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+	if (msglen >= 2 * POLY1305_PARALLEL_SIZE)
+	{
+		rmd = msglen - (msglen % POLY1305_PARALLEL_SIZE);
+		poly1305_blocks_x4(ctx, message, rmd / QSC_POLY1305_BLOCK_SIZE);
+		message += rmd;
+		msglen -= rmd;
+	}
+#endif
+
 	while (msglen >= QSC_POLY1305_BLOCK_SIZE)
 	{
 		qsc_poly1305_blockupdate(ctx, message);
@@ -256,3 +865,37 @@ int32_t qsc_poly1305_verify(const uint8_t* code, const uint8_t* message, size_t
 	return qsc_intutils_verify(code, hash, QSC_POLY1305_MAC_SIZE);
 }
 
+bool qsc_poly1305_verify_batch(uint8_t* bitmap, const qsc_poly1305_verify_item* items, size_t count)
+{
+	assert(bitmap != NULL);
+	assert(items != NULL);
+
+	uint8_t hash[QSC_POLY1305_MAC_SIZE] = { 0 };
+	size_t i;
+	uint32_t fail;
+	uint8_t res;
+	bool status;
+
+	status = false;
+
+	if (bitmap != NULL && items != NULL)
+	{
+		qsc_memutils_clear(bitmap, (count + 7) / 8);
+		fail = 0;
+
+		/* with AVX2 or AVX-512, the blocks of each message are evaluated in parallel by the vectorized update */
+		for (i = 0; i < count; ++i)
+		{
+			qsc_poly1305_compute(hash, items[i].message, items[i].msglen, items[i].key);
+			res = (uint8_t)(qsc_intutils_verify(items[i].code, hash, QSC_POLY1305_MAC_SIZE) + 1);
+			bitmap[i / 8] |= (uint8_t)(res << (i % 8));
+			fail |= (uint32_t)(res ^ 1U);
+		}
+
+		qsc_memutils_clear(hash, sizeof(hash));
+		status = (fail == 0);
+	}
+
+	return status;
+}
+
@@ -58,6 +58,9 @@
 *
 * \endcode
 * \remarks
+* With AVX2 or AVX512, long messages are absorbed 4 or 8 blocks at a time;
+* the powers of r are computed on the first parallel update after the key is loaded, and each vector lane runs an independent Horner evaluation
+* that is recombined with the remaining powers of r at the end of the message run. \n
 * For usage examples, see poly1305_test.h
 */
 
@@ -79,6 +82,24 @@
 */
 #define QSC_POLY1305_MAC_SIZE 16
 
+#if defined(QSC_SYSTEM_HAS_AVX512)
+/*!
+* \def QSC_POLY1305_PARALLEL_BLOCKS
+* \brief The number of message blocks evaluated in parallel by the vectorized update
+*/
+#	define QSC_POLY1305_PARALLEL_BLOCKS 8
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+#	define QSC_POLY1305_PARALLEL_BLOCKS 4
+#endif
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+/*!
+* \def QSC_POLY1305_IFMA_BLOCKS
+* \brief The number of message blocks evaluated in parallel by the AVX-512 IFMA update, selected at runtime
+*/
+#	define QSC_POLY1305_IFMA_BLOCKS 8
+#endif
+
 /*! 
 * \struct qsc_poly1305_state
 * \brief Contains the Poly1305 internal state
@@ -92,6 +113,12 @@ QSC_EXPORT_API typedef struct qsc_poly1305_state
 	uint8_t buf[QSC_POLY1305_BLOCK_SIZE];	/*!< The buffer parameter */
 	size_t fnl;								/*!< The fnl size */
 	size_t rmd;								/*!< The rmd size */
+#if defined(QSC_POLY1305_PARALLEL_BLOCKS)
+	uint32_t p[QSC_POLY1305_PARALLEL_BLOCKS][5];	/*!< The powers of r used by the parallel update */
+#endif
+#if defined(QSC_POLY1305_IFMA_BLOCKS)
+	uint64_t q[QSC_POLY1305_IFMA_BLOCKS][3];		/*!< The radix 2^44 powers of r used by the IFMA update */
+#endif
 } qsc_poly1305_state;
 
 
@@ -164,4 +191,28 @@ QSC_EXPORT_API void qsc_poly1305_update(qsc_poly1305_state* ctx, const uint8_t*
 */
 QSC_EXPORT_API int32_t qsc_poly1305_verify(const uint8_t* code, const uint8_t* message, size_t msglen, const uint8_t* key);
 
+/*!
+* \struct qsc_poly1305_verify_item
+* \brief One Poly1305 code to verify in a batch; each item carries its own one-time key
+*/
+QSC_EXPORT_API typedef struct
+{
+	const uint8_t* code;					/*!< The 16-byte received MAC code */
+	const uint8_t* message;					/*!< The message array */
+	const uint8_t* key;						/*!< The 32-byte one-time key */
+	size_t msglen;							/*!< The number of message bytes */
+} qsc_poly1305_verify_item;
+
+/**
+* \brief Verify a batch of MAC codes.
+* Each code is compared in constant time, and every item is evaluated; the bitmap reveals which items failed,
+* but not where a code differs. Bit (i % 8) of bitmap byte (i / 8) is set if item i verifies.
+*
+* \param bitmap: The output bitmap; must be at least (count + 7) / 8 bytes
+* \param items: [const][struct] The array of items to verify
+* \param count: The number of items
+* \return Returns true if every item verifies
+*/
+QSC_EXPORT_API bool qsc_poly1305_verify_batch(uint8_t* bitmap, const qsc_poly1305_verify_item* items, size_t count);
+
 #endif
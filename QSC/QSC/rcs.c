@@ -114,7 +114,7 @@ static const uint8_t rcs_512_name[RCS_NAME_SIZE] =
 static void rcs_transform_256(qsc_rcs_state* ctx, __m128i output[2], const __m128i input[2])
 {
 	const __m128i BLEND_MASK = _mm_set_epi32(0x80000000UL, 0x80800000UL, 0x80800000UL, 0x80808000UL);
-	const __m128i SHIFT_MASK = _mm_set_epi8(0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13, 2, 3);
+	const __m128i SHIFT_MASK = _mm_setr_epi8(0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13, 2, 3);
 	const size_t HLFBLK = QSC_RCS_BLOCK_SIZE / 2;
 	const size_t RNDCNT = ctx->roundkeylen - 3;
 	size_t kctr;
@@ -183,10 +183,10 @@ static void rcs_transform_512(qsc_rcs_state* ctx, __m512i* output, const __m512i
 		17361641481138401520, 17361641481138401520, 8102099357864587376, 8102099357864587376);
 	const __m512i NI512K1 = _mm512_set_epi64(8102099357864587376, 8102099357864587376, 17361641481138401520, 17361641481138401520,
 		8102099357864587376, 8102099357864587376, 17361641481138401520, 17361641481138401520);
-	const __m512i SWMASKL = _mm512_setr_epi8(0, 17, 22, 23, 4, 5, 26, 27, 8, 9, 14, 31, 12, 13, 18, 19,
-		16, 1, 6, 7, 20, 21, 10, 11, 24, 25, 30, 15, 28, 29, 2, 3,
-		0, 17, 22, 23, 4, 5, 26, 27, 8, 9, 14, 31, 12, 13, 18, 19, 
-		16, 1, 6, 7, 20, 21, 10, 11, 24, 25, 30, 15, 28, 29, 2, 3);
+	const __m512i SWMASKL = _mm512_set_epi8(3, 2, 29, 28, 15, 30, 25, 24, 11, 10, 21, 20, 7, 6, 1, 16,
+		19, 18, 13, 12, 31, 14, 9, 8, 27, 26, 5, 4, 23, 22, 17, 0,
+		3, 2, 29, 28, 15, 30, 25, 24, 11, 10, 21, 20, 7, 6, 1, 16,
+		19, 18, 13, 12, 31, 14, 9, 8, 27, 26, 5, 4, 23, 22, 17, 0);
 
 	const size_t RNDCNT = (ctx->roundkeylen / 2) - 2;
 	size_t kctr;
@@ -235,7 +235,7 @@ static void rcs_ctr_transform(qsc_rcs_state* ctx, uint8_t* output, const uint8_t
 		ctrw = _mm512_set1_epi64(0);
 		qsc_memutils_copy(ctrblk, ctx->nonce, QSC_RCS_BLOCK_SIZE);
 		qsc_memutils_copy(((uint8_t*)ctrblk + QSC_RCS_BLOCK_SIZE), ctx->nonce, QSC_RCS_BLOCK_SIZE);
-		ctrw = _mm512_load_si512(ctrblk);
+		ctrw = _mm512_loadu_si512((const __m512i*)ctrblk);
 		ctrw = _mm512_add_epi64(ctrw, _mm512_set_epi64(0, 0, 0, 1, 0, 0, 0, 0));
 
 		/* process 2 blocks in parallel */
@@ -1,7 +1,9 @@
 #include "sha2.h"
+#include "cpuidex.h"
 #include "intrinsics.h"
 #include "intutils.h"
 #include "memutils.h"
+#include <stdlib.h>
 
 
 #define SHA2_256_ROUNDS_COUNT 64
@@ -645,6 +647,271 @@ void qsc_sha256_update(qsc_sha256_state* ctx, const uint8_t* message, size_t msg
 	}
 }
 
+/* SHA2-512 SIMD */
+
+/* the SHA512 instruction set extension intrinsics are available from GCC 14 and Clang 18;
+   the extension is compiled with a function target and selected at runtime */
+#if defined(QSC_SYSTEM_HAS_AVX2) && defined(QSC_SYSTEM_COMPILER_GCC) && \
+	((defined(__clang__) && (__clang_major__ >= 18)) || (!defined(__clang__) && (__GNUC__ >= 14)))
+#	define SHA2_SHA512_ISA
+#endif
+
+#if defined(SHA2_SHA512_ISA) || (defined(QSC_SYSTEM_HAS_AVX2) && defined(QSC_SHA2_AVX2_SCHEDULE_ENABLED))
+
+static const uint64_t sha512_k[SHA2_512_ROUNDS_COUNT] =
+{
+	0x428A2F98D728AE22ULL, 0x7137449123EF65CDULL, 0xB5C0FBCFEC4D3B2FULL, 0xE9B5DBA58189DBBCULL,
+	0x3956C25BF348B538ULL, 0x59F111F1B605D019ULL, 0x923F82A4AF194F9BULL, 0xAB1C5ED5DA6D8118ULL,
+	0xD807AA98A3030242ULL, 0x12835B0145706FBEULL, 0x243185BE4EE4B28CULL, 0x550C7DC3D5FFB4E2ULL,
+	0x72BE5D74F27B896FULL, 0x80DEB1FE3B1696B1ULL, 0x9BDC06A725C71235ULL, 0xC19BF174CF692694ULL,
+	0xE49B69C19EF14AD2ULL, 0xEFBE4786384F25E3ULL, 0x0FC19DC68B8CD5B5ULL, 0x240CA1CC77AC9C65ULL,
+	0x2DE92C6F592B0275ULL, 0x4A7484AA6EA6E483ULL, 0x5CB0A9DCBD41FBD4ULL, 0x76F988DA831153B5ULL,
+	0x983E5152EE66DFABULL, 0xA831C66D2DB43210ULL, 0xB00327C898FB213FULL, 0xBF597FC7BEEF0EE4ULL,
+	0xC6E00BF33DA88FC2ULL, 0xD5A79147930AA725ULL, 0x06CA6351E003826FULL, 0x142929670A0E6E70ULL,
+	0x27B70A8546D22FFCULL, 0x2E1B21385C26C926ULL, 0x4D2C6DFC5AC42AEDULL, 0x53380D139D95B3DFULL,
+	0x650A73548BAF63DEULL, 0x766A0ABB3C77B2A8ULL, 0x81C2C92E47EDAEE6ULL, 0x92722C851482353BULL,
+	0xA2BFE8A14CF10364ULL, 0xA81A664BBC423001ULL, 0xC24B8B70D0F89791ULL, 0xC76C51A30654BE30ULL,
+	0xD192E819D6EF5218ULL, 0xD69906245565A910ULL, 0xF40E35855771202AULL, 0x106AA07032BBD1B8ULL,
+	0x19A4C116B8D2D0C8ULL, 0x1E376C085141AB53ULL, 0x2748774CDF8EEB99ULL, 0x34B0BCB5E19B48A8ULL,
+	0x391C0CB3C5C95A63ULL, 0x4ED8AA4AE3418ACBULL, 0x5B9CCA4F7763E373ULL, 0x682E6FF3D6B2B8A3ULL,
+	0x748F82EE5DEFB2FCULL, 0x78A5636F43172F60ULL, 0x84C87814A1F0AB72ULL, 0x8CC702081A6439ECULL,
+	0x90BEFFFA23631E28ULL, 0xA4506CEBDE82BDE9ULL, 0xBEF9A3F7B2C67915ULL, 0xC67178F2E372532BULL,
+	0xCA273ECEEA26619CULL, 0xD186B8C721C0C207ULL, 0xEADA7DD6CDE0EB1EULL, 0xF57D4F7FEE6ED178ULL,
+	0x06F067AA72176FBAULL, 0x0A637DC5A2C898A6ULL, 0x113F9804BEF90DAEULL, 0x1B710B35131C471BULL,
+	0x28DB77F523047D84ULL, 0x32CAAB7B40C72493ULL, 0x3C9EBE0A15C9BEBCULL, 0x431D67C49C100D4CULL,
+	0x4CC5D4BECB3E42B6ULL, 0x597F299CFC657E2AULL, 0x5FCB6FAB3AD6FAECULL, 0x6C44198C4A475817ULL
+};
+
+#if defined(SHA2_SHA512_ISA)
+static bool sha512_isa_available(void)
+{
+	static volatile int32_t state = -1;
+	qsc_cpuidex_cpu_features feat = { 0 };
+
+	/* the feature query is made once; the result is idempotent, so concurrent first calls are harmless */
+	if (state < 0)
+	{
+		state = (qsc_cpuidex_features_set(&feat) == true && feat.sha512 == true && feat.avx2 == true) ? 1 : 0;
+	}
+
+	return (state == 1);
+}
+
+__attribute__((target("avx2,sha512")))
+static void sha512_permute_isa(uint64_t* output, const uint8_t* message, size_t blocks)
+{
+	const __m256i BSWAP = _mm256_set_epi64x(0x08090A0B0C0D0E0FLL, 0x0001020304050607LL, 0x08090A0B0C0D0E0FLL, 0x0001020304050607LL);
+	uint64_t tmp[4];
+	__m256i abef;
+	__m256i abefs;
+	__m256i cdgh;
+	__m256i cdghs;
+	__m256i m[4];
+	__m256i w;
+	size_t i;
+
+	/* the state is held as the A,B,E,F and C,D,G,H quadword pairs used by vsha512rnds2 */
+	abef = _mm256_set_epi64x((int64_t)output[0], (int64_t)output[1], (int64_t)output[4], (int64_t)output[5]);
+	cdgh = _mm256_set_epi64x((int64_t)output[2], (int64_t)output[3], (int64_t)output[6], (int64_t)output[7]);
+
+	while (blocks != 0)
+	{
+		abefs = abef;
+		cdghs = cdgh;
+
+		for (i = 0; i < 4; ++i)
+		{
+			m[i] = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)(message + (i * sizeof(__m256i)))), BSWAP);
+		}
+
+		for (i = 0; i < SHA2_512_ROUNDS_COUNT / 4; ++i)
+		{
+			/* four rounds; each vsha512rnds2 swaps the roles of the two state registers */
+			w = _mm256_add_epi64(m[i & 3], _mm256_loadu_si256((const __m256i*)(sha512_k + (i * 4))));
+			cdgh = _mm256_sha512rnds2_epi64(cdgh, abef, _mm256_castsi256_si128(w));
+			abef = _mm256_sha512rnds2_epi64(abef, cdgh, _mm256_extracti128_si256(w, 1));
+
+			if (i < (SHA2_512_ROUNDS_COUNT / 4) - 4)
+			{
+				/* W[t-16] + s0(W[t-15]) + W[t-7], then s1(W[t-2]) */
+				w = _mm256_permute4x64_epi64(_mm256_blend_epi32(m[(i + 2) & 3], m[(i + 3) & 3], 0x03), 0x39);
+				m[i & 3] = _mm256_sha512msg1_epi64(m[i & 3], _mm256_castsi256_si128(m[(i + 1) & 3]));
+				m[i & 3] = _mm256_sha512msg2_epi64(_mm256_add_epi64(m[i & 3], w), m[(i + 3) & 3]);
+			}
+		}
+
+		abef = _mm256_add_epi64(abef, abefs);
+		cdgh = _mm256_add_epi64(cdgh, cdghs);
+		message += QSC_SHA2_512_RATE;
+		--blocks;
+	}
+
+	_mm256_storeu_si256((__m256i*)tmp, abef);
+	output[0] = tmp[3];
+	output[1] = tmp[2];
+	output[4] = tmp[1];
+	output[5] = tmp[0];
+	_mm256_storeu_si256((__m256i*)tmp, cdgh);
+	output[2] = tmp[3];
+	output[3] = tmp[2];
+	output[6] = tmp[1];
+	output[7] = tmp[0];
+}
+#endif
+
+#if defined(QSC_SHA2_AVX2_SCHEDULE_ENABLED)
+static __m256i sha512_rotr_x4(__m256i x, int n)
+{
+	return _mm256_or_si256(_mm256_srli_epi64(x, n), _mm256_slli_epi64(x, 64 - n));
+}
+
+static __m256i sha512_ssig0_x4(__m256i x)
+{
+	return _mm256_xor_si256(_mm256_xor_si256(sha512_rotr_x4(x, 1), sha512_rotr_x4(x, 8)), _mm256_srli_epi64(x, 7));
+}
+
+static __m256i sha512_ssig1_x4(__m256i x)
+{
+	return _mm256_xor_si256(_mm256_xor_si256(sha512_rotr_x4(x, 19), sha512_rotr_x4(x, 61)), _mm256_srli_epi64(x, 6));
+}
+
+static void sha512_schedule_store(uint64_t wk[2][SHA2_512_ROUNDS_COUNT], __m256i x, size_t i)
+{
+	__m256i k;
+
+	/* the low half holds two words of the first block, the high half the same words of the second */
+	k = _mm256_add_epi64(x, _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(sha512_k + (i * 2)))));
+	_mm_storeu_si128((__m128i*)(wk[0] + (i * 2)), _mm256_castsi256_si128(k));
+	_mm_storeu_si128((__m128i*)(wk[1] + (i * 2)), _mm256_extracti128_si256(k, 1));
+}
+
+static void sha512_schedule_load(__m256i x[8], uint64_t wk[2][SHA2_512_ROUNDS_COUNT], const uint8_t* block0, const uint8_t* block1)
+{
+	const __m256i BSWAP = _mm256_set_epi64x(0x08090A0B0C0D0E0FLL, 0x0001020304050607LL, 0x08090A0B0C0D0E0FLL, 0x0001020304050607LL);
+	size_t i;
+
+	for (i = 0; i < 8; ++i)
+	{
+		x[i] = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)(block0 + (i * sizeof(__m128i))))),
+			_mm_loadu_si128((const __m128i*)(block1 + (i * sizeof(__m128i)))), 1);
+		x[i] = _mm256_shuffle_epi8(x[i], BSWAP);
+		sha512_schedule_store(wk, x[i], i);
+	}
+}
+
+static void sha512_schedule_step(__m256i x[8], uint64_t wk[2][SHA2_512_ROUNDS_COUNT], size_t i)
+{
+	/* W[t] and W[t+1] of both blocks: s1(W[t-2]) + W[t-7] + s0(W[t-15]) + W[t-16] */
+	x[i & 7] = _mm256_add_epi64(_mm256_add_epi64(x[i & 7], sha512_ssig0_x4(_mm256_alignr_epi8(x[(i + 1) & 7], x[i & 7], 8))),
+		_mm256_add_epi64(_mm256_alignr_epi8(x[(i + 5) & 7], x[(i + 4) & 7], 8), sha512_ssig1_x4(x[(i + 7) & 7])));
+	sha512_schedule_store(wk, x[i & 7], i);
+}
+
+#define SHA2_512_ROUND(a, b, c, d, e, f, g, h, wk) \
+	h += (((e << 50) | (e >> 14)) ^ ((e << 46) | (e >> 18)) ^ ((e << 23) | (e >> 41))) + ((e & f) ^ (~e & g)) + (wk); \
+	d += h; \
+	h += (((a << 36) | (a >> 28)) ^ ((a << 30) | (a >> 34)) ^ ((a << 25) | (a >> 39))) + ((a & b) ^ (a & c) ^ (b & c))
+
+static void sha512_rounds(uint64_t* output, const uint64_t* wk, __m256i x[8], uint64_t wks[2][SHA2_512_ROUNDS_COUNT])
+{
+	uint64_t a;
+	uint64_t b;
+	uint64_t c;
+	uint64_t d;
+	uint64_t e;
+	uint64_t f;
+	uint64_t g;
+	uint64_t h;
+	size_t i;
+
+	a = output[0];
+	b = output[1];
+	c = output[2];
+	d = output[3];
+	e = output[4];
+	f = output[5];
+	g = output[6];
+	h = output[7];
+
+	for (i = 0; i < SHA2_512_ROUNDS_COUNT; i += 8)
+	{
+		/* the vector message schedule runs 16 words ahead of the scalar rounds of the first block */
+		if (x != NULL && i < SHA2_512_ROUNDS_COUNT - 16)
+		{
+			sha512_schedule_step(x, wks, 8 + (i / 2));
+			sha512_schedule_step(x, wks, 9 + (i / 2));
+			sha512_schedule_step(x, wks, 10 + (i / 2));
+			sha512_schedule_step(x, wks, 11 + (i / 2));
+		}
+
+		SHA2_512_ROUND(a, b, c, d, e, f, g, h, wk[i]);
+		SHA2_512_ROUND(h, a, b, c, d, e, f, g, wk[i + 1]);
+		SHA2_512_ROUND(g, h, a, b, c, d, e, f, wk[i + 2]);
+		SHA2_512_ROUND(f, g, h, a, b, c, d, e, wk[i + 3]);
+		SHA2_512_ROUND(e, f, g, h, a, b, c, d, wk[i + 4]);
+		SHA2_512_ROUND(d, e, f, g, h, a, b, c, wk[i + 5]);
+		SHA2_512_ROUND(c, d, e, f, g, h, a, b, wk[i + 6]);
+		SHA2_512_ROUND(b, c, d, e, f, g, h, a, wk[i + 7]);
+	}
+
+	output[0] += a;
+	output[1] += b;
+	output[2] += c;
+	output[3] += d;
+	output[4] += e;
+	output[5] += f;
+	output[6] += g;
+	output[7] += h;
+}
+
+static void sha512_permute_avx2(uint64_t* output, const uint8_t* message, size_t blocks)
+{
+	uint64_t wk[2][SHA2_512_ROUNDS_COUNT];
+	__m256i x[8];
+
+	/* Gueron and Krasnov: the message schedule of two blocks is computed in the vector unit,
+	   interleaved with the scalar rounds of the first block */
+	while (blocks >= 2)
+	{
+		sha512_schedule_load(x, wk, message, message + QSC_SHA2_512_RATE);
+		sha512_rounds(output, wk[0], x, wk);
+		sha512_rounds(output, wk[1], NULL, wk);
+		message += 2 * QSC_SHA2_512_RATE;
+		blocks -= 2;
+	}
+
+	if (blocks != 0)
+	{
+		qsc_sha512_permute(output, message);
+	}
+}
+#endif
+
+#endif
+
+static void sha512_permute_blocks(uint64_t* output, const uint8_t* message, size_t blocks)
+{
+#if defined(SHA2_SHA512_ISA)
+	if (sha512_isa_available() == true)
+	{
+		sha512_permute_isa(output, message, blocks);
+	}
+	else
+#endif
+	{
+#if defined(QSC_SYSTEM_HAS_AVX2) && defined(QSC_SHA2_AVX2_SCHEDULE_ENABLED)
+		sha512_permute_avx2(output, message, blocks);
+#else
+		while (blocks != 0)
+		{
+			qsc_sha512_permute(output, message);
+			message += QSC_SHA2_512_RATE;
+			--blocks;
+		}
+#endif
+	}
+}
+
 /* SHA2-384 */
 
 static const uint64_t sha384_iv[8] =
@@ -783,12 +1050,14 @@ void qsc_sha384_update(qsc_sha384_state* ctx, const uint8_t* message, size_t msg
 		}
 
 		/* sequential loop through blocks */
-		while (msglen >= QSC_SHA2_384_RATE)
+		if (msglen >= QSC_SHA2_384_RATE)
 		{
-			qsc_sha512_permute(ctx->state, message);
-			sha384_increase(ctx, QSC_SHA2_384_RATE);
-			message += QSC_SHA2_384_RATE;
-			msglen -= QSC_SHA2_384_RATE;
+			const size_t BLKLEN = msglen - (msglen % QSC_SHA2_384_RATE);
+
+			sha512_permute_blocks(ctx->state, message, BLKLEN / QSC_SHA2_384_RATE);
+			sha384_increase(ctx, BLKLEN);
+			message += BLKLEN;
+			msglen -= BLKLEN;
 		}
 
 		/* store unaligned bytes */
@@ -914,11 +1183,8 @@ void qsc_sha512_initialize(qsc_sha512_state* ctx)
 	ctx->position = 0;
 }
 
-void qsc_sha512_permute(uint64_t* output, const uint8_t* message)
+static void sha512_permute_scalar(uint64_t* output, const uint8_t* message)
 {
-	assert(output != NULL);
-	assert(message != NULL);
-
 	uint64_t a;
 	uint64_t b;
 	uint64_t c;
@@ -1290,6 +1556,23 @@ void qsc_sha512_permute(uint64_t* output, const uint8_t* message)
 	output[7] += h;
 }
 
+void qsc_sha512_permute(uint64_t* output, const uint8_t* message)
+{
+	assert(output != NULL);
+	assert(message != NULL);
+
+#if defined(SHA2_SHA512_ISA)
+	if (sha512_isa_available() == true)
+	{
+		sha512_permute_isa(output, message, 1);
+	}
+	else
+#endif
+	{
+		sha512_permute_scalar(output, message);
+	}
+}
+
 void qsc_sha512_update(qsc_sha512_state* ctx, const uint8_t* message, size_t msglen)
 {
 	assert(ctx != NULL);
@@ -1314,12 +1597,14 @@ void qsc_sha512_update(qsc_sha512_state* ctx, const uint8_t* message, size_t msg
 		}
 
 		/* sequential loop through blocks */
-		while (msglen >= QSC_SHA2_512_RATE)
+		if (msglen >= QSC_SHA2_512_RATE)
 		{
-			qsc_sha512_permute(ctx->state, message);
-			sha512_increase(ctx, QSC_SHA2_512_RATE);
-			message += QSC_SHA2_512_RATE;
-			msglen -= QSC_SHA2_512_RATE;
+			const size_t BLKLEN = msglen - (msglen % QSC_SHA2_512_RATE);
+
+			sha512_permute_blocks(ctx->state, message, BLKLEN / QSC_SHA2_512_RATE);
+			sha512_increase(ctx, BLKLEN);
+			message += BLKLEN;
+			msglen -= BLKLEN;
 		}
 
 		/* store unaligned bytes */
@@ -1353,8 +1638,7 @@ void qsc_hmac256_dispose(qsc_hmac256_state* ctx)
 	
 	if (ctx != NULL)
 	{
-		qsc_memutils_clear(ctx->ipad, sizeof(ctx->ipad));
-		qsc_memutils_clear(ctx->opad, sizeof(ctx->ipad));
+		qsc_memutils_clear((uint8_t*)ctx->ostate, sizeof(ctx->ostate));
 		qsc_sha256_dispose(&ctx->pstate);
 	}
 }
@@ -1368,8 +1652,10 @@ void qsc_hmac256_finalize(qsc_hmac256_state* ctx, uint8_t* output)
 	uint8_t tmpv[QSC_SHA2_256_HASH_SIZE] = { 0 };
 
 	qsc_sha256_finalize(&ctx->pstate, tmpv);
-	qsc_sha256_initialize(&ctx->pstate);
-	qsc_sha256_update(&ctx->pstate, ctx->opad, sizeof(ctx->opad));
+	/* resume the outer hash from its state after the output pad block */
+	qsc_memutils_copy((uint8_t*)ctx->pstate.state, (const uint8_t*)ctx->ostate, sizeof(ctx->ostate));
+	ctx->pstate.t = QSC_SHA2_256_RATE;
+	ctx->pstate.position = 0;
 	qsc_sha256_update(&ctx->pstate, tmpv, sizeof(tmpv));
 	qsc_sha256_finalize(&ctx->pstate, output);
 	qsc_hmac256_dispose(ctx);
@@ -1380,36 +1666,94 @@ void qsc_hmac256_initialize(qsc_hmac256_state* ctx, const uint8_t* key, size_t k
 	assert(ctx != NULL);
 	assert(key != NULL);
 
+	qsc_hmac256_key pkey;
+
+	qsc_hmac256_key_prepare(&pkey, key, keylen);
+	qsc_hmac256_initialize_prepared(ctx, &pkey);
+	qsc_hmac256_key_dispose(&pkey);
+}
+
+void qsc_hmac256_update(qsc_hmac256_state* ctx, const uint8_t* message, size_t msglen)
+{
+	assert(ctx != NULL);
+	assert(message != NULL);
+
+	qsc_sha256_update(&ctx->pstate, message, msglen);
+}
+
+void qsc_hmac256_compute_prepared(uint8_t* output, const uint8_t* message, size_t msglen, const qsc_hmac256_key* pkey)
+{
+	assert(output != NULL);
+	assert(message != NULL);
+	assert(pkey != NULL);
+
+	qsc_hmac256_state ctx;
+
+	qsc_hmac256_initialize_prepared(&ctx, pkey);
+	qsc_hmac256_update(&ctx, message, msglen);
+	qsc_hmac256_finalize(&ctx, output);
+}
+
+void qsc_hmac256_initialize_prepared(qsc_hmac256_state* ctx, const qsc_hmac256_key* pkey)
+{
+	assert(ctx != NULL);
+	assert(pkey != NULL);
+
+	/* the inner hash resumes after the input pad block */
+	qsc_memutils_copy((uint8_t*)ctx->pstate.state, (const uint8_t*)pkey->istate, sizeof(ctx->pstate.state));
+	qsc_memutils_clear(ctx->pstate.buffer, sizeof(ctx->pstate.buffer));
+	ctx->pstate.t = QSC_SHA2_256_RATE;
+	ctx->pstate.position = 0;
+	qsc_memutils_copy((uint8_t*)ctx->ostate, (const uint8_t*)pkey->ostate, sizeof(ctx->ostate));
+}
+
+QSC_SYSTEM_OPTIMIZE_IGNORE
+void qsc_hmac256_key_dispose(qsc_hmac256_key* pkey)
+{
+	assert(pkey != NULL);
+
+	if (pkey != NULL)
+	{
+		qsc_memutils_clear((uint8_t*)pkey->istate, sizeof(pkey->istate));
+		qsc_memutils_clear((uint8_t*)pkey->ostate, sizeof(pkey->ostate));
+	}
+}
+QSC_SYSTEM_OPTIMIZE_RESUME
+
+void qsc_hmac256_key_prepare(qsc_hmac256_key* pkey, const uint8_t* key, size_t keylen)
+{
+	assert(pkey != NULL);
+	assert(key != NULL);
+
 	const uint8_t IPAD = 0x36;
 	const uint8_t OPAD = 0x5C;
-
-	qsc_memutils_clear(ctx->ipad, QSC_SHA2_256_RATE);
+	uint8_t ipad[QSC_SHA2_256_RATE] = { 0 };
+	uint8_t opad[QSC_SHA2_256_RATE] = { 0 };
+	qsc_sha256_state hstate;
 
 	if (keylen > QSC_SHA2_256_RATE)
 	{
-		qsc_sha256_initialize(&ctx->pstate);
-		qsc_sha256_update(&ctx->pstate, key, keylen);
-		qsc_sha256_finalize(&ctx->pstate, ctx->ipad);
+		qsc_sha256_initialize(&hstate);
+		qsc_sha256_update(&hstate, key, keylen);
+		qsc_sha256_finalize(&hstate, ipad);
 	}
 	else
 	{
-		qsc_memutils_copy(ctx->ipad, key, keylen);
+		qsc_memutils_copy(ipad, key, keylen);
 	}
 
-	qsc_memutils_copy(ctx->opad, ctx->ipad, QSC_SHA2_256_RATE);
-	qsc_memutils_xorv(ctx->opad, OPAD, QSC_SHA2_256_RATE);
-	qsc_memutils_xorv(ctx->ipad, IPAD, QSC_SHA2_256_RATE);
-
-	qsc_sha256_initialize(&ctx->pstate);
-	qsc_sha256_update(&ctx->pstate, ctx->ipad, sizeof(ctx->ipad));
-}
+	qsc_memutils_copy(opad, ipad, QSC_SHA2_256_RATE);
+	qsc_memutils_xorv(opad, OPAD, QSC_SHA2_256_RATE);
+	qsc_memutils_xorv(ipad, IPAD, QSC_SHA2_256_RATE);
 
-void qsc_hmac256_update(qsc_hmac256_state* ctx, const uint8_t* message, size_t msglen)
-{
-	assert(ctx != NULL);
-	assert(message != NULL);
+	/* each pad block is compressed once, and the chaining values are stored */
+	qsc_memutils_copy((uint8_t*)pkey->istate, (const uint8_t*)sha256_iv, sizeof(pkey->istate));
+	qsc_sha256_permute(pkey->istate, ipad);
+	qsc_memutils_copy((uint8_t*)pkey->ostate, (const uint8_t*)sha256_iv, sizeof(pkey->ostate));
+	qsc_sha256_permute(pkey->ostate, opad);
 
-	qsc_sha256_update(&ctx->pstate, message, msglen);
+	qsc_memutils_clear(ipad, sizeof(ipad));
+	qsc_memutils_clear(opad, sizeof(opad));
 }
 
 /* HMAC-512 */
@@ -1434,8 +1778,7 @@ void qsc_hmac512_dispose(qsc_hmac512_state* ctx)
 	
 	if (ctx != NULL)
 	{
-		qsc_memutils_clear(ctx->ipad, sizeof(ctx->ipad));
-		qsc_memutils_clear(ctx->opad, sizeof(ctx->ipad));
+		qsc_memutils_clear((uint8_t*)ctx->ostate, sizeof(ctx->ostate));
 		qsc_sha512_dispose(&ctx->pstate);
 	}
 }
@@ -1449,8 +1792,11 @@ void qsc_hmac512_finalize(qsc_hmac512_state* ctx, uint8_t* output)
 	uint8_t tmpv[QSC_SHA2_512_HASH_SIZE] = { 0 };
 
 	qsc_sha512_finalize(&ctx->pstate, tmpv);
-	qsc_sha512_initialize(&ctx->pstate);
-	qsc_sha512_update(&ctx->pstate, ctx->opad, sizeof(ctx->opad));
+	/* resume the outer hash from its state after the output pad block */
+	qsc_memutils_copy((uint8_t*)ctx->pstate.state, (const uint8_t*)ctx->ostate, sizeof(ctx->ostate));
+	ctx->pstate.t[0] = QSC_SHA2_512_RATE;
+	ctx->pstate.t[1] = 0;
+	ctx->pstate.position = 0;
 	qsc_sha512_update(&ctx->pstate, tmpv, sizeof(tmpv));
 	qsc_sha512_finalize(&ctx->pstate, output);
 	qsc_hmac512_dispose(ctx);
@@ -1461,36 +1807,95 @@ void qsc_hmac512_initialize(qsc_hmac512_state* ctx, const uint8_t* key, size_t k
 	assert(ctx != NULL);
 	assert(key != NULL);
 
+	qsc_hmac512_key pkey;
+
+	qsc_hmac512_key_prepare(&pkey, key, keylen);
+	qsc_hmac512_initialize_prepared(ctx, &pkey);
+	qsc_hmac512_key_dispose(&pkey);
+}
+
+void qsc_hmac512_update(qsc_hmac512_state* ctx, const uint8_t* message, size_t msglen)
+{
+	assert(ctx != NULL);
+	assert(message != NULL);
+
+	qsc_sha512_update(&ctx->pstate, message, msglen);
+}
+
+void qsc_hmac512_compute_prepared(uint8_t* output, const uint8_t* message, size_t msglen, const qsc_hmac512_key* pkey)
+{
+	assert(output != NULL);
+	assert(message != NULL);
+	assert(pkey != NULL);
+
+	qsc_hmac512_state ctx;
+
+	qsc_hmac512_initialize_prepared(&ctx, pkey);
+	qsc_hmac512_update(&ctx, message, msglen);
+	qsc_hmac512_finalize(&ctx, output);
+}
+
+void qsc_hmac512_initialize_prepared(qsc_hmac512_state* ctx, const qsc_hmac512_key* pkey)
+{
+	assert(ctx != NULL);
+	assert(pkey != NULL);
+
+	/* the inner hash resumes after the input pad block */
+	qsc_memutils_copy((uint8_t*)ctx->pstate.state, (const uint8_t*)pkey->istate, sizeof(ctx->pstate.state));
+	qsc_memutils_clear(ctx->pstate.buffer, sizeof(ctx->pstate.buffer));
+	ctx->pstate.t[0] = QSC_SHA2_512_RATE;
+	ctx->pstate.t[1] = 0;
+	ctx->pstate.position = 0;
+	qsc_memutils_copy((uint8_t*)ctx->ostate, (const uint8_t*)pkey->ostate, sizeof(ctx->ostate));
+}
+
+QSC_SYSTEM_OPTIMIZE_IGNORE
+void qsc_hmac512_key_dispose(qsc_hmac512_key* pkey)
+{
+	assert(pkey != NULL);
+
+	if (pkey != NULL)
+	{
+		qsc_memutils_clear((uint8_t*)pkey->istate, sizeof(pkey->istate));
+		qsc_memutils_clear((uint8_t*)pkey->ostate, sizeof(pkey->ostate));
+	}
+}
+QSC_SYSTEM_OPTIMIZE_RESUME
+
+void qsc_hmac512_key_prepare(qsc_hmac512_key* pkey, const uint8_t* key, size_t keylen)
+{
+	assert(pkey != NULL);
+	assert(key != NULL);
+
 	const uint8_t IPAD = 0x36;
 	const uint8_t OPAD = 0x5C;
-
-	qsc_memutils_clear(ctx->ipad, QSC_SHA2_512_RATE);
+	uint8_t ipad[QSC_SHA2_512_RATE] = { 0 };
+	uint8_t opad[QSC_SHA2_512_RATE] = { 0 };
+	qsc_sha512_state hstate;
 
 	if (keylen > QSC_SHA2_512_RATE)
 	{
-		qsc_sha512_initialize(&ctx->pstate);
-		qsc_sha512_update(&ctx->pstate, key, keylen);
-		qsc_sha512_finalize(&ctx->pstate, ctx->ipad);
+		qsc_sha512_initialize(&hstate);
+		qsc_sha512_update(&hstate, key, keylen);
+		qsc_sha512_finalize(&hstate, ipad);
 	}
 	else
 	{
-		qsc_memutils_copy(ctx->ipad, key, keylen);
+		qsc_memutils_copy(ipad, key, keylen);
 	}
 
-	qsc_memutils_copy(ctx->opad, ctx->ipad, QSC_SHA2_512_RATE);
-	qsc_memutils_xorv(ctx->opad, OPAD, QSC_SHA2_512_RATE);
-	qsc_memutils_xorv(ctx->ipad, IPAD, QSC_SHA2_512_RATE);
+	qsc_memutils_copy(opad, ipad, QSC_SHA2_512_RATE);
+	qsc_memutils_xorv(opad, OPAD, QSC_SHA2_512_RATE);
+	qsc_memutils_xorv(ipad, IPAD, QSC_SHA2_512_RATE);
 
-	qsc_sha512_initialize(&ctx->pstate);
-	qsc_sha512_update(&ctx->pstate, ctx->ipad, sizeof(ctx->ipad));
-}
+	/* each pad block is compressed once, and the chaining values are stored */
+	qsc_memutils_copy((uint8_t*)pkey->istate, (const uint8_t*)sha512_iv, sizeof(pkey->istate));
+	qsc_sha512_permute(pkey->istate, ipad);
+	qsc_memutils_copy((uint8_t*)pkey->ostate, (const uint8_t*)sha512_iv, sizeof(pkey->ostate));
+	qsc_sha512_permute(pkey->ostate, opad);
 
-void qsc_hmac512_update(qsc_hmac512_state* ctx, const uint8_t* message, size_t msglen)
-{
-	assert(ctx != NULL);
-	assert(message != NULL);
-
-	qsc_sha512_update(&ctx->pstate, message, msglen);
+	qsc_memutils_clear(ipad, sizeof(ipad));
+	qsc_memutils_clear(opad, sizeof(opad));
 }
 
 /* HKDF-256 */
@@ -1501,12 +1906,16 @@ void qsc_hkdf256_expand(uint8_t* output, size_t otplen, const uint8_t* key, size
 	assert(key != NULL);
 
 	qsc_hmac256_state ctx;
+	qsc_hmac256_key pkey;
 	uint8_t buf[QSC_SHA2_256_HASH_SIZE] = { 0 };
 	uint8_t ctr[1] = { 0 };
 
+	/* the key is processed once; each output block starts from the prepared pad states */
+	qsc_hmac256_key_prepare(&pkey, key, keylen);
+
 	while (otplen != 0)
 	{
-		qsc_hmac256_initialize(&ctx, key, keylen);
+		qsc_hmac256_initialize_prepared(&ctx, &pkey);
 
 		if (ctr[0] != 0)
 		{
@@ -1528,6 +1937,8 @@ void qsc_hkdf256_expand(uint8_t* output, size_t otplen, const uint8_t* key, size
 		otplen -= RMDLEN;
 		output += RMDLEN;
 	}
+
+	qsc_hmac256_key_dispose(&pkey);
 }
 
 void qsc_hkdf256_extract(uint8_t* output, size_t otplen, const uint8_t* key, size_t keylen, const uint8_t* salt, size_t saltlen)
@@ -1562,12 +1973,16 @@ void qsc_hkdf512_expand(uint8_t* output, size_t otplen, const uint8_t* key, size
 	assert(key != NULL);
 
 	qsc_hmac512_state ctx;
+	qsc_hmac512_key pkey;
 	uint8_t buf[QSC_SHA2_512_HASH_SIZE] = { 0 };
 	uint8_t ctr[1] = { 0 };
 
+	/* the key is processed once; each output block starts from the prepared pad states */
+	qsc_hmac512_key_prepare(&pkey, key, keylen);
+
 	while (otplen != 0)
 	{
-		qsc_hmac512_initialize(&ctx, key, keylen);
+		qsc_hmac512_initialize_prepared(&ctx, &pkey);
 
 		if (ctr[0] != 0)
 		{
@@ -1589,6 +2004,8 @@ void qsc_hkdf512_expand(uint8_t* output, size_t otplen, const uint8_t* key, size
 		otplen -= RMDLEN;
 		output += RMDLEN;
 	}
+
+	qsc_hmac512_key_dispose(&pkey);
 }
 
 void qsc_hkdf512_extract(uint8_t* output, size_t otplen, const uint8_t* key, size_t keylen, const uint8_t* salt, size_t saltlen)
@@ -1614,3 +2031,638 @@ void qsc_hkdf512_extract(uint8_t* output, size_t otplen, const uint8_t* key, siz
         qsc_hmac512_finalize(&ctx, output);
     }
 }
+
+/* multi-buffer SHA2-256 */
+
+#if defined(QSC_SYSTEM_HAS_AVX512) || defined(QSC_SYSTEM_HAS_AVX2)
+
+static const uint32_t sha256_k[SHA2_256_ROUNDS_COUNT] =
+{
+	0x428A2F98UL, 0x71374491UL, 0xB5C0FBCFUL, 0xE9B5DBA5UL, 0x3956C25BUL, 0x59F111F1UL, 0x923F82A4UL, 0xAB1C5ED5UL,
+	0xD807AA98UL, 0x12835B01UL, 0x243185BEUL, 0x550C7DC3UL, 0x72BE5D74UL, 0x80DEB1FEUL, 0x9BDC06A7UL, 0xC19BF174UL,
+	0xE49B69C1UL, 0xEFBE4786UL, 0x0FC19DC6UL, 0x240CA1CCUL, 0x2DE92C6FUL, 0x4A7484AAUL, 0x5CB0A9DCUL, 0x76F988DAUL,
+	0x983E5152UL, 0xA831C66DUL, 0xB00327C8UL, 0xBF597FC7UL, 0xC6E00BF3UL, 0xD5A79147UL, 0x06CA6351UL, 0x14292967UL,
+	0x27B70A85UL, 0x2E1B2138UL, 0x4D2C6DFCUL, 0x53380D13UL, 0x650A7354UL, 0x766A0ABBUL, 0x81C2C92EUL, 0x92722C85UL,
+	0xA2BFE8A1UL, 0xA81A664BUL, 0xC24B8B70UL, 0xC76C51A3UL, 0xD192E819UL, 0xD6990624UL, 0xF40E3585UL, 0x106AA070UL,
+	0x19A4C116UL, 0x1E376C08UL, 0x2748774CUL, 0x34B0BCB5UL, 0x391C0CB3UL, 0x4ED8AA4AUL, 0x5B9CCA4FUL, 0x682E6FF3UL,
+	0x748F82EEUL, 0x78A5636FUL, 0x84C87814UL, 0x8CC70208UL, 0x90BEFFFAUL, 0xA4506CEBUL, 0xBEF9A3F7UL, 0xC67178F2UL
+};
+
+typedef struct
+{
+	uint32_t state[QSC_SHA2_STATE_SIZE][QSC_SHA256_JOB_LANES];
+	uint32_t wblk[16][QSC_SHA256_JOB_LANES];
+	uint8_t head[QSC_SHA256_JOB_LANES][QSC_SHA2_256_RATE];
+	uint8_t okey[QSC_SHA256_JOB_LANES][QSC_SHA2_256_RATE];
+	uint8_t tail[QSC_SHA256_JOB_LANES][2][QSC_SHA2_256_RATE];
+	qsc_sha256_job* job[QSC_SHA256_JOB_LANES];
+	const uint8_t* message[QSC_SHA256_JOB_LANES];
+	size_t hblocks[QSC_SHA256_JOB_LANES];
+	size_t full[QSC_SHA256_JOB_LANES];
+	size_t blocks[QSC_SHA256_JOB_LANES];
+	size_t absorbed[QSC_SHA256_JOB_LANES];
+	bool outer[QSC_SHA256_JOB_LANES];
+} sha256_job_lanes;
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+
+static __m512i sha256_ssig0_x16(__m512i x)
+{
+	return _mm512_ternarylogic_epi32(_mm512_ror_epi32(x, 7), _mm512_ror_epi32(x, 18), _mm512_srli_epi32(x, 3), 0x96);
+}
+
+static __m512i sha256_ssig1_x16(__m512i x)
+{
+	return _mm512_ternarylogic_epi32(_mm512_ror_epi32(x, 17), _mm512_ror_epi32(x, 19), _mm512_srli_epi32(x, 10), 0x96);
+}
+
+static void sha256_permute_x16(uint32_t state[QSC_SHA2_STATE_SIZE][QSC_SHA256_JOB_LANES], const uint32_t wblk[16][QSC_SHA256_JOB_LANES])
+{
+	__m512i w[16];
+	__m512i a;
+	__m512i b;
+	__m512i c;
+	__m512i d;
+	__m512i e;
+	__m512i f;
+	__m512i g;
+	__m512i h;
+	__m512i t1;
+	__m512i t2;
+	size_t i;
+
+	a = _mm512_loadu_si512((const __m512i*)state[0]);
+	b = _mm512_loadu_si512((const __m512i*)state[1]);
+	c = _mm512_loadu_si512((const __m512i*)state[2]);
+	d = _mm512_loadu_si512((const __m512i*)state[3]);
+	e = _mm512_loadu_si512((const __m512i*)state[4]);
+	f = _mm512_loadu_si512((const __m512i*)state[5]);
+	g = _mm512_loadu_si512((const __m512i*)state[6]);
+	h = _mm512_loadu_si512((const __m512i*)state[7]);
+
+	for (i = 0; i < SHA2_256_ROUNDS_COUNT; ++i)
+	{
+		if (i < 16)
+		{
+			w[i] = _mm512_loadu_si512((const __m512i*)wblk[i]);
+		}
+		else
+		{
+			w[i & 15] = _mm512_add_epi32(_mm512_add_epi32(w[i & 15], sha256_ssig0_x16(w[(i + 1) & 15])),
+				_mm512_add_epi32(w[(i + 9) & 15], sha256_ssig1_x16(w[(i + 14) & 15])));
+		}
+
+		/* ch, maj, and the three-way sigma xors are each a single vpternlogd */
+		t1 = _mm512_add_epi32(_mm512_add_epi32(h, _mm512_set1_epi32((int32_t)sha256_k[i])), _mm512_add_epi32(w[i & 15],
+			_mm512_ternarylogic_epi32(_mm512_ror_epi32(e, 6), _mm512_ror_epi32(e, 11), _mm512_ror_epi32(e, 25), 0x96)));
+		t1 = _mm512_add_epi32(t1, _mm512_ternarylogic_epi32(e, f, g, 0xCA));
+		t2 = _mm512_add_epi32(_mm512_ternarylogic_epi32(_mm512_ror_epi32(a, 2), _mm512_ror_epi32(a, 13), _mm512_ror_epi32(a, 22), 0x96),
+			_mm512_ternarylogic_epi32(a, b, c, 0xE8));
+		h = g;
+		g = f;
+		f = e;
+		e = _mm512_add_epi32(d, t1);
+		d = c;
+		c = b;
+		b = a;
+		a = _mm512_add_epi32(t1, t2);
+	}
+
+	_mm512_storeu_si512((__m512i*)state[0], _mm512_add_epi32(a, _mm512_loadu_si512((const __m512i*)state[0])));
+	_mm512_storeu_si512((__m512i*)state[1], _mm512_add_epi32(b, _mm512_loadu_si512((const __m512i*)state[1])));
+	_mm512_storeu_si512((__m512i*)state[2], _mm512_add_epi32(c, _mm512_loadu_si512((const __m512i*)state[2])));
+	_mm512_storeu_si512((__m512i*)state[3], _mm512_add_epi32(d, _mm512_loadu_si512((const __m512i*)state[3])));
+	_mm512_storeu_si512((__m512i*)state[4], _mm512_add_epi32(e, _mm512_loadu_si512((const __m512i*)state[4])));
+	_mm512_storeu_si512((__m512i*)state[5], _mm512_add_epi32(f, _mm512_loadu_si512((const __m512i*)state[5])));
+	_mm512_storeu_si512((__m512i*)state[6], _mm512_add_epi32(g, _mm512_loadu_si512((const __m512i*)state[6])));
+	_mm512_storeu_si512((__m512i*)state[7], _mm512_add_epi32(h, _mm512_loadu_si512((const __m512i*)state[7])));
+}
+
+#else
+
+static __m256i sha256_rotr_x8(__m256i x, int n)
+{
+	return _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - n));
+}
+
+static __m256i sha256_ssig0_x8(__m256i x)
+{
+	return _mm256_xor_si256(_mm256_xor_si256(sha256_rotr_x8(x, 7), sha256_rotr_x8(x, 18)), _mm256_srli_epi32(x, 3));
+}
+
+static __m256i sha256_ssig1_x8(__m256i x)
+{
+	return _mm256_xor_si256(_mm256_xor_si256(sha256_rotr_x8(x, 17), sha256_rotr_x8(x, 19)), _mm256_srli_epi32(x, 10));
+}
+
+static void sha256_permute_x8(uint32_t state[QSC_SHA2_STATE_SIZE][QSC_SHA256_JOB_LANES], const uint32_t wblk[16][QSC_SHA256_JOB_LANES])
+{
+	__m256i w[16];
+	__m256i a;
+	__m256i b;
+	__m256i c;
+	__m256i d;
+	__m256i e;
+	__m256i f;
+	__m256i g;
+	__m256i h;
+	__m256i t1;
+	__m256i t2;
+	size_t i;
+
+	a = _mm256_loadu_si256((const __m256i*)state[0]);
+	b = _mm256_loadu_si256((const __m256i*)state[1]);
+	c = _mm256_loadu_si256((const __m256i*)state[2]);
+	d = _mm256_loadu_si256((const __m256i*)state[3]);
+	e = _mm256_loadu_si256((const __m256i*)state[4]);
+	f = _mm256_loadu_si256((const __m256i*)state[5]);
+	g = _mm256_loadu_si256((const __m256i*)state[6]);
+	h = _mm256_loadu_si256((const __m256i*)state[7]);
+
+	for (i = 0; i < SHA2_256_ROUNDS_COUNT; ++i)
+	{
+		if (i < 16)
+		{
+			w[i] = _mm256_loadu_si256((const __m256i*)wblk[i]);
+		}
+		else
+		{
+			w[i & 15] = _mm256_add_epi32(_mm256_add_epi32(w[i & 15], sha256_ssig0_x8(w[(i + 1) & 15])),
+				_mm256_add_epi32(w[(i + 9) & 15], sha256_ssig1_x8(w[(i + 14) & 15])));
+		}
+
+		t1 = _mm256_add_epi32(_mm256_add_epi32(h, _mm256_set1_epi32((int32_t)sha256_k[i])), _mm256_add_epi32(w[i & 15],
+			_mm256_xor_si256(_mm256_xor_si256(sha256_rotr_x8(e, 6), sha256_rotr_x8(e, 11)), sha256_rotr_x8(e, 25))));
+		t1 = _mm256_add_epi32(t1, _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g)));
+		t2 = _mm256_add_epi32(_mm256_xor_si256(_mm256_xor_si256(sha256_rotr_x8(a, 2), sha256_rotr_x8(a, 13)), sha256_rotr_x8(a, 22)),
+			_mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b))));
+		h = g;
+		g = f;
+		f = e;
+		e = _mm256_add_epi32(d, t1);
+		d = c;
+		c = b;
+		b = a;
+		a = _mm256_add_epi32(t1, t2);
+	}
+
+	_mm256_storeu_si256((__m256i*)state[0], _mm256_add_epi32(a, _mm256_loadu_si256((const __m256i*)state[0])));
+	_mm256_storeu_si256((__m256i*)state[1], _mm256_add_epi32(b, _mm256_loadu_si256((const __m256i*)state[1])));
+	_mm256_storeu_si256((__m256i*)state[2], _mm256_add_epi32(c, _mm256_loadu_si256((const __m256i*)state[2])));
+	_mm256_storeu_si256((__m256i*)state[3], _mm256_add_epi32(d, _mm256_loadu_si256((const __m256i*)state[3])));
+	_mm256_storeu_si256((__m256i*)state[4], _mm256_add_epi32(e, _mm256_loadu_si256((const __m256i*)state[4])));
+	_mm256_storeu_si256((__m256i*)state[5], _mm256_add_epi32(f, _mm256_loadu_si256((const __m256i*)state[5])));
+	_mm256_storeu_si256((__m256i*)state[6], _mm256_add_epi32(g, _mm256_loadu_si256((const __m256i*)state[6])));
+	_mm256_storeu_si256((__m256i*)state[7], _mm256_add_epi32(h, _mm256_loadu_si256((const __m256i*)state[7])));
+}
+
+#endif
+
+static size_t sha256_job_cost(const qsc_sha256_job* job)
+{
+	size_t cost;
+
+	/* the number of compression calls the job requires */
+	cost = ((job->msglen + 8) / QSC_SHA2_256_RATE) + 1;
+
+	if (job->function == qsc_sha256_job_hmac256)
+	{
+		cost += 3;
+	}
+
+	return cost;
+}
+
+static int sha256_job_compare(const void* a, const void* b)
+{
+	const size_t CA = sha256_job_cost(*(qsc_sha256_job* const*)a);
+	const size_t CB = sha256_job_cost(*(qsc_sha256_job* const*)b);
+
+	/* longest first, so jobs in the same lanes complete together */
+	return (CA < CB) ? 1 : ((CA > CB) ? -1 : 0);
+}
+
+static size_t sha256_job_tail(uint8_t tail[2][QSC_SHA2_256_RATE], const uint8_t* input, size_t inplen, uint64_t total)
+{
+	size_t blocks;
+
+	/* the trailing message bytes, the padding bit, and the big-endian bit length */
+	qsc_memutils_clear(tail, 2 * QSC_SHA2_256_RATE);
+
+	if (inplen != 0)
+	{
+		qsc_memutils_copy(tail[0], input, inplen);
+	}
+
+	tail[0][inplen] = 128;
+	blocks = (inplen < QSC_SHA2_256_RATE - 8) ? 1 : 2;
+	qsc_intutils_be32to8(tail[blocks - 1] + 56, (uint32_t)((total << 3) >> 32));
+	qsc_intutils_be32to8(tail[blocks - 1] + 60, (uint32_t)(total << 3));
+
+	return blocks;
+}
+
+static void sha256_job_initial(sha256_job_lanes* lanes, size_t lane)
+{
+	size_t i;
+
+	for (i = 0; i < QSC_SHA2_STATE_SIZE; ++i)
+	{
+		lanes->state[i][lane] = sha256_iv[i];
+	}
+
+	lanes->absorbed[lane] = 0;
+}
+
+static void sha256_job_load(sha256_job_lanes* lanes, size_t lane, qsc_sha256_job* job)
+{
+	const size_t FULL = job->msglen / QSC_SHA2_256_RATE;
+	const size_t RMDLEN = job->msglen - (FULL * QSC_SHA2_256_RATE);
+	uint64_t total;
+
+	lanes->job[lane] = job;
+	lanes->message[lane] = job->message;
+	lanes->full[lane] = FULL;
+	lanes->outer[lane] = false;
+	lanes->hblocks[lane] = 0;
+	total = job->msglen;
+	sha256_job_initial(lanes, lane);
+
+	if (job->function == qsc_sha256_job_hmac256)
+	{
+		qsc_memutils_clear(lanes->head[lane], QSC_SHA2_256_RATE);
+
+		if (job->keylen > QSC_SHA2_256_RATE)
+		{
+			qsc_sha256_compute(lanes->head[lane], job->key, job->keylen);
+		}
+		else if (job->keylen != 0)
+		{
+			qsc_memutils_copy(lanes->head[lane], job->key, job->keylen);
+		}
+
+		/* the inner key block is absorbed first, the outer key block is kept for the second pass */
+		qsc_memutils_copy(lanes->okey[lane], lanes->head[lane], QSC_SHA2_256_RATE);
+		qsc_memutils_xorv(lanes->okey[lane], 0x5C, QSC_SHA2_256_RATE);
+		qsc_memutils_xorv(lanes->head[lane], 0x36, QSC_SHA2_256_RATE);
+		lanes->hblocks[lane] = 1;
+		total += QSC_SHA2_256_RATE;
+	}
+
+	lanes->blocks[lane] = lanes->hblocks[lane] + FULL + sha256_job_tail(lanes->tail[lane], job->message + (FULL * QSC_SHA2_256_RATE), RMDLEN, total);
+}
+
+static const uint8_t* sha256_job_block(const sha256_job_lanes* lanes, size_t lane)
+{
+	const uint8_t* blk;
+	size_t b;
+
+	b = lanes->absorbed[lane];
+
+	if (b < lanes->hblocks[lane])
+	{
+		blk = lanes->head[lane];
+	}
+	else if (b - lanes->hblocks[lane] < lanes->full[lane])
+	{
+		blk = lanes->message[lane] + ((b - lanes->hblocks[lane]) * QSC_SHA2_256_RATE);
+	}
+	else
+	{
+		blk = lanes->tail[lane][b - lanes->hblocks[lane] - lanes->full[lane]];
+	}
+
+	return blk;
+}
+
+static bool sha256_job_complete(sha256_job_lanes* lanes, size_t lane)
+{
+	uint8_t hash[QSC_SHA2_256_HASH_SIZE];
+	size_t i;
+	bool res;
+
+	for (i = 0; i < QSC_SHA2_STATE_SIZE; ++i)
+	{
+		qsc_intutils_be32to8(hash + (i * sizeof(uint32_t)), lanes->state[i][lane]);
+	}
+
+	if (lanes->job[lane]->function == qsc_sha256_job_hmac256 && lanes->outer[lane] == false)
+	{
+		/* the outer hash of the opad block and the inner hash runs in the same lane */
+		qsc_memutils_copy(lanes->head[lane], lanes->okey[lane], QSC_SHA2_256_RATE);
+		lanes->blocks[lane] = 1 + sha256_job_tail(lanes->tail[lane], hash, sizeof(hash), QSC_SHA2_256_RATE + sizeof(hash));
+		lanes->full[lane] = 0;
+		lanes->outer[lane] = true;
+		sha256_job_initial(lanes, lane);
+		res = false;
+	}
+	else
+	{
+		qsc_memutils_copy(lanes->job[lane]->output, hash, sizeof(hash));
+		res = true;
+	}
+
+	qsc_memutils_clear(hash, sizeof(hash));
+
+	return res;
+}
+
+static void sha256_jobs_permute(sha256_job_lanes* lanes, size_t active)
+{
+	const uint8_t* blk;
+	size_t i;
+	size_t lane;
+
+	if (active > 1)
+	{
+		/* transpose the next block of each lane into big-endian message words */
+		for (lane = 0; lane < QSC_SHA256_JOB_LANES; ++lane)
+		{
+			if (lanes->job[lane] != NULL)
+			{
+				blk = sha256_job_block(lanes, lane);
+
+				for (i = 0; i < 16; ++i)
+				{
+					lanes->wblk[i][lane] = qsc_intutils_be8to32(blk + (i * sizeof(uint32_t)));
+				}
+			}
+		}
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+		sha256_permute_x16(lanes->state, (const uint32_t (*)[QSC_SHA256_JOB_LANES])lanes->wblk);
+#else
+		sha256_permute_x8(lanes->state, (const uint32_t (*)[QSC_SHA256_JOB_LANES])lanes->wblk);
+#endif
+	}
+	else
+	{
+		uint32_t state[QSC_SHA2_STATE_SIZE];
+
+		/* a single job remains; finish it with the sequential compression function */
+		for (lane = 0; lane < QSC_SHA256_JOB_LANES; ++lane)
+		{
+			if (lanes->job[lane] != NULL)
+			{
+				for (i = 0; i < QSC_SHA2_STATE_SIZE; ++i)
+				{
+					state[i] = lanes->state[i][lane];
+				}
+
+				qsc_sha256_permute(state, sha256_job_block(lanes, lane));
+
+				for (i = 0; i < QSC_SHA2_STATE_SIZE; ++i)
+				{
+					lanes->state[i][lane] = state[i];
+				}
+			}
+		}
+
+		qsc_memutils_clear((uint8_t*)state, sizeof(state));
+	}
+}
+
+static void sha256_jobs_process(qsc_sha256_job** queue, size_t count)
+{
+	sha256_job_lanes lanes;
+	size_t active;
+	size_t lane;
+	size_t next;
+
+	qsc_memutils_clear(&lanes, sizeof(lanes));
+	active = 0;
+	next = 0;
+
+	/* fill the lanes with the longest jobs */
+	for (lane = 0; lane < QSC_SHA256_JOB_LANES && next < count; ++lane)
+	{
+		sha256_job_load(&lanes, lane, queue[next]);
+		++active;
+		++next;
+	}
+
+	while (active != 0)
+	{
+		sha256_jobs_permute(&lanes, active);
+
+		for (lane = 0; lane < QSC_SHA256_JOB_LANES; ++lane)
+		{
+			if (lanes.job[lane] != NULL)
+			{
+				++lanes.absorbed[lane];
+
+				if (lanes.absorbed[lane] == lanes.blocks[lane] && sha256_job_complete(&lanes, lane) == true)
+				{
+					/* retire the completed job and refill the lane from the queue */
+					lanes.job[lane] = NULL;
+					--active;
+
+					if (next < count)
+					{
+						sha256_job_load(&lanes, lane, queue[next]);
+						++active;
+						++next;
+					}
+				}
+			}
+		}
+	}
+
+	qsc_memutils_clear(&lanes, sizeof(lanes));
+}
+
+#endif
+
+void qsc_sha256_jobs_compute(qsc_sha256_job* jobs, size_t count)
+{
+	assert(jobs != NULL);
+
+	size_t i;
+
+	if (jobs != NULL && count != 0)
+	{
+#if defined(QSC_SYSTEM_HAS_AVX512) || defined(QSC_SYSTEM_HAS_AVX2)
+		qsc_sha256_job** queue;
+
+		queue = (qsc_sha256_job**)qsc_memutils_malloc(count * sizeof(qsc_sha256_job*));
+
+		if (queue != NULL)
+		{
+			for (i = 0; i < count; ++i)
+			{
+				queue[i] = &jobs[i];
+			}
+
+			/* group the jobs by compression count */
+			qsort(queue, count, sizeof(qsc_sha256_job*), sha256_job_compare);
+
+			/* run the jobs in parallel lanes */
+			sha256_jobs_process(queue, count);
+
+			qsc_memutils_alloc_free(queue);
+		}
+		else
+#endif
+		{
+			for (i = 0; i < count; ++i)
+			{
+				if (jobs[i].function == qsc_sha256_job_hmac256)
+				{
+					qsc_hmac256_compute(jobs[i].output, jobs[i].message, jobs[i].msglen, jobs[i].key, jobs[i].keylen);
+				}
+				else
+				{
+					qsc_sha256_compute(jobs[i].output, jobs[i].message, jobs[i].msglen);
+				}
+			}
+		}
+	}
+}
+
+void qsc_sha256_jobs_flush(qsc_sha256_job_manager* mgr)
+{
+	assert(mgr != NULL);
+
+	if (mgr != NULL && mgr->count != 0)
+	{
+		qsc_sha256_jobs_compute(mgr->jobs, mgr->count);
+		mgr->count = 0;
+	}
+}
+
+void qsc_sha256_jobs_initialize(qsc_sha256_job_manager* mgr, qsc_sha256_job* jobs, size_t capacity)
+{
+	assert(mgr != NULL);
+	assert(jobs != NULL);
+	assert(capacity != 0);
+
+	if (mgr != NULL)
+	{
+		mgr->jobs = jobs;
+		mgr->capacity = capacity;
+		mgr->count = 0;
+	}
+}
+
+void qsc_sha256_jobs_submit(qsc_sha256_job_manager* mgr, const qsc_sha256_job* job)
+{
+	assert(mgr != NULL);
+	assert(job != NULL);
+
+	if (mgr != NULL && job != NULL)
+	{
+		if (mgr->count == mgr->capacity)
+		{
+			qsc_sha256_jobs_flush(mgr);
+		}
+
+		qsc_memutils_copy(&mgr->jobs[mgr->count], job, sizeof(qsc_sha256_job));
+		++mgr->count;
+	}
+}
+
+/* batch MAC verification */
+
+bool qsc_hmac256_verify_batch(uint8_t* bitmap, const qsc_hmac_verify_item* items, size_t count)
+{
+	assert(bitmap != NULL);
+	assert(items != NULL);
+
+	qsc_sha256_job* jobs;
+	uint8_t* codes;
+	size_t i;
+	uint32_t fail;
+	uint8_t res;
+	bool status;
+
+	status = false;
+
+	if (bitmap != NULL && items != NULL)
+	{
+		qsc_memutils_clear(bitmap, (count + 7) / 8);
+		status = true;
+
+		if (count != 0)
+		{
+			jobs = (qsc_sha256_job*)qsc_memutils_malloc(count * sizeof(qsc_sha256_job));
+			codes = (uint8_t*)qsc_memutils_malloc(count * QSC_HMAC_256_MAC_SIZE);
+
+			if (jobs != NULL && codes != NULL)
+			{
+				for (i = 0; i < count; ++i)
+				{
+					jobs[i].output = codes + (i * QSC_HMAC_256_MAC_SIZE);
+					jobs[i].message = items[i].message;
+					jobs[i].key = items[i].key;
+					jobs[i].msglen = items[i].msglen;
+					jobs[i].keylen = items[i].keylen;
+					jobs[i].function = qsc_sha256_job_hmac256;
+				}
+
+				qsc_sha256_jobs_compute(jobs, count);
+				fail = 0;
+
+				/* every code is compared, and the result is accumulated without branching */
+				for (i = 0; i < count; ++i)
+				{
+					res = (uint8_t)(qsc_intutils_verify(items[i].code, codes + (i * QSC_HMAC_256_MAC_SIZE), QSC_HMAC_256_MAC_SIZE) + 1);
+					bitmap[i / 8] |= (uint8_t)(res << (i % 8));
+					fail |= (uint32_t)(res ^ 1U);
+				}
+
+				qsc_memutils_clear(codes, count * QSC_HMAC_256_MAC_SIZE);
+				status = (fail == 0);
+			}
+			else
+			{
+				status = false;
+			}
+
+			if (jobs != NULL)
+			{
+				qsc_memutils_alloc_free(jobs);
+			}
+
+			if (codes != NULL)
+			{
+				qsc_memutils_alloc_free(codes);
+			}
+		}
+	}
+
+	return status;
+}
+
+bool qsc_hmac512_verify_batch(uint8_t* bitmap, const qsc_hmac_verify_item* items, size_t count)
+{
+	assert(bitmap != NULL);
+	assert(items != NULL);
+
+	uint8_t code[QSC_HMAC_512_MAC_SIZE] = { 0 };
+	size_t i;
+	uint32_t fail;
+	uint8_t res;
+	bool status;
+
+	status = false;
+
+	if (bitmap != NULL && items != NULL)
+	{
+		qsc_memutils_clear(bitmap, (count + 7) / 8);
+		fail = 0;
+
+		/* there is no multi-lane SHA2-512 engine, so the codes are computed in sequence */
+		for (i = 0; i < count; ++i)
+		{
+			qsc_hmac512_compute(code, items[i].message, items[i].msglen, items[i].key, items[i].keylen);
+			res = (uint8_t)(qsc_intutils_verify(items[i].code, code, QSC_HMAC_512_MAC_SIZE) + 1);
+			bitmap[i / 8] |= (uint8_t)(res << (i % 8));
+			fail |= (uint32_t)(res ^ 1U);
+		}
+
+		qsc_memutils_clear(code, sizeof(code));
+		status = (fail == 0);
+	}
+
+	return status;
+}
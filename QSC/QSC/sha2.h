@@ -34,7 +34,8 @@
 * \updated September 12, 2020
 *
 * \brief SHA2 header definition \n
-* Contains the public api and documentation for SHA2 digests, HMAC and HKDF implementations.
+* Contains the public api and documentation for SHA2 digests, HMAC and HKDF implementations,
+* and a multi-buffer SHA2-256 and HMAC(SHA2-256) engine.
 *
 * SHA2-512 hash computation using long-form api \n
 * \code
@@ -78,6 +79,17 @@
 //#	define QSC_SHA2_SHANI_ENABLED
 #endif
 
+/*!
+* \def QSC_SHA2_AVX2_SCHEDULE_ENABLED
+* \brief Enables the AVX2 SHA2-512 message schedule.
+* Multi-block updates compute the message schedule of two blocks in the vector unit, interleaved with the scalar rounds.
+* This helps processors where the scalar schedule competes with the rounds for integer ports;
+* on wide cores the rounds are latency bound, and the scalar schedule is already hidden.
+*/
+#if !defined(QSC_SHA2_AVX2_SCHEDULE_ENABLED)
+//#	define QSC_SHA2_AVX2_SCHEDULE_ENABLED
+#endif
+
 /*!
 * \def QSC_HKDF_256_KEY_SIZE
 * \brief The HKDF-256 key size in bytes
@@ -375,7 +387,9 @@ QSC_EXPORT_API void qsc_sha512_initialize(qsc_sha512_state* ctx);
 /**
 * \brief The SHA2-512 permutation function.
 * Internal function: called by protocol hash and generation functions, or in the construction of other external protocols.
-* Absorbs a message and permutes the state array.
+* Absorbs a message and permutes the state array. \n
+* Uses the SHA512 instruction set extension when the processor reports it, and the compiler supports it (GCC 14, Clang 18).
+* Multi-block updates of SHA2-384 and SHA2-512 use a vector message schedule when QSC_SHA2_AVX2_SCHEDULE_ENABLED is defined.
 *
 * \param output: The function output; must be initialized
 * \param input: [const] The input message byte array
@@ -403,11 +417,22 @@ QSC_EXPORT_API void qsc_sha512_update(qsc_sha512_state* ctx, const uint8_t* mess
 */
 QSC_EXPORT_API typedef struct
 {
-	qsc_sha256_state pstate;			/*!< The SHA2-256 state  */
-	uint8_t ipad[QSC_SHA2_256_RATE];	/*!< The input pad array  */
-	uint8_t opad[QSC_SHA2_256_RATE];	/*!< The output pad array  */
+	qsc_sha256_state pstate;				/*!< The SHA2-256 state  */
+	uint32_t ostate[QSC_SHA2_STATE_SIZE];	/*!< The outer hash state after the output pad block  */
 } qsc_hmac256_state;
 
+/*!
+* \struct qsc_hmac256_key
+* \brief A prepared HMAC(SHA2-256) key.
+* Holds the hash states after the input and output pad blocks, so that an instance
+* can be keyed by copying the states rather than compressing both pad blocks again.
+*/
+QSC_EXPORT_API typedef struct
+{
+	uint32_t istate[QSC_SHA2_STATE_SIZE];	/*!< The inner hash state after the input pad block  */
+	uint32_t ostate[QSC_SHA2_STATE_SIZE];	/*!< The outer hash state after the output pad block  */
+} qsc_hmac256_key;
+
 /**
 * \brief Process a message with HMAC(SHA2-256) and returns the hash code in the output byte array.
 * Short form api: processes the key and complete message, and generates the MAC code with a single call.
@@ -466,6 +491,48 @@ QSC_EXPORT_API void qsc_hmac256_initialize(qsc_hmac256_state* ctx, const uint8_t
 */
 QSC_EXPORT_API void qsc_hmac256_update(qsc_hmac256_state* ctx, const uint8_t* message, size_t msglen);
 
+/**
+* \brief Process a message with HMAC(SHA2-256) using a prepared key, and return the MAC code in the output byte array.
+* Short form api: keys the instance from the prepared key, and generates the MAC code with a single call.
+*
+* \warning The output array must be at least 32 bytes in length.
+*
+* \param output: The output byte array; receives the MAC code
+* \param message: [const] The message input byte array
+* \param msglen: The number of message bytes to process
+* \param pkey: [const] The prepared key; must be initialized with qsc_hmac256_key_prepare
+*/
+QSC_EXPORT_API void qsc_hmac256_compute_prepared(uint8_t* output, const uint8_t* message, size_t msglen, const qsc_hmac256_key* pkey);
+
+/**
+* \brief Initializes an HMAC-256 state structure from a prepared key.
+* Long form api: must be used in conjunction with the update and finalize functions.
+* Copies the pad block states from the prepared key; one prepared key can key any number of instances.
+*
+* \param ctx: [struct] The function state
+* \param pkey: [const] The prepared key; must be initialized with qsc_hmac256_key_prepare
+*/
+QSC_EXPORT_API void qsc_hmac256_initialize_prepared(qsc_hmac256_state* ctx, const qsc_hmac256_key* pkey);
+
+/**
+* \brief Dispose of a prepared HMAC-256 key.
+* This function erases the pad block states.
+*
+* \param pkey: [struct] The prepared key structure
+*/
+QSC_EXPORT_API void qsc_hmac256_key_dispose(qsc_hmac256_key* pkey);
+
+/**
+* \brief Prepare an HMAC-256 key.
+* Hashes the input and output pad blocks once, so that instances using the same key
+* can be initialized with qsc_hmac256_initialize_prepared without re-processing the key.
+*
+* \param pkey: [struct] The prepared key structure
+* \param key: [const] The secret key array
+* \param keylen: The key array length
+*/
+QSC_EXPORT_API void qsc_hmac256_key_prepare(qsc_hmac256_key* pkey, const uint8_t* key, size_t keylen);
+
 /* HMAC-512 */
 
 /*!
@@ -474,11 +541,22 @@ QSC_EXPORT_API void qsc_hmac256_update(qsc_hmac256_state* ctx, const uint8_t* me
 */
 QSC_EXPORT_API typedef struct
 {
-	qsc_sha512_state pstate;			/*!< The SHA2-512 state  */
-	uint8_t ipad[QSC_SHA2_512_RATE];	/*!< The input pad array  */
-	uint8_t opad[QSC_SHA2_512_RATE];	/*!< The output pad array  */
+	qsc_sha512_state pstate;				/*!< The SHA2-512 state  */
+	uint64_t ostate[QSC_SHA2_STATE_SIZE];	/*!< The outer hash state after the output pad block  */
 } qsc_hmac512_state;
 
+/*!
+* \struct qsc_hmac512_key
+* \brief A prepared HMAC(SHA2-512) key.
+* Holds the hash states after the input and output pad blocks, so that an instance
+* can be keyed by copying the states rather than compressing both pad blocks again.
+*/
+QSC_EXPORT_API typedef struct
+{
+	uint64_t istate[QSC_SHA2_STATE_SIZE];	/*!< The inner hash state after the input pad block  */
+	uint64_t ostate[QSC_SHA2_STATE_SIZE];	/*!< The outer hash state after the output pad block  */
+} qsc_hmac512_key;
+
 /**
 * \brief Process a message with SHA2-512 and returns the hash code in the output byte array.
 * Short form api: processes the key and complete message, and generates the MAC code with a single call.
@@ -539,6 +617,48 @@ QSC_EXPORT_API void qsc_hmac512_initialize(qsc_hmac512_state* ctx, const uint8_t
 */
 QSC_EXPORT_API void qsc_hmac512_update(qsc_hmac512_state* ctx, const uint8_t* message, size_t msglen);
 
+/**
+* \brief Process a message with HMAC(SHA2-512) using a prepared key, and return the MAC code in the output byte array.
+* Short form api: keys the instance from the prepared key, and generates the MAC code with a single call.
+*
+* \warning The output array must be at least 64 bytes in length.
+*
+* \param output: The output byte array; receives the MAC code
+* \param message: [const] The message input byte array
+* \param msglen: The number of message bytes to process
+* \param pkey: [const] The prepared key; must be initialized with qsc_hmac512_key_prepare
+*/
+QSC_EXPORT_API void qsc_hmac512_compute_prepared(uint8_t* output, const uint8_t* message, size_t msglen, const qsc_hmac512_key* pkey);
+
+/**
+* \brief Initializes an HMAC-512 state structure from a prepared key.
+* Long form api: must be used in conjunction with the update and finalize functions.
+* Copies the pad block states from the prepared key; one prepared key can key any number of instances.
+*
+* \param ctx: [struct] The function state
+* \param pkey: [const] The prepared key; must be initialized with qsc_hmac512_key_prepare
+*/
+QSC_EXPORT_API void qsc_hmac512_initialize_prepared(qsc_hmac512_state* ctx, const qsc_hmac512_key* pkey);
+
+/**
+* \brief Dispose of a prepared HMAC-512 key.
+* This function erases the pad block states.
+*
+* \param pkey: [struct] The prepared key structure
+*/
+QSC_EXPORT_API void qsc_hmac512_key_dispose(qsc_hmac512_key* pkey);
+
+/**
+* \brief Prepare an HMAC-512 key.
+* Hashes the input and output pad blocks once, so that instances using the same key
+* can be initialized with qsc_hmac512_initialize_prepared without re-processing the key.
+*
+* \param pkey: [struct] The prepared key structure
+* \param key: [const] The secret key array
+* \param keylen: The key array length
+*/
+QSC_EXPORT_API void qsc_hmac512_key_prepare(qsc_hmac512_key* pkey, const uint8_t* key, size_t keylen);
+
 /* HKDF */
 
 /**
@@ -591,4 +711,133 @@ QSC_EXPORT_API void qsc_hkdf512_expand(uint8_t* output, size_t otplen, const uin
 */
 QSC_EXPORT_API void qsc_hkdf512_extract(uint8_t* output, size_t otplen, const uint8_t* key, size_t keylen, const uint8_t* salt, size_t saltlen);
 
+/* multi-buffer SHA2-256 */
+
+/*!
+* \def QSC_SHA256_JOB_LANES
+* \brief The number of independent SHA2-256 jobs processed in parallel SIMD lanes by the multi-buffer engine
+*/
+#if defined(QSC_SYSTEM_HAS_AVX512)
+#	define QSC_SHA256_JOB_LANES 16
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+#	define QSC_SHA256_JOB_LANES 8
+#else
+#	define QSC_SHA256_JOB_LANES 1
+#endif
+
+/*!
+* \enum qsc_sha256_job_function
+* \brief The function computed by a multi-buffer SHA2-256 job
+*/
+typedef enum qsc_sha256_job_function
+{
+	qsc_sha256_job_sha256 = 0,						/*!< A SHA2-256 message digest  */
+	qsc_sha256_job_hmac256 = 1,						/*!< An HMAC(SHA2-256) code; keyed with the key array  */
+} qsc_sha256_job_function;
+
+/*!
+* \struct qsc_sha256_job
+* \brief A multi-buffer job; one independent SHA2-256 or HMAC(SHA2-256) computation
+*/
+QSC_EXPORT_API typedef struct
+{
+	uint8_t* output;								/*!< The 32-byte output array  */
+	const uint8_t* message;							/*!< The message array  */
+	const uint8_t* key;								/*!< The HMAC key array; unused by SHA2-256  */
+	size_t msglen;									/*!< The number of message bytes  */
+	size_t keylen;									/*!< The HMAC key length  */
+	qsc_sha256_job_function function;				/*!< The job function  */
+} qsc_sha256_job;
+
+/*!
+* \struct qsc_sha256_job_manager
+* \brief The multi-buffer SHA2-256 job manager; queues jobs in a caller supplied array
+*/
+QSC_EXPORT_API typedef struct
+{
+	qsc_sha256_job* jobs;							/*!< The job queue array  */
+	size_t capacity;								/*!< The number of jobs the queue can hold  */
+	size_t count;									/*!< The number of queued jobs  */
+} qsc_sha256_job_manager;
+
+/**
+* \brief Compute a set of independent SHA2-256 and HMAC(SHA2-256) jobs.
+* Up to QSC_SHA256_JOB_LANES jobs are processed in parallel SIMD lanes (16 with AVX-512, 8 with AVX2).
+* The jobs are scheduled longest first, and a lane that completes its job is refilled from the pending set,
+* so messages of different lengths share the compression lanes without idling. \n
+* Each job produces the same output as qsc_sha256_compute or qsc_hmac256_compute.
+*
+* \param jobs: [struct] The array of jobs
+* \param count: The number of jobs in the array
+*/
+QSC_EXPORT_API void qsc_sha256_jobs_compute(qsc_sha256_job* jobs, size_t count);
+
+/**
+* \brief Compute all queued jobs and empty the queue.
+*
+* \param mgr: [struct] The job manager; must be initialized
+*/
+QSC_EXPORT_API void qsc_sha256_jobs_flush(qsc_sha256_job_manager* mgr);
+
+/**
+* \brief Initialize a multi-buffer SHA2-256 job manager.
+*
+* \param mgr: [struct] The job manager
+* \param jobs: [struct] The array used to queue jobs
+* \param capacity: The number of jobs the array can hold
+*/
+QSC_EXPORT_API void qsc_sha256_jobs_initialize(qsc_sha256_job_manager* mgr, qsc_sha256_job* jobs, size_t capacity);
+
+/**
+* \brief Submit a job to the manager queue.
+* If the queue is full, the queued jobs are computed before the job is added.
+*
+* \warning The output of a job is written when the queue is flushed;
+* the message, key, and output arrays must remain valid until then.
+*
+* \param mgr: [struct] The job manager; must be initialized
+* \param job: [const][struct] The job to queue
+*/
+QSC_EXPORT_API void qsc_sha256_jobs_submit(qsc_sha256_job_manager* mgr, const qsc_sha256_job* job);
+
+/* batch MAC verification */
+
+/*!
+* \struct qsc_hmac_verify_item
+* \brief One HMAC code to verify in a batch; each item carries its own key
+*/
+QSC_EXPORT_API typedef struct
+{
+	const uint8_t* code;							/*!< The received MAC code; the full MAC size of the function  */
+	const uint8_t* message;							/*!< The message array  */
+	const uint8_t* key;								/*!< The HMAC key array  */
+	size_t msglen;									/*!< The number of message bytes  */
+	size_t keylen;									/*!< The HMAC key length  */
+} qsc_hmac_verify_item;
+
+/**
+* \brief Verify a batch of HMAC(SHA2-256) codes.
+* The codes are computed with the multi-buffer SHA2-256 engine, and each code is compared in constant time.
+* Every item is evaluated; the bitmap reveals which items failed, but not where a code differs. \n
+* Bit (i % 8) of bitmap byte (i / 8) is set if item i verifies.
+*
+* \param bitmap: The output bitmap; must be at least (count + 7) / 8 bytes
+* \param items: [const][struct] The array of items to verify; each code is 32 bytes
+* \param count: The number of items
+* \return: Returns true if every item verifies; returns false if any item fails or memory allocation fails
+*/
+QSC_EXPORT_API bool qsc_hmac256_verify_batch(uint8_t* bitmap, const qsc_hmac_verify_item* items, size_t count);
+
+/**
+* \brief Verify a batch of HMAC(SHA2-512) codes.
+* Each code is computed and compared in constant time, and every item is evaluated. \n
+* Bit (i % 8) of bitmap byte (i / 8) is set if item i verifies.
+*
+* \param bitmap: The output bitmap; must be at least (count + 7) / 8 bytes
+* \param items: [const][struct] The array of items to verify; each code is 64 bytes
+* \param count: The number of items
+* \return: Returns true if every item verifies
+*/
+QSC_EXPORT_API bool qsc_hmac512_verify_batch(uint8_t* bitmap, const qsc_hmac_verify_item* items, size_t count);
+
 #endif
@@ -1,11 +1,25 @@
 #include "sha3.h"
+#include "async.h"
 #include "intutils.h"
 #include "memutils.h"
+#include <stdlib.h>
 
 #define KPA_LEAF_HASH128 16
 #define KPA_LEAF_HASH256 32
 #define KPA_LEAF_HASH512 64
 
+/* the rotations are expanded in place rather than called through intutils */
+#if defined(QSC_SYSTEM_COMPILER_MSC)
+#	define KECCAK_ROTL64(x, n) _rotl64((x), (int)(n))
+#else
+#	define KECCAK_ROTL64(x, n) (((x) << (n)) | ((x) >> (64 - (n))))
+#endif
+
+/* AVX-512VL provides the 128-bit forms of vpternlogq and vprolq used by the single-state permutation */
+#if defined(QSC_SYSTEM_HAS_AVX512) && defined(__AVX512VL__)
+#	define KECCAK_AVX512VL_PERMUTATION
+#endif
+
 /* keccak round constants */
 static const uint64_t KECCAK_ROUND_CONSTANTS[QSC_KECCAK_PERMUTATION_MAX_ROUNDS] =
 {
@@ -84,7 +98,7 @@ static size_t keccak_right_encode(uint8_t* buffer, size_t value)
 #if defined(QSC_SYSTEM_HAS_AVX512)
 #	if defined(QSC_KECCAK_UNROLLED_PERMUTATION)
 
-void qsc_keccak_permute_p8x1600(__m512i state[QSC_KECCAK_STATE_SIZE], size_t rounds)
+static void keccak_permute_p8x1600(__m512i state[QSC_KECCAK_STATE_SIZE], const uint64_t* rc, size_t rounds)
 {
 	assert(rounds % 2 == 0);
 
@@ -184,82 +198,82 @@ void qsc_keccak_permute_p8x1600(__m512i state[QSC_KECCAK_STATE_SIZE], size_t rou
 		c2 = _mm512_xor_si512(_mm512_xor_si512(_mm512_xor_si512(a2, a7), _mm512_xor_si512(a12, a17)), a22);
 		c3 = _mm512_xor_si512(_mm512_xor_si512(_mm512_xor_si512(a3, a8), _mm512_xor_si512(a13, a18)), a23);
 		c4 = _mm512_xor_si512(_mm512_xor_si512(_mm512_xor_si512(a4, a9), _mm512_xor_si512(a14, a19)), a24);
-		d0 = _mm512_xor_si512(c4, _mm512_or_si512(_mm512_slli_epi64(c1, 1), _mm512_srli_epi64(c1, 64 - 1)));
-		d1 = _mm512_xor_si512(c0, _mm512_or_si512(_mm512_slli_epi64(c2, 1), _mm512_srli_epi64(c2, 64 - 1)));
-		d2 = _mm512_xor_si512(c1, _mm512_or_si512(_mm512_slli_epi64(c3, 1), _mm512_srli_epi64(c3, 64 - 1)));
-		d3 = _mm512_xor_si512(c2, _mm512_or_si512(_mm512_slli_epi64(c4, 1), _mm512_srli_epi64(c4, 64 - 1)));
-		d4 = _mm512_xor_si512(c3, _mm512_or_si512(_mm512_slli_epi64(c0, 1), _mm512_srli_epi64(c0, 64 - 1)));
+		d0 = _mm512_xor_si512(c4, _mm512_rol_epi64(c1, 1));
+		d1 = _mm512_xor_si512(c0, _mm512_rol_epi64(c2, 1));
+		d2 = _mm512_xor_si512(c1, _mm512_rol_epi64(c3, 1));
+		d3 = _mm512_xor_si512(c2, _mm512_rol_epi64(c4, 1));
+		d4 = _mm512_xor_si512(c3, _mm512_rol_epi64(c0, 1));
 		a0 = _mm512_xor_si512(a0, d0);
 		c0 = a0;
 		a6 = _mm512_xor_si512(a6, d1);
-		c1 = _mm512_or_si512(_mm512_slli_epi64(a6, 44), _mm512_srli_epi64(a6, 64 - 44));
+		c1 = _mm512_rol_epi64(a6, 44);
 		a12 = _mm512_xor_si512(a12, d2);
-		c2 = _mm512_or_si512(_mm512_slli_epi64(a12, 43), _mm512_srli_epi64(a12, 64 - 43));
+		c2 = _mm512_rol_epi64(a12, 43);
 		a18 = _mm512_xor_si512(a18, d3);
-		c3 = _mm512_or_si512(_mm512_slli_epi64(a18, 21), _mm512_srli_epi64(a18, 64 - 21));
+		c3 = _mm512_rol_epi64(a18, 21);
 		a24 = _mm512_xor_si512(a24, d4);
-		c4 = _mm512_or_si512(_mm512_slli_epi64(a24, 14), _mm512_srli_epi64(a24, 64 - 14));
+		c4 = _mm512_rol_epi64(a24, 14);
 		e0 = _mm512_xor_si512(c0, _mm512_and_si512(_mm512_xor_epi64(c1, _mm512_set1_epi64(-1)), c2));
-		e0 = _mm512_xor_si512(e0, _mm512_set1_epi64(KECCAK_ROUND_CONSTANTS[i]));
+		e0 = _mm512_xor_si512(e0, _mm512_set1_epi64(rc[i]));
 		e1 = _mm512_xor_si512(c1, _mm512_and_si512(_mm512_xor_epi64(c2, _mm512_set1_epi64(-1)), c3));
 		e2 = _mm512_xor_si512(c2, _mm512_and_si512(_mm512_xor_epi64(c3, _mm512_set1_epi64(-1)), c4));
 		e3 = _mm512_xor_si512(c3, _mm512_and_si512(_mm512_xor_epi64(c4, _mm512_set1_epi64(-1)), c0));
 		e4 = _mm512_xor_si512(c4, _mm512_and_si512(_mm512_xor_epi64(c0, _mm512_set1_epi64(-1)), c1));
 		a3 = _mm512_xor_si512(a3, d3);
-		c0 = _mm512_or_si512(_mm512_slli_epi64(a3, 28), _mm512_srli_epi64(a3, 64 - 28));
+		c0 = _mm512_rol_epi64(a3, 28);
 		a9 = _mm512_xor_si512(a9, d4);
-		c1 = _mm512_or_si512(_mm512_slli_epi64(a9, 20), _mm512_srli_epi64(a9, 64 - 20));
+		c1 = _mm512_rol_epi64(a9, 20);
 		a10 = _mm512_xor_si512(a10, d0);
-		c2 = _mm512_or_si512(_mm512_slli_epi64(a10, 3), _mm512_srli_epi64(a10, 64 - 3));
+		c2 = _mm512_rol_epi64(a10, 3);
 		a16 = _mm512_xor_si512(a16, d1);
-		c3 = _mm512_or_si512(_mm512_slli_epi64(a16, 45), _mm512_srli_epi64(a16, 64 - 45));
+		c3 = _mm512_rol_epi64(a16, 45);
 		a22 = _mm512_xor_si512(a22, d2);
-		c4 = _mm512_or_si512(_mm512_slli_epi64(a22, 61), _mm512_srli_epi64(a22, 64 - 61));
+		c4 = _mm512_rol_epi64(a22, 61);
 		e5 = _mm512_xor_si512(c0, _mm512_and_si512(_mm512_xor_epi64(c1, _mm512_set1_epi64(-1)), c2));
 		e6 = _mm512_xor_si512(c1, _mm512_and_si512(_mm512_xor_epi64(c2, _mm512_set1_epi64(-1)), c3));
 		e7 = _mm512_xor_si512(c2, _mm512_and_si512(_mm512_xor_epi64(c3, _mm512_set1_epi64(-1)), c4));
 		e8 = _mm512_xor_si512(c3, _mm512_and_si512(_mm512_xor_epi64(c4, _mm512_set1_epi64(-1)), c0));
 		e9 = _mm512_xor_si512(c4, _mm512_and_si512(_mm512_xor_epi64(c0, _mm512_set1_epi64(-1)), c1));
 		a1 = _mm512_xor_si512(a1, d1);
-		c0 = _mm512_or_si512(_mm512_slli_epi64(a1, 1), _mm512_srli_epi64(a1, 64 - 1));
+		c0 = _mm512_rol_epi64(a1, 1);
 		a7 = _mm512_xor_si512(a7, d2);
-		c1 = _mm512_or_si512(_mm512_slli_epi64(a7, 6), _mm512_srli_epi64(a7, 64 - 6));
+		c1 = _mm512_rol_epi64(a7, 6);
 		a13 = _mm512_xor_si512(a13, d3);
-		c2 = _mm512_or_si512(_mm512_slli_epi64(a13, 25), _mm512_srli_epi64(a13, 64 - 25));
+		c2 = _mm512_rol_epi64(a13, 25);
 		a19 = _mm512_xor_si512(a19, d4);
-		c3 = _mm512_or_si512(_mm512_slli_epi64(a19, 8), _mm512_srli_epi64(a19, 64 - 8));
+		c3 = _mm512_rol_epi64(a19, 8);
 		a20 = _mm512_xor_si512(a20, d0);
-		c4 = _mm512_or_si512(_mm512_slli_epi64(a20, 18), _mm512_srli_epi64(a20, 64 - 18));
+		c4 = _mm512_rol_epi64(a20, 18);
 		e10 = _mm512_xor_si512(c0, _mm512_and_si512(_mm512_xor_epi64(c1, _mm512_set1_epi64(-1)), c2));
 		e11 = _mm512_xor_si512(c1, _mm512_and_si512(_mm512_xor_epi64(c2, _mm512_set1_epi64(-1)), c3));
 		e12 = _mm512_xor_si512(c2, _mm512_and_si512(_mm512_xor_epi64(c3, _mm512_set1_epi64(-1)), c4));
 		e13 = _mm512_xor_si512(c3, _mm512_and_si512(_mm512_xor_epi64(c4, _mm512_set1_epi64(-1)), c0));
 		e14 = _mm512_xor_si512(c4, _mm512_and_si512(_mm512_xor_epi64(c0, _mm512_set1_epi64(-1)), c1));
 		a4 = _mm512_xor_si512(a4, d4);
-		c0 = _mm512_or_si512(_mm512_slli_epi64(a4, 27), _mm512_srli_epi64(a4, 64 - 27));
+		c0 = _mm512_rol_epi64(a4, 27);
 		a5 = _mm512_xor_si512(a5, d0);
-		c1 = _mm512_or_si512(_mm512_slli_epi64(a5, 36), _mm512_srli_epi64(a5, 64 - 36));
+		c1 = _mm512_rol_epi64(a5, 36);
 		a11 = _mm512_xor_si512(a11, d1);
-		c2 = _mm512_or_si512(_mm512_slli_epi64(a11, 10), _mm512_srli_epi64(a11, 64 - 10));
+		c2 = _mm512_rol_epi64(a11, 10);
 		a17 = _mm512_xor_si512(a17, d2);
-		c3 = _mm512_or_si512(_mm512_slli_epi64(a17, 15), _mm512_srli_epi64(a17, 64 - 15));
+		c3 = _mm512_rol_epi64(a17, 15);
 		a23 = _mm512_xor_si512(a23, d3);
-		c4 = _mm512_or_si512(_mm512_slli_epi64(a23, 56), _mm512_srli_epi64(a23, 64 - 56));
+		c4 = _mm512_rol_epi64(a23, 56);
 		e15 = _mm512_xor_si512(c0, _mm512_and_si512(_mm512_xor_epi64(c1, _mm512_set1_epi64(-1)), c2));
 		e16 = _mm512_xor_si512(c1, _mm512_and_si512(_mm512_xor_epi64(c2, _mm512_set1_epi64(-1)), c3));
 		e17 = _mm512_xor_si512(c2, _mm512_and_si512(_mm512_xor_epi64(c3, _mm512_set1_epi64(-1)), c4));
 		e18 = _mm512_xor_si512(c3, _mm512_and_si512(_mm512_xor_epi64(c4, _mm512_set1_epi64(-1)), c0));
 		e19 = _mm512_xor_si512(c4, _mm512_and_si512(_mm512_xor_epi64(c0, _mm512_set1_epi64(-1)), c1));
 		a2 = _mm512_xor_si512(a2, d2);
-		c0 = _mm512_or_si512(_mm512_slli_epi64(a2, 62), _mm512_srli_epi64(a2, 64 - 62));
+		c0 = _mm512_rol_epi64(a2, 62);
 		a8 = _mm512_xor_si512(a8, d3);
-		c1 = _mm512_or_si512(_mm512_slli_epi64(a8, 55), _mm512_srli_epi64(a8, 64 - 55));
+		c1 = _mm512_rol_epi64(a8, 55);
 		a14 = _mm512_xor_si512(a14, d4);
-		c2 = _mm512_or_si512(_mm512_slli_epi64(a14, 39), _mm512_srli_epi64(a14, 64 - 39));
+		c2 = _mm512_rol_epi64(a14, 39);
 		a15 = _mm512_xor_si512(a15, d0);
-		c3 = _mm512_or_si512(_mm512_slli_epi64(a15, 41), _mm512_srli_epi64(a15, 64 - 41));
+		c3 = _mm512_rol_epi64(a15, 41);
 		a21 = _mm512_xor_si512(a21, d1);
-		c4 = _mm512_or_si512(_mm512_slli_epi64(a21, 2), _mm512_srli_epi64(a21, 64 - 2));
+		c4 = _mm512_rol_epi64(a21, 2);
 		e20 = _mm512_xor_si512(c0, _mm512_and_si512(_mm512_xor_epi64(c1, _mm512_set1_epi64(-1)), c2));
 		e21 = _mm512_xor_si512(c1, _mm512_and_si512(_mm512_xor_epi64(c2, _mm512_set1_epi64(-1)), c3));
 		e22 = _mm512_xor_si512(c2, _mm512_and_si512(_mm512_xor_epi64(c3, _mm512_set1_epi64(-1)), c4));
@@ -271,82 +285,82 @@ void qsc_keccak_permute_p8x1600(__m512i state[QSC_KECCAK_STATE_SIZE], size_t rou
 		c2 = _mm512_xor_si512(_mm512_xor_si512(_mm512_xor_si512(e2, e7), _mm512_xor_si512(e12, e17)), e22);
 		c3 = _mm512_xor_si512(_mm512_xor_si512(_mm512_xor_si512(e3, e8), _mm512_xor_si512(e13, e18)), e23);
 		c4 = _mm512_xor_si512(_mm512_xor_si512(_mm512_xor_si512(e4, e9), _mm512_xor_si512(e14, e19)), e24);
-		d0 = _mm512_xor_si512(c4, _mm512_or_si512(_mm512_slli_epi64(c1, 1), _mm512_srli_epi64(c1, 64 - 1)));
-		d1 = _mm512_xor_si512(c0, _mm512_or_si512(_mm512_slli_epi64(c2, 1), _mm512_srli_epi64(c2, 64 - 1)));
-		d2 = _mm512_xor_si512(c1, _mm512_or_si512(_mm512_slli_epi64(c3, 1), _mm512_srli_epi64(c3, 64 - 1)));
-		d3 = _mm512_xor_si512(c2, _mm512_or_si512(_mm512_slli_epi64(c4, 1), _mm512_srli_epi64(c4, 64 - 1)));
-		d4 = _mm512_xor_si512(c3, _mm512_or_si512(_mm512_slli_epi64(c0, 1), _mm512_srli_epi64(c0, 64 - 1)));
+		d0 = _mm512_xor_si512(c4, _mm512_rol_epi64(c1, 1));
+		d1 = _mm512_xor_si512(c0, _mm512_rol_epi64(c2, 1));
+		d2 = _mm512_xor_si512(c1, _mm512_rol_epi64(c3, 1));
+		d3 = _mm512_xor_si512(c2, _mm512_rol_epi64(c4, 1));
+		d4 = _mm512_xor_si512(c3, _mm512_rol_epi64(c0, 1));
 		e0 = _mm512_xor_si512(e0, d0);
 		c0 = e0;
 		e6 = _mm512_xor_si512(e6, d1);
-		c1 = _mm512_or_si512(_mm512_slli_epi64(e6, 44), _mm512_srli_epi64(e6, 64 - 44));
+		c1 = _mm512_rol_epi64(e6, 44);
 		e12 = _mm512_xor_si512(e12, d2);
-		c2 = _mm512_or_si512(_mm512_slli_epi64(e12, 43), _mm512_srli_epi64(e12, 64 - 43));
+		c2 = _mm512_rol_epi64(e12, 43);
 		e18 = _mm512_xor_si512(e18, d3);
-		c3 = _mm512_or_si512(_mm512_slli_epi64(e18, 21), _mm512_srli_epi64(e18, 64 - 21));
+		c3 = _mm512_rol_epi64(e18, 21);
 		e24 = _mm512_xor_si512(e24, d4);
-		c4 = _mm512_or_si512(_mm512_slli_epi64(e24, 14), _mm512_srli_epi64(e24, 64 - 14));
+		c4 = _mm512_rol_epi64(e24, 14);
 		a0 = _mm512_xor_si512(c0, _mm512_and_si512(_mm512_xor_epi64(c1, _mm512_set1_epi64(-1)), c2));
-		a0 = _mm512_xor_si512(a0, _mm512_set1_epi64(KECCAK_ROUND_CONSTANTS[i + 1]));
+		a0 = _mm512_xor_si512(a0, _mm512_set1_epi64(rc[i + 1]));
 		a1 = _mm512_xor_si512(c1, _mm512_and_si512(_mm512_xor_epi64(c2, _mm512_set1_epi64(-1)), c3));
 		a2 = _mm512_xor_si512(c2, _mm512_and_si512(_mm512_xor_epi64(c3, _mm512_set1_epi64(-1)), c4));
 		a3 = _mm512_xor_si512(c3, _mm512_and_si512(_mm512_xor_epi64(c4, _mm512_set1_epi64(-1)), c0));
 		a4 = _mm512_xor_si512(c4, _mm512_and_si512(_mm512_xor_epi64(c0, _mm512_set1_epi64(-1)), c1));
 		e3 = _mm512_xor_si512(e3, d3);
-		c0 = _mm512_or_si512(_mm512_slli_epi64(e3, 28), _mm512_srli_epi64(e3, 64 - 28));
+		c0 = _mm512_rol_epi64(e3, 28);
 		e9 = _mm512_xor_si512(e9, d4);
-		c1 = _mm512_or_si512(_mm512_slli_epi64(e9, 20), _mm512_srli_epi64(e9, 64 - 20));
+		c1 = _mm512_rol_epi64(e9, 20);
 		e10 = _mm512_xor_si512(e10, d0);
-		c2 = _mm512_or_si512(_mm512_slli_epi64(e10, 3), _mm512_srli_epi64(e10, 64 - 3));
+		c2 = _mm512_rol_epi64(e10, 3);
 		e16 = _mm512_xor_si512(e16, d1);
-		c3 = _mm512_or_si512(_mm512_slli_epi64(e16, 45), _mm512_srli_epi64(e16, 64 - 45));
+		c3 = _mm512_rol_epi64(e16, 45);
 		e22 = _mm512_xor_si512(e22, d2);
-		c4 = _mm512_or_si512(_mm512_slli_epi64(e22, 61), _mm512_srli_epi64(e22, 64 - 61));
+		c4 = _mm512_rol_epi64(e22, 61);
 		a5 = _mm512_xor_si512(c0, _mm512_and_si512(_mm512_xor_epi64(c1, _mm512_set1_epi64(-1)), c2));
 		a6 = _mm512_xor_si512(c1, _mm512_and_si512(_mm512_xor_epi64(c2, _mm512_set1_epi64(-1)), c3));
 		a7 = _mm512_xor_si512(c2, _mm512_and_si512(_mm512_xor_epi64(c3, _mm512_set1_epi64(-1)), c4));
 		a8 = _mm512_xor_si512(c3, _mm512_and_si512(_mm512_xor_epi64(c4, _mm512_set1_epi64(-1)), c0));
 		a9 = _mm512_xor_si512(c4, _mm512_and_si512(_mm512_xor_epi64(c0, _mm512_set1_epi64(-1)), c1));
 		e1 = _mm512_xor_si512(e1, d1);
-		c0 = _mm512_or_si512(_mm512_slli_epi64(e1, 1), _mm512_srli_epi64(e1, 64 - 1));
+		c0 = _mm512_rol_epi64(e1, 1);
 		e7 = _mm512_xor_si512(e7, d2);
-		c1 = _mm512_or_si512(_mm512_slli_epi64(e7, 6), _mm512_srli_epi64(e7, 64 - 6));
+		c1 = _mm512_rol_epi64(e7, 6);
 		e13 = _mm512_xor_si512(e13, d3);
-		c2 = _mm512_or_si512(_mm512_slli_epi64(e13, 25), _mm512_srli_epi64(e13, 64 - 25));
+		c2 = _mm512_rol_epi64(e13, 25);
 		e19 = _mm512_xor_si512(e19, d4);
-		c3 = _mm512_or_si512(_mm512_slli_epi64(e19, 8), _mm512_srli_epi64(e19, 64 - 8));
+		c3 = _mm512_rol_epi64(e19, 8);
 		e20 = _mm512_xor_si512(e20, d0);
-		c4 = _mm512_or_si512(_mm512_slli_epi64(e20, 18), _mm512_srli_epi64(e20, 64 - 18));
+		c4 = _mm512_rol_epi64(e20, 18);
 		a10 = _mm512_xor_si512(c0, _mm512_and_si512(_mm512_xor_epi64(c1, _mm512_set1_epi64(-1)), c2));
 		a11 = _mm512_xor_si512(c1, _mm512_and_si512(_mm512_xor_epi64(c2, _mm512_set1_epi64(-1)), c3));
 		a12 = _mm512_xor_si512(c2, _mm512_and_si512(_mm512_xor_epi64(c3, _mm512_set1_epi64(-1)), c4));
 		a13 = _mm512_xor_si512(c3, _mm512_and_si512(_mm512_xor_epi64(c4, _mm512_set1_epi64(-1)), c0));
 		a14 = _mm512_xor_si512(c4, _mm512_and_si512(_mm512_xor_epi64(c0, _mm512_set1_epi64(-1)), c1));
 		e4 = _mm512_xor_si512(e4, d4);
-		c0 = _mm512_or_si512(_mm512_slli_epi64(e4, 27), _mm512_srli_epi64(e4, 64 - 27));
+		c0 = _mm512_rol_epi64(e4, 27);
 		e5 = _mm512_xor_si512(e5, d0);
-		c1 = _mm512_or_si512(_mm512_slli_epi64(e5, 36), _mm512_srli_epi64(e5, 64 - 36));
+		c1 = _mm512_rol_epi64(e5, 36);
 		e11 = _mm512_xor_si512(e11, d1);
-		c2 = _mm512_or_si512(_mm512_slli_epi64(e11, 10), _mm512_srli_epi64(e11, 64 - 10));
+		c2 = _mm512_rol_epi64(e11, 10);
 		e17 = _mm512_xor_si512(e17, d2);
-		c3 = _mm512_or_si512(_mm512_slli_epi64(e17, 15), _mm512_srli_epi64(e17, 64 - 15));
+		c3 = _mm512_rol_epi64(e17, 15);
 		e23 = _mm512_xor_si512(e23, d3);
-		c4 = _mm512_or_si512(_mm512_slli_epi64(e23, 56), _mm512_srli_epi64(e23, 64 - 56));
+		c4 = _mm512_rol_epi64(e23, 56);
 		a15 = _mm512_xor_si512(c0, _mm512_and_si512(_mm512_xor_epi64(c1, _mm512_set1_epi64(-1)), c2));
 		a16 = _mm512_xor_si512(c1, _mm512_and_si512(_mm512_xor_epi64(c2, _mm512_set1_epi64(-1)), c3));
 		a17 = _mm512_xor_si512(c2, _mm512_and_si512(_mm512_xor_epi64(c3, _mm512_set1_epi64(-1)), c4));
 		a18 = _mm512_xor_si512(c3, _mm512_and_si512(_mm512_xor_epi64(c4, _mm512_set1_epi64(-1)), c0));
 		a19 = _mm512_xor_si512(c4, _mm512_and_si512(_mm512_xor_epi64(c0, _mm512_set1_epi64(-1)), c1));
 		e2 = _mm512_xor_si512(e2, d2);
-		c0 = _mm512_or_si512(_mm512_slli_epi64(e2, 62), _mm512_srli_epi64(e2, 64 - 62));
+		c0 = _mm512_rol_epi64(e2, 62);
 		e8 = _mm512_xor_si512(e8, d3);
-		c1 = _mm512_or_si512(_mm512_slli_epi64(e8, 55), _mm512_srli_epi64(e8, 64 - 55));
+		c1 = _mm512_rol_epi64(e8, 55);
 		e14 = _mm512_xor_si512(e14, d4);
-		c2 = _mm512_or_si512(_mm512_slli_epi64(e14, 39), _mm512_srli_epi64(e14, 64 - 39));
+		c2 = _mm512_rol_epi64(e14, 39);
 		e15 = _mm512_xor_si512(e15, d0);
-		c3 = _mm512_or_si512(_mm512_slli_epi64(e15, 41), _mm512_srli_epi64(e15, 64 - 41));
+		c3 = _mm512_rol_epi64(e15, 41);
 		e21 = _mm512_xor_si512(e21, d1);
-		c4 = _mm512_or_si512(_mm512_slli_epi64(e21, 2), _mm512_srli_epi64(e21, 64 - 2));
+		c4 = _mm512_rol_epi64(e21, 2);
 		a20 = _mm512_xor_si512(c0, _mm512_and_si512(_mm512_xor_epi64(c1, _mm512_set1_epi64(-1)), c2));
 		a21 = _mm512_xor_si512(c1, _mm512_and_si512(_mm512_xor_epi64(c2, _mm512_set1_epi64(-1)), c3));
 		a22 = _mm512_xor_si512(c2, _mm512_and_si512(_mm512_xor_epi64(c3, _mm512_set1_epi64(-1)), c4));
@@ -383,7 +397,7 @@ void qsc_keccak_permute_p8x1600(__m512i state[QSC_KECCAK_STATE_SIZE], size_t rou
 
 #	else
 
-void qsc_keccak_permute_p8x1600(__m512i state[QSC_KECCAK_STATE_SIZE], size_t rounds)
+static void keccak_permute_p8x1600(__m512i state[QSC_KECCAK_STATE_SIZE], const uint64_t* rc, size_t rounds)
 {
 	assert(rounds % 2 == 0);
 
@@ -406,82 +420,82 @@ void qsc_keccak_permute_p8x1600(__m512i state[QSC_KECCAK_STATE_SIZE], size_t rou
 		c[2] = _mm512_xor_si512(_mm512_xor_si512(_mm512_xor_si512(a[2], a[7]), _mm512_xor_si512(a[12], a[17])), a[22]);
 		c[3] = _mm512_xor_si512(_mm512_xor_si512(_mm512_xor_si512(a[3], a[8]), _mm512_xor_si512(a[13], a[18])), a[23]);
 		c[4] = _mm512_xor_si512(_mm512_xor_si512(_mm512_xor_si512(a[4], a[9]), _mm512_xor_si512(a[14], a[19])), a[24]);
-		d[0] = _mm512_xor_si512(c[4], _mm512_or_si512(_mm512_slli_epi64(c[1], 1), _mm512_srli_epi64(c[1], 64 - 1)));
-		d[1] = _mm512_xor_si512(c[0], _mm512_or_si512(_mm512_slli_epi64(c[2], 1), _mm512_srli_epi64(c[2], 64 - 1)));
-		d[2] = _mm512_xor_si512(c[1], _mm512_or_si512(_mm512_slli_epi64(c[3], 1), _mm512_srli_epi64(c[3], 64 - 1)));
-		d[3] = _mm512_xor_si512(c[2], _mm512_or_si512(_mm512_slli_epi64(c[4], 1), _mm512_srli_epi64(c[4], 64 - 1)));
-		d[4] = _mm512_xor_si512(c[3], _mm512_or_si512(_mm512_slli_epi64(c[0], 1), _mm512_srli_epi64(c[0], 64 - 1)));
+		d[0] = _mm512_xor_si512(c[4], _mm512_rol_epi64(c[1], 1));
+		d[1] = _mm512_xor_si512(c[0], _mm512_rol_epi64(c[2], 1));
+		d[2] = _mm512_xor_si512(c[1], _mm512_rol_epi64(c[3], 1));
+		d[3] = _mm512_xor_si512(c[2], _mm512_rol_epi64(c[4], 1));
+		d[4] = _mm512_xor_si512(c[3], _mm512_rol_epi64(c[0], 1));
 		a[0] = _mm512_xor_si512(a[0], d[0]);
 		c[0] = a[0];
 		a[6] = _mm512_xor_si512(a[6], d[1]);
-		c[1] = _mm512_or_si512(_mm512_slli_epi64(a[6], 44), _mm512_srli_epi64(a[6], 64 - 44));
+		c[1] = _mm512_rol_epi64(a[6], 44);
 		a[12] = _mm512_xor_si512(a[12], d[2]);
-		c[2] = _mm512_or_si512(_mm512_slli_epi64(a[12], 43), _mm512_srli_epi64(a[12], 64 - 43));
+		c[2] = _mm512_rol_epi64(a[12], 43);
 		a[18] = _mm512_xor_si512(a[18], d[3]);
-		c[3] = _mm512_or_si512(_mm512_slli_epi64(a[18], 21), _mm512_srli_epi64(a[18], 64 - 21));
+		c[3] = _mm512_rol_epi64(a[18], 21);
 		a[24] = _mm512_xor_si512(a[24], d[4]);
-		c[4] = _mm512_or_si512(_mm512_slli_epi64(a[24], 14), _mm512_srli_epi64(a[24], 64 - 14));
+		c[4] = _mm512_rol_epi64(a[24], 14);
 		e[0] = _mm512_xor_si512(c[0], _mm512_and_si512(_mm512_xor_epi64(c[1], _mm512_set1_epi64(-1)), c[2]));
-		e[0] = _mm512_xor_si512(e[0], _mm512_set1_epi64(KECCAK_ROUND_CONSTANTS[i]));
+		e[0] = _mm512_xor_si512(e[0], _mm512_set1_epi64(rc[i]));
 		e[1] = _mm512_xor_si512(c[1], _mm512_and_si512(_mm512_xor_epi64(c[2], _mm512_set1_epi64(-1)), c[3]));
 		e[2] = _mm512_xor_si512(c[2], _mm512_and_si512(_mm512_xor_epi64(c[3], _mm512_set1_epi64(-1)), c[4]));
 		e[3] = _mm512_xor_si512(c[3], _mm512_and_si512(_mm512_xor_epi64(c[4], _mm512_set1_epi64(-1)), c[0]));
 		e[4] = _mm512_xor_si512(c[4], _mm512_and_si512(_mm512_xor_epi64(c[0], _mm512_set1_epi64(-1)), c[1]));
 		a[3] = _mm512_xor_si512(a[3], d[3]);
-		c[0] = _mm512_or_si512(_mm512_slli_epi64(a[3], 28), _mm512_srli_epi64(a[3], 64 - 28));
+		c[0] = _mm512_rol_epi64(a[3], 28);
 		a[9] = _mm512_xor_si512(a[9], d[4]);
-		c[1] = _mm512_or_si512(_mm512_slli_epi64(a[9], 20), _mm512_srli_epi64(a[9], 64 - 20));
+		c[1] = _mm512_rol_epi64(a[9], 20);
 		a[10] = _mm512_xor_si512(a[10], d[0]);
-		c[2] = _mm512_or_si512(_mm512_slli_epi64(a[10], 3), _mm512_srli_epi64(a[10], 64 - 3));
+		c[2] = _mm512_rol_epi64(a[10], 3);
 		a[16] = _mm512_xor_si512(a[16], d[1]);
-		c[3] = _mm512_or_si512(_mm512_slli_epi64(a[16], 45), _mm512_srli_epi64(a[16], 64 - 45));
+		c[3] = _mm512_rol_epi64(a[16], 45);
 		a[22] = _mm512_xor_si512(a[22], d[2]);
-		c[4] = _mm512_or_si512(_mm512_slli_epi64(a[22], 61), _mm512_srli_epi64(a[22], 64 - 61));
+		c[4] = _mm512_rol_epi64(a[22], 61);
 		e[5] = _mm512_xor_si512(c[0], _mm512_and_si512(_mm512_xor_epi64(c[1], _mm512_set1_epi64(-1)), c[2]));
 		e[6] = _mm512_xor_si512(c[1], _mm512_and_si512(_mm512_xor_epi64(c[2], _mm512_set1_epi64(-1)), c[3]));
 		e[7] = _mm512_xor_si512(c[2], _mm512_and_si512(_mm512_xor_epi64(c[3], _mm512_set1_epi64(-1)), c[4]));
 		e[8] = _mm512_xor_si512(c[3], _mm512_and_si512(_mm512_xor_epi64(c[4], _mm512_set1_epi64(-1)), c[0]));
 		e[9] = _mm512_xor_si512(c[4], _mm512_and_si512(_mm512_xor_epi64(c[0], _mm512_set1_epi64(-1)), c[1]));
 		a[1] = _mm512_xor_si512(a[1], d[1]);
-		c[0] = _mm512_or_si512(_mm512_slli_epi64(a[1], 1), _mm512_srli_epi64(a[1], 64 - 1));
+		c[0] = _mm512_rol_epi64(a[1], 1);
 		a[7] = _mm512_xor_si512(a[7], d[2]);
-		c[1] = _mm512_or_si512(_mm512_slli_epi64(a[7], 6), _mm512_srli_epi64(a[7], 64 - 6));
+		c[1] = _mm512_rol_epi64(a[7], 6);
 		a[13] = _mm512_xor_si512(a[13], d[3]);
-		c[2] = _mm512_or_si512(_mm512_slli_epi64(a[13], 25), _mm512_srli_epi64(a[13], 64 - 25));
+		c[2] = _mm512_rol_epi64(a[13], 25);
 		a[19] = _mm512_xor_si512(a[19], d[4]);
-		c[3] = _mm512_or_si512(_mm512_slli_epi64(a[19], 8), _mm512_srli_epi64(a[19], 64 - 8));
+		c[3] = _mm512_rol_epi64(a[19], 8);
 		a[20] = _mm512_xor_si512(a[20], d[0]);
-		c[4] = _mm512_or_si512(_mm512_slli_epi64(a[20], 18), _mm512_srli_epi64(a[20], 64 - 18));
+		c[4] = _mm512_rol_epi64(a[20], 18);
 		e[10] = _mm512_xor_si512(c[0], _mm512_and_si512(_mm512_xor_epi64(c[1], _mm512_set1_epi64(-1)), c[2]));
 		e[11] = _mm512_xor_si512(c[1], _mm512_and_si512(_mm512_xor_epi64(c[2], _mm512_set1_epi64(-1)), c[3]));
 		e[12] = _mm512_xor_si512(c[2], _mm512_and_si512(_mm512_xor_epi64(c[3], _mm512_set1_epi64(-1)), c[4]));
 		e[13] = _mm512_xor_si512(c[3], _mm512_and_si512(_mm512_xor_epi64(c[4], _mm512_set1_epi64(-1)), c[0]));
 		e[14] = _mm512_xor_si512(c[4], _mm512_and_si512(_mm512_xor_epi64(c[0], _mm512_set1_epi64(-1)), c[1]));
 		a[4] = _mm512_xor_si512(a[4], d[4]);
-		c[0] = _mm512_or_si512(_mm512_slli_epi64(a[4], 27), _mm512_srli_epi64(a[4], 64 - 27));
+		c[0] = _mm512_rol_epi64(a[4], 27);
 		a[5] = _mm512_xor_si512(a[5], d[0]);
-		c[1] = _mm512_or_si512(_mm512_slli_epi64(a[5], 36), _mm512_srli_epi64(a[5], 64 - 36));
+		c[1] = _mm512_rol_epi64(a[5], 36);
 		a[11] = _mm512_xor_si512(a[11], d[1]);
-		c[2] = _mm512_or_si512(_mm512_slli_epi64(a[11], 10), _mm512_srli_epi64(a[11], 64 - 10));
+		c[2] = _mm512_rol_epi64(a[11], 10);
 		a[17] = _mm512_xor_si512(a[17], d[2]);
-		c[3] = _mm512_or_si512(_mm512_slli_epi64(a[17], 15), _mm512_srli_epi64(a[17], 64 - 15));
+		c[3] = _mm512_rol_epi64(a[17], 15);
 		a[23] = _mm512_xor_si512(a[23], d[3]);
-		c[4] = _mm512_or_si512(_mm512_slli_epi64(a[23], 56), _mm512_srli_epi64(a[23], 64 - 56));
+		c[4] = _mm512_rol_epi64(a[23], 56);
 		e[15] = _mm512_xor_si512(c[0], _mm512_and_si512(_mm512_xor_epi64(c[1], _mm512_set1_epi64(-1)), c[2]));
 		e[16] = _mm512_xor_si512(c[1], _mm512_and_si512(_mm512_xor_epi64(c[2], _mm512_set1_epi64(-1)), c[3]));
 		e[17] = _mm512_xor_si512(c[2], _mm512_and_si512(_mm512_xor_epi64(c[3], _mm512_set1_epi64(-1)), c[4]));
 		e[18] = _mm512_xor_si512(c[3], _mm512_and_si512(_mm512_xor_epi64(c[4], _mm512_set1_epi64(-1)), c[0]));
 		e[19] = _mm512_xor_si512(c[4], _mm512_and_si512(_mm512_xor_epi64(c[0], _mm512_set1_epi64(-1)), c[1]));
 		a[2] = _mm512_xor_si512(a[2], d[2]);
-		c[0] = _mm512_or_si512(_mm512_slli_epi64(a[2], 62), _mm512_srli_epi64(a[2], 64 - 62));
+		c[0] = _mm512_rol_epi64(a[2], 62);
 		a[8] = _mm512_xor_si512(a[8], d[3]);
-		c[1] = _mm512_or_si512(_mm512_slli_epi64(a[8], 55), _mm512_srli_epi64(a[8], 64 - 55));
+		c[1] = _mm512_rol_epi64(a[8], 55);
 		a[14] = _mm512_xor_si512(a[14], d[4]);
-		c[2] = _mm512_or_si512(_mm512_slli_epi64(a[14], 39), _mm512_srli_epi64(a[14], 64 - 39));
+		c[2] = _mm512_rol_epi64(a[14], 39);
 		a[15] = _mm512_xor_si512(a[15], d[0]);
-		c[3] = _mm512_or_si512(_mm512_slli_epi64(a[15], 41), _mm512_srli_epi64(a[15], 64 - 41));
+		c[3] = _mm512_rol_epi64(a[15], 41);
 		a[21] = _mm512_xor_si512(a[21], d[1]);
-		c[4] = _mm512_or_si512(_mm512_slli_epi64(a[21], 2), _mm512_srli_epi64(a[21], 64 - 2));
+		c[4] = _mm512_rol_epi64(a[21], 2);
 		e[20] = _mm512_xor_si512(c[0], _mm512_and_si512(_mm512_xor_epi64(c[1], _mm512_set1_epi64(-1)), c[2]));
 		e[21] = _mm512_xor_si512(c[1], _mm512_and_si512(_mm512_xor_epi64(c[2], _mm512_set1_epi64(-1)), c[3]));
 		e[22] = _mm512_xor_si512(c[2], _mm512_and_si512(_mm512_xor_epi64(c[3], _mm512_set1_epi64(-1)), c[4]));
@@ -494,82 +508,82 @@ void qsc_keccak_permute_p8x1600(__m512i state[QSC_KECCAK_STATE_SIZE], size_t rou
 		c[2] = _mm512_xor_si512(_mm512_xor_si512(_mm512_xor_si512(e[2], e[7]), _mm512_xor_si512(e[12], e[17])), e[22]);
 		c[3] = _mm512_xor_si512(_mm512_xor_si512(_mm512_xor_si512(e[3], e[8]), _mm512_xor_si512(e[13], e[18])), e[23]);
 		c[4] = _mm512_xor_si512(_mm512_xor_si512(_mm512_xor_si512(e[4], e[9]), _mm512_xor_si512(e[14], e[19])), e[24]);
-		d[0] = _mm512_xor_si512(c[4], _mm512_or_si512(_mm512_slli_epi64(c[1], 1), _mm512_srli_epi64(c[1], 64 - 1)));
-		d[1] = _mm512_xor_si512(c[0], _mm512_or_si512(_mm512_slli_epi64(c[2], 1), _mm512_srli_epi64(c[2], 64 - 1)));
-		d[2] = _mm512_xor_si512(c[1], _mm512_or_si512(_mm512_slli_epi64(c[3], 1), _mm512_srli_epi64(c[3], 64 - 1)));
-		d[3] = _mm512_xor_si512(c[2], _mm512_or_si512(_mm512_slli_epi64(c[4], 1), _mm512_srli_epi64(c[4], 64 - 1)));
-		d[4] = _mm512_xor_si512(c[3], _mm512_or_si512(_mm512_slli_epi64(c[0], 1), _mm512_srli_epi64(c[0], 64 - 1)));
+		d[0] = _mm512_xor_si512(c[4], _mm512_rol_epi64(c[1], 1));
+		d[1] = _mm512_xor_si512(c[0], _mm512_rol_epi64(c[2], 1));
+		d[2] = _mm512_xor_si512(c[1], _mm512_rol_epi64(c[3], 1));
+		d[3] = _mm512_xor_si512(c[2], _mm512_rol_epi64(c[4], 1));
+		d[4] = _mm512_xor_si512(c[3], _mm512_rol_epi64(c[0], 1));
 		e[0] = _mm512_xor_si512(e[0], d[0]);
 		c[0] = e[0];
 		e[6] = _mm512_xor_si512(e[6], d[1]);
-		c[1] = _mm512_or_si512(_mm512_slli_epi64(e[6], 44), _mm512_srli_epi64(e[6], 64 - 44));
+		c[1] = _mm512_rol_epi64(e[6], 44);
 		e[12] = _mm512_xor_si512(e[12], d[2]);
-		c[2] = _mm512_or_si512(_mm512_slli_epi64(e[12], 43), _mm512_srli_epi64(e[12], 64 - 43));
+		c[2] = _mm512_rol_epi64(e[12], 43);
 		e[18] = _mm512_xor_si512(e[18], d[3]);
-		c[3] = _mm512_or_si512(_mm512_slli_epi64(e[18], 21), _mm512_srli_epi64(e[18], 64 - 21));
+		c[3] = _mm512_rol_epi64(e[18], 21);
 		e[24] = _mm512_xor_si512(e[24], d[4]);
-		c[4] = _mm512_or_si512(_mm512_slli_epi64(e[24], 14), _mm512_srli_epi64(e[24], 64 - 14));
+		c[4] = _mm512_rol_epi64(e[24], 14);
 		a[0] = _mm512_xor_si512(c[0], _mm512_and_si512(_mm512_xor_epi64(c[1], _mm512_set1_epi64(-1)), c[2]));
-		a[0] = _mm512_xor_si512(a[0], _mm512_set1_epi64(KECCAK_ROUND_CONSTANTS[i + 1]));
+		a[0] = _mm512_xor_si512(a[0], _mm512_set1_epi64(rc[i + 1]));
 		a[1] = _mm512_xor_si512(c[1], _mm512_and_si512(_mm512_xor_epi64(c[2], _mm512_set1_epi64(-1)), c[3]));
 		a[2] = _mm512_xor_si512(c[2], _mm512_and_si512(_mm512_xor_epi64(c[3], _mm512_set1_epi64(-1)), c[4]));
 		a[3] = _mm512_xor_si512(c[3], _mm512_and_si512(_mm512_xor_epi64(c[4], _mm512_set1_epi64(-1)), c[0]));
 		a[4] = _mm512_xor_si512(c[4], _mm512_and_si512(_mm512_xor_epi64(c[0], _mm512_set1_epi64(-1)), c[1]));
 		e[3] = _mm512_xor_si512(e[3], d[3]);
-		c[0] = _mm512_or_si512(_mm512_slli_epi64(e[3], 28), _mm512_srli_epi64(e[3], 64 - 28));
+		c[0] = _mm512_rol_epi64(e[3], 28);
 		e[9] = _mm512_xor_si512(e[9], d[4]);
-		c[1] = _mm512_or_si512(_mm512_slli_epi64(e[9], 20), _mm512_srli_epi64(e[9], 64 - 20));
+		c[1] = _mm512_rol_epi64(e[9], 20);
 		e[10] = _mm512_xor_si512(e[10], d[0]);
-		c[2] = _mm512_or_si512(_mm512_slli_epi64(e[10], 3), _mm512_srli_epi64(e[10], 64 - 3));
+		c[2] = _mm512_rol_epi64(e[10], 3);
 		e[16] = _mm512_xor_si512(e[16], d[1]);
-		c[3] = _mm512_or_si512(_mm512_slli_epi64(e[16], 45), _mm512_srli_epi64(e[16], 64 - 45));
+		c[3] = _mm512_rol_epi64(e[16], 45);
 		e[22] = _mm512_xor_si512(e[22], d[2]);
-		c[4] = _mm512_or_si512(_mm512_slli_epi64(e[22], 61), _mm512_srli_epi64(e[22], 64 - 61));
+		c[4] = _mm512_rol_epi64(e[22], 61);
 		a[5] = _mm512_xor_si512(c[0], _mm512_and_si512(_mm512_xor_epi64(c[1], _mm512_set1_epi64(-1)), c[2]));
 		a[6] = _mm512_xor_si512(c[1], _mm512_and_si512(_mm512_xor_epi64(c[2], _mm512_set1_epi64(-1)), c[3]));
 		a[7] = _mm512_xor_si512(c[2], _mm512_and_si512(_mm512_xor_epi64(c[3], _mm512_set1_epi64(-1)), c[4]));
 		a[8] = _mm512_xor_si512(c[3], _mm512_and_si512(_mm512_xor_epi64(c[4], _mm512_set1_epi64(-1)), c[0]));
 		a[9] = _mm512_xor_si512(c[4], _mm512_and_si512(_mm512_xor_epi64(c[0], _mm512_set1_epi64(-1)), c[1]));
 		e[1] = _mm512_xor_si512(e[1], d[1]);
-		c[0] = _mm512_or_si512(_mm512_slli_epi64(e[1], 1), _mm512_srli_epi64(e[1], 64 - 1));
+		c[0] = _mm512_rol_epi64(e[1], 1);
 		e[7] = _mm512_xor_si512(e[7], d[2]);
-		c[1] = _mm512_or_si512(_mm512_slli_epi64(e[7], 6), _mm512_srli_epi64(e[7], 64 - 6));
+		c[1] = _mm512_rol_epi64(e[7], 6);
 		e[13] = _mm512_xor_si512(e[13], d[3]);
-		c[2] = _mm512_or_si512(_mm512_slli_epi64(e[13], 25), _mm512_srli_epi64(e[13], 64 - 25));
+		c[2] = _mm512_rol_epi64(e[13], 25);
 		e[19] = _mm512_xor_si512(e[19], d[4]);
-		c[3] = _mm512_or_si512(_mm512_slli_epi64(e[19], 8), _mm512_srli_epi64(e[19], 64 - 8));
+		c[3] = _mm512_rol_epi64(e[19], 8);
 		e[20] = _mm512_xor_si512(e[20], d[0]);
-		c[4] = _mm512_or_si512(_mm512_slli_epi64(e[20], 18), _mm512_srli_epi64(e[20], 64 - 18));
+		c[4] = _mm512_rol_epi64(e[20], 18);
 		a[10] = _mm512_xor_si512(c[0], _mm512_and_si512(_mm512_xor_epi64(c[1], _mm512_set1_epi64(-1)), c[2]));
 		a[11] = _mm512_xor_si512(c[1], _mm512_and_si512(_mm512_xor_epi64(c[2], _mm512_set1_epi64(-1)), c[3]));
 		a[12] = _mm512_xor_si512(c[2], _mm512_and_si512(_mm512_xor_epi64(c[3], _mm512_set1_epi64(-1)), c[4]));
 		a[13] = _mm512_xor_si512(c[3], _mm512_and_si512(_mm512_xor_epi64(c[4], _mm512_set1_epi64(-1)), c[0]));
 		a[14] = _mm512_xor_si512(c[4], _mm512_and_si512(_mm512_xor_epi64(c[0], _mm512_set1_epi64(-1)), c[1]));
 		e[4] = _mm512_xor_si512(e[4], d[4]);
-		c[0] = _mm512_or_si512(_mm512_slli_epi64(e[4], 27), _mm512_srli_epi64(e[4], 64 - 27));
+		c[0] = _mm512_rol_epi64(e[4], 27);
 		e[5] = _mm512_xor_si512(e[5], d[0]);
-		c[1] = _mm512_or_si512(_mm512_slli_epi64(e[5], 36), _mm512_srli_epi64(e[5], 64 - 36));
+		c[1] = _mm512_rol_epi64(e[5], 36);
 		e[11] = _mm512_xor_si512(e[11], d[1]);
-		c[2] = _mm512_or_si512(_mm512_slli_epi64(e[11], 10), _mm512_srli_epi64(e[11], 64 - 10));
+		c[2] = _mm512_rol_epi64(e[11], 10);
 		e[17] = _mm512_xor_si512(e[17], d[2]);
-		c[3] = _mm512_or_si512(_mm512_slli_epi64(e[17], 15), _mm512_srli_epi64(e[17], 64 - 15));
+		c[3] = _mm512_rol_epi64(e[17], 15);
 		e[23] = _mm512_xor_si512(e[23], d[3]);
-		c[4] = _mm512_or_si512(_mm512_slli_epi64(e[23], 56), _mm512_srli_epi64(e[23], 64 - 56));
+		c[4] = _mm512_rol_epi64(e[23], 56);
 		a[15] = _mm512_xor_si512(c[0], _mm512_and_si512(_mm512_xor_epi64(c[1], _mm512_set1_epi64(-1)), c[2]));
 		a[16] = _mm512_xor_si512(c[1], _mm512_and_si512(_mm512_xor_epi64(c[2], _mm512_set1_epi64(-1)), c[3]));
 		a[17] = _mm512_xor_si512(c[2], _mm512_and_si512(_mm512_xor_epi64(c[3], _mm512_set1_epi64(-1)), c[4]));
 		a[18] = _mm512_xor_si512(c[3], _mm512_and_si512(_mm512_xor_epi64(c[4], _mm512_set1_epi64(-1)), c[0]));
 		a[19] = _mm512_xor_si512(c[4], _mm512_and_si512(_mm512_xor_epi64(c[0], _mm512_set1_epi64(-1)), c[1]));
 		e[2] = _mm512_xor_si512(e[2], d[2]);
-		c[0] = _mm512_or_si512(_mm512_slli_epi64(e[2], 62), _mm512_srli_epi64(e[2], 64 - 62));
+		c[0] = _mm512_rol_epi64(e[2], 62);
 		e[8] = _mm512_xor_si512(e[8], d[3]);
-		c[1] = _mm512_or_si512(_mm512_slli_epi64(e[8], 55), _mm512_srli_epi64(e[8], 64 - 55));
+		c[1] = _mm512_rol_epi64(e[8], 55);
 		e[14] = _mm512_xor_si512(e[14], d[4]);
-		c[2] = _mm512_or_si512(_mm512_slli_epi64(e[14], 39), _mm512_srli_epi64(e[14], 64 - 39));
+		c[2] = _mm512_rol_epi64(e[14], 39);
 		e[15] = _mm512_xor_si512(e[15], d[0]);
-		c[3] = _mm512_or_si512(_mm512_slli_epi64(e[15], 41), _mm512_srli_epi64(e[15], 64 - 41));
+		c[3] = _mm512_rol_epi64(e[15], 41);
 		e[21] = _mm512_xor_si512(e[21], d[1]);
-		c[4] = _mm512_or_si512(_mm512_slli_epi64(e[21], 2), _mm512_srli_epi64(e[21], 64 - 2));
+		c[4] = _mm512_rol_epi64(e[21], 2);
 		a[20] = _mm512_xor_si512(c[0], _mm512_and_si512(_mm512_xor_epi64(c[1], _mm512_set1_epi64(-1)), c[2]));
 		a[21] = _mm512_xor_si512(c[1], _mm512_and_si512(_mm512_xor_epi64(c[2], _mm512_set1_epi64(-1)), c[3]));
 		a[22] = _mm512_xor_si512(c[2], _mm512_and_si512(_mm512_xor_epi64(c[3], _mm512_set1_epi64(-1)), c[4]));
@@ -584,12 +598,18 @@ void qsc_keccak_permute_p8x1600(__m512i state[QSC_KECCAK_STATE_SIZE], size_t rou
 }
 
 #	endif
+
+void qsc_keccak_permute_p8x1600(__m512i state[QSC_KECCAK_STATE_SIZE], size_t rounds)
+{
+	keccak_permute_p8x1600(state, KECCAK_ROUND_CONSTANTS, rounds);
+}
+
 #endif
 
 #if defined(QSC_SYSTEM_HAS_AVX2)
 #	if defined(QSC_KECCAK_UNROLLED_PERMUTATION)
 
-void qsc_keccak_permute_p4x1600(__m256i state[QSC_KECCAK_STATE_SIZE], size_t rounds)
+static void keccak_permute_p4x1600(__m256i state[QSC_KECCAK_STATE_SIZE], const uint64_t* rc, size_t rounds)
 {
 	assert(rounds % 2 == 0);
 
@@ -707,7 +727,7 @@ void qsc_keccak_permute_p4x1600(__m256i state[QSC_KECCAK_STATE_SIZE], size_t rou
 		a24 = _mm256_xor_si256(a24, d4);
 		c4 = _mm256_or_si256(_mm256_slli_epi64(a24, 14), _mm256_srli_epi64(a24, 64 - 14));
 		e0 = _mm256_xor_si256(c0, _mm256_and_si256(_mm256_xor_si256(c1, _mm256_set1_epi64x(-1)), c2));
-		e0 = _mm256_xor_si256(e0, _mm256_set1_epi64x(KECCAK_ROUND_CONSTANTS[i]));
+		e0 = _mm256_xor_si256(e0, _mm256_set1_epi64x(rc[i]));
 		e1 = _mm256_xor_si256(c1, _mm256_and_si256(_mm256_xor_si256(c2, _mm256_set1_epi64x(-1)), c3));
 		e2 = _mm256_xor_si256(c2, _mm256_and_si256(_mm256_xor_si256(c3, _mm256_set1_epi64x(-1)), c4));
 		e3 = _mm256_xor_si256(c3, _mm256_and_si256(_mm256_xor_si256(c4, _mm256_set1_epi64x(-1)), c0));
@@ -794,7 +814,7 @@ void qsc_keccak_permute_p4x1600(__m256i state[QSC_KECCAK_STATE_SIZE], size_t rou
 		e24 = _mm256_xor_si256(e24, d4);
 		c4 = _mm256_or_si256(_mm256_slli_epi64(e24, 14), _mm256_srli_epi64(e24, 64 - 14));
 		a0 = _mm256_xor_si256(c0, _mm256_and_si256(_mm256_xor_si256(c1, _mm256_set1_epi64x(-1)), c2));
-		a0 = _mm256_xor_si256(a0, _mm256_set1_epi64x(KECCAK_ROUND_CONSTANTS[i + 1]));
+		a0 = _mm256_xor_si256(a0, _mm256_set1_epi64x(rc[i + 1]));
 		a1 = _mm256_xor_si256(c1, _mm256_and_si256(_mm256_xor_si256(c2, _mm256_set1_epi64x(-1)), c3));
 		a2 = _mm256_xor_si256(c2, _mm256_and_si256(_mm256_xor_si256(c3, _mm256_set1_epi64x(-1)), c4));
 		a3 = _mm256_xor_si256(c3, _mm256_and_si256(_mm256_xor_si256(c4, _mm256_set1_epi64x(-1)), c0));
@@ -890,7 +910,7 @@ void qsc_keccak_permute_p4x1600(__m256i state[QSC_KECCAK_STATE_SIZE], size_t rou
 
 #	else
 
-void qsc_keccak_permute_p4x1600(__m256i state[QSC_KECCAK_STATE_SIZE], size_t rounds)
+static void keccak_permute_p4x1600(__m256i state[QSC_KECCAK_STATE_SIZE], const uint64_t* rc, size_t rounds)
 {
 	assert(rounds % 2 == 0);
 
@@ -929,7 +949,7 @@ void qsc_keccak_permute_p4x1600(__m256i state[QSC_KECCAK_STATE_SIZE], size_t rou
 		a[24] = _mm256_xor_si256(a[24], d[4]);
 		c[4] = _mm256_or_si256(_mm256_slli_epi64(a[24], 14), _mm256_srli_epi64(a[24], 64 - 14));
 		e[0] = _mm256_xor_si256(c[0], _mm256_and_si256(_mm256_xor_si256(c[1], _mm256_set1_epi64x(-1)), c[2]));
-		e[0] = _mm256_xor_si256(e[0], _mm256_set1_epi64x(KECCAK_ROUND_CONSTANTS[i]));
+		e[0] = _mm256_xor_si256(e[0], _mm256_set1_epi64x(rc[i]));
 		e[1] = _mm256_xor_si256(c[1], _mm256_and_si256(_mm256_xor_si256(c[2], _mm256_set1_epi64x(-1)), c[3]));
 		e[2] = _mm256_xor_si256(c[2], _mm256_and_si256(_mm256_xor_si256(c[3], _mm256_set1_epi64x(-1)), c[4]));
 		e[3] = _mm256_xor_si256(c[3], _mm256_and_si256(_mm256_xor_si256(c[4], _mm256_set1_epi64x(-1)), c[0]));
@@ -1017,7 +1037,7 @@ void qsc_keccak_permute_p4x1600(__m256i state[QSC_KECCAK_STATE_SIZE], size_t rou
 		e[24] = _mm256_xor_si256(e[24], d[4]);
 		c[4] = _mm256_or_si256(_mm256_slli_epi64(e[24], 14), _mm256_srli_epi64(e[24], 64 - 14));
 		a[0] = _mm256_xor_si256(c[0], _mm256_and_si256(_mm256_xor_si256(c[1], _mm256_set1_epi64x(-1)), c[2]));
-		a[0] = _mm256_xor_si256(a[0], _mm256_set1_epi64x(KECCAK_ROUND_CONSTANTS[i + 1]));
+		a[0] = _mm256_xor_si256(a[0], _mm256_set1_epi64x(rc[i + 1]));
 		a[1] = _mm256_xor_si256(c[1], _mm256_and_si256(_mm256_xor_si256(c[2], _mm256_set1_epi64x(-1)), c[3]));
 		a[2] = _mm256_xor_si256(c[2], _mm256_and_si256(_mm256_xor_si256(c[3], _mm256_set1_epi64x(-1)), c[4]));
 		a[3] = _mm256_xor_si256(c[3], _mm256_and_si256(_mm256_xor_si256(c[4], _mm256_set1_epi64x(-1)), c[0]));
@@ -1091,6 +1111,12 @@ void qsc_keccak_permute_p4x1600(__m256i state[QSC_KECCAK_STATE_SIZE], size_t rou
 }
 
 #	endif
+
+void qsc_keccak_permute_p4x1600(__m256i state[QSC_KECCAK_STATE_SIZE], size_t rounds)
+{
+	keccak_permute_p4x1600(state, KECCAK_ROUND_CONSTANTS, rounds);
+}
+
 #endif
 
 /* Keccak */
@@ -1488,14 +1514,284 @@ void qsc_keccak_permute(qsc_keccak_state* ctx, size_t rounds)
 	if (ctx != NULL)
 	{
 #if defined(QSC_KECCAK_UNROLLED_PERMUTATION)
-		qsc_keccak_permute_p1600u(ctx->state)
+		qsc_keccak_permute_p1600u(ctx->state);
 #else
 		qsc_keccak_permute_p1600c(ctx->state, rounds);
 #endif
 	}
 }
 
-void qsc_keccak_permute_p1600c(uint64_t* state, size_t rounds)
+#if defined(KECCAK_AVX512VL_PERMUTATION)
+
+/* one lane per 128-bit register; chi is a single vpternlogq, and the vector register file holds the state */
+static void keccak_permute_p1600c(uint64_t* state, const uint64_t* rc, size_t rounds)
+{
+	assert(state != NULL);
+	assert(rounds % 2 == 0);
+
+	__m128i Aba;
+	__m128i Abe;
+	__m128i Abi;
+	__m128i Abo;
+	__m128i Abu;
+	__m128i Aga;
+	__m128i Age;
+	__m128i Agi;
+	__m128i Ago;
+	__m128i Agu;
+	__m128i Aka;
+	__m128i Ake;
+	__m128i Aki;
+	__m128i Ako;
+	__m128i Aku;
+	__m128i Ama;
+	__m128i Ame;
+	__m128i Ami;
+	__m128i Amo;
+	__m128i Amu;
+	__m128i Asa;
+	__m128i Ase;
+	__m128i Asi;
+	__m128i Aso;
+	__m128i Asu;
+	__m128i BCa;
+	__m128i BCe;
+	__m128i BCi;
+	__m128i BCo;
+	__m128i BCu;
+	__m128i Da;
+	__m128i De;
+	__m128i Di;
+	__m128i Do;
+	__m128i Du;
+	__m128i Eba;
+	__m128i Ebe;
+	__m128i Ebi;
+	__m128i Ebo;
+	__m128i Ebu;
+	__m128i Ega;
+	__m128i Ege;
+	__m128i Egi;
+	__m128i Ego;
+	__m128i Egu;
+	__m128i Eka;
+	__m128i Eke;
+	__m128i Eki;
+	__m128i Eko;
+	__m128i Eku;
+	__m128i Ema;
+	__m128i Eme;
+	__m128i Emi;
+	__m128i Emo;
+	__m128i Emu;
+	__m128i Esa;
+	__m128i Ese;
+	__m128i Esi;
+	__m128i Eso;
+	__m128i Esu;
+
+	/* copyFromState(A, state) */
+	Aba = _mm_loadl_epi64((const __m128i*)&state[0]);
+	Abe = _mm_loadl_epi64((const __m128i*)&state[1]);
+	Abi = _mm_loadl_epi64((const __m128i*)&state[2]);
+	Abo = _mm_loadl_epi64((const __m128i*)&state[3]);
+	Abu = _mm_loadl_epi64((const __m128i*)&state[4]);
+	Aga = _mm_loadl_epi64((const __m128i*)&state[5]);
+	Age = _mm_loadl_epi64((const __m128i*)&state[6]);
+	Agi = _mm_loadl_epi64((const __m128i*)&state[7]);
+	Ago = _mm_loadl_epi64((const __m128i*)&state[8]);
+	Agu = _mm_loadl_epi64((const __m128i*)&state[9]);
+	Aka = _mm_loadl_epi64((const __m128i*)&state[10]);
+	Ake = _mm_loadl_epi64((const __m128i*)&state[11]);
+	Aki = _mm_loadl_epi64((const __m128i*)&state[12]);
+	Ako = _mm_loadl_epi64((const __m128i*)&state[13]);
+	Aku = _mm_loadl_epi64((const __m128i*)&state[14]);
+	Ama = _mm_loadl_epi64((const __m128i*)&state[15]);
+	Ame = _mm_loadl_epi64((const __m128i*)&state[16]);
+	Ami = _mm_loadl_epi64((const __m128i*)&state[17]);
+	Amo = _mm_loadl_epi64((const __m128i*)&state[18]);
+	Amu = _mm_loadl_epi64((const __m128i*)&state[19]);
+	Asa = _mm_loadl_epi64((const __m128i*)&state[20]);
+	Ase = _mm_loadl_epi64((const __m128i*)&state[21]);
+	Asi = _mm_loadl_epi64((const __m128i*)&state[22]);
+	Aso = _mm_loadl_epi64((const __m128i*)&state[23]);
+	Asu = _mm_loadl_epi64((const __m128i*)&state[24]);
+
+	for (size_t i = 0; i < rounds; i += 2)
+	{
+		/* prepareTheta */
+		BCa = _mm_ternarylogic_epi64(_mm_ternarylogic_epi64(Aba, Aga, Aka, 0x96), Ama, Asa, 0x96);
+		BCe = _mm_ternarylogic_epi64(_mm_ternarylogic_epi64(Abe, Age, Ake, 0x96), Ame, Ase, 0x96);
+		BCi = _mm_ternarylogic_epi64(_mm_ternarylogic_epi64(Abi, Agi, Aki, 0x96), Ami, Asi, 0x96);
+		BCo = _mm_ternarylogic_epi64(_mm_ternarylogic_epi64(Abo, Ago, Ako, 0x96), Amo, Aso, 0x96);
+		BCu = _mm_ternarylogic_epi64(_mm_ternarylogic_epi64(Abu, Agu, Aku, 0x96), Amu, Asu, 0x96);
+
+		/* thetaRhoPiChiIota */
+		Da = _mm_xor_si128(BCu, _mm_rol_epi64(BCe, 1));
+		De = _mm_xor_si128(BCa, _mm_rol_epi64(BCi, 1));
+		Di = _mm_xor_si128(BCe, _mm_rol_epi64(BCo, 1));
+		Do = _mm_xor_si128(BCi, _mm_rol_epi64(BCu, 1));
+		Du = _mm_xor_si128(BCo, _mm_rol_epi64(BCa, 1));
+
+		BCa = _mm_xor_si128(Aba, Da);
+		BCe = _mm_rol_epi64(_mm_xor_si128(Age, De), 44);
+		BCi = _mm_rol_epi64(_mm_xor_si128(Aki, Di), 43);
+		BCo = _mm_rol_epi64(_mm_xor_si128(Amo, Do), 21);
+		BCu = _mm_rol_epi64(_mm_xor_si128(Asu, Du), 14);
+		Eba = _mm_ternarylogic_epi64(BCa, BCe, BCi, 0xD2);
+		Eba = _mm_xor_si128(Eba, _mm_cvtsi64_si128((int64_t)rc[i]));
+		Ebe = _mm_ternarylogic_epi64(BCe, BCi, BCo, 0xD2);
+		Ebi = _mm_ternarylogic_epi64(BCi, BCo, BCu, 0xD2);
+		Ebo = _mm_ternarylogic_epi64(BCo, BCu, BCa, 0xD2);
+		Ebu = _mm_ternarylogic_epi64(BCu, BCa, BCe, 0xD2);
+
+		BCa = _mm_rol_epi64(_mm_xor_si128(Abo, Do), 28);
+		BCe = _mm_rol_epi64(_mm_xor_si128(Agu, Du), 20);
+		BCi = _mm_rol_epi64(_mm_xor_si128(Aka, Da), 3);
+		BCo = _mm_rol_epi64(_mm_xor_si128(Ame, De), 45);
+		BCu = _mm_rol_epi64(_mm_xor_si128(Asi, Di), 61);
+		Ega = _mm_ternarylogic_epi64(BCa, BCe, BCi, 0xD2);
+		Ege = _mm_ternarylogic_epi64(BCe, BCi, BCo, 0xD2);
+		Egi = _mm_ternarylogic_epi64(BCi, BCo, BCu, 0xD2);
+		Ego = _mm_ternarylogic_epi64(BCo, BCu, BCa, 0xD2);
+		Egu = _mm_ternarylogic_epi64(BCu, BCa, BCe, 0xD2);
+
+		BCa = _mm_rol_epi64(_mm_xor_si128(Abe, De), 1);
+		BCe = _mm_rol_epi64(_mm_xor_si128(Agi, Di), 6);
+		BCi = _mm_rol_epi64(_mm_xor_si128(Ako, Do), 25);
+		BCo = _mm_rol_epi64(_mm_xor_si128(Amu, Du), 8);
+		BCu = _mm_rol_epi64(_mm_xor_si128(Asa, Da), 18);
+		Eka = _mm_ternarylogic_epi64(BCa, BCe, BCi, 0xD2);
+		Eke = _mm_ternarylogic_epi64(BCe, BCi, BCo, 0xD2);
+		Eki = _mm_ternarylogic_epi64(BCi, BCo, BCu, 0xD2);
+		Eko = _mm_ternarylogic_epi64(BCo, BCu, BCa, 0xD2);
+		Eku = _mm_ternarylogic_epi64(BCu, BCa, BCe, 0xD2);
+
+		BCa = _mm_rol_epi64(_mm_xor_si128(Abu, Du), 27);
+		BCe = _mm_rol_epi64(_mm_xor_si128(Aga, Da), 36);
+		BCi = _mm_rol_epi64(_mm_xor_si128(Ake, De), 10);
+		BCo = _mm_rol_epi64(_mm_xor_si128(Ami, Di), 15);
+		BCu = _mm_rol_epi64(_mm_xor_si128(Aso, Do), 56);
+		Ema = _mm_ternarylogic_epi64(BCa, BCe, BCi, 0xD2);
+		Eme = _mm_ternarylogic_epi64(BCe, BCi, BCo, 0xD2);
+		Emi = _mm_ternarylogic_epi64(BCi, BCo, BCu, 0xD2);
+		Emo = _mm_ternarylogic_epi64(BCo, BCu, BCa, 0xD2);
+		Emu = _mm_ternarylogic_epi64(BCu, BCa, BCe, 0xD2);
+
+		BCa = _mm_rol_epi64(_mm_xor_si128(Abi, Di), 62);
+		BCe = _mm_rol_epi64(_mm_xor_si128(Ago, Do), 55);
+		BCi = _mm_rol_epi64(_mm_xor_si128(Aku, Du), 39);
+		BCo = _mm_rol_epi64(_mm_xor_si128(Ama, Da), 41);
+		BCu = _mm_rol_epi64(_mm_xor_si128(Ase, De), 2);
+		Esa = _mm_ternarylogic_epi64(BCa, BCe, BCi, 0xD2);
+		Ese = _mm_ternarylogic_epi64(BCe, BCi, BCo, 0xD2);
+		Esi = _mm_ternarylogic_epi64(BCi, BCo, BCu, 0xD2);
+		Eso = _mm_ternarylogic_epi64(BCo, BCu, BCa, 0xD2);
+		Esu = _mm_ternarylogic_epi64(BCu, BCa, BCe, 0xD2);
+
+		/* prepareTheta */
+		BCa = _mm_ternarylogic_epi64(_mm_ternarylogic_epi64(Eba, Ega, Eka, 0x96), Ema, Esa, 0x96);
+		BCe = _mm_ternarylogic_epi64(_mm_ternarylogic_epi64(Ebe, Ege, Eke, 0x96), Eme, Ese, 0x96);
+		BCi = _mm_ternarylogic_epi64(_mm_ternarylogic_epi64(Ebi, Egi, Eki, 0x96), Emi, Esi, 0x96);
+		BCo = _mm_ternarylogic_epi64(_mm_ternarylogic_epi64(Ebo, Ego, Eko, 0x96), Emo, Eso, 0x96);
+		BCu = _mm_ternarylogic_epi64(_mm_ternarylogic_epi64(Ebu, Egu, Eku, 0x96), Emu, Esu, 0x96);
+
+		/* thetaRhoPiChiIota */
+		Da = _mm_xor_si128(BCu, _mm_rol_epi64(BCe, 1));
+		De = _mm_xor_si128(BCa, _mm_rol_epi64(BCi, 1));
+		Di = _mm_xor_si128(BCe, _mm_rol_epi64(BCo, 1));
+		Do = _mm_xor_si128(BCi, _mm_rol_epi64(BCu, 1));
+		Du = _mm_xor_si128(BCo, _mm_rol_epi64(BCa, 1));
+
+		BCa = _mm_xor_si128(Eba, Da);
+		BCe = _mm_rol_epi64(_mm_xor_si128(Ege, De), 44);
+		BCi = _mm_rol_epi64(_mm_xor_si128(Eki, Di), 43);
+		BCo = _mm_rol_epi64(_mm_xor_si128(Emo, Do), 21);
+		BCu = _mm_rol_epi64(_mm_xor_si128(Esu, Du), 14);
+		Aba = _mm_ternarylogic_epi64(BCa, BCe, BCi, 0xD2);
+		Aba = _mm_xor_si128(Aba, _mm_cvtsi64_si128((int64_t)rc[i + 1]));
+		Abe = _mm_ternarylogic_epi64(BCe, BCi, BCo, 0xD2);
+		Abi = _mm_ternarylogic_epi64(BCi, BCo, BCu, 0xD2);
+		Abo = _mm_ternarylogic_epi64(BCo, BCu, BCa, 0xD2);
+		Abu = _mm_ternarylogic_epi64(BCu, BCa, BCe, 0xD2);
+
+		BCa = _mm_rol_epi64(_mm_xor_si128(Ebo, Do), 28);
+		BCe = _mm_rol_epi64(_mm_xor_si128(Egu, Du), 20);
+		BCi = _mm_rol_epi64(_mm_xor_si128(Eka, Da), 3);
+		BCo = _mm_rol_epi64(_mm_xor_si128(Eme, De), 45);
+		BCu = _mm_rol_epi64(_mm_xor_si128(Esi, Di), 61);
+		Aga = _mm_ternarylogic_epi64(BCa, BCe, BCi, 0xD2);
+		Age = _mm_ternarylogic_epi64(BCe, BCi, BCo, 0xD2);
+		Agi = _mm_ternarylogic_epi64(BCi, BCo, BCu, 0xD2);
+		Ago = _mm_ternarylogic_epi64(BCo, BCu, BCa, 0xD2);
+		Agu = _mm_ternarylogic_epi64(BCu, BCa, BCe, 0xD2);
+
+		BCa = _mm_rol_epi64(_mm_xor_si128(Ebe, De), 1);
+		BCe = _mm_rol_epi64(_mm_xor_si128(Egi, Di), 6);
+		BCi = _mm_rol_epi64(_mm_xor_si128(Eko, Do), 25);
+		BCo = _mm_rol_epi64(_mm_xor_si128(Emu, Du), 8);
+		BCu = _mm_rol_epi64(_mm_xor_si128(Esa, Da), 18);
+		Aka = _mm_ternarylogic_epi64(BCa, BCe, BCi, 0xD2);
+		Ake = _mm_ternarylogic_epi64(BCe, BCi, BCo, 0xD2);
+		Aki = _mm_ternarylogic_epi64(BCi, BCo, BCu, 0xD2);
+		Ako = _mm_ternarylogic_epi64(BCo, BCu, BCa, 0xD2);
+		Aku = _mm_ternarylogic_epi64(BCu, BCa, BCe, 0xD2);
+
+		BCa = _mm_rol_epi64(_mm_xor_si128(Ebu, Du), 27);
+		BCe = _mm_rol_epi64(_mm_xor_si128(Ega, Da), 36);
+		BCi = _mm_rol_epi64(_mm_xor_si128(Eke, De), 10);
+		BCo = _mm_rol_epi64(_mm_xor_si128(Emi, Di), 15);
+		BCu = _mm_rol_epi64(_mm_xor_si128(Eso, Do), 56);
+		Ama = _mm_ternarylogic_epi64(BCa, BCe, BCi, 0xD2);
+		Ame = _mm_ternarylogic_epi64(BCe, BCi, BCo, 0xD2);
+		Ami = _mm_ternarylogic_epi64(BCi, BCo, BCu, 0xD2);
+		Amo = _mm_ternarylogic_epi64(BCo, BCu, BCa, 0xD2);
+		Amu = _mm_ternarylogic_epi64(BCu, BCa, BCe, 0xD2);
+
+		BCa = _mm_rol_epi64(_mm_xor_si128(Ebi, Di), 62);
+		BCe = _mm_rol_epi64(_mm_xor_si128(Ego, Do), 55);
+		BCi = _mm_rol_epi64(_mm_xor_si128(Eku, Du), 39);
+		BCo = _mm_rol_epi64(_mm_xor_si128(Ema, Da), 41);
+		BCu = _mm_rol_epi64(_mm_xor_si128(Ese, De), 2);
+		Asa = _mm_ternarylogic_epi64(BCa, BCe, BCi, 0xD2);
+		Ase = _mm_ternarylogic_epi64(BCe, BCi, BCo, 0xD2);
+		Asi = _mm_ternarylogic_epi64(BCi, BCo, BCu, 0xD2);
+		Aso = _mm_ternarylogic_epi64(BCo, BCu, BCa, 0xD2);
+		Asu = _mm_ternarylogic_epi64(BCu, BCa, BCe, 0xD2);
+	}
+
+	/* copyToState(state, A) */
+	_mm_storel_epi64((__m128i*)&state[0], Aba);
+	_mm_storel_epi64((__m128i*)&state[1], Abe);
+	_mm_storel_epi64((__m128i*)&state[2], Abi);
+	_mm_storel_epi64((__m128i*)&state[3], Abo);
+	_mm_storel_epi64((__m128i*)&state[4], Abu);
+	_mm_storel_epi64((__m128i*)&state[5], Aga);
+	_mm_storel_epi64((__m128i*)&state[6], Age);
+	_mm_storel_epi64((__m128i*)&state[7], Agi);
+	_mm_storel_epi64((__m128i*)&state[8], Ago);
+	_mm_storel_epi64((__m128i*)&state[9], Agu);
+	_mm_storel_epi64((__m128i*)&state[10], Aka);
+	_mm_storel_epi64((__m128i*)&state[11], Ake);
+	_mm_storel_epi64((__m128i*)&state[12], Aki);
+	_mm_storel_epi64((__m128i*)&state[13], Ako);
+	_mm_storel_epi64((__m128i*)&state[14], Aku);
+	_mm_storel_epi64((__m128i*)&state[15], Ama);
+	_mm_storel_epi64((__m128i*)&state[16], Ame);
+	_mm_storel_epi64((__m128i*)&state[17], Ami);
+	_mm_storel_epi64((__m128i*)&state[18], Amo);
+	_mm_storel_epi64((__m128i*)&state[19], Amu);
+	_mm_storel_epi64((__m128i*)&state[20], Asa);
+	_mm_storel_epi64((__m128i*)&state[21], Ase);
+	_mm_storel_epi64((__m128i*)&state[22], Asi);
+	_mm_storel_epi64((__m128i*)&state[23], Aso);
+	_mm_storel_epi64((__m128i*)&state[24], Asu);
+}
+
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+
+/* processors with AVX2 also implement BMI1 and BMI2; the chi term compiles to ANDN, and the rotations to RORX */
+static void keccak_permute_p1600c(uint64_t* state, const uint64_t* rc, size_t rounds)
 {
 	assert(state != NULL);
 	assert(rounds % 2 == 0);
@@ -1598,39 +1894,39 @@ void qsc_keccak_permute_p1600c(uint64_t* state, size_t rounds)
 		BCu = Abu ^ Agu ^ Aku ^ Amu ^ Asu;
 
 		/* thetaRhoPiChiIotaPrepareTheta */
-		Da = BCu ^ qsc_intutils_rotl64(BCe, 1);
-		De = BCa ^ qsc_intutils_rotl64(BCi, 1);
-		Di = BCe ^ qsc_intutils_rotl64(BCo, 1);
-		Do = BCi ^ qsc_intutils_rotl64(BCu, 1);
-		Du = BCo ^ qsc_intutils_rotl64(BCa, 1);
+		Da = BCu ^ KECCAK_ROTL64(BCe, 1);
+		De = BCa ^ KECCAK_ROTL64(BCi, 1);
+		Di = BCe ^ KECCAK_ROTL64(BCo, 1);
+		Do = BCi ^ KECCAK_ROTL64(BCu, 1);
+		Du = BCo ^ KECCAK_ROTL64(BCa, 1);
 
 		Aba ^= Da;
 		BCa = Aba;
 		Age ^= De;
-		BCe = qsc_intutils_rotl64(Age, 44);
+		BCe = KECCAK_ROTL64(Age, 44);
 		Aki ^= Di;
-		BCi = qsc_intutils_rotl64(Aki, 43);
+		BCi = KECCAK_ROTL64(Aki, 43);
 		Amo ^= Do;
-		BCo = qsc_intutils_rotl64(Amo, 21);
+		BCo = KECCAK_ROTL64(Amo, 21);
 		Asu ^= Du;
-		BCu = qsc_intutils_rotl64(Asu, 14);
+		BCu = KECCAK_ROTL64(Asu, 14);
 		Eba = BCa ^ ((~BCe) & BCi);
-		Eba ^= KECCAK_ROUND_CONSTANTS[i];
+		Eba ^= rc[i];
 		Ebe = BCe ^ ((~BCi) & BCo);
 		Ebi = BCi ^ ((~BCo) & BCu);
 		Ebo = BCo ^ ((~BCu) & BCa);
 		Ebu = BCu ^ ((~BCa) & BCe);
 
 		Abo ^= Do;
-		BCa = qsc_intutils_rotl64(Abo, 28);
+		BCa = KECCAK_ROTL64(Abo, 28);
 		Agu ^= Du;
-		BCe = qsc_intutils_rotl64(Agu, 20);
+		BCe = KECCAK_ROTL64(Agu, 20);
 		Aka ^= Da;
-		BCi = qsc_intutils_rotl64(Aka, 3);
+		BCi = KECCAK_ROTL64(Aka, 3);
 		Ame ^= De;
-		BCo = qsc_intutils_rotl64(Ame, 45);
+		BCo = KECCAK_ROTL64(Ame, 45);
 		Asi ^= Di;
-		BCu = qsc_intutils_rotl64(Asi, 61);
+		BCu = KECCAK_ROTL64(Asi, 61);
 		Ega = BCa ^ ((~BCe) & BCi);
 		Ege = BCe ^ ((~BCi) & BCo);
 		Egi = BCi ^ ((~BCo) & BCu);
@@ -1638,15 +1934,15 @@ void qsc_keccak_permute_p1600c(uint64_t* state, size_t rounds)
 		Egu = BCu ^ ((~BCa) & BCe);
 
 		Abe ^= De;
-		BCa = qsc_intutils_rotl64(Abe, 1);
+		BCa = KECCAK_ROTL64(Abe, 1);
 		Agi ^= Di;
-		BCe = qsc_intutils_rotl64(Agi, 6);
+		BCe = KECCAK_ROTL64(Agi, 6);
 		Ako ^= Do;
-		BCi = qsc_intutils_rotl64(Ako, 25);
+		BCi = KECCAK_ROTL64(Ako, 25);
 		Amu ^= Du;
-		BCo = qsc_intutils_rotl64(Amu, 8);
+		BCo = KECCAK_ROTL64(Amu, 8);
 		Asa ^= Da;
-		BCu = qsc_intutils_rotl64(Asa, 18);
+		BCu = KECCAK_ROTL64(Asa, 18);
 		Eka = BCa ^ ((~BCe) & BCi);
 		Eke = BCe ^ ((~BCi) & BCo);
 		Eki = BCi ^ ((~BCo) & BCu);
@@ -1654,15 +1950,15 @@ void qsc_keccak_permute_p1600c(uint64_t* state, size_t rounds)
 		Eku = BCu ^ ((~BCa) & BCe);
 
 		Abu ^= Du;
-		BCa = qsc_intutils_rotl64(Abu, 27);
+		BCa = KECCAK_ROTL64(Abu, 27);
 		Aga ^= Da;
-		BCe = qsc_intutils_rotl64(Aga, 36);
+		BCe = KECCAK_ROTL64(Aga, 36);
 		Ake ^= De;
-		BCi = qsc_intutils_rotl64(Ake, 10);
+		BCi = KECCAK_ROTL64(Ake, 10);
 		Ami ^= Di;
-		BCo = qsc_intutils_rotl64(Ami, 15);
+		BCo = KECCAK_ROTL64(Ami, 15);
 		Aso ^= Do;
-		BCu = qsc_intutils_rotl64(Aso, 56);
+		BCu = KECCAK_ROTL64(Aso, 56);
 		Ema = BCa ^ ((~BCe) & BCi);
 		Eme = BCe ^ ((~BCi) & BCo);
 		Emi = BCi ^ ((~BCo) & BCu);
@@ -1670,15 +1966,15 @@ void qsc_keccak_permute_p1600c(uint64_t* state, size_t rounds)
 		Emu = BCu ^ ((~BCa) & BCe);
 
 		Abi ^= Di;
-		BCa = qsc_intutils_rotl64(Abi, 62);
+		BCa = KECCAK_ROTL64(Abi, 62);
 		Ago ^= Do;
-		BCe = qsc_intutils_rotl64(Ago, 55);
+		BCe = KECCAK_ROTL64(Ago, 55);
 		Aku ^= Du;
-		BCi = qsc_intutils_rotl64(Aku, 39);
+		BCi = KECCAK_ROTL64(Aku, 39);
 		Ama ^= Da;
-		BCo = qsc_intutils_rotl64(Ama, 41);
+		BCo = KECCAK_ROTL64(Ama, 41);
 		Ase ^= De;
-		BCu = qsc_intutils_rotl64(Ase, 2);
+		BCu = KECCAK_ROTL64(Ase, 2);
 		Esa = BCa ^ ((~BCe) & BCi);
 		Ese = BCe ^ ((~BCi) & BCo);
 		Esi = BCi ^ ((~BCo) & BCu);
@@ -1693,39 +1989,39 @@ void qsc_keccak_permute_p1600c(uint64_t* state, size_t rounds)
 		BCu = Ebu ^ Egu ^ Eku ^ Emu ^ Esu;
 
 		/* thetaRhoPiChiIotaPrepareTheta */
-		Da = BCu ^ qsc_intutils_rotl64(BCe, 1);
-		De = BCa ^ qsc_intutils_rotl64(BCi, 1);
-		Di = BCe ^ qsc_intutils_rotl64(BCo, 1);
-		Do = BCi ^ qsc_intutils_rotl64(BCu, 1);
-		Du = BCo ^ qsc_intutils_rotl64(BCa, 1);
+		Da = BCu ^ KECCAK_ROTL64(BCe, 1);
+		De = BCa ^ KECCAK_ROTL64(BCi, 1);
+		Di = BCe ^ KECCAK_ROTL64(BCo, 1);
+		Do = BCi ^ KECCAK_ROTL64(BCu, 1);
+		Du = BCo ^ KECCAK_ROTL64(BCa, 1);
 
 		Eba ^= Da;
 		BCa = Eba;
 		Ege ^= De;
-		BCe = qsc_intutils_rotl64(Ege, 44);
+		BCe = KECCAK_ROTL64(Ege, 44);
 		Eki ^= Di;
-		BCi = qsc_intutils_rotl64(Eki, 43);
+		BCi = KECCAK_ROTL64(Eki, 43);
 		Emo ^= Do;
-		BCo = qsc_intutils_rotl64(Emo, 21);
+		BCo = KECCAK_ROTL64(Emo, 21);
 		Esu ^= Du;
-		BCu = qsc_intutils_rotl64(Esu, 14);
+		BCu = KECCAK_ROTL64(Esu, 14);
 		Aba = BCa ^ ((~BCe) & BCi);
-		Aba ^= KECCAK_ROUND_CONSTANTS[i + 1];
+		Aba ^= rc[i + 1];
 		Abe = BCe ^ ((~BCi) & BCo);
 		Abi = BCi ^ ((~BCo) & BCu);
 		Abo = BCo ^ ((~BCu) & BCa);
 		Abu = BCu ^ ((~BCa) & BCe);
 
 		Ebo ^= Do;
-		BCa = qsc_intutils_rotl64(Ebo, 28);
+		BCa = KECCAK_ROTL64(Ebo, 28);
 		Egu ^= Du;
-		BCe = qsc_intutils_rotl64(Egu, 20);
+		BCe = KECCAK_ROTL64(Egu, 20);
 		Eka ^= Da;
-		BCi = qsc_intutils_rotl64(Eka, 3);
+		BCi = KECCAK_ROTL64(Eka, 3);
 		Eme ^= De;
-		BCo = qsc_intutils_rotl64(Eme, 45);
+		BCo = KECCAK_ROTL64(Eme, 45);
 		Esi ^= Di;
-		BCu = qsc_intutils_rotl64(Esi, 61);
+		BCu = KECCAK_ROTL64(Esi, 61);
 		Aga = BCa ^ ((~BCe) & BCi);
 		Age = BCe ^ ((~BCi) & BCo);
 		Agi = BCi ^ ((~BCo) & BCu);
@@ -1733,15 +2029,15 @@ void qsc_keccak_permute_p1600c(uint64_t* state, size_t rounds)
 		Agu = BCu ^ ((~BCa) & BCe);
 
 		Ebe ^= De;
-		BCa = qsc_intutils_rotl64(Ebe, 1);
+		BCa = KECCAK_ROTL64(Ebe, 1);
 		Egi ^= Di;
-		BCe = qsc_intutils_rotl64(Egi, 6);
+		BCe = KECCAK_ROTL64(Egi, 6);
 		Eko ^= Do;
-		BCi = qsc_intutils_rotl64(Eko, 25);
+		BCi = KECCAK_ROTL64(Eko, 25);
 		Emu ^= Du;
-		BCo = qsc_intutils_rotl64(Emu, 8);
+		BCo = KECCAK_ROTL64(Emu, 8);
 		Esa ^= Da;
-		BCu = qsc_intutils_rotl64(Esa, 18);
+		BCu = KECCAK_ROTL64(Esa, 18);
 		Aka = BCa ^ ((~BCe) & BCi);
 		Ake = BCe ^ ((~BCi) & BCo);
 		Aki = BCi ^ ((~BCo) & BCu);
@@ -1749,15 +2045,15 @@ void qsc_keccak_permute_p1600c(uint64_t* state, size_t rounds)
 		Aku = BCu ^ ((~BCa) & BCe);
 
 		Ebu ^= Du;
-		BCa = qsc_intutils_rotl64(Ebu, 27);
+		BCa = KECCAK_ROTL64(Ebu, 27);
 		Ega ^= Da;
-		BCe = qsc_intutils_rotl64(Ega, 36);
+		BCe = KECCAK_ROTL64(Ega, 36);
 		Eke ^= De;
-		BCi = qsc_intutils_rotl64(Eke, 10);
+		BCi = KECCAK_ROTL64(Eke, 10);
 		Emi ^= Di;
-		BCo = qsc_intutils_rotl64(Emi, 15);
+		BCo = KECCAK_ROTL64(Emi, 15);
 		Eso ^= Do;
-		BCu = qsc_intutils_rotl64(Eso, 56);
+		BCu = KECCAK_ROTL64(Eso, 56);
 		Ama = BCa ^ ((~BCe) & BCi);
 		Ame = BCe ^ ((~BCi) & BCo);
 		Ami = BCi ^ ((~BCo) & BCu);
@@ -1765,15 +2061,15 @@ void qsc_keccak_permute_p1600c(uint64_t* state, size_t rounds)
 		Amu = BCu ^ ((~BCa) & BCe);
 
 		Ebi ^= Di;
-		BCa = qsc_intutils_rotl64(Ebi, 62);
+		BCa = KECCAK_ROTL64(Ebi, 62);
 		Ego ^= Do;
-		BCe = qsc_intutils_rotl64(Ego, 55);
+		BCe = KECCAK_ROTL64(Ego, 55);
 		Eku ^= Du;
-		BCi = qsc_intutils_rotl64(Eku, 39);
+		BCi = KECCAK_ROTL64(Eku, 39);
 		Ema ^= Da;
-		BCo = qsc_intutils_rotl64(Ema, 41);
+		BCo = KECCAK_ROTL64(Ema, 41);
 		Ese ^= De;
-		BCu = qsc_intutils_rotl64(Ese, 2);
+		BCu = KECCAK_ROTL64(Ese, 2);
 		Asa = BCa ^ ((~BCe) & BCi);
 		Ase = BCe ^ ((~BCi) & BCo);
 		Asi = BCi ^ ((~BCo) & BCu);
@@ -1809,6 +2105,337 @@ void qsc_keccak_permute_p1600c(uint64_t* state, size_t rounds)
 	state[24] = Asu;
 }
 
+#else
+
+/* lane complementing removes most of the NOT operations from chi on processors without ANDN */
+static void keccak_permute_p1600c(uint64_t* state, const uint64_t* rc, size_t rounds)
+{
+	assert(state != NULL);
+	assert(rounds % 2 == 0);
+
+	uint64_t Aba;
+	uint64_t Abe;
+	uint64_t Abi;
+	uint64_t Abo;
+	uint64_t Abu;
+	uint64_t Aga;
+	uint64_t Age;
+	uint64_t Agi;
+	uint64_t Ago;
+	uint64_t Agu;
+	uint64_t Aka;
+	uint64_t Ake;
+	uint64_t Aki;
+	uint64_t Ako;
+	uint64_t Aku;
+	uint64_t Ama;
+	uint64_t Ame;
+	uint64_t Ami;
+	uint64_t Amo;
+	uint64_t Amu;
+	uint64_t Asa;
+	uint64_t Ase;
+	uint64_t Asi;
+	uint64_t Aso;
+	uint64_t Asu;
+	uint64_t BCa;
+	uint64_t BCe;
+	uint64_t BCi;
+	uint64_t BCo;
+	uint64_t BCu;
+	uint64_t Da;
+	uint64_t De;
+	uint64_t Di;
+	uint64_t Do;
+	uint64_t Du;
+	uint64_t Eba;
+	uint64_t Ebe;
+	uint64_t Ebi;
+	uint64_t Ebo;
+	uint64_t Ebu;
+	uint64_t Ega;
+	uint64_t Ege;
+	uint64_t Egi;
+	uint64_t Ego;
+	uint64_t Egu;
+	uint64_t Eka;
+	uint64_t Eke;
+	uint64_t Eki;
+	uint64_t Eko;
+	uint64_t Eku;
+	uint64_t Ema;
+	uint64_t Eme;
+	uint64_t Emi;
+	uint64_t Emo;
+	uint64_t Emu;
+	uint64_t Esa;
+	uint64_t Ese;
+	uint64_t Esi;
+	uint64_t Eso;
+	uint64_t Esu;
+
+	/* copyFromState(A, state), complementing the lanes in the chi mask */
+	Aba = state[0];
+	Abe = ~state[1];
+	Abi = ~state[2];
+	Abo = state[3];
+	Abu = state[4];
+	Aga = state[5];
+	Age = state[6];
+	Agi = state[7];
+	Ago = ~state[8];
+	Agu = state[9];
+	Aka = state[10];
+	Ake = state[11];
+	Aki = ~state[12];
+	Ako = state[13];
+	Aku = state[14];
+	Ama = state[15];
+	Ame = state[16];
+	Ami = ~state[17];
+	Amo = state[18];
+	Amu = state[19];
+	Asa = ~state[20];
+	Ase = state[21];
+	Asi = state[22];
+	Aso = state[23];
+	Asu = state[24];
+
+	/* prepareTheta */
+	BCa = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
+	BCe = Abe ^ Age ^ Ake ^ Ame ^ Ase;
+	BCi = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
+	BCo = Abo ^ Ago ^ Ako ^ Amo ^ Aso;
+	BCu = Abu ^ Agu ^ Aku ^ Amu ^ Asu;
+
+	for (size_t i = 0; i < rounds; i += 2)
+	{
+		/* thetaRhoPiChiIotaPrepareTheta */
+		Da = BCu ^ KECCAK_ROTL64(BCe, 1);
+		De = BCa ^ KECCAK_ROTL64(BCi, 1);
+		Di = BCe ^ KECCAK_ROTL64(BCo, 1);
+		Do = BCi ^ KECCAK_ROTL64(BCu, 1);
+		Du = BCo ^ KECCAK_ROTL64(BCa, 1);
+
+		Aba ^= Da;
+		BCa = Aba;
+		Age ^= De;
+		BCe = KECCAK_ROTL64(Age, 44);
+		Aki ^= Di;
+		BCi = KECCAK_ROTL64(Aki, 43);
+		Amo ^= Do;
+		BCo = KECCAK_ROTL64(Amo, 21);
+		Asu ^= Du;
+		BCu = KECCAK_ROTL64(Asu, 14);
+		Eba = BCa ^ (BCe | BCi);
+		Eba ^= rc[i];
+		Ebe = BCe ^ ((~BCi) | BCo);
+		Ebi = BCi ^ (BCo & BCu);
+		Ebo = BCo ^ (BCu | BCa);
+		Ebu = BCu ^ (BCa & BCe);
+
+		Abo ^= Do;
+		BCa = KECCAK_ROTL64(Abo, 28);
+		Agu ^= Du;
+		BCe = KECCAK_ROTL64(Agu, 20);
+		Aka ^= Da;
+		BCi = KECCAK_ROTL64(Aka, 3);
+		Ame ^= De;
+		BCo = KECCAK_ROTL64(Ame, 45);
+		Asi ^= Di;
+		BCu = KECCAK_ROTL64(Asi, 61);
+		Ega = BCa ^ (BCe | BCi);
+		Ege = BCe ^ (BCi & BCo);
+		Egi = BCi ^ (BCo | (~BCu));
+		Ego = BCo ^ (BCu | BCa);
+		Egu = BCu ^ (BCa & BCe);
+
+		Abe ^= De;
+		BCa = KECCAK_ROTL64(Abe, 1);
+		Agi ^= Di;
+		BCe = KECCAK_ROTL64(Agi, 6);
+		Ako ^= Do;
+		BCi = KECCAK_ROTL64(Ako, 25);
+		Amu ^= Du;
+		BCo = KECCAK_ROTL64(Amu, 8);
+		Asa ^= Da;
+		BCu = KECCAK_ROTL64(Asa, 18);
+		Eka = BCa ^ (BCe | BCi);
+		Eke = BCe ^ (BCi & BCo);
+		Eki = BCi ^ ((~BCo) & BCu);
+		Eko = (~BCo) ^ (BCu | BCa);
+		Eku = BCu ^ (BCa & BCe);
+
+		Abu ^= Du;
+		BCa = KECCAK_ROTL64(Abu, 27);
+		Aga ^= Da;
+		BCe = KECCAK_ROTL64(Aga, 36);
+		Ake ^= De;
+		BCi = KECCAK_ROTL64(Ake, 10);
+		Ami ^= Di;
+		BCo = KECCAK_ROTL64(Ami, 15);
+		Aso ^= Do;
+		BCu = KECCAK_ROTL64(Aso, 56);
+		Ema = BCa ^ (BCe & BCi);
+		Eme = BCe ^ (BCi | BCo);
+		Emi = BCi ^ ((~BCo) | BCu);
+		Emo = (~BCo) ^ (BCu & BCa);
+		Emu = BCu ^ (BCa | BCe);
+
+		Abi ^= Di;
+		BCa = KECCAK_ROTL64(Abi, 62);
+		Ago ^= Do;
+		BCe = KECCAK_ROTL64(Ago, 55);
+		Aku ^= Du;
+		BCi = KECCAK_ROTL64(Aku, 39);
+		Ama ^= Da;
+		BCo = KECCAK_ROTL64(Ama, 41);
+		Ase ^= De;
+		BCu = KECCAK_ROTL64(Ase, 2);
+		Esa = BCa ^ ((~BCe) & BCi);
+		Ese = (~BCe) ^ (BCi | BCo);
+		Esi = BCi ^ (BCo & BCu);
+		Eso = BCo ^ (BCu | BCa);
+		Esu = BCu ^ (BCa & BCe);
+
+		/* prepareTheta */
+		BCa = Eba ^ Ega ^ Eka ^ Ema ^ Esa;
+		BCe = Ebe ^ Ege ^ Eke ^ Eme ^ Ese;
+		BCi = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
+		BCo = Ebo ^ Ego ^ Eko ^ Emo ^ Eso;
+		BCu = Ebu ^ Egu ^ Eku ^ Emu ^ Esu;
+
+		/* thetaRhoPiChiIotaPrepareTheta */
+		Da = BCu ^ KECCAK_ROTL64(BCe, 1);
+		De = BCa ^ KECCAK_ROTL64(BCi, 1);
+		Di = BCe ^ KECCAK_ROTL64(BCo, 1);
+		Do = BCi ^ KECCAK_ROTL64(BCu, 1);
+		Du = BCo ^ KECCAK_ROTL64(BCa, 1);
+
+		Eba ^= Da;
+		BCa = Eba;
+		Ege ^= De;
+		BCe = KECCAK_ROTL64(Ege, 44);
+		Eki ^= Di;
+		BCi = KECCAK_ROTL64(Eki, 43);
+		Emo ^= Do;
+		BCo = KECCAK_ROTL64(Emo, 21);
+		Esu ^= Du;
+		BCu = KECCAK_ROTL64(Esu, 14);
+		Aba = BCa ^ (BCe | BCi);
+		Aba ^= rc[i + 1];
+		Abe = BCe ^ ((~BCi) | BCo);
+		Abi = BCi ^ (BCo & BCu);
+		Abo = BCo ^ (BCu | BCa);
+		Abu = BCu ^ (BCa & BCe);
+
+		Ebo ^= Do;
+		BCa = KECCAK_ROTL64(Ebo, 28);
+		Egu ^= Du;
+		BCe = KECCAK_ROTL64(Egu, 20);
+		Eka ^= Da;
+		BCi = KECCAK_ROTL64(Eka, 3);
+		Eme ^= De;
+		BCo = KECCAK_ROTL64(Eme, 45);
+		Esi ^= Di;
+		BCu = KECCAK_ROTL64(Esi, 61);
+		Aga = BCa ^ (BCe | BCi);
+		Age = BCe ^ (BCi & BCo);
+		Agi = BCi ^ (BCo | (~BCu));
+		Ago = BCo ^ (BCu | BCa);
+		Agu = BCu ^ (BCa & BCe);
+
+		Ebe ^= De;
+		BCa = KECCAK_ROTL64(Ebe, 1);
+		Egi ^= Di;
+		BCe = KECCAK_ROTL64(Egi, 6);
+		Eko ^= Do;
+		BCi = KECCAK_ROTL64(Eko, 25);
+		Emu ^= Du;
+		BCo = KECCAK_ROTL64(Emu, 8);
+		Esa ^= Da;
+		BCu = KECCAK_ROTL64(Esa, 18);
+		Aka = BCa ^ (BCe | BCi);
+		Ake = BCe ^ (BCi & BCo);
+		Aki = BCi ^ ((~BCo) & BCu);
+		Ako = (~BCo) ^ (BCu | BCa);
+		Aku = BCu ^ (BCa & BCe);
+
+		Ebu ^= Du;
+		BCa = KECCAK_ROTL64(Ebu, 27);
+		Ega ^= Da;
+		BCe = KECCAK_ROTL64(Ega, 36);
+		Eke ^= De;
+		BCi = KECCAK_ROTL64(Eke, 10);
+		Emi ^= Di;
+		BCo = KECCAK_ROTL64(Emi, 15);
+		Eso ^= Do;
+		BCu = KECCAK_ROTL64(Eso, 56);
+		Ama = BCa ^ (BCe & BCi);
+		Ame = BCe ^ (BCi | BCo);
+		Ami = BCi ^ ((~BCo) | BCu);
+		Amo = (~BCo) ^ (BCu & BCa);
+		Amu = BCu ^ (BCa | BCe);
+
+		Ebi ^= Di;
+		BCa = KECCAK_ROTL64(Ebi, 62);
+		Ego ^= Do;
+		BCe = KECCAK_ROTL64(Ego, 55);
+		Eku ^= Du;
+		BCi = KECCAK_ROTL64(Eku, 39);
+		Ema ^= Da;
+		BCo = KECCAK_ROTL64(Ema, 41);
+		Ese ^= De;
+		BCu = KECCAK_ROTL64(Ese, 2);
+		Asa = BCa ^ ((~BCe) & BCi);
+		Ase = (~BCe) ^ (BCi | BCo);
+		Asi = BCi ^ (BCo & BCu);
+		Aso = BCo ^ (BCu | BCa);
+		Asu = BCu ^ (BCa & BCe);
+
+		/* prepareTheta */
+		BCa = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
+		BCe = Abe ^ Age ^ Ake ^ Ame ^ Ase;
+		BCi = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
+		BCo = Abo ^ Ago ^ Ako ^ Amo ^ Aso;
+		BCu = Abu ^ Agu ^ Aku ^ Amu ^ Asu;
+	}
+
+	/* copyToState(state, A), restoring the complemented lanes */
+	state[0] = Aba;
+	state[1] = ~Abe;
+	state[2] = ~Abi;
+	state[3] = Abo;
+	state[4] = Abu;
+	state[5] = Aga;
+	state[6] = Age;
+	state[7] = Agi;
+	state[8] = ~Ago;
+	state[9] = Agu;
+	state[10] = Aka;
+	state[11] = Ake;
+	state[12] = ~Aki;
+	state[13] = Ako;
+	state[14] = Aku;
+	state[15] = Ama;
+	state[16] = Ame;
+	state[17] = ~Ami;
+	state[18] = Amo;
+	state[19] = Amu;
+	state[20] = ~Asa;
+	state[21] = Ase;
+	state[22] = Asi;
+	state[23] = Aso;
+	state[24] = Asu;
+}
+
+#endif
+
+void qsc_keccak_permute_p1600c(uint64_t* state, size_t rounds)
+{
+	keccak_permute_p1600c(state, KECCAK_ROUND_CONSTANTS, rounds);
+}
+
 void qsc_keccak_permute_p1600u(uint64_t* state)
 {
 	assert(state != NULL);
@@ -1906,21 +2533,21 @@ void qsc_keccak_permute_p1600u(uint64_t* state)
 	Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
 	Co = Abo ^ Ago ^ Ako ^ Amo ^ Aso;
 	Cu = Abu ^ Agu ^ Aku ^ Amu ^ Asu;
-	Da = Cu ^ qsc_intutils_rotl64(Ce, 1);
-	De = Ca ^ qsc_intutils_rotl64(Ci, 1);
-	Di = Ce ^ qsc_intutils_rotl64(Co, 1);
-	Do = Ci ^ qsc_intutils_rotl64(Cu, 1);
-	Du = Co ^ qsc_intutils_rotl64(Ca, 1);
+	Da = Cu ^ KECCAK_ROTL64(Ce, 1);
+	De = Ca ^ KECCAK_ROTL64(Ci, 1);
+	Di = Ce ^ KECCAK_ROTL64(Co, 1);
+	Do = Ci ^ KECCAK_ROTL64(Cu, 1);
+	Du = Co ^ KECCAK_ROTL64(Ca, 1);
 	Aba ^= Da;
 	Ca = Aba;
 	Age ^= De;
-	Ce = qsc_intutils_rotl64(Age, 44);
+	Ce = KECCAK_ROTL64(Age, 44);
 	Aki ^= Di;
-	Ci = qsc_intutils_rotl64(Aki, 43);
+	Ci = KECCAK_ROTL64(Aki, 43);
 	Amo ^= Do;
-	Co = qsc_intutils_rotl64(Amo, 21);
+	Co = KECCAK_ROTL64(Amo, 21);
 	Asu ^= Du;
-	Cu = qsc_intutils_rotl64(Asu, 14);
+	Cu = KECCAK_ROTL64(Asu, 14);
 	Eba = Ca ^ ((~Ce) & Ci);
 	Eba ^= 0x0000000000000001ULL;
 	Ebe = Ce ^ ((~Ci) & Co);
@@ -1928,60 +2555,60 @@ void qsc_keccak_permute_p1600u(uint64_t* state)
 	Ebo = Co ^ ((~Cu) & Ca);
 	Ebu = Cu ^ ((~Ca) & Ce);
 	Abo ^= Do;
-	Ca = qsc_intutils_rotl64(Abo, 28);
+	Ca = KECCAK_ROTL64(Abo, 28);
 	Agu ^= Du;
-	Ce = qsc_intutils_rotl64(Agu, 20);
+	Ce = KECCAK_ROTL64(Agu, 20);
 	Aka ^= Da;
-	Ci = qsc_intutils_rotl64(Aka, 3);
+	Ci = KECCAK_ROTL64(Aka, 3);
 	Ame ^= De;
-	Co = qsc_intutils_rotl64(Ame, 45);
+	Co = KECCAK_ROTL64(Ame, 45);
 	Asi ^= Di;
-	Cu = qsc_intutils_rotl64(Asi, 61);
+	Cu = KECCAK_ROTL64(Asi, 61);
 	Ega = Ca ^ ((~Ce) & Ci);
 	Ege = Ce ^ ((~Ci) & Co);
 	Egi = Ci ^ ((~Co) & Cu);
 	Ego = Co ^ ((~Cu) & Ca);
 	Egu = Cu ^ ((~Ca) & Ce);
 	Abe ^= De;
-	Ca = qsc_intutils_rotl64(Abe, 1);
+	Ca = KECCAK_ROTL64(Abe, 1);
 	Agi ^= Di;
-	Ce = qsc_intutils_rotl64(Agi, 6);
+	Ce = KECCAK_ROTL64(Agi, 6);
 	Ako ^= Do;
-	Ci = qsc_intutils_rotl64(Ako, 25);
+	Ci = KECCAK_ROTL64(Ako, 25);
 	Amu ^= Du;
-	Co = qsc_intutils_rotl64(Amu, 8);
+	Co = KECCAK_ROTL64(Amu, 8);
 	Asa ^= Da;
-	Cu = qsc_intutils_rotl64(Asa, 18);
+	Cu = KECCAK_ROTL64(Asa, 18);
 	Eka = Ca ^ ((~Ce) & Ci);
 	Eke = Ce ^ ((~Ci) & Co);
 	Eki = Ci ^ ((~Co) & Cu);
 	Eko = Co ^ ((~Cu) & Ca);
 	Eku = Cu ^ ((~Ca) & Ce);
 	Abu ^= Du;
-	Ca = qsc_intutils_rotl64(Abu, 27);
+	Ca = KECCAK_ROTL64(Abu, 27);
 	Aga ^= Da;
-	Ce = qsc_intutils_rotl64(Aga, 36);
+	Ce = KECCAK_ROTL64(Aga, 36);
 	Ake ^= De;
-	Ci = qsc_intutils_rotl64(Ake, 10);
+	Ci = KECCAK_ROTL64(Ake, 10);
 	Ami ^= Di;
-	Co = qsc_intutils_rotl64(Ami, 15);
+	Co = KECCAK_ROTL64(Ami, 15);
 	Aso ^= Do;
-	Cu = qsc_intutils_rotl64(Aso, 56);
+	Cu = KECCAK_ROTL64(Aso, 56);
 	Ema = Ca ^ ((~Ce) & Ci);
 	Eme = Ce ^ ((~Ci) & Co);
 	Emi = Ci ^ ((~Co) & Cu);
 	Emo = Co ^ ((~Cu) & Ca);
 	Emu = Cu ^ ((~Ca) & Ce);
 	Abi ^= Di;
-	Ca = qsc_intutils_rotl64(Abi, 62);
+	Ca = KECCAK_ROTL64(Abi, 62);
 	Ago ^= Do;
-	Ce = qsc_intutils_rotl64(Ago, 55);
+	Ce = KECCAK_ROTL64(Ago, 55);
 	Aku ^= Du;
-	Ci = qsc_intutils_rotl64(Aku, 39);
+	Ci = KECCAK_ROTL64(Aku, 39);
 	Ama ^= Da;
-	Co = qsc_intutils_rotl64(Ama, 41);
+	Co = KECCAK_ROTL64(Ama, 41);
 	Ase ^= De;
-	Cu = qsc_intutils_rotl64(Ase, 2);
+	Cu = KECCAK_ROTL64(Ase, 2);
 	Esa = Ca ^ ((~Ce) & Ci);
 	Ese = Ce ^ ((~Ci) & Co);
 	Esi = Ci ^ ((~Co) & Cu);
@@ -1993,21 +2620,21 @@ void qsc_keccak_permute_p1600u(uint64_t* state)
 	Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
 	Co = Ebo ^ Ego ^ Eko ^ Emo ^ Eso;
 	Cu = Ebu ^ Egu ^ Eku ^ Emu ^ Esu;
-	Da = Cu ^ qsc_intutils_rotl64(Ce, 1);
-	De = Ca ^ qsc_intutils_rotl64(Ci, 1);
-	Di = Ce ^ qsc_intutils_rotl64(Co, 1);
-	Do = Ci ^ qsc_intutils_rotl64(Cu, 1);
-	Du = Co ^ qsc_intutils_rotl64(Ca, 1);
+	Da = Cu ^ KECCAK_ROTL64(Ce, 1);
+	De = Ca ^ KECCAK_ROTL64(Ci, 1);
+	Di = Ce ^ KECCAK_ROTL64(Co, 1);
+	Do = Ci ^ KECCAK_ROTL64(Cu, 1);
+	Du = Co ^ KECCAK_ROTL64(Ca, 1);
 	Eba ^= Da;
 	Ca = Eba;
 	Ege ^= De;
-	Ce = qsc_intutils_rotl64(Ege, 44);
+	Ce = KECCAK_ROTL64(Ege, 44);
 	Eki ^= Di;
-	Ci = qsc_intutils_rotl64(Eki, 43);
+	Ci = KECCAK_ROTL64(Eki, 43);
 	Emo ^= Do;
-	Co = qsc_intutils_rotl64(Emo, 21);
+	Co = KECCAK_ROTL64(Emo, 21);
 	Esu ^= Du;
-	Cu = qsc_intutils_rotl64(Esu, 14);
+	Cu = KECCAK_ROTL64(Esu, 14);
 	Aba = Ca ^ ((~Ce) & Ci);
 	Aba ^= 0x0000000000008082ULL;
 	Abe = Ce ^ ((~Ci) & Co);
@@ -2015,60 +2642,60 @@ void qsc_keccak_permute_p1600u(uint64_t* state)
 	Abo = Co ^ ((~Cu) & Ca);
 	Abu = Cu ^ ((~Ca) & Ce);
 	Ebo ^= Do;
-	Ca = qsc_intutils_rotl64(Ebo, 28);
+	Ca = KECCAK_ROTL64(Ebo, 28);
 	Egu ^= Du;
-	Ce = qsc_intutils_rotl64(Egu, 20);
+	Ce = KECCAK_ROTL64(Egu, 20);
 	Eka ^= Da;
-	Ci = qsc_intutils_rotl64(Eka, 3);
+	Ci = KECCAK_ROTL64(Eka, 3);
 	Eme ^= De;
-	Co = qsc_intutils_rotl64(Eme, 45);
+	Co = KECCAK_ROTL64(Eme, 45);
 	Esi ^= Di;
-	Cu = qsc_intutils_rotl64(Esi, 61);
+	Cu = KECCAK_ROTL64(Esi, 61);
 	Aga = Ca ^ ((~Ce) & Ci);
 	Age = Ce ^ ((~Ci) & Co);
 	Agi = Ci ^ ((~Co) & Cu);
 	Ago = Co ^ ((~Cu) & Ca);
 	Agu = Cu ^ ((~Ca) & Ce);
 	Ebe ^= De;
-	Ca = qsc_intutils_rotl64(Ebe, 1);
+	Ca = KECCAK_ROTL64(Ebe, 1);
 	Egi ^= Di;
-	Ce = qsc_intutils_rotl64(Egi, 6);
+	Ce = KECCAK_ROTL64(Egi, 6);
 	Eko ^= Do;
-	Ci = qsc_intutils_rotl64(Eko, 25);
+	Ci = KECCAK_ROTL64(Eko, 25);
 	Emu ^= Du;
-	Co = qsc_intutils_rotl64(Emu, 8);
+	Co = KECCAK_ROTL64(Emu, 8);
 	Esa ^= Da;
-	Cu = qsc_intutils_rotl64(Esa, 18);
+	Cu = KECCAK_ROTL64(Esa, 18);
 	Aka = Ca ^ ((~Ce) & Ci);
 	Ake = Ce ^ ((~Ci) & Co);
 	Aki = Ci ^ ((~Co) & Cu);
 	Ako = Co ^ ((~Cu) & Ca);
 	Aku = Cu ^ ((~Ca) & Ce);
 	Ebu ^= Du;
-	Ca = qsc_intutils_rotl64(Ebu, 27);
+	Ca = KECCAK_ROTL64(Ebu, 27);
 	Ega ^= Da;
-	Ce = qsc_intutils_rotl64(Ega, 36);
+	Ce = KECCAK_ROTL64(Ega, 36);
 	Eke ^= De;
-	Ci = qsc_intutils_rotl64(Eke, 10);
+	Ci = KECCAK_ROTL64(Eke, 10);
 	Emi ^= Di;
-	Co = qsc_intutils_rotl64(Emi, 15);
+	Co = KECCAK_ROTL64(Emi, 15);
 	Eso ^= Do;
-	Cu = qsc_intutils_rotl64(Eso, 56);
+	Cu = KECCAK_ROTL64(Eso, 56);
 	Ama = Ca ^ ((~Ce) & Ci);
 	Ame = Ce ^ ((~Ci) & Co);
 	Ami = Ci ^ ((~Co) & Cu);
 	Amo = Co ^ ((~Cu) & Ca);
 	Amu = Cu ^ ((~Ca) & Ce);
 	Ebi ^= Di;
-	Ca = qsc_intutils_rotl64(Ebi, 62);
+	Ca = KECCAK_ROTL64(Ebi, 62);
 	Ego ^= Do;
-	Ce = qsc_intutils_rotl64(Ego, 55);
+	Ce = KECCAK_ROTL64(Ego, 55);
 	Eku ^= Du;
-	Ci = qsc_intutils_rotl64(Eku, 39);
+	Ci = KECCAK_ROTL64(Eku, 39);
 	Ema ^= Da;
-	Co = qsc_intutils_rotl64(Ema, 41);
+	Co = KECCAK_ROTL64(Ema, 41);
 	Ese ^= De;
-	Cu = qsc_intutils_rotl64(Ese, 2);
+	Cu = KECCAK_ROTL64(Ese, 2);
 	Asa = Ca ^ ((~Ce) & Ci);
 	Ase = Ce ^ ((~Ci) & Co);
 	Asi = Ci ^ ((~Co) & Cu);
@@ -2080,21 +2707,21 @@ void qsc_keccak_permute_p1600u(uint64_t* state)
 	Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
 	Co = Abo ^ Ago ^ Ako ^ Amo ^ Aso;
 	Cu = Abu ^ Agu ^ Aku ^ Amu ^ Asu;
-	Da = Cu ^ qsc_intutils_rotl64(Ce, 1);
-	De = Ca ^ qsc_intutils_rotl64(Ci, 1);
-	Di = Ce ^ qsc_intutils_rotl64(Co, 1);
-	Do = Ci ^ qsc_intutils_rotl64(Cu, 1);
-	Du = Co ^ qsc_intutils_rotl64(Ca, 1);
+	Da = Cu ^ KECCAK_ROTL64(Ce, 1);
+	De = Ca ^ KECCAK_ROTL64(Ci, 1);
+	Di = Ce ^ KECCAK_ROTL64(Co, 1);
+	Do = Ci ^ KECCAK_ROTL64(Cu, 1);
+	Du = Co ^ KECCAK_ROTL64(Ca, 1);
 	Aba ^= Da;
 	Ca = Aba;
 	Age ^= De;
-	Ce = qsc_intutils_rotl64(Age, 44);
+	Ce = KECCAK_ROTL64(Age, 44);
 	Aki ^= Di;
-	Ci = qsc_intutils_rotl64(Aki, 43);
+	Ci = KECCAK_ROTL64(Aki, 43);
 	Amo ^= Do;
-	Co = qsc_intutils_rotl64(Amo, 21);
+	Co = KECCAK_ROTL64(Amo, 21);
 	Asu ^= Du;
-	Cu = qsc_intutils_rotl64(Asu, 14);
+	Cu = KECCAK_ROTL64(Asu, 14);
 	Eba = Ca ^ ((~Ce) & Ci);
 	Eba ^= 0x800000000000808AULL;
 	Ebe = Ce ^ ((~Ci) & Co);
@@ -2102,60 +2729,60 @@ void qsc_keccak_permute_p1600u(uint64_t* state)
 	Ebo = Co ^ ((~Cu) & Ca);
 	Ebu = Cu ^ ((~Ca) & Ce);
 	Abo ^= Do;
-	Ca = qsc_intutils_rotl64(Abo, 28);
+	Ca = KECCAK_ROTL64(Abo, 28);
 	Agu ^= Du;
-	Ce = qsc_intutils_rotl64(Agu, 20);
+	Ce = KECCAK_ROTL64(Agu, 20);
 	Aka ^= Da;
-	Ci = qsc_intutils_rotl64(Aka, 3);
+	Ci = KECCAK_ROTL64(Aka, 3);
 	Ame ^= De;
-	Co = qsc_intutils_rotl64(Ame, 45);
+	Co = KECCAK_ROTL64(Ame, 45);
 	Asi ^= Di;
-	Cu = qsc_intutils_rotl64(Asi, 61);
+	Cu = KECCAK_ROTL64(Asi, 61);
 	Ega = Ca ^ ((~Ce) & Ci);
 	Ege = Ce ^ ((~Ci) & Co);
 	Egi = Ci ^ ((~Co) & Cu);
 	Ego = Co ^ ((~Cu) & Ca);
 	Egu = Cu ^ ((~Ca) & Ce);
 	Abe ^= De;
-	Ca = qsc_intutils_rotl64(Abe, 1);
+	Ca = KECCAK_ROTL64(Abe, 1);
 	Agi ^= Di;
-	Ce = qsc_intutils_rotl64(Agi, 6);
+	Ce = KECCAK_ROTL64(Agi, 6);
 	Ako ^= Do;
-	Ci = qsc_intutils_rotl64(Ako, 25);
+	Ci = KECCAK_ROTL64(Ako, 25);
 	Amu ^= Du;
-	Co = qsc_intutils_rotl64(Amu, 8);
+	Co = KECCAK_ROTL64(Amu, 8);
 	Asa ^= Da;
-	Cu = qsc_intutils_rotl64(Asa, 18);
+	Cu = KECCAK_ROTL64(Asa, 18);
 	Eka = Ca ^ ((~Ce) & Ci);
 	Eke = Ce ^ ((~Ci) & Co);
 	Eki = Ci ^ ((~Co) & Cu);
 	Eko = Co ^ ((~Cu) & Ca);
 	Eku = Cu ^ ((~Ca) & Ce);
 	Abu ^= Du;
-	Ca = qsc_intutils_rotl64(Abu, 27);
+	Ca = KECCAK_ROTL64(Abu, 27);
 	Aga ^= Da;
-	Ce = qsc_intutils_rotl64(Aga, 36);
+	Ce = KECCAK_ROTL64(Aga, 36);
 	Ake ^= De;
-	Ci = qsc_intutils_rotl64(Ake, 10);
+	Ci = KECCAK_ROTL64(Ake, 10);
 	Ami ^= Di;
-	Co = qsc_intutils_rotl64(Ami, 15);
+	Co = KECCAK_ROTL64(Ami, 15);
 	Aso ^= Do;
-	Cu = qsc_intutils_rotl64(Aso, 56);
+	Cu = KECCAK_ROTL64(Aso, 56);
 	Ema = Ca ^ ((~Ce) & Ci);
 	Eme = Ce ^ ((~Ci) & Co);
 	Emi = Ci ^ ((~Co) & Cu);
 	Emo = Co ^ ((~Cu) & Ca);
 	Emu = Cu ^ ((~Ca) & Ce);
 	Abi ^= Di;
-	Ca = qsc_intutils_rotl64(Abi, 62);
+	Ca = KECCAK_ROTL64(Abi, 62);
 	Ago ^= Do;
-	Ce = qsc_intutils_rotl64(Ago, 55);
+	Ce = KECCAK_ROTL64(Ago, 55);
 	Aku ^= Du;
-	Ci = qsc_intutils_rotl64(Aku, 39);
+	Ci = KECCAK_ROTL64(Aku, 39);
 	Ama ^= Da;
-	Co = qsc_intutils_rotl64(Ama, 41);
+	Co = KECCAK_ROTL64(Ama, 41);
 	Ase ^= De;
-	Cu = qsc_intutils_rotl64(Ase, 2);
+	Cu = KECCAK_ROTL64(Ase, 2);
 	Esa = Ca ^ ((~Ce) & Ci);
 	Ese = Ce ^ ((~Ci) & Co);
 	Esi = Ci ^ ((~Co) & Cu);
@@ -2167,21 +2794,21 @@ void qsc_keccak_permute_p1600u(uint64_t* state)
 	Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
 	Co = Ebo ^ Ego ^ Eko ^ Emo ^ Eso;
 	Cu = Ebu ^ Egu ^ Eku ^ Emu ^ Esu;
-	Da = Cu ^ qsc_intutils_rotl64(Ce, 1);
-	De = Ca ^ qsc_intutils_rotl64(Ci, 1);
-	Di = Ce ^ qsc_intutils_rotl64(Co, 1);
-	Do = Ci ^ qsc_intutils_rotl64(Cu, 1);
-	Du = Co ^ qsc_intutils_rotl64(Ca, 1);
+	Da = Cu ^ KECCAK_ROTL64(Ce, 1);
+	De = Ca ^ KECCAK_ROTL64(Ci, 1);
+	Di = Ce ^ KECCAK_ROTL64(Co, 1);
+	Do = Ci ^ KECCAK_ROTL64(Cu, 1);
+	Du = Co ^ KECCAK_ROTL64(Ca, 1);
 	Eba ^= Da;
 	Ca = Eba;
 	Ege ^= De;
-	Ce = qsc_intutils_rotl64(Ege, 44);
+	Ce = KECCAK_ROTL64(Ege, 44);
 	Eki ^= Di;
-	Ci = qsc_intutils_rotl64(Eki, 43);
+	Ci = KECCAK_ROTL64(Eki, 43);
 	Emo ^= Do;
-	Co = qsc_intutils_rotl64(Emo, 21);
+	Co = KECCAK_ROTL64(Emo, 21);
 	Esu ^= Du;
-	Cu = qsc_intutils_rotl64(Esu, 14);
+	Cu = KECCAK_ROTL64(Esu, 14);
 	Aba = Ca ^ ((~Ce) & Ci);
 	Aba ^= 0x8000000080008000ULL;
 	Abe = Ce ^ ((~Ci) & Co);
@@ -2189,60 +2816,60 @@ void qsc_keccak_permute_p1600u(uint64_t* state)
 	Abo = Co ^ ((~Cu) & Ca);
 	Abu = Cu ^ ((~Ca) & Ce);
 	Ebo ^= Do;
-	Ca = qsc_intutils_rotl64(Ebo, 28);
+	Ca = KECCAK_ROTL64(Ebo, 28);
 	Egu ^= Du;
-	Ce = qsc_intutils_rotl64(Egu, 20);
+	Ce = KECCAK_ROTL64(Egu, 20);
 	Eka ^= Da;
-	Ci = qsc_intutils_rotl64(Eka, 3);
+	Ci = KECCAK_ROTL64(Eka, 3);
 	Eme ^= De;
-	Co = qsc_intutils_rotl64(Eme, 45);
+	Co = KECCAK_ROTL64(Eme, 45);
 	Esi ^= Di;
-	Cu = qsc_intutils_rotl64(Esi, 61);
+	Cu = KECCAK_ROTL64(Esi, 61);
 	Aga = Ca ^ ((~Ce) & Ci);
 	Age = Ce ^ ((~Ci) & Co);
 	Agi = Ci ^ ((~Co) & Cu);
 	Ago = Co ^ ((~Cu) & Ca);
 	Agu = Cu ^ ((~Ca) & Ce);
 	Ebe ^= De;
-	Ca = qsc_intutils_rotl64(Ebe, 1);
+	Ca = KECCAK_ROTL64(Ebe, 1);
 	Egi ^= Di;
-	Ce = qsc_intutils_rotl64(Egi, 6);
+	Ce = KECCAK_ROTL64(Egi, 6);
 	Eko ^= Do;
-	Ci = qsc_intutils_rotl64(Eko, 25);
+	Ci = KECCAK_ROTL64(Eko, 25);
 	Emu ^= Du;
-	Co = qsc_intutils_rotl64(Emu, 8);
+	Co = KECCAK_ROTL64(Emu, 8);
 	Esa ^= Da;
-	Cu = qsc_intutils_rotl64(Esa, 18);
+	Cu = KECCAK_ROTL64(Esa, 18);
 	Aka = Ca ^ ((~Ce) & Ci);
 	Ake = Ce ^ ((~Ci) & Co);
 	Aki = Ci ^ ((~Co) & Cu);
 	Ako = Co ^ ((~Cu) & Ca);
 	Aku = Cu ^ ((~Ca) & Ce);
 	Ebu ^= Du;
-	Ca = qsc_intutils_rotl64(Ebu, 27);
+	Ca = KECCAK_ROTL64(Ebu, 27);
 	Ega ^= Da;
-	Ce = qsc_intutils_rotl64(Ega, 36);
+	Ce = KECCAK_ROTL64(Ega, 36);
 	Eke ^= De;
-	Ci = qsc_intutils_rotl64(Eke, 10);
+	Ci = KECCAK_ROTL64(Eke, 10);
 	Emi ^= Di;
-	Co = qsc_intutils_rotl64(Emi, 15);
+	Co = KECCAK_ROTL64(Emi, 15);
 	Eso ^= Do;
-	Cu = qsc_intutils_rotl64(Eso, 56);
+	Cu = KECCAK_ROTL64(Eso, 56);
 	Ama = Ca ^ ((~Ce) & Ci);
 	Ame = Ce ^ ((~Ci) & Co);
 	Ami = Ci ^ ((~Co) & Cu);
 	Amo = Co ^ ((~Cu) & Ca);
 	Amu = Cu ^ ((~Ca) & Ce);
 	Ebi ^= Di;
-	Ca = qsc_intutils_rotl64(Ebi, 62);
+	Ca = KECCAK_ROTL64(Ebi, 62);
 	Ego ^= Do;
-	Ce = qsc_intutils_rotl64(Ego, 55);
+	Ce = KECCAK_ROTL64(Ego, 55);
 	Eku ^= Du;
-	Ci = qsc_intutils_rotl64(Eku, 39);
+	Ci = KECCAK_ROTL64(Eku, 39);
 	Ema ^= Da;
-	Co = qsc_intutils_rotl64(Ema, 41);
+	Co = KECCAK_ROTL64(Ema, 41);
 	Ese ^= De;
-	Cu = qsc_intutils_rotl64(Ese, 2);
+	Cu = KECCAK_ROTL64(Ese, 2);
 	Asa = Ca ^ ((~Ce) & Ci);
 	Ase = Ce ^ ((~Ci) & Co);
 	Asi = Ci ^ ((~Co) & Cu);
@@ -2254,21 +2881,21 @@ void qsc_keccak_permute_p1600u(uint64_t* state)
 	Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
 	Co = Abo ^ Ago ^ Ako ^ Amo ^ Aso;
 	Cu = Abu ^ Agu ^ Aku ^ Amu ^ Asu;
-	Da = Cu ^ qsc_intutils_rotl64(Ce, 1);
-	De = Ca ^ qsc_intutils_rotl64(Ci, 1);
-	Di = Ce ^ qsc_intutils_rotl64(Co, 1);
-	Do = Ci ^ qsc_intutils_rotl64(Cu, 1);
-	Du = Co ^ qsc_intutils_rotl64(Ca, 1);
+	Da = Cu ^ KECCAK_ROTL64(Ce, 1);
+	De = Ca ^ KECCAK_ROTL64(Ci, 1);
+	Di = Ce ^ KECCAK_ROTL64(Co, 1);
+	Do = Ci ^ KECCAK_ROTL64(Cu, 1);
+	Du = Co ^ KECCAK_ROTL64(Ca, 1);
 	Aba ^= Da;
 	Ca = Aba;
 	Age ^= De;
-	Ce = qsc_intutils_rotl64(Age, 44);
+	Ce = KECCAK_ROTL64(Age, 44);
 	Aki ^= Di;
-	Ci = qsc_intutils_rotl64(Aki, 43);
+	Ci = KECCAK_ROTL64(Aki, 43);
 	Amo ^= Do;
-	Co = qsc_intutils_rotl64(Amo, 21);
+	Co = KECCAK_ROTL64(Amo, 21);
 	Asu ^= Du;
-	Cu = qsc_intutils_rotl64(Asu, 14);
+	Cu = KECCAK_ROTL64(Asu, 14);
 	Eba = Ca ^ ((~Ce) & Ci);
 	Eba ^= 0x000000000000808BULL;
 	Ebe = Ce ^ ((~Ci) & Co);
@@ -2276,60 +2903,60 @@ void qsc_keccak_permute_p1600u(uint64_t* state)
 	Ebo = Co ^ ((~Cu) & Ca);
 	Ebu = Cu ^ ((~Ca) & Ce);
 	Abo ^= Do;
-	Ca = qsc_intutils_rotl64(Abo, 28);
+	Ca = KECCAK_ROTL64(Abo, 28);
 	Agu ^= Du;
-	Ce = qsc_intutils_rotl64(Agu, 20);
+	Ce = KECCAK_ROTL64(Agu, 20);
 	Aka ^= Da;
-	Ci = qsc_intutils_rotl64(Aka, 3);
+	Ci = KECCAK_ROTL64(Aka, 3);
 	Ame ^= De;
-	Co = qsc_intutils_rotl64(Ame, 45);
+	Co = KECCAK_ROTL64(Ame, 45);
 	Asi ^= Di;
-	Cu = qsc_intutils_rotl64(Asi, 61);
+	Cu = KECCAK_ROTL64(Asi, 61);
 	Ega = Ca ^ ((~Ce) & Ci);
 	Ege = Ce ^ ((~Ci) & Co);
 	Egi = Ci ^ ((~Co) & Cu);
 	Ego = Co ^ ((~Cu) & Ca);
 	Egu = Cu ^ ((~Ca) & Ce);
 	Abe ^= De;
-	Ca = qsc_intutils_rotl64(Abe, 1);
+	Ca = KECCAK_ROTL64(Abe, 1);
 	Agi ^= Di;
-	Ce = qsc_intutils_rotl64(Agi, 6);
+	Ce = KECCAK_ROTL64(Agi, 6);
 	Ako ^= Do;
-	Ci = qsc_intutils_rotl64(Ako, 25);
+	Ci = KECCAK_ROTL64(Ako, 25);
 	Amu ^= Du;
-	Co = qsc_intutils_rotl64(Amu, 8);
+	Co = KECCAK_ROTL64(Amu, 8);
 	Asa ^= Da;
-	Cu = qsc_intutils_rotl64(Asa, 18);
+	Cu = KECCAK_ROTL64(Asa, 18);
 	Eka = Ca ^ ((~Ce) & Ci);
 	Eke = Ce ^ ((~Ci) & Co);
 	Eki = Ci ^ ((~Co) & Cu);
 	Eko = Co ^ ((~Cu) & Ca);
 	Eku = Cu ^ ((~Ca) & Ce);
 	Abu ^= Du;
-	Ca = qsc_intutils_rotl64(Abu, 27);
+	Ca = KECCAK_ROTL64(Abu, 27);
 	Aga ^= Da;
-	Ce = qsc_intutils_rotl64(Aga, 36);
+	Ce = KECCAK_ROTL64(Aga, 36);
 	Ake ^= De;
-	Ci = qsc_intutils_rotl64(Ake, 10);
+	Ci = KECCAK_ROTL64(Ake, 10);
 	Ami ^= Di;
-	Co = qsc_intutils_rotl64(Ami, 15);
+	Co = KECCAK_ROTL64(Ami, 15);
 	Aso ^= Do;
-	Cu = qsc_intutils_rotl64(Aso, 56);
+	Cu = KECCAK_ROTL64(Aso, 56);
 	Ema = Ca ^ ((~Ce) & Ci);
 	Eme = Ce ^ ((~Ci) & Co);
 	Emi = Ci ^ ((~Co) & Cu);
 	Emo = Co ^ ((~Cu) & Ca);
 	Emu = Cu ^ ((~Ca) & Ce);
 	Abi ^= Di;
-	Ca = qsc_intutils_rotl64(Abi, 62);
+	Ca = KECCAK_ROTL64(Abi, 62);
 	Ago ^= Do;
-	Ce = qsc_intutils_rotl64(Ago, 55);
+	Ce = KECCAK_ROTL64(Ago, 55);
 	Aku ^= Du;
-	Ci = qsc_intutils_rotl64(Aku, 39);
+	Ci = KECCAK_ROTL64(Aku, 39);
 	Ama ^= Da;
-	Co = qsc_intutils_rotl64(Ama, 41);
+	Co = KECCAK_ROTL64(Ama, 41);
 	Ase ^= De;
-	Cu = qsc_intutils_rotl64(Ase, 2);
+	Cu = KECCAK_ROTL64(Ase, 2);
 	Esa = Ca ^ ((~Ce) & Ci);
 	Ese = Ce ^ ((~Ci) & Co);
 	Esi = Ci ^ ((~Co) & Cu);
@@ -2341,21 +2968,21 @@ void qsc_keccak_permute_p1600u(uint64_t* state)
 	Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
 	Co = Ebo ^ Ego ^ Eko ^ Emo ^ Eso;
 	Cu = Ebu ^ Egu ^ Eku ^ Emu ^ Esu;
-	Da = Cu ^ qsc_intutils_rotl64(Ce, 1);
-	De = Ca ^ qsc_intutils_rotl64(Ci, 1);
-	Di = Ce ^ qsc_intutils_rotl64(Co, 1);
-	Do = Ci ^ qsc_intutils_rotl64(Cu, 1);
-	Du = Co ^ qsc_intutils_rotl64(Ca, 1);
+	Da = Cu ^ KECCAK_ROTL64(Ce, 1);
+	De = Ca ^ KECCAK_ROTL64(Ci, 1);
+	Di = Ce ^ KECCAK_ROTL64(Co, 1);
+	Do = Ci ^ KECCAK_ROTL64(Cu, 1);
+	Du = Co ^ KECCAK_ROTL64(Ca, 1);
 	Eba ^= Da;
 	Ca = Eba;
 	Ege ^= De;
-	Ce = qsc_intutils_rotl64(Ege, 44);
+	Ce = KECCAK_ROTL64(Ege, 44);
 	Eki ^= Di;
-	Ci = qsc_intutils_rotl64(Eki, 43);
+	Ci = KECCAK_ROTL64(Eki, 43);
 	Emo ^= Do;
-	Co = qsc_intutils_rotl64(Emo, 21);
+	Co = KECCAK_ROTL64(Emo, 21);
 	Esu ^= Du;
-	Cu = qsc_intutils_rotl64(Esu, 14);
+	Cu = KECCAK_ROTL64(Esu, 14);
 	Aba = Ca ^ ((~Ce) & Ci);
 	Aba ^= 0x0000000080000001ULL;
 	Abe = Ce ^ ((~Ci) & Co);
@@ -2363,60 +2990,60 @@ void qsc_keccak_permute_p1600u(uint64_t* state)
 	Abo = Co ^ ((~Cu) & Ca);
 	Abu = Cu ^ ((~Ca) & Ce);
 	Ebo ^= Do;
-	Ca = qsc_intutils_rotl64(Ebo, 28);
+	Ca = KECCAK_ROTL64(Ebo, 28);
 	Egu ^= Du;
-	Ce = qsc_intutils_rotl64(Egu, 20);
+	Ce = KECCAK_ROTL64(Egu, 20);
 	Eka ^= Da;
-	Ci = qsc_intutils_rotl64(Eka, 3);
+	Ci = KECCAK_ROTL64(Eka, 3);
 	Eme ^= De;
-	Co = qsc_intutils_rotl64(Eme, 45);
+	Co = KECCAK_ROTL64(Eme, 45);
 	Esi ^= Di;
-	Cu = qsc_intutils_rotl64(Esi, 61);
+	Cu = KECCAK_ROTL64(Esi, 61);
 	Aga = Ca ^ ((~Ce) & Ci);
 	Age = Ce ^ ((~Ci) & Co);
 	Agi = Ci ^ ((~Co) & Cu);
 	Ago = Co ^ ((~Cu) & Ca);
 	Agu = Cu ^ ((~Ca) & Ce);
 	Ebe ^= De;
-	Ca = qsc_intutils_rotl64(Ebe, 1);
+	Ca = KECCAK_ROTL64(Ebe, 1);
 	Egi ^= Di;
-	Ce = qsc_intutils_rotl64(Egi, 6);
+	Ce = KECCAK_ROTL64(Egi, 6);
 	Eko ^= Do;
-	Ci = qsc_intutils_rotl64(Eko, 25);
+	Ci = KECCAK_ROTL64(Eko, 25);
 	Emu ^= Du;
-	Co = qsc_intutils_rotl64(Emu, 8);
+	Co = KECCAK_ROTL64(Emu, 8);
 	Esa ^= Da;
-	Cu = qsc_intutils_rotl64(Esa, 18);
+	Cu = KECCAK_ROTL64(Esa, 18);
 	Aka = Ca ^ ((~Ce) & Ci);
 	Ake = Ce ^ ((~Ci) & Co);
 	Aki = Ci ^ ((~Co) & Cu);
 	Ako = Co ^ ((~Cu) & Ca);
 	Aku = Cu ^ ((~Ca) & Ce);
 	Ebu ^= Du;
-	Ca = qsc_intutils_rotl64(Ebu, 27);
+	Ca = KECCAK_ROTL64(Ebu, 27);
 	Ega ^= Da;
-	Ce = qsc_intutils_rotl64(Ega, 36);
+	Ce = KECCAK_ROTL64(Ega, 36);
 	Eke ^= De;
-	Ci = qsc_intutils_rotl64(Eke, 10);
+	Ci = KECCAK_ROTL64(Eke, 10);
 	Emi ^= Di;
-	Co = qsc_intutils_rotl64(Emi, 15);
+	Co = KECCAK_ROTL64(Emi, 15);
 	Eso ^= Do;
-	Cu = qsc_intutils_rotl64(Eso, 56);
+	Cu = KECCAK_ROTL64(Eso, 56);
 	Ama = Ca ^ ((~Ce) & Ci);
 	Ame = Ce ^ ((~Ci) & Co);
 	Ami = Ci ^ ((~Co) & Cu);
 	Amo = Co ^ ((~Cu) & Ca);
 	Amu = Cu ^ ((~Ca) & Ce);
 	Ebi ^= Di;
-	Ca = qsc_intutils_rotl64(Ebi, 62);
+	Ca = KECCAK_ROTL64(Ebi, 62);
 	Ego ^= Do;
-	Ce = qsc_intutils_rotl64(Ego, 55);
+	Ce = KECCAK_ROTL64(Ego, 55);
 	Eku ^= Du;
-	Ci = qsc_intutils_rotl64(Eku, 39);
+	Ci = KECCAK_ROTL64(Eku, 39);
 	Ema ^= Da;
-	Co = qsc_intutils_rotl64(Ema, 41);
+	Co = KECCAK_ROTL64(Ema, 41);
 	Ese ^= De;
-	Cu = qsc_intutils_rotl64(Ese, 2);
+	Cu = KECCAK_ROTL64(Ese, 2);
 	Asa = Ca ^ ((~Ce) & Ci);
 	Ase = Ce ^ ((~Ci) & Co);
 	Asi = Ci ^ ((~Co) & Cu);
@@ -2428,21 +3055,21 @@ void qsc_keccak_permute_p1600u(uint64_t* state)
 	Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
 	Co = Abo ^ Ago ^ Ako ^ Amo ^ Aso;
 	Cu = Abu ^ Agu ^ Aku ^ Amu ^ Asu;
-	Da = Cu ^ qsc_intutils_rotl64(Ce, 1);
-	De = Ca ^ qsc_intutils_rotl64(Ci, 1);
-	Di = Ce ^ qsc_intutils_rotl64(Co, 1);
-	Do = Ci ^ qsc_intutils_rotl64(Cu, 1);
-	Du = Co ^ qsc_intutils_rotl64(Ca, 1);
+	Da = Cu ^ KECCAK_ROTL64(Ce, 1);
+	De = Ca ^ KECCAK_ROTL64(Ci, 1);
+	Di = Ce ^ KECCAK_ROTL64(Co, 1);
+	Do = Ci ^ KECCAK_ROTL64(Cu, 1);
+	Du = Co ^ KECCAK_ROTL64(Ca, 1);
 	Aba ^= Da;
 	Ca = Aba;
 	Age ^= De;
-	Ce = qsc_intutils_rotl64(Age, 44);
+	Ce = KECCAK_ROTL64(Age, 44);
 	Aki ^= Di;
-	Ci = qsc_intutils_rotl64(Aki, 43);
+	Ci = KECCAK_ROTL64(Aki, 43);
 	Amo ^= Do;
-	Co = qsc_intutils_rotl64(Amo, 21);
+	Co = KECCAK_ROTL64(Amo, 21);
 	Asu ^= Du;
-	Cu = qsc_intutils_rotl64(Asu, 14);
+	Cu = KECCAK_ROTL64(Asu, 14);
 	Eba = Ca ^ ((~Ce) & Ci);
 	Eba ^= 0x8000000080008081ULL;
 	Ebe = Ce ^ ((~Ci) & Co);
@@ -2450,60 +3077,60 @@ void qsc_keccak_permute_p1600u(uint64_t* state)
 	Ebo = Co ^ ((~Cu) & Ca);
 	Ebu = Cu ^ ((~Ca) & Ce);
 	Abo ^= Do;
-	Ca = qsc_intutils_rotl64(Abo, 28);
+	Ca = KECCAK_ROTL64(Abo, 28);
 	Agu ^= Du;
-	Ce = qsc_intutils_rotl64(Agu, 20);
+	Ce = KECCAK_ROTL64(Agu, 20);
 	Aka ^= Da;
-	Ci = qsc_intutils_rotl64(Aka, 3);
+	Ci = KECCAK_ROTL64(Aka, 3);
 	Ame ^= De;
-	Co = qsc_intutils_rotl64(Ame, 45);
+	Co = KECCAK_ROTL64(Ame, 45);
 	Asi ^= Di;
-	Cu = qsc_intutils_rotl64(Asi, 61);
+	Cu = KECCAK_ROTL64(Asi, 61);
 	Ega = Ca ^ ((~Ce) & Ci);
 	Ege = Ce ^ ((~Ci) & Co);
 	Egi = Ci ^ ((~Co) & Cu);
 	Ego = Co ^ ((~Cu) & Ca);
 	Egu = Cu ^ ((~Ca) & Ce);
 	Abe ^= De;
-	Ca = qsc_intutils_rotl64(Abe, 1);
+	Ca = KECCAK_ROTL64(Abe, 1);
 	Agi ^= Di;
-	Ce = qsc_intutils_rotl64(Agi, 6);
+	Ce = KECCAK_ROTL64(Agi, 6);
 	Ako ^= Do;
-	Ci = qsc_intutils_rotl64(Ako, 25);
+	Ci = KECCAK_ROTL64(Ako, 25);
 	Amu ^= Du;
-	Co = qsc_intutils_rotl64(Amu, 8);
+	Co = KECCAK_ROTL64(Amu, 8);
 	Asa ^= Da;
-	Cu = qsc_intutils_rotl64(Asa, 18);
+	Cu = KECCAK_ROTL64(Asa, 18);
 	Eka = Ca ^ ((~Ce) & Ci);
 	Eke = Ce ^ ((~Ci) & Co);
 	Eki = Ci ^ ((~Co) & Cu);
 	Eko = Co ^ ((~Cu) & Ca);
 	Eku = Cu ^ ((~Ca) & Ce);
 	Abu ^= Du;
-	Ca = qsc_intutils_rotl64(Abu, 27);
+	Ca = KECCAK_ROTL64(Abu, 27);
 	Aga ^= Da;
-	Ce = qsc_intutils_rotl64(Aga, 36);
+	Ce = KECCAK_ROTL64(Aga, 36);
 	Ake ^= De;
-	Ci = qsc_intutils_rotl64(Ake, 10);
+	Ci = KECCAK_ROTL64(Ake, 10);
 	Ami ^= Di;
-	Co = qsc_intutils_rotl64(Ami, 15);
+	Co = KECCAK_ROTL64(Ami, 15);
 	Aso ^= Do;
-	Cu = qsc_intutils_rotl64(Aso, 56);
+	Cu = KECCAK_ROTL64(Aso, 56);
 	Ema = Ca ^ ((~Ce) & Ci);
 	Eme = Ce ^ ((~Ci) & Co);
 	Emi = Ci ^ ((~Co) & Cu);
 	Emo = Co ^ ((~Cu) & Ca);
 	Emu = Cu ^ ((~Ca) & Ce);
 	Abi ^= Di;
-	Ca = qsc_intutils_rotl64(Abi, 62);
+	Ca = KECCAK_ROTL64(Abi, 62);
 	Ago ^= Do;
-	Ce = qsc_intutils_rotl64(Ago, 55);
+	Ce = KECCAK_ROTL64(Ago, 55);
 	Aku ^= Du;
-	Ci = qsc_intutils_rotl64(Aku, 39);
+	Ci = KECCAK_ROTL64(Aku, 39);
 	Ama ^= Da;
-	Co = qsc_intutils_rotl64(Ama, 41);
+	Co = KECCAK_ROTL64(Ama, 41);
 	Ase ^= De;
-	Cu = qsc_intutils_rotl64(Ase, 2);
+	Cu = KECCAK_ROTL64(Ase, 2);
 	Esa = Ca ^ ((~Ce) & Ci);
 	Ese = Ce ^ ((~Ci) & Co);
 	Esi = Ci ^ ((~Co) & Cu);
@@ -2515,21 +3142,21 @@ void qsc_keccak_permute_p1600u(uint64_t* state)
 	Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
 	Co = Ebo ^ Ego ^ Eko ^ Emo ^ Eso;
 	Cu = Ebu ^ Egu ^ Eku ^ Emu ^ Esu;
-	Da = Cu ^ qsc_intutils_rotl64(Ce, 1);
-	De = Ca ^ qsc_intutils_rotl64(Ci, 1);
-	Di = Ce ^ qsc_intutils_rotl64(Co, 1);
-	Do = Ci ^ qsc_intutils_rotl64(Cu, 1);
-	Du = Co ^ qsc_intutils_rotl64(Ca, 1);
+	Da = Cu ^ KECCAK_ROTL64(Ce, 1);
+	De = Ca ^ KECCAK_ROTL64(Ci, 1);
+	Di = Ce ^ KECCAK_ROTL64(Co, 1);
+	Do = Ci ^ KECCAK_ROTL64(Cu, 1);
+	Du = Co ^ KECCAK_ROTL64(Ca, 1);
 	Eba ^= Da;
 	Ca = Eba;
 	Ege ^= De;
-	Ce = qsc_intutils_rotl64(Ege, 44);
+	Ce = KECCAK_ROTL64(Ege, 44);
 	Eki ^= Di;
-	Ci = qsc_intutils_rotl64(Eki, 43);
+	Ci = KECCAK_ROTL64(Eki, 43);
 	Emo ^= Do;
-	Co = qsc_intutils_rotl64(Emo, 21);
+	Co = KECCAK_ROTL64(Emo, 21);
 	Esu ^= Du;
-	Cu = qsc_intutils_rotl64(Esu, 14);
+	Cu = KECCAK_ROTL64(Esu, 14);
 	Aba = Ca ^ ((~Ce) & Ci);
 	Aba ^= 0x8000000000008009ULL;
 	Abe = Ce ^ ((~Ci) & Co);
@@ -2537,60 +3164,60 @@ void qsc_keccak_permute_p1600u(uint64_t* state)
 	Abo = Co ^ ((~Cu) & Ca);
 	Abu = Cu ^ ((~Ca) & Ce);
 	Ebo ^= Do;
-	Ca = qsc_intutils_rotl64(Ebo, 28);
+	Ca = KECCAK_ROTL64(Ebo, 28);
 	Egu ^= Du;
-	Ce = qsc_intutils_rotl64(Egu, 20);
+	Ce = KECCAK_ROTL64(Egu, 20);
 	Eka ^= Da;
-	Ci = qsc_intutils_rotl64(Eka, 3);
+	Ci = KECCAK_ROTL64(Eka, 3);
 	Eme ^= De;
-	Co = qsc_intutils_rotl64(Eme, 45);
+	Co = KECCAK_ROTL64(Eme, 45);
 	Esi ^= Di;
-	Cu = qsc_intutils_rotl64(Esi, 61);
+	Cu = KECCAK_ROTL64(Esi, 61);
 	Aga = Ca ^ ((~Ce) & Ci);
 	Age = Ce ^ ((~Ci) & Co);
 	Agi = Ci ^ ((~Co) & Cu);
 	Ago = Co ^ ((~Cu) & Ca);
 	Agu = Cu ^ ((~Ca) & Ce);
 	Ebe ^= De;
-	Ca = qsc_intutils_rotl64(Ebe, 1);
+	Ca = KECCAK_ROTL64(Ebe, 1);
 	Egi ^= Di;
-	Ce = qsc_intutils_rotl64(Egi, 6);
+	Ce = KECCAK_ROTL64(Egi, 6);
 	Eko ^= Do;
-	Ci = qsc_intutils_rotl64(Eko, 25);
+	Ci = KECCAK_ROTL64(Eko, 25);
 	Emu ^= Du;
-	Co = qsc_intutils_rotl64(Emu, 8);
+	Co = KECCAK_ROTL64(Emu, 8);
 	Esa ^= Da;
-	Cu = qsc_intutils_rotl64(Esa, 18);
+	Cu = KECCAK_ROTL64(Esa, 18);
 	Aka = Ca ^ ((~Ce) & Ci);
 	Ake = Ce ^ ((~Ci) & Co);
 	Aki = Ci ^ ((~Co) & Cu);
 	Ako = Co ^ ((~Cu) & Ca);
 	Aku = Cu ^ ((~Ca) & Ce);
 	Ebu ^= Du;
-	Ca = qsc_intutils_rotl64(Ebu, 27);
+	Ca = KECCAK_ROTL64(Ebu, 27);
 	Ega ^= Da;
-	Ce = qsc_intutils_rotl64(Ega, 36);
+	Ce = KECCAK_ROTL64(Ega, 36);
 	Eke ^= De;
-	Ci = qsc_intutils_rotl64(Eke, 10);
+	Ci = KECCAK_ROTL64(Eke, 10);
 	Emi ^= Di;
-	Co = qsc_intutils_rotl64(Emi, 15);
+	Co = KECCAK_ROTL64(Emi, 15);
 	Eso ^= Do;
-	Cu = qsc_intutils_rotl64(Eso, 56);
+	Cu = KECCAK_ROTL64(Eso, 56);
 	Ama = Ca ^ ((~Ce) & Ci);
 	Ame = Ce ^ ((~Ci) & Co);
 	Ami = Ci ^ ((~Co) & Cu);
 	Amo = Co ^ ((~Cu) & Ca);
 	Amu = Cu ^ ((~Ca) & Ce);
 	Ebi ^= Di;
-	Ca = qsc_intutils_rotl64(Ebi, 62);
+	Ca = KECCAK_ROTL64(Ebi, 62);
 	Ego ^= Do;
-	Ce = qsc_intutils_rotl64(Ego, 55);
+	Ce = KECCAK_ROTL64(Ego, 55);
 	Eku ^= Du;
-	Ci = qsc_intutils_rotl64(Eku, 39);
+	Ci = KECCAK_ROTL64(Eku, 39);
 	Ema ^= Da;
-	Co = qsc_intutils_rotl64(Ema, 41);
+	Co = KECCAK_ROTL64(Ema, 41);
 	Ese ^= De;
-	Cu = qsc_intutils_rotl64(Ese, 2);
+	Cu = KECCAK_ROTL64(Ese, 2);
 	Asa = Ca ^ ((~Ce) & Ci);
 	Ase = Ce ^ ((~Ci) & Co);
 	Asi = Ci ^ ((~Co) & Cu);
@@ -2602,21 +3229,21 @@ void qsc_keccak_permute_p1600u(uint64_t* state)
 	Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
 	Co = Abo ^ Ago ^ Ako ^ Amo ^ Aso;
 	Cu = Abu ^ Agu ^ Aku ^ Amu ^ Asu;
-	Da = Cu ^ qsc_intutils_rotl64(Ce, 1);
-	De = Ca ^ qsc_intutils_rotl64(Ci, 1);
-	Di = Ce ^ qsc_intutils_rotl64(Co, 1);
-	Do = Ci ^ qsc_intutils_rotl64(Cu, 1);
-	Du = Co ^ qsc_intutils_rotl64(Ca, 1);
+	Da = Cu ^ KECCAK_ROTL64(Ce, 1);
+	De = Ca ^ KECCAK_ROTL64(Ci, 1);
+	Di = Ce ^ KECCAK_ROTL64(Co, 1);
+	Do = Ci ^ KECCAK_ROTL64(Cu, 1);
+	Du = Co ^ KECCAK_ROTL64(Ca, 1);
 	Aba ^= Da;
 	Ca = Aba;
 	Age ^= De;
-	Ce = qsc_intutils_rotl64(Age, 44);
+	Ce = KECCAK_ROTL64(Age, 44);
 	Aki ^= Di;
-	Ci = qsc_intutils_rotl64(Aki, 43);
+	Ci = KECCAK_ROTL64(Aki, 43);
 	Amo ^= Do;
-	Co = qsc_intutils_rotl64(Amo, 21);
+	Co = KECCAK_ROTL64(Amo, 21);
 	Asu ^= Du;
-	Cu = qsc_intutils_rotl64(Asu, 14);
+	Cu = KECCAK_ROTL64(Asu, 14);
 	Eba = Ca ^ ((~Ce) & Ci);
 	Eba ^= 0x000000000000008AULL;
 	Ebe = Ce ^ ((~Ci) & Co);
@@ -2624,60 +3251,60 @@ void qsc_keccak_permute_p1600u(uint64_t* state)
 	Ebo = Co ^ ((~Cu) & Ca);
 	Ebu = Cu ^ ((~Ca) & Ce);
 	Abo ^= Do;
-	Ca = qsc_intutils_rotl64(Abo, 28);
+	Ca = KECCAK_ROTL64(Abo, 28);
 	Agu ^= Du;
-	Ce = qsc_intutils_rotl64(Agu, 20);
+	Ce = KECCAK_ROTL64(Agu, 20);
 	Aka ^= Da;
-	Ci = qsc_intutils_rotl64(Aka, 3);
+	Ci = KECCAK_ROTL64(Aka, 3);
 	Ame ^= De;
-	Co = qsc_intutils_rotl64(Ame, 45);
+	Co = KECCAK_ROTL64(Ame, 45);
 	Asi ^= Di;
-	Cu = qsc_intutils_rotl64(Asi, 61);
+	Cu = KECCAK_ROTL64(Asi, 61);
 	Ega = Ca ^ ((~Ce) & Ci);
 	Ege = Ce ^ ((~Ci) & Co);
 	Egi = Ci ^ ((~Co) & Cu);
 	Ego = Co ^ ((~Cu) & Ca);
 	Egu = Cu ^ ((~Ca) & Ce);
 	Abe ^= De;
-	Ca = qsc_intutils_rotl64(Abe, 1);
+	Ca = KECCAK_ROTL64(Abe, 1);
 	Agi ^= Di;
-	Ce = qsc_intutils_rotl64(Agi, 6);
+	Ce = KECCAK_ROTL64(Agi, 6);
 	Ako ^= Do;
-	Ci = qsc_intutils_rotl64(Ako, 25);
+	Ci = KECCAK_ROTL64(Ako, 25);
 	Amu ^= Du;
-	Co = qsc_intutils_rotl64(Amu, 8);
+	Co = KECCAK_ROTL64(Amu, 8);
 	Asa ^= Da;
-	Cu = qsc_intutils_rotl64(Asa, 18);
+	Cu = KECCAK_ROTL64(Asa, 18);
 	Eka = Ca ^ ((~Ce) & Ci);
 	Eke = Ce ^ ((~Ci) & Co);
 	Eki = Ci ^ ((~Co) & Cu);
 	Eko = Co ^ ((~Cu) & Ca);
 	Eku = Cu ^ ((~Ca) & Ce);
 	Abu ^= Du;
-	Ca = qsc_intutils_rotl64(Abu, 27);
+	Ca = KECCAK_ROTL64(Abu, 27);
 	Aga ^= Da;
-	Ce = qsc_intutils_rotl64(Aga, 36);
+	Ce = KECCAK_ROTL64(Aga, 36);
 	Ake ^= De;
-	Ci = qsc_intutils_rotl64(Ake, 10);
+	Ci = KECCAK_ROTL64(Ake, 10);
 	Ami ^= Di;
-	Co = qsc_intutils_rotl64(Ami, 15);
+	Co = KECCAK_ROTL64(Ami, 15);
 	Aso ^= Do;
-	Cu = qsc_intutils_rotl64(Aso, 56);
+	Cu = KECCAK_ROTL64(Aso, 56);
 	Ema = Ca ^ ((~Ce) & Ci);
 	Eme = Ce ^ ((~Ci) & Co);
 	Emi = Ci ^ ((~Co) & Cu);
 	Emo = Co ^ ((~Cu) & Ca);
 	Emu = Cu ^ ((~Ca) & Ce);
 	Abi ^= Di;
-	Ca = qsc_intutils_rotl64(Abi, 62);
+	Ca = KECCAK_ROTL64(Abi, 62);
 	Ago ^= Do;
-	Ce = qsc_intutils_rotl64(Ago, 55);
+	Ce = KECCAK_ROTL64(Ago, 55);
 	Aku ^= Du;
-	Ci = qsc_intutils_rotl64(Aku, 39);
+	Ci = KECCAK_ROTL64(Aku, 39);
 	Ama ^= Da;
-	Co = qsc_intutils_rotl64(Ama, 41);
+	Co = KECCAK_ROTL64(Ama, 41);
 	Ase ^= De;
-	Cu = qsc_intutils_rotl64(Ase, 2);
+	Cu = KECCAK_ROTL64(Ase, 2);
 	Esa = Ca ^ ((~Ce) & Ci);
 	Ese = Ce ^ ((~Ci) & Co);
 	Esi = Ci ^ ((~Co) & Cu);
@@ -2689,21 +3316,21 @@ void qsc_keccak_permute_p1600u(uint64_t* state)
 	Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
 	Co = Ebo ^ Ego ^ Eko ^ Emo ^ Eso;
 	Cu = Ebu ^ Egu ^ Eku ^ Emu ^ Esu;
-	Da = Cu ^ qsc_intutils_rotl64(Ce, 1);
-	De = Ca ^ qsc_intutils_rotl64(Ci, 1);
-	Di = Ce ^ qsc_intutils_rotl64(Co, 1);
-	Do = Ci ^ qsc_intutils_rotl64(Cu, 1);
-	Du = Co ^ qsc_intutils_rotl64(Ca, 1);
+	Da = Cu ^ KECCAK_ROTL64(Ce, 1);
+	De = Ca ^ KECCAK_ROTL64(Ci, 1);
+	Di = Ce ^ KECCAK_ROTL64(Co, 1);
+	Do = Ci ^ KECCAK_ROTL64(Cu, 1);
+	Du = Co ^ KECCAK_ROTL64(Ca, 1);
 	Eba ^= Da;
 	Ca = Eba;
 	Ege ^= De;
-	Ce = qsc_intutils_rotl64(Ege, 44);
+	Ce = KECCAK_ROTL64(Ege, 44);
 	Eki ^= Di;
-	Ci = qsc_intutils_rotl64(Eki, 43);
+	Ci = KECCAK_ROTL64(Eki, 43);
 	Emo ^= Do;
-	Co = qsc_intutils_rotl64(Emo, 21);
+	Co = KECCAK_ROTL64(Emo, 21);
 	Esu ^= Du;
-	Cu = qsc_intutils_rotl64(Esu, 14);
+	Cu = KECCAK_ROTL64(Esu, 14);
 	Aba = Ca ^ ((~Ce) & Ci);
 	Aba ^= 0x0000000000000088ULL;
 	Abe = Ce ^ ((~Ci) & Co);
@@ -2711,60 +3338,60 @@ void qsc_keccak_permute_p1600u(uint64_t* state)
 	Abo = Co ^ ((~Cu) & Ca);
 	Abu = Cu ^ ((~Ca) & Ce);
 	Ebo ^= Do;
-	Ca = qsc_intutils_rotl64(Ebo, 28);
+	Ca = KECCAK_ROTL64(Ebo, 28);
 	Egu ^= Du;
-	Ce = qsc_intutils_rotl64(Egu, 20);
+	Ce = KECCAK_ROTL64(Egu, 20);
 	Eka ^= Da;
-	Ci = qsc_intutils_rotl64(Eka, 3);
+	Ci = KECCAK_ROTL64(Eka, 3);
 	Eme ^= De;
-	Co = qsc_intutils_rotl64(Eme, 45);
+	Co = KECCAK_ROTL64(Eme, 45);
 	Esi ^= Di;
-	Cu = qsc_intutils_rotl64(Esi, 61);
+	Cu = KECCAK_ROTL64(Esi, 61);
 	Aga = Ca ^ ((~Ce) & Ci);
 	Age = Ce ^ ((~Ci) & Co);
 	Agi = Ci ^ ((~Co) & Cu);
 	Ago = Co ^ ((~Cu) & Ca);
 	Agu = Cu ^ ((~Ca) & Ce);
 	Ebe ^= De;
-	Ca = qsc_intutils_rotl64(Ebe, 1);
+	Ca = KECCAK_ROTL64(Ebe, 1);
 	Egi ^= Di;
-	Ce = qsc_intutils_rotl64(Egi, 6);
+	Ce = KECCAK_ROTL64(Egi, 6);
 	Eko ^= Do;
-	Ci = qsc_intutils_rotl64(Eko, 25);
+	Ci = KECCAK_ROTL64(Eko, 25);
 	Emu ^= Du;
-	Co = qsc_intutils_rotl64(Emu, 8);
+	Co = KECCAK_ROTL64(Emu, 8);
 	Esa ^= Da;
-	Cu = qsc_intutils_rotl64(Esa, 18);
+	Cu = KECCAK_ROTL64(Esa, 18);
 	Aka = Ca ^ ((~Ce) & Ci);
 	Ake = Ce ^ ((~Ci) & Co);
 	Aki = Ci ^ ((~Co) & Cu);
 	Ako = Co ^ ((~Cu) & Ca);
 	Aku = Cu ^ ((~Ca) & Ce);
 	Ebu ^= Du;
-	Ca = qsc_intutils_rotl64(Ebu, 27);
+	Ca = KECCAK_ROTL64(Ebu, 27);
 	Ega ^= Da;
-	Ce = qsc_intutils_rotl64(Ega, 36);
+	Ce = KECCAK_ROTL64(Ega, 36);
 	Eke ^= De;
-	Ci = qsc_intutils_rotl64(Eke, 10);
+	Ci = KECCAK_ROTL64(Eke, 10);
 	Emi ^= Di;
-	Co = qsc_intutils_rotl64(Emi, 15);
+	Co = KECCAK_ROTL64(Emi, 15);
 	Eso ^= Do;
-	Cu = qsc_intutils_rotl64(Eso, 56);
+	Cu = KECCAK_ROTL64(Eso, 56);
 	Ama = Ca ^ ((~Ce) & Ci);
 	Ame = Ce ^ ((~Ci) & Co);
 	Ami = Ci ^ ((~Co) & Cu);
 	Amo = Co ^ ((~Cu) & Ca);
 	Amu = Cu ^ ((~Ca) & Ce);
 	Ebi ^= Di;
-	Ca = qsc_intutils_rotl64(Ebi, 62);
+	Ca = KECCAK_ROTL64(Ebi, 62);
 	Ego ^= Do;
-	Ce = qsc_intutils_rotl64(Ego, 55);
+	Ce = KECCAK_ROTL64(Ego, 55);
 	Eku ^= Du;
-	Ci = qsc_intutils_rotl64(Eku, 39);
+	Ci = KECCAK_ROTL64(Eku, 39);
 	Ema ^= Da;
-	Co = qsc_intutils_rotl64(Ema, 41);
+	Co = KECCAK_ROTL64(Ema, 41);
 	Ese ^= De;
-	Cu = qsc_intutils_rotl64(Ese, 2);
+	Cu = KECCAK_ROTL64(Ese, 2);
 	Asa = Ca ^ ((~Ce) & Ci);
 	Ase = Ce ^ ((~Ci) & Co);
 	Asi = Ci ^ ((~Co) & Cu);
@@ -2776,21 +3403,21 @@ void qsc_keccak_permute_p1600u(uint64_t* state)
 	Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
 	Co = Abo ^ Ago ^ Ako ^ Amo ^ Aso;
 	Cu = Abu ^ Agu ^ Aku ^ Amu ^ Asu;
-	Da = Cu ^ qsc_intutils_rotl64(Ce, 1);
-	De = Ca ^ qsc_intutils_rotl64(Ci, 1);
-	Di = Ce ^ qsc_intutils_rotl64(Co, 1);
-	Do = Ci ^ qsc_intutils_rotl64(Cu, 1);
-	Du = Co ^ qsc_intutils_rotl64(Ca, 1);
+	Da = Cu ^ KECCAK_ROTL64(Ce, 1);
+	De = Ca ^ KECCAK_ROTL64(Ci, 1);
+	Di = Ce ^ KECCAK_ROTL64(Co, 1);
+	Do = Ci ^ KECCAK_ROTL64(Cu, 1);
+	Du = Co ^ KECCAK_ROTL64(Ca, 1);
 	Aba ^= Da;
 	Ca = Aba;
 	Age ^= De;
-	Ce = qsc_intutils_rotl64(Age, 44);
+	Ce = KECCAK_ROTL64(Age, 44);
 	Aki ^= Di;
-	Ci = qsc_intutils_rotl64(Aki, 43);
+	Ci = KECCAK_ROTL64(Aki, 43);
 	Amo ^= Do;
-	Co = qsc_intutils_rotl64(Amo, 21);
+	Co = KECCAK_ROTL64(Amo, 21);
 	Asu ^= Du;
-	Cu = qsc_intutils_rotl64(Asu, 14);
+	Cu = KECCAK_ROTL64(Asu, 14);
 	Eba = Ca ^ ((~Ce) & Ci);
 	Eba ^= 0x0000000080008009ULL;
 	Ebe = Ce ^ ((~Ci) & Co);
@@ -2798,60 +3425,60 @@ void qsc_keccak_permute_p1600u(uint64_t* state)
 	Ebo = Co ^ ((~Cu) & Ca);
 	Ebu = Cu ^ ((~Ca) & Ce);
 	Abo ^= Do;
-	Ca = qsc_intutils_rotl64(Abo, 28);
+	Ca = KECCAK_ROTL64(Abo, 28);
 	Agu ^= Du;
-	Ce = qsc_intutils_rotl64(Agu, 20);
+	Ce = KECCAK_ROTL64(Agu, 20);
 	Aka ^= Da;
-	Ci = qsc_intutils_rotl64(Aka, 3);
+	Ci = KECCAK_ROTL64(Aka, 3);
 	Ame ^= De;
-	Co = qsc_intutils_rotl64(Ame, 45);
+	Co = KECCAK_ROTL64(Ame, 45);
 	Asi ^= Di;
-	Cu = qsc_intutils_rotl64(Asi, 61);
+	Cu = KECCAK_ROTL64(Asi, 61);
 	Ega = Ca ^ ((~Ce) & Ci);
 	Ege = Ce ^ ((~Ci) & Co);
 	Egi = Ci ^ ((~Co) & Cu);
 	Ego = Co ^ ((~Cu) & Ca);
 	Egu = Cu ^ ((~Ca) & Ce);
 	Abe ^= De;
-	Ca = qsc_intutils_rotl64(Abe, 1);
+	Ca = KECCAK_ROTL64(Abe, 1);
 	Agi ^= Di;
-	Ce = qsc_intutils_rotl64(Agi, 6);
+	Ce = KECCAK_ROTL64(Agi, 6);
 	Ako ^= Do;
-	Ci = qsc_intutils_rotl64(Ako, 25);
+	Ci = KECCAK_ROTL64(Ako, 25);
 	Amu ^= Du;
-	Co = qsc_intutils_rotl64(Amu, 8);
+	Co = KECCAK_ROTL64(Amu, 8);
 	Asa ^= Da;
-	Cu = qsc_intutils_rotl64(Asa, 18);
+	Cu = KECCAK_ROTL64(Asa, 18);
 	Eka = Ca ^ ((~Ce) & Ci);
 	Eke = Ce ^ ((~Ci) & Co);
 	Eki = Ci ^ ((~Co) & Cu);
 	Eko = Co ^ ((~Cu) & Ca);
 	Eku = Cu ^ ((~Ca) & Ce);
 	Abu ^= Du;
-	Ca = qsc_intutils_rotl64(Abu, 27);
+	Ca = KECCAK_ROTL64(Abu, 27);
 	Aga ^= Da;
-	Ce = qsc_intutils_rotl64(Aga, 36);
+	Ce = KECCAK_ROTL64(Aga, 36);
 	Ake ^= De;
-	Ci = qsc_intutils_rotl64(Ake, 10);
+	Ci = KECCAK_ROTL64(Ake, 10);
 	Ami ^= Di;
-	Co = qsc_intutils_rotl64(Ami, 15);
+	Co = KECCAK_ROTL64(Ami, 15);
 	Aso ^= Do;
-	Cu = qsc_intutils_rotl64(Aso, 56);
+	Cu = KECCAK_ROTL64(Aso, 56);
 	Ema = Ca ^ ((~Ce) & Ci);
 	Eme = Ce ^ ((~Ci) & Co);
 	Emi = Ci ^ ((~Co) & Cu);
 	Emo = Co ^ ((~Cu) & Ca);
 	Emu = Cu ^ ((~Ca) & Ce);
 	Abi ^= Di;
-	Ca = qsc_intutils_rotl64(Abi, 62);
+	Ca = KECCAK_ROTL64(Abi, 62);
 	Ago ^= Do;
-	Ce = qsc_intutils_rotl64(Ago, 55);
+	Ce = KECCAK_ROTL64(Ago, 55);
 	Aku ^= Du;
-	Ci = qsc_intutils_rotl64(Aku, 39);
+	Ci = KECCAK_ROTL64(Aku, 39);
 	Ama ^= Da;
-	Co = qsc_intutils_rotl64(Ama, 41);
+	Co = KECCAK_ROTL64(Ama, 41);
 	Ase ^= De;
-	Cu = qsc_intutils_rotl64(Ase, 2);
+	Cu = KECCAK_ROTL64(Ase, 2);
 	Esa = Ca ^ ((~Ce) & Ci);
 	Ese = Ce ^ ((~Ci) & Co);
 	Esi = Ci ^ ((~Co) & Cu);
@@ -2863,21 +3490,21 @@ void qsc_keccak_permute_p1600u(uint64_t* state)
 	Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
 	Co = Ebo ^ Ego ^ Eko ^ Emo ^ Eso;
 	Cu = Ebu ^ Egu ^ Eku ^ Emu ^ Esu;
-	Da = Cu ^ qsc_intutils_rotl64(Ce, 1);
-	De = Ca ^ qsc_intutils_rotl64(Ci, 1);
-	Di = Ce ^ qsc_intutils_rotl64(Co, 1);
-	Do = Ci ^ qsc_intutils_rotl64(Cu, 1);
-	Du = Co ^ qsc_intutils_rotl64(Ca, 1);
+	Da = Cu ^ KECCAK_ROTL64(Ce, 1);
+	De = Ca ^ KECCAK_ROTL64(Ci, 1);
+	Di = Ce ^ KECCAK_ROTL64(Co, 1);
+	Do = Ci ^ KECCAK_ROTL64(Cu, 1);
+	Du = Co ^ KECCAK_ROTL64(Ca, 1);
 	Eba ^= Da;
 	Ca = Eba;
 	Ege ^= De;
-	Ce = qsc_intutils_rotl64(Ege, 44);
+	Ce = KECCAK_ROTL64(Ege, 44);
 	Eki ^= Di;
-	Ci = qsc_intutils_rotl64(Eki, 43);
+	Ci = KECCAK_ROTL64(Eki, 43);
 	Emo ^= Do;
-	Co = qsc_intutils_rotl64(Emo, 21);
+	Co = KECCAK_ROTL64(Emo, 21);
 	Esu ^= Du;
-	Cu = qsc_intutils_rotl64(Esu, 14);
+	Cu = KECCAK_ROTL64(Esu, 14);
 	Aba = Ca ^ ((~Ce) & Ci);
 	Aba ^= 0x000000008000000AULL;
 	Abe = Ce ^ ((~Ci) & Co);
@@ -2885,60 +3512,60 @@ void qsc_keccak_permute_p1600u(uint64_t* state)
 	Abo = Co ^ ((~Cu) & Ca);
 	Abu = Cu ^ ((~Ca) & Ce);
 	Ebo ^= Do;
-	Ca = qsc_intutils_rotl64(Ebo, 28);
+	Ca = KECCAK_ROTL64(Ebo, 28);
 	Egu ^= Du;
-	Ce = qsc_intutils_rotl64(Egu, 20);
+	Ce = KECCAK_ROTL64(Egu, 20);
 	Eka ^= Da;
-	Ci = qsc_intutils_rotl64(Eka, 3);
+	Ci = KECCAK_ROTL64(Eka, 3);
 	Eme ^= De;
-	Co = qsc_intutils_rotl64(Eme, 45);
+	Co = KECCAK_ROTL64(Eme, 45);
 	Esi ^= Di;
-	Cu = qsc_intutils_rotl64(Esi, 61);
+	Cu = KECCAK_ROTL64(Esi, 61);
 	Aga = Ca ^ ((~Ce) & Ci);
 	Age = Ce ^ ((~Ci) & Co);
 	Agi = Ci ^ ((~Co) & Cu);
 	Ago = Co ^ ((~Cu) & Ca);
 	Agu = Cu ^ ((~Ca) & Ce);
 	Ebe ^= De;
-	Ca = qsc_intutils_rotl64(Ebe, 1);
+	Ca = KECCAK_ROTL64(Ebe, 1);
 	Egi ^= Di;
-	Ce = qsc_intutils_rotl64(Egi, 6);
+	Ce = KECCAK_ROTL64(Egi, 6);
 	Eko ^= Do;
-	Ci = qsc_intutils_rotl64(Eko, 25);
+	Ci = KECCAK_ROTL64(Eko, 25);
 	Emu ^= Du;
-	Co = qsc_intutils_rotl64(Emu, 8);
+	Co = KECCAK_ROTL64(Emu, 8);
 	Esa ^= Da;
-	Cu = qsc_intutils_rotl64(Esa, 18);
+	Cu = KECCAK_ROTL64(Esa, 18);
 	Aka = Ca ^ ((~Ce) & Ci);
 	Ake = Ce ^ ((~Ci) & Co);
 	Aki = Ci ^ ((~Co) & Cu);
 	Ako = Co ^ ((~Cu) & Ca);
 	Aku = Cu ^ ((~Ca) & Ce);
 	Ebu ^= Du;
-	Ca = qsc_intutils_rotl64(Ebu, 27);
+	Ca = KECCAK_ROTL64(Ebu, 27);
 	Ega ^= Da;
-	Ce = qsc_intutils_rotl64(Ega, 36);
+	Ce = KECCAK_ROTL64(Ega, 36);
 	Eke ^= De;
-	Ci = qsc_intutils_rotl64(Eke, 10);
+	Ci = KECCAK_ROTL64(Eke, 10);
 	Emi ^= Di;
-	Co = qsc_intutils_rotl64(Emi, 15);
+	Co = KECCAK_ROTL64(Emi, 15);
 	Eso ^= Do;
-	Cu = qsc_intutils_rotl64(Eso, 56);
+	Cu = KECCAK_ROTL64(Eso, 56);
 	Ama = Ca ^ ((~Ce) & Ci);
 	Ame = Ce ^ ((~Ci) & Co);
 	Ami = Ci ^ ((~Co) & Cu);
 	Amo = Co ^ ((~Cu) & Ca);
 	Amu = Cu ^ ((~Ca) & Ce);
 	Ebi ^= Di;
-	Ca = qsc_intutils_rotl64(Ebi, 62);
+	Ca = KECCAK_ROTL64(Ebi, 62);
 	Ego ^= Do;
-	Ce = qsc_intutils_rotl64(Ego, 55);
+	Ce = KECCAK_ROTL64(Ego, 55);
 	Eku ^= Du;
-	Ci = qsc_intutils_rotl64(Eku, 39);
+	Ci = KECCAK_ROTL64(Eku, 39);
 	Ema ^= Da;
-	Co = qsc_intutils_rotl64(Ema, 41);
+	Co = KECCAK_ROTL64(Ema, 41);
 	Ese ^= De;
-	Cu = qsc_intutils_rotl64(Ese, 2);
+	Cu = KECCAK_ROTL64(Ese, 2);
 	Asa = Ca ^ ((~Ce) & Ci);
 	Ase = Ce ^ ((~Ci) & Co);
 	Asi = Ci ^ ((~Co) & Cu);
@@ -2950,21 +3577,21 @@ void qsc_keccak_permute_p1600u(uint64_t* state)
 	Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
 	Co = Abo ^ Ago ^ Ako ^ Amo ^ Aso;
 	Cu = Abu ^ Agu ^ Aku ^ Amu ^ Asu;
-	Da = Cu ^ qsc_intutils_rotl64(Ce, 1);
-	De = Ca ^ qsc_intutils_rotl64(Ci, 1);
-	Di = Ce ^ qsc_intutils_rotl64(Co, 1);
-	Do = Ci ^ qsc_intutils_rotl64(Cu, 1);
-	Du = Co ^ qsc_intutils_rotl64(Ca, 1);
+	Da = Cu ^ KECCAK_ROTL64(Ce, 1);
+	De = Ca ^ KECCAK_ROTL64(Ci, 1);
+	Di = Ce ^ KECCAK_ROTL64(Co, 1);
+	Do = Ci ^ KECCAK_ROTL64(Cu, 1);
+	Du = Co ^ KECCAK_ROTL64(Ca, 1);
 	Aba ^= Da;
 	Ca = Aba;
 	Age ^= De;
-	Ce = qsc_intutils_rotl64(Age, 44);
+	Ce = KECCAK_ROTL64(Age, 44);
 	Aki ^= Di;
-	Ci = qsc_intutils_rotl64(Aki, 43);
+	Ci = KECCAK_ROTL64(Aki, 43);
 	Amo ^= Do;
-	Co = qsc_intutils_rotl64(Amo, 21);
+	Co = KECCAK_ROTL64(Amo, 21);
 	Asu ^= Du;
-	Cu = qsc_intutils_rotl64(Asu, 14);
+	Cu = KECCAK_ROTL64(Asu, 14);
 	Eba = Ca ^ ((~Ce) & Ci);
 	Eba ^= 0x000000008000808BULL;
 	Ebe = Ce ^ ((~Ci) & Co);
@@ -2972,60 +3599,60 @@ void qsc_keccak_permute_p1600u(uint64_t* state)
 	Ebo = Co ^ ((~Cu) & Ca);
 	Ebu = Cu ^ ((~Ca) & Ce);
 	Abo ^= Do;
-	Ca = qsc_intutils_rotl64(Abo, 28);
+	Ca = KECCAK_ROTL64(Abo, 28);
 	Agu ^= Du;
-	Ce = qsc_intutils_rotl64(Agu, 20);
+	Ce = KECCAK_ROTL64(Agu, 20);
 	Aka ^= Da;
-	Ci = qsc_intutils_rotl64(Aka, 3);
+	Ci = KECCAK_ROTL64(Aka, 3);
 	Ame ^= De;
-	Co = qsc_intutils_rotl64(Ame, 45);
+	Co = KECCAK_ROTL64(Ame, 45);
 	Asi ^= Di;
-	Cu = qsc_intutils_rotl64(Asi, 61);
+	Cu = KECCAK_ROTL64(Asi, 61);
 	Ega = Ca ^ ((~Ce) & Ci);
 	Ege = Ce ^ ((~Ci) & Co);
 	Egi = Ci ^ ((~Co) & Cu);
 	Ego = Co ^ ((~Cu) & Ca);
 	Egu = Cu ^ ((~Ca) & Ce);
 	Abe ^= De;
-	Ca = qsc_intutils_rotl64(Abe, 1);
+	Ca = KECCAK_ROTL64(Abe, 1);
 	Agi ^= Di;
-	Ce = qsc_intutils_rotl64(Agi, 6);
+	Ce = KECCAK_ROTL64(Agi, 6);
 	Ako ^= Do;
-	Ci = qsc_intutils_rotl64(Ako, 25);
+	Ci = KECCAK_ROTL64(Ako, 25);
 	Amu ^= Du;
-	Co = qsc_intutils_rotl64(Amu, 8);
+	Co = KECCAK_ROTL64(Amu, 8);
 	Asa ^= Da;
-	Cu = qsc_intutils_rotl64(Asa, 18);
+	Cu = KECCAK_ROTL64(Asa, 18);
 	Eka = Ca ^ ((~Ce) & Ci);
 	Eke = Ce ^ ((~Ci) & Co);
 	Eki = Ci ^ ((~Co) & Cu);
 	Eko = Co ^ ((~Cu) & Ca);
 	Eku = Cu ^ ((~Ca) & Ce);
 	Abu ^= Du;
-	Ca = qsc_intutils_rotl64(Abu, 27);
+	Ca = KECCAK_ROTL64(Abu, 27);
 	Aga ^= Da;
-	Ce = qsc_intutils_rotl64(Aga, 36);
+	Ce = KECCAK_ROTL64(Aga, 36);
 	Ake ^= De;
-	Ci = qsc_intutils_rotl64(Ake, 10);
+	Ci = KECCAK_ROTL64(Ake, 10);
 	Ami ^= Di;
-	Co = qsc_intutils_rotl64(Ami, 15);
+	Co = KECCAK_ROTL64(Ami, 15);
 	Aso ^= Do;
-	Cu = qsc_intutils_rotl64(Aso, 56);
+	Cu = KECCAK_ROTL64(Aso, 56);
 	Ema = Ca ^ ((~Ce) & Ci);
 	Eme = Ce ^ ((~Ci) & Co);
 	Emi = Ci ^ ((~Co) & Cu);
 	Emo = Co ^ ((~Cu) & Ca);
 	Emu = Cu ^ ((~Ca) & Ce);
 	Abi ^= Di;
-	Ca = qsc_intutils_rotl64(Abi, 62);
+	Ca = KECCAK_ROTL64(Abi, 62);
 	Ago ^= Do;
-	Ce = qsc_intutils_rotl64(Ago, 55);
+	Ce = KECCAK_ROTL64(Ago, 55);
 	Aku ^= Du;
-	Ci = qsc_intutils_rotl64(Aku, 39);
+	Ci = KECCAK_ROTL64(Aku, 39);
 	Ama ^= Da;
-	Co = qsc_intutils_rotl64(Ama, 41);
+	Co = KECCAK_ROTL64(Ama, 41);
 	Ase ^= De;
-	Cu = qsc_intutils_rotl64(Ase, 2);
+	Cu = KECCAK_ROTL64(Ase, 2);
 	Esa = Ca ^ ((~Ce) & Ci);
 	Ese = Ce ^ ((~Ci) & Co);
 	Esi = Ci ^ ((~Co) & Cu);
@@ -3037,21 +3664,21 @@ void qsc_keccak_permute_p1600u(uint64_t* state)
 	Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
 	Co = Ebo ^ Ego ^ Eko ^ Emo ^ Eso;
 	Cu = Ebu ^ Egu ^ Eku ^ Emu ^ Esu;
-	Da = Cu ^ qsc_intutils_rotl64(Ce, 1);
-	De = Ca ^ qsc_intutils_rotl64(Ci, 1);
-	Di = Ce ^ qsc_intutils_rotl64(Co, 1);
-	Do = Ci ^ qsc_intutils_rotl64(Cu, 1);
-	Du = Co ^ qsc_intutils_rotl64(Ca, 1);
+	Da = Cu ^ KECCAK_ROTL64(Ce, 1);
+	De = Ca ^ KECCAK_ROTL64(Ci, 1);
+	Di = Ce ^ KECCAK_ROTL64(Co, 1);
+	Do = Ci ^ KECCAK_ROTL64(Cu, 1);
+	Du = Co ^ KECCAK_ROTL64(Ca, 1);
 	Eba ^= Da;
 	Ca = Eba;
 	Ege ^= De;
-	Ce = qsc_intutils_rotl64(Ege, 44);
+	Ce = KECCAK_ROTL64(Ege, 44);
 	Eki ^= Di;
-	Ci = qsc_intutils_rotl64(Eki, 43);
+	Ci = KECCAK_ROTL64(Eki, 43);
 	Emo ^= Do;
-	Co = qsc_intutils_rotl64(Emo, 21);
+	Co = KECCAK_ROTL64(Emo, 21);
 	Esu ^= Du;
-	Cu = qsc_intutils_rotl64(Esu, 14);
+	Cu = KECCAK_ROTL64(Esu, 14);
 	Aba = Ca ^ ((~Ce) & Ci);
 	Aba ^= 0x800000000000008BULL;
 	Abe = Ce ^ ((~Ci) & Co);
@@ -3059,60 +3686,60 @@ void qsc_keccak_permute_p1600u(uint64_t* state)
 	Abo = Co ^ ((~Cu) & Ca);
 	Abu = Cu ^ ((~Ca) & Ce);
 	Ebo ^= Do;
-	Ca = qsc_intutils_rotl64(Ebo, 28);
+	Ca = KECCAK_ROTL64(Ebo, 28);
 	Egu ^= Du;
-	Ce = qsc_intutils_rotl64(Egu, 20);
+	Ce = KECCAK_ROTL64(Egu, 20);
 	Eka ^= Da;
-	Ci = qsc_intutils_rotl64(Eka, 3);
+	Ci = KECCAK_ROTL64(Eka, 3);
 	Eme ^= De;
-	Co = qsc_intutils_rotl64(Eme, 45);
+	Co = KECCAK_ROTL64(Eme, 45);
 	Esi ^= Di;
-	Cu = qsc_intutils_rotl64(Esi, 61);
+	Cu = KECCAK_ROTL64(Esi, 61);
 	Aga = Ca ^ ((~Ce) & Ci);
 	Age = Ce ^ ((~Ci) & Co);
 	Agi = Ci ^ ((~Co) & Cu);
 	Ago = Co ^ ((~Cu) & Ca);
 	Agu = Cu ^ ((~Ca) & Ce);
 	Ebe ^= De;
-	Ca = qsc_intutils_rotl64(Ebe, 1);
+	Ca = KECCAK_ROTL64(Ebe, 1);
 	Egi ^= Di;
-	Ce = qsc_intutils_rotl64(Egi, 6);
+	Ce = KECCAK_ROTL64(Egi, 6);
 	Eko ^= Do;
-	Ci = qsc_intutils_rotl64(Eko, 25);
+	Ci = KECCAK_ROTL64(Eko, 25);
 	Emu ^= Du;
-	Co = qsc_intutils_rotl64(Emu, 8);
+	Co = KECCAK_ROTL64(Emu, 8);
 	Esa ^= Da;
-	Cu = qsc_intutils_rotl64(Esa, 18);
+	Cu = KECCAK_ROTL64(Esa, 18);
 	Aka = Ca ^ ((~Ce) & Ci);
 	Ake = Ce ^ ((~Ci) & Co);
 	Aki = Ci ^ ((~Co) & Cu);
 	Ako = Co ^ ((~Cu) & Ca);
 	Aku = Cu ^ ((~Ca) & Ce);
 	Ebu ^= Du;
-	Ca = qsc_intutils_rotl64(Ebu, 27);
+	Ca = KECCAK_ROTL64(Ebu, 27);
 	Ega ^= Da;
-	Ce = qsc_intutils_rotl64(Ega, 36);
+	Ce = KECCAK_ROTL64(Ega, 36);
 	Eke ^= De;
-	Ci = qsc_intutils_rotl64(Eke, 10);
+	Ci = KECCAK_ROTL64(Eke, 10);
 	Emi ^= Di;
-	Co = qsc_intutils_rotl64(Emi, 15);
+	Co = KECCAK_ROTL64(Emi, 15);
 	Eso ^= Do;
-	Cu = qsc_intutils_rotl64(Eso, 56);
+	Cu = KECCAK_ROTL64(Eso, 56);
 	Ama = Ca ^ ((~Ce) & Ci);
 	Ame = Ce ^ ((~Ci) & Co);
 	Ami = Ci ^ ((~Co) & Cu);
 	Amo = Co ^ ((~Cu) & Ca);
 	Amu = Cu ^ ((~Ca) & Ce);
 	Ebi ^= Di;
-	Ca = qsc_intutils_rotl64(Ebi, 62);
+	Ca = KECCAK_ROTL64(Ebi, 62);
 	Ego ^= Do;
-	Ce = qsc_intutils_rotl64(Ego, 55);
+	Ce = KECCAK_ROTL64(Ego, 55);
 	Eku ^= Du;
-	Ci = qsc_intutils_rotl64(Eku, 39);
+	Ci = KECCAK_ROTL64(Eku, 39);
 	Ema ^= Da;
-	Co = qsc_intutils_rotl64(Ema, 41);
+	Co = KECCAK_ROTL64(Ema, 41);
 	Ese ^= De;
-	Cu = qsc_intutils_rotl64(Ese, 2);
+	Cu = KECCAK_ROTL64(Ese, 2);
 	Asa = Ca ^ ((~Ce) & Ci);
 	Ase = Ce ^ ((~Ci) & Co);
 	Asi = Ci ^ ((~Co) & Cu);
@@ -3124,21 +3751,21 @@ void qsc_keccak_permute_p1600u(uint64_t* state)
 	Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
 	Co = Abo ^ Ago ^ Ako ^ Amo ^ Aso;
 	Cu = Abu ^ Agu ^ Aku ^ Amu ^ Asu;
-	Da = Cu ^ qsc_intutils_rotl64(Ce, 1);
-	De = Ca ^ qsc_intutils_rotl64(Ci, 1);
-	Di = Ce ^ qsc_intutils_rotl64(Co, 1);
-	Do = Ci ^ qsc_intutils_rotl64(Cu, 1);
-	Du = Co ^ qsc_intutils_rotl64(Ca, 1);
+	Da = Cu ^ KECCAK_ROTL64(Ce, 1);
+	De = Ca ^ KECCAK_ROTL64(Ci, 1);
+	Di = Ce ^ KECCAK_ROTL64(Co, 1);
+	Do = Ci ^ KECCAK_ROTL64(Cu, 1);
+	Du = Co ^ KECCAK_ROTL64(Ca, 1);
 	Aba ^= Da;
 	Ca = Aba;
 	Age ^= De;
-	Ce = qsc_intutils_rotl64(Age, 44);
+	Ce = KECCAK_ROTL64(Age, 44);
 	Aki ^= Di;
-	Ci = qsc_intutils_rotl64(Aki, 43);
+	Ci = KECCAK_ROTL64(Aki, 43);
 	Amo ^= Do;
-	Co = qsc_intutils_rotl64(Amo, 21);
+	Co = KECCAK_ROTL64(Amo, 21);
 	Asu ^= Du;
-	Cu = qsc_intutils_rotl64(Asu, 14);
+	Cu = KECCAK_ROTL64(Asu, 14);
 	Eba = Ca ^ ((~Ce) & Ci);
 	Eba ^= 0x8000000000008089ULL;
 	Ebe = Ce ^ ((~Ci) & Co);
@@ -3146,60 +3773,60 @@ void qsc_keccak_permute_p1600u(uint64_t* state)
 	Ebo = Co ^ ((~Cu) & Ca);
 	Ebu = Cu ^ ((~Ca) & Ce);
 	Abo ^= Do;
-	Ca = qsc_intutils_rotl64(Abo, 28);
+	Ca = KECCAK_ROTL64(Abo, 28);
 	Agu ^= Du;
-	Ce = qsc_intutils_rotl64(Agu, 20);
+	Ce = KECCAK_ROTL64(Agu, 20);
 	Aka ^= Da;
-	Ci = qsc_intutils_rotl64(Aka, 3);
+	Ci = KECCAK_ROTL64(Aka, 3);
 	Ame ^= De;
-	Co = qsc_intutils_rotl64(Ame, 45);
+	Co = KECCAK_ROTL64(Ame, 45);
 	Asi ^= Di;
-	Cu = qsc_intutils_rotl64(Asi, 61);
+	Cu = KECCAK_ROTL64(Asi, 61);
 	Ega = Ca ^ ((~Ce) & Ci);
 	Ege = Ce ^ ((~Ci) & Co);
 	Egi = Ci ^ ((~Co) & Cu);
 	Ego = Co ^ ((~Cu) & Ca);
 	Egu = Cu ^ ((~Ca) & Ce);
 	Abe ^= De;
-	Ca = qsc_intutils_rotl64(Abe, 1);
+	Ca = KECCAK_ROTL64(Abe, 1);
 	Agi ^= Di;
-	Ce = qsc_intutils_rotl64(Agi, 6);
+	Ce = KECCAK_ROTL64(Agi, 6);
 	Ako ^= Do;
-	Ci = qsc_intutils_rotl64(Ako, 25);
+	Ci = KECCAK_ROTL64(Ako, 25);
 	Amu ^= Du;
-	Co = qsc_intutils_rotl64(Amu, 8);
+	Co = KECCAK_ROTL64(Amu, 8);
 	Asa ^= Da;
-	Cu = qsc_intutils_rotl64(Asa, 18);
+	Cu = KECCAK_ROTL64(Asa, 18);
 	Eka = Ca ^ ((~Ce) & Ci);
 	Eke = Ce ^ ((~Ci) & Co);
 	Eki = Ci ^ ((~Co) & Cu);
 	Eko = Co ^ ((~Cu) & Ca);
 	Eku = Cu ^ ((~Ca) & Ce);
 	Abu ^= Du;
-	Ca = qsc_intutils_rotl64(Abu, 27);
+	Ca = KECCAK_ROTL64(Abu, 27);
 	Aga ^= Da;
-	Ce = qsc_intutils_rotl64(Aga, 36);
+	Ce = KECCAK_ROTL64(Aga, 36);
 	Ake ^= De;
-	Ci = qsc_intutils_rotl64(Ake, 10);
+	Ci = KECCAK_ROTL64(Ake, 10);
 	Ami ^= Di;
-	Co = qsc_intutils_rotl64(Ami, 15);
+	Co = KECCAK_ROTL64(Ami, 15);
 	Aso ^= Do;
-	Cu = qsc_intutils_rotl64(Aso, 56);
+	Cu = KECCAK_ROTL64(Aso, 56);
 	Ema = Ca ^ ((~Ce) & Ci);
 	Eme = Ce ^ ((~Ci) & Co);
 	Emi = Ci ^ ((~Co) & Cu);
 	Emo = Co ^ ((~Cu) & Ca);
 	Emu = Cu ^ ((~Ca) & Ce);
 	Abi ^= Di;
-	Ca = qsc_intutils_rotl64(Abi, 62);
+	Ca = KECCAK_ROTL64(Abi, 62);
 	Ago ^= Do;
-	Ce = qsc_intutils_rotl64(Ago, 55);
+	Ce = KECCAK_ROTL64(Ago, 55);
 	Aku ^= Du;
-	Ci = qsc_intutils_rotl64(Aku, 39);
+	Ci = KECCAK_ROTL64(Aku, 39);
 	Ama ^= Da;
-	Co = qsc_intutils_rotl64(Ama, 41);
+	Co = KECCAK_ROTL64(Ama, 41);
 	Ase ^= De;
-	Cu = qsc_intutils_rotl64(Ase, 2);
+	Cu = KECCAK_ROTL64(Ase, 2);
 	Esa = Ca ^ ((~Ce) & Ci);
 	Ese = Ce ^ ((~Ci) & Co);
 	Esi = Ci ^ ((~Co) & Cu);
@@ -3211,21 +3838,21 @@ void qsc_keccak_permute_p1600u(uint64_t* state)
 	Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
 	Co = Ebo ^ Ego ^ Eko ^ Emo ^ Eso;
 	Cu = Ebu ^ Egu ^ Eku ^ Emu ^ Esu;
-	Da = Cu ^ qsc_intutils_rotl64(Ce, 1);
-	De = Ca ^ qsc_intutils_rotl64(Ci, 1);
-	Di = Ce ^ qsc_intutils_rotl64(Co, 1);
-	Do = Ci ^ qsc_intutils_rotl64(Cu, 1);
-	Du = Co ^ qsc_intutils_rotl64(Ca, 1);
+	Da = Cu ^ KECCAK_ROTL64(Ce, 1);
+	De = Ca ^ KECCAK_ROTL64(Ci, 1);
+	Di = Ce ^ KECCAK_ROTL64(Co, 1);
+	Do = Ci ^ KECCAK_ROTL64(Cu, 1);
+	Du = Co ^ KECCAK_ROTL64(Ca, 1);
 	Eba ^= Da;
 	Ca = Eba;
 	Ege ^= De;
-	Ce = qsc_intutils_rotl64(Ege, 44);
+	Ce = KECCAK_ROTL64(Ege, 44);
 	Eki ^= Di;
-	Ci = qsc_intutils_rotl64(Eki, 43);
+	Ci = KECCAK_ROTL64(Eki, 43);
 	Emo ^= Do;
-	Co = qsc_intutils_rotl64(Emo, 21);
+	Co = KECCAK_ROTL64(Emo, 21);
 	Esu ^= Du;
-	Cu = qsc_intutils_rotl64(Esu, 14);
+	Cu = KECCAK_ROTL64(Esu, 14);
 	Aba = Ca ^ ((~Ce) & Ci);
 	Aba ^= 0x8000000000008003ULL;
 	Abe = Ce ^ ((~Ci) & Co);
@@ -3233,60 +3860,60 @@ void qsc_keccak_permute_p1600u(uint64_t* state)
 	Abo = Co ^ ((~Cu) & Ca);
 	Abu = Cu ^ ((~Ca) & Ce);
 	Ebo ^= Do;
-	Ca = qsc_intutils_rotl64(Ebo, 28);
+	Ca = KECCAK_ROTL64(Ebo, 28);
 	Egu ^= Du;
-	Ce = qsc_intutils_rotl64(Egu, 20);
+	Ce = KECCAK_ROTL64(Egu, 20);
 	Eka ^= Da;
-	Ci = qsc_intutils_rotl64(Eka, 3);
+	Ci = KECCAK_ROTL64(Eka, 3);
 	Eme ^= De;
-	Co = qsc_intutils_rotl64(Eme, 45);
+	Co = KECCAK_ROTL64(Eme, 45);
 	Esi ^= Di;
-	Cu = qsc_intutils_rotl64(Esi, 61);
+	Cu = KECCAK_ROTL64(Esi, 61);
 	Aga = Ca ^ ((~Ce) & Ci);
 	Age = Ce ^ ((~Ci) & Co);
 	Agi = Ci ^ ((~Co) & Cu);
 	Ago = Co ^ ((~Cu) & Ca);
 	Agu = Cu ^ ((~Ca) & Ce);
 	Ebe ^= De;
-	Ca = qsc_intutils_rotl64(Ebe, 1);
+	Ca = KECCAK_ROTL64(Ebe, 1);
 	Egi ^= Di;
-	Ce = qsc_intutils_rotl64(Egi, 6);
+	Ce = KECCAK_ROTL64(Egi, 6);
 	Eko ^= Do;
-	Ci = qsc_intutils_rotl64(Eko, 25);
+	Ci = KECCAK_ROTL64(Eko, 25);
 	Emu ^= Du;
-	Co = qsc_intutils_rotl64(Emu, 8);
+	Co = KECCAK_ROTL64(Emu, 8);
 	Esa ^= Da;
-	Cu = qsc_intutils_rotl64(Esa, 18);
+	Cu = KECCAK_ROTL64(Esa, 18);
 	Aka = Ca ^ ((~Ce) & Ci);
 	Ake = Ce ^ ((~Ci) & Co);
 	Aki = Ci ^ ((~Co) & Cu);
 	Ako = Co ^ ((~Cu) & Ca);
 	Aku = Cu ^ ((~Ca) & Ce);
 	Ebu ^= Du;
-	Ca = qsc_intutils_rotl64(Ebu, 27);
+	Ca = KECCAK_ROTL64(Ebu, 27);
 	Ega ^= Da;
-	Ce = qsc_intutils_rotl64(Ega, 36);
+	Ce = KECCAK_ROTL64(Ega, 36);
 	Eke ^= De;
-	Ci = qsc_intutils_rotl64(Eke, 10);
+	Ci = KECCAK_ROTL64(Eke, 10);
 	Emi ^= Di;
-	Co = qsc_intutils_rotl64(Emi, 15);
+	Co = KECCAK_ROTL64(Emi, 15);
 	Eso ^= Do;
-	Cu = qsc_intutils_rotl64(Eso, 56);
+	Cu = KECCAK_ROTL64(Eso, 56);
 	Ama = Ca ^ ((~Ce) & Ci);
 	Ame = Ce ^ ((~Ci) & Co);
 	Ami = Ci ^ ((~Co) & Cu);
 	Amo = Co ^ ((~Cu) & Ca);
 	Amu = Cu ^ ((~Ca) & Ce);
 	Ebi ^= Di;
-	Ca = qsc_intutils_rotl64(Ebi, 62);
+	Ca = KECCAK_ROTL64(Ebi, 62);
 	Ego ^= Do;
-	Ce = qsc_intutils_rotl64(Ego, 55);
+	Ce = KECCAK_ROTL64(Ego, 55);
 	Eku ^= Du;
-	Ci = qsc_intutils_rotl64(Eku, 39);
+	Ci = KECCAK_ROTL64(Eku, 39);
 	Ema ^= Da;
-	Co = qsc_intutils_rotl64(Ema, 41);
+	Co = KECCAK_ROTL64(Ema, 41);
 	Ese ^= De;
-	Cu = qsc_intutils_rotl64(Ese, 2);
+	Cu = KECCAK_ROTL64(Ese, 2);
 	Asa = Ca ^ ((~Ce) & Ci);
 	Ase = Ce ^ ((~Ci) & Co);
 	Asi = Ci ^ ((~Co) & Cu);
@@ -3298,21 +3925,21 @@ void qsc_keccak_permute_p1600u(uint64_t* state)
 	Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
 	Co = Abo ^ Ago ^ Ako ^ Amo ^ Aso;
 	Cu = Abu ^ Agu ^ Aku ^ Amu ^ Asu;
-	Da = Cu ^ qsc_intutils_rotl64(Ce, 1);
-	De = Ca ^ qsc_intutils_rotl64(Ci, 1);
-	Di = Ce ^ qsc_intutils_rotl64(Co, 1);
-	Do = Ci ^ qsc_intutils_rotl64(Cu, 1);
-	Du = Co ^ qsc_intutils_rotl64(Ca, 1);
+	Da = Cu ^ KECCAK_ROTL64(Ce, 1);
+	De = Ca ^ KECCAK_ROTL64(Ci, 1);
+	Di = Ce ^ KECCAK_ROTL64(Co, 1);
+	Do = Ci ^ KECCAK_ROTL64(Cu, 1);
+	Du = Co ^ KECCAK_ROTL64(Ca, 1);
 	Aba ^= Da;
 	Ca = Aba;
 	Age ^= De;
-	Ce = qsc_intutils_rotl64(Age, 44);
+	Ce = KECCAK_ROTL64(Age, 44);
 	Aki ^= Di;
-	Ci = qsc_intutils_rotl64(Aki, 43);
+	Ci = KECCAK_ROTL64(Aki, 43);
 	Amo ^= Do;
-	Co = qsc_intutils_rotl64(Amo, 21);
+	Co = KECCAK_ROTL64(Amo, 21);
 	Asu ^= Du;
-	Cu = qsc_intutils_rotl64(Asu, 14);
+	Cu = KECCAK_ROTL64(Asu, 14);
 	Eba = Ca ^ ((~Ce) & Ci);
 	Eba ^= 0x8000000000008002ULL;
 	Ebe = Ce ^ ((~Ci) & Co);
@@ -3320,60 +3947,60 @@ void qsc_keccak_permute_p1600u(uint64_t* state)
 	Ebo = Co ^ ((~Cu) & Ca);
 	Ebu = Cu ^ ((~Ca) & Ce);
 	Abo ^= Do;
-	Ca = qsc_intutils_rotl64(Abo, 28);
+	Ca = KECCAK_ROTL64(Abo, 28);
 	Agu ^= Du;
-	Ce = qsc_intutils_rotl64(Agu, 20);
+	Ce = KECCAK_ROTL64(Agu, 20);
 	Aka ^= Da;
-	Ci = qsc_intutils_rotl64(Aka, 3);
+	Ci = KECCAK_ROTL64(Aka, 3);
 	Ame ^= De;
-	Co = qsc_intutils_rotl64(Ame, 45);
+	Co = KECCAK_ROTL64(Ame, 45);
 	Asi ^= Di;
-	Cu = qsc_intutils_rotl64(Asi, 61);
+	Cu = KECCAK_ROTL64(Asi, 61);
 	Ega = Ca ^ ((~Ce) & Ci);
 	Ege = Ce ^ ((~Ci) & Co);
 	Egi = Ci ^ ((~Co) & Cu);
 	Ego = Co ^ ((~Cu) & Ca);
 	Egu = Cu ^ ((~Ca) & Ce);
 	Abe ^= De;
-	Ca = qsc_intutils_rotl64(Abe, 1);
+	Ca = KECCAK_ROTL64(Abe, 1);
 	Agi ^= Di;
-	Ce = qsc_intutils_rotl64(Agi, 6);
+	Ce = KECCAK_ROTL64(Agi, 6);
 	Ako ^= Do;
-	Ci = qsc_intutils_rotl64(Ako, 25);
+	Ci = KECCAK_ROTL64(Ako, 25);
 	Amu ^= Du;
-	Co = qsc_intutils_rotl64(Amu, 8);
+	Co = KECCAK_ROTL64(Amu, 8);
 	Asa ^= Da;
-	Cu = qsc_intutils_rotl64(Asa, 18);
+	Cu = KECCAK_ROTL64(Asa, 18);
 	Eka = Ca ^ ((~Ce) & Ci);
 	Eke = Ce ^ ((~Ci) & Co);
 	Eki = Ci ^ ((~Co) & Cu);
 	Eko = Co ^ ((~Cu) & Ca);
 	Eku = Cu ^ ((~Ca) & Ce);
 	Abu ^= Du;
-	Ca = qsc_intutils_rotl64(Abu, 27);
+	Ca = KECCAK_ROTL64(Abu, 27);
 	Aga ^= Da;
-	Ce = qsc_intutils_rotl64(Aga, 36);
+	Ce = KECCAK_ROTL64(Aga, 36);
 	Ake ^= De;
-	Ci = qsc_intutils_rotl64(Ake, 10);
+	Ci = KECCAK_ROTL64(Ake, 10);
 	Ami ^= Di;
-	Co = qsc_intutils_rotl64(Ami, 15);
+	Co = KECCAK_ROTL64(Ami, 15);
 	Aso ^= Do;
-	Cu = qsc_intutils_rotl64(Aso, 56);
+	Cu = KECCAK_ROTL64(Aso, 56);
 	Ema = Ca ^ ((~Ce) & Ci);
 	Eme = Ce ^ ((~Ci) & Co);
 	Emi = Ci ^ ((~Co) & Cu);
 	Emo = Co ^ ((~Cu) & Ca);
 	Emu = Cu ^ ((~Ca) & Ce);
 	Abi ^= Di;
-	Ca = qsc_intutils_rotl64(Abi, 62);
+	Ca = KECCAK_ROTL64(Abi, 62);
 	Ago ^= Do;
-	Ce = qsc_intutils_rotl64(Ago, 55);
+	Ce = KECCAK_ROTL64(Ago, 55);
 	Aku ^= Du;
-	Ci = qsc_intutils_rotl64(Aku, 39);
+	Ci = KECCAK_ROTL64(Aku, 39);
 	Ama ^= Da;
-	Co = qsc_intutils_rotl64(Ama, 41);
+	Co = KECCAK_ROTL64(Ama, 41);
 	Ase ^= De;
-	Cu = qsc_intutils_rotl64(Ase, 2);
+	Cu = KECCAK_ROTL64(Ase, 2);
 	Esa = Ca ^ ((~Ce) & Ci);
 	Ese = Ce ^ ((~Ci) & Co);
 	Esi = Ci ^ ((~Co) & Cu);
@@ -3385,21 +4012,21 @@ void qsc_keccak_permute_p1600u(uint64_t* state)
 	Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
 	Co = Ebo ^ Ego ^ Eko ^ Emo ^ Eso;
 	Cu = Ebu ^ Egu ^ Eku ^ Emu ^ Esu;
-	Da = Cu ^ qsc_intutils_rotl64(Ce, 1);
-	De = Ca ^ qsc_intutils_rotl64(Ci, 1);
-	Di = Ce ^ qsc_intutils_rotl64(Co, 1);
-	Do = Ci ^ qsc_intutils_rotl64(Cu, 1);
-	Du = Co ^ qsc_intutils_rotl64(Ca, 1);
+	Da = Cu ^ KECCAK_ROTL64(Ce, 1);
+	De = Ca ^ KECCAK_ROTL64(Ci, 1);
+	Di = Ce ^ KECCAK_ROTL64(Co, 1);
+	Do = Ci ^ KECCAK_ROTL64(Cu, 1);
+	Du = Co ^ KECCAK_ROTL64(Ca, 1);
 	Eba ^= Da;
 	Ca = Eba;
 	Ege ^= De;
-	Ce = qsc_intutils_rotl64(Ege, 44);
+	Ce = KECCAK_ROTL64(Ege, 44);
 	Eki ^= Di;
-	Ci = qsc_intutils_rotl64(Eki, 43);
+	Ci = KECCAK_ROTL64(Eki, 43);
 	Emo ^= Do;
-	Co = qsc_intutils_rotl64(Emo, 21);
+	Co = KECCAK_ROTL64(Emo, 21);
 	Esu ^= Du;
-	Cu = qsc_intutils_rotl64(Esu, 14);
+	Cu = KECCAK_ROTL64(Esu, 14);
 	Aba = Ca ^ ((~Ce) & Ci);
 	Aba ^= 0x8000000000000080ULL;
 	Abe = Ce ^ ((~Ci) & Co);
@@ -3407,60 +4034,60 @@ void qsc_keccak_permute_p1600u(uint64_t* state)
 	Abo = Co ^ ((~Cu) & Ca);
 	Abu = Cu ^ ((~Ca) & Ce);
 	Ebo ^= Do;
-	Ca = qsc_intutils_rotl64(Ebo, 28);
+	Ca = KECCAK_ROTL64(Ebo, 28);
 	Egu ^= Du;
-	Ce = qsc_intutils_rotl64(Egu, 20);
+	Ce = KECCAK_ROTL64(Egu, 20);
 	Eka ^= Da;
-	Ci = qsc_intutils_rotl64(Eka, 3);
+	Ci = KECCAK_ROTL64(Eka, 3);
 	Eme ^= De;
-	Co = qsc_intutils_rotl64(Eme, 45);
+	Co = KECCAK_ROTL64(Eme, 45);
 	Esi ^= Di;
-	Cu = qsc_intutils_rotl64(Esi, 61);
+	Cu = KECCAK_ROTL64(Esi, 61);
 	Aga = Ca ^ ((~Ce) & Ci);
 	Age = Ce ^ ((~Ci) & Co);
 	Agi = Ci ^ ((~Co) & Cu);
 	Ago = Co ^ ((~Cu) & Ca);
 	Agu = Cu ^ ((~Ca) & Ce);
 	Ebe ^= De;
-	Ca = qsc_intutils_rotl64(Ebe, 1);
+	Ca = KECCAK_ROTL64(Ebe, 1);
 	Egi ^= Di;
-	Ce = qsc_intutils_rotl64(Egi, 6);
+	Ce = KECCAK_ROTL64(Egi, 6);
 	Eko ^= Do;
-	Ci = qsc_intutils_rotl64(Eko, 25);
+	Ci = KECCAK_ROTL64(Eko, 25);
 	Emu ^= Du;
-	Co = qsc_intutils_rotl64(Emu, 8);
+	Co = KECCAK_ROTL64(Emu, 8);
 	Esa ^= Da;
-	Cu = qsc_intutils_rotl64(Esa, 18);
+	Cu = KECCAK_ROTL64(Esa, 18);
 	Aka = Ca ^ ((~Ce) & Ci);
 	Ake = Ce ^ ((~Ci) & Co);
 	Aki = Ci ^ ((~Co) & Cu);
 	Ako = Co ^ ((~Cu) & Ca);
 	Aku = Cu ^ ((~Ca) & Ce);
 	Ebu ^= Du;
-	Ca = qsc_intutils_rotl64(Ebu, 27);
+	Ca = KECCAK_ROTL64(Ebu, 27);
 	Ega ^= Da;
-	Ce = qsc_intutils_rotl64(Ega, 36);
+	Ce = KECCAK_ROTL64(Ega, 36);
 	Eke ^= De;
-	Ci = qsc_intutils_rotl64(Eke, 10);
+	Ci = KECCAK_ROTL64(Eke, 10);
 	Emi ^= Di;
-	Co = qsc_intutils_rotl64(Emi, 15);
+	Co = KECCAK_ROTL64(Emi, 15);
 	Eso ^= Do;
-	Cu = qsc_intutils_rotl64(Eso, 56);
+	Cu = KECCAK_ROTL64(Eso, 56);
 	Ama = Ca ^ ((~Ce) & Ci);
 	Ame = Ce ^ ((~Ci) & Co);
 	Ami = Ci ^ ((~Co) & Cu);
 	Amo = Co ^ ((~Cu) & Ca);
 	Amu = Cu ^ ((~Ca) & Ce);
 	Ebi ^= Di;
-	Ca = qsc_intutils_rotl64(Ebi, 62);
+	Ca = KECCAK_ROTL64(Ebi, 62);
 	Ego ^= Do;
-	Ce = qsc_intutils_rotl64(Ego, 55);
+	Ce = KECCAK_ROTL64(Ego, 55);
 	Eku ^= Du;
-	Ci = qsc_intutils_rotl64(Eku, 39);
+	Ci = KECCAK_ROTL64(Eku, 39);
 	Ema ^= Da;
-	Co = qsc_intutils_rotl64(Ema, 41);
+	Co = KECCAK_ROTL64(Ema, 41);
 	Ese ^= De;
-	Cu = qsc_intutils_rotl64(Ese, 2);
+	Cu = KECCAK_ROTL64(Ese, 2);
 	Asa = Ca ^ ((~Ce) & Ci);
 	Ase = Ce ^ ((~Ci) & Co);
 	Asi = Ci ^ ((~Co) & Cu);
@@ -3472,21 +4099,21 @@ void qsc_keccak_permute_p1600u(uint64_t* state)
 	Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
 	Co = Abo ^ Ago ^ Ako ^ Amo ^ Aso;
 	Cu = Abu ^ Agu ^ Aku ^ Amu ^ Asu;
-	Da = Cu ^ qsc_intutils_rotl64(Ce, 1);
-	De = Ca ^ qsc_intutils_rotl64(Ci, 1);
-	Di = Ce ^ qsc_intutils_rotl64(Co, 1);
-	Do = Ci ^ qsc_intutils_rotl64(Cu, 1);
-	Du = Co ^ qsc_intutils_rotl64(Ca, 1);
+	Da = Cu ^ KECCAK_ROTL64(Ce, 1);
+	De = Ca ^ KECCAK_ROTL64(Ci, 1);
+	Di = Ce ^ KECCAK_ROTL64(Co, 1);
+	Do = Ci ^ KECCAK_ROTL64(Cu, 1);
+	Du = Co ^ KECCAK_ROTL64(Ca, 1);
 	Aba ^= Da;
 	Ca = Aba;
 	Age ^= De;
-	Ce = qsc_intutils_rotl64(Age, 44);
+	Ce = KECCAK_ROTL64(Age, 44);
 	Aki ^= Di;
-	Ci = qsc_intutils_rotl64(Aki, 43);
+	Ci = KECCAK_ROTL64(Aki, 43);
 	Amo ^= Do;
-	Co = qsc_intutils_rotl64(Amo, 21);
+	Co = KECCAK_ROTL64(Amo, 21);
 	Asu ^= Du;
-	Cu = qsc_intutils_rotl64(Asu, 14);
+	Cu = KECCAK_ROTL64(Asu, 14);
 	Eba = Ca ^ ((~Ce) & Ci);
 	Eba ^= 0x000000000000800AULL;
 	Ebe = Ce ^ ((~Ci) & Co);
@@ -3494,60 +4121,60 @@ void qsc_keccak_permute_p1600u(uint64_t* state)
 	Ebo = Co ^ ((~Cu) & Ca);
 	Ebu = Cu ^ ((~Ca) & Ce);
 	Abo ^= Do;
-	Ca = qsc_intutils_rotl64(Abo, 28);
+	Ca = KECCAK_ROTL64(Abo, 28);
 	Agu ^= Du;
-	Ce = qsc_intutils_rotl64(Agu, 20);
+	Ce = KECCAK_ROTL64(Agu, 20);
 	Aka ^= Da;
-	Ci = qsc_intutils_rotl64(Aka, 3);
+	Ci = KECCAK_ROTL64(Aka, 3);
 	Ame ^= De;
-	Co = qsc_intutils_rotl64(Ame, 45);
+	Co = KECCAK_ROTL64(Ame, 45);
 	Asi ^= Di;
-	Cu = qsc_intutils_rotl64(Asi, 61);
+	Cu = KECCAK_ROTL64(Asi, 61);
 	Ega = Ca ^ ((~Ce) & Ci);
 	Ege = Ce ^ ((~Ci) & Co);
 	Egi = Ci ^ ((~Co) & Cu);
 	Ego = Co ^ ((~Cu) & Ca);
 	Egu = Cu ^ ((~Ca) & Ce);
 	Abe ^= De;
-	Ca = qsc_intutils_rotl64(Abe, 1);
+	Ca = KECCAK_ROTL64(Abe, 1);
 	Agi ^= Di;
-	Ce = qsc_intutils_rotl64(Agi, 6);
+	Ce = KECCAK_ROTL64(Agi, 6);
 	Ako ^= Do;
-	Ci = qsc_intutils_rotl64(Ako, 25);
+	Ci = KECCAK_ROTL64(Ako, 25);
 	Amu ^= Du;
-	Co = qsc_intutils_rotl64(Amu, 8);
+	Co = KECCAK_ROTL64(Amu, 8);
 	Asa ^= Da;
-	Cu = qsc_intutils_rotl64(Asa, 18);
+	Cu = KECCAK_ROTL64(Asa, 18);
 	Eka = Ca ^ ((~Ce) & Ci);
 	Eke = Ce ^ ((~Ci) & Co);
 	Eki = Ci ^ ((~Co) & Cu);
 	Eko = Co ^ ((~Cu) & Ca);
 	Eku = Cu ^ ((~Ca) & Ce);
 	Abu ^= Du;
-	Ca = qsc_intutils_rotl64(Abu, 27);
+	Ca = KECCAK_ROTL64(Abu, 27);
 	Aga ^= Da;
-	Ce = qsc_intutils_rotl64(Aga, 36);
+	Ce = KECCAK_ROTL64(Aga, 36);
 	Ake ^= De;
-	Ci = qsc_intutils_rotl64(Ake, 10);
+	Ci = KECCAK_ROTL64(Ake, 10);
 	Ami ^= Di;
-	Co = qsc_intutils_rotl64(Ami, 15);
+	Co = KECCAK_ROTL64(Ami, 15);
 	Aso ^= Do;
-	Cu = qsc_intutils_rotl64(Aso, 56);
+	Cu = KECCAK_ROTL64(Aso, 56);
 	Ema = Ca ^ ((~Ce) & Ci);
 	Eme = Ce ^ ((~Ci) & Co);
 	Emi = Ci ^ ((~Co) & Cu);
 	Emo = Co ^ ((~Cu) & Ca);
 	Emu = Cu ^ ((~Ca) & Ce);
 	Abi ^= Di;
-	Ca = qsc_intutils_rotl64(Abi, 62);
+	Ca = KECCAK_ROTL64(Abi, 62);
 	Ago ^= Do;
-	Ce = qsc_intutils_rotl64(Ago, 55);
+	Ce = KECCAK_ROTL64(Ago, 55);
 	Aku ^= Du;
-	Ci = qsc_intutils_rotl64(Aku, 39);
+	Ci = KECCAK_ROTL64(Aku, 39);
 	Ama ^= Da;
-	Co = qsc_intutils_rotl64(Ama, 41);
+	Co = KECCAK_ROTL64(Ama, 41);
 	Ase ^= De;
-	Cu = qsc_intutils_rotl64(Ase, 2);
+	Cu = KECCAK_ROTL64(Ase, 2);
 	Esa = Ca ^ ((~Ce) & Ci);
 	Ese = Ce ^ ((~Ci) & Co);
 	Esi = Ci ^ ((~Co) & Cu);
@@ -3559,21 +4186,21 @@ void qsc_keccak_permute_p1600u(uint64_t* state)
 	Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
 	Co = Ebo ^ Ego ^ Eko ^ Emo ^ Eso;
 	Cu = Ebu ^ Egu ^ Eku ^ Emu ^ Esu;
-	Da = Cu ^ qsc_intutils_rotl64(Ce, 1);
-	De = Ca ^ qsc_intutils_rotl64(Ci, 1);
-	Di = Ce ^ qsc_intutils_rotl64(Co, 1);
-	Do = Ci ^ qsc_intutils_rotl64(Cu, 1);
-	Du = Co ^ qsc_intutils_rotl64(Ca, 1);
+	Da = Cu ^ KECCAK_ROTL64(Ce, 1);
+	De = Ca ^ KECCAK_ROTL64(Ci, 1);
+	Di = Ce ^ KECCAK_ROTL64(Co, 1);
+	Do = Ci ^ KECCAK_ROTL64(Cu, 1);
+	Du = Co ^ KECCAK_ROTL64(Ca, 1);
 	Eba ^= Da;
 	Ca = Eba;
 	Ege ^= De;
-	Ce = qsc_intutils_rotl64(Ege, 44);
+	Ce = KECCAK_ROTL64(Ege, 44);
 	Eki ^= Di;
-	Ci = qsc_intutils_rotl64(Eki, 43);
+	Ci = KECCAK_ROTL64(Eki, 43);
 	Emo ^= Do;
-	Co = qsc_intutils_rotl64(Emo, 21);
+	Co = KECCAK_ROTL64(Emo, 21);
 	Esu ^= Du;
-	Cu = qsc_intutils_rotl64(Esu, 14);
+	Cu = KECCAK_ROTL64(Esu, 14);
 	Aba = Ca ^ ((~Ce) & Ci);
 	Aba ^= 0x800000008000000AULL;
 	Abe = Ce ^ ((~Ci) & Co);
@@ -3581,60 +4208,60 @@ void qsc_keccak_permute_p1600u(uint64_t* state)
 	Abo = Co ^ ((~Cu) & Ca);
 	Abu = Cu ^ ((~Ca) & Ce);
 	Ebo ^= Do;
-	Ca = qsc_intutils_rotl64(Ebo, 28);
+	Ca = KECCAK_ROTL64(Ebo, 28);
 	Egu ^= Du;
-	Ce = qsc_intutils_rotl64(Egu, 20);
+	Ce = KECCAK_ROTL64(Egu, 20);
 	Eka ^= Da;
-	Ci = qsc_intutils_rotl64(Eka, 3);
+	Ci = KECCAK_ROTL64(Eka, 3);
 	Eme ^= De;
-	Co = qsc_intutils_rotl64(Eme, 45);
+	Co = KECCAK_ROTL64(Eme, 45);
 	Esi ^= Di;
-	Cu = qsc_intutils_rotl64(Esi, 61);
+	Cu = KECCAK_ROTL64(Esi, 61);
 	Aga = Ca ^ ((~Ce) & Ci);
 	Age = Ce ^ ((~Ci) & Co);
 	Agi = Ci ^ ((~Co) & Cu);
 	Ago = Co ^ ((~Cu) & Ca);
 	Agu = Cu ^ ((~Ca) & Ce);
 	Ebe ^= De;
-	Ca = qsc_intutils_rotl64(Ebe, 1);
+	Ca = KECCAK_ROTL64(Ebe, 1);
 	Egi ^= Di;
-	Ce = qsc_intutils_rotl64(Egi, 6);
+	Ce = KECCAK_ROTL64(Egi, 6);
 	Eko ^= Do;
-	Ci = qsc_intutils_rotl64(Eko, 25);
+	Ci = KECCAK_ROTL64(Eko, 25);
 	Emu ^= Du;
-	Co = qsc_intutils_rotl64(Emu, 8);
+	Co = KECCAK_ROTL64(Emu, 8);
 	Esa ^= Da;
-	Cu = qsc_intutils_rotl64(Esa, 18);
+	Cu = KECCAK_ROTL64(Esa, 18);
 	Aka = Ca ^ ((~Ce) & Ci);
 	Ake = Ce ^ ((~Ci) & Co);
 	Aki = Ci ^ ((~Co) & Cu);
 	Ako = Co ^ ((~Cu) & Ca);
 	Aku = Cu ^ ((~Ca) & Ce);
 	Ebu ^= Du;
-	Ca = qsc_intutils_rotl64(Ebu, 27);
+	Ca = KECCAK_ROTL64(Ebu, 27);
 	Ega ^= Da;
-	Ce = qsc_intutils_rotl64(Ega, 36);
+	Ce = KECCAK_ROTL64(Ega, 36);
 	Eke ^= De;
-	Ci = qsc_intutils_rotl64(Eke, 10);
+	Ci = KECCAK_ROTL64(Eke, 10);
 	Emi ^= Di;
-	Co = qsc_intutils_rotl64(Emi, 15);
+	Co = KECCAK_ROTL64(Emi, 15);
 	Eso ^= Do;
-	Cu = qsc_intutils_rotl64(Eso, 56);
+	Cu = KECCAK_ROTL64(Eso, 56);
 	Ama = Ca ^ ((~Ce) & Ci);
 	Ame = Ce ^ ((~Ci) & Co);
 	Ami = Ci ^ ((~Co) & Cu);
 	Amo = Co ^ ((~Cu) & Ca);
 	Amu = Cu ^ ((~Ca) & Ce);
 	Ebi ^= Di;
-	Ca = qsc_intutils_rotl64(Ebi, 62);
+	Ca = KECCAK_ROTL64(Ebi, 62);
 	Ego ^= Do;
-	Ce = qsc_intutils_rotl64(Ego, 55);
+	Ce = KECCAK_ROTL64(Ego, 55);
 	Eku ^= Du;
-	Ci = qsc_intutils_rotl64(Eku, 39);
+	Ci = KECCAK_ROTL64(Eku, 39);
 	Ema ^= Da;
-	Co = qsc_intutils_rotl64(Ema, 41);
+	Co = KECCAK_ROTL64(Ema, 41);
 	Ese ^= De;
-	Cu = qsc_intutils_rotl64(Ese, 2);
+	Cu = KECCAK_ROTL64(Ese, 2);
 	Asa = Ca ^ ((~Ce) & Ci);
 	Ase = Ce ^ ((~Ci) & Co);
 	Asi = Ci ^ ((~Co) & Cu);
@@ -3646,21 +4273,21 @@ void qsc_keccak_permute_p1600u(uint64_t* state)
 	Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
 	Co = Abo ^ Ago ^ Ako ^ Amo ^ Aso;
 	Cu = Abu ^ Agu ^ Aku ^ Amu ^ Asu;
-	Da = Cu ^ qsc_intutils_rotl64(Ce, 1);
-	De = Ca ^ qsc_intutils_rotl64(Ci, 1);
-	Di = Ce ^ qsc_intutils_rotl64(Co, 1);
-	Do = Ci ^ qsc_intutils_rotl64(Cu, 1);
-	Du = Co ^ qsc_intutils_rotl64(Ca, 1);
+	Da = Cu ^ KECCAK_ROTL64(Ce, 1);
+	De = Ca ^ KECCAK_ROTL64(Ci, 1);
+	Di = Ce ^ KECCAK_ROTL64(Co, 1);
+	Do = Ci ^ KECCAK_ROTL64(Cu, 1);
+	Du = Co ^ KECCAK_ROTL64(Ca, 1);
 	Aba ^= Da;
 	Ca = Aba;
 	Age ^= De;
-	Ce = qsc_intutils_rotl64(Age, 44);
+	Ce = KECCAK_ROTL64(Age, 44);
 	Aki ^= Di;
-	Ci = qsc_intutils_rotl64(Aki, 43);
+	Ci = KECCAK_ROTL64(Aki, 43);
 	Amo ^= Do;
-	Co = qsc_intutils_rotl64(Amo, 21);
+	Co = KECCAK_ROTL64(Amo, 21);
 	Asu ^= Du;
-	Cu = qsc_intutils_rotl64(Asu, 14);
+	Cu = KECCAK_ROTL64(Asu, 14);
 	Eba = Ca ^ ((~Ce) & Ci);
 	Eba ^= 0x8000000080008081ULL;
 	Ebe = Ce ^ ((~Ci) & Co);
@@ -3668,60 +4295,60 @@ void qsc_keccak_permute_p1600u(uint64_t* state)
 	Ebo = Co ^ ((~Cu) & Ca);
 	Ebu = Cu ^ ((~Ca) & Ce);
 	Abo ^= Do;
-	Ca = qsc_intutils_rotl64(Abo, 28);
+	Ca = KECCAK_ROTL64(Abo, 28);
 	Agu ^= Du;
-	Ce = qsc_intutils_rotl64(Agu, 20);
+	Ce = KECCAK_ROTL64(Agu, 20);
 	Aka ^= Da;
-	Ci = qsc_intutils_rotl64(Aka, 3);
+	Ci = KECCAK_ROTL64(Aka, 3);
 	Ame ^= De;
-	Co = qsc_intutils_rotl64(Ame, 45);
+	Co = KECCAK_ROTL64(Ame, 45);
 	Asi ^= Di;
-	Cu = qsc_intutils_rotl64(Asi, 61);
+	Cu = KECCAK_ROTL64(Asi, 61);
 	Ega = Ca ^ ((~Ce) & Ci);
 	Ege = Ce ^ ((~Ci) & Co);
 	Egi = Ci ^ ((~Co) & Cu);
 	Ego = Co ^ ((~Cu) & Ca);
 	Egu = Cu ^ ((~Ca) & Ce);
 	Abe ^= De;
-	Ca = qsc_intutils_rotl64(Abe, 1);
+	Ca = KECCAK_ROTL64(Abe, 1);
 	Agi ^= Di;
-	Ce = qsc_intutils_rotl64(Agi, 6);
+	Ce = KECCAK_ROTL64(Agi, 6);
 	Ako ^= Do;
-	Ci = qsc_intutils_rotl64(Ako, 25);
+	Ci = KECCAK_ROTL64(Ako, 25);
 	Amu ^= Du;
-	Co = qsc_intutils_rotl64(Amu, 8);
+	Co = KECCAK_ROTL64(Amu, 8);
 	Asa ^= Da;
-	Cu = qsc_intutils_rotl64(Asa, 18);
+	Cu = KECCAK_ROTL64(Asa, 18);
 	Eka = Ca ^ ((~Ce) & Ci);
 	Eke = Ce ^ ((~Ci) & Co);
 	Eki = Ci ^ ((~Co) & Cu);
 	Eko = Co ^ ((~Cu) & Ca);
 	Eku = Cu ^ ((~Ca) & Ce);
 	Abu ^= Du;
-	Ca = qsc_intutils_rotl64(Abu, 27);
+	Ca = KECCAK_ROTL64(Abu, 27);
 	Aga ^= Da;
-	Ce = qsc_intutils_rotl64(Aga, 36);
+	Ce = KECCAK_ROTL64(Aga, 36);
 	Ake ^= De;
-	Ci = qsc_intutils_rotl64(Ake, 10);
+	Ci = KECCAK_ROTL64(Ake, 10);
 	Ami ^= Di;
-	Co = qsc_intutils_rotl64(Ami, 15);
+	Co = KECCAK_ROTL64(Ami, 15);
 	Aso ^= Do;
-	Cu = qsc_intutils_rotl64(Aso, 56);
+	Cu = KECCAK_ROTL64(Aso, 56);
 	Ema = Ca ^ ((~Ce) & Ci);
 	Eme = Ce ^ ((~Ci) & Co);
 	Emi = Ci ^ ((~Co) & Cu);
 	Emo = Co ^ ((~Cu) & Ca);
 	Emu = Cu ^ ((~Ca) & Ce);
 	Abi ^= Di;
-	Ca = qsc_intutils_rotl64(Abi, 62);
+	Ca = KECCAK_ROTL64(Abi, 62);
 	Ago ^= Do;
-	Ce = qsc_intutils_rotl64(Ago, 55);
+	Ce = KECCAK_ROTL64(Ago, 55);
 	Aku ^= Du;
-	Ci = qsc_intutils_rotl64(Aku, 39);
+	Ci = KECCAK_ROTL64(Aku, 39);
 	Ama ^= Da;
-	Co = qsc_intutils_rotl64(Ama, 41);
+	Co = KECCAK_ROTL64(Ama, 41);
 	Ase ^= De;
-	Cu = qsc_intutils_rotl64(Ase, 2);
+	Cu = KECCAK_ROTL64(Ase, 2);
 	Esa = Ca ^ ((~Ce) & Ci);
 	Ese = Ce ^ ((~Ci) & Co);
 	Esi = Ci ^ ((~Co) & Cu);
@@ -3733,21 +4360,21 @@ void qsc_keccak_permute_p1600u(uint64_t* state)
 	Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
 	Co = Ebo ^ Ego ^ Eko ^ Emo ^ Eso;
 	Cu = Ebu ^ Egu ^ Eku ^ Emu ^ Esu;
-	Da = Cu ^ qsc_intutils_rotl64(Ce, 1);
-	De = Ca ^ qsc_intutils_rotl64(Ci, 1);
-	Di = Ce ^ qsc_intutils_rotl64(Co, 1);
-	Do = Ci ^ qsc_intutils_rotl64(Cu, 1);
-	Du = Co ^ qsc_intutils_rotl64(Ca, 1);
+	Da = Cu ^ KECCAK_ROTL64(Ce, 1);
+	De = Ca ^ KECCAK_ROTL64(Ci, 1);
+	Di = Ce ^ KECCAK_ROTL64(Co, 1);
+	Do = Ci ^ KECCAK_ROTL64(Cu, 1);
+	Du = Co ^ KECCAK_ROTL64(Ca, 1);
 	Eba ^= Da;
 	Ca = Eba;
 	Ege ^= De;
-	Ce = qsc_intutils_rotl64(Ege, 44);
+	Ce = KECCAK_ROTL64(Ege, 44);
 	Eki ^= Di;
-	Ci = qsc_intutils_rotl64(Eki, 43);
+	Ci = KECCAK_ROTL64(Eki, 43);
 	Emo ^= Do;
-	Co = qsc_intutils_rotl64(Emo, 21);
+	Co = KECCAK_ROTL64(Emo, 21);
 	Esu ^= Du;
-	Cu = qsc_intutils_rotl64(Esu, 14);
+	Cu = KECCAK_ROTL64(Esu, 14);
 	Aba = Ca ^ ((~Ce) & Ci);
 	Aba ^= 0x8000000000008080ULL;
 	Abe = Ce ^ ((~Ci) & Co);
@@ -3755,60 +4382,60 @@ void qsc_keccak_permute_p1600u(uint64_t* state)
 	Abo = Co ^ ((~Cu) & Ca);
 	Abu = Cu ^ ((~Ca) & Ce);
 	Ebo ^= Do;
-	Ca = qsc_intutils_rotl64(Ebo, 28);
+	Ca = KECCAK_ROTL64(Ebo, 28);
 	Egu ^= Du;
-	Ce = qsc_intutils_rotl64(Egu, 20);
+	Ce = KECCAK_ROTL64(Egu, 20);
 	Eka ^= Da;
-	Ci = qsc_intutils_rotl64(Eka, 3);
+	Ci = KECCAK_ROTL64(Eka, 3);
 	Eme ^= De;
-	Co = qsc_intutils_rotl64(Eme, 45);
+	Co = KECCAK_ROTL64(Eme, 45);
 	Esi ^= Di;
-	Cu = qsc_intutils_rotl64(Esi, 61);
+	Cu = KECCAK_ROTL64(Esi, 61);
 	Aga = Ca ^ ((~Ce) & Ci);
 	Age = Ce ^ ((~Ci) & Co);
 	Agi = Ci ^ ((~Co) & Cu);
 	Ago = Co ^ ((~Cu) & Ca);
 	Agu = Cu ^ ((~Ca) & Ce);
 	Ebe ^= De;
-	Ca = qsc_intutils_rotl64(Ebe, 1);
+	Ca = KECCAK_ROTL64(Ebe, 1);
 	Egi ^= Di;
-	Ce = qsc_intutils_rotl64(Egi, 6);
+	Ce = KECCAK_ROTL64(Egi, 6);
 	Eko ^= Do;
-	Ci = qsc_intutils_rotl64(Eko, 25);
+	Ci = KECCAK_ROTL64(Eko, 25);
 	Emu ^= Du;
-	Co = qsc_intutils_rotl64(Emu, 8);
+	Co = KECCAK_ROTL64(Emu, 8);
 	Esa ^= Da;
-	Cu = qsc_intutils_rotl64(Esa, 18);
+	Cu = KECCAK_ROTL64(Esa, 18);
 	Aka = Ca ^ ((~Ce) & Ci);
 	Ake = Ce ^ ((~Ci) & Co);
 	Aki = Ci ^ ((~Co) & Cu);
 	Ako = Co ^ ((~Cu) & Ca);
 	Aku = Cu ^ ((~Ca) & Ce);
 	Ebu ^= Du;
-	Ca = qsc_intutils_rotl64(Ebu, 27);
+	Ca = KECCAK_ROTL64(Ebu, 27);
 	Ega ^= Da;
-	Ce = qsc_intutils_rotl64(Ega, 36);
+	Ce = KECCAK_ROTL64(Ega, 36);
 	Eke ^= De;
-	Ci = qsc_intutils_rotl64(Eke, 10);
+	Ci = KECCAK_ROTL64(Eke, 10);
 	Emi ^= Di;
-	Co = qsc_intutils_rotl64(Emi, 15);
+	Co = KECCAK_ROTL64(Emi, 15);
 	Eso ^= Do;
-	Cu = qsc_intutils_rotl64(Eso, 56);
+	Cu = KECCAK_ROTL64(Eso, 56);
 	Ama = Ca ^ ((~Ce) & Ci);
 	Ame = Ce ^ ((~Ci) & Co);
 	Ami = Ci ^ ((~Co) & Cu);
 	Amo = Co ^ ((~Cu) & Ca);
 	Amu = Cu ^ ((~Ca) & Ce);
 	Ebi ^= Di;
-	Ca = qsc_intutils_rotl64(Ebi, 62);
+	Ca = KECCAK_ROTL64(Ebi, 62);
 	Ego ^= Do;
-	Ce = qsc_intutils_rotl64(Ego, 55);
+	Ce = KECCAK_ROTL64(Ego, 55);
 	Eku ^= Du;
-	Ci = qsc_intutils_rotl64(Eku, 39);
+	Ci = KECCAK_ROTL64(Eku, 39);
 	Ema ^= Da;
-	Co = qsc_intutils_rotl64(Ema, 41);
+	Co = KECCAK_ROTL64(Ema, 41);
 	Ese ^= De;
-	Cu = qsc_intutils_rotl64(Ese, 2);
+	Cu = KECCAK_ROTL64(Ese, 2);
 	Asa = Ca ^ ((~Ce) & Ci);
 	Ase = Ce ^ ((~Ci) & Co);
 	Asi = Ci ^ ((~Co) & Cu);
@@ -3820,21 +4447,21 @@ void qsc_keccak_permute_p1600u(uint64_t* state)
 	Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
 	Co = Abo ^ Ago ^ Ako ^ Amo ^ Aso;
 	Cu = Abu ^ Agu ^ Aku ^ Amu ^ Asu;
-	Da = Cu ^ qsc_intutils_rotl64(Ce, 1);
-	De = Ca ^ qsc_intutils_rotl64(Ci, 1);
-	Di = Ce ^ qsc_intutils_rotl64(Co, 1);
-	Do = Ci ^ qsc_intutils_rotl64(Cu, 1);
-	Du = Co ^ qsc_intutils_rotl64(Ca, 1);
+	Da = Cu ^ KECCAK_ROTL64(Ce, 1);
+	De = Ca ^ KECCAK_ROTL64(Ci, 1);
+	Di = Ce ^ KECCAK_ROTL64(Co, 1);
+	Do = Ci ^ KECCAK_ROTL64(Cu, 1);
+	Du = Co ^ KECCAK_ROTL64(Ca, 1);
 	Aba ^= Da;
 	Ca = Aba;
 	Age ^= De;
-	Ce = qsc_intutils_rotl64(Age, 44);
+	Ce = KECCAK_ROTL64(Age, 44);
 	Aki ^= Di;
-	Ci = qsc_intutils_rotl64(Aki, 43);
+	Ci = KECCAK_ROTL64(Aki, 43);
 	Amo ^= Do;
-	Co = qsc_intutils_rotl64(Amo, 21);
+	Co = KECCAK_ROTL64(Amo, 21);
 	Asu ^= Du;
-	Cu = qsc_intutils_rotl64(Asu, 14);
+	Cu = KECCAK_ROTL64(Asu, 14);
 	Eba = Ca ^ ((~Ce) & Ci);
 	Eba ^= 0x0000000080000001ULL;
 	Ebe = Ce ^ ((~Ci) & Co);
@@ -3842,60 +4469,60 @@ void qsc_keccak_permute_p1600u(uint64_t* state)
 	Ebo = Co ^ ((~Cu) & Ca);
 	Ebu = Cu ^ ((~Ca) & Ce);
 	Abo ^= Do;
-	Ca = qsc_intutils_rotl64(Abo, 28);
+	Ca = KECCAK_ROTL64(Abo, 28);
 	Agu ^= Du;
-	Ce = qsc_intutils_rotl64(Agu, 20);
+	Ce = KECCAK_ROTL64(Agu, 20);
 	Aka ^= Da;
-	Ci = qsc_intutils_rotl64(Aka, 3);
+	Ci = KECCAK_ROTL64(Aka, 3);
 	Ame ^= De;
-	Co = qsc_intutils_rotl64(Ame, 45);
+	Co = KECCAK_ROTL64(Ame, 45);
 	Asi ^= Di;
-	Cu = qsc_intutils_rotl64(Asi, 61);
+	Cu = KECCAK_ROTL64(Asi, 61);
 	Ega = Ca ^ ((~Ce) & Ci);
 	Ege = Ce ^ ((~Ci) & Co);
 	Egi = Ci ^ ((~Co) & Cu);
 	Ego = Co ^ ((~Cu) & Ca);
 	Egu = Cu ^ ((~Ca) & Ce);
 	Abe ^= De;
-	Ca = qsc_intutils_rotl64(Abe, 1);
+	Ca = KECCAK_ROTL64(Abe, 1);
 	Agi ^= Di;
-	Ce = qsc_intutils_rotl64(Agi, 6);
+	Ce = KECCAK_ROTL64(Agi, 6);
 	Ako ^= Do;
-	Ci = qsc_intutils_rotl64(Ako, 25);
+	Ci = KECCAK_ROTL64(Ako, 25);
 	Amu ^= Du;
-	Co = qsc_intutils_rotl64(Amu, 8);
+	Co = KECCAK_ROTL64(Amu, 8);
 	Asa ^= Da;
-	Cu = qsc_intutils_rotl64(Asa, 18);
+	Cu = KECCAK_ROTL64(Asa, 18);
 	Eka = Ca ^ ((~Ce) & Ci);
 	Eke = Ce ^ ((~Ci) & Co);
 	Eki = Ci ^ ((~Co) & Cu);
 	Eko = Co ^ ((~Cu) & Ca);
 	Eku = Cu ^ ((~Ca) & Ce);
 	Abu ^= Du;
-	Ca = qsc_intutils_rotl64(Abu, 27);
+	Ca = KECCAK_ROTL64(Abu, 27);
 	Aga ^= Da;
-	Ce = qsc_intutils_rotl64(Aga, 36);
+	Ce = KECCAK_ROTL64(Aga, 36);
 	Ake ^= De;
-	Ci = qsc_intutils_rotl64(Ake, 10);
+	Ci = KECCAK_ROTL64(Ake, 10);
 	Ami ^= Di;
-	Co = qsc_intutils_rotl64(Ami, 15);
+	Co = KECCAK_ROTL64(Ami, 15);
 	Aso ^= Do;
-	Cu = qsc_intutils_rotl64(Aso, 56);
+	Cu = KECCAK_ROTL64(Aso, 56);
 	Ema = Ca ^ ((~Ce) & Ci);
 	Eme = Ce ^ ((~Ci) & Co);
 	Emi = Ci ^ ((~Co) & Cu);
 	Emo = Co ^ ((~Cu) & Ca);
 	Emu = Cu ^ ((~Ca) & Ce);
 	Abi ^= Di;
-	Ca = qsc_intutils_rotl64(Abi, 62);
+	Ca = KECCAK_ROTL64(Abi, 62);
 	Ago ^= Do;
-	Ce = qsc_intutils_rotl64(Ago, 55);
+	Ce = KECCAK_ROTL64(Ago, 55);
 	Aku ^= Du;
-	Ci = qsc_intutils_rotl64(Aku, 39);
+	Ci = KECCAK_ROTL64(Aku, 39);
 	Ama ^= Da;
-	Co = qsc_intutils_rotl64(Ama, 41);
+	Co = KECCAK_ROTL64(Ama, 41);
 	Ase ^= De;
-	Cu = qsc_intutils_rotl64(Ase, 2);
+	Cu = KECCAK_ROTL64(Ase, 2);
 	Esa = Ca ^ ((~Ce) & Ci);
 	Ese = Ce ^ ((~Ci) & Co);
 	Esi = Ci ^ ((~Co) & Cu);
@@ -3907,21 +4534,21 @@ void qsc_keccak_permute_p1600u(uint64_t* state)
 	Ci = Ebi ^ Egi ^ Eki ^ Emi ^ Esi;
 	Co = Ebo ^ Ego ^ Eko ^ Emo ^ Eso;
 	Cu = Ebu ^ Egu ^ Eku ^ Emu ^ Esu;
-	Da = Cu ^ qsc_intutils_rotl64(Ce, 1);
-	De = Ca ^ qsc_intutils_rotl64(Ci, 1);
-	Di = Ce ^ qsc_intutils_rotl64(Co, 1);
-	Do = Ci ^ qsc_intutils_rotl64(Cu, 1);
-	Du = Co ^ qsc_intutils_rotl64(Ca, 1);
+	Da = Cu ^ KECCAK_ROTL64(Ce, 1);
+	De = Ca ^ KECCAK_ROTL64(Ci, 1);
+	Di = Ce ^ KECCAK_ROTL64(Co, 1);
+	Do = Ci ^ KECCAK_ROTL64(Cu, 1);
+	Du = Co ^ KECCAK_ROTL64(Ca, 1);
 	Eba ^= Da;
 	Ca = Eba;
 	Ege ^= De;
-	Ce = qsc_intutils_rotl64(Ege, 44);
+	Ce = KECCAK_ROTL64(Ege, 44);
 	Eki ^= Di;
-	Ci = qsc_intutils_rotl64(Eki, 43);
+	Ci = KECCAK_ROTL64(Eki, 43);
 	Emo ^= Do;
-	Co = qsc_intutils_rotl64(Emo, 21);
+	Co = KECCAK_ROTL64(Emo, 21);
 	Esu ^= Du;
-	Cu = qsc_intutils_rotl64(Esu, 14);
+	Cu = KECCAK_ROTL64(Esu, 14);
 	Aba = Ca ^ ((~Ce) & Ci);
 	Aba ^= 0x8000000080008008ULL;
 	Abe = Ce ^ ((~Ci) & Co);
@@ -3929,60 +4556,60 @@ void qsc_keccak_permute_p1600u(uint64_t* state)
 	Abo = Co ^ ((~Cu) & Ca);
 	Abu = Cu ^ ((~Ca) & Ce);
 	Ebo ^= Do;
-	Ca = qsc_intutils_rotl64(Ebo, 28);
+	Ca = KECCAK_ROTL64(Ebo, 28);
 	Egu ^= Du;
-	Ce = qsc_intutils_rotl64(Egu, 20);
+	Ce = KECCAK_ROTL64(Egu, 20);
 	Eka ^= Da;
-	Ci = qsc_intutils_rotl64(Eka, 3);
+	Ci = KECCAK_ROTL64(Eka, 3);
 	Eme ^= De;
-	Co = qsc_intutils_rotl64(Eme, 45);
+	Co = KECCAK_ROTL64(Eme, 45);
 	Esi ^= Di;
-	Cu = qsc_intutils_rotl64(Esi, 61);
+	Cu = KECCAK_ROTL64(Esi, 61);
 	Aga = Ca ^ ((~Ce) & Ci);
 	Age = Ce ^ ((~Ci) & Co);
 	Agi = Ci ^ ((~Co) & Cu);
 	Ago = Co ^ ((~Cu) & Ca);
 	Agu = Cu ^ ((~Ca) & Ce);
 	Ebe ^= De;
-	Ca = qsc_intutils_rotl64(Ebe, 1);
+	Ca = KECCAK_ROTL64(Ebe, 1);
 	Egi ^= Di;
-	Ce = qsc_intutils_rotl64(Egi, 6);
+	Ce = KECCAK_ROTL64(Egi, 6);
 	Eko ^= Do;
-	Ci = qsc_intutils_rotl64(Eko, 25);
+	Ci = KECCAK_ROTL64(Eko, 25);
 	Emu ^= Du;
-	Co = qsc_intutils_rotl64(Emu, 8);
+	Co = KECCAK_ROTL64(Emu, 8);
 	Esa ^= Da;
-	Cu = qsc_intutils_rotl64(Esa, 18);
+	Cu = KECCAK_ROTL64(Esa, 18);
 	Aka = Ca ^ ((~Ce) & Ci);
 	Ake = Ce ^ ((~Ci) & Co);
 	Aki = Ci ^ ((~Co) & Cu);
 	Ako = Co ^ ((~Cu) & Ca);
 	Aku = Cu ^ ((~Ca) & Ce);
 	Ebu ^= Du;
-	Ca = qsc_intutils_rotl64(Ebu, 27);
+	Ca = KECCAK_ROTL64(Ebu, 27);
 	Ega ^= Da;
-	Ce = qsc_intutils_rotl64(Ega, 36);
+	Ce = KECCAK_ROTL64(Ega, 36);
 	Eke ^= De;
-	Ci = qsc_intutils_rotl64(Eke, 10);
+	Ci = KECCAK_ROTL64(Eke, 10);
 	Emi ^= Di;
-	Co = qsc_intutils_rotl64(Emi, 15);
+	Co = KECCAK_ROTL64(Emi, 15);
 	Eso ^= Do;
-	Cu = qsc_intutils_rotl64(Eso, 56);
+	Cu = KECCAK_ROTL64(Eso, 56);
 	Ama = Ca ^ ((~Ce) & Ci);
 	Ame = Ce ^ ((~Ci) & Co);
 	Ami = Ci ^ ((~Co) & Cu);
 	Amo = Co ^ ((~Cu) & Ca);
 	Amu = Cu ^ ((~Ca) & Ce);
 	Ebi ^= Di;
-	Ca = qsc_intutils_rotl64(Ebi, 62);
+	Ca = KECCAK_ROTL64(Ebi, 62);
 	Ego ^= Do;
-	Ce = qsc_intutils_rotl64(Ego, 55);
+	Ce = KECCAK_ROTL64(Ego, 55);
 	Eku ^= Du;
-	Ci = qsc_intutils_rotl64(Eku, 39);
+	Ci = KECCAK_ROTL64(Eku, 39);
 	Ema ^= Da;
-	Co = qsc_intutils_rotl64(Ema, 41);
+	Co = KECCAK_ROTL64(Ema, 41);
 	Ese ^= De;
-	Cu = qsc_intutils_rotl64(Ese, 2);
+	Cu = KECCAK_ROTL64(Ese, 2);
 	Asa = Ca ^ ((~Ce) & Ci);
 	Ase = Ce ^ ((~Ci) & Co);
 	Asi = Ci ^ ((~Co) & Cu);
@@ -4455,24 +5082,74 @@ void qsc_kmac_initialize(qsc_keccak_state* ctx, qsc_keccak_rate rate, const uint
 	qsc_keccak_absorb_key_custom(ctx, rate, key, keylen, custom, custlen, name, sizeof(name), QSC_KECCAK_PERMUTATION_ROUNDS);
 }
 
-void qsc_kmac_update(qsc_keccak_state* ctx, qsc_keccak_rate rate, const uint8_t* message, size_t msglen)
+void qsc_kmac_compute_prepared(uint8_t* output, size_t otplen, const uint8_t* message, size_t msglen, const qsc_kmac_key* pkey)
 {
-	assert(ctx != NULL);
+	assert(output != NULL);
 	assert(message != NULL);
+	assert(pkey != NULL);
 
-	qsc_keccak_update(ctx, rate, message, msglen, QSC_KECCAK_PERMUTATION_ROUNDS);
-}
+	qsc_keccak_state ctx;
 
-/* KPA */
+	qsc_kmac_initialize_prepared(&ctx, pkey);
+	qsc_kmac_update(&ctx, pkey->rate, message, msglen);
+	qsc_kmac_finalize(&ctx, pkey->rate, output, otplen);
+}
 
-static void kpa_absorb_leaves(uint64_t* state, qsc_keccak_rate rate, const uint8_t* input, size_t inplen)
+void qsc_kmac_initialize_prepared(qsc_keccak_state* ctx, const qsc_kmac_key* pkey)
 {
-	assert(state != NULL);
-	assert(input != NULL);
+	assert(ctx != NULL);
+	assert(pkey != NULL);
 
-	while (inplen >= (size_t)rate)
-	{
-#if defined(QSC_SYSTEM_IS_LITTLE_ENDIAN)
+	/* the keyed state ends on a permutation boundary, so the message buffer starts empty */
+	qsc_memutils_copy((uint8_t*)ctx->state, (const uint8_t*)pkey->state, sizeof(ctx->state));
+	qsc_memutils_clear(ctx->buffer, sizeof(ctx->buffer));
+	ctx->position = 0;
+}
+
+QSC_SYSTEM_OPTIMIZE_IGNORE
+void qsc_kmac_key_dispose(qsc_kmac_key* pkey)
+{
+	assert(pkey != NULL);
+
+	if (pkey != NULL)
+	{
+		qsc_memutils_clear((uint8_t*)pkey->state, sizeof(pkey->state));
+		pkey->rate = qsc_keccak_rate_none;
+	}
+}
+QSC_SYSTEM_OPTIMIZE_RESUME
+
+void qsc_kmac_key_prepare(qsc_kmac_key* pkey, qsc_keccak_rate rate, const uint8_t* key, size_t keylen, const uint8_t* custom, size_t custlen)
+{
+	assert(pkey != NULL);
+	assert(key != NULL);
+
+	qsc_keccak_state ctx;
+
+	qsc_kmac_initialize(&ctx, rate, key, keylen, custom, custlen);
+	qsc_memutils_copy((uint8_t*)pkey->state, (const uint8_t*)ctx.state, sizeof(pkey->state));
+	pkey->rate = rate;
+	qsc_keccak_dispose(&ctx);
+}
+
+void qsc_kmac_update(qsc_keccak_state* ctx, qsc_keccak_rate rate, const uint8_t* message, size_t msglen)
+{
+	assert(ctx != NULL);
+	assert(message != NULL);
+
+	qsc_keccak_update(ctx, rate, message, msglen, QSC_KECCAK_PERMUTATION_ROUNDS);
+}
+
+/* KPA */
+
+static void kpa_absorb_leaves(uint64_t* state, qsc_keccak_rate rate, const uint8_t* input, size_t inplen)
+{
+	assert(state != NULL);
+	assert(input != NULL);
+
+	while (inplen >= (size_t)rate)
+	{
+#if defined(QSC_SYSTEM_IS_LITTLE_ENDIAN)
 		qsc_memutils_xor((uint8_t*)state, input, rate);
 #else
 		for (size_t i = 0; i < rate / sizeof(uint64_t); ++i)
@@ -5017,7 +5694,7 @@ void qsc_keccakx4_absorb(__m256i state[QSC_KECCAK_STATE_SIZE], qsc_keccak_rate r
 	{
 		for (i = 0; i < (size_t)rate / sizeof(uint64_t); ++i)
 		{
-			t = _mm256_i64gather_epi64((int64_t*)pos, idx, 1);
+			t = _mm256_i64gather_epi64((const long long*)pos, idx, 1);
 			state[i] = _mm256_xor_si256(state[i], t);
 			pos += sizeof(uint64_t);
 		}
@@ -5030,7 +5707,7 @@ void qsc_keccakx4_absorb(__m256i state[QSC_KECCAK_STATE_SIZE], qsc_keccak_rate r
 
 	while (inplen >= sizeof(uint64_t))
 	{
-		t = _mm256_i64gather_epi64((int64_t*)pos, idx, 1);
+		t = _mm256_i64gather_epi64((const long long*)pos, idx, 1);
 		state[i] = _mm256_xor_si256(state[i], t);
 
 		i++;
@@ -5040,7 +5717,7 @@ void qsc_keccakx4_absorb(__m256i state[QSC_KECCAK_STATE_SIZE], qsc_keccak_rate r
 
 	if (inplen != 0)
 	{
-		t = _mm256_i64gather_epi64((int64_t*)pos, idx, 1);
+		t = _mm256_i64gather_epi64((const long long*)pos, idx, 1);
 		idx = _mm256_set1_epi64x((1ULL << (sizeof(uint64_t) * inplen)) - 1);
 		t = _mm256_and_si256(t, idx);
 		state[i] = _mm256_xor_si256(state[i], t);
@@ -5264,310 +5941,548 @@ void qsc_keccakx8_squeezeblocks(__m512i state[QSC_KECCAK_STATE_SIZE], qsc_keccak
 
 #endif
 
-void qsc_shake_128x4(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3, size_t otplen,
-	const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3, size_t inplen)
-{
-	assert(inp0 != NULL);
-	assert(inp1 != NULL);
-	assert(inp2 != NULL);
-	assert(inp3 != NULL);
-	assert(out0 != NULL);
-	assert(out1 != NULL);
-	assert(out2 != NULL);
-	assert(out3 != NULL);
-	assert(inplen != 0);
-	assert(otplen != 0);
-
-#if defined(QSC_SYSTEM_HAS_AVX2)
+/* incremental parallel Keccak */
 
+static void keccakx4_xor_block(qsc_keccakx4_state* ctx, const uint8_t* inp[4])
+{
+	const size_t WCNT = (size_t)ctx->rate / sizeof(uint64_t);
 	size_t i;
-	size_t nblocks = otplen / QSC_KECCAK_128_RATE;
-	uint8_t t[4][QSC_KECCAK_128_RATE] = { 0 };
-	__m256i state[QSC_KECCAK_STATE_SIZE] = { 0 };
-
-	qsc_keccakx4_absorb(state, qsc_keccak_rate_128, inp0, inp1, inp2, inp3, inplen, QSC_KECCAK_SHAKE_DOMAIN_ID);
 
-	if (otplen >= QSC_KECCAK_128_RATE)
+#if defined(QSC_SYSTEM_HAS_AVX2)
+	for (i = 0; i < WCNT; ++i)
 	{
-		qsc_keccakx4_squeezeblocks(state, qsc_keccak_rate_128, out0, out1, out2, out3, nblocks);
+		const size_t OFT = i * sizeof(uint64_t);
 
-		out0 += nblocks * QSC_KECCAK_128_RATE;
-		out1 += nblocks * QSC_KECCAK_128_RATE;
-		out2 += nblocks * QSC_KECCAK_128_RATE;
-		out3 += nblocks * QSC_KECCAK_128_RATE;
-		otplen -= nblocks * QSC_KECCAK_128_RATE;
+		ctx->state[i] = _mm256_xor_si256(ctx->state[i], _mm256_set_epi64x((int64_t)qsc_intutils_le8to64(inp[3] + OFT),
+			(int64_t)qsc_intutils_le8to64(inp[2] + OFT), (int64_t)qsc_intutils_le8to64(inp[1] + OFT), (int64_t)qsc_intutils_le8to64(inp[0] + OFT)));
 	}
-
-	if (otplen != 0)
+#else
+	for (size_t j = 0; j < 4; ++j)
 	{
-		qsc_keccakx4_squeezeblocks(state, qsc_keccak_rate_128, t[0], t[1], t[2], t[3], 1);
-
-		for (i = 0; i < otplen; ++i)
+		for (i = 0; i < WCNT; ++i)
 		{
-			out0[i] = t[0][i];
-			out1[i] = t[1][i];
-			out2[i] = t[2][i];
-			out3[i] = t[3][i];
+			ctx->state[j][i] ^= qsc_intutils_le8to64(inp[j] + (i * sizeof(uint64_t)));
 		}
 	}
+#endif
+}
 
+static void keccakx4_permute(qsc_keccakx4_state* ctx)
+{
+#if defined(QSC_SYSTEM_HAS_AVX2)
+	qsc_keccak_permute_p4x1600(ctx->state, QSC_KECCAK_PERMUTATION_ROUNDS);
 #else
-
-	qsc_shake128_compute(out0, otplen, inp0, inplen);
-	qsc_shake128_compute(out1, otplen, inp1, inplen);
-	qsc_shake128_compute(out2, otplen, inp2, inplen);
-	qsc_shake128_compute(out3, otplen, inp3, inplen);
-
+	for (size_t j = 0; j < 4; ++j)
+	{
+		qsc_keccak_permute_p1600c(ctx->state[j], QSC_KECCAK_PERMUTATION_ROUNDS);
+	}
 #endif
 }
 
-void qsc_shake_256x4(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3, size_t otplen,
-	const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3, size_t inplen)
+static void keccakx4_extract(qsc_keccakx4_state* ctx)
 {
-	assert(inp0 != NULL);
-	assert(inp1 != NULL);
-	assert(inp2 != NULL);
-	assert(inp3 != NULL);
-	assert(out0 != NULL);
-	assert(out1 != NULL);
-	assert(out2 != NULL);
-	assert(out3 != NULL);
-	assert(inplen != 0);
-	assert(otplen != 0);
+	const size_t WCNT = (size_t)ctx->rate / sizeof(uint64_t);
+	size_t i;
+	size_t j;
 
+	for (i = 0; i < WCNT; ++i)
+	{
 #if defined(QSC_SYSTEM_HAS_AVX2)
+		uint64_t tmp[4];
 
-	size_t nblocks = otplen / QSC_KECCAK_256_RATE;
-	uint8_t t[4][QSC_KECCAK_256_RATE] = { 0 };
-	__m256i state[QSC_KECCAK_STATE_SIZE] = { 0 };
+		_mm256_storeu_si256((__m256i*)tmp, ctx->state[i]);
 
-	qsc_keccakx4_absorb(state, qsc_keccak_rate_256, inp0, inp1, inp2, inp3, inplen, QSC_KECCAK_SHAKE_DOMAIN_ID);
+		for (j = 0; j < 4; ++j)
+		{
+			qsc_intutils_le64to8(ctx->buffer[j] + (i * sizeof(uint64_t)), tmp[j]);
+		}
+#else
+		for (j = 0; j < 4; ++j)
+		{
+			qsc_intutils_le64to8(ctx->buffer[j] + (i * sizeof(uint64_t)), ctx->state[j][i]);
+		}
+#endif
+	}
+}
 
-	if (otplen >= QSC_KECCAK_256_RATE)
+static void keccakx8_xor_block(qsc_keccakx8_state* ctx, const uint8_t* inp[8])
+{
+	const size_t WCNT = (size_t)ctx->rate / sizeof(uint64_t);
+	size_t i;
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+	for (i = 0; i < WCNT; ++i)
 	{
-		qsc_keccakx4_squeezeblocks(state, qsc_keccak_rate_256, out0, out1, out2, out3, nblocks);
+		const size_t OFT = i * sizeof(uint64_t);
 
-		out0 += nblocks * QSC_KECCAK_256_RATE;
-		out1 += nblocks * QSC_KECCAK_256_RATE;
-		out2 += nblocks * QSC_KECCAK_256_RATE;
-		out3 += nblocks * QSC_KECCAK_256_RATE;
-		otplen -= nblocks * QSC_KECCAK_256_RATE;
+		ctx->state[i] = _mm512_xor_si512(ctx->state[i], _mm512_set_epi64((int64_t)qsc_intutils_le8to64(inp[7] + OFT),
+			(int64_t)qsc_intutils_le8to64(inp[6] + OFT), (int64_t)qsc_intutils_le8to64(inp[5] + OFT), (int64_t)qsc_intutils_le8to64(inp[4] + OFT),
+			(int64_t)qsc_intutils_le8to64(inp[3] + OFT), (int64_t)qsc_intutils_le8to64(inp[2] + OFT),
+			(int64_t)qsc_intutils_le8to64(inp[1] + OFT), (int64_t)qsc_intutils_le8to64(inp[0] + OFT)));
 	}
-
-	if (otplen != 0)
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+	for (size_t j = 0; j < 2; ++j)
 	{
-		qsc_keccakx4_squeezeblocks(state, qsc_keccak_rate_256, t[0], t[1], t[2], t[3], 1);
+		for (i = 0; i < WCNT; ++i)
+		{
+			const size_t OFT = i * sizeof(uint64_t);
 
-		for (size_t i = 0; i < otplen; ++i)
+			ctx->state[j][i] = _mm256_xor_si256(ctx->state[j][i], _mm256_set_epi64x((int64_t)qsc_intutils_le8to64(inp[(4 * j) + 3] + OFT),
+				(int64_t)qsc_intutils_le8to64(inp[(4 * j) + 2] + OFT), (int64_t)qsc_intutils_le8to64(inp[(4 * j) + 1] + OFT),
+				(int64_t)qsc_intutils_le8to64(inp[4 * j] + OFT)));
+		}
+	}
+#else
+	for (size_t j = 0; j < 8; ++j)
+	{
+		for (i = 0; i < WCNT; ++i)
 		{
-			out0[i] = t[0][i];
-			out1[i] = t[1][i];
-			out2[i] = t[2][i];
-			out3[i] = t[3][i];
+			ctx->state[j][i] ^= qsc_intutils_le8to64(inp[j] + (i * sizeof(uint64_t)));
 		}
 	}
+#endif
+}
 
+static void keccakx8_permute(qsc_keccakx8_state* ctx)
+{
+#if defined(QSC_SYSTEM_HAS_AVX512)
+	qsc_keccak_permute_p8x1600(ctx->state, QSC_KECCAK_PERMUTATION_ROUNDS);
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+	qsc_keccak_permute_p4x1600(ctx->state[0], QSC_KECCAK_PERMUTATION_ROUNDS);
+	qsc_keccak_permute_p4x1600(ctx->state[1], QSC_KECCAK_PERMUTATION_ROUNDS);
 #else
-
-	qsc_shake256_compute(out0, otplen, inp0, inplen);
-	qsc_shake256_compute(out1, otplen, inp1, inplen);
-	qsc_shake256_compute(out2, otplen, inp2, inplen);
-	qsc_shake256_compute(out3, otplen, inp3, inplen);
-
+	for (size_t j = 0; j < 8; ++j)
+	{
+		qsc_keccak_permute_p1600c(ctx->state[j], QSC_KECCAK_PERMUTATION_ROUNDS);
+	}
 #endif
 }
 
-void qsc_shake_512x4(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3, size_t otplen,
-	const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3, size_t inplen)
+static void keccakx8_extract(qsc_keccakx8_state* ctx)
 {
-	assert(inp0 != NULL);
-	assert(inp1 != NULL);
-	assert(inp2 != NULL);
-	assert(inp3 != NULL);
-	assert(out0 != NULL);
-	assert(out1 != NULL);
-	assert(out2 != NULL);
-	assert(out3 != NULL);
-	assert(inplen != 0);
-	assert(otplen != 0);
+	const size_t WCNT = (size_t)ctx->rate / sizeof(uint64_t);
+	size_t i;
+	size_t j;
 
-#if defined(QSC_SYSTEM_HAS_AVX2)
+	for (i = 0; i < WCNT; ++i)
+	{
+#if defined(QSC_SYSTEM_HAS_AVX512)
+		uint64_t tmp[8];
 
-	size_t nblocks = otplen / QSC_KECCAK_512_RATE;
-	uint8_t t[4][QSC_KECCAK_512_RATE] = { 0 };
-	__m256i state[QSC_KECCAK_STATE_SIZE] = { 0 };
+		_mm512_storeu_si512((__m512i*)tmp, ctx->state[i]);
 
-	qsc_keccakx4_absorb(state, qsc_keccak_rate_512, inp0, inp1, inp2, inp3, inplen, QSC_KECCAK_SHAKE_DOMAIN_ID);
+		for (j = 0; j < 8; ++j)
+		{
+			qsc_intutils_le64to8(ctx->buffer[j] + (i * sizeof(uint64_t)), tmp[j]);
+		}
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+		uint64_t tmp[8];
 
-	if (otplen >= QSC_KECCAK_512_RATE)
-	{
-		qsc_keccakx4_squeezeblocks(state, qsc_keccak_rate_512, out0, out1, out2, out3, nblocks);
+		_mm256_storeu_si256((__m256i*)tmp, ctx->state[0][i]);
+		_mm256_storeu_si256((__m256i*)(tmp + 4), ctx->state[1][i]);
 
-		out0 += nblocks * QSC_KECCAK_512_RATE;
-		out1 += nblocks * QSC_KECCAK_512_RATE;
-		out2 += nblocks * QSC_KECCAK_512_RATE;
-		out3 += nblocks * QSC_KECCAK_512_RATE;
-		otplen -= nblocks * QSC_KECCAK_512_RATE;
+		for (j = 0; j < 8; ++j)
+		{
+			qsc_intutils_le64to8(ctx->buffer[j] + (i * sizeof(uint64_t)), tmp[j]);
+		}
+#else
+		for (j = 0; j < 8; ++j)
+		{
+			qsc_intutils_le64to8(ctx->buffer[j] + (i * sizeof(uint64_t)), ctx->state[j][i]);
+		}
+#endif
 	}
+}
 
-	if (otplen != 0)
-	{
-		qsc_keccakx4_squeezeblocks(state, qsc_keccak_rate_512, t[0], t[1], t[2], t[3], 1);
+void qsc_keccakx4_dispose(qsc_keccakx4_state* ctx)
+{
+	assert(ctx != NULL);
 
-		for (size_t i = 0; i < otplen; ++i)
-		{
-			out0[i] = t[0][i];
-			out1[i] = t[1][i];
-			out2[i] = t[2][i];
-			out3[i] = t[3][i];
-		}
+	if (ctx != NULL)
+	{
+		qsc_memutils_clear((uint8_t*)ctx, sizeof(qsc_keccakx4_state));
 	}
+}
 
-#else
+void qsc_keccakx4_finalize(qsc_keccakx4_state* ctx, uint8_t domain)
+{
+	assert(ctx != NULL);
+	assert(ctx->position < (size_t)ctx->rate);
 
-	qsc_shake512_compute(out0, otplen, inp0, inplen);
-	qsc_shake512_compute(out1, otplen, inp1, inplen);
-	qsc_shake512_compute(out2, otplen, inp2, inplen);
-	qsc_shake512_compute(out3, otplen, inp3, inplen);
+	const uint8_t* blk[4] = { ctx->buffer[0], ctx->buffer[1], ctx->buffer[2], ctx->buffer[3] };
+	const size_t RATE = (size_t)ctx->rate;
+	size_t j;
 
-#endif
+	for (j = 0; j < 4; ++j)
+	{
+		qsc_memutils_clear(ctx->buffer[j] + ctx->position, RATE - ctx->position);
+		ctx->buffer[j][ctx->position] = domain;
+		ctx->buffer[j][RATE - 1] |= 128U;
+	}
+
+	keccakx4_xor_block(ctx, blk);
+
+	/* the buffer is empty; the first squeeze permutes the state */
+	ctx->position = RATE;
 }
 
-/* parallel shake x8 */
+void qsc_keccakx4_initialize(qsc_keccakx4_state* ctx, qsc_keccak_rate rate)
+{
+	assert(ctx != NULL);
 
-void qsc_shake_128x8(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
-	uint8_t* out4, uint8_t* out5, uint8_t* out6, uint8_t* out7, size_t otplen,
-	const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3,
-	const uint8_t* inp4, const uint8_t* inp5, const uint8_t* inp6, const uint8_t* inp7, size_t inplen)
+	if (ctx != NULL)
+	{
+		qsc_memutils_clear((uint8_t*)ctx, sizeof(qsc_keccakx4_state));
+		ctx->rate = rate;
+	}
+}
+
+void qsc_keccakx4_squeeze(qsc_keccakx4_state* ctx, uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3, size_t otplen)
 {
-	assert(inp0 != NULL);
-	assert(inp1 != NULL);
-	assert(inp2 != NULL);
-	assert(inp3 != NULL);
-	assert(inp4 != NULL);
-	assert(inp5 != NULL);
-	assert(inp6 != NULL);
-	assert(inp7 != NULL);
+	assert(ctx != NULL);
 	assert(out0 != NULL);
 	assert(out1 != NULL);
 	assert(out2 != NULL);
 	assert(out3 != NULL);
-	assert(out4 != NULL);
-	assert(out5 != NULL);
-	assert(out6 != NULL);
-	assert(out7 != NULL);
-	assert(inplen != 0);
-	assert(otplen != 0);
 
-#if defined(QSC_SYSTEM_HAS_AVX512)
+	uint8_t* out[4] = { out0, out1, out2, out3 };
+	const size_t RATE = (size_t)ctx->rate;
+	size_t blen;
+	size_t j;
 
-	size_t nblocks = otplen / QSC_KECCAK_128_RATE;
-	uint8_t t[8][QSC_KECCAK_128_RATE] = { 0 };
-	__m512i state[QSC_KECCAK_STATE_SIZE] = { 0 };
+	while (otplen != 0)
+	{
+		if (ctx->position == RATE)
+		{
+			keccakx4_permute(ctx);
+			keccakx4_extract(ctx);
+			ctx->position = 0;
+		}
 
-	qsc_keccakx8_absorb(state, qsc_keccak_rate_128, inp0, inp1, inp2, inp3, inp4, inp5, inp6, inp7, inplen, QSC_KECCAK_SHAKE_DOMAIN_ID);
+		blen = qsc_intutils_min(RATE - ctx->position, otplen);
+
+		for (j = 0; j < 4; ++j)
+		{
+			qsc_memutils_copy(out[j], ctx->buffer[j] + ctx->position, blen);
+			out[j] += blen;
+		}
+
+		ctx->position += blen;
+		otplen -= blen;
+	}
+}
+
+void qsc_keccakx4_update(qsc_keccakx4_state* ctx, const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3, size_t lanelen)
+{
+	assert(ctx != NULL);
+	assert(inp0 != NULL);
+	assert(inp1 != NULL);
+	assert(inp2 != NULL);
+	assert(inp3 != NULL);
+	assert(ctx->position < (size_t)ctx->rate);
+
+	const uint8_t* inp[4] = { inp0, inp1, inp2, inp3 };
+	const size_t RATE = (size_t)ctx->rate;
+	size_t blen;
+	size_t j;
+
+	if (ctx->position != 0 && lanelen != 0)
+	{
+		/* fill the lane buffers */
+		blen = qsc_intutils_min(RATE - ctx->position, lanelen);
+
+		for (j = 0; j < 4; ++j)
+		{
+			qsc_memutils_copy(ctx->buffer[j] + ctx->position, inp[j], blen);
+			inp[j] += blen;
+		}
+
+		ctx->position += blen;
+		lanelen -= blen;
+
+		if (ctx->position == RATE)
+		{
+			const uint8_t* blk[4] = { ctx->buffer[0], ctx->buffer[1], ctx->buffer[2], ctx->buffer[3] };
+
+			keccakx4_xor_block(ctx, blk);
+			keccakx4_permute(ctx);
+			ctx->position = 0;
+		}
+	}
+
+	/* absorb full blocks directly from the inputs */
+	while (lanelen >= RATE)
+	{
+		keccakx4_xor_block(ctx, inp);
+		keccakx4_permute(ctx);
+
+		for (j = 0; j < 4; ++j)
+		{
+			inp[j] += RATE;
+		}
+
+		lanelen -= RATE;
+	}
+
+	/* store the unaligned bytes */
+	if (lanelen != 0)
+	{
+		for (j = 0; j < 4; ++j)
+		{
+			qsc_memutils_copy(ctx->buffer[j], inp[j], lanelen);
+		}
+
+		ctx->position = lanelen;
+	}
+}
+
+void qsc_keccakx8_dispose(qsc_keccakx8_state* ctx)
+{
+	assert(ctx != NULL);
+
+	if (ctx != NULL)
+	{
+		qsc_memutils_clear((uint8_t*)ctx, sizeof(qsc_keccakx8_state));
+	}
+}
+
+void qsc_keccakx8_finalize(qsc_keccakx8_state* ctx, uint8_t domain)
+{
+	assert(ctx != NULL);
+	assert(ctx->position < (size_t)ctx->rate);
+
+	const uint8_t* blk[8] = { ctx->buffer[0], ctx->buffer[1], ctx->buffer[2], ctx->buffer[3],
+		ctx->buffer[4], ctx->buffer[5], ctx->buffer[6], ctx->buffer[7] };
+	const size_t RATE = (size_t)ctx->rate;
+	size_t j;
+
+	for (j = 0; j < 8; ++j)
+	{
+		qsc_memutils_clear(ctx->buffer[j] + ctx->position, RATE - ctx->position);
+		ctx->buffer[j][ctx->position] = domain;
+		ctx->buffer[j][RATE - 1] |= 128U;
+	}
+
+	keccakx8_xor_block(ctx, blk);
+
+	/* the buffer is empty; the first squeeze permutes the state */
+	ctx->position = RATE;
+}
+
+void qsc_keccakx8_initialize(qsc_keccakx8_state* ctx, qsc_keccak_rate rate)
+{
+	assert(ctx != NULL);
+
+	if (ctx != NULL)
+	{
+		qsc_memutils_clear((uint8_t*)ctx, sizeof(qsc_keccakx8_state));
+		ctx->rate = rate;
+	}
+}
+
+void qsc_keccakx8_squeeze(qsc_keccakx8_state* ctx, uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
+	uint8_t* out4, uint8_t* out5, uint8_t* out6, uint8_t* out7, size_t otplen)
+{
+	assert(ctx != NULL);
+	assert(out0 != NULL);
+	assert(out1 != NULL);
+	assert(out2 != NULL);
+	assert(out3 != NULL);
+	assert(out4 != NULL);
+	assert(out5 != NULL);
+	assert(out6 != NULL);
+	assert(out7 != NULL);
+
+	uint8_t* out[8] = { out0, out1, out2, out3, out4, out5, out6, out7 };
+	const size_t RATE = (size_t)ctx->rate;
+	size_t blen;
+	size_t j;
+
+	while (otplen != 0)
+	{
+		if (ctx->position == RATE)
+		{
+			keccakx8_permute(ctx);
+			keccakx8_extract(ctx);
+			ctx->position = 0;
+		}
+
+		blen = qsc_intutils_min(RATE - ctx->position, otplen);
+
+		for (j = 0; j < 8; ++j)
+		{
+			qsc_memutils_copy(out[j], ctx->buffer[j] + ctx->position, blen);
+			out[j] += blen;
+		}
+
+		ctx->position += blen;
+		otplen -= blen;
+	}
+}
+
+void qsc_keccakx8_update(qsc_keccakx8_state* ctx, const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3,
+	const uint8_t* inp4, const uint8_t* inp5, const uint8_t* inp6, const uint8_t* inp7, size_t lanelen)
+{
+	assert(ctx != NULL);
+	assert(inp0 != NULL);
+	assert(inp1 != NULL);
+	assert(inp2 != NULL);
+	assert(inp3 != NULL);
+	assert(inp4 != NULL);
+	assert(inp5 != NULL);
+	assert(inp6 != NULL);
+	assert(inp7 != NULL);
+	assert(ctx->position < (size_t)ctx->rate);
+
+	const uint8_t* inp[8] = { inp0, inp1, inp2, inp3, inp4, inp5, inp6, inp7 };
+	const size_t RATE = (size_t)ctx->rate;
+	size_t blen;
+	size_t j;
+
+	if (ctx->position != 0 && lanelen != 0)
+	{
+		/* fill the lane buffers */
+		blen = qsc_intutils_min(RATE - ctx->position, lanelen);
+
+		for (j = 0; j < 8; ++j)
+		{
+			qsc_memutils_copy(ctx->buffer[j] + ctx->position, inp[j], blen);
+			inp[j] += blen;
+		}
+
+		ctx->position += blen;
+		lanelen -= blen;
+
+		if (ctx->position == RATE)
+		{
+			const uint8_t* blk[8] = { ctx->buffer[0], ctx->buffer[1], ctx->buffer[2], ctx->buffer[3],
+				ctx->buffer[4], ctx->buffer[5], ctx->buffer[6], ctx->buffer[7] };
+
+			keccakx8_xor_block(ctx, blk);
+			keccakx8_permute(ctx);
+			ctx->position = 0;
+		}
+	}
+
+	/* absorb full blocks directly from the inputs */
+	while (lanelen >= RATE)
+	{
+		keccakx8_xor_block(ctx, inp);
+		keccakx8_permute(ctx);
+
+		for (j = 0; j < 8; ++j)
+		{
+			inp[j] += RATE;
+		}
+
+		lanelen -= RATE;
+	}
+
+	/* store the unaligned bytes */
+	if (lanelen != 0)
+	{
+		for (j = 0; j < 8; ++j)
+		{
+			qsc_memutils_copy(ctx->buffer[j], inp[j], lanelen);
+		}
+
+		ctx->position = lanelen;
+	}
+}
+
+void qsc_shake_128x4(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3, size_t otplen,
+	const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3, size_t inplen)
+{
+	assert(inp0 != NULL);
+	assert(inp1 != NULL);
+	assert(inp2 != NULL);
+	assert(inp3 != NULL);
+	assert(out0 != NULL);
+	assert(out1 != NULL);
+	assert(out2 != NULL);
+	assert(out3 != NULL);
+	assert(inplen != 0);
+	assert(otplen != 0);
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+
+	size_t i;
+	size_t nblocks = otplen / QSC_KECCAK_128_RATE;
+	uint8_t t[4][QSC_KECCAK_128_RATE] = { 0 };
+	__m256i state[QSC_KECCAK_STATE_SIZE] = { 0 };
+
+	qsc_keccakx4_absorb(state, qsc_keccak_rate_128, inp0, inp1, inp2, inp3, inplen, QSC_KECCAK_SHAKE_DOMAIN_ID);
 
 	if (otplen >= QSC_KECCAK_128_RATE)
 	{
-		qsc_keccakx8_squeezeblocks(state, qsc_keccak_rate_128, out0, out1, out2, out3, out4, out5, out6, out7, nblocks);
+		qsc_keccakx4_squeezeblocks(state, qsc_keccak_rate_128, out0, out1, out2, out3, nblocks);
 
 		out0 += nblocks * QSC_KECCAK_128_RATE;
 		out1 += nblocks * QSC_KECCAK_128_RATE;
 		out2 += nblocks * QSC_KECCAK_128_RATE;
 		out3 += nblocks * QSC_KECCAK_128_RATE;
-		out4 += nblocks * QSC_KECCAK_128_RATE;
-		out5 += nblocks * QSC_KECCAK_128_RATE;
-		out6 += nblocks * QSC_KECCAK_128_RATE;
-		out7 += nblocks * QSC_KECCAK_128_RATE;
 		otplen -= nblocks * QSC_KECCAK_128_RATE;
 	}
 
 	if (otplen != 0)
 	{
-		qsc_keccakx8_squeezeblocks(state, qsc_keccak_rate_128, t[0], t[1], t[2], t[3], t[4], t[5], t[6], t[7], 1);
+		qsc_keccakx4_squeezeblocks(state, qsc_keccak_rate_128, t[0], t[1], t[2], t[3], 1);
 
-		for (size_t i = 0; i < otplen; ++i)
+		for (i = 0; i < otplen; ++i)
 		{
 			out0[i] = t[0][i];
 			out1[i] = t[1][i];
 			out2[i] = t[2][i];
 			out3[i] = t[3][i];
-			out4[i] = t[4][i];
-			out5[i] = t[5][i];
-			out6[i] = t[6][i];
-			out7[i] = t[7][i];
 		}
 	}
 
-#elif defined(QSC_SYSTEM_HAS_AVX2)
-
-	qsc_shake_128x4(out0, out1, out2, out3, otplen, inp0, inp1, inp2, inp3, inplen);
-	qsc_shake_128x4(out4, out5, out6, out7, otplen, inp4, inp5, inp6, inp7, inplen);
-
 #else
 
 	qsc_shake128_compute(out0, otplen, inp0, inplen);
 	qsc_shake128_compute(out1, otplen, inp1, inplen);
 	qsc_shake128_compute(out2, otplen, inp2, inplen);
 	qsc_shake128_compute(out3, otplen, inp3, inplen);
-	qsc_shake128_compute(out4, otplen, inp4, inplen);
-	qsc_shake128_compute(out5, otplen, inp5, inplen);
-	qsc_shake128_compute(out6, otplen, inp6, inplen);
-	qsc_shake128_compute(out7, otplen, inp7, inplen);
 
 #endif
 }
 
-void qsc_shake_256x8(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
-	uint8_t* out4, uint8_t* out5, uint8_t* out6, uint8_t* out7, size_t otplen,
-	const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3,
-	const uint8_t* inp4, const uint8_t* inp5, const uint8_t* inp6, const uint8_t* inp7, size_t inplen)
+void qsc_shake_256x4(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3, size_t otplen,
+	const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3, size_t inplen)
 {
 	assert(inp0 != NULL);
 	assert(inp1 != NULL);
 	assert(inp2 != NULL);
 	assert(inp3 != NULL);
-	assert(inp4 != NULL);
-	assert(inp5 != NULL);
-	assert(inp6 != NULL);
-	assert(inp7 != NULL);
 	assert(out0 != NULL);
 	assert(out1 != NULL);
 	assert(out2 != NULL);
 	assert(out3 != NULL);
-	assert(out4 != NULL);
-	assert(out5 != NULL);
-	assert(out6 != NULL);
-	assert(out7 != NULL);
 	assert(inplen != 0);
 	assert(otplen != 0);
 
-#if defined(QSC_SYSTEM_HAS_AVX512)
+#if defined(QSC_SYSTEM_HAS_AVX2)
 
 	size_t nblocks = otplen / QSC_KECCAK_256_RATE;
-	uint8_t t[8][QSC_KECCAK_256_RATE] = { 0 };
-	__m512i state[QSC_KECCAK_STATE_SIZE] = { 0 };
+	uint8_t t[4][QSC_KECCAK_256_RATE] = { 0 };
+	__m256i state[QSC_KECCAK_STATE_SIZE] = { 0 };
 
-	qsc_keccakx8_absorb(state, qsc_keccak_rate_256, inp0, inp1, inp2, inp3, inp4, inp5, inp6, inp7, inplen, QSC_KECCAK_SHAKE_DOMAIN_ID);
+	qsc_keccakx4_absorb(state, qsc_keccak_rate_256, inp0, inp1, inp2, inp3, inplen, QSC_KECCAK_SHAKE_DOMAIN_ID);
 
 	if (otplen >= QSC_KECCAK_256_RATE)
 	{
-		qsc_keccakx8_squeezeblocks(state, qsc_keccak_rate_256, out0, out1, out2, out3, out4, out5, out6, out7, nblocks);
+		qsc_keccakx4_squeezeblocks(state, qsc_keccak_rate_256, out0, out1, out2, out3, nblocks);
 
 		out0 += nblocks * QSC_KECCAK_256_RATE;
 		out1 += nblocks * QSC_KECCAK_256_RATE;
 		out2 += nblocks * QSC_KECCAK_256_RATE;
 		out3 += nblocks * QSC_KECCAK_256_RATE;
-		out4 += nblocks * QSC_KECCAK_256_RATE;
-		out5 += nblocks * QSC_KECCAK_256_RATE;
-		out6 += nblocks * QSC_KECCAK_256_RATE;
-		out7 += nblocks * QSC_KECCAK_256_RATE;
 		otplen -= nblocks * QSC_KECCAK_256_RATE;
 	}
 
 	if (otplen != 0)
 	{
-		qsc_keccakx8_squeezeblocks(state, qsc_keccak_rate_256, t[0], t[1], t[2], t[3], t[4], t[5], t[6], t[7], 1);
+		qsc_keccakx4_squeezeblocks(state, qsc_keccak_rate_256, t[0], t[1], t[2], t[3], 1);
 
 		for (size_t i = 0; i < otplen; ++i)
 		{
@@ -5575,82 +6490,55 @@ void qsc_shake_256x8(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
 			out1[i] = t[1][i];
 			out2[i] = t[2][i];
 			out3[i] = t[3][i];
-			out4[i] = t[4][i];
-			out5[i] = t[5][i];
-			out6[i] = t[6][i];
-			out7[i] = t[7][i];
 		}
 	}
 
-#elif defined(QSC_SYSTEM_HAS_AVX2)
-
-	qsc_shake_256x4(out0, out1, out2, out3, otplen, inp0, inp1, inp2, inp3, inplen);
-	qsc_shake_256x4(out4, out5, out6, out7, otplen, inp4, inp5, inp6, inp7, inplen);
-
 #else
 
 	qsc_shake256_compute(out0, otplen, inp0, inplen);
 	qsc_shake256_compute(out1, otplen, inp1, inplen);
 	qsc_shake256_compute(out2, otplen, inp2, inplen);
 	qsc_shake256_compute(out3, otplen, inp3, inplen);
-	qsc_shake256_compute(out4, otplen, inp4, inplen);
-	qsc_shake256_compute(out5, otplen, inp5, inplen);
-	qsc_shake256_compute(out6, otplen, inp6, inplen);
-	qsc_shake256_compute(out7, otplen, inp7, inplen);
 
 #endif
 }
 
-void qsc_shake_512x8(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
-	uint8_t* out4, uint8_t* out5, uint8_t* out6, uint8_t* out7, size_t otplen,
-	const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3,
-	const uint8_t* inp4, const uint8_t* inp5, const uint8_t* inp6, const uint8_t* inp7, size_t inplen)
+void qsc_shake_512x4(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3, size_t otplen,
+	const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3, size_t inplen)
 {
 	assert(inp0 != NULL);
 	assert(inp1 != NULL);
 	assert(inp2 != NULL);
 	assert(inp3 != NULL);
-	assert(inp4 != NULL);
-	assert(inp5 != NULL);
-	assert(inp6 != NULL);
-	assert(inp7 != NULL);
 	assert(out0 != NULL);
 	assert(out1 != NULL);
 	assert(out2 != NULL);
 	assert(out3 != NULL);
-	assert(out4 != NULL);
-	assert(out5 != NULL);
-	assert(out6 != NULL);
-	assert(out7 != NULL);
 	assert(inplen != 0);
 	assert(otplen != 0);
 
-#if defined(QSC_SYSTEM_HAS_AVX512)
+#if defined(QSC_SYSTEM_HAS_AVX2)
 
 	size_t nblocks = otplen / QSC_KECCAK_512_RATE;
-	uint8_t t[8][QSC_KECCAK_512_RATE] = { 0 };
-	__m512i state[QSC_KECCAK_STATE_SIZE] = { 0 };
+	uint8_t t[4][QSC_KECCAK_512_RATE] = { 0 };
+	__m256i state[QSC_KECCAK_STATE_SIZE] = { 0 };
 
-	qsc_keccakx8_absorb(state, qsc_keccak_rate_512, inp0, inp1, inp2, inp3, inp4, inp5, inp6, inp7, inplen, QSC_KECCAK_SHAKE_DOMAIN_ID);
+	qsc_keccakx4_absorb(state, qsc_keccak_rate_512, inp0, inp1, inp2, inp3, inplen, QSC_KECCAK_SHAKE_DOMAIN_ID);
 
 	if (otplen >= QSC_KECCAK_512_RATE)
 	{
-		qsc_keccakx8_squeezeblocks(state, qsc_keccak_rate_512, out0, out1, out2, out3, out4, out5, out6, out7, nblocks);
+		qsc_keccakx4_squeezeblocks(state, qsc_keccak_rate_512, out0, out1, out2, out3, nblocks);
 
 		out0 += nblocks * QSC_KECCAK_512_RATE;
 		out1 += nblocks * QSC_KECCAK_512_RATE;
 		out2 += nblocks * QSC_KECCAK_512_RATE;
 		out3 += nblocks * QSC_KECCAK_512_RATE;
-		out4 += nblocks * QSC_KECCAK_512_RATE;
-		out5 += nblocks * QSC_KECCAK_512_RATE;
-		out6 += nblocks * QSC_KECCAK_512_RATE;
-		out7 += nblocks * QSC_KECCAK_512_RATE;
 		otplen -= nblocks * QSC_KECCAK_512_RATE;
 	}
 
 	if (otplen != 0)
 	{
-		qsc_keccakx8_squeezeblocks(state, qsc_keccak_rate_512, t[0], t[1], t[2], t[3], t[4], t[5], t[6], t[7], 1);
+		qsc_keccakx4_squeezeblocks(state, qsc_keccak_rate_512, t[0], t[1], t[2], t[3], 1);
 
 		for (size_t i = 0; i < otplen; ++i)
 		{
@@ -5658,10 +6546,248 @@ void qsc_shake_512x8(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
 			out1[i] = t[1][i];
 			out2[i] = t[2][i];
 			out3[i] = t[3][i];
-			out4[i] = t[4][i];
-			out5[i] = t[5][i];
-			out6[i] = t[6][i];
-			out7[i] = t[7][i];
+		}
+	}
+
+#else
+
+	qsc_shake512_compute(out0, otplen, inp0, inplen);
+	qsc_shake512_compute(out1, otplen, inp1, inplen);
+	qsc_shake512_compute(out2, otplen, inp2, inplen);
+	qsc_shake512_compute(out3, otplen, inp3, inplen);
+
+#endif
+}
+
+/* parallel shake x8 */
+
+void qsc_shake_128x8(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
+	uint8_t* out4, uint8_t* out5, uint8_t* out6, uint8_t* out7, size_t otplen,
+	const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3,
+	const uint8_t* inp4, const uint8_t* inp5, const uint8_t* inp6, const uint8_t* inp7, size_t inplen)
+{
+	assert(inp0 != NULL);
+	assert(inp1 != NULL);
+	assert(inp2 != NULL);
+	assert(inp3 != NULL);
+	assert(inp4 != NULL);
+	assert(inp5 != NULL);
+	assert(inp6 != NULL);
+	assert(inp7 != NULL);
+	assert(out0 != NULL);
+	assert(out1 != NULL);
+	assert(out2 != NULL);
+	assert(out3 != NULL);
+	assert(out4 != NULL);
+	assert(out5 != NULL);
+	assert(out6 != NULL);
+	assert(out7 != NULL);
+	assert(inplen != 0);
+	assert(otplen != 0);
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+
+	size_t nblocks = otplen / QSC_KECCAK_128_RATE;
+	uint8_t t[8][QSC_KECCAK_128_RATE] = { 0 };
+	__m512i state[QSC_KECCAK_STATE_SIZE] = { 0 };
+
+	qsc_keccakx8_absorb(state, qsc_keccak_rate_128, inp0, inp1, inp2, inp3, inp4, inp5, inp6, inp7, inplen, QSC_KECCAK_SHAKE_DOMAIN_ID);
+
+	if (otplen >= QSC_KECCAK_128_RATE)
+	{
+		qsc_keccakx8_squeezeblocks(state, qsc_keccak_rate_128, out0, out1, out2, out3, out4, out5, out6, out7, nblocks);
+
+		out0 += nblocks * QSC_KECCAK_128_RATE;
+		out1 += nblocks * QSC_KECCAK_128_RATE;
+		out2 += nblocks * QSC_KECCAK_128_RATE;
+		out3 += nblocks * QSC_KECCAK_128_RATE;
+		out4 += nblocks * QSC_KECCAK_128_RATE;
+		out5 += nblocks * QSC_KECCAK_128_RATE;
+		out6 += nblocks * QSC_KECCAK_128_RATE;
+		out7 += nblocks * QSC_KECCAK_128_RATE;
+		otplen -= nblocks * QSC_KECCAK_128_RATE;
+	}
+
+	if (otplen != 0)
+	{
+		qsc_keccakx8_squeezeblocks(state, qsc_keccak_rate_128, t[0], t[1], t[2], t[3], t[4], t[5], t[6], t[7], 1);
+
+		for (size_t i = 0; i < otplen; ++i)
+		{
+			out0[i] = t[0][i];
+			out1[i] = t[1][i];
+			out2[i] = t[2][i];
+			out3[i] = t[3][i];
+			out4[i] = t[4][i];
+			out5[i] = t[5][i];
+			out6[i] = t[6][i];
+			out7[i] = t[7][i];
+		}
+	}
+
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+
+	qsc_shake_128x4(out0, out1, out2, out3, otplen, inp0, inp1, inp2, inp3, inplen);
+	qsc_shake_128x4(out4, out5, out6, out7, otplen, inp4, inp5, inp6, inp7, inplen);
+
+#else
+
+	qsc_shake128_compute(out0, otplen, inp0, inplen);
+	qsc_shake128_compute(out1, otplen, inp1, inplen);
+	qsc_shake128_compute(out2, otplen, inp2, inplen);
+	qsc_shake128_compute(out3, otplen, inp3, inplen);
+	qsc_shake128_compute(out4, otplen, inp4, inplen);
+	qsc_shake128_compute(out5, otplen, inp5, inplen);
+	qsc_shake128_compute(out6, otplen, inp6, inplen);
+	qsc_shake128_compute(out7, otplen, inp7, inplen);
+
+#endif
+}
+
+void qsc_shake_256x8(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
+	uint8_t* out4, uint8_t* out5, uint8_t* out6, uint8_t* out7, size_t otplen,
+	const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3,
+	const uint8_t* inp4, const uint8_t* inp5, const uint8_t* inp6, const uint8_t* inp7, size_t inplen)
+{
+	assert(inp0 != NULL);
+	assert(inp1 != NULL);
+	assert(inp2 != NULL);
+	assert(inp3 != NULL);
+	assert(inp4 != NULL);
+	assert(inp5 != NULL);
+	assert(inp6 != NULL);
+	assert(inp7 != NULL);
+	assert(out0 != NULL);
+	assert(out1 != NULL);
+	assert(out2 != NULL);
+	assert(out3 != NULL);
+	assert(out4 != NULL);
+	assert(out5 != NULL);
+	assert(out6 != NULL);
+	assert(out7 != NULL);
+	assert(inplen != 0);
+	assert(otplen != 0);
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+
+	size_t nblocks = otplen / QSC_KECCAK_256_RATE;
+	uint8_t t[8][QSC_KECCAK_256_RATE] = { 0 };
+	__m512i state[QSC_KECCAK_STATE_SIZE] = { 0 };
+
+	qsc_keccakx8_absorb(state, qsc_keccak_rate_256, inp0, inp1, inp2, inp3, inp4, inp5, inp6, inp7, inplen, QSC_KECCAK_SHAKE_DOMAIN_ID);
+
+	if (otplen >= QSC_KECCAK_256_RATE)
+	{
+		qsc_keccakx8_squeezeblocks(state, qsc_keccak_rate_256, out0, out1, out2, out3, out4, out5, out6, out7, nblocks);
+
+		out0 += nblocks * QSC_KECCAK_256_RATE;
+		out1 += nblocks * QSC_KECCAK_256_RATE;
+		out2 += nblocks * QSC_KECCAK_256_RATE;
+		out3 += nblocks * QSC_KECCAK_256_RATE;
+		out4 += nblocks * QSC_KECCAK_256_RATE;
+		out5 += nblocks * QSC_KECCAK_256_RATE;
+		out6 += nblocks * QSC_KECCAK_256_RATE;
+		out7 += nblocks * QSC_KECCAK_256_RATE;
+		otplen -= nblocks * QSC_KECCAK_256_RATE;
+	}
+
+	if (otplen != 0)
+	{
+		qsc_keccakx8_squeezeblocks(state, qsc_keccak_rate_256, t[0], t[1], t[2], t[3], t[4], t[5], t[6], t[7], 1);
+
+		for (size_t i = 0; i < otplen; ++i)
+		{
+			out0[i] = t[0][i];
+			out1[i] = t[1][i];
+			out2[i] = t[2][i];
+			out3[i] = t[3][i];
+			out4[i] = t[4][i];
+			out5[i] = t[5][i];
+			out6[i] = t[6][i];
+			out7[i] = t[7][i];
+		}
+	}
+
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+
+	qsc_shake_256x4(out0, out1, out2, out3, otplen, inp0, inp1, inp2, inp3, inplen);
+	qsc_shake_256x4(out4, out5, out6, out7, otplen, inp4, inp5, inp6, inp7, inplen);
+
+#else
+
+	qsc_shake256_compute(out0, otplen, inp0, inplen);
+	qsc_shake256_compute(out1, otplen, inp1, inplen);
+	qsc_shake256_compute(out2, otplen, inp2, inplen);
+	qsc_shake256_compute(out3, otplen, inp3, inplen);
+	qsc_shake256_compute(out4, otplen, inp4, inplen);
+	qsc_shake256_compute(out5, otplen, inp5, inplen);
+	qsc_shake256_compute(out6, otplen, inp6, inplen);
+	qsc_shake256_compute(out7, otplen, inp7, inplen);
+
+#endif
+}
+
+void qsc_shake_512x8(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
+	uint8_t* out4, uint8_t* out5, uint8_t* out6, uint8_t* out7, size_t otplen,
+	const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3,
+	const uint8_t* inp4, const uint8_t* inp5, const uint8_t* inp6, const uint8_t* inp7, size_t inplen)
+{
+	assert(inp0 != NULL);
+	assert(inp1 != NULL);
+	assert(inp2 != NULL);
+	assert(inp3 != NULL);
+	assert(inp4 != NULL);
+	assert(inp5 != NULL);
+	assert(inp6 != NULL);
+	assert(inp7 != NULL);
+	assert(out0 != NULL);
+	assert(out1 != NULL);
+	assert(out2 != NULL);
+	assert(out3 != NULL);
+	assert(out4 != NULL);
+	assert(out5 != NULL);
+	assert(out6 != NULL);
+	assert(out7 != NULL);
+	assert(inplen != 0);
+	assert(otplen != 0);
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+
+	size_t nblocks = otplen / QSC_KECCAK_512_RATE;
+	uint8_t t[8][QSC_KECCAK_512_RATE] = { 0 };
+	__m512i state[QSC_KECCAK_STATE_SIZE] = { 0 };
+
+	qsc_keccakx8_absorb(state, qsc_keccak_rate_512, inp0, inp1, inp2, inp3, inp4, inp5, inp6, inp7, inplen, QSC_KECCAK_SHAKE_DOMAIN_ID);
+
+	if (otplen >= QSC_KECCAK_512_RATE)
+	{
+		qsc_keccakx8_squeezeblocks(state, qsc_keccak_rate_512, out0, out1, out2, out3, out4, out5, out6, out7, nblocks);
+
+		out0 += nblocks * QSC_KECCAK_512_RATE;
+		out1 += nblocks * QSC_KECCAK_512_RATE;
+		out2 += nblocks * QSC_KECCAK_512_RATE;
+		out3 += nblocks * QSC_KECCAK_512_RATE;
+		out4 += nblocks * QSC_KECCAK_512_RATE;
+		out5 += nblocks * QSC_KECCAK_512_RATE;
+		out6 += nblocks * QSC_KECCAK_512_RATE;
+		out7 += nblocks * QSC_KECCAK_512_RATE;
+		otplen -= nblocks * QSC_KECCAK_512_RATE;
+	}
+
+	if (otplen != 0)
+	{
+		qsc_keccakx8_squeezeblocks(state, qsc_keccak_rate_512, t[0], t[1], t[2], t[3], t[4], t[5], t[6], t[7], 1);
+
+		for (size_t i = 0; i < otplen; ++i)
+		{
+			out0[i] = t[0][i];
+			out1[i] = t[1][i];
+			out2[i] = t[2][i];
+			out3[i] = t[3][i];
+			out4[i] = t[4][i];
+			out5[i] = t[5][i];
+			out6[i] = t[6][i];
+			out7[i] = t[7][i];
 		}
 	}
 
@@ -6416,3 +7542,1877 @@ void qsc_kmac_512x8(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
 
 #endif
 }
+
+/* parallel cSHAKE */
+
+/* absorbs bytepad(encode_string(name) || encode_string(custom || suffix), rate); the suffix
+   carries the subkey index in the batch derivation, and is empty for the cSHAKE functions */
+static void cshake_customize(qsc_keccak_state* ctx, qsc_keccak_rate rate, const uint8_t* name, size_t nmelen,
+	const uint8_t* custom, size_t cstlen, const uint8_t* suffix, size_t sfxlen)
+{
+	uint8_t enc[2 * (sizeof(size_t) + 1)] = { 0 };
+	uint8_t zero[QSC_KECCAK_STATE_BYTE_SIZE] = { 0 };
+	size_t elen;
+	size_t len;
+
+	elen = keccak_left_encode(enc, (size_t)rate);
+	elen += keccak_left_encode(enc + elen, nmelen * 8);
+	qsc_keccak_incremental_absorb(ctx, (uint32_t)rate, enc, elen);
+	len = elen;
+
+	if (nmelen != 0)
+	{
+		qsc_keccak_incremental_absorb(ctx, (uint32_t)rate, name, nmelen);
+		len += nmelen;
+	}
+
+	elen = keccak_left_encode(enc, (cstlen + sfxlen) * 8);
+	qsc_keccak_incremental_absorb(ctx, (uint32_t)rate, enc, elen);
+	len += elen;
+
+	if (cstlen != 0)
+	{
+		qsc_keccak_incremental_absorb(ctx, (uint32_t)rate, custom, cstlen);
+		len += cstlen;
+	}
+
+	if (sfxlen != 0)
+	{
+		qsc_keccak_incremental_absorb(ctx, (uint32_t)rate, suffix, sfxlen);
+		len += sfxlen;
+	}
+
+	if (len % (size_t)rate != 0)
+	{
+		qsc_keccak_incremental_absorb(ctx, (uint32_t)rate, zero, (size_t)rate - (len % (size_t)rate));
+	}
+}
+
+static void cshake_compute_lane(uint8_t* output, size_t otplen, qsc_keccak_rate rate, const uint8_t* key, size_t keylen,
+	const uint8_t* name, size_t nmelen, const uint8_t* custom, size_t cstlen, const uint8_t* suffix, size_t sfxlen)
+{
+	qsc_keccak_state ctx;
+	uint8_t domain;
+
+	qsc_keccak_initialize_state(&ctx);
+	domain = QSC_KECCAK_SHAKE_DOMAIN_ID;
+
+	if (nmelen + cstlen + sfxlen != 0)
+	{
+		cshake_customize(&ctx, rate, name, nmelen, custom, cstlen, suffix, sfxlen);
+		domain = QSC_KECCAK_CSHAKE_DOMAIN_ID;
+	}
+
+	if (keylen != 0)
+	{
+		qsc_keccak_incremental_absorb(&ctx, (uint32_t)rate, key, keylen);
+	}
+
+	qsc_keccak_incremental_finalize(&ctx, (uint32_t)rate, domain);
+	qsc_keccak_incremental_squeeze(&ctx, (size_t)rate, output, otplen);
+	qsc_keccak_dispose(&ctx);
+}
+
+static void cshakex4_customize(qsc_keccakx4_state* ctx, qsc_keccak_rate rate, const uint8_t* const nme[4], size_t nmelen,
+	const uint8_t* const cst[4], size_t cstlen, const uint8_t* const sfx[4], size_t sfxlen)
+{
+	uint8_t enc[2 * (sizeof(size_t) + 1)] = { 0 };
+	uint8_t zero[QSC_KECCAK_STATE_BYTE_SIZE] = { 0 };
+	size_t elen;
+	size_t len;
+
+	/* the encoded lengths are the same in every lane */
+	elen = keccak_left_encode(enc, (size_t)rate);
+	elen += keccak_left_encode(enc + elen, nmelen * 8);
+	qsc_keccakx4_update(ctx, enc, enc, enc, enc, elen);
+	len = elen;
+
+	if (nmelen != 0)
+	{
+		qsc_keccakx4_update(ctx, nme[0], nme[1], nme[2], nme[3], nmelen);
+		len += nmelen;
+	}
+
+	elen = keccak_left_encode(enc, (cstlen + sfxlen) * 8);
+	qsc_keccakx4_update(ctx, enc, enc, enc, enc, elen);
+	len += elen;
+
+	if (cstlen != 0)
+	{
+		qsc_keccakx4_update(ctx, cst[0], cst[1], cst[2], cst[3], cstlen);
+		len += cstlen;
+	}
+
+	if (sfxlen != 0)
+	{
+		qsc_keccakx4_update(ctx, sfx[0], sfx[1], sfx[2], sfx[3], sfxlen);
+		len += sfxlen;
+	}
+
+	if (len % (size_t)rate != 0)
+	{
+		qsc_keccakx4_update(ctx, zero, zero, zero, zero, (size_t)rate - (len % (size_t)rate));
+	}
+}
+
+static void cshakex4_compute(uint8_t* const out[4], size_t otplen, qsc_keccak_rate rate, const uint8_t* const key[4], size_t keylen,
+	const uint8_t* const nme[4], size_t nmelen, const uint8_t* const cst[4], size_t cstlen, const uint8_t* const sfx[4], size_t sfxlen)
+{
+	qsc_keccakx4_state ctx;
+	uint8_t domain;
+
+	qsc_keccakx4_initialize(&ctx, rate);
+	domain = QSC_KECCAK_SHAKE_DOMAIN_ID;
+
+	if (nmelen + cstlen + sfxlen != 0)
+	{
+		cshakex4_customize(&ctx, rate, nme, nmelen, cst, cstlen, sfx, sfxlen);
+		domain = QSC_KECCAK_CSHAKE_DOMAIN_ID;
+	}
+
+	if (keylen != 0)
+	{
+		qsc_keccakx4_update(&ctx, key[0], key[1], key[2], key[3], keylen);
+	}
+
+	qsc_keccakx4_finalize(&ctx, domain);
+	qsc_keccakx4_squeeze(&ctx, out[0], out[1], out[2], out[3], otplen);
+	qsc_keccakx4_dispose(&ctx);
+}
+
+static void cshakex8_customize(qsc_keccakx8_state* ctx, qsc_keccak_rate rate, const uint8_t* const nme[8], size_t nmelen,
+	const uint8_t* const cst[8], size_t cstlen, const uint8_t* const sfx[8], size_t sfxlen)
+{
+	uint8_t enc[2 * (sizeof(size_t) + 1)] = { 0 };
+	uint8_t zero[QSC_KECCAK_STATE_BYTE_SIZE] = { 0 };
+	size_t elen;
+	size_t len;
+
+	/* the encoded lengths are the same in every lane */
+	elen = keccak_left_encode(enc, (size_t)rate);
+	elen += keccak_left_encode(enc + elen, nmelen * 8);
+	qsc_keccakx8_update(ctx, enc, enc, enc, enc, enc, enc, enc, enc, elen);
+	len = elen;
+
+	if (nmelen != 0)
+	{
+		qsc_keccakx8_update(ctx, nme[0], nme[1], nme[2], nme[3], nme[4], nme[5], nme[6], nme[7], nmelen);
+		len += nmelen;
+	}
+
+	elen = keccak_left_encode(enc, (cstlen + sfxlen) * 8);
+	qsc_keccakx8_update(ctx, enc, enc, enc, enc, enc, enc, enc, enc, elen);
+	len += elen;
+
+	if (cstlen != 0)
+	{
+		qsc_keccakx8_update(ctx, cst[0], cst[1], cst[2], cst[3], cst[4], cst[5], cst[6], cst[7], cstlen);
+		len += cstlen;
+	}
+
+	if (sfxlen != 0)
+	{
+		qsc_keccakx8_update(ctx, sfx[0], sfx[1], sfx[2], sfx[3], sfx[4], sfx[5], sfx[6], sfx[7], sfxlen);
+		len += sfxlen;
+	}
+
+	if (len % (size_t)rate != 0)
+	{
+		qsc_keccakx8_update(ctx, zero, zero, zero, zero, zero, zero, zero, zero, (size_t)rate - (len % (size_t)rate));
+	}
+}
+
+static void cshakex8_compute(uint8_t* const out[8], size_t otplen, qsc_keccak_rate rate, const uint8_t* const key[8], size_t keylen,
+	const uint8_t* const nme[8], size_t nmelen, const uint8_t* const cst[8], size_t cstlen, const uint8_t* const sfx[8], size_t sfxlen)
+{
+	qsc_keccakx8_state ctx;
+	uint8_t domain;
+
+	qsc_keccakx8_initialize(&ctx, rate);
+	domain = QSC_KECCAK_SHAKE_DOMAIN_ID;
+
+	if (nmelen + cstlen + sfxlen != 0)
+	{
+		cshakex8_customize(&ctx, rate, nme, nmelen, cst, cstlen, sfx, sfxlen);
+		domain = QSC_KECCAK_CSHAKE_DOMAIN_ID;
+	}
+
+	if (keylen != 0)
+	{
+		qsc_keccakx8_update(&ctx, key[0], key[1], key[2], key[3], key[4], key[5], key[6], key[7], keylen);
+	}
+
+	qsc_keccakx8_finalize(&ctx, domain);
+	qsc_keccakx8_squeeze(&ctx, out[0], out[1], out[2], out[3], out[4], out[5], out[6], out[7], otplen);
+	qsc_keccakx8_dispose(&ctx);
+}
+
+void qsc_cshake_128x4(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3, size_t otplen,
+	const uint8_t* key0, const uint8_t* key1, const uint8_t* key2, const uint8_t* key3, size_t keylen,
+	const uint8_t* nme0, const uint8_t* nme1, const uint8_t* nme2, const uint8_t* nme3, size_t nmelen,
+	const uint8_t* cst0, const uint8_t* cst1, const uint8_t* cst2, const uint8_t* cst3, size_t cstlen)
+{
+	assert(out0 != NULL);
+	assert(out1 != NULL);
+	assert(out2 != NULL);
+	assert(out3 != NULL);
+	assert(key0 != NULL);
+	assert(key1 != NULL);
+	assert(key2 != NULL);
+	assert(key3 != NULL);
+	assert(otplen != 0);
+
+	uint8_t* const out[4] = { out0, out1, out2, out3 };
+	const uint8_t* const key[4] = { key0, key1, key2, key3 };
+	const uint8_t* const nme[4] = { nme0, nme1, nme2, nme3 };
+	const uint8_t* const cst[4] = { cst0, cst1, cst2, cst3 };
+
+	cshakex4_compute(out, otplen, qsc_keccak_rate_128, key, keylen, nme, nmelen, cst, cstlen, NULL, 0);
+}
+
+void qsc_cshake_256x4(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3, size_t otplen,
+	const uint8_t* key0, const uint8_t* key1, const uint8_t* key2, const uint8_t* key3, size_t keylen,
+	const uint8_t* nme0, const uint8_t* nme1, const uint8_t* nme2, const uint8_t* nme3, size_t nmelen,
+	const uint8_t* cst0, const uint8_t* cst1, const uint8_t* cst2, const uint8_t* cst3, size_t cstlen)
+{
+	assert(out0 != NULL);
+	assert(out1 != NULL);
+	assert(out2 != NULL);
+	assert(out3 != NULL);
+	assert(key0 != NULL);
+	assert(key1 != NULL);
+	assert(key2 != NULL);
+	assert(key3 != NULL);
+	assert(otplen != 0);
+
+	uint8_t* const out[4] = { out0, out1, out2, out3 };
+	const uint8_t* const key[4] = { key0, key1, key2, key3 };
+	const uint8_t* const nme[4] = { nme0, nme1, nme2, nme3 };
+	const uint8_t* const cst[4] = { cst0, cst1, cst2, cst3 };
+
+	cshakex4_compute(out, otplen, qsc_keccak_rate_256, key, keylen, nme, nmelen, cst, cstlen, NULL, 0);
+}
+
+void qsc_cshake_512x4(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3, size_t otplen,
+	const uint8_t* key0, const uint8_t* key1, const uint8_t* key2, const uint8_t* key3, size_t keylen,
+	const uint8_t* nme0, const uint8_t* nme1, const uint8_t* nme2, const uint8_t* nme3, size_t nmelen,
+	const uint8_t* cst0, const uint8_t* cst1, const uint8_t* cst2, const uint8_t* cst3, size_t cstlen)
+{
+	assert(out0 != NULL);
+	assert(out1 != NULL);
+	assert(out2 != NULL);
+	assert(out3 != NULL);
+	assert(key0 != NULL);
+	assert(key1 != NULL);
+	assert(key2 != NULL);
+	assert(key3 != NULL);
+	assert(otplen != 0);
+
+	uint8_t* const out[4] = { out0, out1, out2, out3 };
+	const uint8_t* const key[4] = { key0, key1, key2, key3 };
+	const uint8_t* const nme[4] = { nme0, nme1, nme2, nme3 };
+	const uint8_t* const cst[4] = { cst0, cst1, cst2, cst3 };
+
+	cshakex4_compute(out, otplen, qsc_keccak_rate_512, key, keylen, nme, nmelen, cst, cstlen, NULL, 0);
+}
+
+void qsc_cshake_128x8(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
+	uint8_t* out4, uint8_t* out5, uint8_t* out6, uint8_t* out7, size_t otplen,
+	const uint8_t* key0, const uint8_t* key1, const uint8_t* key2, const uint8_t* key3,
+	const uint8_t* key4, const uint8_t* key5, const uint8_t* key6, const uint8_t* key7, size_t keylen,
+	const uint8_t* nme0, const uint8_t* nme1, const uint8_t* nme2, const uint8_t* nme3,
+	const uint8_t* nme4, const uint8_t* nme5, const uint8_t* nme6, const uint8_t* nme7, size_t nmelen,
+	const uint8_t* cst0, const uint8_t* cst1, const uint8_t* cst2, const uint8_t* cst3,
+	const uint8_t* cst4, const uint8_t* cst5, const uint8_t* cst6, const uint8_t* cst7, size_t cstlen)
+{
+	assert(out0 != NULL);
+	assert(out1 != NULL);
+	assert(out2 != NULL);
+	assert(out3 != NULL);
+	assert(out4 != NULL);
+	assert(out5 != NULL);
+	assert(out6 != NULL);
+	assert(out7 != NULL);
+	assert(key0 != NULL);
+	assert(key1 != NULL);
+	assert(key2 != NULL);
+	assert(key3 != NULL);
+	assert(key4 != NULL);
+	assert(key5 != NULL);
+	assert(key6 != NULL);
+	assert(key7 != NULL);
+	assert(otplen != 0);
+
+	uint8_t* const out[8] = { out0, out1, out2, out3, out4, out5, out6, out7 };
+	const uint8_t* const key[8] = { key0, key1, key2, key3, key4, key5, key6, key7 };
+	const uint8_t* const nme[8] = { nme0, nme1, nme2, nme3, nme4, nme5, nme6, nme7 };
+	const uint8_t* const cst[8] = { cst0, cst1, cst2, cst3, cst4, cst5, cst6, cst7 };
+
+	cshakex8_compute(out, otplen, qsc_keccak_rate_128, key, keylen, nme, nmelen, cst, cstlen, NULL, 0);
+}
+
+void qsc_cshake_256x8(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
+	uint8_t* out4, uint8_t* out5, uint8_t* out6, uint8_t* out7, size_t otplen,
+	const uint8_t* key0, const uint8_t* key1, const uint8_t* key2, const uint8_t* key3,
+	const uint8_t* key4, const uint8_t* key5, const uint8_t* key6, const uint8_t* key7, size_t keylen,
+	const uint8_t* nme0, const uint8_t* nme1, const uint8_t* nme2, const uint8_t* nme3,
+	const uint8_t* nme4, const uint8_t* nme5, const uint8_t* nme6, const uint8_t* nme7, size_t nmelen,
+	const uint8_t* cst0, const uint8_t* cst1, const uint8_t* cst2, const uint8_t* cst3,
+	const uint8_t* cst4, const uint8_t* cst5, const uint8_t* cst6, const uint8_t* cst7, size_t cstlen)
+{
+	assert(out0 != NULL);
+	assert(out1 != NULL);
+	assert(out2 != NULL);
+	assert(out3 != NULL);
+	assert(out4 != NULL);
+	assert(out5 != NULL);
+	assert(out6 != NULL);
+	assert(out7 != NULL);
+	assert(key0 != NULL);
+	assert(key1 != NULL);
+	assert(key2 != NULL);
+	assert(key3 != NULL);
+	assert(key4 != NULL);
+	assert(key5 != NULL);
+	assert(key6 != NULL);
+	assert(key7 != NULL);
+	assert(otplen != 0);
+
+	uint8_t* const out[8] = { out0, out1, out2, out3, out4, out5, out6, out7 };
+	const uint8_t* const key[8] = { key0, key1, key2, key3, key4, key5, key6, key7 };
+	const uint8_t* const nme[8] = { nme0, nme1, nme2, nme3, nme4, nme5, nme6, nme7 };
+	const uint8_t* const cst[8] = { cst0, cst1, cst2, cst3, cst4, cst5, cst6, cst7 };
+
+	cshakex8_compute(out, otplen, qsc_keccak_rate_256, key, keylen, nme, nmelen, cst, cstlen, NULL, 0);
+}
+
+void qsc_cshake_512x8(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
+	uint8_t* out4, uint8_t* out5, uint8_t* out6, uint8_t* out7, size_t otplen,
+	const uint8_t* key0, const uint8_t* key1, const uint8_t* key2, const uint8_t* key3,
+	const uint8_t* key4, const uint8_t* key5, const uint8_t* key6, const uint8_t* key7, size_t keylen,
+	const uint8_t* nme0, const uint8_t* nme1, const uint8_t* nme2, const uint8_t* nme3,
+	const uint8_t* nme4, const uint8_t* nme5, const uint8_t* nme6, const uint8_t* nme7, size_t nmelen,
+	const uint8_t* cst0, const uint8_t* cst1, const uint8_t* cst2, const uint8_t* cst3,
+	const uint8_t* cst4, const uint8_t* cst5, const uint8_t* cst6, const uint8_t* cst7, size_t cstlen)
+{
+	assert(out0 != NULL);
+	assert(out1 != NULL);
+	assert(out2 != NULL);
+	assert(out3 != NULL);
+	assert(out4 != NULL);
+	assert(out5 != NULL);
+	assert(out6 != NULL);
+	assert(out7 != NULL);
+	assert(key0 != NULL);
+	assert(key1 != NULL);
+	assert(key2 != NULL);
+	assert(key3 != NULL);
+	assert(key4 != NULL);
+	assert(key5 != NULL);
+	assert(key6 != NULL);
+	assert(key7 != NULL);
+	assert(otplen != 0);
+
+	uint8_t* const out[8] = { out0, out1, out2, out3, out4, out5, out6, out7 };
+	const uint8_t* const key[8] = { key0, key1, key2, key3, key4, key5, key6, key7 };
+	const uint8_t* const nme[8] = { nme0, nme1, nme2, nme3, nme4, nme5, nme6, nme7 };
+	const uint8_t* const cst[8] = { cst0, cst1, cst2, cst3, cst4, cst5, cst6, cst7 };
+
+	cshakex8_compute(out, otplen, qsc_keccak_rate_512, key, keylen, nme, nmelen, cst, cstlen, NULL, 0);
+}
+
+/* batch cSHAKE key derivation */
+
+void qsc_cshake_kdf_batch(uint8_t* output, size_t otplen, size_t count, qsc_keccak_rate rate, const uint8_t* key, size_t keylen,
+	const uint8_t* name, size_t namelen, const uint8_t* custom, size_t custlen)
+{
+	assert(output != NULL);
+	assert(key != NULL);
+	assert(otplen != 0);
+
+	uint8_t ctr[8][sizeof(uint32_t)] = { 0 };
+	uint8_t* out[8];
+	const uint8_t* key8[8];
+	const uint8_t* nme8[8];
+	const uint8_t* cst8[8];
+	const uint8_t* sfx8[8];
+	size_t i;
+	size_t j;
+
+	/* every lane shares the key, name and customization string, and differs by the index suffix */
+	for (j = 0; j < 8; ++j)
+	{
+		key8[j] = key;
+		nme8[j] = name;
+		cst8[j] = custom;
+		sfx8[j] = ctr[j];
+	}
+
+	i = 0;
+
+	while (count - i >= 8)
+	{
+		for (j = 0; j < 8; ++j)
+		{
+			qsc_intutils_be32to8(ctr[j], (uint32_t)(i + j));
+			out[j] = output + ((i + j) * otplen);
+		}
+
+		cshakex8_compute(out, otplen, rate, key8, keylen, nme8, namelen, cst8, custlen, sfx8, sizeof(uint32_t));
+		i += 8;
+	}
+
+	if (count - i >= 4)
+	{
+		for (j = 0; j < 4; ++j)
+		{
+			qsc_intutils_be32to8(ctr[j], (uint32_t)(i + j));
+			out[j] = output + ((i + j) * otplen);
+		}
+
+		cshakex4_compute(out, otplen, rate, key8, keylen, nme8, namelen, cst8, custlen, sfx8, sizeof(uint32_t));
+		i += 4;
+	}
+
+	for (; i < count; ++i)
+	{
+		qsc_intutils_be32to8(ctr[0], (uint32_t)i);
+		cshake_compute_lane(output + (i * otplen), otplen, rate, key, keylen, name, namelen, custom, custlen, ctr[0], sizeof(uint32_t));
+	}
+}
+
+/* fixed-length hashing */
+
+/* the key and input are whole lanes that fit in a single block, so the lanes are written
+   directly to a zeroed state followed by the domain byte and the final padding bit */
+static void keccak_fixed_load(uint64_t state[QSC_KECCAK_STATE_SIZE], const uint8_t* key, size_t keylen, const uint8_t* input, size_t inplen, uint8_t domain)
+{
+	size_t i;
+	size_t j;
+
+	for (i = 0; i < keylen / sizeof(uint64_t); ++i)
+	{
+		state[i] = qsc_intutils_le8to64(key + (i * sizeof(uint64_t)));
+	}
+
+	for (j = 0; j < inplen / sizeof(uint64_t); ++i, ++j)
+	{
+		state[i] = qsc_intutils_le8to64(input + (j * sizeof(uint64_t)));
+	}
+
+	state[i] = domain;
+	++i;
+
+	for (; i < QSC_KECCAK_STATE_SIZE; ++i)
+	{
+		state[i] = 0;
+	}
+
+	state[(QSC_KECCAK_256_RATE / sizeof(uint64_t)) - 1] ^= 0x8000000000000000ULL;
+}
+
+static void keccak_fixed_store(uint8_t* output, size_t otplen, const uint64_t state[QSC_KECCAK_STATE_SIZE])
+{
+	uint8_t tmp[sizeof(uint64_t)];
+	size_t i;
+
+	for (i = 0; i < otplen / sizeof(uint64_t); ++i)
+	{
+		qsc_intutils_le64to8(output + (i * sizeof(uint64_t)), state[i]);
+	}
+
+	if (otplen % sizeof(uint64_t) != 0)
+	{
+		qsc_intutils_le64to8(tmp, state[i]);
+		qsc_memutils_copy(output + (i * sizeof(uint64_t)), tmp, otplen % sizeof(uint64_t));
+	}
+}
+
+static void keccak_fixed_compute(uint8_t* output, size_t otplen, const uint8_t* key, size_t keylen, const uint8_t* input, size_t inplen, uint8_t domain)
+{
+	uint64_t state[QSC_KECCAK_STATE_SIZE];
+
+	keccak_fixed_load(state, key, keylen, input, inplen, domain);
+#if defined(QSC_KECCAK_UNROLLED_PERMUTATION)
+	qsc_keccak_permute_p1600u(state);
+#else
+	qsc_keccak_permute_p1600c(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+#endif
+	keccak_fixed_store(output, otplen, state);
+
+	if (keylen != 0)
+	{
+		qsc_memutils_clear((uint8_t*)state, sizeof(state));
+	}
+}
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+
+static void keccakx4_fixed_load(__m256i state[QSC_KECCAK_STATE_SIZE], const uint8_t* key, size_t keylen, const uint8_t* input, size_t inplen, uint8_t domain)
+{
+	/* lane j of instance k is gathered from input + (k * inplen) + (j * 8), the key lanes are shared */
+	const __m256i IDX = _mm256_set_epi64x((int64_t)(3 * inplen), (int64_t)(2 * inplen), (int64_t)inplen, 0);
+	size_t i;
+	size_t j;
+
+	for (i = 0; i < keylen / sizeof(uint64_t); ++i)
+	{
+		state[i] = _mm256_set1_epi64x((int64_t)qsc_intutils_le8to64(key + (i * sizeof(uint64_t))));
+	}
+
+	for (j = 0; j < inplen / sizeof(uint64_t); ++i, ++j)
+	{
+		state[i] = _mm256_i64gather_epi64((const long long*)(input + (j * sizeof(uint64_t))), IDX, 1);
+	}
+
+	state[i] = _mm256_set1_epi64x((int64_t)domain);
+	++i;
+
+	for (; i < QSC_KECCAK_STATE_SIZE; ++i)
+	{
+		state[i] = _mm256_setzero_si256();
+	}
+
+	i = (QSC_KECCAK_256_RATE / sizeof(uint64_t)) - 1;
+	state[i] = _mm256_xor_si256(state[i], _mm256_set1_epi64x((int64_t)0x8000000000000000ULL));
+}
+
+static void keccakx4_fixed_store(uint8_t* output, size_t otplen, const __m256i state[QSC_KECCAK_STATE_SIZE])
+{
+	uint64_t lanes[QSC_KECCAK_256_RATE / sizeof(uint64_t)][4];
+	uint8_t tmp[sizeof(uint64_t)];
+	const size_t LCNT = (otplen + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+	size_t i;
+	size_t k;
+
+	for (i = 0; i < LCNT; ++i)
+	{
+		_mm256_storeu_si256((__m256i*)lanes[i], state[i]);
+	}
+
+	for (k = 0; k < 4; ++k)
+	{
+		for (i = 0; i < otplen / sizeof(uint64_t); ++i)
+		{
+			qsc_intutils_le64to8(output + (i * sizeof(uint64_t)), lanes[i][k]);
+		}
+
+		if (otplen % sizeof(uint64_t) != 0)
+		{
+			qsc_intutils_le64to8(tmp, lanes[i][k]);
+			qsc_memutils_copy(output + (i * sizeof(uint64_t)), tmp, otplen % sizeof(uint64_t));
+		}
+
+		output += otplen;
+	}
+}
+
+#endif
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+
+static void keccakx8_fixed_load(__m512i state[QSC_KECCAK_STATE_SIZE], const uint8_t* key, size_t keylen, const uint8_t* input, size_t inplen, uint8_t domain)
+{
+	/* lane j of instance k is gathered from input + (k * inplen) + (j * 8), the key lanes are shared */
+	const __m512i IDX = _mm512_set_epi64((int64_t)(7 * inplen), (int64_t)(6 * inplen), (int64_t)(5 * inplen), (int64_t)(4 * inplen),
+		(int64_t)(3 * inplen), (int64_t)(2 * inplen), (int64_t)inplen, 0);
+	size_t i;
+	size_t j;
+
+	for (i = 0; i < keylen / sizeof(uint64_t); ++i)
+	{
+		state[i] = _mm512_set1_epi64((int64_t)qsc_intutils_le8to64(key + (i * sizeof(uint64_t))));
+	}
+
+	for (j = 0; j < inplen / sizeof(uint64_t); ++i, ++j)
+	{
+		state[i] = _mm512_i64gather_epi64(IDX, (const long long*)(input + (j * sizeof(uint64_t))), 1);
+	}
+
+	state[i] = _mm512_set1_epi64((int64_t)domain);
+	++i;
+
+	for (; i < QSC_KECCAK_STATE_SIZE; ++i)
+	{
+		state[i] = _mm512_setzero_si512();
+	}
+
+	i = (QSC_KECCAK_256_RATE / sizeof(uint64_t)) - 1;
+	state[i] = _mm512_xor_si512(state[i], _mm512_set1_epi64((int64_t)0x8000000000000000ULL));
+}
+
+static void keccakx8_fixed_store(uint8_t* output, size_t otplen, const __m512i state[QSC_KECCAK_STATE_SIZE])
+{
+	uint64_t lanes[QSC_KECCAK_256_RATE / sizeof(uint64_t)][8];
+	uint8_t tmp[sizeof(uint64_t)];
+	const size_t LCNT = (otplen + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+	size_t i;
+	size_t k;
+
+	for (i = 0; i < LCNT; ++i)
+	{
+		_mm512_storeu_si512((__m512i*)lanes[i], state[i]);
+	}
+
+	for (k = 0; k < 8; ++k)
+	{
+		for (i = 0; i < otplen / sizeof(uint64_t); ++i)
+		{
+			qsc_intutils_le64to8(output + (i * sizeof(uint64_t)), lanes[i][k]);
+		}
+
+		if (otplen % sizeof(uint64_t) != 0)
+		{
+			qsc_intutils_le64to8(tmp, lanes[i][k]);
+			qsc_memutils_copy(output + (i * sizeof(uint64_t)), tmp, otplen % sizeof(uint64_t));
+		}
+
+		output += otplen;
+	}
+}
+
+#endif
+
+static void keccak_fixed_computex4(uint8_t* output, size_t otplen, const uint8_t* key, size_t keylen, const uint8_t* input, size_t inplen, uint8_t domain)
+{
+#if defined(QSC_SYSTEM_HAS_AVX2)
+
+	__m256i state[QSC_KECCAK_STATE_SIZE];
+
+	keccakx4_fixed_load(state, key, keylen, input, inplen, domain);
+	qsc_keccak_permute_p4x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+	keccakx4_fixed_store(output, otplen, state);
+
+	if (keylen != 0)
+	{
+		qsc_memutils_clear((uint8_t*)state, sizeof(state));
+	}
+
+#else
+
+	for (size_t i = 0; i < 4; ++i)
+	{
+		keccak_fixed_compute(output + (i * otplen), otplen, key, keylen, input + (i * inplen), inplen, domain);
+	}
+
+#endif
+}
+
+static void keccak_fixed_computex8(uint8_t* output, size_t otplen, const uint8_t* key, size_t keylen, const uint8_t* input, size_t inplen, uint8_t domain)
+{
+#if defined(QSC_SYSTEM_HAS_AVX512)
+
+	__m512i state[QSC_KECCAK_STATE_SIZE];
+
+	keccakx8_fixed_load(state, key, keylen, input, inplen, domain);
+	qsc_keccak_permute_p8x1600(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+	keccakx8_fixed_store(output, otplen, state);
+
+	if (keylen != 0)
+	{
+		qsc_memutils_clear((uint8_t*)state, sizeof(state));
+	}
+
+#else
+
+	keccak_fixed_computex4(output, otplen, key, keylen, input, inplen, domain);
+	keccak_fixed_computex4(output + (4 * otplen), otplen, key, keylen, input + (4 * inplen), inplen, domain);
+
+#endif
+}
+
+void qsc_sha3_node256(uint8_t* output, const uint8_t* input)
+{
+	assert(output != NULL);
+	assert(input != NULL);
+
+	keccak_fixed_compute(output, QSC_SHA3_256_HASH_SIZE, NULL, 0, input, 2 * QSC_KECCAK_NODE_SIZE, QSC_KECCAK_SHA3_DOMAIN_ID);
+}
+
+void qsc_sha3_node256x4(uint8_t* output, const uint8_t* input)
+{
+	assert(output != NULL);
+	assert(input != NULL);
+
+	keccak_fixed_computex4(output, QSC_SHA3_256_HASH_SIZE, NULL, 0, input, 2 * QSC_KECCAK_NODE_SIZE, QSC_KECCAK_SHA3_DOMAIN_ID);
+}
+
+void qsc_sha3_node256x8(uint8_t* output, const uint8_t* input)
+{
+	assert(output != NULL);
+	assert(input != NULL);
+
+	keccak_fixed_computex8(output, QSC_SHA3_256_HASH_SIZE, NULL, 0, input, 2 * QSC_KECCAK_NODE_SIZE, QSC_KECCAK_SHA3_DOMAIN_ID);
+}
+
+void qsc_shake256_node(uint8_t* output, const uint8_t* input)
+{
+	assert(output != NULL);
+	assert(input != NULL);
+
+	keccak_fixed_compute(output, QSC_KECCAK_NODE_SIZE, NULL, 0, input, 2 * QSC_KECCAK_NODE_SIZE, QSC_KECCAK_SHAKE_DOMAIN_ID);
+}
+
+void qsc_shake256_nodex4(uint8_t* output, const uint8_t* input)
+{
+	assert(output != NULL);
+	assert(input != NULL);
+
+	keccak_fixed_computex4(output, QSC_KECCAK_NODE_SIZE, NULL, 0, input, 2 * QSC_KECCAK_NODE_SIZE, QSC_KECCAK_SHAKE_DOMAIN_ID);
+}
+
+void qsc_shake256_nodex8(uint8_t* output, const uint8_t* input)
+{
+	assert(output != NULL);
+	assert(input != NULL);
+
+	keccak_fixed_computex8(output, QSC_KECCAK_NODE_SIZE, NULL, 0, input, 2 * QSC_KECCAK_NODE_SIZE, QSC_KECCAK_SHAKE_DOMAIN_ID);
+}
+
+void qsc_shake256_prf(uint8_t* output, size_t otplen, const uint8_t* key, const uint8_t* input)
+{
+	assert(output != NULL);
+	assert(key != NULL);
+	assert(input != NULL);
+	assert(otplen <= QSC_KECCAK_256_RATE);
+
+	if (otplen <= QSC_KECCAK_256_RATE)
+	{
+		keccak_fixed_compute(output, otplen, key, QSC_KECCAK_NODE_SIZE, input, QSC_KECCAK_NODE_SIZE, QSC_KECCAK_SHAKE_DOMAIN_ID);
+	}
+}
+
+void qsc_shake256_prfx4(uint8_t* output, size_t otplen, const uint8_t* key, const uint8_t* input)
+{
+	assert(output != NULL);
+	assert(key != NULL);
+	assert(input != NULL);
+	assert(otplen <= QSC_KECCAK_256_RATE);
+
+	if (otplen <= QSC_KECCAK_256_RATE)
+	{
+		keccak_fixed_computex4(output, otplen, key, QSC_KECCAK_NODE_SIZE, input, QSC_KECCAK_NODE_SIZE, QSC_KECCAK_SHAKE_DOMAIN_ID);
+	}
+}
+
+void qsc_shake256_prfx8(uint8_t* output, size_t otplen, const uint8_t* key, const uint8_t* input)
+{
+	assert(output != NULL);
+	assert(key != NULL);
+	assert(input != NULL);
+	assert(otplen <= QSC_KECCAK_256_RATE);
+
+	if (otplen <= QSC_KECCAK_256_RATE)
+	{
+		keccak_fixed_computex8(output, otplen, key, QSC_KECCAK_NODE_SIZE, input, QSC_KECCAK_NODE_SIZE, QSC_KECCAK_SHAKE_DOMAIN_ID);
+	}
+}
+
+/* multi-buffer Keccak */
+
+#if defined(QSC_SYSTEM_HAS_AVX512) || defined(QSC_SYSTEM_HAS_AVX2)
+
+typedef struct
+{
+	uint64_t state[QSC_KECCAK_STATE_SIZE][QSC_KECCAK_JOB_LANES];
+	uint8_t head[QSC_KECCAK_JOB_LANES][2][QSC_KECCAK_128_RATE];
+	uint8_t tail[QSC_KECCAK_JOB_LANES][2][QSC_KECCAK_128_RATE];
+	qsc_keccak_job* job[QSC_KECCAK_JOB_LANES];
+	size_t hblocks[QSC_KECCAK_JOB_LANES];
+	size_t blocks[QSC_KECCAK_JOB_LANES];
+	size_t absorbed[QSC_KECCAK_JOB_LANES];
+	size_t position[QSC_KECCAK_JOB_LANES];
+} keccak_job_lanes;
+
+static size_t keccak_job_output_size(const qsc_keccak_job* job)
+{
+	size_t olen;
+
+	if (job->function == qsc_keccak_job_sha3)
+	{
+		olen = (QSC_KECCAK_STATE_BYTE_SIZE - (size_t)job->rate) / 2;
+	}
+	else
+	{
+		olen = job->otplen;
+	}
+
+	return olen;
+}
+
+static size_t keccak_job_cost(const qsc_keccak_job* job)
+{
+	size_t cost;
+
+	/* the number of permutation calls the job requires */
+	cost = (job->msglen / (size_t)job->rate) + (keccak_job_output_size(job) / (size_t)job->rate) + 1;
+
+	if (job->function == qsc_keccak_job_kmac)
+	{
+		cost += 2;
+	}
+
+	return cost;
+}
+
+static int keccak_job_compare(const void* a, const void* b)
+{
+	const size_t CA = keccak_job_cost(*(qsc_keccak_job* const*)a);
+	const size_t CB = keccak_job_cost(*(qsc_keccak_job* const*)b);
+
+	/* longest first, so jobs in the same lanes complete together */
+	return (CA < CB) ? 1 : ((CA > CB) ? -1 : 0);
+}
+
+static bool keccak_job_head(const qsc_keccak_job* job, uint8_t head[2][QSC_KECCAK_128_RATE])
+{
+	const uint8_t name[4] = { 0x4B, 0x4D, 0x41, 0x43 };
+	const size_t RATE = (size_t)job->rate;
+	uint8_t enc[sizeof(size_t) + 1] = { 0 };
+	size_t klen;
+	size_t nlen;
+	size_t slen;
+	size_t oft;
+	bool res;
+
+	/* the kmac prefix blocks are built in the lane when name + custom, and key, each fit in one block */
+	nlen = keccak_left_encode(enc, sizeof(name) * 8);
+	slen = keccak_left_encode(enc, job->custlen * 8);
+	klen = keccak_left_encode(enc, job->keylen * 8);
+	oft = keccak_left_encode(enc, RATE);
+	res = (oft + nlen + sizeof(name) + slen + job->custlen <= RATE && oft + klen + job->keylen <= RATE);
+
+	if (res == true)
+	{
+		qsc_memutils_clear(head, 2 * QSC_KECCAK_128_RATE);
+
+		/* stage 1: name + custom */
+		oft = keccak_left_encode(head[0], RATE);
+		oft += keccak_left_encode(head[0] + oft, sizeof(name) * 8);
+		qsc_memutils_copy(head[0] + oft, name, sizeof(name));
+		oft += sizeof(name);
+		oft += keccak_left_encode(head[0] + oft, job->custlen * 8);
+
+		if (job->custom != NULL && job->custlen != 0)
+		{
+			qsc_memutils_copy(head[0] + oft, job->custom, job->custlen);
+		}
+
+		/* stage 2: key */
+		oft = keccak_left_encode(head[1], RATE);
+		oft += keccak_left_encode(head[1] + oft, job->keylen * 8);
+
+		if (job->key != NULL && job->keylen != 0)
+		{
+			qsc_memutils_copy(head[1] + oft, job->key, job->keylen);
+		}
+	}
+
+	return res;
+}
+
+static size_t keccak_job_tail(const qsc_keccak_job* job, uint8_t tail[2][QSC_KECCAK_128_RATE])
+{
+	const size_t RATE = (size_t)job->rate;
+	const size_t RMDLEN = job->msglen % RATE;
+	uint8_t enc[sizeof(size_t) + 1] = { 0 };
+	size_t blocks;
+	size_t elen;
+	size_t oft;
+
+	qsc_memutils_clear(tail, 2 * QSC_KECCAK_128_RATE);
+	qsc_memutils_copy(tail[0], job->message + (job->msglen - RMDLEN), RMDLEN);
+	blocks = 0;
+	oft = RMDLEN;
+
+	if (job->function == qsc_keccak_job_kmac)
+	{
+		elen = keccak_right_encode(enc, job->otplen * 8);
+
+		/* matches qsc_keccak_finalize; the buffered bytes are permuted before the length encoding,
+		   which then overwrites the start of the same buffer */
+		if (oft + elen >= RATE)
+		{
+			qsc_memutils_copy(tail[1], tail[0], RMDLEN);
+			++blocks;
+			oft = 0;
+		}
+
+		qsc_memutils_copy(tail[blocks] + oft, enc, elen);
+		oft += elen;
+		tail[blocks][oft] = QSC_KECCAK_KMAC_DOMAIN_ID;
+	}
+	else if (job->function == qsc_keccak_job_shake)
+	{
+		tail[blocks][oft] = QSC_KECCAK_SHAKE_DOMAIN_ID;
+	}
+	else
+	{
+		tail[blocks][oft] = QSC_KECCAK_SHA3_DOMAIN_ID;
+	}
+
+	tail[blocks][RATE - 1] |= 128U;
+	++blocks;
+
+	return blocks;
+}
+
+static void keccak_job_load(keccak_job_lanes* lanes, size_t lane, qsc_keccak_job* job)
+{
+	size_t i;
+
+	lanes->job[lane] = job;
+	lanes->hblocks[lane] = 0;
+	lanes->absorbed[lane] = 0;
+	lanes->position[lane] = 0;
+
+	for (i = 0; i < QSC_KECCAK_STATE_SIZE; ++i)
+	{
+		lanes->state[i][lane] = 0;
+	}
+
+	if (job->function == qsc_keccak_job_kmac)
+	{
+		if (keccak_job_head(job, lanes->head[lane]) == true)
+		{
+			lanes->hblocks[lane] = 2;
+		}
+		else
+		{
+			qsc_keccak_state ctx;
+
+			/* long keys or customization strings are absorbed sequentially */
+			qsc_kmac_initialize(&ctx, job->rate, job->key, job->keylen, job->custom, job->custlen);
+
+			for (i = 0; i < QSC_KECCAK_STATE_SIZE; ++i)
+			{
+				lanes->state[i][lane] = ctx.state[i];
+			}
+
+			qsc_keccak_dispose(&ctx);
+		}
+	}
+
+	lanes->blocks[lane] = lanes->hblocks[lane] + (job->msglen / (size_t)job->rate) + keccak_job_tail(job, lanes->tail[lane]);
+}
+
+static bool keccak_job_absorbing(const keccak_job_lanes* lanes, size_t lane)
+{
+	return (lanes->absorbed[lane] < lanes->blocks[lane]);
+}
+
+static void keccak_job_absorb(keccak_job_lanes* lanes, size_t lane)
+{
+	const qsc_keccak_job* job = lanes->job[lane];
+	const size_t RATE = (size_t)job->rate;
+	const size_t FULL = job->msglen / RATE;
+	const uint8_t* blk;
+	size_t b;
+	size_t i;
+
+	b = lanes->absorbed[lane];
+
+	if (b < lanes->hblocks[lane])
+	{
+		blk = lanes->head[lane][b];
+	}
+	else if (b - lanes->hblocks[lane] < FULL)
+	{
+		blk = job->message + ((b - lanes->hblocks[lane]) * RATE);
+	}
+	else
+	{
+		blk = lanes->tail[lane][b - lanes->hblocks[lane] - FULL];
+	}
+
+	for (i = 0; i < RATE / sizeof(uint64_t); ++i)
+	{
+		lanes->state[i][lane] ^= qsc_intutils_le8to64(blk + (i * sizeof(uint64_t)));
+	}
+
+	++lanes->absorbed[lane];
+}
+
+static bool keccak_job_squeeze(keccak_job_lanes* lanes, size_t lane)
+{
+	uint8_t tmp[QSC_KECCAK_128_RATE];
+	const qsc_keccak_job* job = lanes->job[lane];
+	const size_t OTPLEN = keccak_job_output_size(job);
+	size_t blen;
+	size_t i;
+
+	blen = qsc_intutils_min(OTPLEN - lanes->position[lane], (size_t)job->rate);
+
+	for (i = 0; i < (blen + sizeof(uint64_t) - 1) / sizeof(uint64_t); ++i)
+	{
+		qsc_intutils_le64to8(tmp + (i * sizeof(uint64_t)), lanes->state[i][lane]);
+	}
+
+	qsc_memutils_copy(job->output + lanes->position[lane], tmp, blen);
+	lanes->position[lane] += blen;
+
+	return (lanes->position[lane] == OTPLEN);
+}
+
+static void keccak_jobs_permute(keccak_job_lanes* lanes, size_t active)
+{
+	size_t i;
+
+	if (active > 1)
+	{
+#if defined(QSC_SYSTEM_HAS_AVX512)
+		__m512i statew[QSC_KECCAK_STATE_SIZE];
+
+		for (i = 0; i < QSC_KECCAK_STATE_SIZE; ++i)
+		{
+			statew[i] = _mm512_loadu_si512((const __m512i*)lanes->state[i]);
+		}
+
+		qsc_keccak_permute_p8x1600(statew, QSC_KECCAK_PERMUTATION_ROUNDS);
+
+		for (i = 0; i < QSC_KECCAK_STATE_SIZE; ++i)
+		{
+			_mm512_storeu_si512((__m512i*)lanes->state[i], statew[i]);
+		}
+#else
+		__m256i statew[QSC_KECCAK_STATE_SIZE];
+
+		for (i = 0; i < QSC_KECCAK_STATE_SIZE; ++i)
+		{
+			statew[i] = _mm256_loadu_si256((const __m256i*)lanes->state[i]);
+		}
+
+		qsc_keccak_permute_p4x1600(statew, QSC_KECCAK_PERMUTATION_ROUNDS);
+
+		for (i = 0; i < QSC_KECCAK_STATE_SIZE; ++i)
+		{
+			_mm256_storeu_si256((__m256i*)lanes->state[i], statew[i]);
+		}
+#endif
+	}
+	else
+	{
+		uint64_t state[QSC_KECCAK_STATE_SIZE];
+		size_t lane;
+
+		/* a single job remains; finish it with the sequential permutation */
+		for (lane = 0; lane < QSC_KECCAK_JOB_LANES; ++lane)
+		{
+			if (lanes->job[lane] != NULL)
+			{
+				for (i = 0; i < QSC_KECCAK_STATE_SIZE; ++i)
+				{
+					state[i] = lanes->state[i][lane];
+				}
+
+				qsc_keccak_permute_p1600c(state, QSC_KECCAK_PERMUTATION_ROUNDS);
+
+				for (i = 0; i < QSC_KECCAK_STATE_SIZE; ++i)
+				{
+					lanes->state[i][lane] = state[i];
+				}
+			}
+		}
+
+		qsc_memutils_clear((uint8_t*)state, sizeof(state));
+	}
+}
+
+static void keccak_jobs_process(qsc_keccak_job** queue, size_t count)
+{
+	keccak_job_lanes lanes;
+	size_t active;
+	size_t lane;
+	size_t next;
+
+	qsc_memutils_clear(&lanes, sizeof(lanes));
+	active = 0;
+	next = 0;
+
+	/* fill the lanes with the longest jobs */
+	for (lane = 0; lane < QSC_KECCAK_JOB_LANES && next < count; ++lane)
+	{
+		keccak_job_load(&lanes, lane, queue[next]);
+		++active;
+		++next;
+	}
+
+	while (active != 0)
+	{
+		for (lane = 0; lane < QSC_KECCAK_JOB_LANES; ++lane)
+		{
+			if (lanes.job[lane] != NULL && keccak_job_absorbing(&lanes, lane) == true)
+			{
+				keccak_job_absorb(&lanes, lane);
+			}
+		}
+
+		keccak_jobs_permute(&lanes, active);
+
+		for (lane = 0; lane < QSC_KECCAK_JOB_LANES; ++lane)
+		{
+			if (lanes.job[lane] != NULL && keccak_job_absorbing(&lanes, lane) == false)
+			{
+				if (keccak_job_squeeze(&lanes, lane) == true)
+				{
+					/* retire the completed job and refill the lane from the queue */
+					lanes.job[lane] = NULL;
+					--active;
+
+					if (next < count)
+					{
+						keccak_job_load(&lanes, lane, queue[next]);
+						++active;
+						++next;
+					}
+				}
+			}
+		}
+	}
+
+	qsc_memutils_clear(&lanes, sizeof(lanes));
+}
+
+#endif
+
+static void keccak_job_sequential(const qsc_keccak_job* job)
+{
+	qsc_keccak_state ctx;
+	uint8_t hash[QSC_KECCAK_128_RATE] = { 0 };
+
+	if (job->function == qsc_keccak_job_kmac)
+	{
+		qsc_kmac_initialize(&ctx, job->rate, job->key, job->keylen, job->custom, job->custlen);
+		qsc_kmac_update(&ctx, job->rate, job->message, job->msglen);
+		qsc_kmac_finalize(&ctx, job->rate, job->output, job->otplen);
+	}
+	else if (job->function == qsc_keccak_job_shake)
+	{
+		const size_t NBLK = job->otplen / (size_t)job->rate;
+
+		qsc_shake_initialize(&ctx, job->rate, job->message, job->msglen);
+		qsc_shake_squeezeblocks(&ctx, job->rate, job->output, NBLK);
+
+		if (job->otplen - (NBLK * (size_t)job->rate) != 0)
+		{
+			qsc_shake_squeezeblocks(&ctx, job->rate, hash, 1);
+			qsc_memutils_copy(job->output + (NBLK * (size_t)job->rate), hash, job->otplen - (NBLK * (size_t)job->rate));
+		}
+	}
+	else
+	{
+		qsc_sha3_initialize(&ctx);
+		qsc_keccak_absorb(&ctx, job->rate, job->message, job->msglen, QSC_KECCAK_SHA3_DOMAIN_ID, QSC_KECCAK_PERMUTATION_ROUNDS);
+		qsc_keccak_squeezeblocks(&ctx, hash, 1, job->rate, QSC_KECCAK_PERMUTATION_ROUNDS);
+		qsc_memutils_copy(job->output, hash, (QSC_KECCAK_STATE_BYTE_SIZE - (size_t)job->rate) / 2);
+	}
+
+	qsc_keccak_dispose(&ctx);
+	qsc_memutils_clear(hash, sizeof(hash));
+}
+
+void qsc_keccak_jobs_compute(qsc_keccak_job* jobs, size_t count)
+{
+	assert(jobs != NULL);
+
+	size_t i;
+
+	if (jobs != NULL && count != 0)
+	{
+#if defined(QSC_SYSTEM_HAS_AVX512) || defined(QSC_SYSTEM_HAS_AVX2)
+		qsc_keccak_job** queue;
+		size_t qlen;
+
+		queue = (qsc_keccak_job**)qsc_memutils_malloc(count * sizeof(qsc_keccak_job*));
+
+		if (queue != NULL)
+		{
+			qlen = 0;
+
+			for (i = 0; i < count; ++i)
+			{
+				if (jobs[i].function == qsc_keccak_job_sha3 || jobs[i].otplen != 0)
+				{
+					queue[qlen] = &jobs[i];
+					++qlen;
+				}
+			}
+
+			/* group the jobs by permutation count */
+			qsort(queue, qlen, sizeof(qsc_keccak_job*), keccak_job_compare);
+
+			/* run the jobs in parallel lanes */
+			keccak_jobs_process(queue, qlen);
+
+			qsc_memutils_alloc_free(queue);
+		}
+		else
+#endif
+		{
+			for (i = 0; i < count; ++i)
+			{
+				keccak_job_sequential(&jobs[i]);
+			}
+		}
+	}
+}
+
+void qsc_keccak_jobs_flush(qsc_keccak_job_manager* mgr)
+{
+	assert(mgr != NULL);
+
+	if (mgr != NULL && mgr->count != 0)
+	{
+		qsc_keccak_jobs_compute(mgr->jobs, mgr->count);
+		mgr->count = 0;
+	}
+}
+
+void qsc_keccak_jobs_initialize(qsc_keccak_job_manager* mgr, qsc_keccak_job* jobs, size_t capacity)
+{
+	assert(mgr != NULL);
+	assert(jobs != NULL);
+	assert(capacity != 0);
+
+	if (mgr != NULL)
+	{
+		mgr->jobs = jobs;
+		mgr->capacity = capacity;
+		mgr->count = 0;
+	}
+}
+
+void qsc_keccak_jobs_submit(qsc_keccak_job_manager* mgr, const qsc_keccak_job* job)
+{
+	assert(mgr != NULL);
+	assert(job != NULL);
+
+	if (mgr != NULL && job != NULL)
+	{
+		if (mgr->count == mgr->capacity)
+		{
+			qsc_keccak_jobs_flush(mgr);
+		}
+
+		qsc_memutils_copy(&mgr->jobs[mgr->count], job, sizeof(qsc_keccak_job));
+		++mgr->count;
+	}
+}
+
+/* batch MAC verification */
+
+bool qsc_kmac_verify_batch(uint8_t* bitmap, const qsc_kmac_verify_item* items, size_t count, qsc_keccak_rate rate)
+{
+	assert(bitmap != NULL);
+	assert(items != NULL);
+
+	qsc_keccak_job* jobs;
+	uint8_t* codes;
+	size_t i;
+	size_t oft;
+	size_t tlen;
+	uint32_t fail;
+	uint8_t res;
+	bool status;
+
+	status = false;
+
+	if (bitmap != NULL && items != NULL)
+	{
+		qsc_memutils_clear(bitmap, (count + 7) / 8);
+		tlen = 0;
+
+		for (i = 0; i < count; ++i)
+		{
+			assert(items[i].codelen != 0);
+			tlen += items[i].codelen;
+		}
+
+		status = true;
+
+		if (count != 0 && tlen != 0)
+		{
+			jobs = (qsc_keccak_job*)qsc_memutils_malloc(count * sizeof(qsc_keccak_job));
+			codes = (uint8_t*)qsc_memutils_malloc(tlen);
+
+			if (jobs != NULL && codes != NULL)
+			{
+				oft = 0;
+
+				for (i = 0; i < count; ++i)
+				{
+					jobs[i].output = codes + oft;
+					jobs[i].message = items[i].message;
+					jobs[i].key = items[i].key;
+					jobs[i].custom = items[i].custom;
+					jobs[i].otplen = items[i].codelen;
+					jobs[i].msglen = items[i].msglen;
+					jobs[i].keylen = items[i].keylen;
+					jobs[i].custlen = items[i].custlen;
+					jobs[i].rate = rate;
+					jobs[i].function = qsc_keccak_job_kmac;
+					oft += items[i].codelen;
+				}
+
+				qsc_keccak_jobs_compute(jobs, count);
+				fail = 0;
+				oft = 0;
+
+				/* every code is compared, and the result is accumulated without branching */
+				for (i = 0; i < count; ++i)
+				{
+					res = (uint8_t)(qsc_intutils_verify(items[i].code, codes + oft, items[i].codelen) + 1) & (uint8_t)(items[i].codelen != 0);
+					bitmap[i / 8] |= (uint8_t)(res << (i % 8));
+					fail |= (uint32_t)(res ^ 1U);
+					oft += items[i].codelen;
+				}
+
+				qsc_memutils_clear(codes, tlen);
+				status = (fail == 0);
+			}
+			else
+			{
+				status = false;
+			}
+
+			if (jobs != NULL)
+			{
+				qsc_memutils_alloc_free(jobs);
+			}
+
+			if (codes != NULL)
+			{
+				qsc_memutils_alloc_free(codes);
+			}
+		}
+		else if (count != 0)
+		{
+			status = false;
+		}
+	}
+
+	return status;
+}
+
+/* TurboSHAKE and KangarooTwelve */
+
+#define KANGAROOTWELVE_FINAL_DOMAIN 0x06
+#define KANGAROOTWELVE_LEAF_DOMAIN 0x0B
+#define KANGAROOTWELVE_SINGLE_DOMAIN 0x07
+
+/* the number of chaining values hashed between final node updates */
+#define KANGAROOTWELVE_CV_BATCH 64
+
+/* the minimum number of leaves assigned to a thread */
+#define KANGAROOTWELVE_PARALLEL_LEAVES 64
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+#	define KANGAROOTWELVE_LANES 8
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+#	define KANGAROOTWELVE_LANES 4
+#else
+#	define KANGAROOTWELVE_LANES 1
+#endif
+
+/* TurboSHAKE uses the last 12 rounds of the Keccak-f[1600] round schedule */
+#define TURBOSHAKE_ROUND_OFFSET (QSC_KECCAK_PERMUTATION_ROUNDS - QSC_KECCAK_PERMUTATION_MIN_ROUNDS)
+
+typedef struct
+{
+	const uint8_t* message;
+	const uint8_t* custom;
+	size_t msglen;
+	size_t custlen;
+	size_t enclen;
+	uint8_t encoding[sizeof(size_t) + 1];
+} kangarootwelve_input;
+
+typedef struct
+{
+	const kangarootwelve_input* input;
+	uint8_t* cvs;
+	size_t first;
+	size_t count;
+	size_t cvlen;
+	size_t rate;
+} kangarootwelve_task;
+
+static void turboshake_permute(uint64_t* state)
+{
+	keccak_permute_p1600c(state, KECCAK_ROUND_CONSTANTS + TURBOSHAKE_ROUND_OFFSET, QSC_KECCAK_PERMUTATION_MIN_ROUNDS);
+}
+
+static void turboshake_xor_block(uint64_t* state, const uint8_t* block, size_t rate)
+{
+	size_t i;
+
+	for (i = 0; i < rate / sizeof(uint64_t); ++i)
+	{
+		state[i] ^= qsc_intutils_le8to64(block + (i * sizeof(uint64_t)));
+	}
+}
+
+static void turboshake_absorb(qsc_keccak_state* ctx, size_t rate, const uint8_t* message, size_t msglen)
+{
+	size_t rmd;
+
+	if (ctx->position != 0 && msglen != 0)
+	{
+		rmd = qsc_intutils_min(rate - ctx->position, msglen);
+		qsc_memutils_copy(ctx->buffer + ctx->position, message, rmd);
+		ctx->position += rmd;
+		message += rmd;
+		msglen -= rmd;
+
+		if (ctx->position == rate)
+		{
+			turboshake_xor_block(ctx->state, ctx->buffer, rate);
+			turboshake_permute(ctx->state);
+			ctx->position = 0;
+		}
+	}
+
+	while (msglen >= rate)
+	{
+		turboshake_xor_block(ctx->state, message, rate);
+		turboshake_permute(ctx->state);
+		message += rate;
+		msglen -= rate;
+	}
+
+	if (msglen != 0)
+	{
+		qsc_memutils_copy(ctx->buffer, message, msglen);
+		ctx->position = msglen;
+	}
+}
+
+static void turboshake_finalize(qsc_keccak_state* ctx, size_t rate, uint8_t domain)
+{
+	qsc_memutils_clear(ctx->buffer + ctx->position, rate - ctx->position);
+	ctx->buffer[ctx->position] ^= domain;
+	ctx->buffer[rate - 1] ^= 0x80;
+	turboshake_xor_block(ctx->state, ctx->buffer, rate);
+	/* the first squeeze permutes the padded state */
+	ctx->position = rate;
+}
+
+static void turboshake_squeeze(qsc_keccak_state* ctx, size_t rate, uint8_t* output, size_t otplen)
+{
+	size_t i;
+	size_t rmd;
+
+	while (otplen != 0)
+	{
+		if (ctx->position == rate)
+		{
+			turboshake_permute(ctx->state);
+
+			for (i = 0; i < rate / sizeof(uint64_t); ++i)
+			{
+				qsc_intutils_le64to8(ctx->buffer + (i * sizeof(uint64_t)), ctx->state[i]);
+			}
+
+			ctx->position = 0;
+		}
+
+		rmd = qsc_intutils_min(rate - ctx->position, otplen);
+		qsc_memutils_copy(output, ctx->buffer + ctx->position, rmd);
+		ctx->position += rmd;
+		output += rmd;
+		otplen -= rmd;
+	}
+}
+
+static void turboshake_compute(uint8_t* output, size_t otplen, const uint8_t* message, size_t msglen, size_t rate, uint8_t domain)
+{
+	qsc_keccak_state ctx;
+
+	qsc_keccak_initialize_state(&ctx);
+	turboshake_absorb(&ctx, rate, message, msglen);
+	turboshake_finalize(&ctx, rate, domain);
+	turboshake_squeeze(&ctx, rate, output, otplen);
+	qsc_keccak_dispose(&ctx);
+}
+
+static size_t kangarootwelve_length_encode(uint8_t* buffer, size_t value)
+{
+	size_t i;
+	size_t n;
+
+	n = 0;
+
+	for (i = value; i != 0; i >>= 8)
+	{
+		++n;
+	}
+
+	for (i = 0; i < n; ++i)
+	{
+		buffer[i] = (uint8_t)(value >> (8 * (n - i - 1)));
+	}
+
+	buffer[n] = (uint8_t)n;
+
+	return n + 1;
+}
+
+static void kangarootwelve_absorb_range(qsc_keccak_state* ctx, size_t rate, const kangarootwelve_input* input, size_t offset, size_t length)
+{
+	const uint8_t* seg[3];
+	size_t slen[3];
+	size_t i;
+	size_t rmd;
+
+	/* the tree input is the virtual string message || custom || length_encode(custlen) */
+	seg[0] = input->message;
+	seg[1] = input->custom;
+	seg[2] = input->encoding;
+	slen[0] = input->msglen;
+	slen[1] = input->custlen;
+	slen[2] = input->enclen;
+
+	for (i = 0; i < 3 && length != 0; ++i)
+	{
+		if (offset < slen[i])
+		{
+			rmd = qsc_intutils_min(slen[i] - offset, length);
+			turboshake_absorb(ctx, rate, seg[i] + offset, rmd);
+			length -= rmd;
+			offset = 0;
+		}
+		else
+		{
+			offset -= slen[i];
+		}
+	}
+}
+
+static void kangarootwelve_leaf(uint8_t* cv, size_t cvlen, const kangarootwelve_input* input, size_t index, size_t rate)
+{
+	qsc_keccak_state ctx;
+
+	qsc_keccak_initialize_state(&ctx);
+	kangarootwelve_absorb_range(&ctx, rate, input, index * QSC_KANGAROOTWELVE_CHUNK_SIZE, QSC_KANGAROOTWELVE_CHUNK_SIZE);
+	turboshake_finalize(&ctx, rate, KANGAROOTWELVE_LEAF_DOMAIN);
+	turboshake_squeeze(&ctx, rate, cv, cvlen);
+	qsc_keccak_dispose(&ctx);
+}
+
+#if defined(QSC_SYSTEM_HAS_AVX512)
+static void kangarootwelve_leaves_x8(uint8_t* cvs, size_t cvlen, const uint8_t* leaves, size_t rate)
+{
+	const size_t BCNT = QSC_KANGAROOTWELVE_CHUNK_SIZE / rate;
+	const size_t RCNT = (QSC_KANGAROOTWELVE_CHUNK_SIZE % rate) / sizeof(uint64_t);
+	const size_t WCNT = rate / sizeof(uint64_t);
+	__m512i state[QSC_KECCAK_STATE_SIZE];
+	__m512i idx;
+	uint64_t tmp[8];
+	size_t i;
+	size_t j;
+	size_t pos;
+
+	/* lane j reads the leaf at offset j * chunk-size */
+	idx = _mm512_set_epi64(7 * QSC_KANGAROOTWELVE_CHUNK_SIZE, 6 * QSC_KANGAROOTWELVE_CHUNK_SIZE, 5 * QSC_KANGAROOTWELVE_CHUNK_SIZE,
+		4 * QSC_KANGAROOTWELVE_CHUNK_SIZE, 3 * QSC_KANGAROOTWELVE_CHUNK_SIZE, 2 * QSC_KANGAROOTWELVE_CHUNK_SIZE, QSC_KANGAROOTWELVE_CHUNK_SIZE, 0);
+	pos = 0;
+
+	for (i = 0; i < QSC_KECCAK_STATE_SIZE; ++i)
+	{
+		state[i] = _mm512_setzero_si512();
+	}
+
+	for (j = 0; j < BCNT; ++j)
+	{
+		for (i = 0; i < WCNT; ++i)
+		{
+			state[i] = _mm512_xor_si512(state[i], _mm512_i64gather_epi64(idx, (const int64_t*)(leaves + pos), 1));
+			pos += sizeof(uint64_t);
+		}
+
+		keccak_permute_p8x1600(state, KECCAK_ROUND_CONSTANTS + TURBOSHAKE_ROUND_OFFSET, QSC_KECCAK_PERMUTATION_MIN_ROUNDS);
+	}
+
+	for (i = 0; i < RCNT; ++i)
+	{
+		state[i] = _mm512_xor_si512(state[i], _mm512_i64gather_epi64(idx, (const int64_t*)(leaves + pos), 1));
+		pos += sizeof(uint64_t);
+	}
+
+	/* the chunk size is a multiple of 8, so the leaf padding begins on a lane boundary */
+	state[RCNT] = _mm512_xor_si512(state[RCNT], _mm512_set1_epi64(KANGAROOTWELVE_LEAF_DOMAIN));
+	state[WCNT - 1] = _mm512_xor_si512(state[WCNT - 1], _mm512_set1_epi64((int64_t)(1ULL << 63)));
+	keccak_permute_p8x1600(state, KECCAK_ROUND_CONSTANTS + TURBOSHAKE_ROUND_OFFSET, QSC_KECCAK_PERMUTATION_MIN_ROUNDS);
+
+	for (i = 0; i < cvlen / sizeof(uint64_t); ++i)
+	{
+		_mm512_storeu_si512((__m512i*)tmp, state[i]);
+
+		for (j = 0; j < 8; ++j)
+		{
+			qsc_intutils_le64to8(cvs + (j * cvlen) + (i * sizeof(uint64_t)), tmp[j]);
+		}
+	}
+}
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+static void kangarootwelve_leaves_x4(uint8_t* cvs, size_t cvlen, const uint8_t* leaves, size_t rate)
+{
+	const size_t BCNT = QSC_KANGAROOTWELVE_CHUNK_SIZE / rate;
+	const size_t RCNT = (QSC_KANGAROOTWELVE_CHUNK_SIZE % rate) / sizeof(uint64_t);
+	const size_t WCNT = rate / sizeof(uint64_t);
+	__m256i state[QSC_KECCAK_STATE_SIZE];
+	__m256i idx;
+	uint64_t tmp[4];
+	size_t i;
+	size_t j;
+	size_t pos;
+
+	/* lane j reads the leaf at offset j * chunk-size */
+	idx = _mm256_set_epi64x(3 * QSC_KANGAROOTWELVE_CHUNK_SIZE, 2 * QSC_KANGAROOTWELVE_CHUNK_SIZE, QSC_KANGAROOTWELVE_CHUNK_SIZE, 0);
+	pos = 0;
+
+	for (i = 0; i < QSC_KECCAK_STATE_SIZE; ++i)
+	{
+		state[i] = _mm256_setzero_si256();
+	}
+
+	for (j = 0; j < BCNT; ++j)
+	{
+		for (i = 0; i < WCNT; ++i)
+		{
+			state[i] = _mm256_xor_si256(state[i], _mm256_i64gather_epi64((const long long*)(leaves + pos), idx, 1));
+			pos += sizeof(uint64_t);
+		}
+
+		keccak_permute_p4x1600(state, KECCAK_ROUND_CONSTANTS + TURBOSHAKE_ROUND_OFFSET, QSC_KECCAK_PERMUTATION_MIN_ROUNDS);
+	}
+
+	for (i = 0; i < RCNT; ++i)
+	{
+		state[i] = _mm256_xor_si256(state[i], _mm256_i64gather_epi64((const long long*)(leaves + pos), idx, 1));
+		pos += sizeof(uint64_t);
+	}
+
+	/* the chunk size is a multiple of 8, so the leaf padding begins on a lane boundary */
+	state[RCNT] = _mm256_xor_si256(state[RCNT], _mm256_set1_epi64x(KANGAROOTWELVE_LEAF_DOMAIN));
+	state[WCNT - 1] = _mm256_xor_si256(state[WCNT - 1], _mm256_set1_epi64x((int64_t)(1ULL << 63)));
+	keccak_permute_p4x1600(state, KECCAK_ROUND_CONSTANTS + TURBOSHAKE_ROUND_OFFSET, QSC_KECCAK_PERMUTATION_MIN_ROUNDS);
+
+	for (i = 0; i < cvlen / sizeof(uint64_t); ++i)
+	{
+		_mm256_storeu_si256((__m256i*)tmp, state[i]);
+
+		for (j = 0; j < 4; ++j)
+		{
+			qsc_intutils_le64to8(cvs + (j * cvlen) + (i * sizeof(uint64_t)), tmp[j]);
+		}
+	}
+}
+#endif
+
+static void kangarootwelve_chaining(uint8_t* cvs, const kangarootwelve_input* input, size_t first, size_t count, size_t cvlen, size_t rate)
+{
+	size_t i;
+
+	i = 0;
+
+#if (KANGAROOTWELVE_LANES > 1)
+	/* groups of full leaves that lie within the message are hashed in parallel lanes */
+	while (count - i >= KANGAROOTWELVE_LANES && (first + i + KANGAROOTWELVE_LANES) * QSC_KANGAROOTWELVE_CHUNK_SIZE <= input->msglen)
+	{
+#	if defined(QSC_SYSTEM_HAS_AVX512)
+		kangarootwelve_leaves_x8(cvs + (i * cvlen), cvlen, input->message + ((first + i) * QSC_KANGAROOTWELVE_CHUNK_SIZE), rate);
+#	else
+		kangarootwelve_leaves_x4(cvs + (i * cvlen), cvlen, input->message + ((first + i) * QSC_KANGAROOTWELVE_CHUNK_SIZE), rate);
+#	endif
+		i += KANGAROOTWELVE_LANES;
+	}
+#endif
+
+	/* the remaining leaves, and any leaf that spans the customization string, are hashed individually */
+	for (; i < count; ++i)
+	{
+		kangarootwelve_leaf(cvs + (i * cvlen), cvlen, input, first + i, rate);
+	}
+}
+
+static void kangarootwelve_worker(void* state)
+{
+	kangarootwelve_task* task = (kangarootwelve_task*)state;
+
+	kangarootwelve_chaining(task->cvs, task->input, task->first, task->count, task->cvlen, task->rate);
+}
+
+static bool kangarootwelve_parallel(qsc_keccak_state* ctx, const kangarootwelve_input* input, size_t lcnt, size_t cvlen, size_t rate)
+{
+	qsc_thread thds[QSC_ASYNC_PARALLEL_MAX] = { 0 };
+	kangarootwelve_task* tasks;
+	uint8_t* cvs;
+	size_t first;
+	size_t i;
+	size_t scnt;
+	size_t tcnt;
+	size_t tlen;
+	bool res;
+
+	cvs = NULL;
+	tasks = NULL;
+	res = false;
+	tcnt = qsc_intutils_min(qsc_async_processor_count(), (size_t)QSC_ASYNC_PARALLEL_MAX);
+	tcnt = qsc_intutils_min(tcnt, lcnt / KANGAROOTWELVE_PARALLEL_LEAVES);
+
+	if (tcnt > 1)
+	{
+		tasks = (kangarootwelve_task*)qsc_memutils_malloc(tcnt * sizeof(kangarootwelve_task));
+		cvs = (uint8_t*)qsc_memutils_malloc(lcnt * cvlen);
+	}
+
+	if (tasks != NULL && cvs != NULL)
+	{
+		/* each thread hashes a contiguous run of leaves; all but the last run are a multiple of the lane count */
+		tlen = (lcnt / tcnt) - ((lcnt / tcnt) % KANGAROOTWELVE_LANES);
+		first = 0;
+
+		for (i = 0; i < tcnt; ++i)
+		{
+			tasks[i].input = input;
+			tasks[i].cvs = cvs + (first * cvlen);
+			tasks[i].first = first + 1;
+			tasks[i].count = (i == tcnt - 1) ? lcnt - first : tlen;
+			tasks[i].cvlen = cvlen;
+			tasks[i].rate = rate;
+			first += tasks[i].count;
+		}
+
+		/* if a worker cannot be started, its leaves and those after it are hashed on the calling thread */
+		for (i = 0; i < tcnt; ++i)
+		{
+			thds[i] = qsc_async_thread_create(kangarootwelve_worker, &tasks[i]);
+
+			if (thds[i] == 0)
+			{
+				break;
+			}
+		}
+
+		scnt = i;
+
+		for (; i < tcnt; ++i)
+		{
+			kangarootwelve_worker(&tasks[i]);
+		}
+
+		qsc_async_thread_wait_all(thds, scnt);
+		turboshake_absorb(ctx, rate, cvs, lcnt * cvlen);
+		res = true;
+	}
+
+	qsc_memutils_alloc_free(cvs);
+	qsc_memutils_alloc_free(tasks);
+
+	return res;
+}
+
+static void kangarootwelve_compute(uint8_t* output, size_t otplen, const uint8_t* message, size_t msglen, const uint8_t* custom, size_t custlen,
+	size_t rate, size_t cvlen, bool parallel)
+{
+	const uint8_t NODE[8] = { 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+	const uint8_t TERM[2] = { 0xFF, 0xFF };
+	kangarootwelve_input input;
+	qsc_keccak_state ctx;
+	uint8_t cvs[KANGAROOTWELVE_CV_BATCH * QSC_KT256_HASH_SIZE];
+	uint8_t enc[sizeof(size_t) + 1];
+	size_t blen;
+	size_t i;
+	size_t lcnt;
+	size_t slen;
+
+	input.message = message;
+	input.msglen = msglen;
+	input.custom = custom;
+	input.custlen = custlen;
+	input.enclen = kangarootwelve_length_encode(input.encoding, custlen);
+	slen = msglen + custlen + input.enclen;
+
+	/* the final node begins with the first chunk */
+	qsc_keccak_initialize_state(&ctx);
+	kangarootwelve_absorb_range(&ctx, rate, &input, 0, QSC_KANGAROOTWELVE_CHUNK_SIZE);
+
+	if (slen <= QSC_KANGAROOTWELVE_CHUNK_SIZE)
+	{
+		turboshake_finalize(&ctx, rate, KANGAROOTWELVE_SINGLE_DOMAIN);
+	}
+	else
+	{
+		/* the chunks that follow the first are leaves, chained into the final node by their hash */
+		lcnt = (slen - 1) / QSC_KANGAROOTWELVE_CHUNK_SIZE;
+		turboshake_absorb(&ctx, rate, NODE, sizeof(NODE));
+
+		if (parallel == false || kangarootwelve_parallel(&ctx, &input, lcnt, cvlen, rate) == false)
+		{
+			for (i = 0; i < lcnt; i += blen)
+			{
+				blen = qsc_intutils_min(lcnt - i, KANGAROOTWELVE_CV_BATCH);
+				kangarootwelve_chaining(cvs, &input, i + 1, blen, cvlen, rate);
+				turboshake_absorb(&ctx, rate, cvs, blen * cvlen);
+			}
+		}
+
+		turboshake_absorb(&ctx, rate, enc, kangarootwelve_length_encode(enc, lcnt));
+		turboshake_absorb(&ctx, rate, TERM, sizeof(TERM));
+		turboshake_finalize(&ctx, rate, KANGAROOTWELVE_FINAL_DOMAIN);
+	}
+
+	turboshake_squeeze(&ctx, rate, output, otplen);
+	qsc_keccak_dispose(&ctx);
+}
+
+void qsc_turboshake128_compute(uint8_t* output, size_t otplen, const uint8_t* message, size_t msglen, uint8_t domain)
+{
+	assert(output != NULL);
+	assert(message != NULL);
+	assert(domain >= 0x01 && domain <= 0x7F);
+
+	turboshake_compute(output, otplen, message, msglen, QSC_KECCAK_128_RATE, domain);
+}
+
+void qsc_turboshake256_compute(uint8_t* output, size_t otplen, const uint8_t* message, size_t msglen, uint8_t domain)
+{
+	assert(output != NULL);
+	assert(message != NULL);
+	assert(domain >= 0x01 && domain <= 0x7F);
+
+	turboshake_compute(output, otplen, message, msglen, QSC_KECCAK_256_RATE, domain);
+}
+
+void qsc_kt128_compute(uint8_t* output, size_t otplen, const uint8_t* message, size_t msglen, const uint8_t* custom, size_t custlen)
+{
+	assert(output != NULL);
+	assert(message != NULL);
+
+	kangarootwelve_compute(output, otplen, message, msglen, custom, custlen, QSC_KECCAK_128_RATE, QSC_KT128_HASH_SIZE, false);
+}
+
+void qsc_kt128_parallel_compute(uint8_t* output, size_t otplen, const uint8_t* message, size_t msglen, const uint8_t* custom, size_t custlen)
+{
+	assert(output != NULL);
+	assert(message != NULL);
+
+	kangarootwelve_compute(output, otplen, message, msglen, custom, custlen, QSC_KECCAK_128_RATE, QSC_KT128_HASH_SIZE, true);
+}
+
+void qsc_kt256_compute(uint8_t* output, size_t otplen, const uint8_t* message, size_t msglen, const uint8_t* custom, size_t custlen)
+{
+	assert(output != NULL);
+	assert(message != NULL);
+
+	kangarootwelve_compute(output, otplen, message, msglen, custom, custlen, QSC_KECCAK_256_RATE, QSC_KT256_HASH_SIZE, false);
+}
+
+void qsc_kt256_parallel_compute(uint8_t* output, size_t otplen, const uint8_t* message, size_t msglen, const uint8_t* custom, size_t custlen)
+{
+	assert(output != NULL);
+	assert(message != NULL);
+
+	kangarootwelve_compute(output, otplen, message, msglen, custom, custlen, QSC_KECCAK_256_RATE, QSC_KT256_HASH_SIZE, true);
+}
@@ -37,7 +37,7 @@
 * \updated October 19, 2021
 *
 * \brief SHA3 header definition \n
-* Contains the public api and documentation for SHA3 digest, SHAKE, cSHAKE, and KMAC implementations.
+* Contains the public api and documentation for SHA3 digest, SHAKE, cSHAKE, KMAC, TurboSHAKE, and KangarooTwelve implementations.
 *
 * Usage Examples \n
 *
@@ -104,7 +104,8 @@
 * NIST: SHA3 Keccak Submission http://keccak.noekeon.org/Keccak-submission-3.pdf \n
 * NIST: SHA3 Keccak Slides http://csrc.nist.gov/groups/ST/hash/sha-3/documents/Keccak-slides-at-NIST.pdf \n
 * NIST: SHA3 Third-Round Report http://nvlpubs.nist.gov/nistpubs/ir/2012/NIST.IR.7896.pdf \n
-* Team Keccak: Specifications summary https://keccak.team/keccak_specs_summary.html
+* Team Keccak: Specifications summary https://keccak.team/keccak_specs_summary.html \n
+* IETF: RFC 9861 KangarooTwelve and TurboSHAKE https://www.rfc-editor.org/rfc/rfc9861
 */
 
 /*!
@@ -360,7 +361,9 @@ QSC_EXPORT_API void qsc_keccak_permute(qsc_keccak_state* ctx, size_t rounds);
 
 /**
 * \brief The compact Keccak permute function.
-* Internal function: Permutes the state array, can be used in external constructions.
+* Internal function: Permutes the state array, can be used in external constructions. \n
+* The implementation is selected by the target instruction set: an AVX-512VL form that keeps the state in vector registers,
+* a form using the BMI1/BMI2 ANDN and RORX instructions on AVX2 processors, and a lane-complemented form for other processors.
 *
 * \param state: The state array; must be initialized
 * \param rounds: The number of permutation rounds, the default and maximum is 24
@@ -740,6 +743,63 @@ QSC_EXPORT_API void qsc_kmac_finalize(qsc_keccak_state* ctx, qsc_keccak_rate rat
 */
 QSC_EXPORT_API void qsc_kmac_initialize(qsc_keccak_state* ctx, qsc_keccak_rate rate, const uint8_t* key, size_t keylen, const uint8_t* custom, size_t custlen);
 
+/*!
+* \struct qsc_kmac_key
+* \brief A prepared KMAC key.
+* Holds the Keccak state after the encoded customization string and key have been absorbed,
+* so that an instance can be keyed by copying the state rather than re-absorbing the key.
+*/
+QSC_EXPORT_API typedef struct
+{
+	uint64_t state[QSC_KECCAK_STATE_SIZE];	/*!< The keyed Keccak state  */
+	qsc_keccak_rate rate;					/*!< The rate the key was prepared with  */
+} qsc_kmac_key;
+
+/**
+* \brief Generate a KMAC code using a prepared key.
+* Short form api: keys the instance from the prepared key, processes the message, and generates the MAC code with a single call.
+* The KMAC variant is selected by the rate the key was prepared with.
+*
+* \param output: The MAC code byte array
+* \param otplen: The number of MAC code bytes to generate
+* \param message: [const] The message input byte array
+* \param msglen: The number of message bytes to process
+* \param pkey: [const] The prepared key; must be initialized with qsc_kmac_key_prepare
+*/
+QSC_EXPORT_API void qsc_kmac_compute_prepared(uint8_t* output, size_t otplen, const uint8_t* message, size_t msglen, const qsc_kmac_key* pkey);
+
+/**
+* \brief Initialize a KMAC instance from a prepared key.
+* Long form api: must be used in conjunction with the update and finalize functions, using the rate the key was prepared with.
+* Copies the keyed state; one prepared key can key any number of instances.
+*
+* \param ctx: [struct] A reference to the keccak state
+* \param pkey: [const] The prepared key; must be initialized with qsc_kmac_key_prepare
+*/
+QSC_EXPORT_API void qsc_kmac_initialize_prepared(qsc_keccak_state* ctx, const qsc_kmac_key* pkey);
+
+/**
+* \brief Dispose of a prepared KMAC key.
+* This function erases the keyed state.
+*
+* \param pkey: [struct] The prepared key structure
+*/
+QSC_EXPORT_API void qsc_kmac_key_dispose(qsc_kmac_key* pkey);
+
+/**
+* \brief Prepare a KMAC key.
+* Absorbs the customization string and key once, so that instances using the same key
+* can be initialized with qsc_kmac_initialize_prepared without re-absorbing the key.
+*
+* \param pkey: [struct] The prepared key structure
+* \param rate: The rate of absorption in bytes
+* \param key: [const] The input key byte array
+* \param keylen: The number of key bytes to process
+* \param custom: [const] The customization string
+* \param custlen: The byte length of the customization string
+*/
+QSC_EXPORT_API void qsc_kmac_key_prepare(qsc_kmac_key* pkey, qsc_keccak_rate rate, const uint8_t* key, size_t keylen, const uint8_t* custom, size_t custlen);
+
 /* KPA - Keccak-based Parallel Authentication */
 
 #if defined(QSC_SYSTEM_HAS_AVX512) || defined(QSC_SYSTEM_HAS_AVX2)
@@ -931,6 +991,162 @@ void qsc_keccakx8_squeezeblocks(__m512i state[QSC_KECCAK_STATE_SIZE], qsc_keccak
 
 #endif
 
+/* incremental parallel Keccak */
+
+/*!
+* \struct qsc_keccakx4_state
+* \brief The incremental 4-lane parallel Keccak state.
+* The lanes are permuted with AVX2 when available, otherwise as four interleaved sequential states.
+* The lanes advance in lock-step and share one buffer position, so the four lane messages must be of equal length.
+*/
+QSC_EXPORT_API typedef struct
+{
+#if defined(QSC_SYSTEM_HAS_AVX2)
+	__m256i state[QSC_KECCAK_STATE_SIZE];						/*!< The AVX2 state array  */
+#else
+	uint64_t state[4][QSC_KECCAK_STATE_SIZE];					/*!< The sequential state arrays  */
+#endif
+	uint8_t buffer[4][QSC_KECCAK_STATE_BYTE_SIZE];				/*!< The lane buffers  */
+	size_t position;											/*!< The buffer position shared by all lanes  */
+	qsc_keccak_rate rate;										/*!< The Keccak rate  */
+} qsc_keccakx4_state;
+
+/*!
+* \struct qsc_keccakx8_state
+* \brief The incremental 8-lane parallel Keccak state.
+* The lanes are permuted with AVX-512, as two AVX2 states, or as eight interleaved sequential states.
+* The lanes advance in lock-step and share one buffer position, so the eight lane messages must be of equal length.
+*/
+QSC_EXPORT_API typedef struct
+{
+#if defined(QSC_SYSTEM_HAS_AVX512)
+	__m512i state[QSC_KECCAK_STATE_SIZE];						/*!< The AVX512 state array  */
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+	__m256i state[2][QSC_KECCAK_STATE_SIZE];					/*!< The AVX2 state arrays  */
+#else
+	uint64_t state[8][QSC_KECCAK_STATE_SIZE];					/*!< The sequential state arrays  */
+#endif
+	uint8_t buffer[8][QSC_KECCAK_STATE_BYTE_SIZE];				/*!< The lane buffers  */
+	size_t position;											/*!< The buffer position shared by all lanes  */
+	qsc_keccak_rate rate;										/*!< The Keccak rate  */
+} qsc_keccakx8_state;
+
+/**
+* \brief Dispose of the 4-lane parallel Keccak state.
+*
+* \param ctx: [struct] The parallel Keccak state
+*/
+QSC_EXPORT_API void qsc_keccakx4_dispose(qsc_keccakx4_state* ctx);
+
+/**
+* \brief Pad and absorb the final block of the 4 lanes; called once, after the last update and before squeezing.
+*
+* \param ctx: [struct] The parallel Keccak state; must be initialized
+* \param domain: The function domain id
+*/
+QSC_EXPORT_API void qsc_keccakx4_finalize(qsc_keccakx4_state* ctx, uint8_t domain);
+
+/**
+* \brief Initialize the 4-lane parallel Keccak state.
+*
+* \param ctx: [struct] The parallel Keccak state
+* \param rate: The Keccak rate
+*/
+QSC_EXPORT_API void qsc_keccakx4_initialize(qsc_keccakx4_state* ctx, qsc_keccak_rate rate);
+
+/**
+* \brief Squeeze output from the 4 lanes; can be called repeatedly to extract any number of bytes.
+*
+* \warning The state must be finalized before calling.
+*
+* \param ctx: [struct] The parallel Keccak state; must be finalized
+* \param out0: The 1st output array
+* \param out1: The 2nd output array
+* \param out2: The 3rd output array
+* \param out3: The 4th output array
+* \param otplen: The number of bytes to extract from each lane
+*/
+QSC_EXPORT_API void qsc_keccakx4_squeeze(qsc_keccakx4_state* ctx, uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3, size_t otplen);
+
+/**
+* \brief Absorb an equal length segment of each of the 4 lane messages.
+* Full blocks are absorbed directly, partial blocks are buffered until the next update or finalize call.
+*
+* \warning Every lane reads lanelen bytes; lane messages of different lengths can not be absorbed with this function.
+* Must not be called after the state has been finalized.
+*
+* \param ctx: [struct] The parallel Keccak state; must be initialized
+* \param inp0: [const] The 1st input array
+* \param inp1: [const] The 2nd input array
+* \param inp2: [const] The 3rd input array
+* \param inp3: [const] The 4th input array
+* \param lanelen: The number of bytes absorbed from each input array
+*/
+QSC_EXPORT_API void qsc_keccakx4_update(qsc_keccakx4_state* ctx, const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3, size_t lanelen);
+
+/**
+* \brief Dispose of the 8-lane parallel Keccak state.
+*
+* \param ctx: [struct] The parallel Keccak state
+*/
+QSC_EXPORT_API void qsc_keccakx8_dispose(qsc_keccakx8_state* ctx);
+
+/**
+* \brief Pad and absorb the final block of the 8 lanes; called once, after the last update and before squeezing.
+*
+* \param ctx: [struct] The parallel Keccak state; must be initialized
+* \param domain: The function domain id
+*/
+QSC_EXPORT_API void qsc_keccakx8_finalize(qsc_keccakx8_state* ctx, uint8_t domain);
+
+/**
+* \brief Initialize the 8-lane parallel Keccak state.
+*
+* \param ctx: [struct] The parallel Keccak state
+* \param rate: The Keccak rate
+*/
+QSC_EXPORT_API void qsc_keccakx8_initialize(qsc_keccakx8_state* ctx, qsc_keccak_rate rate);
+
+/**
+* \brief Squeeze output from the 8 lanes; can be called repeatedly to extract any number of bytes.
+*
+* \warning The state must be finalized before calling.
+*
+* \param ctx: [struct] The parallel Keccak state; must be finalized
+* \param out0: The 1st output array
+* \param out1: The 2nd output array
+* \param out2: The 3rd output array
+* \param out3: The 4th output array
+* \param out4: The 5th output array
+* \param out5: The 6th output array
+* \param out6: The 7th output array
+* \param out7: The 8th output array
+* \param otplen: The number of bytes to extract from each lane
+*/
+QSC_EXPORT_API void qsc_keccakx8_squeeze(qsc_keccakx8_state* ctx, uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
+	uint8_t* out4, uint8_t* out5, uint8_t* out6, uint8_t* out7, size_t otplen);
+
+/**
+* \brief Absorb an equal length segment of each of the 8 lane messages.
+* Full blocks are absorbed directly, partial blocks are buffered until the next update or finalize call.
+*
+* \warning Every lane reads lanelen bytes; lane messages of different lengths can not be absorbed with this function.
+* Must not be called after the state has been finalized.
+*
+* \param ctx: [struct] The parallel Keccak state; must be initialized
+* \param inp0: [const] The 1st input array
+* \param inp1: [const] The 2nd input array
+* \param inp2: [const] The 3rd input array
+* \param inp3: [const] The 4th input array
+* \param inp4: [const] The 5th input array
+* \param inp5: [const] The 6th input array
+* \param inp6: [const] The 7th input array
+* \param inp7: [const] The 8th input array
+* \param lanelen: The number of bytes absorbed from each input array
+*/
+QSC_EXPORT_API void qsc_keccakx8_update(qsc_keccakx8_state* ctx, const uint8_t* inp0, const uint8_t* inp1, const uint8_t* inp2, const uint8_t* inp3,
+	const uint8_t* inp4, const uint8_t* inp5, const uint8_t* inp6, const uint8_t* inp7, size_t lanelen);
+
 /* parallel SHAKE x4 */
 
 /**
@@ -1341,4 +1557,615 @@ QSC_EXPORT_API void qsc_kmac_512x8(uint8_t* out0, uint8_t* out1, uint8_t* out2,
 	const uint8_t* msg0, const uint8_t* msg1, const uint8_t* msg2, const uint8_t* msg3,
 	const uint8_t* msg4, const uint8_t* msg5, const uint8_t* msg6, const uint8_t* msg7, size_t msglen);
 
+/* parallel cSHAKE x4 */
+
+/**
+* \brief Process 4 cSHAKE-128 instances simultaneously, each with its own key, name, and customization string.
+* The lanes are permuted with AVX2 when available, otherwise sequentially.
+* If the name and customization lengths are both zero, each lane computes SHAKE-128.
+*
+* \warning The arrays in each group must be of the same length.
+*
+* \param out0: The 1st output array
+* \param out1: The 2nd output array
+* \param out2: The 3rd output array
+* \param out3: The 4th output array
+* \param otplen: The length of the output arrays
+* \param key0: [const] The 1st key array
+* \param key1: [const] The 2nd key array
+* \param key2: [const] The 3rd key array
+* \param key3: [const] The 4th key array
+* \param keylen: The length of the key arrays
+* \param nme0: [const] The 1st name array
+* \param nme1: [const] The 2nd name array
+* \param nme2: [const] The 3rd name array
+* \param nme3: [const] The 4th name array
+* \param nmelen: The length of the name arrays
+* \param cst0: [const] The 1st custom array
+* \param cst1: [const] The 2nd custom array
+* \param cst2: [const] The 3rd custom array
+* \param cst3: [const] The 4th custom array
+* \param cstlen: The length of the custom arrays
+*/
+QSC_EXPORT_API void qsc_cshake_128x4(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3, size_t otplen,
+	const uint8_t* key0, const uint8_t* key1, const uint8_t* key2, const uint8_t* key3, size_t keylen,
+	const uint8_t* nme0, const uint8_t* nme1, const uint8_t* nme2, const uint8_t* nme3, size_t nmelen,
+	const uint8_t* cst0, const uint8_t* cst1, const uint8_t* cst2, const uint8_t* cst3, size_t cstlen);
+
+/**
+* \brief Process 4 cSHAKE-256 instances simultaneously, each with its own key, name, and customization string.
+* The lanes are permuted with AVX2 when available, otherwise sequentially.
+* If the name and customization lengths are both zero, each lane computes SHAKE-256.
+*
+* \warning The arrays in each group must be of the same length.
+*
+* \param out0: The 1st output array
+* \param out1: The 2nd output array
+* \param out2: The 3rd output array
+* \param out3: The 4th output array
+* \param otplen: The length of the output arrays
+* \param key0: [const] The 1st key array
+* \param key1: [const] The 2nd key array
+* \param key2: [const] The 3rd key array
+* \param key3: [const] The 4th key array
+* \param keylen: The length of the key arrays
+* \param nme0: [const] The 1st name array
+* \param nme1: [const] The 2nd name array
+* \param nme2: [const] The 3rd name array
+* \param nme3: [const] The 4th name array
+* \param nmelen: The length of the name arrays
+* \param cst0: [const] The 1st custom array
+* \param cst1: [const] The 2nd custom array
+* \param cst2: [const] The 3rd custom array
+* \param cst3: [const] The 4th custom array
+* \param cstlen: The length of the custom arrays
+*/
+QSC_EXPORT_API void qsc_cshake_256x4(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3, size_t otplen,
+	const uint8_t* key0, const uint8_t* key1, const uint8_t* key2, const uint8_t* key3, size_t keylen,
+	const uint8_t* nme0, const uint8_t* nme1, const uint8_t* nme2, const uint8_t* nme3, size_t nmelen,
+	const uint8_t* cst0, const uint8_t* cst1, const uint8_t* cst2, const uint8_t* cst3, size_t cstlen);
+
+/**
+* \brief Process 4 cSHAKE-512 instances simultaneously, each with its own key, name, and customization string.
+* The lanes are permuted with AVX2 when available, otherwise sequentially.
+* If the name and customization lengths are both zero, each lane computes SHAKE-512.
+*
+* \warning The arrays in each group must be of the same length.
+*
+* \param out0: The 1st output array
+* \param out1: The 2nd output array
+* \param out2: The 3rd output array
+* \param out3: The 4th output array
+* \param otplen: The length of the output arrays
+* \param key0: [const] The 1st key array
+* \param key1: [const] The 2nd key array
+* \param key2: [const] The 3rd key array
+* \param key3: [const] The 4th key array
+* \param keylen: The length of the key arrays
+* \param nme0: [const] The 1st name array
+* \param nme1: [const] The 2nd name array
+* \param nme2: [const] The 3rd name array
+* \param nme3: [const] The 4th name array
+* \param nmelen: The length of the name arrays
+* \param cst0: [const] The 1st custom array
+* \param cst1: [const] The 2nd custom array
+* \param cst2: [const] The 3rd custom array
+* \param cst3: [const] The 4th custom array
+* \param cstlen: The length of the custom arrays
+*/
+QSC_EXPORT_API void qsc_cshake_512x4(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3, size_t otplen,
+	const uint8_t* key0, const uint8_t* key1, const uint8_t* key2, const uint8_t* key3, size_t keylen,
+	const uint8_t* nme0, const uint8_t* nme1, const uint8_t* nme2, const uint8_t* nme3, size_t nmelen,
+	const uint8_t* cst0, const uint8_t* cst1, const uint8_t* cst2, const uint8_t* cst3, size_t cstlen);
+
+/* parallel cSHAKE x8 */
+
+/**
+* \brief Process 8 cSHAKE-128 instances simultaneously, each with its own key, name, and customization string.
+* The lanes are permuted with AVX-512, or as two AVX2 states, when available, otherwise sequentially.
+* If the name and customization lengths are both zero, each lane computes SHAKE-128.
+*
+* \warning The arrays in each group must be of the same length.
+*
+* \param out0: The 1st output array
+* \param out1: The 2nd output array
+* \param out2: The 3rd output array
+* \param out3: The 4th output array
+* \param out4: The 5th output array
+* \param out5: The 6th output array
+* \param out6: The 7th output array
+* \param out7: The 8th output array
+* \param otplen: The length of the output arrays
+* \param key0: [const] The 1st key array
+* \param key1: [const] The 2nd key array
+* \param key2: [const] The 3rd key array
+* \param key3: [const] The 4th key array
+* \param key4: [const] The 5th key array
+* \param key5: [const] The 6th key array
+* \param key6: [const] The 7th key array
+* \param key7: [const] The 8th key array
+* \param keylen: The length of the key arrays
+* \param nme0: [const] The 1st name array
+* \param nme1: [const] The 2nd name array
+* \param nme2: [const] The 3rd name array
+* \param nme3: [const] The 4th name array
+* \param nme4: [const] The 5th name array
+* \param nme5: [const] The 6th name array
+* \param nme6: [const] The 7th name array
+* \param nme7: [const] The 8th name array
+* \param nmelen: The length of the name arrays
+* \param cst0: [const] The 1st custom array
+* \param cst1: [const] The 2nd custom array
+* \param cst2: [const] The 3rd custom array
+* \param cst3: [const] The 4th custom array
+* \param cst4: [const] The 5th custom array
+* \param cst5: [const] The 6th custom array
+* \param cst6: [const] The 7th custom array
+* \param cst7: [const] The 8th custom array
+* \param cstlen: The length of the custom arrays
+*/
+QSC_EXPORT_API void qsc_cshake_128x8(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
+	uint8_t* out4, uint8_t* out5, uint8_t* out6, uint8_t* out7, size_t otplen,
+	const uint8_t* key0, const uint8_t* key1, const uint8_t* key2, const uint8_t* key3,
+	const uint8_t* key4, const uint8_t* key5, const uint8_t* key6, const uint8_t* key7, size_t keylen,
+	const uint8_t* nme0, const uint8_t* nme1, const uint8_t* nme2, const uint8_t* nme3,
+	const uint8_t* nme4, const uint8_t* nme5, const uint8_t* nme6, const uint8_t* nme7, size_t nmelen,
+	const uint8_t* cst0, const uint8_t* cst1, const uint8_t* cst2, const uint8_t* cst3,
+	const uint8_t* cst4, const uint8_t* cst5, const uint8_t* cst6, const uint8_t* cst7, size_t cstlen);
+
+/**
+* \brief Process 8 cSHAKE-256 instances simultaneously, each with its own key, name, and customization string.
+* The lanes are permuted with AVX-512, or as two AVX2 states, when available, otherwise sequentially.
+* If the name and customization lengths are both zero, each lane computes SHAKE-256.
+*
+* \warning The arrays in each group must be of the same length.
+*
+* \param out0: The 1st output array
+* \param out1: The 2nd output array
+* \param out2: The 3rd output array
+* \param out3: The 4th output array
+* \param out4: The 5th output array
+* \param out5: The 6th output array
+* \param out6: The 7th output array
+* \param out7: The 8th output array
+* \param otplen: The length of the output arrays
+* \param key0: [const] The 1st key array
+* \param key1: [const] The 2nd key array
+* \param key2: [const] The 3rd key array
+* \param key3: [const] The 4th key array
+* \param key4: [const] The 5th key array
+* \param key5: [const] The 6th key array
+* \param key6: [const] The 7th key array
+* \param key7: [const] The 8th key array
+* \param keylen: The length of the key arrays
+* \param nme0: [const] The 1st name array
+* \param nme1: [const] The 2nd name array
+* \param nme2: [const] The 3rd name array
+* \param nme3: [const] The 4th name array
+* \param nme4: [const] The 5th name array
+* \param nme5: [const] The 6th name array
+* \param nme6: [const] The 7th name array
+* \param nme7: [const] The 8th name array
+* \param nmelen: The length of the name arrays
+* \param cst0: [const] The 1st custom array
+* \param cst1: [const] The 2nd custom array
+* \param cst2: [const] The 3rd custom array
+* \param cst3: [const] The 4th custom array
+* \param cst4: [const] The 5th custom array
+* \param cst5: [const] The 6th custom array
+* \param cst6: [const] The 7th custom array
+* \param cst7: [const] The 8th custom array
+* \param cstlen: The length of the custom arrays
+*/
+QSC_EXPORT_API void qsc_cshake_256x8(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
+	uint8_t* out4, uint8_t* out5, uint8_t* out6, uint8_t* out7, size_t otplen,
+	const uint8_t* key0, const uint8_t* key1, const uint8_t* key2, const uint8_t* key3,
+	const uint8_t* key4, const uint8_t* key5, const uint8_t* key6, const uint8_t* key7, size_t keylen,
+	const uint8_t* nme0, const uint8_t* nme1, const uint8_t* nme2, const uint8_t* nme3,
+	const uint8_t* nme4, const uint8_t* nme5, const uint8_t* nme6, const uint8_t* nme7, size_t nmelen,
+	const uint8_t* cst0, const uint8_t* cst1, const uint8_t* cst2, const uint8_t* cst3,
+	const uint8_t* cst4, const uint8_t* cst5, const uint8_t* cst6, const uint8_t* cst7, size_t cstlen);
+
+/**
+* \brief Process 8 cSHAKE-512 instances simultaneously, each with its own key, name, and customization string.
+* The lanes are permuted with AVX-512, or as two AVX2 states, when available, otherwise sequentially.
+* If the name and customization lengths are both zero, each lane computes SHAKE-512.
+*
+* \warning The arrays in each group must be of the same length.
+*
+* \param out0: The 1st output array
+* \param out1: The 2nd output array
+* \param out2: The 3rd output array
+* \param out3: The 4th output array
+* \param out4: The 5th output array
+* \param out5: The 6th output array
+* \param out6: The 7th output array
+* \param out7: The 8th output array
+* \param otplen: The length of the output arrays
+* \param key0: [const] The 1st key array
+* \param key1: [const] The 2nd key array
+* \param key2: [const] The 3rd key array
+* \param key3: [const] The 4th key array
+* \param key4: [const] The 5th key array
+* \param key5: [const] The 6th key array
+* \param key6: [const] The 7th key array
+* \param key7: [const] The 8th key array
+* \param keylen: The length of the key arrays
+* \param nme0: [const] The 1st name array
+* \param nme1: [const] The 2nd name array
+* \param nme2: [const] The 3rd name array
+* \param nme3: [const] The 4th name array
+* \param nme4: [const] The 5th name array
+* \param nme5: [const] The 6th name array
+* \param nme6: [const] The 7th name array
+* \param nme7: [const] The 8th name array
+* \param nmelen: The length of the name arrays
+* \param cst0: [const] The 1st custom array
+* \param cst1: [const] The 2nd custom array
+* \param cst2: [const] The 3rd custom array
+* \param cst3: [const] The 4th custom array
+* \param cst4: [const] The 5th custom array
+* \param cst5: [const] The 6th custom array
+* \param cst6: [const] The 7th custom array
+* \param cst7: [const] The 8th custom array
+* \param cstlen: The length of the custom arrays
+*/
+QSC_EXPORT_API void qsc_cshake_512x8(uint8_t* out0, uint8_t* out1, uint8_t* out2, uint8_t* out3,
+	uint8_t* out4, uint8_t* out5, uint8_t* out6, uint8_t* out7, size_t otplen,
+	const uint8_t* key0, const uint8_t* key1, const uint8_t* key2, const uint8_t* key3,
+	const uint8_t* key4, const uint8_t* key5, const uint8_t* key6, const uint8_t* key7, size_t keylen,
+	const uint8_t* nme0, const uint8_t* nme1, const uint8_t* nme2, const uint8_t* nme3,
+	const uint8_t* nme4, const uint8_t* nme5, const uint8_t* nme6, const uint8_t* nme7, size_t nmelen,
+	const uint8_t* cst0, const uint8_t* cst1, const uint8_t* cst2, const uint8_t* cst3,
+	const uint8_t* cst4, const uint8_t* cst5, const uint8_t* cst6, const uint8_t* cst7, size_t cstlen);
+
+/* batch cSHAKE key derivation */
+
+/**
+* \brief Derive a batch of subkeys from one master key with cSHAKE.
+* Subkey i is cSHAKE(key, name, custom || be32(i)), where be32(i) is the 4-byte big endian subkey index.
+* The subkeys are computed 8 or 4 at a time in the parallel Keccak states, and the remainder sequentially.
+*
+* \param output: The output array; receives count consecutive subkeys of otplen bytes
+* \param otplen: The byte length of each subkey
+* \param count: The number of subkeys to derive
+* \param rate: The rate of absorption in bytes
+* \param key: [const] The master key array
+* \param keylen: The master key length
+* \param name: [const] The function name string; can be NULL if the length is zero
+* \param namelen: The byte length of the name string
+* \param custom: [const] The customization string; can be NULL if the length is zero
+* \param custlen: The byte length of the customization string
+*/
+QSC_EXPORT_API void qsc_cshake_kdf_batch(uint8_t* output, size_t otplen, size_t count, qsc_keccak_rate rate, const uint8_t* key, size_t keylen,
+	const uint8_t* name, size_t namelen, const uint8_t* custom, size_t custlen);
+
+/* fixed-length hashing */
+
+/*!
+* \def QSC_KECCAK_NODE_SIZE
+* \brief The byte size of a fixed-length hash node, and of the PRF key and input
+*/
+#define QSC_KECCAK_NODE_SIZE 32
+
+/**
+* \brief Hash a pair of 32-byte nodes with SHA3-256; a 2-to-1 tree node hash.
+* The 64-byte input is written directly into the Keccak state, with no message buffer.
+*
+* \param output: The 32-byte output hash
+* \param input: [const] The 64-byte concatenation of the left and right nodes
+*/
+QSC_EXPORT_API void qsc_sha3_node256(uint8_t* output, const uint8_t* input);
+
+/**
+* \brief Hash 4 pairs of 32-byte nodes with SHA3-256 simultaneously.
+* The pairs are contiguous, as in one level of a Merkle tree; uses AVX2 when available.
+*
+* \param output: The 128-byte output array; receives the 4 node hashes in order
+* \param input: [const] The 256-byte input array of 4 node pairs
+*/
+QSC_EXPORT_API void qsc_sha3_node256x4(uint8_t* output, const uint8_t* input);
+
+/**
+* \brief Hash 8 pairs of 32-byte nodes with SHA3-256 simultaneously.
+* The pairs are contiguous, as in one level of a Merkle tree; uses AVX-512 or AVX2 when available.
+*
+* \param output: The 256-byte output array; receives the 8 node hashes in order
+* \param input: [const] The 512-byte input array of 8 node pairs
+*/
+QSC_EXPORT_API void qsc_sha3_node256x8(uint8_t* output, const uint8_t* input);
+
+/**
+* \brief Hash a pair of 32-byte nodes with SHAKE-256, producing a 32-byte node.
+* The 64-byte input is written directly into the Keccak state, with no message buffer.
+*
+* \param output: The 32-byte output hash
+* \param input: [const] The 64-byte concatenation of the left and right nodes
+*/
+QSC_EXPORT_API void qsc_shake256_node(uint8_t* output, const uint8_t* input);
+
+/**
+* \brief Hash 4 pairs of 32-byte nodes with SHAKE-256 simultaneously.
+* The pairs are contiguous, as in one level of a Merkle tree; uses AVX2 when available.
+*
+* \param output: The 128-byte output array; receives the 4 node hashes in order
+* \param input: [const] The 256-byte input array of 4 node pairs
+*/
+QSC_EXPORT_API void qsc_shake256_nodex4(uint8_t* output, const uint8_t* input);
+
+/**
+* \brief Hash 8 pairs of 32-byte nodes with SHAKE-256 simultaneously.
+* The pairs are contiguous, as in one level of a Merkle tree; uses AVX-512 or AVX2 when available.
+*
+* \param output: The 256-byte output array; receives the 8 node hashes in order
+* \param input: [const] The 512-byte input array of 8 node pairs
+*/
+QSC_EXPORT_API void qsc_shake256_nodex8(uint8_t* output, const uint8_t* input);
+
+/**
+* \brief A SHAKE-256 PRF over a 32-byte key and a 32-byte input; computes SHAKE-256(key || input).
+* The key and input are written directly into the Keccak state, with no message buffer.
+*
+* \warning The output length can not exceed the SHAKE-256 rate of 136 bytes.
+*
+* \param output: The output array
+* \param otplen: The number of output bytes to generate
+* \param key: [const] The 32-byte key
+* \param input: [const] The 32-byte input
+*/
+QSC_EXPORT_API void qsc_shake256_prf(uint8_t* output, size_t otplen, const uint8_t* key, const uint8_t* input);
+
+/**
+* \brief Compute 4 SHAKE-256 PRF outputs under one key simultaneously; uses AVX2 when available.
+*
+* \warning The output length can not exceed the SHAKE-256 rate of 136 bytes.
+*
+* \param output: The output array; receives 4 consecutive outputs of otplen bytes
+* \param otplen: The number of output bytes to generate for each input
+* \param key: [const] The 32-byte key
+* \param input: [const] The 128-byte input array of 4 consecutive 32-byte inputs
+*/
+QSC_EXPORT_API void qsc_shake256_prfx4(uint8_t* output, size_t otplen, const uint8_t* key, const uint8_t* input);
+
+/**
+* \brief Compute 8 SHAKE-256 PRF outputs under one key simultaneously; uses AVX-512 or AVX2 when available.
+*
+* \warning The output length can not exceed the SHAKE-256 rate of 136 bytes.
+*
+* \param output: The output array; receives 8 consecutive outputs of otplen bytes
+* \param otplen: The number of output bytes to generate for each input
+* \param key: [const] The 32-byte key
+* \param input: [const] The 256-byte input array of 8 consecutive 32-byte inputs
+*/
+QSC_EXPORT_API void qsc_shake256_prfx8(uint8_t* output, size_t otplen, const uint8_t* key, const uint8_t* input);
+
+/* multi-buffer Keccak */
+
+/*!
+* \def QSC_KECCAK_JOB_LANES
+* \brief The number of independent Keccak jobs processed in parallel SIMD lanes by the multi-buffer engine
+*/
+#if defined(QSC_SYSTEM_HAS_AVX512)
+#	define QSC_KECCAK_JOB_LANES 8
+#elif defined(QSC_SYSTEM_HAS_AVX2)
+#	define QSC_KECCAK_JOB_LANES 4
+#else
+#	define QSC_KECCAK_JOB_LANES 1
+#endif
+
+/*!
+* \enum qsc_keccak_job_function
+* \brief The Keccak function computed by a multi-buffer job
+*/
+typedef enum qsc_keccak_job_function
+{
+	qsc_keccak_job_sha3 = 0,						/*!< A SHA3 message digest; the output size is the digest size of the rate  */
+	qsc_keccak_job_shake = 1,						/*!< A SHAKE XOF; the message is the input key  */
+	qsc_keccak_job_kmac = 2,						/*!< A KMAC code; keyed with the key and custom arrays  */
+} qsc_keccak_job_function;
+
+/*!
+* \struct qsc_keccak_job
+* \brief A multi-buffer job; one independent SHA3, SHAKE, or KMAC computation
+*/
+QSC_EXPORT_API typedef struct
+{
+	uint8_t* output;								/*!< The output array  */
+	const uint8_t* message;							/*!< The message array  */
+	const uint8_t* key;								/*!< The KMAC key array; unused by SHA3 and SHAKE  */
+	const uint8_t* custom;							/*!< The KMAC customization string; can be NULL  */
+	size_t otplen;									/*!< The number of output bytes; ignored by SHA3  */
+	size_t msglen;									/*!< The number of message bytes  */
+	size_t keylen;									/*!< The KMAC key length  */
+	size_t custlen;									/*!< The KMAC customization string length  */
+	qsc_keccak_rate rate;							/*!< The Keccak rate; selects the 128, 256, or 512-bit function  */
+	qsc_keccak_job_function function;				/*!< The Keccak function  */
+} qsc_keccak_job;
+
+/*!
+* \struct qsc_keccak_job_manager
+* \brief The multi-buffer job manager; queues jobs in a caller supplied array
+*/
+QSC_EXPORT_API typedef struct
+{
+	qsc_keccak_job* jobs;							/*!< The job queue array  */
+	size_t capacity;								/*!< The number of jobs the queue can hold  */
+	size_t count;									/*!< The number of queued jobs  */
+} qsc_keccak_job_manager;
+
+/**
+* \brief Compute a set of independent SHA3, SHAKE, and KMAC jobs.
+* Up to QSC_KECCAK_JOB_LANES jobs are processed in parallel SIMD lanes (8 with AVX-512, 4 with AVX2).
+* The jobs are scheduled longest first, and a lane that completes its job is refilled from the pending set,
+* so messages of different lengths, functions, and rates share the permutation lanes without idling. \n
+* Each job produces the same output as the corresponding sequential compute function.
+*
+* \param jobs: [struct] The array of jobs
+* \param count: The number of jobs in the array
+*/
+QSC_EXPORT_API void qsc_keccak_jobs_compute(qsc_keccak_job* jobs, size_t count);
+
+/**
+* \brief Compute all queued jobs and empty the queue.
+*
+* \param mgr: [struct] The job manager; must be initialized
+*/
+QSC_EXPORT_API void qsc_keccak_jobs_flush(qsc_keccak_job_manager* mgr);
+
+/**
+* \brief Initialize a multi-buffer job manager.
+*
+* \param mgr: [struct] The job manager
+* \param jobs: [struct] The array used to queue jobs
+* \param capacity: The number of jobs the array can hold
+*/
+QSC_EXPORT_API void qsc_keccak_jobs_initialize(qsc_keccak_job_manager* mgr, qsc_keccak_job* jobs, size_t capacity);
+
+/**
+* \brief Submit a job to the manager queue.
+* If the queue is full, the queued jobs are computed before the job is added.
+*
+* \warning The output of a job is written when the queue is flushed;
+* the message, key, and output arrays must remain valid until then.
+*
+* \param mgr: [struct] The job manager; must be initialized
+* \param job: [const][struct] The job to queue
+*/
+QSC_EXPORT_API void qsc_keccak_jobs_submit(qsc_keccak_job_manager* mgr, const qsc_keccak_job* job);
+
+/* batch MAC verification */
+
+/*!
+* \struct qsc_kmac_verify_item
+* \brief One KMAC code to verify in a batch; each item carries its own key
+*/
+QSC_EXPORT_API typedef struct
+{
+	const uint8_t* code;							/*!< The received MAC code  */
+	const uint8_t* message;							/*!< The message array  */
+	const uint8_t* key;								/*!< The KMAC key array  */
+	const uint8_t* custom;							/*!< The KMAC customization string; can be NULL  */
+	size_t codelen;									/*!< The MAC code length; must be non-zero  */
+	size_t msglen;									/*!< The number of message bytes  */
+	size_t keylen;									/*!< The KMAC key length  */
+	size_t custlen;									/*!< The KMAC customization string length  */
+} qsc_kmac_verify_item;
+
+/**
+* \brief Verify a batch of KMAC codes.
+* The codes are computed with the multi-buffer Keccak engine, so items of different lengths and keys share the
+* permutation lanes, and each code is compared in constant time. Every item is evaluated; the bitmap reveals
+* which items failed, but not where a code differs. \n
+* Bit (i % 8) of bitmap byte (i / 8) is set if item i verifies.
+*
+* \param bitmap: The output bitmap; must be at least (count + 7) / 8 bytes
+* \param items: [const][struct] The array of items to verify
+* \param count: The number of items
+* \param rate: The Keccak rate; selects KMAC-128, KMAC-256, or KMAC-512
+* \return: Returns true if every item verifies; returns false if any item fails or memory allocation fails
+*/
+QSC_EXPORT_API bool qsc_kmac_verify_batch(uint8_t* bitmap, const qsc_kmac_verify_item* items, size_t count, qsc_keccak_rate rate);
+
+/* TurboSHAKE and KangarooTwelve */
+
+/*!
+* \def QSC_TURBOSHAKE_DOMAIN_ID
+* \brief The default TurboSHAKE domain id
+*/
+#define QSC_TURBOSHAKE_DOMAIN_ID 0x1F
+
+/*!
+* \def QSC_KANGAROOTWELVE_CHUNK_SIZE
+* \brief The KangarooTwelve tree leaf size in bytes
+*/
+#define QSC_KANGAROOTWELVE_CHUNK_SIZE 8192
+
+/*!
+* \def QSC_KT128_HASH_SIZE
+* \brief The KT128 default output size in bytes
+*/
+#define QSC_KT128_HASH_SIZE 32
+
+/*!
+* \def QSC_KT256_HASH_SIZE
+* \brief The KT256 default output size in bytes
+*/
+#define QSC_KT256_HASH_SIZE 64
+
+/**
+* \brief Compute TurboSHAKE128; the 12-round Keccak-p[1600] XOF with a 168 byte rate.
+*
+* \param output: The output byte array
+* \param otplen: The number of output bytes to generate
+* \param message: [const] The input message byte array
+* \param msglen: The number of message bytes to process
+* \param domain: The domain separation byte, between 0x01 and 0x7F; the default is QSC_TURBOSHAKE_DOMAIN_ID
+*/
+QSC_EXPORT_API void qsc_turboshake128_compute(uint8_t* output, size_t otplen, const uint8_t* message, size_t msglen, uint8_t domain);
+
+/**
+* \brief Compute TurboSHAKE256; the 12-round Keccak-p[1600] XOF with a 136 byte rate.
+*
+* \param output: The output byte array
+* \param otplen: The number of output bytes to generate
+* \param message: [const] The input message byte array
+* \param msglen: The number of message bytes to process
+* \param domain: The domain separation byte, between 0x01 and 0x7F; the default is QSC_TURBOSHAKE_DOMAIN_ID
+*/
+QSC_EXPORT_API void qsc_turboshake256_compute(uint8_t* output, size_t otplen, const uint8_t* message, size_t msglen, uint8_t domain);
+
+/**
+* \brief Compute the KT128 (KangarooTwelve) tree hash of a message.
+* The message is divided into 8KB leaves that are hashed with TurboSHAKE128,
+* 8 leaves at a time with AVX-512 or 4 with AVX2.
+*
+* \param output: The output byte array
+* \param otplen: The number of output bytes to generate
+* \param message: [const] The input message byte array
+* \param msglen: The number of message bytes to process
+* \param custom: [const] The customization string; can be NULL
+* \param custlen: The byte length of the customization string
+*/
+QSC_EXPORT_API void qsc_kt128_compute(uint8_t* output, size_t otplen, const uint8_t* message, size_t msglen, const uint8_t* custom, size_t custlen);
+
+/**
+* \brief Compute the KT128 tree hash of a message, dividing the leaves of large messages between threads.
+* Produces the same output as qsc_kt128_compute; small messages are hashed on the calling thread.
+*
+* \param output: The output byte array
+* \param otplen: The number of output bytes to generate
+* \param message: [const] The input message byte array
+* \param msglen: The number of message bytes to process
+* \param custom: [const] The customization string; can be NULL
+* \param custlen: The byte length of the customization string
+*/
+QSC_EXPORT_API void qsc_kt128_parallel_compute(uint8_t* output, size_t otplen, const uint8_t* message, size_t msglen, const uint8_t* custom, size_t custlen);
+
+/**
+* \brief Compute the KT256 tree hash of a message.
+* The message is divided into 8KB leaves that are hashed with TurboSHAKE256,
+* 8 leaves at a time with AVX-512 or 4 with AVX2.
+*
+* \param output: The output byte array
+* \param otplen: The number of output bytes to generate
+* \param message: [const] The input message byte array
+* \param msglen: The number of message bytes to process
+* \param custom: [const] The customization string; can be NULL
+* \param custlen: The byte length of the customization string
+*/
+QSC_EXPORT_API void qsc_kt256_compute(uint8_t* output, size_t otplen, const uint8_t* message, size_t msglen, const uint8_t* custom, size_t custlen);
+
+/**
+* \brief Compute the KT256 tree hash of a message, dividing the leaves of large messages between threads.
+* Produces the same output as qsc_kt256_compute; small messages are hashed on the calling thread.
+*
+* \param output: The output byte array
+* \param otplen: The number of output bytes to generate
+* \param message: [const] The input message byte array
+* \param msglen: The number of message bytes to process
+* \param custom: [const] The customization string; can be NULL
+* \param custlen: The byte length of the customization string
+*/
+QSC_EXPORT_API void qsc_kt256_parallel_compute(uint8_t* output, size_t otplen, const uint8_t* message, size_t msglen, const uint8_t* custom, size_t custlen);
+
 #endif
@@ -1,5 +1,38 @@
 #include "sphincsplus.h"
 #include "sphincsplusbase.h"
+#include "memutils.h"
+
+/*!
+\def SPHINCSPLUS_PREHASH_SIZE
+* \brief The byte size of the SHAKE256 message pre-hash
+*/
+#define SPHINCSPLUS_PREHASH_SIZE 64
+
+/*!
+\def SPHINCSPLUS_PREHASH_OID_SIZE
+* \brief The byte size of the DER encoded pre-hash function identifier
+*/
+#define SPHINCSPLUS_PREHASH_OID_SIZE 11
+
+/*!
+\def SPHINCSPLUS_PREHASH_MESSAGE_SIZE
+* \brief The byte size of the signed pre-hash encoding
+*/
+#define SPHINCSPLUS_PREHASH_MESSAGE_SIZE (2 + SPHINCSPLUS_PREHASH_OID_SIZE + SPHINCSPLUS_PREHASH_SIZE)
+
+/* the pre-hash domain byte, an empty context, and the SHAKE256 object identifier 2.16.840.1.101.3.4.2.12 */
+static const uint8_t sphincsplus_prehash_prefix[2 + SPHINCSPLUS_PREHASH_OID_SIZE] =
+{
+	0x01, 0x00, 0x06, 0x09, 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x0C
+};
+
+static void sphincsplus_prehash_message(uint8_t* output, qsc_keccak_state* kstate)
+{
+	qsc_memutils_copy(output, sphincsplus_prehash_prefix, sizeof(sphincsplus_prehash_prefix));
+	qsc_keccak_incremental_finalize(kstate, QSC_KECCAK_256_RATE, QSC_KECCAK_SHAKE_DOMAIN_ID);
+	qsc_keccak_incremental_squeeze(kstate, QSC_KECCAK_256_RATE, output + sizeof(sphincsplus_prehash_prefix), SPHINCSPLUS_PREHASH_SIZE);
+	qsc_keccak_dispose(kstate);
+}
 
 void qsc_sphincsplus_generate_keypair(uint8_t* publickey, uint8_t* privatekey, bool (*rng_generate)(uint8_t*, size_t))
 {
@@ -45,3 +78,114 @@ bool qsc_sphincsplus_verify(uint8_t* message, size_t* msglen, const uint8_t* sig
 
 	return res;
 }
+
+void qsc_sphincsplus_sign_detached(uint8_t* signature, size_t* siglen, const uint8_t* message, size_t msglen, const uint8_t* privatekey, bool (*rng_generate)(uint8_t*, size_t))
+{
+	assert(signature != NULL);
+	assert(siglen != NULL);
+	assert(message != NULL);
+	assert(privatekey != NULL);
+	assert(rng_generate != NULL);
+
+	if (signature != NULL && siglen != NULL && message != NULL && privatekey != NULL && rng_generate != NULL)
+	{
+		sphincsplus_ref_sign_signature(signature, siglen, message, msglen, privatekey, rng_generate);
+	}
+}
+
+bool qsc_sphincsplus_verify_detached(const uint8_t* signature, size_t siglen, const uint8_t* message, size_t msglen, const uint8_t* publickey)
+{
+	assert(signature != NULL);
+	assert(message != NULL);
+	assert(publickey != NULL);
+
+	bool res;
+
+	res = false;
+
+	if (signature != NULL && message != NULL && publickey != NULL)
+	{
+		res = sphincsplus_ref_sign_verify(signature, siglen, message, msglen, publickey);
+	}
+
+	return res;
+}
+
+void qsc_sphincsplus_sign_initialize(qsc_sphincsplus_stream_state* state)
+{
+	assert(state != NULL);
+
+	if (state != NULL)
+	{
+		qsc_keccak_initialize_state(&state->kstate);
+	}
+}
+
+void qsc_sphincsplus_sign_update(qsc_sphincsplus_stream_state* state, const uint8_t* message, size_t msglen)
+{
+	assert(state != NULL);
+	assert(message != NULL);
+
+	if (state != NULL && message != NULL)
+	{
+		qsc_keccak_incremental_absorb(&state->kstate, QSC_KECCAK_256_RATE, message, msglen);
+	}
+}
+
+void qsc_sphincsplus_sign_finalize(qsc_sphincsplus_stream_state* state, uint8_t* signature, size_t* siglen, const uint8_t* privatekey, bool (*rng_generate)(uint8_t*, size_t))
+{
+	assert(state != NULL);
+	assert(signature != NULL);
+	assert(siglen != NULL);
+	assert(privatekey != NULL);
+	assert(rng_generate != NULL);
+
+	uint8_t phm[SPHINCSPLUS_PREHASH_MESSAGE_SIZE];
+
+	if (state != NULL && signature != NULL && siglen != NULL && privatekey != NULL && rng_generate != NULL)
+	{
+		sphincsplus_prehash_message(phm, &state->kstate);
+		sphincsplus_ref_sign_signature(signature, siglen, phm, sizeof(phm), privatekey, rng_generate);
+	}
+}
+
+void qsc_sphincsplus_verify_initialize(qsc_sphincsplus_stream_state* state)
+{
+	assert(state != NULL);
+
+	if (state != NULL)
+	{
+		qsc_keccak_initialize_state(&state->kstate);
+	}
+}
+
+void qsc_sphincsplus_verify_update(qsc_sphincsplus_stream_state* state, const uint8_t* message, size_t msglen)
+{
+	assert(state != NULL);
+	assert(message != NULL);
+
+	if (state != NULL && message != NULL)
+	{
+		qsc_keccak_incremental_absorb(&state->kstate, QSC_KECCAK_256_RATE, message, msglen);
+	}
+}
+
+bool qsc_sphincsplus_verify_finalize(qsc_sphincsplus_stream_state* state, const uint8_t* signature, size_t siglen, const uint8_t* publickey)
+{
+	assert(state != NULL);
+	assert(signature != NULL);
+	assert(publickey != NULL);
+
+	uint8_t phm[SPHINCSPLUS_PREHASH_MESSAGE_SIZE];
+	bool res;
+
+	res = false;
+
+	if (state != NULL && signature != NULL && publickey != NULL)
+	{
+		sphincsplus_prehash_message(phm, &state->kstate);
+		res = sphincsplus_ref_sign_verify(signature, siglen, phm, sizeof(phm), publickey);
+	}
+
+	return res;
+}
@@ -26,6 +26,7 @@
 #define QSC_SPHINCSPLUS_H
 
 #include "common.h"
+#include "sha3.h"
 
 /**
 * \file sphincsplus.h
@@ -235,6 +236,18 @@
 */
 #define QSC_SPHINCSPLUS_ALGNAME "SPHINCSPLUS"
 
+/**
+* \struct qsc_sphincsplus_stream_state
+* \brief The SPHINCS+ streaming sign and verify state. \n
+* Holds the SHAKE256 state that absorbs the message in chunks.
+* SPHINCS+ hashes the message twice during signing, so streaming signatures
+* sign a SHAKE256 pre-hash of the message rather than the message itself.
+*/
+typedef struct
+{
+	qsc_keccak_state kstate;	/*!< The message pre-hash state */
+} qsc_sphincsplus_stream_state;
+
 /**
 * \brief Generates a Sphincs+ public/private key-pair.
 *
@@ -272,4 +285,94 @@ QSC_EXPORT_API void qsc_sphincsplus_sign(uint8_t* signedmsg, size_t* smsglen, co
 */
 QSC_EXPORT_API bool qsc_sphincsplus_verify(uint8_t* message, size_t* msglen, const uint8_t* signedmsg, size_t smsglen, const uint8_t* publickey);
 
+/**
+* \brief Signs a message and returns a detached signature.
+* The message is read in place; no copy of the message is made.
+*
+* \warning Signature array must be sized to QSC_SPHINCSPLUS_SIGNATURE_SIZE.
+*
+* \param signature: Pointer to the signature array
+* \param siglen: The signature length
+* \param message: [const] Pointer to the message array
+* \param msglen: The message array length
+* \param privatekey: [const] Pointer to the private signature-key
+* \param rng_generate: Pointer to the random generator
+*/
+QSC_EXPORT_API void qsc_sphincsplus_sign_detached(uint8_t* signature, size_t* siglen, const uint8_t* message, size_t msglen, const uint8_t* privatekey, bool (*rng_generate)(uint8_t*, size_t));
+
+/**
+* \brief Verifies a detached signature against a message with the public key.
+*
+* \param signature: [const] Pointer to the signature array
+* \param siglen: The signature length
+* \param message: [const] Pointer to the message array
+* \param msglen: The message array length
+* \param publickey: [const] Pointer to the public verification-key array
+* \return Returns true for success
+*/
+QSC_EXPORT_API bool qsc_sphincsplus_verify_detached(const uint8_t* signature, size_t siglen, const uint8_t* message, size_t msglen, const uint8_t* publickey);
+
+/**
+* \brief Initialize a streaming (pre-hashed) signature.
+* Long form api: must be used in conjunction with the update and finalize functions.
+* The signature is computed over the pre-hash encoding 0x01 || 0x00 || OID(SHAKE256) || SHAKE256(message, 64),
+* and verifies only with the streaming verification functions.
+*
+* \param state: [struct] The stream state
+*/
+QSC_EXPORT_API void qsc_sphincsplus_sign_initialize(qsc_sphincsplus_stream_state* state);
+
+/**
+* \brief Add a block of message bytes to a streaming signature.
+* Can be called any number of times; memory use does not depend on the message length.
+*
+* \param state: [struct] The stream state
+* \param message: [const] Pointer to the message block
+* \param msglen: The message block length
+*/
+QSC_EXPORT_API void qsc_sphincsplus_sign_update(qsc_sphincsplus_stream_state* state, const uint8_t* message, size_t msglen);
+
+/**
+* \brief Finalize a streaming signature and return the detached signature.
+* The stream state is erased.
+*
+* \warning Signature array must be sized to QSC_SPHINCSPLUS_SIGNATURE_SIZE.
+*
+* \param state: [struct] The stream state
+* \param signature: Pointer to the signature array
+* \param siglen: The signature length
+* \param privatekey: [const] Pointer to the private signature-key
+* \param rng_generate: Pointer to the random generator
+*/
+QSC_EXPORT_API void qsc_sphincsplus_sign_finalize(qsc_sphincsplus_stream_state* state, uint8_t* signature, size_t* siglen, const uint8_t* privatekey, bool (*rng_generate)(uint8_t*, size_t));
+
+/**
+* \brief Initialize a streaming (pre-hashed) verification.
+* Long form api: must be used in conjunction with the update and finalize functions.
+*
+* \param state: [struct] The stream state
+*/
+QSC_EXPORT_API void qsc_sphincsplus_verify_initialize(qsc_sphincsplus_stream_state* state);
+
+/**
+* \brief Add a block of message bytes to a streaming verification.
+*
+* \param state: [struct] The stream state
+* \param message: [const] Pointer to the message block
+* \param msglen: The message block length
+*/
+QSC_EXPORT_API void qsc_sphincsplus_verify_update(qsc_sphincsplus_stream_state* state, const uint8_t* message, size_t msglen);
+
+/**
+* \brief Finalize a streaming verification and verify the detached signature.
+* The stream state is erased.
+*
+* \param state: [struct] The stream state
+* \param signature: [const] Pointer to the signature array
+* \param siglen: The signature length
+* \param publickey: [const] Pointer to the public verification-key array
+* \return Returns true for success
+*/
+QSC_EXPORT_API bool qsc_sphincsplus_verify_finalize(qsc_sphincsplus_stream_state* state, const uint8_t* signature, size_t siglen, const uint8_t* publickey);
+
 #endif
@@ -4,13 +4,35 @@
 #include "../QSC/chacha.h"
 #include "../QSC/csp.h"
 #include "../QSC/csx.h"
+#include "../QSC/dilithium.h"
+#include "../QSC/falcon.h"
+#include "../QSC/memutils.h"
 #include "../QSC/rcs.h"
+#include "../QSC/sha2.h"
 #include "../QSC/sha3.h"
 #include "../QSC/timerex.h"
+#if defined(QSC_SYSTEM_AVX_INTRINSICS)
+#	include "../QSC/intrinsics.h"
+#endif
 
 #define BUFFER_SIZE 1024
 #define SAMPLE_COUNT 1000000
 #define ONE_GIGABYTE 1024000000
+#define KECCAK_JOB_COUNT 64
+#define KECCAK_JOB_MESSAGE 2048
+#define KANGAROOTWELVE_MESSAGE (16 * 1024 * 1024)
+#define KECCAK_CPB_MESSAGE 16384
+#define KECCAK_CPB_SAMPLES 1000
+#define KECCAK_FIXED_SAMPLES 10000
+#define SHA256_JOB_COUNT 64
+#define SHA256_JOB_MESSAGE 2048
+#define SHA2_CPB_MESSAGE 16384
+#define SHA2_CPB_SAMPLES 1000
+#define DILITHIUM_BENCH_MESSAGE 64
+#define DILITHIUM_BENCH_SAMPLES 2000
+#define DILITHIUM_LATENCY_SAMPLES 1000
+#define FALCON_BENCH_MESSAGE 64
+#define FALCON_BENCH_SAMPLES 1000
 
 static void aes128_cbc_benchmark_test()
 {
@@ -998,6 +1020,623 @@ static void shake512x8_benchmark()
 }
 #endif
 
+static void keccak_jobs_benchmark(qsc_keccak_job_function function)
+{
+	uint8_t key[32] = { 0 };
+	uint8_t otp[KECCAK_JOB_COUNT][32] = { 0 };
+	qsc_keccak_job jobs[KECCAK_JOB_COUNT];
+	uint8_t* msg;
+	size_t i;
+	size_t tctr;
+	size_t tlen;
+	uint64_t start;
+	uint64_t elapsed;
+
+	msg = (uint8_t*)qsc_memutils_malloc(KECCAK_JOB_COUNT * KECCAK_JOB_MESSAGE);
+
+	if (msg != NULL)
+	{
+		qsc_csp_generate(msg, KECCAK_JOB_COUNT * KECCAK_JOB_MESSAGE);
+		tlen = 0;
+
+		/* a set of messages between 32 and 2048 bytes */
+		for (i = 0; i < KECCAK_JOB_COUNT; ++i)
+		{
+			jobs[i].function = function;
+			jobs[i].rate = qsc_keccak_rate_256;
+			jobs[i].message = msg + (i * KECCAK_JOB_MESSAGE);
+			jobs[i].msglen = 32 + ((i * 97) % (KECCAK_JOB_MESSAGE - 32));
+			jobs[i].output = otp[i];
+			jobs[i].otplen = sizeof(otp[i]);
+			jobs[i].key = key;
+			jobs[i].keylen = sizeof(key);
+			jobs[i].custom = NULL;
+			jobs[i].custlen = 0;
+			tlen += jobs[i].msglen;
+		}
+
+		/* sequential */
+
+		tctr = 0;
+		start = qsc_timerex_stopwatch_start();
+
+		while (tctr < ONE_GIGABYTE)
+		{
+			for (i = 0; i < KECCAK_JOB_COUNT; ++i)
+			{
+				if (function == qsc_keccak_job_kmac)
+				{
+					qsc_kmac256_compute(otp[i], sizeof(otp[i]), jobs[i].message, jobs[i].msglen, key, sizeof(key), NULL, 0);
+				}
+				else
+				{
+					qsc_sha3_compute256(otp[i], jobs[i].message, jobs[i].msglen);
+				}
+			}
+
+			tctr += tlen;
+		}
+
+		elapsed = qsc_timerex_stopwatch_elapsed(start);
+		qsctest_print_safe((function == qsc_keccak_job_kmac) ? "KMAC-256" : "SHA3-256");
+		qsctest_print_safe(" sequential processed 1GB of mixed length messages in ");
+		qsctest_print_double((double)elapsed / 1000.0);
+		qsctest_print_line(" seconds");
+
+		/* multi-buffer */
+
+		tctr = 0;
+		start = qsc_timerex_stopwatch_start();
+
+		while (tctr < ONE_GIGABYTE)
+		{
+			qsc_keccak_jobs_compute(jobs, KECCAK_JOB_COUNT);
+			tctr += tlen;
+		}
+
+		elapsed = qsc_timerex_stopwatch_elapsed(start);
+		qsctest_print_safe((function == qsc_keccak_job_kmac) ? "KMAC-256" : "SHA3-256");
+		qsctest_print_safe(" multi-buffer processed 1GB of mixed length messages in ");
+		qsctest_print_double((double)elapsed / 1000.0);
+		qsctest_print_line(" seconds");
+
+		qsc_memutils_alloc_free(msg);
+	}
+}
+
+#if defined(QSC_SYSTEM_AVX_INTRINSICS)
+static void keccak_cpb_benchmark(bool shake)
+{
+	const size_t MSGLEN[3] = { 64, 1024, KECCAK_CPB_MESSAGE };
+	uint8_t otp[QSC_SHA3_256_HASH_SIZE] = { 0 };
+	uint8_t* msg;
+	uint64_t best;
+	uint64_t start;
+	uint64_t cycles;
+	size_t i;
+	size_t j;
+
+	msg = (uint8_t*)qsc_memutils_malloc(KECCAK_CPB_MESSAGE);
+
+	if (msg != NULL)
+	{
+		qsc_memutils_setvalue(msg, 0xA5, KECCAK_CPB_MESSAGE);
+
+		for (i = 0; i < sizeof(MSGLEN) / sizeof(size_t); ++i)
+		{
+			/* the fastest sample is the least disturbed by interrupts and frequency changes */
+			best = UINT64_MAX;
+
+			for (j = 0; j < KECCAK_CPB_SAMPLES; ++j)
+			{
+				start = __rdtsc();
+
+				if (shake == true)
+				{
+					qsc_shake128_compute(otp, sizeof(otp), msg, MSGLEN[i]);
+				}
+				else
+				{
+					qsc_sha3_compute256(otp, msg, MSGLEN[i]);
+				}
+
+				cycles = __rdtsc() - start;
+				best = (cycles < best) ? cycles : best;
+			}
+
+			qsctest_print_safe((shake == true) ? "SHAKE-128 " : "SHA3-256 ");
+			qsctest_print_ulong((uint64_t)MSGLEN[i]);
+			qsctest_print_safe(" byte message: ");
+			qsctest_print_double((double)best / (double)MSGLEN[i]);
+			qsctest_print_line(" cycles per byte");
+		}
+
+		qsc_memutils_alloc_free(msg);
+	}
+}
+
+static void keccak_fixed_benchmark()
+{
+	const char* NAMES[8] = { "SHA3-256 generic 64 byte hash: ", "SHA3-256 node: ", "SHA3-256 node x4: ", "SHA3-256 node x8: ",
+		"SHAKE-256 generic 64 byte hash: ", "SHAKE-256 PRF: ", "SHAKE-256 PRF x4: ", "SHAKE-256 PRF x8: " };
+	const size_t HASHES[8] = { 1, 1, 4, 8, 1, 1, 4, 8 };
+	uint8_t inp[16 * QSC_KECCAK_NODE_SIZE] = { 0 };
+	uint8_t key[QSC_KECCAK_NODE_SIZE] = { 0 };
+	uint8_t otp[8 * QSC_KECCAK_NODE_SIZE] = { 0 };
+	uint64_t best;
+	uint64_t start;
+	uint64_t cycles;
+	size_t i;
+	size_t j;
+
+	qsc_memutils_setvalue(inp, 0xA5, sizeof(inp));
+	qsc_memutils_setvalue(key, 0x5A, sizeof(key));
+
+	for (i = 0; i < sizeof(HASHES) / sizeof(size_t); ++i)
+	{
+		best = UINT64_MAX;
+
+		for (j = 0; j < KECCAK_FIXED_SAMPLES; ++j)
+		{
+			start = __rdtsc();
+
+			/* the generic functions hash the same 64 bytes through the buffered absorb and squeeze path */
+			if (i == 0)
+			{
+				qsc_sha3_compute256(otp, inp, 2 * QSC_KECCAK_NODE_SIZE);
+			}
+			else if (i == 1)
+			{
+				qsc_sha3_node256(otp, inp);
+			}
+			else if (i == 2)
+			{
+				qsc_sha3_node256x4(otp, inp);
+			}
+			else if (i == 3)
+			{
+				qsc_sha3_node256x8(otp, inp);
+			}
+			else if (i == 4)
+			{
+				qsc_shake256_compute(otp, QSC_KECCAK_NODE_SIZE, inp, 2 * QSC_KECCAK_NODE_SIZE);
+			}
+			else if (i == 5)
+			{
+				qsc_shake256_prf(otp, QSC_KECCAK_NODE_SIZE, key, inp);
+			}
+			else if (i == 6)
+			{
+				qsc_shake256_prfx4(otp, QSC_KECCAK_NODE_SIZE, key, inp);
+			}
+			else
+			{
+				qsc_shake256_prfx8(otp, QSC_KECCAK_NODE_SIZE, key, inp);
+			}
+
+			cycles = __rdtsc() - start;
+			best = (cycles < best) ? cycles : best;
+		}
+
+		qsctest_print_safe(NAMES[i]);
+		qsctest_print_double((double)best / (double)HASHES[i]);
+		qsctest_print_line(" cycles per hash");
+	}
+}
+#endif
+
+static void kangarootwelve_benchmark(bool parallel)
+{
+	uint8_t otp[QSC_KT128_HASH_SIZE] = { 0 };
+	uint8_t* msg;
+	size_t tctr;
+	uint64_t start;
+	uint64_t elapsed;
+
+	msg = (uint8_t*)qsc_memutils_malloc(KANGAROOTWELVE_MESSAGE);
+
+	if (msg != NULL)
+	{
+		qsc_memutils_setvalue(msg, 0xA5, KANGAROOTWELVE_MESSAGE);
+		tctr = 0;
+		start = qsc_timerex_stopwatch_start();
+
+		while (tctr < ONE_GIGABYTE)
+		{
+			if (parallel == true)
+			{
+				qsc_kt128_parallel_compute(otp, sizeof(otp), msg, KANGAROOTWELVE_MESSAGE, NULL, 0);
+			}
+			else
+			{
+				qsc_kt128_compute(otp, sizeof(otp), msg, KANGAROOTWELVE_MESSAGE, NULL, 0);
+			}
+
+			tctr += KANGAROOTWELVE_MESSAGE;
+		}
+
+		elapsed = qsc_timerex_stopwatch_elapsed(start);
+		qsctest_print_safe((parallel == true) ? "KT128 multi-threaded" : "KT128");
+		qsctest_print_safe(" processed 1GB of data in ");
+		qsctest_print_double((double)elapsed / 1000.0);
+		qsctest_print_line(" seconds");
+
+		qsc_memutils_alloc_free(msg);
+	}
+}
+
+static void sha256_jobs_benchmark(qsc_sha256_job_function function)
+{
+	uint8_t key[QSC_HMAC_256_KEY_SIZE] = { 0 };
+	uint8_t otp[SHA256_JOB_COUNT][QSC_SHA2_256_HASH_SIZE] = { 0 };
+	qsc_sha256_job jobs[SHA256_JOB_COUNT];
+	uint8_t* msg;
+	size_t i;
+	size_t tctr;
+	size_t tlen;
+	uint64_t start;
+	uint64_t elapsed;
+
+	msg = (uint8_t*)qsc_memutils_malloc(SHA256_JOB_COUNT * SHA256_JOB_MESSAGE);
+
+	if (msg != NULL)
+	{
+		qsc_csp_generate(msg, SHA256_JOB_COUNT * SHA256_JOB_MESSAGE);
+		tlen = 0;
+
+		/* a set of messages between 32 and 2048 bytes */
+		for (i = 0; i < SHA256_JOB_COUNT; ++i)
+		{
+			jobs[i].function = function;
+			jobs[i].message = msg + (i * SHA256_JOB_MESSAGE);
+			jobs[i].msglen = 32 + ((i * 97) % (SHA256_JOB_MESSAGE - 32));
+			jobs[i].output = otp[i];
+			jobs[i].key = key;
+			jobs[i].keylen = sizeof(key);
+			tlen += jobs[i].msglen;
+		}
+
+		/* sequential */
+
+		tctr = 0;
+		start = qsc_timerex_stopwatch_start();
+
+		while (tctr < ONE_GIGABYTE)
+		{
+			for (i = 0; i < SHA256_JOB_COUNT; ++i)
+			{
+				if (function == qsc_sha256_job_hmac256)
+				{
+					qsc_hmac256_compute(otp[i], jobs[i].message, jobs[i].msglen, key, sizeof(key));
+				}
+				else
+				{
+					qsc_sha256_compute(otp[i], jobs[i].message, jobs[i].msglen);
+				}
+			}
+
+			tctr += tlen;
+		}
+
+		elapsed = qsc_timerex_stopwatch_elapsed(start);
+		qsctest_print_safe((function == qsc_sha256_job_hmac256) ? "HMAC(SHA2-256)" : "SHA2-256");
+		qsctest_print_safe(" sequential processed 1GB of mixed length messages in ");
+		qsctest_print_double((double)elapsed / 1000.0);
+		qsctest_print_line(" seconds");
+
+		/* multi-buffer */
+
+		tctr = 0;
+		start = qsc_timerex_stopwatch_start();
+
+		while (tctr < ONE_GIGABYTE)
+		{
+			qsc_sha256_jobs_compute(jobs, SHA256_JOB_COUNT);
+			tctr += tlen;
+		}
+
+		elapsed = qsc_timerex_stopwatch_elapsed(start);
+		qsctest_print_safe((function == qsc_sha256_job_hmac256) ? "HMAC(SHA2-256)" : "SHA2-256");
+		qsctest_print_safe(" multi-buffer processed 1GB of mixed length messages in ");
+		qsctest_print_double((double)elapsed / 1000.0);
+		qsctest_print_line(" seconds");
+
+		qsc_memutils_alloc_free(msg);
+	}
+}
+
+#if defined(QSC_SYSTEM_AVX_INTRINSICS)
+static void sha2_cpb_benchmark(bool sha512)
+{
+	const size_t MSGLEN[3] = { 64, 1024, SHA2_CPB_MESSAGE };
+	uint8_t otp[QSC_SHA2_512_HASH_SIZE] = { 0 };
+	uint8_t* msg;
+	uint64_t best;
+	uint64_t start;
+	uint64_t cycles;
+	size_t i;
+	size_t j;
+
+	msg = (uint8_t*)qsc_memutils_malloc(SHA2_CPB_MESSAGE);
+
+	if (msg != NULL)
+	{
+		qsc_memutils_setvalue(msg, 0xA5, SHA2_CPB_MESSAGE);
+
+		for (i = 0; i < sizeof(MSGLEN) / sizeof(size_t); ++i)
+		{
+			/* the fastest sample is the least disturbed by interrupts and frequency changes */
+			best = UINT64_MAX;
+
+			for (j = 0; j < SHA2_CPB_SAMPLES; ++j)
+			{
+				start = __rdtsc();
+
+				if (sha512 == true)
+				{
+					qsc_sha512_compute(otp, msg, MSGLEN[i]);
+				}
+				else
+				{
+					qsc_sha256_compute(otp, msg, MSGLEN[i]);
+				}
+
+				cycles = __rdtsc() - start;
+				best = (cycles < best) ? cycles : best;
+			}
+
+			qsctest_print_safe((sha512 == true) ? "SHA2-512 " : "SHA2-256 ");
+			qsctest_print_ulong((uint64_t)MSGLEN[i]);
+			qsctest_print_safe(" byte message: ");
+			qsctest_print_double((double)best / (double)MSGLEN[i]);
+			qsctest_print_line(" cycles per byte");
+		}
+
+		qsc_memutils_alloc_free(msg);
+	}
+}
+#endif
+
+static void dilithium_rate_print(const char* name, uint64_t elapsed)
+{
+	qsctest_print_safe(name);
+	qsctest_print_safe(": ");
+	qsctest_print_ulong(((uint64_t)DILITHIUM_BENCH_SAMPLES * 1000ULL) / ((elapsed != 0) ? elapsed : 1));
+	qsctest_print_line(" per second");
+}
+
+static void dilithium_sign_benchmark()
+{
+	uint8_t msg[DILITHIUM_BENCH_MESSAGE] = { 0 };
+	uint8_t pk[QSC_DILITHIUM_PUBLICKEY_SIZE] = { 0 };
+	uint8_t sk[QSC_DILITHIUM_PRIVATEKEY_SIZE] = { 0 };
+	uint8_t smsg[QSC_DILITHIUM_SIGNATURE_SIZE + DILITHIUM_BENCH_MESSAGE] = { 0 };
+	qsc_dilithium_expanded_privatekey* esk;
+	uint64_t start;
+	uint64_t elapsed;
+	size_t smsglen;
+	size_t i;
+
+	esk = (qsc_dilithium_expanded_privatekey*)qsc_memutils_aligned_alloc(64, sizeof(qsc_dilithium_expanded_privatekey));
+
+	if (esk != NULL)
+	{
+		qsc_csp_generate(msg, sizeof(msg));
+		qsc_dilithium_generate_keypair(pk, sk, qsc_csp_generate);
+
+		start = qsc_timerex_stopwatch_start();
+
+		for (i = 0; i < DILITHIUM_BENCH_SAMPLES; ++i)
+		{
+			msg[0] = (uint8_t)i;
+			qsc_dilithium_sign(smsg, &smsglen, msg, sizeof(msg), sk, qsc_csp_generate);
+		}
+
+		elapsed = qsc_timerex_stopwatch_elapsed(start);
+		dilithium_rate_print("Dilithium signatures with the packed private key", elapsed);
+
+		/* the key is expanded once, outside the timed loop */
+		qsc_dilithium_expand_privatekey(esk, sk);
+		start = qsc_timerex_stopwatch_start();
+
+		for (i = 0; i < DILITHIUM_BENCH_SAMPLES; ++i)
+		{
+			msg[0] = (uint8_t)i;
+			qsc_dilithium_sign_expanded(smsg, &smsglen, msg, sizeof(msg), esk, qsc_csp_generate);
+		}
+
+		elapsed = qsc_timerex_stopwatch_elapsed(start);
+		dilithium_rate_print("Dilithium signatures with the expanded private key", elapsed);
+
+		qsc_dilithium_expanded_privatekey_dispose(esk);
+		qsc_memutils_aligned_free(esk);
+	}
+}
+
+#if defined(QSC_SYSTEM_AVX_INTRINSICS)
+static void dilithium_latency_sort(uint64_t* samples, size_t count)
+{
+	uint64_t tmp;
+	size_t i;
+	size_t j;
+
+	for (i = 1; i < count; ++i)
+	{
+		tmp = samples[i];
+
+		for (j = i; j > 0 && samples[j - 1] > tmp; --j)
+		{
+			samples[j] = samples[j - 1];
+		}
+
+		samples[j] = tmp;
+	}
+}
+
+static void dilithium_latency_print(const char* name, uint64_t* samples, size_t count)
+{
+	dilithium_latency_sort(samples, count);
+
+	qsctest_print_safe(name);
+	qsctest_print_safe(": median ");
+	qsctest_print_ulong(samples[count / 2]);
+	qsctest_print_safe(", p99 ");
+	qsctest_print_ulong(samples[(count * 99) / 100]);
+	qsctest_print_safe(", max ");
+	qsctest_print_ulong(samples[count - 1]);
+	qsctest_print_line(" cycles");
+}
+
+static void dilithium_latency_benchmark()
+{
+	uint8_t msg[DILITHIUM_BENCH_MESSAGE] = { 0 };
+	uint8_t pk[QSC_DILITHIUM_PUBLICKEY_SIZE] = { 0 };
+	uint8_t sk[QSC_DILITHIUM_PRIVATEKEY_SIZE] = { 0 };
+	uint8_t sig[QSC_DILITHIUM_SIGNATURE_SIZE] = { 0 };
+	uint64_t* samples;
+	uint64_t start;
+	size_t siglen;
+	size_t i;
+
+	samples = (uint64_t*)qsc_memutils_malloc(DILITHIUM_LATENCY_SAMPLES * sizeof(uint64_t));
+
+	if (samples != NULL)
+	{
+		qsc_csp_generate(msg, sizeof(msg));
+		qsc_dilithium_generate_keypair(pk, sk, qsc_csp_generate);
+
+		/* the number of rejection-loop iterations varies per message, so the tail latency is measured */
+		for (i = 0; i < DILITHIUM_LATENCY_SAMPLES; ++i)
+		{
+			msg[0] = (uint8_t)i;
+			msg[1] = (uint8_t)(i >> 8);
+			start = __rdtsc();
+			qsc_dilithium_sign_detached(sig, &siglen, msg, sizeof(msg), sk, qsc_csp_generate);
+			samples[i] = __rdtsc() - start;
+		}
+
+		dilithium_latency_print("Dilithium sequential signing latency", samples, DILITHIUM_LATENCY_SAMPLES);
+
+		for (i = 0; i < DILITHIUM_LATENCY_SAMPLES; ++i)
+		{
+			msg[0] = (uint8_t)i;
+			msg[1] = (uint8_t)(i >> 8);
+			start = __rdtsc();
+			qsc_dilithium_sign_detached_parallel(sig, &siglen, msg, sizeof(msg), sk, qsc_csp_generate);
+			samples[i] = __rdtsc() - start;
+		}
+
+		dilithium_latency_print("Dilithium parallel signing latency", samples, DILITHIUM_LATENCY_SAMPLES);
+
+		qsc_memutils_alloc_free(samples);
+	}
+}
+#endif
+
+static void dilithium_verify_benchmark()
+{
+	uint8_t msg[DILITHIUM_BENCH_MESSAGE] = { 0 };
+	uint8_t pk[QSC_DILITHIUM_PUBLICKEY_SIZE] = { 0 };
+	uint8_t rmsg[DILITHIUM_BENCH_MESSAGE] = { 0 };
+	uint8_t sk[QSC_DILITHIUM_PRIVATEKEY_SIZE] = { 0 };
+	uint8_t smsg[QSC_DILITHIUM_SIGNATURE_SIZE + DILITHIUM_BENCH_MESSAGE] = { 0 };
+	qsc_dilithium_expanded_publickey* epk;
+	uint64_t start;
+	uint64_t elapsed;
+	size_t rmsglen;
+	size_t smsglen;
+	size_t i;
+
+	epk = (qsc_dilithium_expanded_publickey*)qsc_memutils_aligned_alloc(64, sizeof(qsc_dilithium_expanded_publickey));
+
+	if (epk != NULL)
+	{
+		qsc_csp_generate(msg, sizeof(msg));
+		qsc_dilithium_generate_keypair(pk, sk, qsc_csp_generate);
+		qsc_dilithium_sign(smsg, &smsglen, msg, sizeof(msg), sk, qsc_csp_generate);
+
+		start = qsc_timerex_stopwatch_start();
+
+		for (i = 0; i < DILITHIUM_BENCH_SAMPLES; ++i)
+		{
+			qsc_dilithium_verify(rmsg, &rmsglen, smsg, smsglen, pk);
+		}
+
+		elapsed = qsc_timerex_stopwatch_elapsed(start);
+		dilithium_rate_print("Dilithium verifications with the packed public key", elapsed);
+
+		/* the key is expanded once, outside the timed loop */
+		qsc_dilithium_expand_publickey(epk, pk);
+		start = qsc_timerex_stopwatch_start();
+
+		for (i = 0; i < DILITHIUM_BENCH_SAMPLES; ++i)
+		{
+			qsc_dilithium_verify_expanded(rmsg, &rmsglen, smsg, smsglen, epk);
+		}
+
+		elapsed = qsc_timerex_stopwatch_elapsed(start);
+		dilithium_rate_print("Dilithium verifications with the expanded public key", elapsed);
+
+		qsc_memutils_aligned_free(epk);
+	}
+}
+
+static void falcon_rate_print(const char* name, uint64_t elapsed)
+{
+	qsctest_print_safe(name);
+	qsctest_print_safe(": ");
+	qsctest_print_ulong(((uint64_t)FALCON_BENCH_SAMPLES * 1000ULL) / ((elapsed != 0) ? elapsed : 1));
+	qsctest_print_line(" per second");
+}
+
+static void falcon_sign_benchmark()
+{
+	uint8_t msg[FALCON_BENCH_MESSAGE] = { 0 };
+	uint8_t pk[QSC_FALCON_PUBLICKEY_SIZE] = { 0 };
+	uint8_t sk[QSC_FALCON_PRIVATEKEY_SIZE] = { 0 };
+	uint8_t smsg[QSC_FALCON_SIGNATURE_SIZE + FALCON_BENCH_MESSAGE] = { 0 };
+	qsc_falcon_expanded_privatekey* esk;
+	uint64_t start;
+	uint64_t elapsed;
+	size_t smsglen;
+	size_t i;
+
+	esk = (qsc_falcon_expanded_privatekey*)qsc_memutils_aligned_alloc(64, sizeof(qsc_falcon_expanded_privatekey));
+
+	if (esk != NULL)
+	{
+		qsc_csp_generate(msg, sizeof(msg));
+		qsc_falcon_generate_keypair(pk, sk, qsc_csp_generate);
+
+		start = qsc_timerex_stopwatch_start();
+
+		for (i = 0; i < FALCON_BENCH_SAMPLES; ++i)
+		{
+			msg[0] = (uint8_t)i;
+			qsc_falcon_sign(smsg, &smsglen, msg, sizeof(msg), sk, qsc_csp_generate);
+		}
+
+		elapsed = qsc_timerex_stopwatch_elapsed(start);
+		falcon_rate_print("Falcon signatures with the packed private key", elapsed);
+
+		/* the FFT basis and LDL tree are computed once, outside the timed loop */
+		qsc_falcon_expand_privatekey(esk, sk);
+		start = qsc_timerex_stopwatch_start();
+
+		for (i = 0; i < FALCON_BENCH_SAMPLES; ++i)
+		{
+			msg[0] = (uint8_t)i;
+			qsc_falcon_sign_expanded(smsg, &smsglen, msg, sizeof(msg), esk, qsc_csp_generate);
+		}
+
+		elapsed = qsc_timerex_stopwatch_elapsed(start);
+		falcon_rate_print("Falcon signatures with the expanded private key", elapsed);
+
+		qsc_falcon_expanded_privatekey_dispose(esk);
+		qsc_memutils_aligned_free(esk);
+	}
+}
+
 void qsctest_benchmark_aes_run()
 {
 	qsctest_print_line("Running the AES-128 performance benchmarks.");
@@ -1025,6 +1664,26 @@ void qsctest_benchmark_csx_run()
 	csx_benchmark_test();
 }
 
+void qsctest_benchmark_dilithium_run()
+{
+	qsctest_print_line("Running the Dilithium signing performance benchmarks.");
+	dilithium_sign_benchmark();
+
+#if defined(QSC_SYSTEM_AVX_INTRINSICS)
+	qsctest_print_line("Running the Dilithium signing latency benchmarks.");
+	dilithium_latency_benchmark();
+#endif
+
+	qsctest_print_line("Running the Dilithium verification performance benchmarks.");
+	dilithium_verify_benchmark();
+}
+
+void qsctest_benchmark_falcon_run()
+{
+	qsctest_print_line("Running the Falcon signing performance benchmarks.");
+	falcon_sign_benchmark();
+}
+
 void qsctest_benchmark_rcs_run()
 {
 	qsctest_print_line("Running the RCS-256 encryption and authentication performance benchmarks.");
@@ -1066,6 +1725,9 @@ void qsctest_benchmark_kmac_run()
 	qsctest_print_line("Running the AVX512 8X KMAC-512 performance benchmarks.");
 	kmac512x8_benchmark();
 #endif
+
+	qsctest_print_line("Running the multi-buffer KMAC-256 job performance benchmarks.");
+	keccak_jobs_benchmark(qsc_keccak_job_kmac);
 }
 
 void qsctest_benchmark_kpa_run()
@@ -1080,6 +1742,21 @@ void qsctest_benchmark_kpa_run()
 	kpa512_benchmark();
 }
 
+void qsctest_benchmark_sha2_run()
+{
+	qsctest_print_line("Running the multi-buffer SHA2-256 job performance benchmarks.");
+	sha256_jobs_benchmark(qsc_sha256_job_sha256);
+
+	qsctest_print_line("Running the multi-buffer HMAC(SHA2-256) job performance benchmarks.");
+	sha256_jobs_benchmark(qsc_sha256_job_hmac256);
+
+#if defined(QSC_SYSTEM_AVX_INTRINSICS)
+	qsctest_print_line("Running the SHA2-256 and SHA2-512 cycles per byte benchmarks.");
+	sha2_cpb_benchmark(false);
+	sha2_cpb_benchmark(true);
+#endif
+}
+
 void qsctest_benchmark_shake_run()
 {
 	qsctest_print_line("Running the SHAKE-128 performance benchmarks.");
@@ -1112,4 +1789,20 @@ void qsctest_benchmark_shake_run()
 	qsctest_print_line("Running the AVX512 8X SHAKE-512 performance benchmarks.");
 	shake512x8_benchmark();
 #endif
+
+	qsctest_print_line("Running the multi-buffer SHA3-256 job performance benchmarks.");
+	keccak_jobs_benchmark(qsc_keccak_job_sha3);
+
+#if defined(QSC_SYSTEM_AVX_INTRINSICS)
+	qsctest_print_line("Running the SHA3-256 and SHAKE-128 cycles per byte benchmarks.");
+	keccak_cpb_benchmark(false);
+	keccak_cpb_benchmark(true);
+
+	qsctest_print_line("Running the fixed-length SHA3-256 and SHAKE-256 node and PRF benchmarks.");
+	keccak_fixed_benchmark();
+#endif
+
+	qsctest_print_line("Running the KangarooTwelve KT128 performance benchmarks.");
+	kangarootwelve_benchmark(false);
+	kangarootwelve_benchmark(true);
 }
@@ -29,6 +29,18 @@ void qsctest_benchmark_chacha_run(void);
 */
 void qsctest_benchmark_csx_run(void);
 
+/**
+* \brief Tests the Dilithium signature scheme performance.
+* Measures the signing and verification rates with the packed and the expanded keys.
+*/
+void qsctest_benchmark_dilithium_run(void);
+
+/**
+* \brief Tests the Falcon signature scheme performance.
+* Measures the signing rate with the packed and the expanded private keys.
+*/
+void qsctest_benchmark_falcon_run(void);
+
 /**
 * \brief Tests the KMAC implementations performance.
 * Tests the Keccak MACs for performance timing.
@@ -47,6 +59,13 @@ void qsctest_benchmark_kpa_run(void);
 */
 void qsctest_benchmark_rcs_run(void);
 
+/**
+* \brief Tests the SHA2 implementations performance.
+* Tests the multi-buffer SHA2-256 and HMAC(SHA2-256) engine against the sequential functions for performance timing,
+* and measures the SHA2-256 and SHA2-512 cycles per byte.
+*/
+void qsctest_benchmark_sha2_run(void);
+
 /**
 * \brief Tests the SHAKE implementations performance.
 * Tests the various SHAKE implementations for performance timing.
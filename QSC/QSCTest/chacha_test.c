@@ -113,6 +113,289 @@ bool qsctest_chacha256_kat()
 	return status;
 }
 
+static bool chachapoly_kat_compare(bool extended, const uint8_t* key, const uint8_t* nonce, const uint8_t* aad, size_t aadlen, const uint8_t* msg, size_t msglen, const uint8_t* expected)
+{
+	uint8_t dec[128] = { 0 };
+	uint8_t enc[128 + QSC_CHACHAPOLY_MAC_SIZE] = { 0 };
+	qsc_chachapoly_state ctx;
+	bool status;
+
+	status = true;
+
+	/* encrypt and compare the cipher-text and tag */
+	if (extended == true)
+	{
+		qsc_xchachapoly_initialize(&ctx, key, nonce, true);
+	}
+	else
+	{
+		qsc_chachapoly_initialize(&ctx, key, nonce, true);
+	}
+
+	qsc_chachapoly_set_associated(&ctx, aad, aadlen);
+	qsc_chachapoly_transform(&ctx, enc, msg, msglen);
+
+	if (qsc_intutils_are_equal8(enc, expected, msglen + QSC_CHACHAPOLY_MAC_SIZE) == false)
+	{
+		status = false;
+	}
+
+	/* decrypt and authenticate */
+	if (extended == true)
+	{
+		qsc_xchachapoly_initialize(&ctx, key, nonce, false);
+	}
+	else
+	{
+		qsc_chachapoly_initialize(&ctx, key, nonce, false);
+	}
+
+	qsc_chachapoly_set_associated(&ctx, aad, aadlen);
+
+	if (qsc_chachapoly_transform(&ctx, dec, enc, msglen) == false)
+	{
+		status = false;
+	}
+
+	if (qsc_intutils_are_equal8(dec, msg, msglen) == false)
+	{
+		status = false;
+	}
+
+	/* a modified tag must fail authentication */
+	enc[msglen] ^= 0x01U;
+
+	if (extended == true)
+	{
+		qsc_xchachapoly_initialize(&ctx, key, nonce, false);
+	}
+	else
+	{
+		qsc_chachapoly_initialize(&ctx, key, nonce, false);
+	}
+
+	qsc_chachapoly_set_associated(&ctx, aad, aadlen);
+
+	if (qsc_chachapoly_transform(&ctx, dec, enc, msglen) == true)
+	{
+		status = false;
+	}
+
+	qsc_chachapoly_dispose(&ctx);
+
+	return status;
+}
+
+bool qsctest_chachapoly_kat()
+{
+	uint8_t aad[12] = { 0 };
+	uint8_t exp[2][114 + QSC_CHACHAPOLY_MAC_SIZE] = { 0 };
+	uint8_t key[QSC_CHACHA_KEY256_SIZE] = { 0 };
+	uint8_t msg[114] = { 0 };
+	uint8_t nonce[QSC_CHACHAPOLY_NONCE_SIZE] = { 0 };
+	uint8_t xnonce[QSC_XCHACHAPOLY_NONCE_SIZE] = { 0 };
+	bool status;
+
+	status = true;
+
+	qsctest_hex_to_bin("50515253C0C1C2C3C4C5C6C7", aad, sizeof(aad));
+	qsctest_hex_to_bin("808182838485868788898A8B8C8D8E8F909192939495969798999A9B9C9D9E9F", key, sizeof(key));
+	qsctest_hex_to_bin("4C616469657320616E642047656E746C656D656E206F662074686520636C617373206F66202739393A204966204920636F756C64206F6666657220796F75206F6E6C79206F6E652074697020666F7220746865206675747572652C2073756E73637265656E20776F756C642062652069742E", msg, sizeof(msg));
+	qsctest_hex_to_bin("070000004041424344454647", nonce, sizeof(nonce));
+	qsctest_hex_to_bin("404142434445464748494A4B4C4D4E4F5051525354555657", xnonce, sizeof(xnonce));
+
+	qsctest_hex_to_bin("D31A8D34648E60DB7B86AFBC53EF7EC2A4ADED51296E08FEA9E2B5A736EE62D63DBEA45E8CA9671282FAFB69DA92728B1A71DE0A9E060B2905D6A5B67ECD3B3692DDBD7F2D778B8C9803AEE328091B58FAB324E4FAD675945585808B4831D7BC3FF4DEF08E4B7A9DE576D26586CEC64B6116"
+		"1AE10B594F09E26A7E902ECBD0600691", exp[0], sizeof(exp[0]));
+	qsctest_hex_to_bin("BD6D179D3E83D43B9576579493C0E939572A1700252BFACCBED2902C21396CBB731C7F1B0B4AA6440BF3A82F4EDA7E39AE64C6708C54C216CB96B72E1213B4522F8C9BA40DB5D945B11B69B982C1BB9E3F3FAC2BC369488F76B2383565D3FFF921F9664C97637DA9768812F615C68B13B52E"
+		"C0875924C1C7987947DEAFD8780ACF49", exp[1], sizeof(exp[1]));
+
+	if (chachapoly_kat_compare(false, key, nonce, aad, sizeof(aad), msg, sizeof(msg), exp[0]) == false)
+	{
+		qsctest_print_safe("Failure! chachapoly_kat: output does not match the expected answer -CP1 \n");
+		status = false;
+	}
+
+	if (chachapoly_kat_compare(true, key, xnonce, aad, sizeof(aad), msg, sizeof(msg), exp[1]) == false)
+	{
+		qsctest_print_safe("Failure! chachapoly_kat: output does not match the expected answer -CP2 \n");
+		status = false;
+	}
+
+	return status;
+}
+
+bool qsctest_chachapoly_stress()
+{
+	const size_t MSGMAX = 8 * CHACHA_TEST_SAMPLE;
+	uint8_t aad[20] = { 0 };
+	uint8_t key[QSC_CHACHA_KEY256_SIZE] = { 0 };
+	uint8_t nonce[QSC_CHACHAPOLY_NONCE_SIZE] = { 0 };
+	uint8_t pmcnt[sizeof(uint16_t)] = { 0 };
+	qsc_chachapoly_state ctx;
+	uint8_t* dec;
+	uint8_t* enc;
+	uint8_t* msg;
+	size_t mlen;
+	bool status;
+
+	status = true;
+	dec = (uint8_t*)qsc_memutils_malloc(MSGMAX);
+	enc = (uint8_t*)qsc_memutils_malloc(MSGMAX + QSC_CHACHAPOLY_MAC_SIZE);
+	msg = (uint8_t*)qsc_memutils_malloc(MSGMAX);
+
+	if (dec != NULL && enc != NULL && msg != NULL)
+	{
+		for (size_t i = 0; i < QSCTEST_CHACHA_TEST_CYCLES; ++i)
+		{
+			/* random message sizes up to eight avx512 segments */
+			qsc_csp_generate(pmcnt, sizeof(pmcnt));
+			mlen = (size_t)qsc_intutils_le8to16(pmcnt) % MSGMAX;
+
+			qsc_csp_generate(aad, sizeof(aad));
+			qsc_csp_generate(key, sizeof(key));
+			qsc_csp_generate(nonce, sizeof(nonce));
+			qsc_csp_generate(msg, mlen);
+
+			qsc_chachapoly_initialize(&ctx, key, nonce, true);
+			qsc_chachapoly_set_associated(&ctx, aad, sizeof(aad));
+			qsc_chachapoly_transform(&ctx, enc, msg, mlen);
+
+			qsc_chachapoly_initialize(&ctx, key, nonce, false);
+			qsc_chachapoly_set_associated(&ctx, aad, sizeof(aad));
+
+			if (qsc_chachapoly_transform(&ctx, dec, enc, mlen) == false)
+			{
+				qsctest_print_safe("Failure! chachapoly_stress: authentication failure -CS1 \n");
+				status = false;
+				break;
+			}
+
+			if (qsc_intutils_are_equal8(dec, msg, mlen) == false)
+			{
+				qsctest_print_safe("Failure! chachapoly_stress: decrypted output does not match the message -CS2 \n");
+				status = false;
+				break;
+			}
+
+			/* a modified associated data string must fail authentication */
+			aad[0] ^= 0x01U;
+			qsc_chachapoly_initialize(&ctx, key, nonce, false);
+			qsc_chachapoly_set_associated(&ctx, aad, sizeof(aad));
+
+			if (qsc_chachapoly_transform(&ctx, dec, enc, mlen) == true)
+			{
+				qsctest_print_safe("Failure! chachapoly_stress: authentication of modified data -CS3 \n");
+				status = false;
+				break;
+			}
+
+			qsc_chachapoly_dispose(&ctx);
+		}
+	}
+	else
+	{
+		status = false;
+	}
+
+	if (dec != NULL)
+	{
+		qsc_memutils_alloc_free(dec);
+	}
+
+	if (enc != NULL)
+	{
+		qsc_memutils_alloc_free(enc);
+	}
+
+	if (msg != NULL)
+	{
+		qsc_memutils_alloc_free(msg);
+	}
+
+	return status;
+}
+
+bool qsctest_chacha_parallel_equality()
+{
+	const size_t MSGLEN = (3 * 64 * 1024) + 1000;
+	const size_t SKPBLK = 1029;
+	uint8_t key[QSC_CHACHA_KEY256_SIZE] = { 0 };
+	uint8_t nonce[QSC_CHACHA_NONCE_SIZE] = { 0 };
+	uint8_t tail1[QSC_CHACHA_BLOCK_SIZE] = { 0 };
+	uint8_t tail2[QSC_CHACHA_BLOCK_SIZE] = { 0 };
+	qsc_chacha_state ctx1;
+	qsc_chacha_state ctx2;
+	uint8_t* enc1;
+	uint8_t* enc2;
+	uint8_t* msg;
+	bool status;
+
+	status = true;
+	enc1 = (uint8_t*)qsc_memutils_malloc(MSGLEN);
+	enc2 = (uint8_t*)qsc_memutils_malloc(MSGLEN);
+	msg = (uint8_t*)qsc_memutils_malloc(MSGLEN);
+
+	if (enc1 != NULL && enc2 != NULL && msg != NULL)
+	{
+		qsc_csp_generate(key, sizeof(key));
+		qsc_csp_generate(nonce, sizeof(nonce));
+		qsc_csp_generate(msg, MSGLEN);
+
+		qsc_chacha_keyparams kp = { key, sizeof(key), nonce };
+
+		/* sequential and multi-threaded transforms must be equal, and leave the counter at the same position */
+		qsc_chacha_initialize(&ctx1, &kp);
+		qsc_chacha_transform(&ctx1, enc1, msg, MSGLEN);
+		qsc_chacha_transform(&ctx1, tail1, msg, sizeof(tail1));
+
+		qsc_chacha_initialize(&ctx2, &kp);
+		qsc_chacha_parallel_transform(&ctx2, enc2, msg, MSGLEN);
+		qsc_chacha_transform(&ctx2, tail2, msg, sizeof(tail2));
+
+		if (qsc_intutils_are_equal8(enc1, enc2, MSGLEN) == false ||
+			qsc_intutils_are_equal8(tail1, tail2, sizeof(tail1)) == false)
+		{
+			qsctest_print_safe("Failure! chacha_parallel_equality: output does not match the sequential transform -CP1 \n");
+			status = false;
+		}
+
+		/* random access to the middle of the key-stream */
+		qsc_memutils_clear(enc2, MSGLEN);
+		qsc_chacha_seek(&ctx2, SKPBLK);
+		qsc_chacha_transform(&ctx2, enc2, msg + (SKPBLK * QSC_CHACHA_BLOCK_SIZE), MSGLEN - (SKPBLK * QSC_CHACHA_BLOCK_SIZE));
+
+		if (qsc_intutils_are_equal8(enc1 + (SKPBLK * QSC_CHACHA_BLOCK_SIZE), enc2, MSGLEN - (SKPBLK * QSC_CHACHA_BLOCK_SIZE)) == false)
+		{
+			qsctest_print_safe("Failure! chacha_parallel_equality: seek output does not match the key-stream -CP2 \n");
+			status = false;
+		}
+
+		qsc_chacha_dispose(&ctx1);
+		qsc_chacha_dispose(&ctx2);
+	}
+	else
+	{
+		status = false;
+	}
+
+	if (enc1 != NULL)
+	{
+		qsc_memutils_alloc_free(enc1);
+	}
+
+	if (enc2 != NULL)
+	{
+		qsc_memutils_alloc_free(enc2);
+	}
+
+	if (msg != NULL)
+	{
+		qsc_memutils_alloc_free(msg);
+	}
+
+	return status;
+}
+
 #if defined(QSCTEST_CHACHA_WIDE_BLOCK_TESTS)
 bool qsctest_chacha128_wide_equality()
 {
@@ -283,6 +566,33 @@ void qsctest_chacha_run()
 		qsctest_print_safe("Failure! Failed the ChaCha 256-bit key known answer test. \n");
 	}
 
+	if (qsctest_chachapoly_kat() == true)
+	{
+		qsctest_print_safe("Success! Passed the ChaCha20-Poly1305 AEAD known answer tests. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the ChaCha20-Poly1305 AEAD known answer tests. \n");
+	}
+
+	if (qsctest_chachapoly_stress() == true)
+	{
+		qsctest_print_safe("Success! Passed the ChaCha20-Poly1305 AEAD stress test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the ChaCha20-Poly1305 AEAD stress test. \n");
+	}
+
+	if (qsctest_chacha_parallel_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the ChaCha parallel transform and seek equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the ChaCha parallel transform and seek equality test. \n");
+	}
+
 #if defined(QSCTEST_CHACHA_WIDE_BLOCK_TESTS)
 	if (qsctest_chacha128_wide_equality() == true)
 	{
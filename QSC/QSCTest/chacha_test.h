@@ -38,6 +38,33 @@ bool qsctest_chacha128_kat(void);
 */
 bool qsctest_chacha256_kat(void);
 
+/**
+* \brief Tests the ChaCha20-Poly1305 and XChaCha20-Poly1305 AEAD implementations
+* for encryption, decryption, and authentication failure.
+*
+* \return Returns true for success
+*
+* \remarks <b>Test References:</b> \n
+* RFC8439: <a href="https://tools.ietf.org/html/rfc8439">ChaCha20 and Poly1305 for IETF Protocols</a> \n
+* XChaCha: <a href="https://datatracker.ietf.org/doc/html/draft-irtf-cfrg-xchacha">XChaCha: eXtended-nonce ChaCha and AEAD_XChaCha20_Poly1305</a>
+*/
+bool qsctest_chachapoly_kat(void);
+
+/**
+* \brief Tests the ChaCha20-Poly1305 AEAD with random message sizes that span several key-stream segments,
+* checking the decrypted output and the rejection of a modified cipher-text.
+*
+* \return Returns true for success
+*/
+bool qsctest_chachapoly_stress(void);
+
+/**
+* \brief Tests the multi-threaded ChaCha transform and the seek function for equivalence with the sequential transform.
+*
+* \return Returns true for success
+*/
+bool qsctest_chacha_parallel_equality(void);
+
 
 #if defined(QSCTEST_CHACHA_WIDE_BLOCK_TESTS)
 
@@ -250,6 +250,272 @@ bool qsctest_csx512_stress()
 	return status;
 }
 
+bool qsctest_csx_stream_equality()
+{
+	const size_t MSGMAX = 4096;
+	const size_t STRIDE = MSGMAX + QSC_CSX_MAC_SIZE;
+	uint8_t aad[20] = { 0 };
+	uint8_t keys[QSCTEST_CSX_STREAM_COUNT][QSC_CSX_KEY_SIZE] = { 0 };
+	uint8_t nonces[QSCTEST_CSX_STREAM_COUNT][QSC_CSX_NONCE_SIZE] = { 0 };
+	uint8_t ncopy[QSC_CSX_NONCE_SIZE] = { 0 };
+	uint8_t pmcnt[sizeof(uint16_t)] = { 0 };
+	qsc_csx_stream streams[QSCTEST_CSX_STREAM_COUNT];
+	qsc_csx_state* states;
+	uint8_t* dec;
+	uint8_t* enc;
+	uint8_t* exp;
+	uint8_t* msg;
+	size_t mlen[QSCTEST_CSX_STREAM_COUNT] = { 0 };
+	size_t i;
+	bool status;
+
+	status = true;
+	dec = (uint8_t*)qsc_memutils_malloc(QSCTEST_CSX_STREAM_COUNT * STRIDE);
+	enc = (uint8_t*)qsc_memutils_malloc(QSCTEST_CSX_STREAM_COUNT * STRIDE);
+	exp = (uint8_t*)qsc_memutils_malloc(QSCTEST_CSX_STREAM_COUNT * STRIDE);
+	msg = (uint8_t*)qsc_memutils_malloc(QSCTEST_CSX_STREAM_COUNT * STRIDE);
+	states = (qsc_csx_state*)qsc_memutils_malloc(QSCTEST_CSX_STREAM_COUNT * sizeof(qsc_csx_state));
+
+	if (dec != NULL && enc != NULL && exp != NULL && msg != NULL && states != NULL)
+	{
+		qsc_memutils_clear(dec, QSCTEST_CSX_STREAM_COUNT * STRIDE);
+		qsc_memutils_clear(enc, QSCTEST_CSX_STREAM_COUNT * STRIDE);
+		qsc_memutils_clear(exp, QSCTEST_CSX_STREAM_COUNT * STRIDE);
+		qsc_csp_generate(msg, QSCTEST_CSX_STREAM_COUNT * STRIDE);
+		qsc_csp_generate(aad, sizeof(aad));
+
+		/* random keys, nonces, and message sizes 0-4095; one empty and one full-size message */
+		for (i = 0; i < QSCTEST_CSX_STREAM_COUNT; ++i)
+		{
+			qsc_csp_generate(keys[i], QSC_CSX_KEY_SIZE);
+			qsc_csp_generate(nonces[i], QSC_CSX_NONCE_SIZE);
+			qsc_csp_generate(pmcnt, sizeof(pmcnt));
+			mlen[i] = (size_t)qsc_intutils_le8to16(pmcnt) % MSGMAX;
+		}
+
+		mlen[0] = 0;
+		mlen[1] = MSGMAX;
+
+		/* encrypt each message with the sequential transform */
+		for (i = 0; i < QSCTEST_CSX_STREAM_COUNT; ++i)
+		{
+			qsc_memutils_copy(ncopy, nonces[i], QSC_CSX_NONCE_SIZE);
+			qsc_csx_keyparams kp = { keys[i], QSC_CSX_KEY_SIZE, ncopy, NULL, 0 };
+			qsc_csx_initialize(&states[i], &kp, true);
+#if defined(QSC_CSX_AUTHENTICATED)
+			qsc_csx_set_associated(&states[i], aad, sizeof(aad));
+#endif
+			qsc_csx_transform(&states[i], exp + (i * STRIDE), msg + (i * STRIDE), mlen[i]);
+			qsc_csx_dispose(&states[i]);
+		}
+
+		/* encrypt the set with the multi-stream transform */
+		for (i = 0; i < QSCTEST_CSX_STREAM_COUNT; ++i)
+		{
+			qsc_memutils_copy(ncopy, nonces[i], QSC_CSX_NONCE_SIZE);
+			qsc_csx_keyparams kp = { keys[i], QSC_CSX_KEY_SIZE, ncopy, NULL, 0 };
+			qsc_csx_initialize(&states[i], &kp, true);
+#if defined(QSC_CSX_AUTHENTICATED)
+			qsc_csx_set_associated(&states[i], aad, sizeof(aad));
+#endif
+			streams[i].ctx = &states[i];
+			streams[i].output = enc + (i * STRIDE);
+			streams[i].input = msg + (i * STRIDE);
+			streams[i].length = mlen[i];
+		}
+
+		if (qsc_csx_transform_streams(streams, QSCTEST_CSX_STREAM_COUNT) == false)
+		{
+			qsctest_print_safe("Failure! csx_stream_equality: encryption failure -CM1 \n");
+			status = false;
+		}
+
+		if (qsc_intutils_are_equal8(enc, exp, QSCTEST_CSX_STREAM_COUNT * STRIDE) == false)
+		{
+			qsctest_print_safe("Failure! csx_stream_equality: output does not match the sequential transform -CM2 \n");
+			status = false;
+		}
+
+		/* decrypt the set, with a tampered cipher-text in the last stream */
+#if defined(QSC_CSX_AUTHENTICATED)
+		enc[((QSCTEST_CSX_STREAM_COUNT - 1) * STRIDE)] ^= 0x01U;
+#endif
+
+		for (i = 0; i < QSCTEST_CSX_STREAM_COUNT; ++i)
+		{
+			qsc_csx_dispose(&states[i]);
+			qsc_memutils_copy(ncopy, nonces[i], QSC_CSX_NONCE_SIZE);
+			qsc_csx_keyparams kp = { keys[i], QSC_CSX_KEY_SIZE, ncopy, NULL, 0 };
+			qsc_csx_initialize(&states[i], &kp, false);
+#if defined(QSC_CSX_AUTHENTICATED)
+			qsc_csx_set_associated(&states[i], aad, sizeof(aad));
+#endif
+			streams[i].ctx = &states[i];
+			streams[i].output = dec + (i * STRIDE);
+			streams[i].input = enc + (i * STRIDE);
+			streams[i].length = mlen[i];
+		}
+
+		qsc_csx_transform_streams(streams, QSCTEST_CSX_STREAM_COUNT);
+
+		for (i = 0; i < QSCTEST_CSX_STREAM_COUNT - 1; ++i)
+		{
+			if (streams[i].result == false || qsc_intutils_are_equal8(dec + (i * STRIDE), msg + (i * STRIDE), mlen[i]) == false)
+			{
+				qsctest_print_safe("Failure! csx_stream_equality: decryption failure -CM3 \n");
+				status = false;
+				break;
+			}
+		}
+
+#if defined(QSC_CSX_AUTHENTICATED)
+		if (streams[QSCTEST_CSX_STREAM_COUNT - 1].result == true)
+		{
+			qsctest_print_safe("Failure! csx_stream_equality: tampered stream was authenticated -CM4 \n");
+			status = false;
+		}
+#endif
+
+		for (i = 0; i < QSCTEST_CSX_STREAM_COUNT; ++i)
+		{
+			qsc_csx_dispose(&states[i]);
+		}
+	}
+	else
+	{
+		status = false;
+	}
+
+	if (dec != NULL)
+	{
+		qsc_memutils_alloc_free(dec);
+	}
+
+	if (enc != NULL)
+	{
+		qsc_memutils_alloc_free(enc);
+	}
+
+	if (exp != NULL)
+	{
+		qsc_memutils_alloc_free(exp);
+	}
+
+	if (msg != NULL)
+	{
+		qsc_memutils_alloc_free(msg);
+	}
+
+	if (states != NULL)
+	{
+		qsc_memutils_alloc_free(states);
+	}
+
+	return status;
+}
+
+bool qsctest_csx_parallel_equality()
+{
+	const size_t MSGLEN = (3 * 64 * 1024) + 1000;
+	const size_t SKPBLK = 517;
+	uint8_t key[QSC_CSX_KEY_SIZE] = { 0 };
+	uint8_t nonce[QSC_CSX_NONCE_SIZE] = { 0 };
+	uint8_t ncopy[QSC_CSX_NONCE_SIZE] = { 0 };
+	qsc_csx_state ctx1;
+	qsc_csx_state ctx2;
+	uint8_t* dec;
+	uint8_t* enc1;
+	uint8_t* enc2;
+	uint8_t* msg;
+	bool status;
+
+	status = true;
+	dec = (uint8_t*)qsc_memutils_malloc(MSGLEN);
+	enc1 = (uint8_t*)qsc_memutils_malloc(MSGLEN + QSC_CSX_MAC_SIZE);
+	enc2 = (uint8_t*)qsc_memutils_malloc(MSGLEN + QSC_CSX_MAC_SIZE);
+	msg = (uint8_t*)qsc_memutils_malloc(MSGLEN);
+
+	if (dec != NULL && enc1 != NULL && enc2 != NULL && msg != NULL)
+	{
+		qsc_memutils_clear(enc1, MSGLEN + QSC_CSX_MAC_SIZE);
+		qsc_memutils_clear(enc2, MSGLEN + QSC_CSX_MAC_SIZE);
+		qsc_csp_generate(key, sizeof(key));
+		qsc_csp_generate(nonce, sizeof(nonce));
+		qsc_csp_generate(msg, MSGLEN);
+
+		/* sequential and multi-threaded transforms must produce the same cipher-text and mac */
+		qsc_memutils_copy(ncopy, nonce, sizeof(ncopy));
+		qsc_csx_keyparams kp1 = { key, sizeof(key), ncopy, NULL, 0 };
+		qsc_csx_initialize(&ctx1, &kp1, true);
+		qsc_csx_transform(&ctx1, enc1, msg, MSGLEN);
+
+		qsc_memutils_copy(ncopy, nonce, sizeof(ncopy));
+		qsc_csx_keyparams kp2 = { key, sizeof(key), ncopy, NULL, 0 };
+		qsc_csx_initialize(&ctx2, &kp2, true);
+		qsc_csx_parallel_transform(&ctx2, enc2, msg, MSGLEN);
+
+		if (qsc_intutils_are_equal8(enc1, enc2, MSGLEN + QSC_CSX_MAC_SIZE) == false ||
+			qsc_intutils_are_equal8((const uint8_t*)ctx1.state, (const uint8_t*)ctx2.state, sizeof(ctx1.state)) == false)
+		{
+			qsctest_print_safe("Failure! csx_parallel_equality: output does not match the sequential transform -CP1 \n");
+			status = false;
+		}
+
+		/* random access to the middle of the key-stream */
+		qsc_csx_seek(&ctx2, SKPBLK);
+		qsc_csx_transform(&ctx2, enc2, msg + (SKPBLK * QSC_CSX_BLOCK_SIZE), MSGLEN - (SKPBLK * QSC_CSX_BLOCK_SIZE));
+
+		if (qsc_intutils_are_equal8(enc1 + (SKPBLK * QSC_CSX_BLOCK_SIZE), enc2, MSGLEN - (SKPBLK * QSC_CSX_BLOCK_SIZE)) == false)
+		{
+			qsctest_print_safe("Failure! csx_parallel_equality: seek output does not match the key-stream -CP2 \n");
+			status = false;
+		}
+
+		qsc_csx_dispose(&ctx1);
+		qsc_csx_dispose(&ctx2);
+
+		/* authenticate and decrypt with the multi-threaded transform */
+		qsc_memutils_copy(ncopy, nonce, sizeof(ncopy));
+		qsc_csx_keyparams kp3 = { key, sizeof(key), ncopy, NULL, 0 };
+		qsc_csx_initialize(&ctx1, &kp3, false);
+
+		if (qsc_csx_parallel_transform(&ctx1, dec, enc1, MSGLEN) == false ||
+			qsc_intutils_are_equal8(dec, msg, MSGLEN) == false)
+		{
+			qsctest_print_safe("Failure! csx_parallel_equality: decryption failure -CP3 \n");
+			status = false;
+		}
+
+		qsc_csx_dispose(&ctx1);
+	}
+	else
+	{
+		status = false;
+	}
+
+	if (dec != NULL)
+	{
+		qsc_memutils_alloc_free(dec);
+	}
+
+	if (enc1 != NULL)
+	{
+		qsc_memutils_alloc_free(enc1);
+	}
+
+	if (enc2 != NULL)
+	{
+		qsc_memutils_alloc_free(enc2);
+	}
+
+	if (msg != NULL)
+	{
+		qsc_memutils_alloc_free(msg);
+	}
+
+	return status;
+}
+
 #if defined(QSCTEST_CSX_WIDE_BLOCK_TESTS)
 bool qsctest_csx_wide_equality()
 {
@@ -386,6 +652,24 @@ void qsctest_csx_run()
 		qsctest_print_safe("Failure! Failed the CSX stress tests. \n");
 	}
 
+	if (qsctest_csx_stream_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the CSX multi-stream equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the CSX multi-stream equality test. \n");
+	}
+
+	if (qsctest_csx_parallel_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the CSX parallel transform and seek equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the CSX parallel transform and seek equality test. \n");
+	}
+
 #if defined(QSCTEST_CSX_WIDE_BLOCK_TESTS)
 	if (qsctest_csx_wide_equality() == true)
 	{
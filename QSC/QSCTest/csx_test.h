@@ -15,6 +15,7 @@
 #include "../QSC/csx.h"
 
 #define QSCTEST_CSX_TEST_CYCLES 100
+#define QSCTEST_CSX_STREAM_COUNT 19
 
 #if defined(QSC_SYSTEM_AVX_INTRINSICS)
 #if !defined(QSC_CSX_AUTHENTICATED)
@@ -41,6 +42,21 @@ bool qsctest_csx512_kat(void);
 */
 bool qsctest_csx512_stress(void);
 
+/**
+* \brief Tests the CSX multi-stream transform for equal output to the sequential transform,
+* using streams with independent keys and random message sizes.
+*
+* \return Returns true for success
+*/
+bool qsctest_csx_stream_equality(void);
+
+/**
+* \brief Tests the multi-threaded CSX transform and the seek function for equivalence with the sequential transform.
+*
+* \return Returns true for success
+*/
+bool qsctest_csx_parallel_equality(void);
+
 #if defined(QSCTEST_CSX_WIDE_BLOCK_TESTS)
 /**
 * \brief Tests the CSX AVX functions for equal output to sequential processing.
@@ -3,7 +3,10 @@
 #include "katparser.h"
 #include "nistrng.h"
 #include "testutils.h"
+#include "../QSC/csp.h"
 #include "../QSC/dilithium.h"
+#include "../QSC/dilithiumbase.h"
+#include "../QSC/dilithiumbase_avx2.h"
 #include "../QSC/intutils.h"
 
 bool qsctest_dilithium_kat_test()
@@ -269,6 +272,302 @@ bool qsctest_dilithium_stress_test()
 	return ret;
 }
 
+#if defined(QSC_SYSTEM_HAS_AVX2)
+bool qsctest_dilithium_avx2_equality()
+{
+	uint8_t msg[QSCTEST_DILITHIUM_MLEN] = { 0 };
+	uint8_t pk1[QSC_DILITHIUM_PUBLICKEY_SIZE] = { 0 };
+	uint8_t pk2[QSC_DILITHIUM_PUBLICKEY_SIZE] = { 0 };
+	uint8_t seed[QSCTEST_NIST_RNG_SEED_SIZE] = { 0 };
+	uint8_t sig1[QSC_DILITHIUM_SIGNATURE_SIZE] = { 0 };
+	uint8_t sig2[QSC_DILITHIUM_SIGNATURE_SIZE] = { 0 };
+	uint8_t sk1[QSC_DILITHIUM_PRIVATEKEY_SIZE] = { 0 };
+	uint8_t sk2[QSC_DILITHIUM_PRIVATEKEY_SIZE] = { 0 };
+	size_t siglen1;
+	size_t siglen2;
+	bool ret;
+
+	ret = true;
+
+	for (size_t i = 0; i < QSCTEST_DILITHIUM_EQUALITY_CYCLES; ++i)
+	{
+		qsc_csp_generate(seed, sizeof(seed));
+		qsc_csp_generate(msg, sizeof(msg));
+
+		/* the reference implementation */
+		qsctest_nistrng_prng_initialize(seed, NULL, 0);
+		qsc_dilithium_ref_generate_keypair(pk1, sk1, qsctest_nistrng_prng_generate);
+		qsc_dilithium_ref_sign_signature(sig1, &siglen1, msg, sizeof(msg), sk1, qsctest_nistrng_prng_generate);
+
+		/* the AVX2 implementation */
+		qsctest_nistrng_prng_initialize(seed, NULL, 0);
+		qsc_dilithium_avx2_generate_keypair(pk2, sk2, qsctest_nistrng_prng_generate);
+		qsc_dilithium_avx2_sign_signature(sig2, &siglen2, msg, sizeof(msg), sk2, qsctest_nistrng_prng_generate);
+
+		if (qsc_intutils_are_equal8(pk1, pk2, sizeof(pk1)) != true || qsc_intutils_are_equal8(sk1, sk2, sizeof(sk1)) != true)
+		{
+			qsctest_print_safe("Failure! dilithium avx2 equality: the key-pairs are not equal -DAE1 \n");
+			ret = false;
+			break;
+		}
+
+		if (siglen1 != siglen2 || qsc_intutils_are_equal8(sig1, sig2, sizeof(sig1)) != true)
+		{
+			qsctest_print_safe("Failure! dilithium avx2 equality: the signatures are not equal -DAE2 \n");
+			ret = false;
+			break;
+		}
+
+		if (qsc_dilithium_ref_verify(sig2, siglen2, msg, sizeof(msg), pk2) != true ||
+			qsc_dilithium_avx2_verify(sig1, siglen1, msg, sizeof(msg), pk1) != true)
+		{
+			qsctest_print_safe("Failure! dilithium avx2 equality: signature verification failure -DAE3 \n");
+			ret = false;
+			break;
+		}
+	}
+
+	return ret;
+}
+#endif
+
+bool qsctest_dilithium_expanded_equality()
+{
+	uint8_t msg[QSCTEST_DILITHIUM_MLEN] = { 0 };
+	uint8_t pk[QSC_DILITHIUM_PUBLICKEY_SIZE] = { 0 };
+	uint8_t rmsg[QSCTEST_DILITHIUM_MLEN] = { 0 };
+	uint8_t seed[QSCTEST_NIST_RNG_SEED_SIZE] = { 0 };
+	uint8_t sk[QSC_DILITHIUM_PRIVATEKEY_SIZE] = { 0 };
+	uint8_t smsg1[QSC_DILITHIUM_SIGNATURE_SIZE + QSCTEST_DILITHIUM_MLEN] = { 0 };
+	uint8_t smsg2[QSC_DILITHIUM_SIGNATURE_SIZE + QSCTEST_DILITHIUM_MLEN] = { 0 };
+	qsc_dilithium_expanded_publickey epk;
+	qsc_dilithium_expanded_privatekey esk;
+	size_t rmsglen;
+	size_t smsglen1;
+	size_t smsglen2;
+	bool ret;
+
+	ret = true;
+	qsc_csp_generate(seed, sizeof(seed));
+	qsctest_nistrng_prng_initialize(seed, NULL, 0);
+	qsc_dilithium_generate_keypair(pk, sk, qsctest_nistrng_prng_generate);
+	qsc_dilithium_expand_publickey(&epk, pk);
+	qsc_dilithium_expand_privatekey(&esk, sk);
+
+	for (size_t i = 0; i < QSCTEST_DILITHIUM_EQUALITY_CYCLES; ++i)
+	{
+		qsc_csp_generate(seed, sizeof(seed));
+		qsc_csp_generate(msg, sizeof(msg));
+
+		/* the packed and expanded private keys must produce the same signature */
+		qsctest_nistrng_prng_initialize(seed, NULL, 0);
+		qsc_dilithium_sign(smsg1, &smsglen1, msg, sizeof(msg), sk, qsctest_nistrng_prng_generate);
+		qsctest_nistrng_prng_initialize(seed, NULL, 0);
+		qsc_dilithium_sign_expanded(smsg2, &smsglen2, msg, sizeof(msg), &esk, qsctest_nistrng_prng_generate);
+
+		if (smsglen1 != smsglen2 || qsc_intutils_are_equal8(smsg1, smsg2, sizeof(smsg1)) != true)
+		{
+			qsctest_print_safe("Failure! dilithium expanded equality: the signatures are not equal -DXE1 \n");
+			ret = false;
+			break;
+		}
+
+		if (qsc_dilithium_verify_expanded(rmsg, &rmsglen, smsg2, smsglen2, &epk) != true ||
+			rmsglen != sizeof(msg) || qsc_intutils_are_equal8(msg, rmsg, sizeof(msg)) != true)
+		{
+			qsctest_print_safe("Failure! dilithium expanded equality: signature verification failure -DXE2 \n");
+			ret = false;
+			break;
+		}
+
+		/* a mutated signature must be rejected by both forms of the public key */
+		smsg1[i % QSC_DILITHIUM_SIGNATURE_SIZE] ^= 1U;
+
+		if (qsc_dilithium_verify_expanded(rmsg, &rmsglen, smsg1, smsglen1, &epk) == true ||
+			qsc_dilithium_verify(rmsg, &rmsglen, smsg1, smsglen1, pk) == true)
+		{
+			qsctest_print_safe("Failure! dilithium expanded equality: verified a mutated signature -DXE3 \n");
+			ret = false;
+			break;
+		}
+	}
+
+	qsc_dilithium_expanded_privatekey_dispose(&esk);
+
+	return ret;
+}
+
+bool qsctest_dilithium_detached_test()
+{
+	uint8_t dsig[QSC_DILITHIUM_SIGNATURE_SIZE] = { 0 };
+	uint8_t msg[QSCTEST_DILITHIUM_MLEN] = { 0 };
+	uint8_t pk[QSC_DILITHIUM_PUBLICKEY_SIZE] = { 0 };
+	uint8_t seed[QSCTEST_NIST_RNG_SEED_SIZE] = { 0 };
+	uint8_t sk[QSC_DILITHIUM_PRIVATEKEY_SIZE] = { 0 };
+	uint8_t smsg[QSC_DILITHIUM_SIGNATURE_SIZE + QSCTEST_DILITHIUM_MLEN] = { 0 };
+	size_t dlen;
+	size_t smsglen;
+	bool ret;
+
+	ret = true;
+	dlen = 0;
+	smsglen = 0;
+	qsc_csp_generate(seed, sizeof(seed));
+	qsc_csp_generate(msg, sizeof(msg));
+	qsctest_nistrng_prng_initialize(seed, NULL, 0);
+	qsc_dilithium_generate_keypair(pk, sk, qsctest_nistrng_prng_generate);
+
+	/* the detached signature must equal the signature prefix of the signed message */
+	qsctest_nistrng_prng_initialize(seed, NULL, 0);
+	qsc_dilithium_sign(smsg, &smsglen, msg, sizeof(msg), sk, qsctest_nistrng_prng_generate);
+	qsctest_nistrng_prng_initialize(seed, NULL, 0);
+	qsc_dilithium_sign_detached(dsig, &dlen, msg, sizeof(msg), sk, qsctest_nistrng_prng_generate);
+
+	if (dlen != QSC_DILITHIUM_SIGNATURE_SIZE || smsglen != dlen + sizeof(msg) || qsc_intutils_are_equal8(dsig, smsg, dlen) != true)
+	{
+		qsctest_print_safe("Failure! dilithium detached: signature does not match the signed message -DDT1 \n");
+		ret = false;
+	}
+
+	if (qsc_dilithium_verify_detached(dsig, dlen, msg, sizeof(msg), pk) != true)
+	{
+		qsctest_print_safe("Failure! dilithium detached: signature verification has failed -DDT2 \n");
+		ret = false;
+	}
+
+	/* flip 1 bit in the message */
+	msg[0] ^= 1U;
+
+	if (qsc_dilithium_verify_detached(dsig, dlen, msg, sizeof(msg), pk) == true)
+	{
+		qsctest_print_safe("Failure! dilithium detached: altered message passed verification -DDT3 \n");
+		ret = false;
+	}
+
+	/* flip 1 bit in the signature */
+	msg[0] ^= 1U;
+	dsig[0] ^= 1U;
+
+	if (qsc_dilithium_verify_detached(dsig, dlen, msg, sizeof(msg), pk) == true)
+	{
+		qsctest_print_safe("Failure! dilithium detached: altered signature passed verification -DDT4 \n");
+		ret = false;
+	}
+
+	return ret;
+}
+
+bool qsctest_dilithium_stream_test()
+{
+	uint8_t dsig[QSC_DILITHIUM_SIGNATURE_SIZE] = { 0 };
+	uint8_t msg[QSCTEST_DILITHIUM_STREAM_MLEN] = { 0 };
+	uint8_t pk[QSC_DILITHIUM_PUBLICKEY_SIZE] = { 0 };
+	uint8_t seed[QSCTEST_NIST_RNG_SEED_SIZE] = { 0 };
+	uint8_t sig[QSC_DILITHIUM_SIGNATURE_SIZE] = { 0 };
+	uint8_t sk[QSC_DILITHIUM_PRIVATEKEY_SIZE] = { 0 };
+	qsc_dilithium_stream_state state;
+	size_t dlen;
+	size_t pos;
+	size_t siglen;
+	bool ret;
+
+	ret = true;
+	dlen = 0;
+	siglen = 0;
+	qsc_csp_generate(seed, sizeof(seed));
+	qsc_csp_generate(msg, sizeof(msg));
+	qsctest_nistrng_prng_initialize(seed, NULL, 0);
+	qsc_dilithium_generate_keypair(pk, sk, qsctest_nistrng_prng_generate);
+
+	/* sign the message in uneven blocks; the signature must equal the one-shot signature */
+	qsctest_nistrng_prng_initialize(seed, NULL, 0);
+	qsc_dilithium_sign_detached(dsig, &dlen, msg, sizeof(msg), sk, qsctest_nistrng_prng_generate);
+	qsctest_nistrng_prng_initialize(seed, NULL, 0);
+	qsc_dilithium_sign_initialize(&state, sk);
+
+	for (pos = 0; pos < sizeof(msg); pos += 1 + (pos % 300))
+	{
+		qsc_dilithium_sign_update(&state, msg + pos, qsc_intutils_min(1 + (pos % 300), sizeof(msg) - pos));
+	}
+
+	qsc_dilithium_sign_finalize(&state, sig, &siglen, sk, qsctest_nistrng_prng_generate);
+
+	if (siglen != dlen || qsc_intutils_are_equal8(sig, dsig, dlen) != true)
+	{
+		qsctest_print_safe("Failure! dilithium stream: signature does not match the one-shot signature -DSM1 \n");
+		ret = false;
+	}
+
+	qsc_dilithium_verify_initialize(&state, pk);
+	qsc_dilithium_verify_update(&state, msg, 1);
+	qsc_dilithium_verify_update(&state, msg + 1, sizeof(msg) - 1);
+
+	if (qsc_dilithium_verify_finalize(&state, sig, siglen, pk) != true)
+	{
+		qsctest_print_safe("Failure! dilithium stream: signature verification has failed -DSM2 \n");
+		ret = false;
+	}
+
+	/* drop the last message byte */
+	qsc_dilithium_verify_initialize(&state, pk);
+	qsc_dilithium_verify_update(&state, msg, sizeof(msg) - 1);
+
+	if (qsc_dilithium_verify_finalize(&state, sig, siglen, pk) == true)
+	{
+		qsctest_print_safe("Failure! dilithium stream: truncated message passed verification -DSM3 \n");
+		ret = false;
+	}
+
+	return ret;
+}
+
+bool qsctest_dilithium_parallel_test()
+{
+	uint8_t msg[QSCTEST_DILITHIUM_MLEN] = { 0 };
+	uint8_t pk[QSC_DILITHIUM_PUBLICKEY_SIZE] = { 0 };
+	uint8_t psig[QSC_DILITHIUM_SIGNATURE_SIZE] = { 0 };
+	uint8_t seed[QSCTEST_NIST_RNG_SEED_SIZE] = { 0 };
+	uint8_t sig[QSC_DILITHIUM_SIGNATURE_SIZE] = { 0 };
+	uint8_t sk[QSC_DILITHIUM_PRIVATEKEY_SIZE] = { 0 };
+	size_t plen;
+	size_t siglen;
+	bool ret;
+
+	ret = true;
+	qsc_csp_generate(seed, sizeof(seed));
+	qsctest_nistrng_prng_initialize(seed, NULL, 0);
+	qsc_dilithium_generate_keypair(pk, sk, qsctest_nistrng_prng_generate);
+
+	/* several messages, so that some signatures need more than one round of parallel iterations */
+	for (size_t i = 0; i < QSCTEST_DILITHIUM_EQUALITY_CYCLES; ++i)
+	{
+		plen = 0;
+		siglen = 0;
+		qsc_csp_generate(msg, sizeof(msg));
+
+		qsctest_nistrng_prng_initialize(seed, NULL, 0);
+		qsc_dilithium_sign_detached(sig, &siglen, msg, sizeof(msg), sk, qsctest_nistrng_prng_generate);
+		qsctest_nistrng_prng_initialize(seed, NULL, 0);
+		qsc_dilithium_sign_detached_parallel(psig, &plen, msg, sizeof(msg), sk, qsctest_nistrng_prng_generate);
+
+		if (plen != siglen || qsc_intutils_are_equal8(psig, sig, siglen) != true)
+		{
+			qsctest_print_safe("Failure! dilithium parallel: signature does not match the sequential signature -DPS1 \n");
+			ret = false;
+			break;
+		}
+
+		if (qsc_dilithium_verify_detached(psig, plen, msg, sizeof(msg), pk) != true)
+		{
+			qsctest_print_safe("Failure! dilithium parallel: signature verification has failed -DPS2 \n");
+			ret = false;
+			break;
+		}
+	}
+
+	return ret;
+}
+
 void qsctest_dilithium_run()
 {
 	if (qsctest_dilithium_kat_test() == true)
@@ -315,4 +614,51 @@ void qsctest_dilithium_run()
 	{
 		qsctest_print_safe("Failure! Failed the Dilithium altered signature test has failed. \n");
 	}
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+	if (qsctest_dilithium_avx2_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the Dilithium AVX2 and reference implementation equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the Dilithium AVX2 and reference implementation equality test. \n");
+	}
+#endif
+
+	if (qsctest_dilithium_expanded_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the Dilithium expanded key equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the Dilithium expanded key equality test. \n");
+	}
+
+	if (qsctest_dilithium_detached_test() == true)
+	{
+		qsctest_print_safe("Success! Passed the Dilithium detached signature test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the Dilithium detached signature test. \n");
+	}
+
+	if (qsctest_dilithium_stream_test() == true)
+	{
+		qsctest_print_safe("Success! Passed the Dilithium streaming signature test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the Dilithium streaming signature test. \n");
+	}
+
+	if (qsctest_dilithium_parallel_test() == true)
+	{
+		qsctest_print_safe("Success! Passed the Dilithium parallel signing test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the Dilithium parallel signing test. \n");
+	}
 }
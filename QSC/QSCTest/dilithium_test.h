@@ -12,8 +12,11 @@
 #define QSCTEST_DILITHIUM_TEST_H
 
 #include "common.h"
+#include "../QSC/common.h"
 
+#define QSCTEST_DILITHIUM_EQUALITY_CYCLES 10
 #define QSCTEST_DILITHIUM_MLEN 33
+#define QSCTEST_DILITHIUM_STREAM_MLEN 4096
 
 /**
 * \brief Test the public and private keys, cipher-text and shared key
@@ -47,6 +50,40 @@ bool qsctest_dilithium_signature_integrity(void);
 */
 bool qsctest_dilithium_stress_test(void);
 
+#if defined(QSC_SYSTEM_HAS_AVX2)
+/**
+* \brief Test the AVX2 implementation against the reference implementation;
+* the keys and signatures generated from the same random seed must be identical
+* \return Returns true for test success
+*/
+bool qsctest_dilithium_avx2_equality(void);
+#endif
+
+/**
+* \brief Test the expanded key functions against the packed key functions;
+* signing with the expanded private key must produce identical signatures
+* \return Returns true for test success
+*/
+bool qsctest_dilithium_expanded_equality(void);
+
+/**
+* \brief Test detached signing and verification against the signed-message format
+* \return Returns true for test success
+*/
+bool qsctest_dilithium_detached_test(void);
+
+/**
+* \brief Test streaming signing and verification against the one-shot detached functions
+* \return Returns true for test success
+*/
+bool qsctest_dilithium_stream_test(void);
+
+/**
+* \brief Test that parallel signing returns the same signatures as sequential signing
+* \return Returns true for test success
+*/
+bool qsctest_dilithium_parallel_test(void);
+
 /**
 * \brief Run the Dilithium implementation stress and correctness tests tests
 */
@@ -356,6 +356,153 @@ bool qsctest_ecdsa_stress_test()
 	return ret;
 }
 
+bool qsctest_ecdsa_detached_test()
+{
+	uint8_t dsig[QSC_ECDSA_SIGNATURE_SIZE] = { 0 };
+	uint8_t msg[QSCTEST_ECDSA_MSG0_SIZE] = { 0 };
+	uint8_t seed[QSCTEST_NIST_RNG_SEED_SIZE] = { 0 };
+	uint8_t sig[QSC_ECDSA_SIGNATURE_SIZE + QSCTEST_ECDSA_MSG0_SIZE] = { 0 };
+	uint8_t sk[QSC_ECDSA_PRIVATEKEY_SIZE] = { 0 };
+	uint8_t pk[QSC_ECDSA_PUBLICKEY_SIZE] = { 0 };
+	size_t dlen;
+	size_t siglen;
+	bool ret;
+
+	ret = true;
+	dlen = 0;
+	siglen = 0;
+	qsctest_hex_to_bin("061550234D158C5EC95595FE04EF7A25767F2E24CC2BC479D09D86DC9ABCFDE7056A8C266F9EF97ED08541DBD2E1FFA1", seed, sizeof(seed));
+	qsctest_nistrng_prng_initialize(seed, NULL, 0);
+	qsc_ecdsa_generate_keypair(pk, sk, qsctest_nistrng_prng_generate);
+	qsctest_nistrng_prng_generate(msg, sizeof(msg));
+
+	/* the detached signature must equal the signature prefix of the signed message */
+	qsc_ecdsa_sign(sig, &siglen, msg, sizeof(msg), sk);
+	qsc_ecdsa_sign_detached(dsig, &dlen, msg, sizeof(msg), sk);
+
+	if (dlen != QSC_ECDSA_SIGNATURE_SIZE || siglen != dlen + sizeof(msg) || qsc_intutils_are_equal8(dsig, sig, dlen) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_ecdsa_detached_test: ECDSA detached signature does not match the signed message -ED1 \n");
+		ret = false;
+	}
+
+	if (qsc_ecdsa_verify_detached(dsig, dlen, msg, sizeof(msg), pk) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_ecdsa_detached_test: ECDSA detached signature verification has failed -ED2 \n");
+		ret = false;
+	}
+
+	/* flip 1 bit in the message */
+	msg[0] ^= 1U;
+
+	if (qsc_ecdsa_verify_detached(dsig, dlen, msg, sizeof(msg), pk) == true)
+	{
+		qsctest_print_safe("Failure! qsctest_ecdsa_detached_test: ECDSA altered message passed verification -ED3 \n");
+		ret = false;
+	}
+
+	/* flip 1 bit in the signature */
+	msg[0] ^= 1U;
+	dsig[0] ^= 1U;
+
+	if (qsc_ecdsa_verify_detached(dsig, dlen, msg, sizeof(msg), pk) == true)
+	{
+		qsctest_print_safe("Failure! qsctest_ecdsa_detached_test: ECDSA altered signature passed verification -ED4 \n");
+		ret = false;
+	}
+
+	return ret;
+}
+
+bool qsctest_ecdsa_stream_test()
+{
+	uint8_t exp[QSC_ECDSA_SIGNATURE_SIZE] = { 0 };
+	uint8_t msg[QSCTEST_ECDSA_STREAM_MLEN] = { 0 };
+	uint8_t pk[QSC_ECDSA_PUBLICKEY_SIZE] = { 0 };
+	uint8_t rseed[QSCTEST_NIST_RNG_SEED_SIZE] = { 0 };
+	uint8_t seed[QSC_ECDSA_SEED_SIZE] = { 0 };
+	uint8_t sig[QSC_ECDSA_SIGNATURE_SIZE] = { 0 };
+	uint8_t sk[QSC_ECDSA_PRIVATEKEY_SIZE] = { 0 };
+	qsc_ecdsa_stream_state state;
+	size_t i;
+	size_t plen;
+	size_t siglen;
+	bool ret;
+
+	ret = true;
+	siglen = 0;
+
+	/* RFC 8032 7.3 Ed25519ph test vector, message 'abc' */
+	qsctest_hex_to_bin("833FE62409237B9D62EC77587520911E9A759CEC1D19755B7DA901B96DCA3D42", seed, sizeof(seed));
+	qsctest_hex_to_bin("98A70222F0B8121AA9D30F813D683F809E462B469C7FF87639499BB94E6DAE4131F85042463C2A355A2003D062ADF5AAA10B8C61E636062AAAD11C2A26083406", exp, sizeof(exp));
+	msg[0] = 0x61U;
+	msg[1] = 0x62U;
+	msg[2] = 0x63U;
+	qsc_ecdsa_generate_seeded_keypair(pk, sk, seed);
+
+	qsc_ecdsa_sign_initialize(&state);
+	qsc_ecdsa_sign_update(&state, msg, 1);
+	qsc_ecdsa_sign_update(&state, msg + 1, 2);
+	qsc_ecdsa_sign_finalize(&state, sig, &siglen, sk);
+
+	if (siglen != QSC_ECDSA_SIGNATURE_SIZE || qsc_intutils_are_equal8(sig, exp, siglen) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_ecdsa_stream_test: Ed25519ph signature does not match the known answer -ESM1 \n");
+		ret = false;
+	}
+
+	qsc_ecdsa_verify_initialize(&state);
+	qsc_ecdsa_verify_update(&state, msg, 3);
+
+	if (qsc_ecdsa_verify_finalize(&state, sig, siglen, pk) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_ecdsa_stream_test: Ed25519ph known answer verification has failed -ESM2 \n");
+		ret = false;
+	}
+
+	/* sign a long message in uneven blocks */
+	qsctest_hex_to_bin("061550234D158C5EC95595FE04EF7A25767F2E24CC2BC479D09D86DC9ABCFDE7056A8C266F9EF97ED08541DBD2E1FFA1", rseed, sizeof(rseed));
+	qsctest_nistrng_prng_initialize(rseed, NULL, 0);
+	qsctest_nistrng_prng_generate(msg, sizeof(msg));
+	qsc_ecdsa_sign_initialize(&state);
+
+	for (i = 0; i < sizeof(msg); i += plen)
+	{
+		plen = qsc_intutils_min(sizeof(msg) - i, (i % 113) + 1);
+		qsc_ecdsa_sign_update(&state, msg + i, plen);
+	}
+
+	qsc_ecdsa_sign_finalize(&state, sig, &siglen, sk);
+
+	qsc_ecdsa_verify_initialize(&state);
+	qsc_ecdsa_verify_update(&state, msg, sizeof(msg));
+
+	if (qsc_ecdsa_verify_finalize(&state, sig, siglen, pk) == false)
+	{
+		qsctest_print_safe("Failure! qsctest_ecdsa_stream_test: ECDSA streaming verification has failed -ESM3 \n");
+		ret = false;
+	}
+
+	/* a truncated message must fail */
+	qsc_ecdsa_verify_initialize(&state);
+	qsc_ecdsa_verify_update(&state, msg, sizeof(msg) - 1);
+
+	if (qsc_ecdsa_verify_finalize(&state, sig, siglen, pk) == true)
+	{
+		qsctest_print_safe("Failure! qsctest_ecdsa_stream_test: ECDSA truncated message passed verification -ESM4 \n");
+		ret = false;
+	}
+
+	/* the pre-hashed signature must not verify as a pure Ed25519 signature */
+	if (qsc_ecdsa_verify_detached(sig, siglen, msg, sizeof(msg), pk) == true)
+	{
+		qsctest_print_safe("Failure! qsctest_ecdsa_stream_test: Ed25519ph signature passed pure verification -ESM5 \n");
+		ret = false;
+	}
+
+	return ret;
+}
+
 void qsctest_ecdsa_run()
 {
 	if (qsctest_ecdsa_kat_test() == true)
@@ -402,4 +549,22 @@ void qsctest_ecdsa_run()
 	{
 		qsctest_print_safe("Failure! The ECDSA altered signature test has failed. \n");
 	}
+
+	if (qsctest_ecdsa_detached_test() == true)
+	{
+		qsctest_print_safe("Success! The ECDSA detached signature test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! The ECDSA detached signature test has failed. \n");
+	}
+
+	if (qsctest_ecdsa_stream_test() == true)
+	{
+		qsctest_print_safe("Success! The ECDSA streaming signature test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! The ECDSA streaming signature test has failed. \n");
+	}
 }
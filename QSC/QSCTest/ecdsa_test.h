@@ -18,6 +18,8 @@
 #	define QSCTEST_ECDSA_ITERATIONS 100
 #endif
 
+#define QSCTEST_ECDSA_STREAM_MLEN 4096
+
 /**
 * \brief Test the ECDSA known answer test vectors
 */
@@ -47,6 +49,18 @@ bool qsctest_ecdsa_signature_integrity(void);
 */
 bool qsctest_ecdsa_stress_test(void);
 
+/**
+* \brief Test detached signing and verification against the signed-message format
+* \return Returns true for test success
+*/
+bool qsctest_ecdsa_detached_test(void);
+
+/**
+* \brief Test streaming Ed25519ph signing and verification, including the RFC 8032 known answer
+* \return Returns true for test success
+*/
+bool qsctest_ecdsa_stream_test(void);
+
 /**
 * \brief Run the ECDSA implementation stress and correctness tests tests
 */
@@ -95,6 +95,77 @@ bool qsctest_falcon_operations_test()
 	return ret;
 }
 
+bool qsctest_falcon_kat_equivalence_test()
+{
+	uint8_t kmsg[QSCTEST_FALCON_MLEN * QSCTEST_FALCON_KAT_COUNT] = { 0 };
+	uint8_t pk[QSC_FALCON_PUBLICKEY_SIZE] = { 0 };
+	uint8_t kpk[QSC_FALCON_PUBLICKEY_SIZE] = { 0 };
+	uint8_t seed[QSCTEST_NIST_RNG_SEED_SIZE] = { 0 };
+	uint8_t sk[QSC_FALCON_PRIVATEKEY_SIZE] = { 0 };
+	uint8_t ksk[QSC_FALCON_PRIVATEKEY_SIZE] = { 0 };
+	uint8_t sig[QSC_FALCON_SIGNATURE_SIZE + (QSCTEST_FALCON_MLEN * QSCTEST_FALCON_KAT_COUNT)] = { 0 };
+	uint8_t ksig[QSC_FALCON_SIGNATURE_SIZE + (QSCTEST_FALCON_MLEN * QSCTEST_FALCON_KAT_COUNT)] = { 0 };
+	size_t kmsglen;
+	size_t kpklen;
+	size_t kseedlen;
+	size_t ksiglen;
+	size_t ksklen;
+	size_t siglen;
+	uint32_t i;
+	bool ret;
+
+#if defined(QSC_FALCON_S3SHAKE256F512)
+	char path[] = "NPQCR3/falcon512.rsp";
+#elif defined(QSC_FALCON_S5SHAKE256F1024)
+	char path[] = "NPQCR3/falcon1024.rsp";
+#else
+#	error The parameter set is invalid!
+#endif
+
+	ret = true;
+
+	for (i = 0; i < QSCTEST_FALCON_KAT_COUNT; ++i)
+	{
+		kmsglen = 0;
+		kpklen = 0;
+		kseedlen = 0;
+		ksiglen = 0;
+		ksklen = 0;
+		siglen = 0;
+
+		/* the message length grows by QSCTEST_FALCON_MLEN with each vector */
+		parse_nist_signature_kat(path, seed, &kseedlen, kmsg, &kmsglen, kpk, &kpklen, ksk, &ksklen, ksig, &ksiglen, i);
+
+		if (kmsglen != QSCTEST_FALCON_MLEN * (i + 1) || ksiglen > sizeof(ksig))
+		{
+			qsctest_print_safe("Failure! falcon equivalence: the known answer file could not be parsed -FKE1 \n");
+			ret = false;
+			break;
+		}
+
+		qsctest_nistrng_prng_initialize(seed, NULL, 0);
+		qsc_falcon_generate_keypair(pk, sk, qsctest_nistrng_prng_generate);
+
+		if (qsc_intutils_are_equal8(pk, kpk, QSC_FALCON_PUBLICKEY_SIZE) == false || qsc_intutils_are_equal8(sk, ksk, QSC_FALCON_PRIVATEKEY_SIZE) == false)
+		{
+			qsctest_print_safe("Failure! falcon equivalence: a key pair does not align with the known answer -FKE2 \n");
+			ret = false;
+			break;
+		}
+
+		qsc_falcon_sign(sig, &siglen, kmsg, kmsglen, sk, qsctest_nistrng_prng_generate);
+
+		if (siglen != ksiglen || qsc_intutils_are_equal8(sig, ksig, siglen) == false)
+		{
+			qsctest_print_safe("Failure! falcon equivalence: a signature does not align with the known answer -FKE3 \n");
+			ret = false;
+			break;
+		}
+	}
+
+	return ret;
+}
+
 bool qsctest_falcon_privatekey_integrity()
 {
 	uint8_t msg[QSCTEST_FALCON_MLEN] = { 0 };
@@ -247,7 +318,7 @@ bool qsctest_falcon_stress_test()
 	/* sign the message and return the signed version in sig */
 	qsc_falcon_sign(sig, &siglen, msg, msglen, sk, qsctest_nistrng_prng_generate);
 
-	if (siglen != QSC_FALCON_SIGNATURE_SIZE + QSCTEST_FALCON_MLEN)
+	if (siglen > QSC_FALCON_SIGNATURE_SIZE + QSCTEST_FALCON_MLEN)
 	{
 		qsctest_print_safe("Failure! falcon stress: signature length is incorrect -DST1 \n");
 		ret = false;
@@ -344,6 +415,221 @@ bool qsctest_falcon_stress_test2()
 	return ret;
 }
 
+bool qsctest_falcon_detached_test()
+{
+	uint8_t dsig[QSC_FALCON_SIGNATURE_SIZE] = { 0 };
+	uint8_t msg[QSCTEST_FALCON_MLEN] = { 0 };
+	uint8_t seed[QSCTEST_NIST_RNG_SEED_SIZE] = { 0 };
+	uint8_t sig[QSC_FALCON_SIGNATURE_SIZE + QSCTEST_FALCON_MLEN] = { 0 };
+	uint8_t sk[QSC_FALCON_PRIVATEKEY_SIZE] = { 0 };
+	uint8_t pk[QSC_FALCON_PUBLICKEY_SIZE] = { 0 };
+	size_t dlen;
+	size_t hlen;
+	size_t siglen;
+	bool ret;
+
+	ret = true;
+	dlen = 0;
+	siglen = 0;
+	/* the signature length and nonce precede the message in the signed message */
+	hlen = 2 + 40;
+	qsctest_hex_to_bin("061550234D158C5EC95595FE04EF7A25767F2E24CC2BC479D09D86DC9ABCFDE7056A8C266F9EF97ED08541DBD2E1FFA1", seed, sizeof(seed));
+	qsctest_nistrng_prng_initialize(seed, NULL, 0);
+	qsc_falcon_generate_keypair(pk, sk, qsctest_nistrng_prng_generate);
+	qsctest_nistrng_prng_generate(msg, sizeof(msg));
+
+	/* sign the same message with the same random state in both formats */
+	qsctest_nistrng_prng_initialize(seed, NULL, 0);
+	qsc_falcon_sign(sig, &siglen, msg, sizeof(msg), sk, qsctest_nistrng_prng_generate);
+	qsctest_nistrng_prng_initialize(seed, NULL, 0);
+	qsc_falcon_sign_detached(dsig, &dlen, msg, sizeof(msg), sk, qsctest_nistrng_prng_generate);
+
+	if (dlen != siglen - sizeof(msg) || dlen > QSC_FALCON_SIGNATURE_SIZE)
+	{
+		qsctest_print_safe("Failure! falcon detached: signature length is incorrect -FDT1 \n");
+		ret = false;
+	}
+
+	/* the detached signature is the signed message with the message removed */
+	if (qsc_intutils_are_equal8(dsig, sig, hlen) == false ||
+		qsc_intutils_are_equal8(dsig + hlen, sig + hlen + sizeof(msg), dlen - hlen) == false)
+	{
+		qsctest_print_safe("Failure! falcon detached: signature does not match the signed message -FDT2 \n");
+		ret = false;
+	}
+
+	if (qsc_falcon_verify_detached(dsig, dlen, msg, sizeof(msg), pk) != true)
+	{
+		qsctest_print_safe("Failure! falcon detached: signature verification has failed -FDT3 \n");
+		ret = false;
+	}
+
+	/* flip 1 bit in the message */
+	msg[0] ^= 1U;
+
+	if (qsc_falcon_verify_detached(dsig, dlen, msg, sizeof(msg), pk) == true)
+	{
+		qsctest_print_safe("Failure! falcon detached: altered message passed verification -FDT4 \n");
+		ret = false;
+	}
+
+	/* flip 1 bit in the signature */
+	msg[0] ^= 1U;
+	dsig[dlen - 1] ^= 1U;
+
+	if (qsc_falcon_verify_detached(dsig, dlen, msg, sizeof(msg), pk) == true)
+	{
+		qsctest_print_safe("Failure! falcon detached: altered signature passed verification -FDT5 \n");
+		ret = false;
+	}
+
+	return ret;
+}
+
+bool qsctest_falcon_stream_test()
+{
+	uint8_t dsig[QSC_FALCON_SIGNATURE_SIZE] = { 0 };
+	uint8_t msg[QSCTEST_FALCON_STREAM_MLEN] = { 0 };
+	uint8_t seed[QSCTEST_NIST_RNG_SEED_SIZE] = { 0 };
+	uint8_t sig[QSC_FALCON_SIGNATURE_SIZE] = { 0 };
+	uint8_t sk[QSC_FALCON_PRIVATEKEY_SIZE] = { 0 };
+	uint8_t pk[QSC_FALCON_PUBLICKEY_SIZE] = { 0 };
+	qsc_falcon_stream_state state;
+	size_t dlen;
+	size_t pos;
+	size_t siglen;
+	bool ret;
+
+	ret = true;
+	dlen = 0;
+	siglen = 0;
+	qsctest_hex_to_bin("061550234D158C5EC95595FE04EF7A25767F2E24CC2BC479D09D86DC9ABCFDE7056A8C266F9EF97ED08541DBD2E1FFA1", seed, sizeof(seed));
+	qsctest_nistrng_prng_initialize(seed, NULL, 0);
+	qsc_falcon_generate_keypair(pk, sk, qsctest_nistrng_prng_generate);
+	qsctest_nistrng_prng_generate(msg, sizeof(msg));
+
+	/* sign the message in uneven blocks; with the same random state the signature must equal the one-shot signature */
+	qsctest_nistrng_prng_initialize(seed, NULL, 0);
+	qsc_falcon_sign_detached(dsig, &dlen, msg, sizeof(msg), sk, qsctest_nistrng_prng_generate);
+	qsctest_nistrng_prng_initialize(seed, NULL, 0);
+	qsc_falcon_sign_initialize(&state, qsctest_nistrng_prng_generate);
+
+	for (pos = 0; pos < sizeof(msg); pos += 1 + (pos % 300))
+	{
+		qsc_falcon_sign_update(&state, msg + pos, qsc_intutils_min(1 + (pos % 300), sizeof(msg) - pos));
+	}
+
+	qsc_falcon_sign_finalize(&state, sig, &siglen, sk, qsctest_nistrng_prng_generate);
+
+	if (siglen != dlen || qsc_intutils_are_equal8(sig, dsig, dlen) == false)
+	{
+		qsctest_print_safe("Failure! falcon stream: signature does not match the one-shot signature -FSM1 \n");
+		ret = false;
+	}
+
+	qsc_falcon_verify_initialize(&state, sig, siglen);
+	qsc_falcon_verify_update(&state, msg, 1);
+	qsc_falcon_verify_update(&state, msg + 1, sizeof(msg) - 1);
+
+	if (qsc_falcon_verify_finalize(&state, sig, siglen, pk) != true)
+	{
+		qsctest_print_safe("Failure! falcon stream: signature verification has failed -FSM2 \n");
+		ret = false;
+	}
+
+	/* drop the last message byte */
+	qsc_falcon_verify_initialize(&state, sig, siglen);
+	qsc_falcon_verify_update(&state, msg, sizeof(msg) - 1);
+
+	if (qsc_falcon_verify_finalize(&state, sig, siglen, pk) == true)
+	{
+		qsctest_print_safe("Failure! falcon stream: truncated message passed verification -FSM3 \n");
+		ret = false;
+	}
+
+	/* a verification state initialized with another signature nonce must fail */
+	qsc_falcon_verify_initialize(&state, dsig, dlen);
+	qsc_falcon_verify_update(&state, msg, sizeof(msg));
+	sig[2] ^= 1U;
+
+	if (qsc_falcon_verify_finalize(&state, sig, siglen, pk) == true)
+	{
+		qsctest_print_safe("Failure! falcon stream: altered nonce passed verification -FSM4 \n");
+		ret = false;
+	}
+
+	return ret;
+}
+
+bool qsctest_falcon_expanded_test()
+{
+	uint8_t msg[QSCTEST_FALCON_MLEN] = { 0 };
+	uint8_t mout[QSCTEST_FALCON_MLEN] = { 0 };
+	uint8_t pk[QSC_FALCON_PUBLICKEY_SIZE] = { 0 };
+	uint8_t seed[QSCTEST_NIST_RNG_SEED_SIZE] = { 0 };
+	uint8_t sig[QSC_FALCON_SIGNATURE_SIZE + QSCTEST_FALCON_MLEN] = { 0 };
+	uint8_t sk[QSC_FALCON_PRIVATEKEY_SIZE] = { 0 };
+	uint8_t xsig[QSC_FALCON_SIGNATURE_SIZE + QSCTEST_FALCON_MLEN] = { 0 };
+	qsc_falcon_expanded_privatekey* esk;
+	size_t mlen;
+	size_t siglen;
+	size_t xlen;
+	bool ret;
+
+	ret = false;
+	esk = (qsc_falcon_expanded_privatekey*)qsc_memutils_aligned_alloc(64, sizeof(qsc_falcon_expanded_privatekey));
+
+	if (esk != NULL)
+	{
+		ret = true;
+		mlen = 0;
+		siglen = 0;
+		xlen = 0;
+		qsctest_hex_to_bin("061550234D158C5EC95595FE04EF7A25767F2E24CC2BC479D09D86DC9ABCFDE7056A8C266F9EF97ED08541DBD2E1FFA1", seed, sizeof(seed));
+		qsctest_nistrng_prng_initialize(seed, NULL, 0);
+		qsc_falcon_generate_keypair(pk, sk, qsctest_nistrng_prng_generate);
+		qsctest_nistrng_prng_generate(msg, sizeof(msg));
+
+		if (qsc_falcon_expand_privatekey(esk, sk) == false)
+		{
+			qsctest_print_safe("Failure! falcon expanded: the private key expansion has failed -FEX1 \n");
+			ret = false;
+		}
+
+		/* with the same random state, the expanded key signature must equal the packed key signature */
+		qsctest_nistrng_prng_initialize(seed, NULL, 0);
+		qsc_falcon_sign(sig, &siglen, msg, sizeof(msg), sk, qsctest_nistrng_prng_generate);
+		qsctest_nistrng_prng_initialize(seed, NULL, 0);
+		qsc_falcon_sign_expanded(xsig, &xlen, msg, sizeof(msg), esk, qsctest_nistrng_prng_generate);
+
+		if (xlen != siglen || qsc_intutils_are_equal8(xsig, sig, siglen) == false)
+		{
+			qsctest_print_safe("Failure! falcon expanded: the expanded key signature does not match -FEX2 \n");
+			ret = false;
+		}
+
+		if (qsc_falcon_verify(mout, &mlen, xsig, xlen, pk) == false || mlen != sizeof(msg) || qsc_intutils_are_equal8(mout, msg, mlen) == false)
+		{
+			qsctest_print_safe("Failure! falcon expanded: the expanded key signature verification has failed -FEX3 \n");
+			ret = false;
+		}
+
+		/* a malformed private key must be rejected */
+		sk[0] ^= 1U;
+
+		if (qsc_falcon_expand_privatekey(esk, sk) == true)
+		{
+			qsctest_print_safe("Failure! falcon expanded: a malformed private key was expanded -FEX4 \n");
+			ret = false;
+		}
+
+		qsc_falcon_expanded_privatekey_dispose(esk);
+		qsc_memutils_aligned_free(esk);
+	}
+
+	return ret;
+}
+
 void qsctest_falcon_run()
 {
 	if (qsctest_falcon_operations_test() == true)
@@ -355,6 +641,15 @@ void qsctest_falcon_run()
 		qsctest_print_safe("Failure! Failed the Falcon known answer integrity tests. \n");
 	}
 
+	if (qsctest_falcon_kat_equivalence_test() == true)
+	{
+		qsctest_print_safe("Success! Passed the Falcon multi-vector known answer equivalence test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the Falcon multi-vector known answer equivalence test. \n");
+	}
+
 	if (qsctest_falcon_stress_test() == true)
 	{
 		qsctest_print_safe("Success! Passed the Falcon stress test. \n");
@@ -390,4 +685,31 @@ void qsctest_falcon_run()
 	{
 		qsctest_print_safe("Failure! Failed the Falcon altered signature test has failed. \n");
 	}
+
+	if (qsctest_falcon_detached_test() == true)
+	{
+		qsctest_print_safe("Success! Passed the Falcon detached signature test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the Falcon detached signature test has failed. \n");
+	}
+
+	if (qsctest_falcon_stream_test() == true)
+	{
+		qsctest_print_safe("Success! Passed the Falcon streaming signature test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the Falcon streaming signature test has failed. \n");
+	}
+
+	if (qsctest_falcon_expanded_test() == true)
+	{
+		qsctest_print_safe("Success! Passed the Falcon expanded private-key signature test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the Falcon expanded private-key signature test has failed. \n");
+	}
 }
@@ -14,6 +14,8 @@
 #include "common.h"
 
 #define QSCTEST_FALCON_MLEN 33
+#define QSCTEST_FALCON_STREAM_MLEN 4096
+#define QSCTEST_FALCON_KAT_COUNT 10
 
 /**
 * \brief Test the public and private keys, cipher-text and shared key
@@ -23,6 +25,13 @@
 */
 bool qsctest_falcon_operations_test(void);
 
+/**
+* \brief Test the keys and signatures against the first QSCTEST_FALCON_KAT_COUNT vectors in the NIST PQC Round 3 KAT file.
+* Checks that the configured floating-point backend reproduces the reference outputs bit for bit.
+* \return Returns true for test success
+*/
+bool qsctest_falcon_kat_equivalence_test(void);
+
 /**
 * \brief Test the validity of a mutated secret key
 * \return Returns true for test success
@@ -49,6 +58,24 @@ bool qsctest_falcon_stress_test(void);
 
 bool qsctest_falcon_stress_test2(void);
 
+/**
+* \brief Test detached signing and verification against the signed-message format
+* \return Returns true for test success
+*/
+bool qsctest_falcon_detached_test(void);
+
+/**
+* \brief Test streaming signing and verification against the one-shot detached functions
+* \return Returns true for test success
+*/
+bool qsctest_falcon_stream_test(void);
+
+/**
+* \brief Test signing with an expanded private key against the packed-key signature
+* \return Returns true for test success
+*/
+bool qsctest_falcon_expanded_test(void);
+
 /**
 * \brief Run the Falcon implementation stress and correctness tests tests
 */
@@ -6,6 +6,8 @@
 #include "../QSC/csp.h"
 #include "../QSC/intutils.h"
 #include "../QSC/kyber.h"
+#include "../QSC/kyberbase.h"
+#include "../QSC/kyberbase_avx2.h"
 #include "../QSC/memutils.h"
 
 bool qsctest_kyber_ciphertext_integrity()
@@ -53,6 +55,140 @@ bool qsctest_kyber_ciphertext_integrity()
 	return res;
 }
 
+#if defined(QSC_SYSTEM_HAS_AVX2)
+bool qsctest_kyber_avx2_equality()
+{
+	uint8_t ct1[QSC_KYBER_CIPHERTEXT_SIZE] = { 0 };
+	uint8_t ct2[QSC_KYBER_CIPHERTEXT_SIZE] = { 0 };
+	uint8_t pk1[QSC_KYBER_PUBLICKEY_SIZE] = { 0 };
+	uint8_t pk2[QSC_KYBER_PUBLICKEY_SIZE] = { 0 };
+	uint8_t seed[QSCTEST_NIST_RNG_SEED_SIZE] = { 0 };
+	uint8_t sk1[QSC_KYBER_PRIVATEKEY_SIZE] = { 0 };
+	uint8_t sk2[QSC_KYBER_PRIVATEKEY_SIZE] = { 0 };
+	uint8_t ss1[QSC_KYBER_SHAREDSECRET_SIZE] = { 0 };
+	uint8_t ss2[QSC_KYBER_SHAREDSECRET_SIZE] = { 0 };
+	uint8_t ss3[QSC_KYBER_SHAREDSECRET_SIZE] = { 0 };
+	uint8_t ss4[QSC_KYBER_SHAREDSECRET_SIZE] = { 0 };
+	bool res;
+
+	res = true;
+
+	for (size_t i = 0; i < QSCTEST_KYBER_EQUALITY_CYCLES; ++i)
+	{
+		qsc_csp_generate(seed, sizeof(seed));
+
+		/* the reference implementation */
+		qsctest_nistrng_prng_initialize(seed, NULL, 0);
+		qsc_kyber_ref_generate_keypair(pk1, sk1, qsctest_nistrng_prng_generate);
+		qsc_kyber_ref_encapsulate(ct1, ss1, pk1, qsctest_nistrng_prng_generate);
+
+		/* the AVX2 implementation */
+		qsctest_nistrng_prng_initialize(seed, NULL, 0);
+		qsc_kyber_avx2_generate_keypair(pk2, sk2, qsctest_nistrng_prng_generate);
+		qsc_kyber_avx2_encapsulate(ct2, ss2, pk2, qsctest_nistrng_prng_generate);
+
+		if (qsc_intutils_are_equal8(pk1, pk2, sizeof(pk1)) != true || qsc_intutils_are_equal8(sk1, sk2, sizeof(sk1)) != true)
+		{
+			qsc_consoleutils_print_line("Failure! kyber avx2 equality: the key-pairs are not equal -KAE1");
+			res = false;
+			break;
+		}
+
+		if (qsc_intutils_are_equal8(ct1, ct2, sizeof(ct1)) != true || qsc_intutils_are_equal8(ss1, ss2, sizeof(ss1)) != true)
+		{
+			qsc_consoleutils_print_line("Failure! kyber avx2 equality: the encapsulations are not equal -KAE2");
+			res = false;
+			break;
+		}
+
+		if (qsc_kyber_ref_decapsulate(ss3, ct1, sk1) != true || qsc_kyber_avx2_decapsulate(ss4, ct1, sk2) != true)
+		{
+			qsc_consoleutils_print_line("Failure! kyber avx2 equality: decapsulation failure -KAE3");
+			res = false;
+			break;
+		}
+
+		if (qsc_intutils_are_equal8(ss3, ss4, sizeof(ss3)) != true || qsc_intutils_are_equal8(ss1, ss4, sizeof(ss1)) != true)
+		{
+			qsc_consoleutils_print_line("Failure! kyber avx2 equality: the shared secrets are not equal -KAE4");
+			res = false;
+			break;
+		}
+	}
+
+	return res;
+}
+#endif
+
+bool qsctest_kyber_expanded_equality()
+{
+	uint8_t ct1[QSC_KYBER_CIPHERTEXT_SIZE] = { 0 };
+	uint8_t ct2[QSC_KYBER_CIPHERTEXT_SIZE] = { 0 };
+	uint8_t pk[QSC_KYBER_PUBLICKEY_SIZE] = { 0 };
+	uint8_t seed[QSCTEST_NIST_RNG_SEED_SIZE] = { 0 };
+	uint8_t sk[QSC_KYBER_PRIVATEKEY_SIZE] = { 0 };
+	uint8_t ss1[QSC_KYBER_SHAREDSECRET_SIZE] = { 0 };
+	uint8_t ss2[QSC_KYBER_SHAREDSECRET_SIZE] = { 0 };
+	uint8_t ss3[QSC_KYBER_SHAREDSECRET_SIZE] = { 0 };
+	uint8_t ss4[QSC_KYBER_SHAREDSECRET_SIZE] = { 0 };
+	qsc_kyber_expanded_publickey epk;
+	qsc_kyber_expanded_privatekey esk;
+	bool res;
+
+	res = true;
+	qsc_csp_generate(seed, sizeof(seed));
+	qsctest_nistrng_prng_initialize(seed, NULL, 0);
+	qsc_kyber_generate_keypair(pk, sk, qsctest_nistrng_prng_generate);
+	qsc_kyber_expand_publickey(&epk, pk);
+	qsc_kyber_expand_privatekey(&esk, sk);
+
+	for (size_t i = 0; i < QSCTEST_KYBER_EQUALITY_CYCLES; ++i)
+	{
+		qsc_csp_generate(seed, sizeof(seed));
+
+		/* the packed and expanded public keys must produce the same encapsulation */
+		qsctest_nistrng_prng_initialize(seed, NULL, 0);
+		qsc_kyber_encapsulate(ss1, ct1, pk, qsctest_nistrng_prng_generate);
+		qsctest_nistrng_prng_initialize(seed, NULL, 0);
+		qsc_kyber_encapsulate_expanded(ss2, ct2, &epk, qsctest_nistrng_prng_generate);
+
+		if (qsc_intutils_are_equal8(ct1, ct2, sizeof(ct1)) != true || qsc_intutils_are_equal8(ss1, ss2, sizeof(ss1)) != true)
+		{
+			qsc_consoleutils_print_line("Failure! kyber expanded equality: the encapsulations are not equal -KXE1");
+			res = false;
+			break;
+		}
+
+		if (qsc_kyber_decapsulate_expanded(ss3, ct1, &esk) != true || qsc_intutils_are_equal8(ss1, ss3, sizeof(ss1)) != true)
+		{
+			qsc_consoleutils_print_line("Failure! kyber expanded equality: decapsulation failure -KXE2");
+			res = false;
+			break;
+		}
+
+		/* a mutated cipher-text must fail, and yield the same implicit rejection secret */
+		ct1[i % sizeof(ct1)] ^= 1U;
+
+		if (qsc_kyber_decapsulate_expanded(ss3, ct1, &esk) == true || qsc_kyber_decapsulate(ss4, ct1, sk) == true)
+		{
+			qsc_consoleutils_print_line("Failure! kyber expanded equality: decapsulated a mutated cipher-text -KXE3");
+			res = false;
+			break;
+		}
+
+		if (qsc_intutils_are_equal8(ss3, ss4, sizeof(ss3)) != true)
+		{
+			qsc_consoleutils_print_line("Failure! kyber expanded equality: the rejection secrets are not equal -KXE4");
+			res = false;
+			break;
+		}
+	}
+
+	qsc_kyber_expanded_privatekey_dispose(&esk);
+
+	return res;
+}
+
 bool qsctest_kyber_kat_test()
 {
 	uint8_t ct[QSC_KYBER_CIPHERTEXT_SIZE] = { 0 };
@@ -332,4 +468,24 @@ void qsctest_kyber_run()
 	{
 		qsc_consoleutils_print_line("Failure! Failed the Kyber cipher-text tamper test.");
 	}
+
+#if defined(QSC_SYSTEM_HAS_AVX2)
+	if (qsctest_kyber_avx2_equality() == true)
+	{
+		qsc_consoleutils_print_line("Success! Passed the Kyber AVX2 and reference implementation equality test.");
+	}
+	else
+	{
+		qsc_consoleutils_print_line("Failure! Failed the Kyber AVX2 and reference implementation equality test.");
+	}
+#endif
+
+	if (qsctest_kyber_expanded_equality() == true)
+	{
+		qsc_consoleutils_print_line("Success! Passed the Kyber expanded key equality test.");
+	}
+	else
+	{
+		qsc_consoleutils_print_line("Failure! Failed the Kyber expanded key equality test.");
+	}
 }
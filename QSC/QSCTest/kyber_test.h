@@ -12,6 +12,9 @@
 #define QSCTEST_KYBER_TEST_H
 
 #include "common.h"
+#include "../QSC/common.h"
+
+#define QSCTEST_KYBER_EQUALITY_CYCLES 10
 
 /**
 * \brief Test the validity of a mutated cipher-text
@@ -19,6 +22,22 @@
 */
 bool qsctest_kyber_ciphertext_integrity(void);
 
+#if defined(QSC_SYSTEM_HAS_AVX2)
+/**
+* \brief Test the AVX2 implementation against the reference implementation;
+* the keys, cipher-texts and shared secrets generated from the same random seed must be identical
+* \return Returns true for test success
+*/
+bool qsctest_kyber_avx2_equality(void);
+#endif
+
+/**
+* \brief Test the expanded key functions against the packed key functions;
+* encapsulation and decapsulation with the expanded keys must produce identical outputs
+* \return Returns true for test success
+*/
+bool qsctest_kyber_expanded_equality(void);
+
 /**
 * \brief Test the public and private keys, cipher-text and shared key
 * for correctness against the NIST PQC Round 3 vectors
@@ -1,6 +1,7 @@
 #include "poly1305_test.h"
 #include "common.h"
 #include "testutils.h"
+#include "../QSC/csp.h"
 #include "../QSC/intutils.h"
 #include "../QSC/poly1305.h"
 
@@ -95,6 +96,123 @@ bool qsctest_poly1305_kat()
 	return status;
 }
 
+#if defined(QSC_POLY1305_PARALLEL_BLOCKS)
+bool qsctest_poly1305_wide_equality()
+{
+	uint8_t code1[QSC_POLY1305_MAC_SIZE] = { 0 };
+	uint8_t code2[QSC_POLY1305_MAC_SIZE] = { 0 };
+	uint8_t key[QSC_POLY1305_KEY_SIZE] = { 0 };
+	uint8_t msg[4096] = { 0 };
+	uint8_t pmcnt[sizeof(uint16_t)] = { 0 };
+	qsc_poly1305_state ctx;
+	size_t i;
+	size_t mlen;
+	bool status;
+
+	status = true;
+
+	for (size_t j = 0; j < QSCTEST_POLY1305_TEST_CYCLES; ++j)
+	{
+		qsc_csp_generate(key, sizeof(key));
+		qsc_csp_generate(msg, sizeof(msg));
+		qsc_csp_generate(pmcnt, sizeof(pmcnt));
+		mlen = (size_t)qsc_intutils_le8to16(pmcnt) % sizeof(msg);
+
+		/* multi-block update */
+		qsc_poly1305_compute(code1, msg, mlen, key);
+
+		/* single block update */
+		qsc_poly1305_initialize(&ctx, key);
+
+		for (i = 0; i + QSC_POLY1305_BLOCK_SIZE <= mlen; i += QSC_POLY1305_BLOCK_SIZE)
+		{
+			qsc_poly1305_blockupdate(&ctx, msg + i);
+		}
+
+		qsc_poly1305_update(&ctx, msg + i, mlen - i);
+		qsc_poly1305_finalize(&ctx, code2);
+
+		if (qsc_intutils_are_equal8(code1, code2, sizeof(code1)) == false)
+		{
+			status = false;
+			break;
+		}
+	}
+
+	return status;
+}
+#endif
+
+bool qsctest_poly1305_verify_batch()
+{
+	qsc_poly1305_verify_item items[QSCTEST_POLY1305_VERIFY_COUNT] = { 0 };
+	uint8_t bitmap[(QSCTEST_POLY1305_VERIFY_COUNT + 7) / 8] = { 0 };
+	uint8_t code[QSCTEST_POLY1305_VERIFY_COUNT][QSC_POLY1305_MAC_SIZE] = { 0 };
+	uint8_t key[QSCTEST_POLY1305_VERIFY_COUNT][QSC_POLY1305_KEY_SIZE] = { 0 };
+	uint8_t msg[QSCTEST_POLY1305_VERIFY_MESSAGE] = { 0 };
+	size_t i;
+	size_t mlen;
+	uint8_t exp;
+	bool status;
+
+	qsc_csp_generate(msg, sizeof(msg));
+	qsc_csp_generate((uint8_t*)key, sizeof(key));
+	status = true;
+
+	/* every item has its own key and message length */
+	for (i = 0; i < QSCTEST_POLY1305_VERIFY_COUNT; ++i)
+	{
+		mlen = (i * 97) % sizeof(msg);
+		qsc_poly1305_compute(code[i], msg, mlen, key[i]);
+		items[i].code = code[i];
+		items[i].message = msg;
+		items[i].key = key[i];
+		items[i].msglen = mlen;
+	}
+
+	if (qsc_poly1305_verify_batch(bitmap, items, QSCTEST_POLY1305_VERIFY_COUNT) == false)
+	{
+		qsctest_print_safe("Failure! poly1305_verify_batch: valid codes failed verification -PV1 \n");
+		status = false;
+	}
+
+	for (i = 0; i < QSCTEST_POLY1305_VERIFY_COUNT; ++i)
+	{
+		if (((bitmap[i / 8] >> (i % 8)) & 1U) != 1U)
+		{
+			qsctest_print_safe("Failure! poly1305_verify_batch: the bitmap is incorrect -PV2 \n");
+			status = false;
+			break;
+		}
+	}
+
+	/* alter every third code */
+	for (i = 0; i < QSCTEST_POLY1305_VERIFY_COUNT; i += 3)
+	{
+		code[i][i % QSC_POLY1305_MAC_SIZE] ^= 0x01U;
+	}
+
+	if (qsc_poly1305_verify_batch(bitmap, items, QSCTEST_POLY1305_VERIFY_COUNT) == true)
+	{
+		qsctest_print_safe("Failure! poly1305_verify_batch: altered codes passed verification -PV3 \n");
+		status = false;
+	}
+
+	for (i = 0; i < QSCTEST_POLY1305_VERIFY_COUNT; ++i)
+	{
+		exp = (i % 3 == 0) ? 0U : 1U;
+
+		if (((bitmap[i / 8] >> (i % 8)) & 1U) != exp)
+		{
+			qsctest_print_safe("Failure! poly1305_verify_batch: the bitmap is incorrect -PV4 \n");
+			status = false;
+			break;
+		}
+	}
+
+	return status;
+}
+
 void qsctest_poly1305_run()
 {
 	if (qsctest_poly1305_kat() == true)
@@ -105,4 +223,24 @@ void qsctest_poly1305_run()
 	{
 		qsctest_print_safe("Failure! Failed the Poly1305 KAT tests. \n");
 	}
+
+#if defined(QSC_POLY1305_PARALLEL_BLOCKS)
+	if (qsctest_poly1305_wide_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the Poly1305 AVX mode equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the Poly1305 AVX mode equality test. \n");
+	}
+#endif
+
+	if (qsctest_poly1305_verify_batch() == true)
+	{
+		qsctest_print_safe("Success! Passed the Poly1305 batch verification test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the Poly1305 batch verification test. \n");
+	}
 }
@@ -11,6 +11,11 @@
 #define QSCTEST_POLY1305_TEST_H
 
 #include "../QSC/common.h"
+#include "../QSC/poly1305.h"
+
+#define QSCTEST_POLY1305_TEST_CYCLES 100
+#define QSCTEST_POLY1305_VERIFY_COUNT 19
+#define QSCTEST_POLY1305_VERIFY_MESSAGE 600
 
 /**
 * \brief Tests the Poly1305 implementation.
@@ -22,6 +27,24 @@
 */
 bool qsctest_poly1305_kat(void);
 
+#if defined(QSC_POLY1305_PARALLEL_BLOCKS)
+/**
+* \brief Tests the AVX2 or AVX512 multi-block Poly1305 update for equivalence with the single block function.
+* Uses random keys and message sizes.
+*
+* \return Returns true for success
+*/
+bool qsctest_poly1305_wide_equality(void);
+#endif
+
+/**
+* \brief Tests the Poly1305 batch verification, using a distinct key for every item.
+* The bitmap must flag exactly the items with altered codes.
+*
+* \return Returns true for success
+*/
+bool qsctest_poly1305_verify_batch(void);
+
 /**
 * \brief Run all Poly1305 MAC generator tests
 */
@@ -280,6 +280,18 @@ int32_t main(void)
 			qsctest_print_line("");
 			qsctest_benchmark_shake_run();
 			qsctest_print_line("");
+			qsctest_print_line("Testing symmetric SHA2 primitives..");
+			qsctest_benchmark_sha2_run();
+			qsctest_print_line("");
+		}
+
+		if (qsctest_test_confirm("Press 'Y' then Enter to run Asymmetric Speed Tests, any other key to cancel: ") == true)
+		{
+			qsctest_print_line("Testing asymmetric signature schemes..");
+			qsctest_benchmark_dilithium_run();
+			qsctest_print_line("");
+			qsctest_benchmark_falcon_run();
+			qsctest_print_line("");
 		}
 
 		qsctest_print_line("Completed! Press any key to close..");
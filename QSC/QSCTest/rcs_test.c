@@ -2,6 +2,7 @@
 #include "../QSC/csp.h"
 #include "../QSC/intutils.h"
 #include "../QSC/memutils.h"
+#include "../QSC/sha3.h"
 #include "testutils.h"
 
 bool qsctest_rcs256_kat()
@@ -500,6 +501,77 @@ bool qsctest_extended_cipher_test()
 	return res;
 }
 
+#if defined(QSC_RCS_AUTHENTICATED)
+static bool rcs_authenticated_compare(size_t keylen, const char* expected)
+{
+	uint8_t ad[20] = { 0 };
+	uint8_t enc[2000 + QSC_RCS_512_MAC_SIZE] = { 0 };
+	uint8_t exp[QSC_SHA3_256_HASH_SIZE] = { 0 };
+	uint8_t hash[QSC_SHA3_256_HASH_SIZE] = { 0 };
+	uint8_t key[QSC_RCS_512_KEY_SIZE] = { 0 };
+	uint8_t msg[2000] = { 0 };
+	uint8_t nce[QSC_RCS_NONCE_SIZE] = { 0 };
+	qsc_rcs_state state;
+	bool res;
+
+	for (size_t i = 0; i < sizeof(key); ++i)
+	{
+		key[i] = (uint8_t)i;
+	}
+
+	for (size_t i = 0; i < sizeof(nce); ++i)
+	{
+		nce[i] = (uint8_t)(0xFFU - i);
+	}
+
+	for (size_t i = 0; i < sizeof(msg); ++i)
+	{
+		msg[i] = (uint8_t)i;
+	}
+
+	qsctest_hex_to_bin(expected, exp, sizeof(exp));
+	qsc_memutils_setvalue(ad, 0x01, sizeof(ad));
+
+	qsc_rcs_keyparams kp = { key, keylen, nce, NULL, 0 };
+	qsc_rcs_initialize(&state, &kp, true);
+	qsc_rcs_set_associated(&state, ad, sizeof(ad));
+
+	/* the second call tests mac chaining across multiple transform calls */
+	qsc_rcs_transform(&state, enc, msg, sizeof(msg));
+	qsc_rcs_transform(&state, enc, msg, sizeof(msg));
+	qsc_rcs_dispose(&state);
+
+	/* the mac size is equal to the key size */
+	qsc_sha3_compute256(hash, enc, sizeof(msg) + keylen);
+	res = qsc_intutils_are_equal8(hash, exp, sizeof(exp));
+
+	return res;
+}
+
+bool qsctest_rcs_authenticated_kat()
+{
+	bool status;
+
+	status = true;
+
+	/* sha3-256 hashes of cipher-text and mac, generated with the reference implementation */
+
+	if (rcs_authenticated_compare(QSC_RCS_256_KEY_SIZE, "7B196EBF0AC81E34D8059E0567C78242425DDDD7A6C1E1343C621888DD329665") == false)
+	{
+		qsctest_print_safe("Failure! rcs_authenticated_kat: RCS-256 output does not match the known answer -RT1 \n");
+		status = false;
+	}
+
+	if (rcs_authenticated_compare(QSC_RCS_512_KEY_SIZE, "98396E4F448BDAEFB99064532E1B9E9D092FFEEC64BEDD95B6EF725AECA2FBC5") == false)
+	{
+		qsctest_print_safe("Failure! rcs_authenticated_kat: RCS-512 output does not match the known answer -RT2 \n");
+		status = false;
+	}
+
+	return status;
+}
+#endif
+
 #if defined(QSCTEST_RCS_WIDE_BLOCK_TESTS)
 bool qsctest_rcs_wide_equality()
 {
@@ -663,6 +735,17 @@ void qsctest_rcs_run()
 		qsctest_print_safe("Failure! Failed the RCS extended transform test. \n");
 	}
 
+#if defined(QSC_RCS_AUTHENTICATED)
+	if (qsctest_rcs_authenticated_kat() == true)
+	{
+		qsctest_print_safe("Success! Passed the RCS multi-call authenticated transform known answer test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the RCS multi-call authenticated transform known answer test. \n");
+	}
+#endif
+
 #if defined(QSCTEST_RCS_WIDE_BLOCK_TESTS)
 	if (qsctest_rcs_wide_equality() == true)
 	{
@@ -68,6 +68,16 @@ bool qsctest_rcs512_stress_test(void);
 */
 bool qsctest_extended_cipher_test(void);
 
+#if defined(QSC_RCS_AUTHENTICATED)
+/**
+* \brief Tests the authenticated transform against known answers, using
+* messages split across multiple transform calls.
+*
+* \return Returns true for success
+*/
+bool qsctest_rcs_authenticated_kat(void);
+#endif
+
 #if defined(QSCTEST_RCS_WIDE_BLOCK_TESTS)
 /**
 * \brief Tests the RCS AVX functions for equal output to sequential processing.
@@ -1,6 +1,8 @@
 #include "sha2_test.h"
 #include "testutils.h"
+#include "../QSC/csp.h"
 #include "../QSC/intutils.h"
+#include "../QSC/memutils.h"
 #include "../QSC/sha2.h"
 #include <stdio.h>
 
@@ -408,6 +410,226 @@ bool qsctest_hmac_512_kat()
 	return status;
 }
 
+bool qsctest_hmac_prepared_equality()
+{
+	uint8_t exp[QSC_HMAC_512_MAC_SIZE] = { 0 };
+	uint8_t otp[QSC_HMAC_512_MAC_SIZE] = { 0 };
+	uint8_t key[QSCTEST_HMAC_PREPARED_KEY] = { 0 };
+	uint8_t msg[QSCTEST_HMAC_PREPARED_MESSAGE] = { 0 };
+	qsc_hmac256_key pkey256;
+	qsc_hmac512_key pkey512;
+	qsc_hmac256_state ctx256;
+	qsc_hmac512_state ctx512;
+	size_t klen;
+	size_t mlen;
+	bool status;
+
+	status = true;
+	qsc_csp_generate(key, sizeof(key));
+	qsc_csp_generate(msg, sizeof(msg));
+
+	for (klen = 0; klen <= sizeof(key) && status == true; klen += 16)
+	{
+		qsc_hmac256_key_prepare(&pkey256, key, klen);
+		qsc_hmac512_key_prepare(&pkey512, key, klen);
+
+		/* one prepared key is reused for every message */
+		for (mlen = 0; mlen <= sizeof(msg); mlen += 71)
+		{
+			qsc_hmac256_compute(exp, msg, mlen, key, klen);
+			qsc_hmac256_compute_prepared(otp, msg, mlen, &pkey256);
+
+			if (qsc_intutils_are_equal8(otp, exp, QSC_HMAC_256_MAC_SIZE) == false)
+			{
+				qsctest_print_safe("Failure! hmac_prepared_equality: HMAC(SHA2-256) output does not match -HP1 \n");
+				status = false;
+				break;
+			}
+
+			qsc_hmac256_initialize_prepared(&ctx256, &pkey256);
+			qsc_hmac256_update(&ctx256, msg, mlen / 2);
+			qsc_hmac256_update(&ctx256, msg + (mlen / 2), mlen - (mlen / 2));
+			qsc_hmac256_finalize(&ctx256, otp);
+
+			if (qsc_intutils_are_equal8(otp, exp, QSC_HMAC_256_MAC_SIZE) == false)
+			{
+				qsctest_print_safe("Failure! hmac_prepared_equality: HMAC(SHA2-256) long form output does not match -HP2 \n");
+				status = false;
+				break;
+			}
+
+			qsc_hmac512_compute(exp, msg, mlen, key, klen);
+			qsc_hmac512_compute_prepared(otp, msg, mlen, &pkey512);
+
+			if (qsc_intutils_are_equal8(otp, exp, QSC_HMAC_512_MAC_SIZE) == false)
+			{
+				qsctest_print_safe("Failure! hmac_prepared_equality: HMAC(SHA2-512) output does not match -HP3 \n");
+				status = false;
+				break;
+			}
+
+			qsc_hmac512_initialize_prepared(&ctx512, &pkey512);
+			qsc_hmac512_update(&ctx512, msg, mlen / 2);
+			qsc_hmac512_update(&ctx512, msg + (mlen / 2), mlen - (mlen / 2));
+			qsc_hmac512_finalize(&ctx512, otp);
+
+			if (qsc_intutils_are_equal8(otp, exp, QSC_HMAC_512_MAC_SIZE) == false)
+			{
+				qsctest_print_safe("Failure! hmac_prepared_equality: HMAC(SHA2-512) long form output does not match -HP4 \n");
+				status = false;
+				break;
+			}
+		}
+
+		qsc_hmac256_key_dispose(&pkey256);
+		qsc_hmac512_key_dispose(&pkey512);
+	}
+
+	return status;
+}
+
+bool qsctest_hmac256_verify_batch()
+{
+	qsc_hmac_verify_item items[QSCTEST_HMAC_VERIFY_COUNT] = { 0 };
+	uint8_t bitmap[(QSCTEST_HMAC_VERIFY_COUNT + 7) / 8] = { 0 };
+	uint8_t code[QSCTEST_HMAC_VERIFY_COUNT][QSC_HMAC_256_MAC_SIZE] = { 0 };
+	uint8_t key[QSCTEST_HMAC_VERIFY_COUNT][QSCTEST_HMAC_VERIFY_KEY] = { 0 };
+	uint8_t msg[QSCTEST_HMAC_VERIFY_MESSAGE] = { 0 };
+	size_t i;
+	size_t mlen;
+	uint8_t exp;
+	bool status;
+
+	qsc_csp_generate(msg, sizeof(msg));
+	qsc_csp_generate((uint8_t*)key, sizeof(key));
+	status = true;
+
+	/* every item has its own key and message length */
+	for (i = 0; i < QSCTEST_HMAC_VERIFY_COUNT; ++i)
+	{
+		mlen = (i * 97) % sizeof(msg);
+		qsc_hmac256_compute(code[i], msg, mlen, key[i], 1 + (i * 13) % QSCTEST_HMAC_VERIFY_KEY);
+		items[i].code = code[i];
+		items[i].message = msg;
+		items[i].key = key[i];
+		items[i].msglen = mlen;
+		items[i].keylen = 1 + (i * 13) % QSCTEST_HMAC_VERIFY_KEY;
+	}
+
+	if (qsc_hmac256_verify_batch(bitmap, items, QSCTEST_HMAC_VERIFY_COUNT) == false)
+	{
+		qsctest_print_safe("Failure! hmac256_verify_batch: valid codes failed verification -HV1 \n");
+		status = false;
+	}
+
+	for (i = 0; i < QSCTEST_HMAC_VERIFY_COUNT; ++i)
+	{
+		if (((bitmap[i / 8] >> (i % 8)) & 1U) != 1U)
+		{
+			qsctest_print_safe("Failure! hmac256_verify_batch: the bitmap is incorrect -HV2 \n");
+			status = false;
+			break;
+		}
+	}
+
+	/* alter every third code */
+	for (i = 0; i < QSCTEST_HMAC_VERIFY_COUNT; i += 3)
+	{
+		code[i][i % QSC_HMAC_256_MAC_SIZE] ^= 0x01U;
+	}
+
+	if (qsc_hmac256_verify_batch(bitmap, items, QSCTEST_HMAC_VERIFY_COUNT) == true)
+	{
+		qsctest_print_safe("Failure! hmac256_verify_batch: altered codes passed verification -HV3 \n");
+		status = false;
+	}
+
+	for (i = 0; i < QSCTEST_HMAC_VERIFY_COUNT; ++i)
+	{
+		exp = (i % 3 == 0) ? 0U : 1U;
+
+		if (((bitmap[i / 8] >> (i % 8)) & 1U) != exp)
+		{
+			qsctest_print_safe("Failure! hmac256_verify_batch: the bitmap is incorrect -HV4 \n");
+			status = false;
+			break;
+		}
+	}
+
+	return status;
+}
+
+bool qsctest_hmac512_verify_batch()
+{
+	qsc_hmac_verify_item items[QSCTEST_HMAC_VERIFY_COUNT] = { 0 };
+	uint8_t bitmap[(QSCTEST_HMAC_VERIFY_COUNT + 7) / 8] = { 0 };
+	uint8_t code[QSCTEST_HMAC_VERIFY_COUNT][QSC_HMAC_512_MAC_SIZE] = { 0 };
+	uint8_t key[QSCTEST_HMAC_VERIFY_COUNT][QSCTEST_HMAC_VERIFY_KEY] = { 0 };
+	uint8_t msg[QSCTEST_HMAC_VERIFY_MESSAGE] = { 0 };
+	size_t i;
+	size_t mlen;
+	uint8_t exp;
+	bool status;
+
+	qsc_csp_generate(msg, sizeof(msg));
+	qsc_csp_generate((uint8_t*)key, sizeof(key));
+	status = true;
+
+	/* every item has its own key and message length */
+	for (i = 0; i < QSCTEST_HMAC_VERIFY_COUNT; ++i)
+	{
+		mlen = (i * 97) % sizeof(msg);
+		qsc_hmac512_compute(code[i], msg, mlen, key[i], 1 + (i * 13) % QSCTEST_HMAC_VERIFY_KEY);
+		items[i].code = code[i];
+		items[i].message = msg;
+		items[i].key = key[i];
+		items[i].msglen = mlen;
+		items[i].keylen = 1 + (i * 13) % QSCTEST_HMAC_VERIFY_KEY;
+	}
+
+	if (qsc_hmac512_verify_batch(bitmap, items, QSCTEST_HMAC_VERIFY_COUNT) == false)
+	{
+		qsctest_print_safe("Failure! hmac512_verify_batch: valid codes failed verification -HW1 \n");
+		status = false;
+	}
+
+	for (i = 0; i < QSCTEST_HMAC_VERIFY_COUNT; ++i)
+	{
+		if (((bitmap[i / 8] >> (i % 8)) & 1U) != 1U)
+		{
+			qsctest_print_safe("Failure! hmac512_verify_batch: the bitmap is incorrect -HW2 \n");
+			status = false;
+			break;
+		}
+	}
+
+	/* alter every third code */
+	for (i = 0; i < QSCTEST_HMAC_VERIFY_COUNT; i += 3)
+	{
+		code[i][i % QSC_HMAC_512_MAC_SIZE] ^= 0x01U;
+	}
+
+	if (qsc_hmac512_verify_batch(bitmap, items, QSCTEST_HMAC_VERIFY_COUNT) == true)
+	{
+		qsctest_print_safe("Failure! hmac512_verify_batch: altered codes passed verification -HW3 \n");
+		status = false;
+	}
+
+	for (i = 0; i < QSCTEST_HMAC_VERIFY_COUNT; ++i)
+	{
+		exp = (i % 3 == 0) ? 0U : 1U;
+
+		if (((bitmap[i / 8] >> (i % 8)) & 1U) != exp)
+		{
+			qsctest_print_safe("Failure! hmac512_verify_batch: the bitmap is incorrect -HW4 \n");
+			status = false;
+			break;
+		}
+	}
+
+	return status;
+}
+
 bool qsctest_sha2_256_kat()
 {
 	uint8_t exp0[QSC_SHA2_256_HASH_SIZE] = { 0 };
@@ -769,6 +991,162 @@ bool qsctest_sha2_512_kat()
 	return status;
 }
 
+bool qsctest_sha2_512_blocks_equality()
+{
+	uint8_t exp[QSC_SHA2_512_HASH_SIZE] = { 0 };
+	uint8_t otp[QSC_SHA2_512_HASH_SIZE] = { 0 };
+	uint8_t msg[QSCTEST_SHA512_BLOCKS_MESSAGE] = { 0 };
+	qsc_sha384_state ctx384;
+	qsc_sha512_state ctx512;
+	size_t i;
+	size_t mlen;
+	size_t pos;
+	bool status;
+
+	status = true;
+	qsc_csp_generate(msg, sizeof(msg));
+
+	/* odd and even block counts, with and without a partial block */
+	for (mlen = 0; mlen <= sizeof(msg); mlen += 67)
+	{
+		qsc_sha512_compute(exp, msg, mlen);
+		qsc_sha512_initialize(&ctx512);
+		pos = 0;
+
+		for (i = 1; pos < mlen; ++i)
+		{
+			const size_t ULEN = qsc_intutils_min(i % 29, mlen - pos);
+
+			qsc_sha512_update(&ctx512, msg + pos, ULEN);
+			pos += ULEN;
+		}
+
+		qsc_sha512_finalize(&ctx512, otp);
+
+		if (qsc_intutils_are_equal8(otp, exp, QSC_SHA2_512_HASH_SIZE) == false)
+		{
+			qsctest_print_safe("Failure! sha2_512_blocks_equality: SHA2-512 output does not match -SB1 \n");
+			status = false;
+			break;
+		}
+
+		qsc_sha384_compute(exp, msg, mlen);
+		qsc_sha384_initialize(&ctx384);
+		pos = 0;
+
+		for (i = 1; pos < mlen; ++i)
+		{
+			const size_t ULEN = qsc_intutils_min(i % 29, mlen - pos);
+
+			qsc_sha384_update(&ctx384, msg + pos, ULEN);
+			pos += ULEN;
+		}
+
+		qsc_sha384_finalize(&ctx384, otp);
+
+		if (qsc_intutils_are_equal8(otp, exp, QSC_SHA2_384_HASH_SIZE) == false)
+		{
+			qsctest_print_safe("Failure! sha2_512_blocks_equality: SHA2-384 output does not match -SB2 \n");
+			status = false;
+			break;
+		}
+	}
+
+	return status;
+}
+
+bool qsctest_sha256_jobs_equality()
+{
+	uint8_t exp[QSCTEST_SHA256_JOB_COUNT][QSC_SHA2_256_HASH_SIZE] = { 0 };
+	uint8_t key[2 * QSC_SHA2_256_RATE] = { 0 };
+	uint8_t otp[QSCTEST_SHA256_JOB_COUNT][QSC_SHA2_256_HASH_SIZE] = { 0 };
+	uint8_t rnd[sizeof(uint16_t)] = { 0 };
+	qsc_sha256_job jobs[QSCTEST_SHA256_JOB_COUNT];
+	qsc_sha256_job queue[7];
+	qsc_sha256_job_manager mgr;
+	uint8_t* msg;
+	size_t i;
+	bool status;
+
+	status = true;
+	msg = (uint8_t*)qsc_memutils_malloc(QSCTEST_SHA256_JOB_COUNT * QSCTEST_SHA256_JOB_MESSAGE);
+
+	if (msg != NULL)
+	{
+		qsc_csp_generate(msg, QSCTEST_SHA256_JOB_COUNT * QSCTEST_SHA256_JOB_MESSAGE);
+		qsc_csp_generate(key, sizeof(key));
+
+		/* random functions, and message and key sizes */
+		for (i = 0; i < QSCTEST_SHA256_JOB_COUNT; ++i)
+		{
+			qsc_csp_generate(rnd, sizeof(rnd));
+			jobs[i].function = (qsc_sha256_job_function)(i % 2);
+			jobs[i].message = msg + (i * QSCTEST_SHA256_JOB_MESSAGE);
+			jobs[i].msglen = (size_t)qsc_intutils_le8to16(rnd) % QSCTEST_SHA256_JOB_MESSAGE;
+			jobs[i].output = otp[i];
+			jobs[i].key = key;
+			jobs[i].keylen = 1 + (i % QSC_SHA2_256_RATE);
+		}
+
+		/* empty messages, the padding block boundaries, and keys longer than the block */
+		jobs[0].msglen = 0;
+		jobs[1].msglen = 0;
+		jobs[2].msglen = 55;
+		jobs[3].msglen = 55;
+		jobs[4].msglen = 56;
+		jobs[5].msglen = 56;
+		jobs[6].msglen = QSC_SHA2_256_RATE;
+		jobs[7].msglen = QSC_SHA2_256_RATE - 1;
+		jobs[9].keylen = sizeof(key);
+		jobs[11].keylen = QSC_SHA2_256_RATE + 1;
+
+		for (i = 0; i < QSCTEST_SHA256_JOB_COUNT; ++i)
+		{
+			if (jobs[i].function == qsc_sha256_job_hmac256)
+			{
+				qsc_hmac256_compute(exp[i], jobs[i].message, jobs[i].msglen, key, jobs[i].keylen);
+			}
+			else
+			{
+				qsc_sha256_compute(exp[i], jobs[i].message, jobs[i].msglen);
+			}
+		}
+
+		qsc_sha256_jobs_compute(jobs, QSCTEST_SHA256_JOB_COUNT);
+
+		if (qsc_intutils_are_equal8((uint8_t*)otp, (uint8_t*)exp, sizeof(otp)) == false)
+		{
+			qsctest_print_safe("Failure! sha256_jobs_equality: output does not match the sequential functions -SJ1 \n");
+			status = false;
+		}
+
+		/* submit the same jobs through a manager with a short queue */
+		qsc_memutils_clear((uint8_t*)otp, sizeof(otp));
+		qsc_sha256_jobs_initialize(&mgr, queue, sizeof(queue) / sizeof(qsc_sha256_job));
+
+		for (i = 0; i < QSCTEST_SHA256_JOB_COUNT; ++i)
+		{
+			qsc_sha256_jobs_submit(&mgr, &jobs[i]);
+		}
+
+		qsc_sha256_jobs_flush(&mgr);
+
+		if (qsc_intutils_are_equal8((uint8_t*)otp, (uint8_t*)exp, sizeof(otp)) == false)
+		{
+			qsctest_print_safe("Failure! sha256_jobs_equality: managed output does not match the sequential functions -SJ2 \n");
+			status = false;
+		}
+
+		qsc_memutils_alloc_free(msg);
+	}
+	else
+	{
+		status = false;
+	}
+
+	return status;
+}
+
 void qsctest_sha2_run()
 {
 	if (qsctest_sha2_256_kat() == true)
@@ -798,6 +1176,15 @@ void qsctest_sha2_run()
 		qsctest_print_safe("Failure! Failed the SHA2-512 KAT test. \n");
 	}
 
+	if (qsctest_sha2_512_blocks_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the SHA2-384 and SHA2-512 multi-block equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the SHA2-384 and SHA2-512 multi-block equality test. \n");
+	}
+
 	if (qsctest_hkdf_256_kat() == true)
 	{
 		qsctest_print_safe("Success! Passed the HKDF-Expand(HMAC(SHA2-256)) KAT test. \n");
@@ -833,4 +1220,40 @@ void qsctest_sha2_run()
 	{
 		qsctest_print_safe("Failure! Failed the HMAC(SHA2-512) KAT test. \n");
 	}
+
+	if (qsctest_hmac_prepared_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the HMAC(SHA2-256) and HMAC(SHA2-512) prepared key equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the HMAC(SHA2-256) and HMAC(SHA2-512) prepared key equality test. \n");
+	}
+
+	if (qsctest_hmac256_verify_batch() == true)
+	{
+		qsctest_print_safe("Success! Passed the HMAC(SHA2-256) batch verification test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the HMAC(SHA2-256) batch verification test. \n");
+	}
+
+	if (qsctest_hmac512_verify_batch() == true)
+	{
+		qsctest_print_safe("Success! Passed the HMAC(SHA2-512) batch verification test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the HMAC(SHA2-512) batch verification test. \n");
+	}
+
+	if (qsctest_sha256_jobs_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the multi-buffer SHA2-256 and HMAC(SHA2-256) equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the multi-buffer SHA2-256 and HMAC(SHA2-256) equality test. \n");
+	}
 }
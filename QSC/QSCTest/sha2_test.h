@@ -12,6 +12,15 @@
 
 #include "common.h"
 
+#define QSCTEST_SHA256_JOB_COUNT 53
+#define QSCTEST_SHA256_JOB_MESSAGE 1024
+#define QSCTEST_SHA512_BLOCKS_MESSAGE 2048
+#define QSCTEST_HMAC_PREPARED_KEY 300
+#define QSCTEST_HMAC_PREPARED_MESSAGE 600
+#define QSCTEST_HMAC_VERIFY_COUNT 37
+#define QSCTEST_HMAC_VERIFY_KEY 160
+#define QSCTEST_HMAC_VERIFY_MESSAGE 700
+
 /**
 * \brief Tests the 256-bit version of the HFDF-Expand(HMAC(SHA2-256)) key derivation function for correct operation,
 * using vectors from the official KAT file.
@@ -60,6 +69,30 @@ bool qsctest_hmac_256_kat(void);
 */
 bool qsctest_hmac_512_kat(void);
 
+/**
+* \brief Tests HMAC(SHA2-256) and HMAC(SHA2-512) with prepared keys for equality with the keyed functions.
+* Uses key lengths shorter than, equal to, and longer than the hash rate, and reuses each prepared key for several messages.
+*
+* \return Returns true for success
+*/
+bool qsctest_hmac_prepared_equality(void);
+
+/**
+* \brief Tests the HMAC(SHA2-256) batch verification, using a distinct key and key length for every item.
+* The bitmap must flag exactly the items with altered codes.
+*
+* \return Returns true for success
+*/
+bool qsctest_hmac256_verify_batch(void);
+
+/**
+* \brief Tests the HMAC(SHA2-512) batch verification, using a distinct key and key length for every item.
+* The bitmap must flag exactly the items with altered codes.
+*
+* \return Returns true for success
+*/
+bool qsctest_hmac512_verify_batch(void);
+
 /**
 * \brief Tests the 256-bit version of the SHA2 message digest for correct operation,
 * using selected vectors from the NIST SHA2 official KAT file.
@@ -93,6 +126,22 @@ bool qsctest_sha2_384_kat(void);
 */
 bool qsctest_sha2_512_kat(void);
 
+/**
+* \brief Tests the multi-block SHA2-384 and SHA2-512 update path for equality with block-at-a-time processing.
+* Hashes random messages with a single update call, and with small updates that are processed one block at a time.
+*
+* \return Returns true for success
+*/
+bool qsctest_sha2_512_blocks_equality(void);
+
+/**
+* \brief Tests the multi-buffer SHA2-256 job engine for equality with the sequential SHA2-256 and HMAC(SHA2-256) functions.
+* Computes a set of jobs with mixed functions, and message and key lengths, directly and through a job manager.
+*
+* \return Returns true for success
+*/
+bool qsctest_sha256_jobs_equality(void);
+
 /**
 * \brief Run all tests.
 */
@@ -1,6 +1,8 @@
 #include "sha3_test.h"
 #include "testutils.h"
+#include "../QSC/csp.h"
 #include "../QSC/intutils.h"
+#include "../QSC/memutils.h"
 #include "../QSC/sha3.h"
 
 bool qsctest_sha3_256_kat()
@@ -952,6 +954,69 @@ bool qsctest_kmac_512_kat()
 	return status;
 }
 
+bool qsctest_kmac_prepared_equality()
+{
+	const qsc_keccak_rate rates[3] = { qsc_keccak_rate_128, qsc_keccak_rate_256, qsc_keccak_rate_512 };
+	uint8_t cust[QSCTEST_KMAC_PREPARED_CUSTOM] = { 0 };
+	uint8_t exp[QSCTEST_KMAC_PREPARED_OUTPUT] = { 0 };
+	uint8_t otp[QSCTEST_KMAC_PREPARED_OUTPUT] = { 0 };
+	uint8_t key[QSCTEST_KMAC_PREPARED_KEY] = { 0 };
+	uint8_t msg[QSCTEST_KMAC_PREPARED_MESSAGE] = { 0 };
+	qsc_keccak_state ctx;
+	qsc_kmac_key pkey;
+	size_t clen;
+	size_t i;
+	size_t klen;
+	size_t mlen;
+	bool status;
+
+	status = true;
+	qsc_csp_generate(cust, sizeof(cust));
+	qsc_csp_generate(key, sizeof(key));
+	qsc_csp_generate(msg, sizeof(msg));
+
+	for (i = 0; i < sizeof(rates) / sizeof(rates[0]) && status == true; ++i)
+	{
+		for (klen = 16, clen = 0; klen <= sizeof(key) && status == true; klen += 37, clen = (clen + 53) % sizeof(cust))
+		{
+			qsc_kmac_key_prepare(&pkey, rates[i], key, klen, cust, clen);
+
+			/* one prepared key is reused for every message */
+			for (mlen = 0; mlen <= sizeof(msg); mlen += 97)
+			{
+				qsc_kmac_initialize(&ctx, rates[i], key, klen, cust, clen);
+				qsc_kmac_update(&ctx, rates[i], msg, mlen);
+				qsc_kmac_finalize(&ctx, rates[i], exp, sizeof(exp));
+
+				qsc_kmac_compute_prepared(otp, sizeof(otp), msg, mlen, &pkey);
+
+				if (qsc_intutils_are_equal8(otp, exp, sizeof(exp)) == false)
+				{
+					qsctest_print_safe("Failure! kmac_prepared_equality: output does not match -KP1 \n");
+					status = false;
+					break;
+				}
+
+				qsc_kmac_initialize_prepared(&ctx, &pkey);
+				qsc_kmac_update(&ctx, rates[i], msg, mlen / 3);
+				qsc_kmac_update(&ctx, rates[i], msg + (mlen / 3), mlen - (mlen / 3));
+				qsc_kmac_finalize(&ctx, rates[i], otp, sizeof(otp));
+
+				if (qsc_intutils_are_equal8(otp, exp, sizeof(exp)) == false)
+				{
+					qsctest_print_safe("Failure! kmac_prepared_equality: long form output does not match -KP2 \n");
+					status = false;
+					break;
+				}
+			}
+
+			qsc_kmac_key_dispose(&pkey);
+		}
+	}
+
+	return status;
+}
+
 bool qsctest_kpa_256_kat()
 {
 	uint8_t cust168[21] = { 0 };
@@ -2183,6 +2248,915 @@ bool qsctest_shake512x8_equality()
 }
 #endif
 
+bool qsctest_keccak_jobs_equality()
+{
+	const qsc_keccak_rate rates[3] = { qsc_keccak_rate_128, qsc_keccak_rate_256, qsc_keccak_rate_512 };
+	uint8_t cust[QSC_KECCAK_128_RATE] = { 0 };
+	uint8_t exp[QSCTEST_KECCAK_JOB_COUNT][QSCTEST_KECCAK_JOB_OUTPUT] = { 0 };
+	uint8_t key[QSC_KECCAK_128_RATE] = { 0 };
+	uint8_t otp[QSCTEST_KECCAK_JOB_COUNT][QSCTEST_KECCAK_JOB_OUTPUT] = { 0 };
+	uint8_t rnd[sizeof(uint16_t)] = { 0 };
+	qsc_keccak_job jobs[QSCTEST_KECCAK_JOB_COUNT];
+	qsc_keccak_job queue[5];
+	qsc_keccak_job_manager mgr;
+	uint8_t* msg;
+	size_t i;
+	bool status;
+
+	status = true;
+	msg = (uint8_t*)qsc_memutils_malloc(QSCTEST_KECCAK_JOB_COUNT * QSCTEST_KECCAK_JOB_MESSAGE);
+
+	if (msg != NULL)
+	{
+		qsc_csp_generate(msg, QSCTEST_KECCAK_JOB_COUNT * QSCTEST_KECCAK_JOB_MESSAGE);
+		qsc_csp_generate(key, sizeof(key));
+		qsc_csp_generate(cust, sizeof(cust));
+
+		/* random functions, rates, and message and output sizes */
+		for (i = 0; i < QSCTEST_KECCAK_JOB_COUNT; ++i)
+		{
+			qsc_csp_generate(rnd, sizeof(rnd));
+			jobs[i].function = (qsc_keccak_job_function)(i % 3);
+			jobs[i].rate = rates[(i / 3) % 3];
+			jobs[i].message = msg + (i * QSCTEST_KECCAK_JOB_MESSAGE);
+			jobs[i].msglen = (size_t)qsc_intutils_le8to16(rnd) % QSCTEST_KECCAK_JOB_MESSAGE;
+			jobs[i].output = otp[i];
+			jobs[i].otplen = 1 + (size_t)rnd[0] % (QSCTEST_KECCAK_JOB_OUTPUT - 1);
+			jobs[i].key = key;
+			jobs[i].keylen = 16 + (i % 48);
+			jobs[i].custom = cust;
+			jobs[i].custlen = i % 24;
+		}
+
+		/* empty messages, a message filling the last block, and a long key and customization string */
+		jobs[0].msglen = 0;
+		jobs[1].msglen = 0;
+		jobs[2].msglen = 0;
+		jobs[5].msglen = (size_t)jobs[5].rate - 2;
+		jobs[8].msglen = (2 * (size_t)jobs[8].rate) - 1;
+		jobs[11].keylen = sizeof(key);
+		jobs[14].custlen = sizeof(cust);
+
+		for (i = 0; i < QSCTEST_KECCAK_JOB_COUNT; ++i)
+		{
+			if (jobs[i].function == qsc_keccak_job_kmac)
+			{
+				if (jobs[i].rate == qsc_keccak_rate_128)
+				{
+					qsc_kmac128_compute(exp[i], jobs[i].otplen, jobs[i].message, jobs[i].msglen, key, jobs[i].keylen, cust, jobs[i].custlen);
+				}
+				else if (jobs[i].rate == qsc_keccak_rate_256)
+				{
+					qsc_kmac256_compute(exp[i], jobs[i].otplen, jobs[i].message, jobs[i].msglen, key, jobs[i].keylen, cust, jobs[i].custlen);
+				}
+				else
+				{
+					qsc_kmac512_compute(exp[i], jobs[i].otplen, jobs[i].message, jobs[i].msglen, key, jobs[i].keylen, cust, jobs[i].custlen);
+				}
+			}
+			else if (jobs[i].function == qsc_keccak_job_shake)
+			{
+				if (jobs[i].rate == qsc_keccak_rate_128)
+				{
+					qsc_shake128_compute(exp[i], jobs[i].otplen, jobs[i].message, jobs[i].msglen);
+				}
+				else if (jobs[i].rate == qsc_keccak_rate_256)
+				{
+					qsc_shake256_compute(exp[i], jobs[i].otplen, jobs[i].message, jobs[i].msglen);
+				}
+				else
+				{
+					qsc_shake512_compute(exp[i], jobs[i].otplen, jobs[i].message, jobs[i].msglen);
+				}
+			}
+			else
+			{
+				if (jobs[i].rate == qsc_keccak_rate_128)
+				{
+					qsc_sha3_compute128(exp[i], jobs[i].message, jobs[i].msglen);
+				}
+				else if (jobs[i].rate == qsc_keccak_rate_256)
+				{
+					qsc_sha3_compute256(exp[i], jobs[i].message, jobs[i].msglen);
+				}
+				else
+				{
+					qsc_sha3_compute512(exp[i], jobs[i].message, jobs[i].msglen);
+				}
+			}
+		}
+
+		qsc_keccak_jobs_compute(jobs, QSCTEST_KECCAK_JOB_COUNT);
+
+		if (qsc_intutils_are_equal8((uint8_t*)otp, (uint8_t*)exp, sizeof(otp)) == false)
+		{
+			qsctest_print_safe("Failure! keccak_jobs_equality: output does not match the sequential functions -KJ1 \n");
+			status = false;
+		}
+
+		/* submit the same jobs through a manager with a short queue */
+		qsc_memutils_clear((uint8_t*)otp, sizeof(otp));
+		qsc_keccak_jobs_initialize(&mgr, queue, sizeof(queue) / sizeof(qsc_keccak_job));
+
+		for (i = 0; i < QSCTEST_KECCAK_JOB_COUNT; ++i)
+		{
+			qsc_keccak_jobs_submit(&mgr, &jobs[i]);
+		}
+
+		qsc_keccak_jobs_flush(&mgr);
+
+		if (qsc_intutils_are_equal8((uint8_t*)otp, (uint8_t*)exp, sizeof(otp)) == false)
+		{
+			qsctest_print_safe("Failure! keccak_jobs_equality: managed output does not match the sequential functions -KJ2 \n");
+			status = false;
+		}
+
+		qsc_memutils_alloc_free(msg);
+	}
+	else
+	{
+		status = false;
+	}
+
+	return status;
+}
+
+bool qsctest_keccakx4_incremental_equality()
+{
+	const qsc_keccak_rate rates[3] = { qsc_keccak_rate_128, qsc_keccak_rate_256, qsc_keccak_rate_512 };
+	uint8_t exp[4][QSCTEST_KECCAK_INCREMENTAL_OUTPUT] = { 0 };
+	uint8_t msg[4][QSCTEST_KECCAK_INCREMENTAL_MESSAGE] = { 0 };
+	uint8_t otp[4][QSCTEST_KECCAK_INCREMENTAL_OUTPUT] = { 0 };
+	uint8_t rnd[2] = { 0 };
+	qsc_keccakx4_state ctx;
+	size_t blen;
+	size_t i;
+	size_t j;
+	size_t mlen;
+	size_t pos;
+	bool status;
+
+	status = true;
+
+	for (i = 0; i < QSCTEST_KECCAK_INCREMENTAL_CYCLES; ++i)
+	{
+		qsc_csp_generate((uint8_t*)msg, sizeof(msg));
+		qsc_csp_generate(rnd, sizeof(rnd));
+		mlen = (size_t)qsc_intutils_le8to16(rnd) % QSCTEST_KECCAK_INCREMENTAL_MESSAGE;
+		qsc_keccakx4_initialize(&ctx, rates[i % 3]);
+
+		/* absorb the messages in random segments */
+		for (pos = 0; pos < mlen; pos += blen)
+		{
+			qsc_csp_generate(rnd, 1);
+			blen = qsc_intutils_min((size_t)rnd[0], mlen - pos);
+			qsc_keccakx4_update(&ctx, msg[0] + pos, msg[1] + pos, msg[2] + pos, msg[3] + pos, blen);
+		}
+
+		qsc_keccakx4_finalize(&ctx, QSC_KECCAK_SHAKE_DOMAIN_ID);
+
+		/* squeeze the output in random segments */
+		for (pos = 0; pos < QSCTEST_KECCAK_INCREMENTAL_OUTPUT; pos += blen)
+		{
+			qsc_csp_generate(rnd, 1);
+			blen = qsc_intutils_min((size_t)rnd[0], QSCTEST_KECCAK_INCREMENTAL_OUTPUT - pos);
+			qsc_keccakx4_squeeze(&ctx, otp[0] + pos, otp[1] + pos, otp[2] + pos, otp[3] + pos, blen);
+		}
+
+		qsc_keccakx4_dispose(&ctx);
+
+		for (j = 0; j < 4; ++j)
+		{
+			if (rates[i % 3] == qsc_keccak_rate_128)
+			{
+				qsc_shake128_compute(exp[j], QSCTEST_KECCAK_INCREMENTAL_OUTPUT, msg[j], mlen);
+			}
+			else if (rates[i % 3] == qsc_keccak_rate_256)
+			{
+				qsc_shake256_compute(exp[j], QSCTEST_KECCAK_INCREMENTAL_OUTPUT, msg[j], mlen);
+			}
+			else
+			{
+				qsc_shake512_compute(exp[j], QSCTEST_KECCAK_INCREMENTAL_OUTPUT, msg[j], mlen);
+			}
+		}
+
+		if (qsc_intutils_are_equal8((uint8_t*)otp, (uint8_t*)exp, sizeof(otp)) == false)
+		{
+			qsctest_print_safe("Failure! keccakx4_incremental_equality: output does not match the sequential function -KI1 \n");
+			status = false;
+			break;
+		}
+	}
+
+	return status;
+}
+
+bool qsctest_keccakx8_incremental_equality()
+{
+	const qsc_keccak_rate rates[3] = { qsc_keccak_rate_128, qsc_keccak_rate_256, qsc_keccak_rate_512 };
+	uint8_t exp[8][QSCTEST_KECCAK_INCREMENTAL_OUTPUT] = { 0 };
+	uint8_t msg[8][QSCTEST_KECCAK_INCREMENTAL_MESSAGE] = { 0 };
+	uint8_t otp[8][QSCTEST_KECCAK_INCREMENTAL_OUTPUT] = { 0 };
+	uint8_t rnd[2] = { 0 };
+	qsc_keccakx8_state ctx;
+	size_t blen;
+	size_t i;
+	size_t j;
+	size_t mlen;
+	size_t pos;
+	bool status;
+
+	status = true;
+
+	for (i = 0; i < QSCTEST_KECCAK_INCREMENTAL_CYCLES; ++i)
+	{
+		qsc_csp_generate((uint8_t*)msg, sizeof(msg));
+		qsc_csp_generate(rnd, sizeof(rnd));
+		mlen = (size_t)qsc_intutils_le8to16(rnd) % QSCTEST_KECCAK_INCREMENTAL_MESSAGE;
+		qsc_keccakx8_initialize(&ctx, rates[i % 3]);
+
+		/* absorb the messages in random segments */
+		for (pos = 0; pos < mlen; pos += blen)
+		{
+			qsc_csp_generate(rnd, 1);
+			blen = qsc_intutils_min((size_t)rnd[0], mlen - pos);
+			qsc_keccakx8_update(&ctx, msg[0] + pos, msg[1] + pos, msg[2] + pos, msg[3] + pos,
+				msg[4] + pos, msg[5] + pos, msg[6] + pos, msg[7] + pos, blen);
+		}
+
+		qsc_keccakx8_finalize(&ctx, QSC_KECCAK_SHA3_DOMAIN_ID);
+
+		/* squeeze the output in random segments */
+		for (pos = 0; pos < QSCTEST_KECCAK_INCREMENTAL_OUTPUT; pos += blen)
+		{
+			qsc_csp_generate(rnd, 1);
+			blen = qsc_intutils_min((size_t)rnd[0], QSCTEST_KECCAK_INCREMENTAL_OUTPUT - pos);
+			qsc_keccakx8_squeeze(&ctx, otp[0] + pos, otp[1] + pos, otp[2] + pos, otp[3] + pos,
+				otp[4] + pos, otp[5] + pos, otp[6] + pos, otp[7] + pos, blen);
+		}
+
+		qsc_keccakx8_dispose(&ctx);
+
+		/* the first block of a SHA3 domain output is the message digest */
+		for (j = 0; j < 8; ++j)
+		{
+			if (rates[i % 3] == qsc_keccak_rate_128)
+			{
+				qsc_sha3_compute128(exp[j], msg[j], mlen);
+			}
+			else if (rates[i % 3] == qsc_keccak_rate_256)
+			{
+				qsc_sha3_compute256(exp[j], msg[j], mlen);
+			}
+			else
+			{
+				qsc_sha3_compute512(exp[j], msg[j], mlen);
+			}
+
+			if (qsc_intutils_are_equal8(otp[j], exp[j], (QSC_KECCAK_STATE_BYTE_SIZE - (size_t)rates[i % 3]) / 2) == false)
+			{
+				qsctest_print_safe("Failure! keccakx8_incremental_equality: output does not match the sequential function -KI1 \n");
+				status = false;
+				break;
+			}
+		}
+
+		if (status == false)
+		{
+			break;
+		}
+	}
+
+	return status;
+}
+
+static void kangarootwelve_pattern(uint8_t* output, size_t length)
+{
+	/* the RFC 9861 test message pattern; repeating bytes 0x00 to 0xFA */
+	for (size_t i = 0; i < length; ++i)
+	{
+		output[i] = (uint8_t)(i % 251);
+	}
+}
+
+bool qsctest_keccak_fixed_equality()
+{
+	uint8_t exp[8 * QSC_KECCAK_256_RATE] = { 0 };
+	uint8_t otp[8 * QSC_KECCAK_256_RATE] = { 0 };
+	uint8_t inp[16 * QSC_KECCAK_NODE_SIZE] = { 0 };
+	uint8_t kin[2 * QSC_KECCAK_NODE_SIZE] = { 0 };
+	size_t i;
+	size_t j;
+	size_t olen;
+	bool status;
+
+	status = true;
+
+	for (i = 0; i < QSCTEST_KECCAK_FIXED_CYCLES && status == true; ++i)
+	{
+		qsc_csp_generate(inp, sizeof(inp));
+		qsc_csp_generate(kin, QSC_KECCAK_NODE_SIZE);
+
+		/* SHA3-256 node hashes */
+		for (j = 0; j < 8; ++j)
+		{
+			qsc_sha3_compute256(exp + (j * QSC_SHA3_256_HASH_SIZE), inp + (j * 2 * QSC_KECCAK_NODE_SIZE), 2 * QSC_KECCAK_NODE_SIZE);
+		}
+
+		qsc_sha3_node256(otp, inp);
+
+		if (qsc_intutils_are_equal8(otp, exp, QSC_SHA3_256_HASH_SIZE) == false)
+		{
+			qsctest_print_safe("Failure! keccak_fixed_equality: SHA3-256 node output does not match -KF1 \n");
+			status = false;
+			break;
+		}
+
+		qsc_sha3_node256x4(otp, inp);
+
+		if (qsc_intutils_are_equal8(otp, exp, 4 * QSC_SHA3_256_HASH_SIZE) == false)
+		{
+			qsctest_print_safe("Failure! keccak_fixed_equality: SHA3-256 x4 node output does not match -KF2 \n");
+			status = false;
+			break;
+		}
+
+		qsc_sha3_node256x8(otp, inp);
+
+		if (qsc_intutils_are_equal8(otp, exp, 8 * QSC_SHA3_256_HASH_SIZE) == false)
+		{
+			qsctest_print_safe("Failure! keccak_fixed_equality: SHA3-256 x8 node output does not match -KF3 \n");
+			status = false;
+			break;
+		}
+
+		/* SHAKE-256 node hashes */
+		for (j = 0; j < 8; ++j)
+		{
+			qsc_shake256_compute(exp + (j * QSC_KECCAK_NODE_SIZE), QSC_KECCAK_NODE_SIZE, inp + (j * 2 * QSC_KECCAK_NODE_SIZE), 2 * QSC_KECCAK_NODE_SIZE);
+		}
+
+		qsc_shake256_node(otp, inp);
+
+		if (qsc_intutils_are_equal8(otp, exp, QSC_KECCAK_NODE_SIZE) == false)
+		{
+			qsctest_print_safe("Failure! keccak_fixed_equality: SHAKE-256 node output does not match -KF4 \n");
+			status = false;
+			break;
+		}
+
+		qsc_shake256_nodex4(otp, inp);
+
+		if (qsc_intutils_are_equal8(otp, exp, 4 * QSC_KECCAK_NODE_SIZE) == false)
+		{
+			qsctest_print_safe("Failure! keccak_fixed_equality: SHAKE-256 x4 node output does not match -KF5 \n");
+			status = false;
+			break;
+		}
+
+		qsc_shake256_nodex8(otp, inp);
+
+		if (qsc_intutils_are_equal8(otp, exp, 8 * QSC_KECCAK_NODE_SIZE) == false)
+		{
+			qsctest_print_safe("Failure! keccak_fixed_equality: SHAKE-256 x8 node output does not match -KF6 \n");
+			status = false;
+			break;
+		}
+
+		/* SHAKE-256 PRF, including partial lane output lengths */
+		for (olen = 1; olen <= QSC_KECCAK_256_RATE && status == true; olen += 9)
+		{
+			for (j = 0; j < 8; ++j)
+			{
+				qsc_memutils_copy(kin + QSC_KECCAK_NODE_SIZE, inp + (j * QSC_KECCAK_NODE_SIZE), QSC_KECCAK_NODE_SIZE);
+				qsc_shake256_compute(exp + (j * olen), olen, kin, sizeof(kin));
+			}
+
+			qsc_shake256_prf(otp, olen, kin, inp);
+
+			if (qsc_intutils_are_equal8(otp, exp, olen) == false)
+			{
+				qsctest_print_safe("Failure! keccak_fixed_equality: SHAKE-256 PRF output does not match -KF7 \n");
+				status = false;
+				break;
+			}
+
+			qsc_shake256_prfx4(otp, olen, kin, inp);
+
+			if (qsc_intutils_are_equal8(otp, exp, 4 * olen) == false)
+			{
+				qsctest_print_safe("Failure! keccak_fixed_equality: SHAKE-256 x4 PRF output does not match -KF8 \n");
+				status = false;
+				break;
+			}
+
+			qsc_shake256_prfx8(otp, olen, kin, inp);
+
+			if (qsc_intutils_are_equal8(otp, exp, 8 * olen) == false)
+			{
+				qsctest_print_safe("Failure! keccak_fixed_equality: SHAKE-256 x8 PRF output does not match -KF9 \n");
+				status = false;
+				break;
+			}
+		}
+	}
+
+	return status;
+}
+
+static void cshake_parallel_compute(uint8_t* output, size_t otplen, qsc_keccak_rate rate, const uint8_t* key, size_t keylen,
+	const uint8_t* name, size_t namelen, const uint8_t* custom, size_t custlen)
+{
+	if (rate == qsc_keccak_rate_128)
+	{
+		qsc_cshake128_compute(output, otplen, key, keylen, name, namelen, custom, custlen);
+	}
+	else if (rate == qsc_keccak_rate_256)
+	{
+		qsc_cshake256_compute(output, otplen, key, keylen, name, namelen, custom, custlen);
+	}
+	else
+	{
+		qsc_cshake512_compute(output, otplen, key, keylen, name, namelen, custom, custlen);
+	}
+}
+
+bool qsctest_cshake_parallel_equality()
+{
+	const qsc_keccak_rate rates[3] = { qsc_keccak_rate_128, qsc_keccak_rate_256, qsc_keccak_rate_512 };
+	uint8_t cst[8][QSCTEST_CSHAKE_PARALLEL_INPUT] = { 0 };
+	uint8_t key[8][QSCTEST_CSHAKE_PARALLEL_INPUT] = { 0 };
+	uint8_t nme[8][QSCTEST_CSHAKE_PARALLEL_INPUT] = { 0 };
+	uint8_t exp[QSCTEST_CSHAKE_BATCH_COUNT * QSCTEST_CSHAKE_PARALLEL_OUTPUT] = { 0 };
+	uint8_t otp[QSCTEST_CSHAKE_BATCH_COUNT * QSCTEST_CSHAKE_PARALLEL_OUTPUT] = { 0 };
+	uint8_t bst[QSCTEST_CSHAKE_PARALLEL_INPUT + sizeof(uint32_t)] = { 0 };
+	size_t cstlen;
+	size_t i;
+	size_t j;
+	size_t k;
+	size_t keylen;
+	size_t nmelen;
+	size_t otplen;
+	bool status;
+
+	status = true;
+
+	for (i = 0; i < QSCTEST_CSHAKE_PARALLEL_CYCLES && status == true; ++i)
+	{
+		qsc_csp_generate((uint8_t*)cst, sizeof(cst));
+		qsc_csp_generate((uint8_t*)key, sizeof(key));
+		qsc_csp_generate((uint8_t*)nme, sizeof(nme));
+
+		/* the first cycle has an empty name and customization, and falls back to SHAKE */
+		keylen = 1 + ((i * 61) % QSCTEST_CSHAKE_PARALLEL_INPUT);
+		nmelen = (i * 37) % QSCTEST_CSHAKE_PARALLEL_INPUT;
+		cstlen = (i == 0) ? 0 : (i * 53) % QSCTEST_CSHAKE_PARALLEL_INPUT;
+		otplen = 1 + ((i * 71) % QSCTEST_CSHAKE_PARALLEL_OUTPUT);
+
+		for (k = 0; k < 3 && status == true; ++k)
+		{
+			for (j = 0; j < 8; ++j)
+			{
+				cshake_parallel_compute(exp + (j * otplen), otplen, rates[k], key[j], keylen, nme[j], nmelen, cst[j], cstlen);
+			}
+
+			if (rates[k] == qsc_keccak_rate_128)
+			{
+				qsc_cshake_128x4(otp, otp + otplen, otp + (2 * otplen), otp + (3 * otplen), otplen,
+					key[0], key[1], key[2], key[3], keylen, nme[0], nme[1], nme[2], nme[3], nmelen, cst[0], cst[1], cst[2], cst[3], cstlen);
+			}
+			else if (rates[k] == qsc_keccak_rate_256)
+			{
+				qsc_cshake_256x4(otp, otp + otplen, otp + (2 * otplen), otp + (3 * otplen), otplen,
+					key[0], key[1], key[2], key[3], keylen, nme[0], nme[1], nme[2], nme[3], nmelen, cst[0], cst[1], cst[2], cst[3], cstlen);
+			}
+			else
+			{
+				qsc_cshake_512x4(otp, otp + otplen, otp + (2 * otplen), otp + (3 * otplen), otplen,
+					key[0], key[1], key[2], key[3], keylen, nme[0], nme[1], nme[2], nme[3], nmelen, cst[0], cst[1], cst[2], cst[3], cstlen);
+			}
+
+			if (qsc_intutils_are_equal8(otp, exp, 4 * otplen) == false)
+			{
+				qsctest_print_safe("Failure! cshake_parallel_equality: cSHAKE x4 output does not match -CP1 \n");
+				status = false;
+				break;
+			}
+
+			if (rates[k] == qsc_keccak_rate_128)
+			{
+				qsc_cshake_128x8(otp, otp + otplen, otp + (2 * otplen), otp + (3 * otplen),
+					otp + (4 * otplen), otp + (5 * otplen), otp + (6 * otplen), otp + (7 * otplen), otplen,
+					key[0], key[1], key[2], key[3], key[4], key[5], key[6], key[7], keylen,
+					nme[0], nme[1], nme[2], nme[3], nme[4], nme[5], nme[6], nme[7], nmelen,
+					cst[0], cst[1], cst[2], cst[3], cst[4], cst[5], cst[6], cst[7], cstlen);
+			}
+			else if (rates[k] == qsc_keccak_rate_256)
+			{
+				qsc_cshake_256x8(otp, otp + otplen, otp + (2 * otplen), otp + (3 * otplen),
+					otp + (4 * otplen), otp + (5 * otplen), otp + (6 * otplen), otp + (7 * otplen), otplen,
+					key[0], key[1], key[2], key[3], key[4], key[5], key[6], key[7], keylen,
+					nme[0], nme[1], nme[2], nme[3], nme[4], nme[5], nme[6], nme[7], nmelen,
+					cst[0], cst[1], cst[2], cst[3], cst[4], cst[5], cst[6], cst[7], cstlen);
+			}
+			else
+			{
+				qsc_cshake_512x8(otp, otp + otplen, otp + (2 * otplen), otp + (3 * otplen),
+					otp + (4 * otplen), otp + (5 * otplen), otp + (6 * otplen), otp + (7 * otplen), otplen,
+					key[0], key[1], key[2], key[3], key[4], key[5], key[6], key[7], keylen,
+					nme[0], nme[1], nme[2], nme[3], nme[4], nme[5], nme[6], nme[7], nmelen,
+					cst[0], cst[1], cst[2], cst[3], cst[4], cst[5], cst[6], cst[7], cstlen);
+			}
+
+			if (qsc_intutils_are_equal8(otp, exp, 8 * otplen) == false)
+			{
+				qsctest_print_safe("Failure! cshake_parallel_equality: cSHAKE x8 output does not match -CP2 \n");
+				status = false;
+				break;
+			}
+
+			/* subkey j is cSHAKE(key, name, custom || be32(j)) */
+			qsc_memutils_copy(bst, cst[0], cstlen);
+
+			for (j = 0; j < QSCTEST_CSHAKE_BATCH_COUNT; ++j)
+			{
+				qsc_intutils_be32to8(bst + cstlen, (uint32_t)j);
+				cshake_parallel_compute(exp + (j * otplen), otplen, rates[k], key[0], keylen, nme[0], nmelen, bst, cstlen + sizeof(uint32_t));
+			}
+
+			qsc_cshake_kdf_batch(otp, otplen, QSCTEST_CSHAKE_BATCH_COUNT, rates[k], key[0], keylen, nme[0], nmelen, cst[0], cstlen);
+
+			if (qsc_intutils_are_equal8(otp, exp, QSCTEST_CSHAKE_BATCH_COUNT * otplen) == false)
+			{
+				qsctest_print_safe("Failure! cshake_parallel_equality: batch key derivation output does not match -CP3 \n");
+				status = false;
+				break;
+			}
+		}
+	}
+
+	return status;
+}
+
+bool qsctest_kmac_verify_batch()
+{
+	const qsc_keccak_rate rates[2] = { qsc_keccak_rate_256, qsc_keccak_rate_512 };
+	qsc_kmac_verify_item items[QSCTEST_KMAC_VERIFY_COUNT] = { 0 };
+	uint8_t bitmap[(QSCTEST_KMAC_VERIFY_COUNT + 7) / 8] = { 0 };
+	uint8_t code[QSCTEST_KMAC_VERIFY_COUNT][QSCTEST_KMAC_VERIFY_CODE] = { 0 };
+	uint8_t cst[QSCTEST_KMAC_VERIFY_KEY] = { 0 };
+	uint8_t key[QSCTEST_KMAC_VERIFY_COUNT][QSCTEST_KMAC_VERIFY_KEY] = { 0 };
+	uint8_t msg[QSCTEST_KMAC_VERIFY_MESSAGE] = { 0 };
+	size_t i;
+	size_t j;
+	uint8_t exp;
+	bool status;
+
+	qsc_csp_generate(cst, sizeof(cst));
+	qsc_csp_generate((uint8_t*)key, sizeof(key));
+	qsc_csp_generate(msg, sizeof(msg));
+	status = true;
+
+	for (j = 0; j < 2 && status == true; ++j)
+	{
+		/* every item has its own key, code, customization, and message length */
+		for (i = 0; i < QSCTEST_KMAC_VERIFY_COUNT; ++i)
+		{
+			items[i].code = code[i];
+			items[i].message = msg;
+			items[i].key = key[i];
+			items[i].custom = cst;
+			items[i].codelen = 16 + (i % (QSCTEST_KMAC_VERIFY_CODE - 15));
+			items[i].msglen = (i * 101) % sizeof(msg);
+			items[i].keylen = 16 + ((i * 7) % (QSCTEST_KMAC_VERIFY_KEY - 15));
+			items[i].custlen = i % 3;
+
+			if (rates[j] == qsc_keccak_rate_256)
+			{
+				qsc_kmac256_compute(code[i], items[i].codelen, msg, items[i].msglen, key[i], items[i].keylen, cst, items[i].custlen);
+			}
+			else
+			{
+				qsc_kmac512_compute(code[i], items[i].codelen, msg, items[i].msglen, key[i], items[i].keylen, cst, items[i].custlen);
+			}
+		}
+
+		if (qsc_kmac_verify_batch(bitmap, items, QSCTEST_KMAC_VERIFY_COUNT, rates[j]) == false)
+		{
+			qsctest_print_safe("Failure! kmac_verify_batch: valid codes failed verification -KV1 \n");
+			status = false;
+		}
+
+		for (i = 0; i < QSCTEST_KMAC_VERIFY_COUNT; ++i)
+		{
+			if (((bitmap[i / 8] >> (i % 8)) & 1U) != 1U)
+			{
+				qsctest_print_safe("Failure! kmac_verify_batch: the bitmap is incorrect -KV2 \n");
+				status = false;
+				break;
+			}
+		}
+
+		/* alter every third code */
+		for (i = 0; i < QSCTEST_KMAC_VERIFY_COUNT; i += 3)
+		{
+			code[i][i % items[i].codelen] ^= 0x01U;
+		}
+
+		if (qsc_kmac_verify_batch(bitmap, items, QSCTEST_KMAC_VERIFY_COUNT, rates[j]) == true)
+		{
+			qsctest_print_safe("Failure! kmac_verify_batch: altered codes passed verification -KV3 \n");
+			status = false;
+		}
+
+		for (i = 0; i < QSCTEST_KMAC_VERIFY_COUNT; ++i)
+		{
+			exp = (i % 3 == 0) ? 0U : 1U;
+
+			if (((bitmap[i / 8] >> (i % 8)) & 1U) != exp)
+			{
+				qsctest_print_safe("Failure! kmac_verify_batch: the bitmap is incorrect -KV4 \n");
+				status = false;
+				break;
+			}
+		}
+	}
+
+	return status;
+}
+
+bool qsctest_turboshake_kat()
+{
+	uint8_t exp128a[32] = { 0 };
+	uint8_t exp128b[32] = { 0 };
+	uint8_t exp128c[32] = { 0 };
+	uint8_t exp256a[64] = { 0 };
+	uint8_t msg[289] = { 0 };
+	uint8_t output[64] = { 0 };
+	bool status;
+
+	qsctest_hex_to_bin("1E415F1C5983AFF2169217277D17BB538CD945A397DDEC541F1CE41AF2C1B74C", exp128a, sizeof(exp128a));
+	qsctest_hex_to_bin("96C77C279E0126F7FC07C9B07F5CDAE1E0BE60BDBE10620040E75D7223A624D2", exp128b, sizeof(exp128b));
+	qsctest_hex_to_bin("BF323F940494E88EE1C540FE660BE8A0C93F43D15EC006998462FA994EED5DAB", exp128c, sizeof(exp128c));
+	qsctest_hex_to_bin("367A329DAFEA871C7802EC67F905AE13C57695DC2C6663C61035F59A18F8E7DB"
+		"11EDC0E12E91EA60EB6B32DF06DD7F002FBAFABB6E13EC1CC20D995547600DB0", exp256a, sizeof(exp256a));
+
+	status = true;
+
+	qsc_turboshake128_compute(output, sizeof(exp128a), msg, 0, QSC_TURBOSHAKE_DOMAIN_ID);
+
+	if (qsc_intutils_are_equal8(output, exp128a, sizeof(exp128a)) == false)
+	{
+		qsctest_print_safe("Failure! turboshake_kat: output does not match the known answer -TK1 \n");
+		status = false;
+	}
+
+	kangarootwelve_pattern(msg, sizeof(msg));
+	qsc_turboshake128_compute(output, sizeof(exp128b), msg, sizeof(msg), QSC_TURBOSHAKE_DOMAIN_ID);
+
+	if (qsc_intutils_are_equal8(output, exp128b, sizeof(exp128b)) == false)
+	{
+		qsctest_print_safe("Failure! turboshake_kat: output does not match the known answer -TK2 \n");
+		status = false;
+	}
+
+	qsc_memutils_setvalue(msg, 0xFF, 3);
+	qsc_turboshake128_compute(output, sizeof(exp128c), msg, 3, 0x01);
+
+	if (qsc_intutils_are_equal8(output, exp128c, sizeof(exp128c)) == false)
+	{
+		qsctest_print_safe("Failure! turboshake_kat: output does not match the known answer -TK3 \n");
+		status = false;
+	}
+
+	qsc_turboshake256_compute(output, sizeof(exp256a), msg, 0, QSC_TURBOSHAKE_DOMAIN_ID);
+
+	if (qsc_intutils_are_equal8(output, exp256a, sizeof(exp256a)) == false)
+	{
+		qsctest_print_safe("Failure! turboshake_kat: output does not match the known answer -TK4 \n");
+		status = false;
+	}
+
+	return status;
+}
+
+bool qsctest_kangarootwelve_kat()
+{
+	uint8_t cust[1681] = { 0 };
+	uint8_t exp128a[32] = { 0 };
+	uint8_t exp128b[32] = { 0 };
+	uint8_t exp128c[32] = { 0 };
+	uint8_t exp128d[32] = { 0 };
+	uint8_t exp128e[32] = { 0 };
+	uint8_t exp128f[32] = { 0 };
+	uint8_t exp128g[32] = { 0 };
+	uint8_t exp256a[64] = { 0 };
+	uint8_t exp256b[64] = { 0 };
+	uint8_t exp256c[64] = { 0 };
+	uint8_t exp256d[64] = { 0 };
+	uint8_t msgff[1] = { 0xFF };
+	uint8_t output[64] = { 0 };
+	uint8_t* msg;
+	bool status;
+
+	qsctest_hex_to_bin("1AC2D450FC3B4205D19DA7BFCA1B37513C0803577AC7167F06FE2CE1F0EF39E5", exp128a, sizeof(exp128a));
+	qsctest_hex_to_bin("6BF75FA2239198DB4772E36478F8E19B0F371205F6A9A93A273F51DF37122888", exp128b, sizeof(exp128b));
+	qsctest_hex_to_bin("1B577636F723643E990CC7D6A659837436FD6A103626600EB8301CD1DBE553D6", exp128c, sizeof(exp128c));
+	qsctest_hex_to_bin("48F256F6772F9EDFB6A8B661EC92DC93B95EBD05A08A17B39AE3490870C926C3", exp128d, sizeof(exp128d));
+	qsctest_hex_to_bin("844D610933B1B9963CBDEB5AE3B6B05CC7CBD67CEEDF883EB678A0A8E0371682", exp128e, sizeof(exp128e));
+	qsctest_hex_to_bin("FAB658DB63E94A246188BF7AF69A133045F46EE984C56E3C3328CAAF1AA1A583", exp128f, sizeof(exp128f));
+	qsctest_hex_to_bin("D848C5068CED736F4462159B9867FD4C20B808ACC3D5BC48E0B06BA0A3762EC4", exp128g, sizeof(exp128g));
+	qsctest_hex_to_bin("B23D2E9CEA9F4904E02BEC06817FC10CE38CE8E93EF4C89E6537076AF8646404"
+		"E3E8B68107B8833A5D30490AA33482353FD4ADC7148ECB782855003AAEBDE4A9", exp256a, sizeof(exp256a));
+	qsctest_hex_to_bin("1BA3C02B1FC514474F06C8979978A9056C8483F4A1B63D0DCCEFE3A28A2F323E"
+		"1CDCCA40EBF006AC76EF0397152346837B1277D3E7FAA9C9653B19075098527B", exp256b, sizeof(exp256b));
+	qsctest_hex_to_bin("B06275D284CD1CF205BCBE57DCCD3EC1FF6686E3ED15776383E1F2FA3C6AC8F0"
+		"8BF8A162829DB1A44B2A43FF83DD89C3CF1CEB61EDE659766D5CCF817A62BA8D", exp256c, sizeof(exp256c));
+	qsctest_hex_to_bin("3DB4EB9ED737B9844DF7771D44C86DAE08D0986BB4CB240B9BB0A6E630566679"
+		"E390AAC93565204F603313E9E7E0B477C09F4A58CEE839710827D50B639E2CC8", exp256d, sizeof(exp256d));
+
+	status = true;
+	msg = (uint8_t*)qsc_memutils_malloc(QSCTEST_KANGAROOTWELVE_PATTERN);
+
+	if (msg != NULL)
+	{
+		kangarootwelve_pattern(msg, QSCTEST_KANGAROOTWELVE_PATTERN);
+		kangarootwelve_pattern(cust, sizeof(cust));
+
+		/* KT128: a single chunk, chunk boundaries, and a multi-leaf message */
+		qsc_kt128_compute(output, sizeof(exp128a), msg, 0, NULL, 0);
+
+		if (qsc_intutils_are_equal8(output, exp128a, sizeof(exp128a)) == false)
+		{
+			qsctest_print_safe("Failure! kangarootwelve_kat: output does not match the known answer -KK1 \n");
+			status = false;
+		}
+
+		qsc_kt128_compute(output, sizeof(exp128b), msg, 17, NULL, 0);
+
+		if (qsc_intutils_are_equal8(output, exp128b, sizeof(exp128b)) == false)
+		{
+			qsctest_print_safe("Failure! kangarootwelve_kat: output does not match the known answer -KK2 \n");
+			status = false;
+		}
+
+		qsc_kt128_compute(output, sizeof(exp128c), msg, 8191, NULL, 0);
+
+		if (qsc_intutils_are_equal8(output, exp128c, sizeof(exp128c)) == false)
+		{
+			qsctest_print_safe("Failure! kangarootwelve_kat: output does not match the known answer -KK3 \n");
+			status = false;
+		}
+
+		qsc_kt128_compute(output, sizeof(exp128d), msg, 8192, NULL, 0);
+
+		if (qsc_intutils_are_equal8(output, exp128d, sizeof(exp128d)) == false)
+		{
+			qsctest_print_safe("Failure! kangarootwelve_kat: output does not match the known answer -KK4 \n");
+			status = false;
+		}
+
+		qsc_kt128_compute(output, sizeof(exp128e), msg, QSCTEST_KANGAROOTWELVE_PATTERN, NULL, 0);
+
+		if (qsc_intutils_are_equal8(output, exp128e, sizeof(exp128e)) == false)
+		{
+			qsctest_print_safe("Failure! kangarootwelve_kat: output does not match the known answer -KK5 \n");
+			status = false;
+		}
+
+		qsc_intutils_clear8(output, sizeof(output));
+		qsc_kt128_parallel_compute(output, sizeof(exp128e), msg, QSCTEST_KANGAROOTWELVE_PATTERN, NULL, 0);
+
+		if (qsc_intutils_are_equal8(output, exp128e, sizeof(exp128e)) == false)
+		{
+			qsctest_print_safe("Failure! kangarootwelve_kat: output does not match the known answer -KK6 \n");
+			status = false;
+		}
+
+		/* KT128 with a customization string */
+		qsc_kt128_compute(output, sizeof(exp128f), msg, 0, cust, 1);
+
+		if (qsc_intutils_are_equal8(output, exp128f, sizeof(exp128f)) == false)
+		{
+			qsctest_print_safe("Failure! kangarootwelve_kat: output does not match the known answer -KK7 \n");
+			status = false;
+		}
+
+		qsc_kt128_compute(output, sizeof(exp128g), msgff, sizeof(msgff), cust, 41);
+
+		if (qsc_intutils_are_equal8(output, exp128g, sizeof(exp128g)) == false)
+		{
+			qsctest_print_safe("Failure! kangarootwelve_kat: output does not match the known answer -KK8 \n");
+			status = false;
+		}
+
+		/* KT256 */
+		qsc_kt256_compute(output, sizeof(exp256a), msg, 0, NULL, 0);
+
+		if (qsc_intutils_are_equal8(output, exp256a, sizeof(exp256a)) == false)
+		{
+			qsctest_print_safe("Failure! kangarootwelve_kat: output does not match the known answer -KK9 \n");
+			status = false;
+		}
+
+		qsc_kt256_compute(output, sizeof(exp256b), msg, 17, NULL, 0);
+
+		if (qsc_intutils_are_equal8(output, exp256b, sizeof(exp256b)) == false)
+		{
+			qsctest_print_safe("Failure! kangarootwelve_kat: output does not match the known answer -KK10 \n");
+			status = false;
+		}
+
+		qsc_kt256_compute(output, sizeof(exp256c), msg, 83521, NULL, 0);
+
+		if (qsc_intutils_are_equal8(output, exp256c, sizeof(exp256c)) == false)
+		{
+			qsctest_print_safe("Failure! kangarootwelve_kat: output does not match the known answer -KK11 \n");
+			status = false;
+		}
+
+		qsc_kt256_parallel_compute(output, sizeof(exp256d), msg, QSCTEST_KANGAROOTWELVE_PATTERN, cust, sizeof(cust));
+
+		if (qsc_intutils_are_equal8(output, exp256d, sizeof(exp256d)) == false)
+		{
+			qsctest_print_safe("Failure! kangarootwelve_kat: output does not match the known answer -KK12 \n");
+			status = false;
+		}
+
+		qsc_memutils_alloc_free(msg);
+	}
+	else
+	{
+		qsctest_print_safe("Failure! kangarootwelve_kat: memory allocation failed -KK13 \n");
+		status = false;
+	}
+
+	return status;
+}
+
+bool qsctest_kangarootwelve_parallel_equality()
+{
+	uint8_t cust[64] = { 0 };
+	uint8_t exp[QSC_KT256_HASH_SIZE] = { 0 };
+	uint8_t otp[QSC_KT256_HASH_SIZE] = { 0 };
+	uint8_t rnd[4] = { 0 };
+	uint8_t seed[32] = { 0 };
+	uint8_t* msg;
+	size_t clen;
+	size_t i;
+	size_t mlen;
+	bool status;
+
+	status = true;
+	msg = (uint8_t*)qsc_memutils_malloc(QSCTEST_KANGAROOTWELVE_MESSAGE);
+
+	if (msg != NULL)
+	{
+		/* the message is expanded from a random seed */
+		qsc_csp_generate(seed, sizeof(seed));
+		qsc_shake256_compute(msg, QSCTEST_KANGAROOTWELVE_MESSAGE, seed, sizeof(seed));
+		qsc_csp_generate(cust, sizeof(cust));
+
+		for (i = 0; i < QSCTEST_KANGAROOTWELVE_CYCLES; ++i)
+		{
+			/* random message lengths that span the threading threshold, some with a customization string */
+			qsc_csp_generate(rnd, sizeof(rnd));
+			mlen = (size_t)qsc_intutils_le8to32(rnd) % QSCTEST_KANGAROOTWELVE_MESSAGE;
+			clen = (i % 2 == 0) ? 0 : (size_t)rnd[0] % sizeof(cust);
+
+			qsc_kt128_compute(exp, QSC_KT128_HASH_SIZE, msg, mlen, cust, clen);
+			qsc_kt128_parallel_compute(otp, QSC_KT128_HASH_SIZE, msg, mlen, cust, clen);
+
+			if (qsc_intutils_are_equal8(otp, exp, QSC_KT128_HASH_SIZE) == false)
+			{
+				qsctest_print_safe("Failure! kangarootwelve_parallel_equality: output does not match the sequential function -KE1 \n");
+				status = false;
+				break;
+			}
+
+			qsc_kt256_compute(exp, QSC_KT256_HASH_SIZE, msg, mlen, cust, clen);
+			qsc_kt256_parallel_compute(otp, QSC_KT256_HASH_SIZE, msg, mlen, cust, clen);
+
+			if (qsc_intutils_are_equal8(otp, exp, QSC_KT256_HASH_SIZE) == false)
+			{
+				qsctest_print_safe("Failure! kangarootwelve_parallel_equality: output does not match the sequential function -KE2 \n");
+				status = false;
+				break;
+			}
+		}
+
+		qsc_memutils_alloc_free(msg);
+	}
+	else
+	{
+		qsctest_print_safe("Failure! kangarootwelve_parallel_equality: memory allocation failed -KE3 \n");
+		status = false;
+	}
+
+	return status;
+}
+
 void qsctest_sha3_run()
 {
 	if (qsctest_cshake_256_kat() == true)
@@ -2230,6 +3204,15 @@ void qsctest_sha3_run()
 		qsctest_print_safe("Failure! Failed the KMAC-512 KAT test. \n");
 	}
 
+	if (qsctest_kmac_prepared_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the KMAC prepared key equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the KMAC prepared key equality test. \n");
+	}
+
 	if (qsctest_sha3_256_kat() == true)
 	{
 		qsctest_print_safe("Success! Passed the SHA3-256 KAT test. \n");
@@ -2284,6 +3267,87 @@ void qsctest_sha3_run()
 		qsctest_print_safe("Failure! Failed the KPA-512 KAT test. \n");
 	}
 
+	if (qsctest_keccak_jobs_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the Keccak multi-buffer job equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the Keccak multi-buffer job equality test. \n");
+	}
+
+	if (qsctest_keccakx4_incremental_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the Keccak 4x incremental equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the Keccak 4x incremental equality test. \n");
+	}
+
+	if (qsctest_keccakx8_incremental_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the Keccak 8x incremental equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the Keccak 8x incremental equality test. \n");
+	}
+
+	if (qsctest_keccak_fixed_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the fixed-length SHA3-256 and SHAKE-256 equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the fixed-length SHA3-256 and SHAKE-256 equality test. \n");
+	}
+
+	if (qsctest_cshake_parallel_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the parallel cSHAKE and batch key derivation equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the parallel cSHAKE and batch key derivation equality test. \n");
+	}
+
+	if (qsctest_kmac_verify_batch() == true)
+	{
+		qsctest_print_safe("Success! Passed the KMAC-256 and KMAC-512 batch verification test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the KMAC-256 and KMAC-512 batch verification test. \n");
+	}
+
+	if (qsctest_turboshake_kat() == true)
+	{
+		qsctest_print_safe("Success! Passed the TurboSHAKE KAT test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the TurboSHAKE KAT test. \n");
+	}
+
+	if (qsctest_kangarootwelve_kat() == true)
+	{
+		qsctest_print_safe("Success! Passed the KangarooTwelve KAT test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the KangarooTwelve KAT test. \n");
+	}
+
+	if (qsctest_kangarootwelve_parallel_equality() == true)
+	{
+		qsctest_print_safe("Success! Passed the KangarooTwelve parallel equality test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the KangarooTwelve parallel equality test. \n");
+	}
+
 #if defined(QSC_SYSTEM_HAS_AVX2)
 
 	if (qsctest_kmac128x4_equality() == true)
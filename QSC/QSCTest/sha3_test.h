@@ -12,6 +12,29 @@
 
 #include "common.h"
 
+#define QSCTEST_KECCAK_JOB_COUNT 41
+#define QSCTEST_KECCAK_JOB_MESSAGE 1024
+#define QSCTEST_KECCAK_JOB_OUTPUT 400
+#define QSCTEST_KECCAK_FIXED_CYCLES 16
+#define QSCTEST_CSHAKE_PARALLEL_CYCLES 12
+#define QSCTEST_CSHAKE_PARALLEL_INPUT 300
+#define QSCTEST_CSHAKE_PARALLEL_OUTPUT 200
+#define QSCTEST_CSHAKE_BATCH_COUNT 13
+#define QSCTEST_KMAC_VERIFY_CODE 64
+#define QSCTEST_KMAC_VERIFY_COUNT 29
+#define QSCTEST_KMAC_VERIFY_KEY 100
+#define QSCTEST_KMAC_VERIFY_MESSAGE 800
+#define QSCTEST_KMAC_PREPARED_CUSTOM 200
+#define QSCTEST_KMAC_PREPARED_KEY 240
+#define QSCTEST_KMAC_PREPARED_MESSAGE 700
+#define QSCTEST_KMAC_PREPARED_OUTPUT 80
+#define QSCTEST_KECCAK_INCREMENTAL_CYCLES 30
+#define QSCTEST_KECCAK_INCREMENTAL_MESSAGE 2048
+#define QSCTEST_KECCAK_INCREMENTAL_OUTPUT 500
+#define QSCTEST_KANGAROOTWELVE_CYCLES 8
+#define QSCTEST_KANGAROOTWELVE_MESSAGE (2 * 1024 * 1024)
+#define QSCTEST_KANGAROOTWELVE_PATTERN 1419857
+
 /**
 * \brief Tests the 256-bit version of the keccak message digest for correct operation,
 * using selected vectors from the NIST Fips202 and alternative references.
@@ -147,6 +170,14 @@ bool qsctest_kmac_256_kat(void);
 */
 bool qsctest_kmac_512_kat(void);
 
+/**
+* \brief Tests KMAC with prepared keys for equality with the keyed KMAC functions.
+* Each prepared key is reused for several messages, using the short and long form api at every rate.
+*
+* \return Returns true for success
+*/
+bool qsctest_kmac_prepared_equality(void);
+
 /**
 * \brief Tests the 256-bit version of the Keccak-based Parallel Authentication MAC (KPA) function for correct operation,
 * using original vectors.
@@ -251,6 +282,83 @@ bool qsctest_shake256x8_equality(void);
 bool qsctest_shake512x8_equality(void);
 #endif
 
+/**
+* \brief Tests the multi-buffer Keccak job engine for equality with the sequential SHA3, SHAKE, and KMAC functions.
+* Computes a set of jobs with mixed functions, rates, and message and output lengths, directly and through a job manager.
+*
+* \return Returns true for success
+*/
+bool qsctest_keccak_jobs_equality(void);
+
+/**
+* \brief Tests the incremental 4-lane Keccak functions for equality with the sequential SHAKE functions.
+* The lane messages are absorbed, and the output squeezed, in random segment sizes.
+*
+* \return Returns true for success
+*/
+bool qsctest_keccakx4_incremental_equality(void);
+
+/**
+* \brief Tests the incremental 8-lane Keccak functions for equality with the sequential SHA3 functions.
+* The lane messages are absorbed, and the output squeezed, in random segment sizes.
+*
+* \return Returns true for success
+*/
+bool qsctest_keccakx8_incremental_equality(void);
+
+/**
+* \brief Tests the fixed-length node and PRF functions for equality with the SHA3-256 and SHAKE-256 functions.
+* The 4 and 8 lane forms are compared with the single hash functions, and the PRF is tested at every output length.
+*
+* \return Returns true for success
+*/
+bool qsctest_keccak_fixed_equality(void);
+
+/**
+* \brief Tests the 4 and 8 lane cSHAKE functions and the batch cSHAKE key derivation for equality
+* with the single cSHAKE functions, using distinct keys, names and customization strings in every lane.
+*
+* \return Returns true for success
+*/
+bool qsctest_cshake_parallel_equality(void);
+
+/**
+* \brief Tests the KMAC-256 and KMAC-512 batch verification, using a distinct key, code length,
+* and message length for every item. The bitmap must flag exactly the items with altered codes.
+*
+* \return Returns true for success
+*/
+bool qsctest_kmac_verify_batch(void);
+
+/**
+* \brief Tests the TurboSHAKE128 and TurboSHAKE256 functions for correct operation,
+* using vectors from RFC 9861.
+*
+* \return Returns true for success
+*
+* \remarks <b>Test References:</b> \n
+* RFC 9861: <a href="https://www.rfc-editor.org/rfc/rfc9861">KangarooTwelve and TurboSHAKE</a>
+*/
+bool qsctest_turboshake_kat(void);
+
+/**
+* \brief Tests the KT128 and KT256 tree hash functions for correct operation,
+* using vectors from RFC 9861 that cover single chunk, multi-leaf, and customized messages.
+*
+* \return Returns true for success
+*
+* \remarks <b>Test References:</b> \n
+* RFC 9861: <a href="https://www.rfc-editor.org/rfc/rfc9861">KangarooTwelve and TurboSHAKE</a>
+*/
+bool qsctest_kangarootwelve_kat(void);
+
+/**
+* \brief Tests the threaded KangarooTwelve functions for equality with the sequential functions.
+*
+* \return Returns true for success
+*/
+bool qsctest_kangarootwelve_parallel_equality(void);
+
 /**
 * \brief Run all tests.
 */
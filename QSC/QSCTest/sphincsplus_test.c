@@ -316,6 +316,131 @@ bool qsctest_sphincsplus_stress_test()
 
 #endif
 
+bool qsctest_sphincsplus_detached_test()
+{
+	uint8_t dsig[QSC_SPHINCSPLUS_SIGNATURE_SIZE] = { 0 };
+	uint8_t msg[QSCTEST_SPHINCSPLUS_MLEN] = { 0 };
+	uint8_t seed[QSCTEST_NIST_RNG_SEED_SIZE] = { 0 };
+	uint8_t sig[QSC_SPHINCSPLUS_SIGNATURE_SIZE + QSCTEST_SPHINCSPLUS_MLEN] = { 0 };
+	uint8_t sk[QSC_SPHINCSPLUS_PRIVATEKEY_SIZE] = { 0 };
+	uint8_t pk[QSC_SPHINCSPLUS_PUBLICKEY_SIZE] = { 0 };
+	size_t dlen;
+	size_t siglen;
+	bool ret;
+
+	ret = true;
+	dlen = 0;
+	siglen = 0;
+	qsctest_hex_to_bin("061550234D158C5EC95595FE04EF7A25767F2E24CC2BC479D09D86DC9ABCFDE7056A8C266F9EF97ED08541DBD2E1FFA1", seed, sizeof(seed));
+	qsctest_nistrng_prng_initialize(seed, NULL, 0);
+	qsc_sphincsplus_generate_keypair(pk, sk, qsctest_nistrng_prng_generate);
+	qsctest_nistrng_prng_generate(msg, sizeof(msg));
+
+	/* the detached signature must equal the signature prefix of the signed message */
+	qsctest_nistrng_prng_initialize(seed, NULL, 0);
+	qsc_sphincsplus_sign(sig, &siglen, msg, sizeof(msg), sk, qsctest_nistrng_prng_generate);
+	qsctest_nistrng_prng_initialize(seed, NULL, 0);
+	qsc_sphincsplus_sign_detached(dsig, &dlen, msg, sizeof(msg), sk, qsctest_nistrng_prng_generate);
+
+	if (dlen != QSC_SPHINCSPLUS_SIGNATURE_SIZE || siglen != dlen + sizeof(msg) || qsc_intutils_are_equal8(dsig, sig, dlen) != true)
+	{
+		qsctest_print_safe("Failure! sphincsplus detached: signature does not match the signed message! - SDT1 \n");
+		ret = false;
+	}
+
+	if (qsc_sphincsplus_verify_detached(dsig, dlen, msg, sizeof(msg), pk) != true)
+	{
+		qsctest_print_safe("Failure! sphincsplus detached: signature verification has failed! - SDT2 \n");
+		ret = false;
+	}
+
+	/* flip 1 bit in the message */
+	msg[0] ^= 1U;
+
+	if (qsc_sphincsplus_verify_detached(dsig, dlen, msg, sizeof(msg), pk) == true)
+	{
+		qsctest_print_safe("Failure! sphincsplus detached: altered message passed verification! - SDT3 \n");
+		ret = false;
+	}
+
+	/* flip 1 bit in the signature */
+	msg[0] ^= 1U;
+	dsig[dlen - 1] ^= 1U;
+
+	if (qsc_sphincsplus_verify_detached(dsig, dlen, msg, sizeof(msg), pk) == true)
+	{
+		qsctest_print_safe("Failure! sphincsplus detached: altered signature passed verification! - SDT4 \n");
+		ret = false;
+	}
+
+	return ret;
+}
+
+bool qsctest_sphincsplus_stream_test()
+{
+	uint8_t msg[QSCTEST_SPHINCSPLUS_STREAM_MLEN] = { 0 };
+	uint8_t seed[QSCTEST_NIST_RNG_SEED_SIZE] = { 0 };
+	uint8_t sig[QSC_SPHINCSPLUS_SIGNATURE_SIZE] = { 0 };
+	uint8_t sk[QSC_SPHINCSPLUS_PRIVATEKEY_SIZE] = { 0 };
+	uint8_t pk[QSC_SPHINCSPLUS_PUBLICKEY_SIZE] = { 0 };
+	qsc_sphincsplus_stream_state state;
+	size_t pos;
+	size_t siglen;
+	bool ret;
+
+	ret = true;
+	siglen = 0;
+	qsctest_hex_to_bin("061550234D158C5EC95595FE04EF7A25767F2E24CC2BC479D09D86DC9ABCFDE7056A8C266F9EF97ED08541DBD2E1FFA1", seed, sizeof(seed));
+	qsctest_nistrng_prng_initialize(seed, NULL, 0);
+	qsc_sphincsplus_generate_keypair(pk, sk, qsctest_nistrng_prng_generate);
+	qsctest_nistrng_prng_generate(msg, sizeof(msg));
+
+	/* sign the message in uneven blocks */
+	qsc_sphincsplus_sign_initialize(&state);
+
+	for (pos = 0; pos < sizeof(msg); pos += 1 + (pos % 300))
+	{
+		qsc_sphincsplus_sign_update(&state, msg + pos, qsc_intutils_min(1 + (pos % 300), sizeof(msg) - pos));
+	}
+
+	qsc_sphincsplus_sign_finalize(&state, sig, &siglen, sk, qsctest_nistrng_prng_generate);
+
+	if (siglen != QSC_SPHINCSPLUS_SIGNATURE_SIZE)
+	{
+		qsctest_print_safe("Failure! sphincsplus stream: signature length is incorrect! - SSM1 \n");
+		ret = false;
+	}
+
+	qsc_sphincsplus_verify_initialize(&state);
+	qsc_sphincsplus_verify_update(&state, msg, 1);
+	qsc_sphincsplus_verify_update(&state, msg + 1, sizeof(msg) - 1);
+
+	if (qsc_sphincsplus_verify_finalize(&state, sig, siglen, pk) != true)
+	{
+		qsctest_print_safe("Failure! sphincsplus stream: signature verification has failed! - SSM2 \n");
+		ret = false;
+	}
+
+	/* drop the last message byte */
+	qsc_sphincsplus_verify_initialize(&state);
+	qsc_sphincsplus_verify_update(&state, msg, sizeof(msg) - 1);
+
+	if (qsc_sphincsplus_verify_finalize(&state, sig, siglen, pk) == true)
+	{
+		qsctest_print_safe("Failure! sphincsplus stream: truncated message passed verification! - SSM3 \n");
+		ret = false;
+	}
+
+	/* a pre-hashed signature must not verify as a signature of the message itself */
+	if (qsc_sphincsplus_verify_detached(sig, siglen, msg, sizeof(msg), pk) == true)
+	{
+		qsctest_print_safe("Failure! sphincsplus stream: pre-hashed signature verified as a pure signature! - SSM4 \n");
+		ret = false;
+	}
+
+	return ret;
+}
+
 void qsctest_sphincsplus_run()
 {
 #if defined(QSC_SPHINCSPLUS_EXTENDED)
@@ -372,5 +497,23 @@ void qsctest_sphincsplus_run()
 	{
 		qsctest_print_safe("Failure! Failed the SphincsPlus altered signature test has failed. \n");
 	}
+
+	if (qsctest_sphincsplus_detached_test() == true)
+	{
+		qsctest_print_safe("Success! Passed the SphincsPlus detached signature test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the SphincsPlus detached signature test has failed. \n");
+	}
+
+	if (qsctest_sphincsplus_stream_test() == true)
+	{
+		qsctest_print_safe("Success! Passed the SphincsPlus streaming signature test. \n");
+	}
+	else
+	{
+		qsctest_print_safe("Failure! Failed the SphincsPlus streaming signature test has failed. \n");
+	}
 #endif
 }
@@ -14,6 +14,7 @@
 #include "common.h"
 
 #define QSCTEST_SPHINCSPLUS_MLEN 33
+#define QSCTEST_SPHINCSPLUS_STREAM_MLEN 4096
 
 /**
 * \brief Test the public and private keys, cipher-text and shared key
@@ -47,6 +48,18 @@ bool qsctest_sphincsplus_signature_integrity(void);
 */
 bool qsctest_sphincsplus_stress_test(void);
 
+/**
+* \brief Test detached signing and verification against the signed-message format
+* \return Returns one (true) for test success
+*/
+bool qsctest_sphincsplus_detached_test(void);
+
+/**
+* \brief Test streaming (pre-hashed) signing and verification
+* \return Returns one (true) for test success
+*/
+bool qsctest_sphincsplus_stream_test(void);
+
 /**
 * \brief Tests the 512-bit extended version of the signature scheme
 * \return Returns one (true) for test success